@@ -87,6 +87,11 @@ Error ExternalTool::setLastError(Error error, const char* message) noexcept {
 // [asmjit::Assembler - Construction / Destruction]
 // ============================================================================
 
+static const char assemblerSectionNames[kSectionCount][8] = {
+  ".text",
+  ".rodata"
+};
+
 Assembler::Assembler(Runtime* runtime) noexcept
   : _runtime(runtime),
     _logger(nullptr),
@@ -103,11 +108,24 @@ Assembler::Assembler(Runtime* runtime) noexcept
     _buffer(nullptr),
     _end(nullptr),
     _cursor(nullptr),
+    _bufferOffset(0),
+    _firstChunk(nullptr),
+    _currentChunk(nullptr),
     _trampolinesSize(0),
     _comment(nullptr),
     _unusedLinks(nullptr),
     _labels(),
-    _relocations() {}
+    _relocations(),
+    _sectionLinks(),
+    _relaxItems(),
+    _relaxRefs() {
+
+  ::memset(_sections, 0, sizeof(_sections));
+  for (uint32_t i = 0; i < kSectionCount; i++) {
+    _sections[i].id = i;
+    ::memcpy(_sections[i].name, assemblerSectionNames[i], sizeof(assemblerSectionNames[i]));
+  }
+}
 
 Assembler::~Assembler() noexcept {
   reset(true);
@@ -129,21 +147,52 @@ void Assembler::reset(bool releaseMemory) noexcept {
 
   _zoneAllocator.reset(releaseMemory);
 
-  if (releaseMemory && _buffer != nullptr) {
-    ASMJIT_FREE(_buffer);
+  Chunk* chunk = _firstChunk;
+  if (releaseMemory) {
+    while (chunk != nullptr) {
+      Chunk* next = chunk->next;
+      ASMJIT_FREE(chunk);
+      chunk = next;
+    }
+
+    _firstChunk = nullptr;
+    _currentChunk = nullptr;
     _buffer = nullptr;
     _end = nullptr;
   }
+  else if (chunk != nullptr) {
+    // Keep all chunks, they are reused by the next code.
+    _currentChunk = chunk;
+    _buffer = chunk->getData();
+    _end = _buffer + chunk->capacity;
+  }
 
   _cursor = _buffer;
+  _bufferOffset = 0;
   _trampolinesSize = 0;
 
   _comment = nullptr;
   _unusedLinks = nullptr;
 
-  _sections.reset(releaseMemory);
+  for (uint32_t i = 0; i < kSectionCount; i++) {
+    Buffer& content = _sections[i].content;
+
+    if (releaseMemory && content.data != nullptr) {
+      ASMJIT_FREE(content.data);
+      content.data = nullptr;
+      content.capacity = 0;
+    }
+
+    content.length = 0;
+    content.offset = 0;
+    _sections[i].alignment = 0;
+  }
+
   _labels.reset(releaseMemory);
   _relocations.reset(releaseMemory);
+  _sectionLinks.reset(releaseMemory);
+  _relaxItems.reset(releaseMemory);
+  _relaxRefs.reset(releaseMemory);
 }
 
 // ============================================================================
@@ -202,63 +251,304 @@ Error Assembler::setErrorHandler(ErrorHandler* handler) noexcept {
 // ============================================================================
 
 Error Assembler::_grow(size_t n) noexcept {
-  size_t capacity = getCapacity();
-  size_t after = getOffset() + n;
-
-  // Overflow.
-  if (n > IntTraits<uintptr_t>::maxValue() - capacity)
-    return setLastError(kErrorNoHeapMemory);
-
   // Grow is called when allocation is needed, so it shouldn't happen, but on
   // the other hand it is simple to catch and it's not an error.
-  if (after <= capacity)
+  if (n <= getRemainingSpace())
     return kErrorOk;
 
-  if (capacity < kMemAllocOverhead)
-    capacity = kMemAllocOverhead;
-  else
-    capacity += kMemAllocOverhead;
+  size_t offset = getOffset();
+  size_t maxCapacity = kChunkSize - sizeof(Chunk);
 
-  do {
-    size_t oldCapacity = capacity;
+  // Overflow.
+  if (n > IntTraits<uintptr_t>::maxValue() - kChunkSize - offset)
+    return setLastError(kErrorNoHeapMemory);
+
+  // The first chunk grows like a regular buffer, so a small function ends up
+  // in a single chunk and growing never copies more than `kChunkSize` bytes.
+  Chunk* chunk = _currentChunk;
+  if (chunk == nullptr || (chunk == _firstChunk && offset + n <= maxCapacity)) {
+    size_t after = offset + n;
+    size_t capacity = chunk != nullptr ? chunk->capacity : 0;
 
-    if (capacity < kMemAllocGrowMax)
+    if (capacity < 256)
+      capacity = 256;
+
+    while (capacity < after)
       capacity *= 2;
-    else
-      capacity += kMemAllocGrowMax;
 
-    // Overflow.
-    if (oldCapacity > capacity)
+    if (capacity > maxCapacity)
+      capacity = Utils::iMax<size_t>(maxCapacity, after);
+    return _reserve(capacity);
+  }
+
+  // Continue in the next chunk, reuse the one kept by `reset()` if it's
+  // large enough.
+  Chunk* next = chunk->next;
+  if (next == nullptr || next->capacity < n) {
+    size_t capacity = Utils::iMax<size_t>(maxCapacity, n);
+
+    next = static_cast<Chunk*>(ASMJIT_ALLOC(sizeof(Chunk) + capacity));
+    if (next == nullptr)
       return setLastError(kErrorNoHeapMemory);
-  } while (capacity - kMemAllocOverhead < after);
 
-  capacity -= kMemAllocOverhead;
-  return _reserve(capacity);
+    next->next = chunk->next;
+    next->capacity = capacity;
+    chunk->next = next;
+  }
+
+  chunk->length = (size_t)(_cursor - _buffer);
+  next->offset = offset;
+  next->length = 0;
+
+  _currentChunk = next;
+  _buffer = next->getData();
+  _end = _buffer + next->capacity;
+  _cursor = _buffer;
+  _bufferOffset = offset;
+
+  return kErrorOk;
 }
 
 Error Assembler::_reserve(size_t n) noexcept {
-  size_t capacity = getCapacity();
-  if (n <= capacity)
+  if (n <= getCapacity())
     return kErrorOk;
 
-  uint8_t* newBuffer;
-  if (_buffer == nullptr)
-    newBuffer = static_cast<uint8_t*>(ASMJIT_ALLOC(n));
+  // Only the first chunk can be reallocated, the code in other chunks never
+  // moves.
+  Chunk* chunk = _currentChunk;
+  if (chunk != _firstChunk)
+    return _grow(n - getOffset());
+
+  Chunk* newChunk;
+  if (chunk == nullptr)
+    newChunk = static_cast<Chunk*>(ASMJIT_ALLOC(sizeof(Chunk) + n));
   else
-    newBuffer = static_cast<uint8_t*>(ASMJIT_REALLOC(_buffer, n));
+    newChunk = static_cast<Chunk*>(ASMJIT_REALLOC(chunk, sizeof(Chunk) + n));
 
-  if (newBuffer == nullptr)
+  if (newChunk == nullptr)
     return setLastError(kErrorNoHeapMemory);
 
+  if (chunk == nullptr) {
+    newChunk->next = nullptr;
+    newChunk->offset = 0;
+    newChunk->length = 0;
+  }
+  newChunk->capacity = n;
+
   size_t offset = getOffset();
 
-  _buffer = newBuffer;
+  _firstChunk = newChunk;
+  _currentChunk = newChunk;
+  _buffer = newChunk->getData();
   _end = _buffer + n;
-  _cursor = newBuffer + offset;
+  _cursor = _buffer + offset;
 
   return kErrorOk;
 }
 
+Error Assembler::_flatten() noexcept {
+  Chunk* first = _firstChunk;
+  if (first == _currentChunk)
+    return kErrorOk;
+
+  size_t offset = getOffset();
+  size_t capacity = getCapacity();
+
+  Chunk* flat = static_cast<Chunk*>(ASMJIT_ALLOC(sizeof(Chunk) + capacity));
+  if (flat == nullptr)
+    return setLastError(kErrorNoHeapMemory);
+
+  uint8_t* data = flat->getData();
+  Chunk* chunk = first;
+
+  // Used part of all previous chunks and the whole current chunk.
+  for (;;) {
+    if (chunk == _currentChunk) {
+      ::memcpy(data + chunk->offset, chunk->getData(), chunk->capacity);
+      break;
+    }
+
+    ::memcpy(data + chunk->offset, chunk->getData(), chunk->length);
+    chunk = chunk->next;
+  }
+
+  // Release all chunks, including the ones kept by `reset()`.
+  chunk = first;
+  while (chunk != nullptr) {
+    Chunk* next = chunk->next;
+    ASMJIT_FREE(chunk);
+    chunk = next;
+  }
+
+  flat->next = nullptr;
+  flat->offset = 0;
+  flat->length = 0;
+  flat->capacity = capacity;
+
+  _firstChunk = flat;
+  _currentChunk = flat;
+  _buffer = data;
+  _end = data + capacity;
+  _cursor = data + offset;
+  _bufferOffset = 0;
+
+  return kErrorOk;
+}
+
+uint8_t* Assembler::_getPtrAtSlow(size_t pos, size_t size) const noexcept {
+  ASMJIT_UNUSED(size);
+
+  // Only called for positions before the current chunk.
+  Chunk* chunk = _firstChunk;
+  while (pos >= chunk->offset + chunk->length)
+    chunk = chunk->next;
+
+  ASMJIT_ASSERT(pos + size <= chunk->offset + chunk->length);
+  return chunk->getData() + (pos - chunk->offset);
+}
+
+uint8_t* Assembler::getBuffer() const noexcept {
+  if (const_cast<Assembler*>(this)->_flatten() != kErrorOk)
+    return nullptr;
+  return _buffer;
+}
+
+void Assembler::copyCode(void* dst, size_t size) const noexcept {
+  uint8_t* p = static_cast<uint8_t*>(dst);
+
+  for (Chunk* chunk = _firstChunk; chunk != nullptr && size != 0; chunk = chunk->next) {
+    bool isCurrent = chunk == _currentChunk;
+    size_t length = isCurrent ? chunk->capacity : chunk->length;
+
+    if (length > size)
+      length = size;
+
+    ::memcpy(p, chunk->getData(), length);
+    p += length;
+    size -= length;
+
+    if (isCurrent)
+      break;
+  }
+}
+
+// ============================================================================
+// [asmjit::Assembler - Sections]
+// ============================================================================
+
+Error Assembler::embedRoData(const Label& label, const void* data, uint32_t size, uint32_t alignment) noexcept {
+  uint8_t* p;
+  ASMJIT_PROPAGATE_ERROR(_allocRoData(&p, label, size, alignment));
+
+  ::memcpy(p, data, size);
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  if (_logger)
+    _logger->logBinary(Logger::kStyleData, p, size);
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  return kErrorOk;
+}
+
+Error Assembler::embedRoConstPool(const Label& label, const ConstPool& pool) noexcept {
+  uint8_t* p;
+  size_t size = pool.getSize();
+  ASMJIT_PROPAGATE_ERROR(_allocRoData(&p, label, size, static_cast<uint32_t>(pool.getAlignment())));
+
+  pool.fill(p);
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  if (_logger)
+    _logger->logBinary(Logger::kStyleData, p, size);
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  return kErrorOk;
+}
+
+Error Assembler::_allocRoData(uint8_t** dst, const Label& label, size_t size, uint32_t alignment) noexcept {
+  Section& section = _sections[kSectionRoData];
+  Buffer& content = section.content;
+
+  if (alignment == 0)
+    alignment = 1;
+  ASMJIT_ASSERT(Utils::isPowerOf2(alignment));
+
+  // Label can be bound only once.
+  uint32_t id = label.getId();
+  if (getLabelData(id)->offset != -1)
+    return setLastError(kErrorLabelAlreadyBound);
+
+  size_t offset = Utils::alignTo<size_t>(content.length, alignment);
+  if (size > IntTraits<size_t>::maxValue() / 2 - offset)
+    return setLastError(kErrorNoHeapMemory);
+
+  size_t after = offset + size;
+  if (after > content.capacity) {
+    size_t capacity = Utils::iMax<size_t>(content.capacity, 256);
+    while (capacity < after)
+      capacity *= 2;
+
+    uint8_t* data = static_cast<uint8_t*>(ASMJIT_REALLOC(content.data, capacity));
+    if (data == nullptr)
+      return setLastError(kErrorNoHeapMemory);
+
+    content.data = data;
+    content.capacity = capacity;
+  }
+
+  // Padding between data is never executed, zero it.
+  ::memset(content.data + content.length, 0, offset - content.length);
+  content.length = after;
+
+  if (section.alignment < alignment)
+    section.alignment = alignment;
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  if (_logger)
+    _logger->logFormat(Logger::kStyleLabel, "L%u: ; %s\n", id, section.name);
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  *dst = content.data + offset;
+  return _bindLabel(id, kSectionRoData, offset);
+}
+
+Error Assembler::_addSectionLink(uint32_t sectionId, size_t offset, uint32_t size) noexcept {
+  SectionLink link;
+  link.sectionId = sectionId;
+  link.size = size;
+  link.offset = offset;
+
+  if (_sectionLinks.append(link) != kErrorOk)
+    return setLastError(kErrorNoHeapMemory);
+  return kErrorOk;
+}
+
+void Assembler::_relocSections(uint8_t* dst) const noexcept {
+  const Buffer& roData = _sections[kSectionRoData].content;
+  if (roData.length == 0)
+    return;
+
+  size_t offset = getOffset();
+  size_t roDataOffset = getRoDataOffset();
+
+  ::memset(dst + offset, 0, roDataOffset - offset);
+  ::memcpy(dst + roDataOffset, roData.data, roData.length);
+
+  size_t count = _sectionLinks.getLength();
+  const SectionLink* links = _sectionLinks.getData();
+
+  for (size_t i = 0; i < count; i++) {
+    const SectionLink& link = links[i];
+    uint8_t* p = dst + link.offset;
+
+    ASMJIT_ASSERT(link.sectionId == kSectionRoData);
+    if (link.size == 4)
+      Utils::writeU32u(p, Utils::readU32u(p) + static_cast<uint32_t>(roDataOffset));
+    else
+      Utils::writeU64u(p, Utils::readU64u(p) + static_cast<uint64_t>(roDataOffset));
+  }
+}
+
 // ============================================================================
 // [asmjit::Assembler - Label]
 // ============================================================================
@@ -268,6 +558,7 @@ Error Assembler::_newLabelId() noexcept {
 
   data->offset = -1;
   data->links = nullptr;
+  data->sectionId = kSectionText;
   data->exId = 0;
   data->exData = nullptr;
 
@@ -325,8 +616,12 @@ Error Assembler::bind(const Label& label) noexcept {
   }
 #endif // !ASMJIT_DISABLE_LOGGER
 
+  return _bindLabel(index, kSectionText, getOffset());
+}
+
+Error Assembler::_bindLabel(uint32_t id, uint32_t sectionId, size_t pos) noexcept {
+  LabelData* data = getLabelData(id);
   Error error = kErrorOk;
-  size_t pos = getOffset();
 
   LabelLink* link = data->links;
   LabelLink* prev = nullptr;
@@ -337,7 +632,11 @@ Error Assembler::bind(const Label& label) noexcept {
     if (link->relocId != -1) {
       // Handle RelocData - We have to update RelocData information instead of
       // patching the displacement in LabelData.
-      _relocations[link->relocId].data += static_cast<Ptr>(pos);
+      RelocData& rd = _relocations[link->relocId];
+      rd.data += static_cast<Ptr>(pos);
+
+      if (sectionId != kSectionText && _addSectionLink(sectionId, static_cast<size_t>(rd.from), rd.size) != kErrorOk)
+        error = kErrorNoHeapMemory;
     }
     else {
       // Not using relocId, this means that we are overwriting a real
@@ -351,10 +650,14 @@ Error Assembler::bind(const Label& label) noexcept {
 
       if (size == 4) {
         writeI32At(offset, patchedValue);
+
+        // The displacement is relative to the start of the section for now.
+        if (sectionId != kSectionText && _addSectionLink(sectionId, static_cast<size_t>(offset), 4) != kErrorOk)
+          error = kErrorNoHeapMemory;
       }
       else {
         ASMJIT_ASSERT(size == 1);
-        if (Utils::isInt8(patchedValue))
+        if (sectionId == kSectionText && Utils::isInt8(patchedValue))
           writeU8At(offset, static_cast<uint32_t>(patchedValue) & 0xFF);
         else
           error = kErrorIllegalDisplacement;
@@ -378,6 +681,7 @@ Error Assembler::bind(const Label& label) noexcept {
   // Set as bound (offset is zero or greater and no links).
   data->offset = pos;
   data->links = nullptr;
+  data->sectionId = sectionId;
 
   if (error != kErrorOk)
     return setLastError(error);
@@ -419,6 +723,20 @@ size_t Assembler::relocCode(void* dst, Ptr baseAddress) const noexcept {
   return _relocCode(dst, baseAddress);
 }
 
+// ============================================================================
+// [asmjit::Assembler - Relax]
+// ============================================================================
+
+Error Assembler::relax() noexcept {
+  if (!hasAsmOption(kOptionRelaxJumps) || _relaxItems.isEmpty())
+    return kErrorOk;
+  return _relax();
+}
+
+Error Assembler::_relax() noexcept {
+  return kErrorOk;
+}
+
 // ============================================================================
 // [asmjit::Assembler - Make]
 // ============================================================================
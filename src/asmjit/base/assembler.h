@@ -9,6 +9,7 @@
 #define _ASMJIT_BASE_ASSEMBLER_H
 
 // [Dependencies]
+#include "../base/constpool.h"
 #include "../base/containers.h"
 #include "../base/logger.h"
 #include "../base/operand.h"
@@ -142,6 +143,25 @@ ASMJIT_ENUM(AlignMode) {
   kAlignZero = 2
 };
 
+// ============================================================================
+// [asmjit::SectionId]
+// ============================================================================
+
+//! Assembler section.
+//!
+//! Code is always emitted into `.text`, read-only data can be placed to
+//! `.rodata` by `Assembler::embedRoData()` or `Assembler::embedRoConstPool()`
+//! so it doesn't share cache lines with the code. Sections are laid out by
+//! `Assembler::relocCode()` in the order of their ids.
+ASMJIT_ENUM(SectionId) {
+  //! Code section.
+  kSectionText = 0,
+  //! Read-only data section.
+  kSectionRoData = 1,
+  //! Count of sections.
+  kSectionCount = 2
+};
+
 // ============================================================================
 // [asmjit::RelocMode]
 // ============================================================================
@@ -188,6 +208,8 @@ struct LabelData {
   intptr_t offset;
   //! Label links chain.
   LabelLink* links;
+  //! Section the label is bound to, see \ref SectionId.
+  uint32_t sectionId;
 
   //! External tool ID, if linked to any.
   uint64_t exId;
@@ -195,6 +217,64 @@ struct LabelData {
   void* exData;
 };
 
+// ============================================================================
+// [asmjit::SectionLink]
+// ============================================================================
+
+//! \internal
+//!
+//! Reference from `.text` to a label bound in another section.
+//!
+//! The position of the section is not known until the sections are laid out,
+//! so `relocCode()` adds the offset of the section to the value at `offset`
+//! after the code has been relocated.
+struct SectionLink {
+  //! Section id, see \ref SectionId.
+  uint32_t sectionId;
+  //! Size of the value (4 or 8 bytes).
+  uint32_t size;
+  //! Offset of the value in `.text`.
+  size_t offset;
+};
+
+// ============================================================================
+// [asmjit::RelaxItem]
+// ============================================================================
+
+//! \internal
+//!
+//! Jump or alignment recorded by `Assembler::kOptionRelaxJumps`.
+struct RelaxItem {
+  //! Target of a jump, `nullptr` if the item is an alignment.
+  LabelData* label;
+  //! Alignment mode (alignment only).
+  uint32_t alignMode;
+  //! Alignment (alignment only).
+  uint32_t alignment;
+  //! Offset of the jump or the padding.
+  size_t offset;
+  //! Size of the jump or the padding.
+  size_t size;
+};
+
+// ============================================================================
+// [asmjit::RelaxRef]
+// ============================================================================
+
+//! \internal
+//!
+//! PC-relative reference to a label recorded by `Assembler::kOptionRelaxJumps`.
+struct RelaxRef {
+  //! Referenced label.
+  LabelData* label;
+  //! Size of the displacement (1 or 4 bytes).
+  uint32_t size;
+  //! Offset of the displacement.
+  size_t offset;
+  //! Offset the displacement is relative to (end of the instruction).
+  size_t base;
+};
+
 // ============================================================================
 // [asmjit::RelocData]
 // ============================================================================
@@ -418,7 +498,7 @@ class ASMJIT_VIRTAPI Assembler {
   ASMJIT_ENUM(Options) {
     //! Emit optimized code-alignment sequences (`Assembler` and `Compiler`).
     //!
-    //! Default `true`.
+    //! Default `false`.
     //!
     //! X86/X64 Specific
     //! ----------------
@@ -430,7 +510,7 @@ class ASMJIT_VIRTAPI Assembler {
     //! for alignment between 1 to 11 bytes. Also when `X86Compiler` is used,
     //! it can add REX prefixes into the code to make some instructions greater
     //! so no alignment sequence is needed.
-    kOptionOptimizedAlign = 0,
+    kOptionOptimizedAlign = 4,
 
     //! Emit jump-prediction hints (`Assembler` and `Compiler`).
     //!
@@ -449,7 +529,41 @@ class ASMJIT_VIRTAPI Assembler {
     //! This feature is disabled by default, because the only processor that
     //! used to take into consideration prediction hints was P4. Newer processors
     //! implement heuristics for branch prediction that ignores any static hints.
-    kOptionPredictedJumps = 1
+    kOptionPredictedJumps = 1,
+
+    //! Relax forward jumps (`Assembler` and `Compiler`).
+    //!
+    //! Default `false`.
+    //!
+    //! A jump to a label that is not bound yet has to be emitted in its long
+    //! form unless the short form is requested explicitly. If this option is
+    //! enabled all such jumps and alignments are recorded and `relax()` uses
+    //! the short form for every jump whose target ends up close enough. Label
+    //! offsets and relocations are updated.
+    //!
+    //! `relax()` is called by runtimes before the code is relocated. It expects
+    //! that all PC-relative references in the code were created through labels,
+    //! the code must not be patched through `setOffset()` when this option is
+    //! used.
+    kOptionRelaxJumps = 2,
+
+    //! Validate instructions before they are emitted (`Assembler` and `Compiler`).
+    //!
+    //! Default `false`.
+    //!
+    //! Operands of each instruction are checked against the instruction table,
+    //! together with the target architecture and CPU features provided by the
+    //! runtime's \ref CpuInfo. An invalid instruction is not emitted and the
+    //! error is reported through `setLastError()` (and the error handler). The
+    //! `Compiler` validates instructions when they are added, so errors are
+    //! reported at the place where they are made, not during `finalize()`.
+    //!
+    //! X86/X64 Specific
+    //! ----------------
+    //!
+    //! See `X86Util::validateInst()`, which can be also used to validate
+    //! instructions without emitting them, and `X86Compiler::validate()`.
+    kOptionStrictValidation = 8
   };
 
   // --------------------------------------------------------------------------
@@ -468,13 +582,49 @@ class ASMJIT_VIRTAPI Assembler {
     size_t offset;
   };
 
+  // --------------------------------------------------------------------------
+  // [Chunk]
+  // --------------------------------------------------------------------------
+
+  //! \internal
+  //!
+  //! Chunk of the code-buffer.
+  //!
+  //! The code-buffer is a linked list of chunks, so growing it never copies
+  //! code that has already been emitted. The first chunk grows like a regular
+  //! buffer up to `kChunkSize`, then fixed-size chunks are appended. Anything
+  //! emitted by a single call (instruction, alignment, embedded data) never
+  //! crosses a chunk boundary.
+  struct Chunk {
+    //! Get chunk data.
+    ASMJIT_INLINE uint8_t* getData() const noexcept {
+      return reinterpret_cast<uint8_t*>(const_cast<Chunk*>(this + 1));
+    }
+
+    //! Next chunk.
+    Chunk* next;
+    //! Offset of the chunk in the code-buffer.
+    size_t offset;
+    //! Number of bytes used (not valid for the current chunk).
+    size_t length;
+    //! Capacity of the chunk.
+    size_t capacity;
+  };
+
+  enum {
+    //! Size of a single chunk allocation (including `Chunk` header).
+    kChunkSize = 65536 - static_cast<int>(kMemAllocOverhead)
+  };
+
   // --------------------------------------------------------------------------
   // [Section]
   // --------------------------------------------------------------------------
 
   //! Code or data section.
+  //!
+  //! NOTE: Content of `.text` is the code-buffer, its `content` is not used.
   struct Section {
-    //! Section id.
+    //! Section id, see \ref SectionId.
     uint32_t id;
     //! Section flags.
     uint32_t flags;
@@ -632,24 +782,52 @@ class ASMJIT_VIRTAPI Assembler {
   //! Grow the code-buffer.
   //!
   //! The internal code-buffer will grow at least by `n` bytes so `n` bytes can
-  //! be added to it. If `n` is zero or `getOffset() + n` is not greater than
-  //! the current capacity of the code-buffer this function does nothing.
+  //! be added to it at the cursor. If `n` bytes fit into the current chunk this
+  //! function does nothing, otherwise the cursor moves to a new chunk.
   ASMJIT_API Error _grow(size_t n) noexcept;
   //! Reserve the code-buffer to at least `n` bytes.
   ASMJIT_API Error _reserve(size_t n) noexcept;
+  //! \internal
+  //!
+  //! Move all chunks into a single one.
+  ASMJIT_API Error _flatten() noexcept;
+
+  //! \internal
+  //!
+  //! Get pointer to `size` bytes at `pos`.
+  ASMJIT_INLINE uint8_t* _getPtrAt(size_t pos, size_t size) const noexcept {
+    ASMJIT_ASSERT(pos + size <= getCapacity());
+    if (ASMJIT_UNLIKELY(pos < _bufferOffset))
+      return _getPtrAtSlow(pos, size);
+    return _buffer + (pos - _bufferOffset);
+  }
+  //! \internal
+  ASMJIT_API uint8_t* _getPtrAtSlow(size_t pos, size_t size) const noexcept;
+
+  //! \internal
+  //!
+  //! Get offset of `p`, which points to the current chunk.
+  ASMJIT_INLINE size_t _getOffsetOf(const uint8_t* p) const noexcept {
+    return _bufferOffset + (size_t)(p - _buffer);
+  }
+
+  //! Copy the first `size` bytes of the code-buffer to `dst`.
+  ASMJIT_API void copyCode(void* dst, size_t size) const noexcept;
 
   //! Get capacity of the code-buffer.
   ASMJIT_INLINE size_t getCapacity() const noexcept {
-    return (size_t)(_end - _buffer);
+    return _bufferOffset + (size_t)(_end - _buffer);
   }
   //! Get the number of remaining bytes in code-buffer.
   ASMJIT_INLINE size_t getRemainingSpace() const noexcept {
     return (size_t)(_end - _cursor);
   }
 
-  //! Get current offset in buffer, same as `getOffset() + getTramplineSize()`.
+  //! Get size of the relocated code, including all sections and trampolines.
+  //!
+  //! Without `.rodata` it's the same as `getOffset() + getTrampolinesSize()`.
   ASMJIT_INLINE size_t getCodeSize() const noexcept {
-    return getOffset() + getTrampolinesSize();
+    return getRoDataOffset() + _sections[kSectionRoData].content.length + getTrampolinesSize();
   }
 
   //! Get size of all possible trampolines.
@@ -661,8 +839,12 @@ class ASMJIT_VIRTAPI Assembler {
   ASMJIT_INLINE size_t getTrampolinesSize() const noexcept { return _trampolinesSize; }
 
   //! Get code-buffer.
-  ASMJIT_INLINE uint8_t* getBuffer() const noexcept { return _buffer; }
-  //! Get the end of the code-buffer (points to the first byte that is invalid).
+  //!
+  //! NOTE: If the code-buffer consists of more than one chunk all chunks are
+  //! moved into a single one first, which copies the whole code. Use
+  //! `copyCode()` or `relocCode()` to get the code without copying it twice.
+  ASMJIT_API uint8_t* getBuffer() const noexcept;
+  //! Get the end of the current chunk (points to the first byte that is invalid).
   ASMJIT_INLINE uint8_t* getEnd() const noexcept { return _end; }
 
   //! Get the current position in the code-buffer.
@@ -674,110 +856,100 @@ class ASMJIT_VIRTAPI Assembler {
   }
 
   //! Get the current offset in the buffer.
-  ASMJIT_INLINE size_t getOffset() const noexcept { return (size_t)(_cursor - _buffer); }
+  ASMJIT_INLINE size_t getOffset() const noexcept { return _getOffsetOf(_cursor); }
   //! Set the current offset in the buffer to `offset` and return the previous value.
+  //!
+  //! NOTE: Setting the offset before the current chunk moves all chunks into
+  //! a single one.
   ASMJIT_INLINE size_t setOffset(size_t offset) noexcept {
     ASMJIT_ASSERT(offset < getCapacity());
 
-    size_t oldOffset = (size_t)(_cursor - _buffer);
-    _cursor = _buffer + offset;
+    size_t oldOffset = getOffset();
+    if (ASMJIT_UNLIKELY(offset < _bufferOffset) && _flatten() != kErrorOk)
+      return oldOffset;
+
+    _cursor = _buffer + (offset - _bufferOffset);
     return oldOffset;
   }
 
   //! Read `int8_t` at index `pos`.
   ASMJIT_INLINE int32_t readI8At(size_t pos) const noexcept {
-    ASMJIT_ASSERT(pos + 1 <= (size_t)(_end - _buffer));
-    return Utils::readI8(_buffer + pos);
+    return Utils::readI8(_getPtrAt(pos, 1));
   }
 
   //! Read `uint8_t` at index `pos`.
   ASMJIT_INLINE uint32_t readU8At(size_t pos) const noexcept {
-    ASMJIT_ASSERT(pos + 1 <= (size_t)(_end - _buffer));
-    return Utils::readU8(_buffer + pos);
+    return Utils::readU8(_getPtrAt(pos, 1));
   }
 
   //! Read `int16_t` at index `pos`.
   ASMJIT_INLINE int32_t readI16At(size_t pos) const noexcept {
-    ASMJIT_ASSERT(pos + 2 <= (size_t)(_end - _buffer));
-    return Utils::readI16u(_buffer + pos);
+    return Utils::readI16u(_getPtrAt(pos, 2));
   }
 
   //! Read `uint16_t` at index `pos`.
   ASMJIT_INLINE uint32_t readU16At(size_t pos) const noexcept {
-    ASMJIT_ASSERT(pos + 2 <= (size_t)(_end - _buffer));
-    return Utils::readU16u(_buffer + pos);
+    return Utils::readU16u(_getPtrAt(pos, 2));
   }
 
   //! Read `int32_t` at index `pos`.
   ASMJIT_INLINE int32_t readI32At(size_t pos) const noexcept {
-    ASMJIT_ASSERT(pos + 4 <= (size_t)(_end - _buffer));
-    return Utils::readI32u(_buffer + pos);
+    return Utils::readI32u(_getPtrAt(pos, 4));
   }
 
   //! Read `uint32_t` at index `pos`.
   ASMJIT_INLINE uint32_t readU32At(size_t pos) const noexcept {
-    ASMJIT_ASSERT(pos + 4 <= (size_t)(_end - _buffer));
-    return Utils::readU32u(_buffer + pos);
+    return Utils::readU32u(_getPtrAt(pos, 4));
   }
 
   //! Read `uint64_t` at index `pos`.
   ASMJIT_INLINE int64_t readI64At(size_t pos) const noexcept {
-    ASMJIT_ASSERT(pos + 8 <= (size_t)(_end - _buffer));
-    return Utils::readI64u(_buffer + pos);
+    return Utils::readI64u(_getPtrAt(pos, 8));
   }
 
   //! Read `uint64_t` at index `pos`.
   ASMJIT_INLINE uint64_t readU64At(size_t pos) const noexcept {
-    ASMJIT_ASSERT(pos + 8 <= (size_t)(_end - _buffer));
-    return Utils::readU64u(_buffer + pos);
+    return Utils::readU64u(_getPtrAt(pos, 8));
   }
 
   //! Write `int8_t` at index `pos`.
   ASMJIT_INLINE void writeI8At(size_t pos, int32_t x) noexcept {
-    ASMJIT_ASSERT(pos + 1 <= (size_t)(_end - _buffer));
-    Utils::writeI8(_buffer + pos, x);
+    Utils::writeI8(_getPtrAt(pos, 1), x);
   }
 
   //! Write `uint8_t` at index `pos`.
   ASMJIT_INLINE void writeU8At(size_t pos, uint32_t x) noexcept {
-    ASMJIT_ASSERT(pos + 1 <= (size_t)(_end - _buffer));
-    Utils::writeU8(_buffer + pos, x);
+    Utils::writeU8(_getPtrAt(pos, 1), x);
   }
 
   //! Write `int8_t` at index `pos`.
   ASMJIT_INLINE void writeI16At(size_t pos, int32_t x) noexcept {
-    ASMJIT_ASSERT(pos + 2 <= (size_t)(_end - _buffer));
-    Utils::writeI16u(_buffer + pos, x);
+    Utils::writeI16u(_getPtrAt(pos, 2), x);
   }
 
   //! Write `uint8_t` at index `pos`.
   ASMJIT_INLINE void writeU16At(size_t pos, uint32_t x) noexcept {
-    ASMJIT_ASSERT(pos + 2 <= (size_t)(_end - _buffer));
-    Utils::writeU16u(_buffer + pos, x);
+    Utils::writeU16u(_getPtrAt(pos, 2), x);
   }
 
   //! Write `int32_t` at index `pos`.
   ASMJIT_INLINE void writeI32At(size_t pos, int32_t x) noexcept {
-    ASMJIT_ASSERT(pos + 4 <= (size_t)(_end - _buffer));
-    Utils::writeI32u(_buffer + pos, x);
+    Utils::writeI32u(_getPtrAt(pos, 4), x);
   }
 
   //! Write `uint32_t` at index `pos`.
   ASMJIT_INLINE void writeU32At(size_t pos, uint32_t x) noexcept {
-    ASMJIT_ASSERT(pos + 4 <= (size_t)(_end - _buffer));
-    Utils::writeU32u(_buffer + pos, x);
+    Utils::writeU32u(_getPtrAt(pos, 4), x);
   }
 
   //! Write `int64_t` at index `pos`.
   ASMJIT_INLINE void writeI64At(size_t pos, int64_t x) noexcept {
-    ASMJIT_ASSERT(pos + 8 <= (size_t)(_end - _buffer));
-    Utils::writeI64u(_buffer + pos, x);
+    Utils::writeI64u(_getPtrAt(pos, 8), x);
   }
 
   //! Write `uint64_t` at index `pos`.
   ASMJIT_INLINE void writeU64At(size_t pos, uint64_t x) noexcept {
-    ASMJIT_ASSERT(pos + 8 <= (size_t)(_end - _buffer));
-    Utils::writeU64u(_buffer + pos, x);
+    Utils::writeU64u(_getPtrAt(pos, 8), x);
   }
 
   // --------------------------------------------------------------------------
@@ -787,6 +959,62 @@ class ASMJIT_VIRTAPI Assembler {
   //! Embed raw data into the code-buffer.
   ASMJIT_API virtual Error embed(const void* data, uint32_t size) noexcept;
 
+  // --------------------------------------------------------------------------
+  // [Sections]
+  // --------------------------------------------------------------------------
+
+  //! Get section `id`, see \ref SectionId.
+  ASMJIT_INLINE const Section& getSection(uint32_t id) const noexcept {
+    ASMJIT_ASSERT(id < kSectionCount);
+    return _sections[id];
+  }
+
+  //! Get offset of `.rodata` in the relocated code.
+  //!
+  //! The section follows `.text` aligned to the highest alignment of its data,
+  //! the alignment is relative to the start of the code.
+  ASMJIT_INLINE size_t getRoDataOffset() const noexcept {
+    const Section& section = _sections[kSectionRoData];
+    size_t offset = getOffset();
+
+    if (section.content.length == 0)
+      return offset;
+    return Utils::alignTo<size_t>(offset, section.alignment);
+  }
+
+  //! Embed `size` bytes of `data` into `.rodata` and bind `label` to them.
+  //!
+  //! The data is aligned to `alignment`, which must be a power of 2. The label
+  //! can be used by memory operands and `embedLabel()`, but not as a jump or
+  //! call target.
+  ASMJIT_API Error embedRoData(const Label& label, const void* data, uint32_t size, uint32_t alignment = 16) noexcept;
+  //! Embed constant `pool` into `.rodata` and bind `label` to it.
+  ASMJIT_API Error embedRoConstPool(const Label& label, const ConstPool& pool) noexcept;
+
+  //! \internal
+  //!
+  //! Reserve `size` bytes in `.rodata` aligned to `alignment`, bind `label`
+  //! to them and return their address in `dst`.
+  ASMJIT_API Error _allocRoData(uint8_t** dst, const Label& label, size_t size, uint32_t alignment) noexcept;
+
+  //! \internal
+  //!
+  //! Record a reference at `offset` in case that `label` is bound outside of
+  //! `.text`.
+  ASMJIT_INLINE Error _linkSection(const LabelData* label, size_t offset, uint32_t size) noexcept {
+    if (ASMJIT_LIKELY(label->sectionId == kSectionText))
+      return kErrorOk;
+    return _addSectionLink(label->sectionId, offset, size);
+  }
+  //! \internal
+  ASMJIT_API Error _addSectionLink(uint32_t sectionId, size_t offset, uint32_t size) noexcept;
+
+  //! \internal
+  //!
+  //! Add the offsets of sections laid out by `relocCode()` to all references
+  //! in `dst`.
+  ASMJIT_API void _relocSections(uint8_t* dst) const noexcept;
+
   // --------------------------------------------------------------------------
   // [Align]
   // --------------------------------------------------------------------------
@@ -860,6 +1088,11 @@ class ASMJIT_VIRTAPI Assembler {
   //! New LabelLink instance.
   ASMJIT_API LabelLink* _newLabelLink() noexcept;
 
+  //! \internal
+  //!
+  //! Bind label `id` to `pos` in section `sectionId` and patch all its links.
+  ASMJIT_API Error _bindLabel(uint32_t id, uint32_t sectionId, size_t pos) noexcept;
+
   //! Create and return a new `Label`.
   ASMJIT_INLINE Label newLabel() noexcept { return Label(_newLabelId()); }
 
@@ -896,6 +1129,65 @@ class ASMJIT_VIRTAPI Assembler {
   //! Reloc code.
   virtual size_t _relocCode(void* dst, Ptr baseAddress) const noexcept = 0;
 
+  // --------------------------------------------------------------------------
+  // [Relax]
+  // --------------------------------------------------------------------------
+
+  //! Relax jumps recorded by `kOptionRelaxJumps`.
+  //!
+  //! Does nothing if the option is not enabled or if some referenced label is
+  //! not bound yet. Called by runtimes before `getCodeSize()`, it's only needed
+  //! to call it explicitly before reading label offsets or before calling
+  //! `relocCode()` directly.
+  ASMJIT_API Error relax() noexcept;
+
+  //! \internal
+  //!
+  //! Relax code.
+  //!
+  //! The default implementation does nothing and keeps the code as emitted.
+  ASMJIT_API virtual Error _relax() noexcept;
+
+  //! \internal
+  //!
+  //! Record a jump or an alignment at `offset` if jumps are relaxed.
+  ASMJIT_INLINE Error _relaxItem(LabelData* label, size_t offset, size_t size, uint32_t alignMode = 0, uint32_t alignment = 0) noexcept {
+    if (ASMJIT_LIKELY(!hasAsmOption(kOptionRelaxJumps)))
+      return kErrorOk;
+
+    RelaxItem item;
+    item.label = label;
+    item.alignMode = alignMode;
+    item.alignment = alignment;
+    item.offset = offset;
+    item.size = size;
+
+    if (_relaxItems.append(item) != kErrorOk)
+      return setLastError(kErrorNoHeapMemory);
+    return kErrorOk;
+  }
+
+  //! \internal
+  //!
+  //! Record a PC-relative reference to `label` if jumps are relaxed.
+  //!
+  //! The displacement of `size` bytes at `offset` is relative to the end of
+  //! the instruction, which is followed by `tail` bytes of an immediate.
+  ASMJIT_INLINE Error _relaxRef(LabelData* label, size_t offset, uint32_t size, uint32_t tail = 0) noexcept {
+    if (ASMJIT_LIKELY(!hasAsmOption(kOptionRelaxJumps)))
+      return kErrorOk;
+
+    RelaxRef ref;
+    ref.label = label;
+    ref.size = size;
+    ref.offset = offset;
+    ref.base = offset + size + tail;
+
+    if (_relaxRefs.append(ref) != kErrorOk)
+      return setLastError(kErrorNoHeapMemory);
+    return kErrorOk;
+  }
+
   // --------------------------------------------------------------------------
   // [Make]
   // --------------------------------------------------------------------------
@@ -971,12 +1263,19 @@ class ASMJIT_VIRTAPI Assembler {
   //! General purpose zone allocator.
   Zone _zoneAllocator;
 
-  //! Start of the code-buffer of the current section.
+  //! Start of the current chunk of the code-buffer.
   uint8_t* _buffer;
-  //! End of the code-buffer of the current section (points to the first invalid byte).
+  //! End of the current chunk of the code-buffer (points to the first invalid byte).
   uint8_t* _end;
-  //! The current position in `_buffer` of the current section.
+  //! The current position in `_buffer`.
   uint8_t* _cursor;
+  //! Offset of `_buffer` in the code-buffer.
+  size_t _bufferOffset;
+
+  //! First chunk of the code-buffer.
+  Chunk* _firstChunk;
+  //! Current chunk of the code-buffer, chunks after it are unused.
+  Chunk* _currentChunk;
 
   //! Size of all possible trampolines.
   uint32_t _trampolinesSize;
@@ -987,11 +1286,17 @@ class ASMJIT_VIRTAPI Assembler {
   LabelLink* _unusedLinks;
 
   //! Assembler sections.
-  PodVectorTmp<Section*, 4> _sections;
+  Section _sections[kSectionCount];
   //! Assembler labels.
   PodVectorTmp<LabelData*, 16> _labels;
   //! Table of relocations.
   PodVector<RelocData> _relocations;
+  //! References from `.text` to labels bound in other sections.
+  PodVector<SectionLink> _sectionLinks;
+  //! Jumps and alignments to relax, see `kOptionRelaxJumps`.
+  PodVector<RelaxItem> _relaxItems;
+  //! PC-relative references to labels, see `kOptionRelaxJumps`.
+  PodVector<RelaxRef> _relaxRefs;
 };
 
 //! \}
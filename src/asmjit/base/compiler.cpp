@@ -39,6 +39,9 @@ enum { kCompilerDefaultLookAhead = 64 };
 Compiler::Compiler() noexcept
   : _features(0),
     _maxLookAhead(kCompilerDefaultLookAhead),
+    _loopAlign(0),
+    _jumpBoundary(0),
+    _threadCount(0),
     _instOptions(0),
     _tokenGenerator(0),
     _nodeFlowId(0),
@@ -72,6 +75,9 @@ void Compiler::reset(bool releaseMemory) noexcept {
 
   _features = 0;
   _maxLookAhead = kCompilerDefaultLookAhead;
+  _loopAlign = 0;
+  _jumpBoundary = 0;
+  _threadCount = 0;
 
   _instOptions = 0;
   _tokenGenerator = 0;
@@ -432,6 +438,17 @@ Error Compiler::embedConstPool(const Label& label, const ConstPool& pool) noexce
   return kErrorOk;
 }
 
+Error Compiler::embedRoConstPool(const Label& label, const ConstPool& pool) noexcept {
+  if (label.getId() == kInvalidValue)
+    return kErrorInvalidState;
+
+  Assembler* assembler = getAssembler();
+  if (assembler == nullptr)
+    return kErrorNotInitialized;
+
+  return assembler->embedRoConstPool(label, pool);
+}
+
 // ============================================================================
 // [asmjit::Compiler - Comment]
 // ============================================================================
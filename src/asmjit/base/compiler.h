@@ -52,12 +52,59 @@ ASMJIT_ENUM(CompilerFeatures) {
   //! X86/X64 Specific
   //! ----------------
   //!
-  //! If scheduling is enabled AsmJit will try to reorder instructions to
-  //! minimize the dependency chain. Scheduler always runs after the registers
-  //! are allocated so it doesn't change count of register allocs/spills.
+  //! If scheduling is enabled AsmJit reorders instructions within each basic
+  //! block before the registers are allocated. A list scheduler uses a small
+  //! latency model to start long-latency operations (loads, multiplications,
+  //! divisions) early and to interleave independent dependency chains.
+  //! Dependencies are derived from variables, memory operands and EFLAGS
+  //! read/written by each instruction. Instructions that use physical
+  //! registers, volatile instructions, calls, hints and labels are never
+  //! moved and split the block into independent regions.
   //!
-  //! This feature is highly experimental and untested.
-  kCompilerFeatureEnableScheduler = 0
+  //! The scheduler runs after the liveness analysis and before the registers
+  //! are allocated. It tracks variables alive at each point and defers
+  //! instructions that would make more variables alive than there are
+  //! registers. A region whose new order still needs spills keeps its
+  //! original order unless the new order needs fewer of them, so the
+  //! scheduler doesn't introduce spills.
+  kCompilerFeatureEnableScheduler = 0,
+
+  //! Use a linear-scan register allocator (default false).
+  //!
+  //! When enabled the compiler builds live intervals from the liveness
+  //! analysis and assigns registers to them by a linear scan over the whole
+  //! function before the code is translated. Intervals that cannot keep a
+  //! single register are split. The translator then follows the assignment,
+  //! and the moves on block edges are resolved the same way as without this
+  //! feature.
+  //!
+  //! The result is usually smaller code with less spills on large functions
+  //! with many variables, which are typical for generated code.
+  kCompilerFeatureLinearScan = 1,
+
+  //! Run a peephole optimizer over the translated code (default false).
+  //!
+  //! The optimizer runs after registers are allocated and before the code
+  //! is serialized. It removes moves of a register to itself and jumps to
+  //! the next instruction, forwards a register stored to a spill slot to
+  //! the load that immediately follows, removes zeroing by `xor` that is
+  //! overwritten, and zeroes registers by `xor` instead of `mov` if flags
+  //! are not read afterwards.
+  kCompilerFeaturePeephole = 2,
+
+  //! Reuse values computed by earlier instructions (default false).
+  //!
+  //! When enabled the compiler numbers values computed by instructions that
+  //! don't have side effects (loads, `lea`, moves and AVX operations) before
+  //! anything else is done. An instruction that computes the same value as
+  //! an earlier one from unchanged sources is removed and its variable is
+  //! replaced by the variable that already holds the value. If the variable
+  //! can't be replaced the instruction becomes a register move. Values loaded
+  //! from memory are not reused after any memory write.
+  //!
+  //! Values are only reused within a sequence of instructions that doesn't
+  //! contain labels, jumps, calls or hints.
+  kCompilerFeatureValueNumbering = 3
 };
 
 // ============================================================================
@@ -180,8 +227,8 @@ class ASMJIT_VIRTAPI Compiler : public ExternalTool {
   //! Set code-generator `feature` to `value`.
   ASMJIT_INLINE void setFeature(uint32_t feature, bool value) noexcept {
     ASMJIT_ASSERT(feature < 32);
-    feature = static_cast<uint32_t>(value) << feature;
-    _features = (_features & ~feature) | feature;
+    uint32_t mask = static_cast<uint32_t>(1) << feature;
+    _features = (_features & ~mask) | (static_cast<uint32_t>(value) << feature);
   }
 
   //! Get maximum look ahead.
@@ -193,6 +240,73 @@ class ASMJIT_VIRTAPI Compiler : public ExternalTool {
     _maxLookAhead = val;
   }
 
+  //! Get alignment of loop headers (0 if loops are not aligned).
+  ASMJIT_INLINE uint32_t getLoopAlign() const noexcept {
+    return _loopAlign;
+  }
+  //! Set alignment of loop headers to `alignment` (power of 2 up to 64, 0 to
+  //! disable).
+  //!
+  //! A loop header is a label targeted by a jump that follows it. The padding
+  //! is emitted before the label as `kAlignCode`, so it's only executed when
+  //! the loop is entered. Enable `Assembler::kOptionOptimizedAlign` to pad by
+  //! multi-byte NOPs instead of a sequence of one-byte NOPs.
+  ASMJIT_INLINE Error setLoopAlign(uint32_t alignment) noexcept {
+    if (alignment != 0 && (!Utils::isPowerOf2(alignment) || alignment > 64))
+      return kErrorInvalidArgument;
+
+    _loopAlign = static_cast<uint8_t>(alignment);
+    return kErrorOk;
+  }
+
+  //! Get the boundary that jumps must not cross (0 if disabled).
+  ASMJIT_INLINE uint32_t getJumpBoundary() const noexcept {
+    return _jumpBoundary;
+  }
+  //! Set the boundary that jumps must not cross or end at to `boundary`
+  //! (power of 2 between 16 and 64, 0 to disable).
+  //!
+  //! X86/X64 Specific
+  //! ----------------
+  //!
+  //! Jumps, calls, returns and macro-fused `cmp|test|add|sub|and|inc|dec+jcc`
+  //! pairs are padded by `kAlignCode` so they don't cross or end at the
+  //! boundary. The boundary of 32 bytes avoids the JCC erratum of Skylake
+  //! derived CPUs, where such jumps can't be cached in the decoded icache.
+  //!
+  //! NOTE: The padding is computed before `Assembler::relax()`, so it's only
+  //! guaranteed if `Assembler::kOptionRelaxJumps` is not used.
+  ASMJIT_INLINE Error setJumpBoundary(uint32_t boundary) noexcept {
+    if (boundary != 0 && (!Utils::isPowerOf2(boundary) || boundary < 16 || boundary > 64))
+      return kErrorInvalidArgument;
+
+    _jumpBoundary = static_cast<uint8_t>(boundary);
+    return kErrorOk;
+  }
+
+  //! Get count of threads used by `finalize()` (0 or 1 if single-threaded).
+  ASMJIT_INLINE uint32_t getThreadCount() const noexcept {
+    return _threadCount;
+  }
+  //! Set count of threads used by `finalize()` to `count` (up to 64, 0 or 1
+  //! to disable).
+  //!
+  //! Functions are fetched, translated and serialized in their original order
+  //! by the calling thread, but the analysis of up to `count` functions (CFG,
+  //! liveness and linear-scan) runs in parallel, each function having its own
+  //! `Context` and `Zone`. The output is the same as the output of the
+  //! single-threaded `finalize()`.
+  //!
+  //! NOTE: Worker threads are started by each `finalize()` call, so it only
+  //! pays off for code containing many (or large) functions.
+  ASMJIT_INLINE Error setThreadCount(uint32_t count) noexcept {
+    if (count > 64)
+      return kErrorInvalidArgument;
+
+    _threadCount = static_cast<uint8_t>(count);
+    return kErrorOk;
+  }
+
   // --------------------------------------------------------------------------
   // [Token ID]
   // --------------------------------------------------------------------------
@@ -389,6 +503,15 @@ class ASMJIT_VIRTAPI Compiler : public ExternalTool {
   //!   3. Constant pool data.
   ASMJIT_API Error embedConstPool(const Label& label, const ConstPool& pool) noexcept;
 
+  //! Embed a constant pool data to `.rodata` section of the assembler and
+  //! bind `label` to it, see `Assembler::embedRoConstPool()`.
+  //!
+  //! Unlike `embedConstPool()` the data is not part of the instruction stream,
+  //! it's placed after the code when the function is relocated, so it doesn't
+  //! need to be aligned within the code and doesn't share cache lines with
+  //! instructions. Compiler uses it for its local and global constant pools.
+  ASMJIT_API Error embedRoConstPool(const Label& label, const ConstPool& pool) noexcept;
+
   // --------------------------------------------------------------------------
   // [Comment]
   // --------------------------------------------------------------------------
@@ -496,6 +619,12 @@ class ASMJIT_VIRTAPI Compiler : public ExternalTool {
   //! Maximum count of nodes to look ahead when allocating/spilling
   //! registers.
   uint32_t _maxLookAhead;
+  //! Alignment of loop headers, see \ref setLoopAlign().
+  uint8_t _loopAlign;
+  //! Boundary that jumps must not cross, see \ref setJumpBoundary().
+  uint8_t _jumpBoundary;
+  //! Count of threads used by `finalize()`, see \ref setThreadCount().
+  uint8_t _threadCount;
 
   //! Options affecting the next instruction.
   uint32_t _instOptions;
@@ -560,9 +689,9 @@ ASMJIT_INLINE HLNode::HLNode(Compiler* compiler, uint32_t type) noexcept {
   _flags = static_cast<uint16_t>(compiler->_nodeFlags);
   _flowId = compiler->_nodeFlowId;
   _tokenId = 0;
+  _blockId = kInvalidValue;
   _comment = nullptr;
   _map = nullptr;
-  _liveness = nullptr;
   _state = nullptr;
 }
 
@@ -51,6 +51,8 @@ void Context::reset(bool releaseMemory) {
   _returningList.reset();
   _jccList.reset();
   _contextVd.reset(releaseMemory);
+  _blocks = nullptr;
+  _blockCount = 0;
 
   _memVarCells = nullptr;
   _memStackCells = nullptr;
@@ -333,206 +335,532 @@ Error Context::removeUnreachableCode() {
 }
 
 // ============================================================================
-// [asmjit::Context - Liveness Analysis]
+// [asmjit::Context - CFG]
 // ============================================================================
 
 //! \internal
-struct LivenessTarget {
-  //! Previous target.
-  LivenessTarget* prev;
+static ASMJIT_INLINE void Context_addSucc(BasicBlock* block, BasicBlock* succ) {
+  // A conditional jump to the next node has the same target on both edges.
+  if (block->_succCount != 0 && block->_succs[0] == succ)
+    return;
 
-  //! Target node.
-  HLLabel* node;
-  //! Jumped from.
-  HLJump* from;
-};
+  ASMJIT_ASSERT(block->_succCount < 2);
+  block->_succs[block->_succCount++] = succ;
+}
 
-Error Context::livenessAnalysis() {
-  uint32_t bLen = static_cast<uint32_t>(
-    ((_contextVd.getLength() + BitArray::kEntityBits - 1) / BitArray::kEntityBits));
+//! \internal
+static ASMJIT_INLINE BasicBlock* Context_intersectDoms(BasicBlock* a, BasicBlock* b) {
+  while (a != b) {
+    while (a->_id > b->_id)
+      a = a->_idom;
+    while (b->_id > a->_id)
+      b = b->_idom;
+  }
+  return a;
+}
 
-  // No variables.
-  if (bLen == 0)
+Error Context::buildCfg() {
+  HLNode* func = getFunc();
+  HLNode* stop = getStop();
+  HLNode* node;
+
+  BasicBlock* block;
+  uint32_t i;
+
+  _blocks = nullptr;
+  _blockCount = 0;
+
+  // --------------------------------------------------------------------------
+  // [Blocks]
+  // --------------------------------------------------------------------------
+
+  // A block starts at a label, at the first node after a jump or a return,
+  // and at the first fetched node after nodes that were not fetched, which
+  // are unreachable and don't belong to any block. Blocks are counted first
+  // so they can be allocated at once.
+  uint32_t count = 0;
+  bool inBlock = false;
+
+  node = func;
+  do {
+    if (!node->isFetched()) {
+      inBlock = false;
+    }
+    else {
+      if (!inBlock || node->isLabel())
+        count++;
+      inBlock = !(node->isJmpOrJcc() || node->isRet());
+    }
+
+    node = node->getNext();
+  } while (node != stop);
+
+  if (count == 0)
     return kErrorOk;
 
-  HLFunc* func = getFunc();
-  HLJump* from = nullptr;
+  BasicBlock* layout = _zoneAllocator.allocT<BasicBlock>(count * sizeof(BasicBlock));
+  BasicBlock** blocks = _zoneAllocator.allocT<BasicBlock*>(count * sizeof(BasicBlock*));
+  BasicBlock** stack = _zoneAllocator.allocT<BasicBlock*>(count * sizeof(BasicBlock*));
+  uint32_t* marks = _zoneAllocator.allocT<uint32_t>(count * sizeof(uint32_t));
 
-  LivenessTarget* ltCur = nullptr;
-  LivenessTarget* ltUnused = nullptr;
+  if (layout == nullptr || blocks == nullptr || stack == nullptr || marks == nullptr)
+    return kErrorNoHeapMemory;
 
-  PodList<HLNode*>::Link* retPtr = _returningList.getFirst();
-  ASMJIT_ASSERT(retPtr != nullptr);
+  for (i = 0; i < count; i++)
+    layout[i].reset(i);
+  ::memset(marks, 0, count * sizeof(uint32_t));
 
-  HLNode* node = retPtr->getValue();
+  // Assign nodes to blocks (in layout order) and add fall-through edges.
+  BasicBlock* fallFrom = nullptr;
 
-  size_t varMapToVaListOffset = _varMapToVaListOffset;
-  BitArray* bCur = newBits(bLen);
+  block = nullptr;
+  i = 0;
 
-  if (bCur == nullptr)
-    goto _NoMemory;
+  node = func;
+  do {
+    if (!node->isFetched()) {
+      node->setBlockId(kInvalidValue);
+      block = nullptr;
+      fallFrom = nullptr;
+    }
+    else {
+      if (block == nullptr || node->isLabel()) {
+        block = &layout[i];
+        block->_id = i++;
+        block->_first = node;
 
-  // Allocate bits for code visited first time.
-_OnVisit:
-  for (;;) {
-    if (node->hasLiveness()) {
-      if (bCur->_addBitsDelSource(node->getLiveness(), bCur, bLen))
-        goto _OnPatch;
-      else
-        goto _OnDone;
+        if (fallFrom != nullptr)
+          Context_addSucc(fallFrom, block);
+      }
+
+      node->setBlockId(block->_id);
+      block->_last = node;
+      fallFrom = block;
+
+      if (node->isJmpOrJcc() || node->isRet()) {
+        if (!node->isJcc())
+          fallFrom = nullptr;
+        block = nullptr;
+      }
     }
 
-    BitArray* bTmp = copyBits(bCur, bLen);
-    if (bTmp == nullptr)
-      goto _NoMemory;
+    node = node->getNext();
+  } while (node != stop);
 
-    node->setLiveness(bTmp);
-    VarMap* map = node->getMap();
+  ASMJIT_ASSERT(i == count);
 
-    if (map != nullptr) {
-      uint32_t vaCount = map->getVaCount();
-      VarAttr* vaList = reinterpret_cast<VarAttr*>(((uint8_t*)map) + varMapToVaListOffset);
+  // --------------------------------------------------------------------------
+  // [Edges]
+  // --------------------------------------------------------------------------
 
-      for (uint32_t i = 0; i < vaCount; i++) {
-        VarAttr* va = &vaList[i];
-        VarData* vd = va->getVd();
+  for (i = 0; i < count; i++) {
+    block = &layout[i];
+    node = block->_last;
 
-        uint32_t flags = va->getFlags();
-        uint32_t localId = vd->getLocalId();
+    if (node->isJmpOrJcc()) {
+      HLLabel* target = static_cast<HLJump*>(node)->getTarget();
+      if (target != nullptr && target->getBlockId() < count)
+        Context_addSucc(block, &layout[target->getBlockId()]);
+    }
+  }
 
-        if ((flags & kVarAttrWAll) && !(flags & kVarAttrRAll)) {
-          // Write-Only.
-          bTmp->setBit(localId);
-          bCur->delBit(localId);
-        }
-        else {
-          // Read-Only or Read/Write.
-          bTmp->setBit(localId);
-          bCur->setBit(localId);
-        }
+  // --------------------------------------------------------------------------
+  // [Order]
+  // --------------------------------------------------------------------------
+
+  // Depth-first search from the entry block produces blocks in post-order,
+  // `marks` hold the count of successors not visited yet plus one. Jump
+  // targets are visited before fall-throughs, so the reverse post-order is
+  // mostly the same as the layout order. Blocks that are not reached (the
+  // exit block if the function never falls into it) are dropped.
+  uint32_t postCount = 0;
+  uint32_t stackLength = 1;
+
+  stack[0] = &layout[0];
+  marks[0] = layout[0]._succCount + 1;
+
+  while (stackLength != 0) {
+    block = stack[stackLength - 1];
+    uint32_t remaining = marks[block->_id] - 1;
+
+    if (remaining != 0) {
+      BasicBlock* succ = block->_succs[remaining - 1];
+      marks[block->_id] = remaining;
+
+      if (marks[succ->_id] == 0) {
+        marks[succ->_id] = succ->_succCount + 1;
+        stack[stackLength++] = succ;
       }
     }
+    else {
+      blocks[postCount++] = block;
+      stackLength--;
+    }
+  }
+
+  if (postCount != count) {
+    for (i = 0; i < count; i++) {
+      if (marks[i] != 0)
+        continue;
 
-    if (node->getType() == HLNode::kTypeLabel)
-      goto _OnTarget;
+      block = &layout[i];
+      for (node = block->_first; ; node = node->getNext()) {
+        node->setBlockId(kInvalidValue);
+        if (node == block->_last)
+          break;
+      }
+    }
+  }
 
-    if (node == func)
-      goto _OnDone;
+  // Renumber blocks to reverse post-order.
+  count = postCount;
 
-    ASMJIT_ASSERT(node->getPrev());
-    node = node->getPrev();
+  for (i = 0; i < count / 2; i++) {
+    block = blocks[i];
+    blocks[i] = blocks[count - 1 - i];
+    blocks[count - 1 - i] = block;
   }
 
-  // Patch already generated liveness bits.
-_OnPatch:
-  for (;;) {
-    ASMJIT_ASSERT(node->hasLiveness());
-    BitArray* bNode = node->getLiveness();
+  for (i = 0; i < count; i++) {
+    block = blocks[i];
+    if (block->_id == i)
+      continue;
+
+    block->_id = i;
+    for (node = block->_first; ; node = node->getNext()) {
+      node->setBlockId(i);
+      if (node == block->_last)
+        break;
+    }
+  }
 
-    if (!bNode->_addBitsDelSource(bCur, bLen))
-      goto _OnDone;
+  _blocks = blocks;
+  _blockCount = count;
 
-    if (node->getType() == HLNode::kTypeLabel)
-      goto _OnTarget;
+  // --------------------------------------------------------------------------
+  // [Predecessors]
+  // --------------------------------------------------------------------------
 
-    if (node == func)
-      goto _OnDone;
+  uint32_t edgeCount = 0;
+  for (i = 0; i < count; i++) {
+    block = blocks[i];
+    edgeCount += block->_succCount;
 
-    node = node->getPrev();
+    for (uint32_t j = 0; j < block->_succCount; j++)
+      block->_succs[j]->_predCount++;
   }
 
-_OnTarget:
-  if (static_cast<HLLabel*>(node)->getNumRefs() != 0) {
-    // Push a new LivenessTarget onto the stack if needed.
-    if (ltCur == nullptr || ltCur->node != node) {
-      // Allocate a new LivenessTarget object (from pool or zone).
-      LivenessTarget* ltTmp = ltUnused;
+  BasicBlock** preds = _zoneAllocator.allocT<BasicBlock*>(edgeCount * sizeof(BasicBlock*));
+  if (preds == nullptr && edgeCount != 0)
+    return kErrorNoHeapMemory;
 
-      if (ltTmp != nullptr) {
-        ltUnused = ltUnused->prev;
-      }
-      else {
-        ltTmp = _zoneAllocator.allocT<LivenessTarget>(
-          sizeof(LivenessTarget) - sizeof(BitArray) + bLen * sizeof(uintptr_t));
+  for (i = 0; i < count; i++) {
+    block = blocks[i];
+    block->_preds = preds;
 
-        if (ltTmp == nullptr)
-          goto _NoMemory;
-      }
+    preds += block->_predCount;
+    block->_predCount = 0;
+  }
 
-      // Initialize and make current - ltTmp->from will be set later on.
-      ltTmp->prev = ltCur;
-      ltTmp->node = static_cast<HLLabel*>(node);
-      ltCur = ltTmp;
+  for (i = 0; i < count; i++) {
+    block = blocks[i];
 
-      from = static_cast<HLLabel*>(node)->getFrom();
-      ASMJIT_ASSERT(from != nullptr);
+    for (uint32_t j = 0; j < block->_succCount; j++) {
+      BasicBlock* succ = block->_succs[j];
+      succ->_preds[succ->_predCount++] = block;
     }
-    else {
-      from = ltCur->from;
-      goto _OnJumpNext;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Dominators]
+  // --------------------------------------------------------------------------
+
+  // Iterative algorithm by Cooper, Harvey and Kennedy. Blocks are visited in
+  // reverse post-order, which requires only a few passes over reducible
+  // graphs. The entry block temporarily dominates itself.
+  BasicBlock* entry = blocks[0];
+  entry->_idom = entry;
+
+  bool changed;
+  do {
+    changed = false;
+
+    for (i = 1; i < count; i++) {
+      block = blocks[i];
+      BasicBlock* idom = nullptr;
+
+      for (uint32_t j = 0; j < block->_predCount; j++) {
+        BasicBlock* pred = block->_preds[j];
+        if (pred->_idom == nullptr)
+          continue;
+        idom = idom == nullptr ? pred : Context_intersectDoms(pred, idom);
+      }
+
+      if (block->_idom != idom) {
+        block->_idom = idom;
+        changed = true;
+      }
     }
+  } while (changed);
 
-    // Visit/Patch.
-    do {
-      ltCur->from = from;
-      bCur->copyBits(node->getLiveness(), bLen);
+  entry->_idom = nullptr;
 
-      if (!from->hasLiveness()) {
-        node = from;
-        goto _OnVisit;
+  // --------------------------------------------------------------------------
+  // [Loops]
+  // --------------------------------------------------------------------------
+
+  // Every edge to a block that dominates its source is a back edge, which
+  // makes the target a loop header. The loop body is found by walking the
+  // predecessors from the source of the back edge until the header. Outer
+  // headers come first in reverse post-order, so the innermost loop of each
+  // block is the last one assigned.
+  for (i = 0; i < count; i++)
+    marks[i] = kInvalidValue;
+
+  for (i = 0; i < count; i++) {
+    BasicBlock* header = blocks[i];
+    stackLength = 0;
+
+    for (uint32_t j = 0; j < header->_predCount; j++) {
+      BasicBlock* pred = header->_preds[j];
+      if (pred->_id < i || !header->dominates(pred))
+        continue;
+
+      if (marks[i] != i) {
+        marks[i] = i;
+        header->_parentLoop = header->_loop;
+        header->_loop = header;
+        header->_loopDepth++;
       }
 
-      // Issue #25: Moved '_OnJumpNext' here since it's important to patch
-      // code again if there are more live variables than before.
-_OnJumpNext:
-      if (bCur->delBits(from->getLiveness(), bLen)) {
-        node = from;
-        goto _OnPatch;
+      if (marks[pred->_id] != i) {
+        marks[pred->_id] = i;
+        stack[stackLength++] = pred;
+      }
+    }
+
+    while (stackLength != 0) {
+      block = stack[--stackLength];
+      block->_loop = header;
+      block->_loopDepth++;
+
+      for (uint32_t j = 0; j < block->_predCount; j++) {
+        BasicBlock* pred = block->_preds[j];
+        if (marks[pred->_id] != i) {
+          marks[pred->_id] = i;
+          stack[stackLength++] = pred;
+        }
       }
+    }
+  }
+
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::Context - Liveness Analysis]
+// ============================================================================
+
+Error Context::livenessAnalysis() {
+  uint32_t bLen = static_cast<uint32_t>(
+    ((_contextVd.getLength() + BitArray::kEntityBits - 1) / BitArray::kEntityBits));
+
+  // No variables.
+  if (bLen == 0)
+    return kErrorOk;
+
+  HLNode* stop = getStop();
+  BasicBlock** blocks = _blocks;
+  uint32_t blockCount = _blockCount;
+  size_t varMapToVaListOffset = _varMapToVaListOffset;
 
-      from = from->getJumpNext();
-    } while (from != nullptr);
+  uint32_t i;
+  bool changed;
 
-    // Pop the current LivenessTarget from the stack.
-    {
-      LivenessTarget* ltTmp = ltCur;
+  // Block translated after a block that ends with a return, see below.
+  BasicBlock** retNext = _zoneAllocator.allocT<BasicBlock*>(blockCount * sizeof(BasicBlock*));
 
-      ltCur = ltCur->prev;
-      ltTmp->prev = ltUnused;
-      ltUnused = ltTmp;
+  // Live-in, live-out and kill sets of all blocks, allocated at once. Kill
+  // sets are only needed by the analysis.
+  size_t bStride = static_cast<size_t>(bLen) * BitArray::kEntitySize;
+  uint8_t* bData = static_cast<uint8_t*>(
+    _zoneAllocator.allocZeroed(static_cast<size_t>(blockCount) * 3 * bStride));
+
+  if (retNext == nullptr || bData == nullptr)
+    return kErrorNoHeapMemory;
+
+  for (i = 0; i < blockCount; i++) {
+    BasicBlock* block = blocks[i];
+    if (block->isLoopHeader()) {
+      block->_loopVars = newBits(bLen);
+      if (block->_loopVars == nullptr)
+        return kErrorNoHeapMemory;
     }
   }
 
-  bCur->copyBits(node->getLiveness(), bLen);
-  node = node->getPrev();
+  // Collect variables each block reads before writing them (gen), which is
+  // where its live-in set starts, and variables it writes (kill). Variables
+  // used by the block are also used by its innermost loop.
+  for (i = 0; i < blockCount; i++) {
+    BasicBlock* block = blocks[i];
+    BitArray* bIn = reinterpret_cast<BitArray*>(bData);
+    BitArray* bKill = reinterpret_cast<BitArray*>(bData + bStride * 2);
+    BitArray* bLoop = block->_loop != nullptr ? block->_loop->_loopVars : static_cast<BitArray*>(nullptr);
+
+    block->_liveIn = bIn;
+    block->_liveOut = reinterpret_cast<BitArray*>(bData + bStride);
+    bData += bStride * 3;
+
+    HLNode* node = block->_last;
+    for (;;) {
+      VarMap* map = node->getMap();
+      if (map != nullptr) {
+        uint32_t vaCount = map->getVaCount();
+        VarAttr* vaList = reinterpret_cast<VarAttr*>(((uint8_t*)map) + varMapToVaListOffset);
+
+        for (uint32_t j = 0; j < vaCount; j++) {
+          VarAttr* va = &vaList[j];
+
+          uint32_t flags = va->getFlags();
+          uint32_t localId = va->getVd()->getLocalId();
+
+          if ((flags & kVarAttrWAll) && !(flags & kVarAttrRAll)) {
+            // Write-Only.
+            bIn->delBit(localId);
+            bKill->setBit(localId);
+          }
+          else {
+            // Read-Only or Read/Write.
+            bIn->setBit(localId);
+          }
+
+          if (bLoop != nullptr)
+            bLoop->setBit(localId);
+        }
+      }
 
-  if (node->isJmp() || !node->isFetched())
-    goto _OnDone;
+      if (node == block->_first)
+        break;
+      node = node->getPrev();
+    }
 
-  if (!node->hasLiveness())
-    goto _OnVisit;
+    // The translator continues after a return with the state it has at the
+    // return, so variables alive at the next block must stay alive across
+    // the return, otherwise the next block would start with their registers
+    // released.
+    node = block->_last;
+    retNext[i] = nullptr;
 
-  if (bCur->delBits(node->getLiveness(), bLen))
-    goto _OnPatch;
+    if (node->getType() == HLNode::kTypeRet) {
+      do {
+        node = node->getNext();
+      } while (node != stop && !node->hasBlockId());
 
-_OnDone:
-  if (ltCur != nullptr) {
-    node = ltCur->node;
-    from = ltCur->from;
+      if (node != stop)
+        retNext[i] = blocks[node->getBlockId()];
+    }
+  }
 
-    goto _OnJumpNext;
+  // Inner loops have higher indexes than loops containing them.
+  i = blockCount;
+  while (i != 0) {
+    BasicBlock* block = blocks[--i];
+    if (block->isLoopHeader() && block->_parentLoop != nullptr)
+      block->_parentLoop->_loopVars->addBits(block->_loopVars, bLen);
   }
 
-  retPtr = retPtr->getNext();
-  if (retPtr != nullptr) {
-    node = retPtr->getValue();
-    goto _OnVisit;
+  // Blocks are visited in post-order, so the live-in sets of successors are
+  // known except for the back edges. Sets only grow, so the propagation is
+  // repeated until nothing changes.
+  do {
+    changed = false;
+
+    i = blockCount;
+    while (i != 0) {
+      BasicBlock* block = blocks[--i];
+      BitArray* bOut = block->_liveOut;
+
+      bool outChanged = false;
+      for (uint32_t j = 0; j < block->_succCount; j++)
+        outChanged |= bOut->addBitsChanged(block->_succs[j]->_liveIn, bLen);
+
+      if (retNext[i] != nullptr)
+        outChanged |= bOut->addBitsChanged(retNext[i]->_liveIn, bLen);
+
+      if (outChanged) {
+        BitArray* bKill = reinterpret_cast<BitArray*>(reinterpret_cast<uint8_t*>(bOut) + bStride);
+        changed |= block->_liveIn->addBitsDelChanged(bOut, bKill, bLen);
+      }
+    }
+  } while (changed);
+
+  // Walk each block once in reverse order and mark variables that are not
+  // alive after the node that uses them, per-node liveness is not stored,
+  // see `updateLiveness()`.
+  BitArray* bCur = newBits(bLen);
+  if (bCur == nullptr)
+    return kErrorNoHeapMemory;
+
+  for (i = 0; i < blockCount; i++) {
+    BasicBlock* block = blocks[i];
+    HLNode* node = block->_last;
+
+    bCur->copyBits(block->_liveOut, bLen);
+    for (;;) {
+      VarMap* map = node->getMap();
+      if (map != nullptr) {
+        uint32_t vaCount = map->getVaCount();
+        VarAttr* vaList = reinterpret_cast<VarAttr*>(((uint8_t*)map) + varMapToVaListOffset);
+
+        for (uint32_t j = 0; j < vaCount; j++) {
+          VarAttr* va = &vaList[j];
+
+          uint32_t flags = va->getFlags();
+          uint32_t localId = va->getVd()->getLocalId();
+
+          if (!bCur->getBit(localId))
+            va->orFlags(kVarAttrDead);
+
+          if ((flags & kVarAttrWAll) && !(flags & kVarAttrRAll))
+            bCur->delBit(localId);
+          else
+            bCur->setBit(localId);
+        }
+      }
+
+      if (node == block->_first)
+        break;
+      node = node->getPrev();
+    }
   }
 
   return kErrorOk;
+}
 
-_NoMemory:
-  return setLastError(kErrorNoHeapMemory);
+bool Context::getLiveness(BitArray* dst, HLNode* node) const {
+  BasicBlock* block = getBlockOf(node);
+  if (block == nullptr || block->_liveIn == nullptr)
+    return false;
+
+  uint32_t bLen = static_cast<uint32_t>(
+    ((_contextVd.getLength() + BitArray::kEntityBits - 1) / BitArray::kEntityBits));
+  uint32_t blockId = block->_id;
+
+  // Nodes inserted by the translator don't belong to the block, skip them.
+  HLNode* cur = block->_first;
+  dst->copyBits(block->_liveIn, bLen);
+
+  for (;;) {
+    if (cur->getBlockId() == blockId) {
+      addUsedVars(dst, cur);
+      if (cur == node)
+        break;
+      delDeadVars(dst, cur);
+    }
+    cur = cur->getNext();
+  }
+
+  return true;
 }
 
 // ============================================================================
@@ -544,18 +872,20 @@ Error Context::formatInlineComment(StringBuilder& dst, HLNode* node) {
   if (node->getComment())
     dst.appendString(node->getComment());
 
-  if (node->hasLiveness()) {
+  uint32_t vdCount = static_cast<uint32_t>(_contextVd.getLength());
+  BitArray* liveness = newBits(
+    (vdCount + BitArray::kEntityBits - 1) / BitArray::kEntityBits);
+
+  if (liveness != nullptr && getLiveness(liveness, node)) {
     if (dst.getLength() < _annotationLength)
       dst.appendChars(' ', _annotationLength - dst.getLength());
 
-    uint32_t vdCount = static_cast<uint32_t>(_contextVd.getLength());
     size_t offset = dst.getLength() + 1;
 
     dst.appendChar('[');
     dst.appendChars(' ', vdCount);
     dst.appendChar(']');
 
-    BitArray* liveness = node->getLiveness();
     VarMap* map = node->getMap();
 
     uint32_t i;
@@ -608,6 +938,8 @@ void Context::cleanup() {
   }
 
   _contextVd.reset(false);
+  _blocks = nullptr;
+  _blockCount = 0;
   _extraBlock = nullptr;
 }
 
@@ -616,6 +948,16 @@ void Context::cleanup() {
 // ============================================================================
 
 Error Context::compile(HLFunc* func) {
+  ASMJIT_PROPAGATE_ERROR(prepare(func));
+
+  Error error = analyze();
+  if (error != kErrorOk)
+    return setLastError(error);
+
+  return generate();
+}
+
+Error Context::prepare(HLFunc* func) {
   HLNode* end = func->getEnd();
   HLNode* stop = end->getNext();
 
@@ -623,10 +965,32 @@ Error Context::compile(HLFunc* func) {
   _stop = stop;
   _extraBlock = end;
 
+  if (getCompiler()->hasFeature(kCompilerFeatureValueNumbering))
+    ASMJIT_PROPAGATE_ERROR(valueNumbering());
+
+  ASMJIT_PROPAGATE_ERROR(tuneVars());
   ASMJIT_PROPAGATE_ERROR(fetch());
   ASMJIT_PROPAGATE_ERROR(removeUnreachableCode());
+
+  return kErrorOk;
+}
+
+Error Context::analyze() {
+  Compiler* compiler = getCompiler();
+
+  ASMJIT_PROPAGATE_ERROR(buildCfg());
   ASMJIT_PROPAGATE_ERROR(livenessAnalysis());
 
+  if (compiler->hasFeature(kCompilerFeatureEnableScheduler))
+    ASMJIT_PROPAGATE_ERROR(schedule());
+
+  if (compiler->hasFeature(kCompilerFeatureLinearScan))
+    ASMJIT_PROPAGATE_ERROR(linearScan());
+
+  return kErrorOk;
+}
+
+Error Context::generate() {
   Compiler* compiler = getCompiler();
 
 #if !defined(ASMJIT_DISABLE_LOGGER)
@@ -635,6 +999,10 @@ Error Context::compile(HLFunc* func) {
 #endif // !ASMJIT_DISABLE_LOGGER
 
   ASMJIT_PROPAGATE_ERROR(translate());
+  ASMJIT_PROPAGATE_ERROR(tune());
+
+  if (compiler->hasFeature(kCompilerFeaturePeephole))
+    ASMJIT_PROPAGATE_ERROR(peephole());
 
   // We alter the compiler cursor, because it doesn't make sense to reference
   // it after compilation - some nodes may disappear and it's forbidden to add
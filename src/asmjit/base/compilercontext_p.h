@@ -71,6 +71,8 @@ ASMJIT_ENUM(VarAttrFlags) {
   kVarAttrSpill = 0x00000800,
   //! Variable should be unused at the end of the instruction/node.
   kVarAttrUnuse = 0x00001000,
+  //! Variable is not alive after the instruction/node (liveness analysis).
+  kVarAttrDead = 0x00002000,
 
   //! All in-flags.
   kVarAttrRAll = kVarAttrRReg | kVarAttrRMem | kVarAttrRDecide | kVarAttrRCall | kVarAttrRFunc,
@@ -574,6 +576,142 @@ struct VarMap {
 //! Variables' state.
 struct VarState {};
 
+// ============================================================================
+// [asmjit::BasicBlock]
+// ============================================================================
+
+//! \internal
+//!
+//! Basic block - a sequence of nodes that is entered only at the first node
+//! and left only after the last one.
+//!
+//! Blocks are created by `Context::buildCfg()` and indexed in reverse
+//! post-order, so the entry block has index 0 and every block has a higher
+//! index than its immediate dominator.
+struct BasicBlock {
+  ASMJIT_NO_COPY(BasicBlock)
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_INLINE void reset(uint32_t id) noexcept {
+    _id = id;
+    _loopDepth = 0;
+
+    _first = nullptr;
+    _last = nullptr;
+
+    _idom = nullptr;
+    _loop = nullptr;
+    _parentLoop = nullptr;
+
+    _preds = nullptr;
+    _predCount = 0;
+    _succCount = 0;
+    _succs[0] = nullptr;
+    _succs[1] = nullptr;
+
+    _liveIn = nullptr;
+    _liveOut = nullptr;
+    _loopVars = nullptr;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get block index.
+  ASMJIT_INLINE uint32_t getId() const { return _id; }
+
+  //! Get the first node of the block.
+  ASMJIT_INLINE HLNode* getFirst() const { return _first; }
+  //! Get the last node of the block.
+  ASMJIT_INLINE HLNode* getLast() const { return _last; }
+
+  //! Get count of predecessors.
+  ASMJIT_INLINE uint32_t getPredCount() const { return _predCount; }
+  //! Get predecessor at `index`.
+  ASMJIT_INLINE BasicBlock* getPred(uint32_t index) const {
+    ASMJIT_ASSERT(index < _predCount);
+    return _preds[index];
+  }
+
+  //! Get count of successors (at most 2).
+  ASMJIT_INLINE uint32_t getSuccCount() const { return _succCount; }
+  //! Get successor at `index`.
+  ASMJIT_INLINE BasicBlock* getSucc(uint32_t index) const {
+    ASMJIT_ASSERT(index < _succCount);
+    return _succs[index];
+  }
+
+  //! Get immediate dominator, `nullptr` for the entry block.
+  ASMJIT_INLINE BasicBlock* getIDom() const { return _idom; }
+
+  //! Get whether this block dominates `block`.
+  ASMJIT_INLINE bool dominates(const BasicBlock* block) const {
+    while (block->_id > _id)
+      block = block->_idom;
+    return block == this;
+  }
+
+  //! Get whether the block is a loop header.
+  ASMJIT_INLINE bool isLoopHeader() const { return _loop == this; }
+  //! Get header of the innermost loop containing this block or `nullptr`.
+  ASMJIT_INLINE BasicBlock* getLoop() const { return _loop; }
+  //! Get loop nesting depth, zero if the block is not inside a loop.
+  ASMJIT_INLINE uint32_t getLoopDepth() const { return _loopDepth; }
+
+  //! Get header of the loop containing the loop of this header or `nullptr`
+  //! (only valid for loop headers).
+  ASMJIT_INLINE BasicBlock* getParentLoop() const { return _parentLoop; }
+  //! Get variables used inside the loop of this header (only valid for loop
+  //! headers).
+  ASMJIT_INLINE BitArray* getLoopVars() const { return _loopVars; }
+
+  //! Get variables alive at the start of the block.
+  ASMJIT_INLINE BitArray* getLiveIn() const { return _liveIn; }
+  //! Get variables alive at the end of the block.
+  ASMJIT_INLINE BitArray* getLiveOut() const { return _liveOut; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Block index.
+  uint32_t _id;
+  //! Loop nesting depth.
+  uint32_t _loopDepth;
+
+  //! First node.
+  HLNode* _first;
+  //! Last node (inclusive).
+  HLNode* _last;
+
+  //! Immediate dominator.
+  BasicBlock* _idom;
+  //! Header of the innermost loop.
+  BasicBlock* _loop;
+  //! Header of the parent loop (headers only).
+  BasicBlock* _parentLoop;
+
+  //! Predecessors.
+  BasicBlock** _preds;
+  //! Count of predecessors.
+  uint32_t _predCount;
+  //! Count of successors.
+  uint32_t _succCount;
+  //! Successors - fall-through and/or jump target.
+  BasicBlock* _succs[2];
+
+  //! Variables alive at the start of the block.
+  BitArray* _liveIn;
+  //! Variables alive at the end of the block.
+  BitArray* _liveOut;
+  //! Variables used inside the loop (headers only).
+  BitArray* _loopVars;
+};
+
 // ============================================================================
 // [asmjit::Context]
 // ============================================================================
@@ -697,6 +835,18 @@ struct Context {
       _zoneAllocator.dup(src, static_cast<size_t>(len) * BitArray::kEntitySize));
   }
 
+  // --------------------------------------------------------------------------
+  // [ValueNumbering]
+  // --------------------------------------------------------------------------
+
+  //! Value numbering.
+  //!
+  //! Finds instructions that compute a value which is still available in
+  //! another variable and reuses that variable instead. It runs before
+  //! `fetch()` so the removed instructions and renamed variables are never
+  //! seen by the rest of the pipeline.
+  virtual Error valueNumbering() = 0;
+
   // --------------------------------------------------------------------------
   // [Fetch]
   // --------------------------------------------------------------------------
@@ -756,22 +906,100 @@ struct Context {
     return kErrorOk;
   }
 
+  // --------------------------------------------------------------------------
+  // [CFG]
+  // --------------------------------------------------------------------------
+
+  //! Build the control-flow graph of the fetched code.
+  //!
+  //! Splits the fetched nodes into basic blocks, connects them by the edges
+  //! of jumps and fall-throughs, and computes dominators and loop nesting
+  //! depth of each block. Unreachable nodes don't belong to any block.
+  virtual Error buildCfg();
+
+  //! Get count of basic blocks.
+  ASMJIT_INLINE uint32_t getBlockCount() const { return _blockCount; }
+
+  //! Get basic block at `index`.
+  ASMJIT_INLINE BasicBlock* getBlock(uint32_t index) const {
+    ASMJIT_ASSERT(index < _blockCount);
+    return _blocks[index];
+  }
+
+  //! Get basic block containing `node` or `nullptr`.
+  ASMJIT_INLINE BasicBlock* getBlockOf(const HLNode* node) const {
+    uint32_t blockId = node->getBlockId();
+    return blockId < _blockCount ? _blocks[blockId] : static_cast<BasicBlock*>(nullptr);
+  }
+
   // --------------------------------------------------------------------------
   // [Analyze]
   // --------------------------------------------------------------------------
 
   //! Perform variable liveness analysis.
   //!
-  //! Analysis phase iterates over nodes in reverse order and generates a bit
-  //! array describing variables that are alive at every node in the function.
-  //! When the analysis start all variables are assumed dead. When a read or
-  //! read/write operations of a variable is detected the variable becomes
-  //! alive; when only write operation is detected the variable becomes dead.
-  //!
-  //! When a label is found all jumps to that label are followed and analysis
-  //! repeats until all variables are resolved.
+  //! The analysis is a backward dataflow over basic blocks. The variables
+  //! read before they are written (gen) and written (kill) are collected for
+  //! each block first, together with variables used inside each loop, then
+  //! the live-in and live-out sets are propagated over the edges until they
+  //! don't change. Liveness of nodes is not stored, each
+  //! block is walked once more to mark variables that are not alive after the
+  //! node using them by `kVarAttrDead`, which is enough to recompute it, see
+  //! `getLiveness()`.
   virtual Error livenessAnalysis();
 
+  //! Compute variables alive at `node` to `dst`.
+  //!
+  //! Variables alive at the node are variables alive after it and variables
+  //! it uses. The block containing the node is walked from its start, which
+  //! is only suitable for occasional queries. Returns `false` if the node
+  //! doesn't belong to any basic block.
+  bool getLiveness(BitArray* dst, HLNode* node) const;
+
+  //! Add variables used by `node` to `live`.
+  ASMJIT_INLINE void addUsedVars(BitArray* live, const HLNode* node) const {
+    VarMap* map = node->getMap();
+    if (map == nullptr)
+      return;
+
+    uint32_t vaCount = map->getVaCount();
+    VarAttr* vaList = reinterpret_cast<VarAttr*>(((uint8_t*)map) + _varMapToVaListOffset);
+
+    for (uint32_t i = 0; i < vaCount; i++)
+      live->setBit(vaList[i].getVd()->getLocalId());
+  }
+
+  //! Remove variables used by `node` that are not alive after it from `live`.
+  ASMJIT_INLINE void delDeadVars(BitArray* live, const HLNode* node) const {
+    VarMap* map = node->getMap();
+    if (map == nullptr)
+      return;
+
+    uint32_t vaCount = map->getVaCount();
+    VarAttr* vaList = reinterpret_cast<VarAttr*>(((uint8_t*)map) + _varMapToVaListOffset);
+
+    for (uint32_t i = 0; i < vaCount; i++) {
+      if (vaList[i].hasFlag(kVarAttrDead))
+        live->delBit(vaList[i].getVd()->getLocalId());
+    }
+  }
+
+  //! Reorder instructions within basic blocks, see
+  //! `kCompilerFeatureEnableScheduler`.
+  //!
+  //! Called after `livenessAnalysis()`, which the scheduler uses to limit
+  //! the count of variables alive at the same time, and before the registers
+  //! are allocated. Live-in and live-out sets of blocks don't change, flow
+  //! ids of reordered nodes are exchanged so they still increase in the node
+  //! order and `kVarAttrDead` is updated.
+  virtual Error schedule() = 0;
+
+  //! Assign registers by a linear scan over live intervals.
+  //!
+  //! Only called if `kCompilerFeatureLinearScan` is enabled. The result is
+  //! used by the translator as the preferred register of each variable.
+  virtual Error linearScan() = 0;
+
   // --------------------------------------------------------------------------
   // [Annotate]
   // --------------------------------------------------------------------------
@@ -786,6 +1014,26 @@ struct Context {
   //! Translate code by allocating registers and handling state changes.
   virtual Error translate() = 0;
 
+  // --------------------------------------------------------------------------
+  // [Peephole]
+  // --------------------------------------------------------------------------
+
+  //! Simplify the translated code, see `kCompilerFeaturePeephole`.
+  virtual Error peephole() = 0;
+
+  // --------------------------------------------------------------------------
+  // [Tune]
+  // --------------------------------------------------------------------------
+
+  //! Replace instructions that use variables by forms preferred by the target
+  //! CPU. Called before `fetch()`, when the sizes of variables are known.
+  virtual Error tuneVars() = 0;
+
+  //! Replace translated instructions by forms preferred by the target CPU.
+  //! Called after `translate()`, before `peephole()` removes any node, as
+  //! it uses `getLiveness()`.
+  virtual Error tune() = 0;
+
   // --------------------------------------------------------------------------
   // [Cleanup]
   // --------------------------------------------------------------------------
@@ -796,8 +1044,25 @@ struct Context {
   // [Compile]
   // --------------------------------------------------------------------------
 
+  //! Compile `func`, the same as calling `prepare()`, `analyze()` and
+  //! `generate()` in sequence.
   virtual Error compile(HLFunc* func);
 
+  //! Fetch `func` and remove its unreachable code.
+  //!
+  //! Modifies the node list and may create variables in `Compiler`.
+  virtual Error prepare(HLFunc* func);
+
+  //! Build the CFG of the prepared function and run the analysis passes.
+  //!
+  //! Only reads `Compiler` and writes memory owned by the function and the
+  //! context, so prepared functions can be analyzed by different contexts in
+  //! parallel. Errors are returned, not reported to the `Compiler`.
+  virtual Error analyze();
+
+  //! Annotate and translate the analyzed function.
+  virtual Error generate();
+
   // --------------------------------------------------------------------------
   // [Serialize]
   // --------------------------------------------------------------------------
@@ -850,6 +1115,10 @@ struct Context {
 
   //! All variables used by the current function.
   PodVector<VarData*> _contextVd;
+  //! Basic blocks of the current function, in reverse post-order.
+  BasicBlock** _blocks;
+  //! Count of basic blocks.
+  uint32_t _blockCount;
 
   //! Memory used to spill variables.
   VarCell* _memVarCells;
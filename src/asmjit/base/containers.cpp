@@ -11,6 +11,12 @@
 #include "../base/containers.h"
 #include "../base/utils.h"
 
+#if ASMJIT_ARCH_AVX2
+# include <immintrin.h>
+#elif ASMJIT_ARCH_SSE2
+# include <emmintrin.h>
+#endif // ASMJIT_ARCH_AVX2 || ASMJIT_ARCH_SSE2
+
 // [Api-Begin]
 #include "../apibegin.h"
 
@@ -368,6 +374,160 @@ bool StringBuilder::eq(const char* str, size_t len) const noexcept {
   }
 }
 
+// ============================================================================
+// [asmjit::BitArray - Dataflow]
+// ============================================================================
+
+//! \internal
+//!
+//! Count of `BitArray` entities processed at once by SSE2 and AVX2 kernels.
+enum {
+  kBitArrayCountXmm = 16 / BitArray::kEntitySize,
+  kBitArrayCountYmm = 32 / BitArray::kEntitySize
+};
+
+bool BitArray::addBitsChanged(const BitArray* s0, uint32_t len) noexcept {
+  uint32_t i = 0;
+  uintptr_t r = 0;
+
+#if ASMJIT_ARCH_AVX2
+  if (len >= kBitArrayCountYmm) {
+    __m256i yr = _mm256_setzero_si256();
+    do {
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+      __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s0->data + i));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), _mm256_or_si256(a, t));
+      yr = _mm256_or_si256(yr, _mm256_andnot_si256(a, t));
+      i += kBitArrayCountYmm;
+    } while (i + kBitArrayCountYmm <= len);
+    r = !_mm256_testz_si256(yr, yr);
+  }
+#endif // ASMJIT_ARCH_AVX2
+
+#if ASMJIT_ARCH_SSE2
+  if (i + kBitArrayCountXmm <= len) {
+    __m128i xr = _mm_setzero_si128();
+    do {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+      __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s0->data + i));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_or_si128(a, t));
+      xr = _mm_or_si128(xr, _mm_andnot_si128(a, t));
+      i += kBitArrayCountXmm;
+    } while (i + kBitArrayCountXmm <= len);
+    r |= _mm_movemask_epi8(_mm_cmpeq_epi8(xr, _mm_setzero_si128())) ^ 0xFFFF;
+  }
+#endif // ASMJIT_ARCH_SSE2
+
+  for (; i < len; i++) {
+    uintptr_t a = data[i];
+    uintptr_t t = s0->data[i];
+    data[i] = a | t;
+    r |= t & ~a;
+  }
+  return r != 0;
+}
+
+bool BitArray::addBitsDelChanged(const BitArray* s0, const BitArray* s1, uint32_t len) noexcept {
+  uint32_t i = 0;
+  uintptr_t r = 0;
+
+#if ASMJIT_ARCH_AVX2
+  if (len >= kBitArrayCountYmm) {
+    __m256i yr = _mm256_setzero_si256();
+    do {
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+      __m256i t = _mm256_andnot_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s1->data + i)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s0->data + i)));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), _mm256_or_si256(a, t));
+      yr = _mm256_or_si256(yr, _mm256_andnot_si256(a, t));
+      i += kBitArrayCountYmm;
+    } while (i + kBitArrayCountYmm <= len);
+    r = !_mm256_testz_si256(yr, yr);
+  }
+#endif // ASMJIT_ARCH_AVX2
+
+#if ASMJIT_ARCH_SSE2
+  if (i + kBitArrayCountXmm <= len) {
+    __m128i xr = _mm_setzero_si128();
+    do {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+      __m128i t = _mm_andnot_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(s1->data + i)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(s0->data + i)));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_or_si128(a, t));
+      xr = _mm_or_si128(xr, _mm_andnot_si128(a, t));
+      i += kBitArrayCountXmm;
+    } while (i + kBitArrayCountXmm <= len);
+    r |= _mm_movemask_epi8(_mm_cmpeq_epi8(xr, _mm_setzero_si128())) ^ 0xFFFF;
+  }
+#endif // ASMJIT_ARCH_SSE2
+
+  for (; i < len; i++) {
+    uintptr_t a = data[i];
+    uintptr_t t = s0->data[i] & ~s1->data[i];
+    data[i] = a | t;
+    r |= t & ~a;
+  }
+  return r != 0;
+}
+
+// ============================================================================
+// [asmjit::BitArray - Unit]
+// ============================================================================
+
+#if defined(ASMJIT_TEST)
+UNIT(base_bitarray) {
+  // Lengths exercise the AVX2, SSE2 and scalar parts of the kernels.
+  static const uint32_t kMaxLen = 23;
+
+  uintptr_t a[kMaxLen], b[kMaxLen], c[kMaxLen], d[kMaxLen];
+  uint32_t seed = 0x12345678;
+
+  for (uint32_t len = 1; len <= kMaxLen; len++) {
+    for (uint32_t k = 0; k < 2 * len; k++) {
+      uint32_t i;
+      for (i = 0; i < len; i++) {
+        seed = seed * 1103515245 + 12345;
+        a[i] = static_cast<uintptr_t>(seed) * 0x9E3779B9u;
+        seed = seed * 1103515245 + 12345;
+        b[i] = static_cast<uintptr_t>(seed) * 0x7F4A7C15u;
+        seed = seed * 1103515245 + 12345;
+        c[i] = static_cast<uintptr_t>(seed);
+      }
+
+      // A single entity of `b` that adds something, or nothing at all.
+      for (i = 0; i < len; i++)
+        b[i] = (i == k) ? b[i] | ~a[i] : b[i] & a[i];
+
+      ::memcpy(d, a, len * sizeof(uintptr_t));
+      bool changed = reinterpret_cast<BitArray*>(d)->addBitsChanged(
+        reinterpret_cast<BitArray*>(b), len);
+
+      for (i = 0; i < len; i++)
+        EXPECT(d[i] == (a[i] | b[i]), "BitArray::addBitsChanged() - wrong data.");
+      EXPECT(changed == (k < len), "BitArray::addBitsChanged() - wrong result.");
+
+      ::memcpy(d, a, len * sizeof(uintptr_t));
+      changed = reinterpret_cast<BitArray*>(d)->addBitsDelChanged(
+        reinterpret_cast<BitArray*>(b), reinterpret_cast<BitArray*>(c), len);
+
+      bool expected = false;
+      for (i = 0; i < len; i++) {
+        uintptr_t t = b[i] & ~c[i];
+        EXPECT(d[i] == (a[i] | t), "BitArray::addBitsDelChanged() - wrong data.");
+        expected |= (t & ~a[i]) != 0;
+      }
+      EXPECT(changed == expected, "BitArray::addBitsDelChanged() - wrong result.");
+    }
+  }
+}
+#endif // ASMJIT_TEST
+
 } // asmjit namespace
 
 // [Api-End]
@@ -109,6 +109,17 @@ struct BitArray {
     return r != 0;
   }
 
+  //! Add bits of `s0`, returns `true` if at least one bit was added (i.e.
+  //! the content has changed).
+  //!
+  //! Used by the dataflow analysis, which spends most of its time here if
+  //! there are many variables, so the bits are processed by SIMD if possible.
+  ASMJIT_API bool addBitsChanged(const BitArray* s0, uint32_t len) noexcept;
+
+  //! Add bits of `s0` that are not in `s1`, returns `true` if at least one
+  //! bit was added (i.e. the content has changed).
+  ASMJIT_API bool addBitsDelChanged(const BitArray* s0, const BitArray* s1, uint32_t len) noexcept;
+
   ASMJIT_INLINE bool _addBitsDelSource(BitArray* s1, uint32_t len) noexcept {
     return _addBitsDelSource(this, s1, len);
   }
@@ -407,11 +407,13 @@ static void x86DetectCpuInfo(CpuInfo* cpuInfo) noexcept {
     cpuInfo->_model    = (regs.eax >> 4) & 0x0F;
     cpuInfo->_stepping = (regs.eax     ) & 0x0F;
 
-    // Use extended family and model fields.
-    if (cpuInfo->_family == 0x0F) {
-      cpuInfo->_family += ((regs.eax >> 20) & 0xFF);
+    // Use extended family and model fields, Intel also uses extended model
+    // of family 6 processors.
+    if (cpuInfo->_family == 0x0F || cpuInfo->_family == 0x06)
       cpuInfo->_model  += ((regs.eax >> 16) & 0x0F) << 4;
-    }
+
+    if (cpuInfo->_family == 0x0F)
+      cpuInfo->_family += ((regs.eax >> 20) & 0xFF);
 
     cpuInfo->_x86Data._processorType        = ((regs.eax >> 12) & 0x03);
     cpuInfo->_x86Data._brandIndex           = ((regs.ebx      ) & 0xFF);
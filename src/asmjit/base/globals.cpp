@@ -9,6 +9,7 @@
 
 // [Dependencies]
 #include "../base/globals.h"
+#include "../base/utils.h"
 
 // [Api-Begin]
 #include "../apibegin.h"
@@ -36,6 +37,10 @@ static const char errorMessages[] = {
   "Illegal addressing\0"
   "Illegal displacement\0"
   "Overlapped arguments\0"
+  "Not supported\0"
+  "Illegal operand\0"
+  "Missing CPU feature\0"
+  "Code mismatch\0"
   "Unknown error\0"
 };
 
@@ -88,6 +93,47 @@ void DebugUtils::assertionFailed(const char* file, int line, const char* msg) no
   ::abort();
 }
 
+// ============================================================================
+// [asmjit::DebugUtils - Alloc]
+// ============================================================================
+
+#if defined(ASMJIT_TRACE_ALLOC)
+static Lock DebugUtils_allocLock;
+static size_t DebugUtils_allocCount;
+
+void* DebugUtils::tracedAlloc(size_t size) noexcept {
+  {
+    AutoLock locked(DebugUtils_allocLock);
+    DebugUtils_allocCount++;
+  }
+  return ::malloc(size);
+}
+
+void* DebugUtils::tracedRealloc(void* p, size_t size) noexcept {
+  {
+    AutoLock locked(DebugUtils_allocLock);
+    DebugUtils_allocCount++;
+  }
+  return ::realloc(p, size);
+}
+
+size_t DebugUtils::getAllocCount() noexcept {
+  AutoLock locked(DebugUtils_allocLock);
+  return DebugUtils_allocCount;
+}
+
+void DebugUtils::resetAllocCount() noexcept {
+  AutoLock locked(DebugUtils_allocLock);
+  DebugUtils_allocCount = 0;
+}
+#else
+size_t DebugUtils::getAllocCount() noexcept {
+  return 0;
+}
+
+void DebugUtils::resetAllocCount() noexcept {}
+#endif // ASMJIT_TRACE_ALLOC
+
 } // asmjit namespace
 
 // [Api-End]
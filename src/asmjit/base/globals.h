@@ -552,6 +552,25 @@ ASMJIT_ENUM(ErrorCode) {
   //! A variable has been assigned more than once to a function argument (Compiler).
   kErrorOverlappedArgs,
 
+  //! The requested feature is not supported by the host operating system.
+  kErrorNotSupported,
+
+  //! Illegal operand.
+  //!
+  //! Returned by instruction validation if an operand (or its size) can't be
+  //! used by the instruction, see `Assembler::kOptionStrictValidation`.
+  kErrorIllegalOperand,
+
+  //! The instruction requires a CPU feature that is not available.
+  //!
+  //! Returned by instruction validation, see `Assembler::kOptionStrictValidation`.
+  kErrorMissingCpuFeature,
+
+  //! Re-assembled code doesn't match the original code.
+  //!
+  //! Returned by round-trip verification, see `X86Disassembler::verify()`.
+  kErrorCodeMismatch,
+
   //! Count of AsmJit error codes.
   kErrorCount
 };
@@ -597,6 +616,17 @@ ASMJIT_API void debugOutput(const char* str) noexcept;
 //! failing code.
 ASMJIT_API void ASMJIT_NORETURN assertionFailed(const char* file, int line, const char* msg) noexcept;
 
+//! Get count of heap allocations (`malloc()` and `realloc()` calls) done by
+//! AsmJit since the start or since the last `resetAllocCount()`.
+//!
+//! Allocations are only counted if AsmJit was built with ASMJIT_TRACE_ALLOC
+//! and default allocation functions, zero is returned otherwise. It's meant
+//! to verify that objects reused by `reset(false)` don't allocate anymore.
+ASMJIT_API size_t getAllocCount() noexcept;
+
+//! Reset the count of heap allocations to zero.
+ASMJIT_API void resetAllocCount() noexcept;
+
 //! \}
 
 } // DebugUtils namespace
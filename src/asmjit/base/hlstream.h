@@ -231,6 +231,17 @@ class HLNode {
   ASMJIT_INLINE uint32_t getTokenId() const noexcept { return _tokenId; }
   ASMJIT_INLINE void setTokenId(uint32_t id) noexcept { _tokenId = id; }
 
+  // --------------------------------------------------------------------------
+  // [Accessors - BlockId]
+  // --------------------------------------------------------------------------
+
+  //! Get whether the node belongs to a basic block.
+  ASMJIT_INLINE bool hasBlockId() const noexcept { return _blockId != kInvalidValue; }
+  //! Get index of the basic block the node belongs to.
+  ASMJIT_INLINE uint32_t getBlockId() const noexcept { return _blockId; }
+  //! Set index of the basic block the node belongs to.
+  ASMJIT_INLINE void setBlockId(uint32_t blockId) noexcept { _blockId = blockId; }
+
   // --------------------------------------------------------------------------
   // [Accessors - VarMap]
   // --------------------------------------------------------------------------
@@ -259,17 +270,6 @@ class HLNode {
   //! Set node state.
   ASMJIT_INLINE void setState(VarState* state) noexcept { _state = state; }
 
-  // --------------------------------------------------------------------------
-  // [Accessors - Liveness]
-  // --------------------------------------------------------------------------
-
-  //! Get whether the node has variable liveness bits.
-  ASMJIT_INLINE bool hasLiveness() const noexcept { return _liveness != nullptr; }
-  //! Get variable liveness bits.
-  ASMJIT_INLINE BitArray* getLiveness() const noexcept { return _liveness; }
-  //! Set variable liveness bits.
-  ASMJIT_INLINE void setLiveness(BitArray* liveness) noexcept { _liveness = liveness; }
-
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
@@ -299,7 +299,12 @@ class HLNode {
   //! different.
   uint32_t _tokenId;
 
-  // TODO: 32-bit gap
+  //! Basic block index.
+  //!
+  //! Assigned by the compiler's context when it builds the control-flow graph,
+  //! `kInvalidValue` if the node doesn't belong to any block (it's unreachable
+  //! or it was created after the graph was built).
+  uint32_t _blockId;
 
   //! Inline comment string, initially set to nullptr.
   const char* _comment;
@@ -308,9 +313,6 @@ class HLNode {
   //! fetch phase.
   VarMap* _map;
 
-  //! Variable liveness bits (initially nullptr, filled by analysis phase).
-  BitArray* _liveness;
-
   //! Saved state.
   //!
   //! Initially nullptr, not all nodes have saved state, only branch/flow control
@@ -190,6 +190,12 @@ public:
     return kErrorOk;
   }
 
+  //! Truncate the vector to at most `n` items.
+  ASMJIT_INLINE void truncate(size_t n) noexcept {
+    if (n < _d->length)
+      _d->length = n;
+  }
+
   //! Get index of `val` or `kInvalidIndex` if not found.
   size_t indexOf(const T& val) const noexcept {
     Data* d = _d;
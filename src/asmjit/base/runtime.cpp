@@ -122,6 +122,12 @@ StaticRuntime::~StaticRuntime() noexcept {}
 // ============================================================================
 
 Error StaticRuntime::add(void** dst, Assembler* assembler) noexcept {
+  Error error = assembler->relax();
+  if (error != kErrorOk) {
+    *dst = nullptr;
+    return error;
+  }
+
   size_t codeSize = assembler->getCodeSize();
   size_t sizeLimit = _sizeLimit;
 
@@ -167,47 +173,290 @@ Error StaticRuntime::release(void* p) noexcept {
 // [asmjit::JitRuntime - Construction / Destruction]
 // ============================================================================
 
-JitRuntime::JitRuntime() noexcept {}
-JitRuntime::~JitRuntime() noexcept {}
+JitRuntime::JitRuntime() noexcept
+  : _funcs(nullptr) {}
+
+JitRuntime::~JitRuntime() noexcept {
+  // The memory of relocatable functions is freed by `VMemMgr`.
+  JitFunc* func = _funcs;
+  while (func != nullptr) {
+    JitFunc* next = func->_next;
+    ASMJIT_FREE(func);
+    func = next;
+  }
+}
 
 // ============================================================================
 // [asmjit::JitRuntime - Interface]
 // ============================================================================
 
-Error JitRuntime::add(void** dst, Assembler* assembler) noexcept {
+//! \internal
+//!
+//! Add code of `assembler` and store its relocated size to `dstSize`.
+static Error jitRuntimeAddCode(JitRuntime* self, void** dst, size_t* dstSize, Assembler* assembler) noexcept {
+  VMemMgr& memMgr = self->_memMgr;
+
+  Error error = assembler->relax();
+  if (error != kErrorOk) {
+    *dst = nullptr;
+    return error;
+  }
+
   size_t codeSize = assembler->getCodeSize();
   if (codeSize == 0) {
     *dst = nullptr;
     return kErrorNoCodeGenerated;
   }
 
-  void* p = _memMgr.alloc(codeSize, getAllocType());
+  void* p = memMgr.alloc(codeSize, self->getAllocType());
   if (p == nullptr) {
     *dst = nullptr;
     return kErrorNoVirtualMemory;
   }
 
-  // Relocate the code and release the unused memory back to `VMemMgr`.
-  size_t relocSize = assembler->relocCode(p);
+  // Relocate the code and release the unused memory back to `VMemMgr`. If
+  // the memory is dual-mapped the code is written through its writable alias.
+  void* pRw = memMgr.getWritablePtr(p);
+  size_t relocSize = assembler->relocCode(pRw, static_cast<Ptr>((uintptr_t)p));
   if (relocSize == 0) {
     *dst = nullptr;
-    _memMgr.release(p);
+    memMgr.release(p);
     return kErrorInvalidState;
   }
 
   if (relocSize < codeSize)
-    _memMgr.shrink(p, relocSize);
+    memMgr.shrink(p, relocSize);
 
-  flush(p, relocSize);
+  self->flush(p, relocSize);
   *dst = p;
+  *dstSize = relocSize;
 
   return kErrorOk;
 }
 
+Error JitRuntime::add(void** dst, Assembler* assembler) noexcept {
+  size_t size;
+  return jitRuntimeAddCode(this, dst, &size, assembler);
+}
+
 Error JitRuntime::release(void* p) noexcept {
   return _memMgr.release(p);
 }
 
+Error JitRuntime::addBatch(void** dst, Assembler* const* assemblers, size_t count) noexcept {
+  PodVectorTmp<size_t, 64> sizes;
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    dst[i] = nullptr;
+
+  for (i = 0; i < count; i++) {
+    Error error = assemblers[i]->relax();
+    if (error != kErrorOk)
+      return error;
+
+    size_t codeSize = assemblers[i]->getCodeSize();
+    if (codeSize == 0)
+      return kErrorNoCodeGenerated;
+
+    if (sizes.append(codeSize) != kErrorOk)
+      return kErrorNoHeapMemory;
+  }
+
+  if (count == 0)
+    return kErrorOk;
+
+  uint32_t allocType = getAllocType();
+  Error error = _memMgr.allocBatch(dst, sizes.getData(), count, allocType);
+
+  if (error != kErrorOk)
+    return error;
+
+  // All functions are in the same virtual memory, so its writable alias has
+  // to be queried only once.
+  uint8_t* base = static_cast<uint8_t*>(dst[0]);
+  uint8_t* baseRw = static_cast<uint8_t*>(_memMgr.getWritablePtr(base));
+  size_t lastSize = 0;
+
+  for (i = 0; i < count; i++) {
+    uint8_t* p = static_cast<uint8_t*>(dst[i]);
+
+    lastSize = assemblers[i]->relocCode(baseRw + (size_t)(p - base), static_cast<Ptr>((uintptr_t)p));
+    if (lastSize == 0) {
+      if (allocType == kVMemAllocFreeable) {
+        for (i = 0; i < count; i++)
+          _memMgr.release(dst[i]);
+      }
+
+      for (i = 0; i < count; i++)
+        dst[i] = nullptr;
+      return kErrorInvalidState;
+    }
+  }
+
+  flush(base, (size_t)(static_cast<uint8_t*>(dst[count - 1]) - base) + lastSize);
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::JitRuntime - Relocatable]
+// ============================================================================
+
+//! \internal
+//!
+//! Patch position-dependent locations of a function moved by `compact()`.
+static bool ASMJIT_CDECL jitRuntimeMoveFunc(void* dst, void* dstRw, void* src, size_t size, void* data) noexcept {
+  ASMJIT_UNUSED(size);
+
+  JitFunc* func = static_cast<JitFunc*>(data);
+  uint8_t* code = static_cast<uint8_t*>(dstRw);
+
+  SignedPtr delta = static_cast<SignedPtr>((uintptr_t)dst - (uintptr_t)src);
+  size_t relocCount = func->_relocCount;
+  const RelocData* rdList = func->_relocs;
+  size_t i;
+
+  // Check relative displacements first, the function is either patched
+  // completely or stays where it is.
+  for (i = 0; i < relocCount; i++) {
+    const RelocData& rd = rdList[i];
+    if (rd.type == kRelocAbsToRel &&
+        !Utils::isInt32(static_cast<SignedPtr>(Utils::readI32u(code + rd.from)) - delta))
+      return false;
+  }
+
+  for (i = 0; i < relocCount; i++) {
+    const RelocData& rd = rdList[i];
+    uint8_t* p = code + rd.from;
+
+    if (rd.type == kRelocRelToAbs) {
+      if (rd.size == 4)
+        Utils::writeU32u(p, Utils::readU32u(p) + static_cast<uint32_t>(delta));
+      else
+        Utils::writeU64u(p, Utils::readU64u(p) + static_cast<uint64_t>(delta));
+    }
+    else {
+      Utils::writeI32u(p, static_cast<int32_t>(Utils::readI32u(p) - delta));
+    }
+  }
+
+  return true;
+}
+
+Error JitRuntime::addRelocatable(JitFunc** dst, Assembler* assembler) noexcept {
+  *dst = nullptr;
+
+  // Permanent memory can't be moved.
+  if (getAllocType() != kVMemAllocFreeable)
+    return kErrorInvalidState;
+
+  size_t rdCount = assembler->_relocations.getLength();
+  const RelocData* rdList = assembler->_relocations.getData();
+
+  JitFunc* func = static_cast<JitFunc*>(ASMJIT_ALLOC(sizeof(JitFunc) + rdCount * sizeof(RelocData)));
+  if (func == nullptr)
+    return kErrorNoHeapMemory;
+
+  void* p;
+  size_t size;
+
+  Error error = jitRuntimeAddCode(this, &p, &size, assembler);
+  if (error != kErrorOk) {
+    ASMJIT_FREE(func);
+    return error;
+  }
+
+  // Only keep locations that depend on the address of the function. Absolute
+  // addresses stay the same and a trampoline is addressed relative to the
+  // function itself.
+  RelocData* relocs = reinterpret_cast<RelocData*>(func + 1);
+  size_t relocCount = 0;
+
+  for (size_t i = 0; i < rdCount; i++) {
+    const RelocData& rd = rdList[i];
+    uint32_t type = rd.type;
+
+    if (type == kRelocAbsToAbs)
+      continue;
+
+    if (type == kRelocTrampoline) {
+      SignedPtr rel = static_cast<SignedPtr>(rd.data - ((Ptr)(uintptr_t)p + rd.from + 4));
+      if (!Utils::isInt32(rel))
+        continue;
+      type = kRelocAbsToRel;
+    }
+
+    relocs[relocCount] = rd;
+    relocs[relocCount].type = type;
+    relocCount++;
+  }
+
+  func->_ptr = p;
+  func->_size = size;
+  func->_prev = nullptr;
+  func->_relocCount = relocCount;
+  func->_relocs = relocs;
+
+  AutoLock locked(_funcLock);
+  func->_next = _funcs;
+  if (_funcs != nullptr)
+    _funcs->_prev = func;
+  _funcs = func;
+
+  *dst = func;
+  return kErrorOk;
+}
+
+Error JitRuntime::releaseRelocatable(JitFunc* func) noexcept {
+  if (func == nullptr)
+    return kErrorOk;
+
+  {
+    AutoLock locked(_funcLock);
+    JitFunc* prev = func->_prev;
+    JitFunc* next = func->_next;
+
+    if (prev != nullptr)
+      prev->_next = next;
+    else
+      _funcs = next;
+
+    if (next != nullptr)
+      next->_prev = prev;
+  }
+
+  Error error = _memMgr.release(func->_ptr);
+  ASMJIT_FREE(func);
+  return error;
+}
+
+Error JitRuntime::compact() noexcept {
+  AutoLock locked(_funcLock);
+  PodVectorTmp<VMemChunk, 64> chunks;
+
+  for (JitFunc* func = _funcs; func != nullptr; func = func->_next) {
+    VMemChunk chunk;
+    chunk.ptr = func->_ptr;
+    chunk.data = func;
+    ASMJIT_PROPAGATE_ERROR(chunks.append(chunk));
+  }
+
+  Error error = _memMgr.compact(chunks.getData(), chunks.getLength(), jitRuntimeMoveFunc);
+
+  size_t count = chunks.getLength();
+  const VMemChunk* chunkList = chunks.getData();
+
+  for (size_t i = 0; i < count; i++) {
+    JitFunc* func = static_cast<JitFunc*>(chunkList[i].data);
+    if (func->_ptr != chunkList[i].ptr) {
+      func->_ptr = chunkList[i].ptr;
+      flush(func->_ptr, func->_size);
+    }
+  }
+
+  return error;
+}
+
 } // asmjit namespace
 
 // [Api-End]
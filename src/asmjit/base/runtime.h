@@ -23,6 +23,7 @@ namespace asmjit {
 
 class Assembler;
 class CpuInfo;
+struct RelocData;
 
 //! \addtogroup asmjit_base
 //! \{
@@ -210,11 +211,48 @@ class ASMJIT_VIRTAPI StaticRuntime : public HostRuntime {
   ASMJIT_API virtual Error release(void* p) noexcept;
 };
 
+// ============================================================================
+// [asmjit::JitFunc]
+// ============================================================================
+
+//! Function added by `JitRuntime::addRelocatable()`.
+//!
+//! The function can be moved by `JitRuntime::compact()`, so it must always be
+//! called through `getPtr()` and must not be referenced by its address from
+//! other generated code.
+struct JitFunc {
+  //! Get the current address of the function.
+  template<typename T>
+  ASMJIT_INLINE T getPtr() const noexcept { return asmjit_cast<T>(_ptr); }
+  //! Get the size of the function.
+  ASMJIT_INLINE size_t getSize() const noexcept { return _size; }
+
+  //! Current address of the function.
+  void* _ptr;
+  //! Size of the function.
+  size_t _size;
+
+  //! Previous function registered in `JitRuntime`.
+  JitFunc* _prev;
+  //! Next function registered in `JitRuntime`.
+  JitFunc* _next;
+
+  //! Count of position-dependent locations.
+  size_t _relocCount;
+  //! Position-dependent locations (`kRelocRelToAbs` or `kRelocAbsToRel`).
+  RelocData* _relocs;
+};
+
 // ============================================================================
 // [asmjit::JitRuntime]
 // ============================================================================
 
 //! JIT runtime.
+//!
+//! Memory is allocated by `VMemMgr`, which can be configured through
+//! `getMemMgr()` before the first function is added. For example W^X mode,
+//! where the code is written through a writable alias of the executable
+//! memory, can be enabled by `getMemMgr()->setDualMappingEnabled(true)`.
 class ASMJIT_VIRTAPI JitRuntime : public HostRuntime {
  public:
   ASMJIT_NO_COPY(JitRuntime)
@@ -247,12 +285,44 @@ class ASMJIT_VIRTAPI JitRuntime : public HostRuntime {
   ASMJIT_API virtual Error add(void** dst, Assembler* assembler) noexcept;
   ASMJIT_API virtual Error release(void* p) noexcept;
 
+  //! Add code of `count` assemblers at once.
+  //!
+  //! The memory for all functions is allocated as a single contiguous run, so
+  //! functions that are used together share cache lines and pages. Each
+  //! function is aligned to 64 bytes, its address is returned in `dst` and it
+  //! can be released separately by `release()`. Returns Status code as \ref
+  //! ErrorCode, on failure all `dst` entries are set to `nullptr`.
+  ASMJIT_API Error addBatch(void** dst, Assembler* const* assemblers, size_t count) noexcept;
+
+  //! Add code of `assembler` as a function that can be moved by `compact()`.
+  //!
+  //! The function is stored to `dst` and has to be released by
+  //! `releaseRelocatable()`. Returns `kErrorInvalidState` if the runtime
+  //! allocates permanent memory, which can't be moved.
+  ASMJIT_API Error addRelocatable(JitFunc** dst, Assembler* assembler) noexcept;
+  //! Release a function added by `addRelocatable()`.
+  ASMJIT_API Error releaseRelocatable(JitFunc* func) noexcept;
+
+  //! Compact the code heap.
+  //!
+  //! Functions added by `addRelocatable()` are moved into fewer memory nodes
+  //! and nodes that end up empty are unmapped, see `VMemMgr::compact()`.
+  //! Functions added by `add()` are never moved and keep their nodes mapped.
+  //!
+  //! NOTE: None of the relocatable functions can be executed during compaction.
+  ASMJIT_API Error compact() noexcept;
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
 
   //! Virtual memory manager.
   VMemMgr _memMgr;
+
+  //! Lock that protects `_funcs`.
+  Lock _funcLock;
+  //! Relocatable functions.
+  JitFunc* _funcs;
 };
 
 //! \}
@@ -1337,6 +1337,164 @@ struct AutoLock {
   Lock& _target;
 };
 
+// ============================================================================
+// [asmjit::Condition]
+// ============================================================================
+
+//! \internal
+//!
+//! Condition variable, waited on with a `Lock` held.
+struct Condition {
+  ASMJIT_NO_COPY(Condition)
+
+  // --------------------------------------------------------------------------
+  // [Windows]
+  // --------------------------------------------------------------------------
+
+#if ASMJIT_OS_WINDOWS
+  typedef CONDITION_VARIABLE Handle;
+
+  //! Create a new `Condition` instance.
+  ASMJIT_INLINE Condition() noexcept { InitializeConditionVariable(&_handle); }
+  //! Destroy the `Condition` instance.
+  ASMJIT_INLINE ~Condition() noexcept {}
+
+  //! Unlock `lock`, wait for a signal and lock `lock` again.
+  ASMJIT_INLINE void wait(Lock& lock) noexcept { SleepConditionVariableCS(&_handle, &lock._handle, INFINITE); }
+  //! Wake up one waiting thread.
+  ASMJIT_INLINE void signal() noexcept { WakeConditionVariable(&_handle); }
+  //! Wake up all waiting threads.
+  ASMJIT_INLINE void broadcast() noexcept { WakeAllConditionVariable(&_handle); }
+#endif // ASMJIT_OS_WINDOWS
+
+  // --------------------------------------------------------------------------
+  // [Posix]
+  // --------------------------------------------------------------------------
+
+#if ASMJIT_OS_POSIX
+  typedef pthread_cond_t Handle;
+
+  //! Create a new `Condition` instance.
+  ASMJIT_INLINE Condition() noexcept { pthread_cond_init(&_handle, nullptr); }
+  //! Destroy the `Condition` instance.
+  ASMJIT_INLINE ~Condition() noexcept { pthread_cond_destroy(&_handle); }
+
+  //! Unlock `lock`, wait for a signal and lock `lock` again.
+  ASMJIT_INLINE void wait(Lock& lock) noexcept { pthread_cond_wait(&_handle, &lock._handle); }
+  //! Wake up one waiting thread.
+  ASMJIT_INLINE void signal() noexcept { pthread_cond_signal(&_handle); }
+  //! Wake up all waiting threads.
+  ASMJIT_INLINE void broadcast() noexcept { pthread_cond_broadcast(&_handle); }
+#endif // ASMJIT_OS_POSIX
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Native handle.
+  Handle _handle;
+};
+
+// ============================================================================
+// [asmjit::Thread]
+// ============================================================================
+
+//! \internal
+//!
+//! Thread.
+struct Thread {
+  ASMJIT_NO_COPY(Thread)
+
+  //! Thread entry point.
+  typedef void (ASMJIT_CDECL* Entry)(void* arg);
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_INLINE Thread() noexcept : _entry(nullptr), _arg(nullptr), _started(false) {}
+  ASMJIT_INLINE ~Thread() noexcept { join(); }
+
+  // --------------------------------------------------------------------------
+  // [Windows]
+  // --------------------------------------------------------------------------
+
+#if ASMJIT_OS_WINDOWS
+  typedef HANDLE Handle;
+
+  //! Start the thread calling `entry(arg)`, returns `false` on failure.
+  ASMJIT_INLINE bool start(Entry entry, void* arg) noexcept {
+    ASMJIT_ASSERT(!_started);
+
+    _entry = entry;
+    _arg = arg;
+    _handle = ::CreateThread(nullptr, 0, _run, this, 0, nullptr);
+    _started = _handle != nullptr;
+    return _started;
+  }
+
+  //! Wait for the thread to finish (no-op if not started).
+  ASMJIT_INLINE void join() noexcept {
+    if (_started) {
+      ::WaitForSingleObject(_handle, INFINITE);
+      ::CloseHandle(_handle);
+      _started = false;
+    }
+  }
+
+  static DWORD WINAPI _run(LPVOID p) noexcept {
+    Thread* self = static_cast<Thread*>(p);
+    self->_entry(self->_arg);
+    return 0;
+  }
+#endif // ASMJIT_OS_WINDOWS
+
+  // --------------------------------------------------------------------------
+  // [Posix]
+  // --------------------------------------------------------------------------
+
+#if ASMJIT_OS_POSIX
+  typedef pthread_t Handle;
+
+  //! Start the thread calling `entry(arg)`, returns `false` on failure.
+  ASMJIT_INLINE bool start(Entry entry, void* arg) noexcept {
+    ASMJIT_ASSERT(!_started);
+
+    _entry = entry;
+    _arg = arg;
+    _started = ::pthread_create(&_handle, nullptr, _run, this) == 0;
+    return _started;
+  }
+
+  //! Wait for the thread to finish (no-op if not started).
+  ASMJIT_INLINE void join() noexcept {
+    if (_started) {
+      ::pthread_join(_handle, nullptr);
+      _started = false;
+    }
+  }
+
+  static void* _run(void* p) noexcept {
+    Thread* self = static_cast<Thread*>(p);
+    self->_entry(self->_arg);
+    return nullptr;
+  }
+#endif // ASMJIT_OS_POSIX
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Native handle.
+  Handle _handle;
+  //! Entry point.
+  Entry _entry;
+  //! Entry point argument.
+  void* _arg;
+  //! Whether the thread was started and not joined yet.
+  bool _started;
+};
+
 //! \}
 
 } // asmjit namespace
@@ -14,9 +14,15 @@
 #if ASMJIT_OS_POSIX
 # include <sys/types.h>
 # include <sys/mman.h>
+# include <fcntl.h>
+# include <stdio.h>
 # include <unistd.h>
 #endif // ASMJIT_OS_POSIX
 
+#if ASMJIT_OS_LINUX
+# include <sys/syscall.h>
+#endif // ASMJIT_OS_LINUX
+
 // [Api-Begin]
 #include "../apibegin.h"
 
@@ -58,6 +64,18 @@
 //
 // These bits show that there are 12 allocated blocks (X) of 64 bytes, so total
 // size allocated is 768 bytes. Maximum count of continuous memory is 12 * 64.
+//
+// Bit arrays are scanned a word at a time, runs of free and used blocks are
+// found by `_FindBit()`, which uses a bit-scan instruction instead of testing
+// bits one by one.
+//
+// Each node keeps its largest free run and is linked into a free bin based on
+// it. Bins below `kBinExact` contain nodes having exactly that many free blocks
+// in a row, the remaining bins are logarithmic. A non-empty bin is marked in
+// `VMemMgr::_binMask`, so finding a node that can satisfy an allocation is a
+// bit-scan over a few words, not a walk over all nodes. Allocations don't
+// rescan the node, so its largest free run is only an upper bound, which is
+// corrected when the lookup finds out that the node doesn't have such run.
 
 namespace asmjit {
 
@@ -76,6 +94,7 @@ struct VMemLocal {
 
   size_t pageSize;
   size_t pageGranularity;
+  size_t hugePageSize;
   HANDLE hProcess;
 };
 static VMemLocal vMemLocal;
@@ -89,6 +108,7 @@ static const VMemLocal& vMemGet() noexcept {
 
     vMem.pageSize = Utils::alignToPowerOf2<uint32_t>(info.dwPageSize);
     vMem.pageGranularity = info.dwAllocationGranularity;
+    vMem.hugePageSize = ::GetLargePageMinimum();
 
     vMem.hProcess = ::GetCurrentProcess();
   }
@@ -106,6 +126,11 @@ size_t VMemUtil::getPageGranularity() noexcept {
   return vMem.pageGranularity;
 }
 
+size_t VMemUtil::getHugePageSize() noexcept {
+  const VMemLocal& vMem = vMemGet();
+  return vMem.hugePageSize;
+}
+
 void* VMemUtil::alloc(size_t length, size_t* allocated, uint32_t flags) noexcept {
   return allocProcessMemory(static_cast<HANDLE>(0), length, allocated, flags);
 }
@@ -128,6 +153,19 @@ void* VMemUtil::allocProcessMemory(HANDLE hProcess, size_t length, size_t* alloc
   else
     protectFlags |= (flags & kVMemFlagWritable) ? PAGE_READWRITE : PAGE_READONLY;
 
+  // Large pages require `SeLockMemoryPrivilege`, fall back to regular pages if
+  // the process doesn't have it.
+  if ((flags & kVMemFlagHugePages) != 0 && vMem.hugePageSize != 0) {
+    size_t hSize = Utils::alignTo(length, vMem.hugePageSize);
+    LPVOID hBase = ::VirtualAllocEx(hProcess, nullptr, hSize, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, protectFlags);
+
+    if (hBase != nullptr) {
+      if (allocated != nullptr)
+        *allocated = hSize;
+      return hBase;
+    }
+  }
+
   LPVOID mBase = ::VirtualAllocEx(hProcess, nullptr, mSize, MEM_COMMIT | MEM_RESERVE, protectFlags);
   if (mBase == nullptr)
     return nullptr;
@@ -150,6 +188,23 @@ Error VMemUtil::releaseProcessMemory(HANDLE hProcess, void* addr, size_t /* leng
     return kErrorInvalidState;
   return kErrorOk;
 }
+
+Error VMemUtil::allocDualMapping(size_t length, size_t* allocated, void** rx, void** rw) noexcept {
+  ASMJIT_UNUSED(length);
+  ASMJIT_UNUSED(allocated);
+
+  *rx = nullptr;
+  *rw = nullptr;
+  return kErrorNotSupported;
+}
+
+Error VMemUtil::releaseDualMapping(void* rx, void* rw, size_t length) noexcept {
+  ASMJIT_UNUSED(rx);
+  ASMJIT_UNUSED(rw);
+  ASMJIT_UNUSED(length);
+
+  return kErrorNotSupported;
+}
 #endif // ASMJIT_OS_WINDOWS
 
 // ============================================================================
@@ -167,16 +222,44 @@ Error VMemUtil::releaseProcessMemory(HANDLE hProcess, void* addr, size_t /* leng
 struct VMemLocal {
   size_t pageSize;
   size_t pageGranularity;
+  size_t hugePageSize;
 };
 static VMemLocal vMemLocal;
 
+// Get the default huge page size as reported by the kernel, zero if the host
+// doesn't support huge pages.
+static size_t vMemQueryHugePageSize() noexcept {
+#if ASMJIT_OS_LINUX && (defined(MAP_HUGETLB) || defined(MADV_HUGEPAGE))
+  FILE* f = ::fopen("/proc/meminfo", "r");
+  if (f == nullptr)
+    return 0;
+
+  char line[256];
+  size_t size = 0;
+
+  while (::fgets(line, ASMJIT_ARRAY_SIZE(line), f) != nullptr) {
+    unsigned long kb;
+    if (::sscanf(line, "Hugepagesize: %lu kB", &kb) == 1) {
+      size = static_cast<size_t>(kb) * 1024;
+      break;
+    }
+  }
+
+  ::fclose(f);
+  return Utils::isPowerOf2(size) ? size : static_cast<size_t>(0);
+#else
+  return 0;
+#endif // ASMJIT_OS_LINUX && (MAP_HUGETLB || MADV_HUGEPAGE)
+}
+
 static const VMemLocal& vMemGet() noexcept {
   VMemLocal& vMem = vMemLocal;
 
   if (!vMem.pageSize) {
     size_t pageSize = ::getpagesize();
-    vMem.pageSize = pageSize;
     vMem.pageGranularity = Utils::iMax<size_t>(pageSize, 65536);
+    vMem.hugePageSize = vMemQueryHugePageSize();
+    vMem.pageSize = pageSize;
   }
 
   return vMem;
@@ -192,6 +275,70 @@ size_t VMemUtil::getPageGranularity() noexcept {
   return vMem.pageGranularity;
 }
 
+size_t VMemUtil::getHugePageSize() noexcept {
+  const VMemLocal& vMem = vMemGet();
+  return vMem.hugePageSize;
+}
+
+// Allocate memory backed by huge pages, returns `nullptr` if not possible.
+static void* vMemAllocHugePages(size_t length, size_t* allocated, int protection) noexcept {
+#if defined(MAP_HUGETLB) || defined(MADV_HUGEPAGE)
+  const VMemLocal& vMem = vMemGet();
+  size_t hugeSize = vMem.hugePageSize;
+
+  if (hugeSize == 0)
+    return nullptr;
+
+  size_t msize = Utils::alignTo<size_t>(length, hugeSize);
+  void* mbase;
+
+#if defined(MAP_HUGETLB)
+  // Explicit huge pages, only succeeds if the system has some reserved.
+  mbase = ::mmap(nullptr, msize, protection, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (mbase != MAP_FAILED) {
+    if (allocated != nullptr)
+      *allocated = msize;
+    return mbase;
+  }
+#endif // MAP_HUGETLB
+
+#if defined(MADV_HUGEPAGE)
+  // Transparent huge pages - the kernel can only use them for aligned ranges,
+  // so map one huge page more and unmap the unaligned head and tail.
+  mbase = ::mmap(nullptr, msize + hugeSize, protection, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mbase == MAP_FAILED)
+    return nullptr;
+
+  uint8_t* raw = static_cast<uint8_t*>(mbase);
+  uint8_t* aligned = reinterpret_cast<uint8_t*>(
+    Utils::alignTo<uintptr_t>(reinterpret_cast<uintptr_t>(raw), hugeSize));
+
+  size_t head = (size_t)(aligned - raw);
+  size_t tail = hugeSize - head;
+
+  if (head != 0)
+    ::munmap(raw, head);
+  if (tail != 0)
+    ::munmap(aligned + msize, tail);
+
+  // Only a hint, the memory is usable even if the kernel ignores it.
+  ::madvise(aligned, msize, MADV_HUGEPAGE);
+
+  if (allocated != nullptr)
+    *allocated = msize;
+  return aligned;
+#else
+  return nullptr;
+#endif // MADV_HUGEPAGE
+#else
+  ASMJIT_UNUSED(length);
+  ASMJIT_UNUSED(allocated);
+  ASMJIT_UNUSED(protection);
+
+  return nullptr;
+#endif // MAP_HUGETLB || MADV_HUGEPAGE
+}
+
 void* VMemUtil::alloc(size_t length, size_t* allocated, uint32_t flags) noexcept {
   const VMemLocal& vMem = vMemGet();
   size_t msize = Utils::alignTo<size_t>(length, vMem.pageSize);
@@ -200,6 +347,12 @@ void* VMemUtil::alloc(size_t length, size_t* allocated, uint32_t flags) noexcept
   if (flags & kVMemFlagWritable  ) protection |= PROT_WRITE;
   if (flags & kVMemFlagExecutable) protection |= PROT_EXEC;
 
+  if (flags & kVMemFlagHugePages) {
+    void* hbase = vMemAllocHugePages(length, allocated, protection);
+    if (hbase != nullptr)
+      return hbase;
+  }
+
   void* mbase = ::mmap(nullptr, msize, protection, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
   if (mbase == MAP_FAILED)
     return nullptr;
@@ -215,6 +368,80 @@ Error VMemUtil::release(void* addr, size_t length) noexcept {
 
   return kErrorOk;
 }
+
+// Create an anonymous file descriptor that can be mapped multiple times. Linux
+// provides `memfd_create()`, other systems use a shared memory object that is
+// unlinked immediately after it has been created.
+static int vMemOpenAnonymousFile() noexcept {
+#if ASMJIT_OS_LINUX && defined(SYS_memfd_create)
+  int fd = static_cast<int>(::syscall(SYS_memfd_create, "asmjit", 1U /* MFD_CLOEXEC */));
+  if (fd >= 0)
+    return fd;
+#endif // ASMJIT_OS_LINUX && SYS_memfd_create
+
+  static uint32_t counter;
+
+  for (uint32_t i = 0; i < 32; i++) {
+    char name[64];
+    ::snprintf(name, ASMJIT_ARRAY_SIZE(name), "/asmjit-%u-%u",
+      static_cast<unsigned int>(::getpid()),
+      static_cast<unsigned int>(++counter));
+
+    int fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+      ::shm_unlink(name);
+      return fd;
+    }
+  }
+
+  return -1;
+}
+
+Error VMemUtil::allocDualMapping(size_t length, size_t* allocated, void** rx, void** rw) noexcept {
+  const VMemLocal& vMem = vMemGet();
+  size_t msize = Utils::alignTo<size_t>(length, vMem.pageSize);
+
+  *rx = nullptr;
+  *rw = nullptr;
+
+  int fd = vMemOpenAnonymousFile();
+  if (fd < 0)
+    return kErrorNotSupported;
+
+  if (::ftruncate(fd, static_cast<off_t>(msize)) != 0) {
+    ::close(fd);
+    return kErrorNoVirtualMemory;
+  }
+
+  void* rxBase = ::mmap(nullptr, msize, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+  if (rxBase == MAP_FAILED) {
+    ::close(fd);
+    return kErrorNoVirtualMemory;
+  }
+
+  void* rwBase = ::mmap(nullptr, msize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (rwBase == MAP_FAILED) {
+    ::munmap(rxBase, msize);
+    ::close(fd);
+    return kErrorNoVirtualMemory;
+  }
+
+  // Mappings keep the memory alive, the descriptor is not needed anymore.
+  ::close(fd);
+
+  if (allocated != nullptr)
+    *allocated = msize;
+
+  *rx = rxBase;
+  *rw = rwBase;
+  return kErrorOk;
+}
+
+Error VMemUtil::releaseDualMapping(void* rx, void* rw, size_t length) noexcept {
+  Error e0 = release(rx, length);
+  Error e1 = release(rw, length);
+  return e0 != kErrorOk ? e0 : e1;
+}
 #endif // ASMJIT_OS_POSIX
 
 // ============================================================================
@@ -229,6 +456,218 @@ enum {
   kBitsPerEntity = (sizeof(size_t) * 8)
 };
 
+//! \internal
+//!
+//! Get index of the first set bit in `x`, which must not be zero.
+static ASMJIT_INLINE size_t _FindFirstBit(size_t x) noexcept {
+  ASMJIT_ASSERT(x != 0);
+
+#if ASMJIT_ARCH_64BIT
+  uint32_t lo = static_cast<uint32_t>(x);
+  if (lo != 0)
+    return Utils::findFirstBit(lo);
+  return 32 + Utils::findFirstBit(static_cast<uint32_t>(x >> 32));
+#else
+  return Utils::findFirstBit(static_cast<uint32_t>(x));
+#endif // ASMJIT_ARCH_64BIT
+}
+
+//! \internal
+//!
+//! Get index of the last set bit in `x`, which must not be zero.
+static ASMJIT_INLINE size_t _FindLastBit(size_t x) noexcept {
+  ASMJIT_ASSERT(x != 0);
+
+#if ASMJIT_CC_MSC_GE(14, 0, 0) && ASMJIT_ARCH_64BIT
+  DWORD i;
+  _BitScanReverse64(&i, x);
+  return static_cast<size_t>(i);
+#elif ASMJIT_CC_MSC_GE(14, 0, 0)
+  DWORD i;
+  _BitScanReverse(&i, x);
+  return static_cast<size_t>(i);
+#elif ASMJIT_CC_GCC_GE(3, 4, 6) || ASMJIT_CC_CLANG
+  return (kBitsPerEntity - 1) ^ static_cast<size_t>(__builtin_clzl(static_cast<unsigned long>(x)));
+#else
+  size_t i = kBitsPerEntity - 1;
+  while (!(x >> i))
+    i--;
+  return i;
+#endif
+}
+
+//! \internal
+//!
+//! Find the first bit having value `v` in `buf` in range [`from`, `end`).
+//!
+//! Returns `end` if there is no such bit.
+static size_t _FindBit(const size_t* buf, size_t from, size_t end, bool v) noexcept {
+  if (from >= end)
+    return end;
+
+  size_t flip = v ? (size_t)0 : ~(size_t)0;
+  size_t i = from / kBitsPerEntity;
+  size_t bits = (buf[i] ^ flip) & (~(size_t)0 << (from % kBitsPerEntity));
+
+  for (;;) {
+    if (bits != 0) {
+      size_t index = i * kBitsPerEntity + _FindFirstBit(bits);
+      return index < end ? index : end;
+    }
+
+    if (++i * kBitsPerEntity >= end)
+      return end;
+    bits = buf[i] ^ flip;
+  }
+}
+
+//! \internal
+//!
+//! Find the last bit having value `v` in `buf` in range [0, `end`).
+//!
+//! Returns the index of the bit that follows it or zero if there is no such bit.
+static size_t _FindBitBack(const size_t* buf, size_t end, bool v) noexcept {
+  if (end == 0)
+    return 0;
+
+  size_t flip = v ? (size_t)0 : ~(size_t)0;
+  size_t i = (end - 1) / kBitsPerEntity;
+  size_t bits = (buf[i] ^ flip) & (~(size_t)0 >> (kBitsPerEntity - 1 - (end - 1) % kBitsPerEntity));
+
+  for (;;) {
+    if (bits != 0)
+      return i * kBitsPerEntity + _FindLastBit(bits) + 1;
+
+    if (i == 0)
+      return 0;
+    bits = buf[--i] ^ flip;
+  }
+}
+
+//! \internal
+//!
+//! Find the first run of `need` zero bits in `buf` having `len` bits.
+//!
+//! Returns the index of the run or `kInvalidIndex` if there is no such run.
+static size_t _FindRun(const size_t* buf, size_t len, size_t need) noexcept {
+  size_t count = (len + kBitsPerEntity - 1) / kBitsPerEntity;
+  size_t cont = 0; // Count of zero bits at the end of the previous words.
+
+  for (size_t i = 0; i < count; i++) {
+    size_t bits = buf[i];
+
+    // Bits outside of `buf` are considered set.
+    if (i == count - 1 && (len % kBitsPerEntity) != 0)
+      bits |= ~(size_t)0 << (len % kBitsPerEntity);
+
+    if (bits == 0) {
+      cont += kBitsPerEntity;
+      if (cont >= need)
+        return (i + 1) * kBitsPerEntity - cont;
+      continue;
+    }
+
+    // Run that started in previous words and ends in this word.
+    size_t low = _FindFirstBit(bits);
+    if (cont + low >= need)
+      return i * kBitsPerEntity - cont;
+
+    // Runs inside this word - `zeros` is reduced so only bits starting a run
+    // of `need` zeros remain.
+    if (need < kBitsPerEntity) {
+      size_t zeros = ~bits;
+      size_t n = 1;
+
+      while (n < need && zeros != 0) {
+        size_t shift = Utils::iMin<size_t>(n, need - n);
+        zeros &= zeros >> shift;
+        n += shift;
+      }
+
+      if (zeros != 0)
+        return i * kBitsPerEntity + _FindFirstBit(zeros);
+    }
+
+    cont = kBitsPerEntity - 1 - _FindLastBit(bits);
+  }
+
+  return kInvalidIndex;
+}
+
+//! \internal
+//!
+//! Get the length of the longest run of zero bits in `buf` having `len` bits.
+static size_t _LongestRun(const size_t* buf, size_t len) noexcept {
+  size_t count = (len + kBitsPerEntity - 1) / kBitsPerEntity;
+  size_t cont = 0; // Count of zero bits at the end of the previous words.
+  size_t longest = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    size_t bits = buf[i];
+
+    // Bits outside of `buf` are considered set.
+    if (i == count - 1 && (len % kBitsPerEntity) != 0)
+      bits |= ~(size_t)0 << (len % kBitsPerEntity);
+
+    if (bits == 0) {
+      cont += kBitsPerEntity;
+      continue;
+    }
+
+    // Run that started in previous words and ends in this word.
+    size_t low = cont + _FindFirstBit(bits);
+    if (longest < low)
+      longest = low;
+
+    // Runs inside this word - only check for runs longer than `longest`.
+    size_t zeros = ~bits;
+    size_t n = 1;
+
+    while (n <= longest && zeros != 0) {
+      size_t shift = Utils::iMin<size_t>(n, longest + 1 - n);
+      zeros &= zeros >> shift;
+      n += shift;
+    }
+
+    // Runs of `n` zeros exist, double `n` while runs of `2n` zeros exist and
+    // then narrow it down, shifting by at most `n` keeps the runs contiguous.
+    if (zeros != 0) {
+      size_t step = n;
+
+      for (;;) {
+        size_t z = step < kBitsPerEntity ? zeros & (zeros >> step) : (size_t)0;
+        if (z == 0)
+          break;
+
+        zeros = z;
+        n += step;
+        step = n;
+      }
+
+      // There are no runs of `n + step` zeros.
+      while (step > 1) {
+        size_t half = step >> 1;
+        size_t z = zeros & (zeros >> half);
+
+        if (z != 0) {
+          zeros = z;
+          n += half;
+          step -= half;
+        }
+        else {
+          step = half;
+        }
+      }
+
+      longest = n;
+    }
+
+    cont = kBitsPerEntity - 1 - _FindLastBit(bits);
+  }
+
+  return longest > cont ? longest : cont;
+}
+
 //! \internal
 //!
 //! Set `len` bits in `buf` starting at `index` bit index.
@@ -259,6 +698,36 @@ static void _SetBits(size_t* buf, size_t index, size_t len) noexcept {
     *buf |= ((~(size_t)0) >> (kBitsPerEntity - len));
 }
 
+//! \internal
+//!
+//! Clear `len` bits in `buf` starting at `index` bit index.
+static void _ClearBits(size_t* buf, size_t index, size_t len) noexcept {
+  if (len == 0)
+    return;
+
+  size_t i = index / kBitsPerEntity;
+  size_t j = index % kBitsPerEntity;
+
+  // How many bytes process in the first group.
+  size_t c = kBitsPerEntity - j;
+  if (c > len)
+    c = len;
+
+  // Offset.
+  buf += i;
+
+  *buf++ &= ~(((~(size_t)0) >> (kBitsPerEntity - c)) << j);
+  len -= c;
+
+  while (len >= kBitsPerEntity) {
+    *buf++ = 0;
+    len -= kBitsPerEntity;
+  }
+
+  if (len)
+    *buf &= ~((~(size_t)0) >> (kBitsPerEntity - len));
+}
+
 // ============================================================================
 // [asmjit::VMemMgr::TypeDefs]
 // ============================================================================
@@ -362,6 +831,7 @@ struct VMemMgr::MemNode : public RbNode {
 
   ASMJIT_INLINE void fillData(MemNode* other) noexcept {
     mem = other->mem;
+    memRw = other->memRw;
 
     size = other->size;
     used = other->used;
@@ -379,12 +849,17 @@ struct VMemMgr::MemNode : public RbNode {
 
   MemNode* prev;         // Prev node in list.
   MemNode* next;         // Next node in list.
+  uint8_t* memRw;        // Writable alias of `mem` (same as `mem` if not dual-mapped).
+
+  MemNode* binPrev;      // Prev node in free bin.
+  MemNode* binNext;      // Next node in free bin.
 
   size_t size;           // How many bytes contain this node.
   size_t used;           // How many bytes are used in this node.
   size_t blocks;         // How many blocks are here.
   size_t density;        // Minimum count of allocated bytes in this node (also alignment).
-  size_t largestBlock;   // Contains largest block that can be allocated.
+  size_t largestBlock;   // Largest count of free blocks in a row (upper bound).
+  uint32_t bin;          // Free bin index.
 
   size_t* baUsed;        // Contains bits about used blocks       (0 = unused, 1 = used).
   size_t* baCont;        // Contains bits about continuous blocks (0 = stop  , 1 = continue).
@@ -413,6 +888,7 @@ struct VMemMgr::PermanentNode {
 
   PermanentNode* prev;   // Pointer to prev chunk or nullptr.
   uint8_t* mem;          // Base pointer (virtual memory address).
+  uint8_t* memRw;        // Writable alias of `mem` (same as `mem` if not dual-mapped).
   size_t size;           // Count of bytes allocated.
   size_t used;           // Count of bytes used.
 };
@@ -424,26 +900,182 @@ struct VMemMgr::PermanentNode {
 //! \internal
 //!
 //! Helper to avoid `#ifdef`s in the code.
-ASMJIT_INLINE uint8_t* vMemMgrAllocVMem(VMemMgr* self, size_t size, size_t* vSize) noexcept {
+//!
+//! The writable alias is returned in `rw`, it's the same as the returned
+//! pointer if the memory is not dual-mapped.
+ASMJIT_INLINE uint8_t* vMemMgrAllocVMem(VMemMgr* self, size_t size, size_t* vSize, uint8_t** rw) noexcept {
+  if (self->_dualMapping) {
+    void* rxBase;
+    void* rwBase;
+
+    if (VMemUtil::allocDualMapping(size, vSize, &rxBase, &rwBase) != kErrorOk)
+      return nullptr;
+
+    *rw = static_cast<uint8_t*>(rwBase);
+    return static_cast<uint8_t*>(rxBase);
+  }
+
   uint32_t flags = kVMemFlagWritable | kVMemFlagExecutable;
+  if (self->_hugePages)
+    flags |= kVMemFlagHugePages;
+
 #if !ASMJIT_OS_WINDOWS
-  return static_cast<uint8_t*>(VMemUtil::alloc(size, vSize, flags));
+  uint8_t* p = static_cast<uint8_t*>(VMemUtil::alloc(size, vSize, flags));
 #else
-  return static_cast<uint8_t*>(VMemUtil::allocProcessMemory(self->_hProcess, size, vSize, flags));
+  uint8_t* p = static_cast<uint8_t*>(VMemUtil::allocProcessMemory(self->_hProcess, size, vSize, flags));
 #endif
+
+  *rw = p;
+  return p;
 }
 
 //! \internal
 //!
 //! Helper to avoid `#ifdef`s in the code.
-ASMJIT_INLINE Error vMemMgrReleaseVMem(VMemMgr* self, void* p, size_t vSize) noexcept {
+ASMJIT_INLINE Error vMemMgrReleaseVMem(VMemMgr* self, void* p, void* rw, size_t vSize) noexcept {
+  if (p != rw)
+    return VMemUtil::releaseDualMapping(p, rw, vSize);
+
 #if !ASMJIT_OS_WINDOWS
+  ASMJIT_UNUSED(self);
   return VMemUtil::release(p, vSize);
 #else
   return VMemUtil::releaseProcessMemory(self->_hProcess, p, vSize);
 #endif
 }
 
+//! \internal
+//!
+//! Get a free bin index of a node having `largest` free blocks in a row.
+static ASMJIT_INLINE uint32_t vMemMgrGetBin(size_t largest) noexcept {
+  if (largest < VMemMgr::kBinExact)
+    return static_cast<uint32_t>(largest);
+
+  uint32_t bin = VMemMgr::kBinExact;
+  while ((largest >>= 1) >= VMemMgr::kBinExact)
+    bin++;
+  return bin;
+}
+
+//! \internal
+//!
+//! Link `node` to the free bin matching its `largestBlock`.
+static void vMemMgrLinkBin(VMemMgr* self, MemNode* node) noexcept {
+  uint32_t bin = vMemMgrGetBin(node->largestBlock);
+  MemNode* first = self->_bins[bin];
+
+  node->bin = bin;
+  node->binPrev = nullptr;
+  node->binNext = first;
+
+  if (first != nullptr)
+    first->binPrev = node;
+
+  self->_bins[bin] = node;
+  self->_binMask[bin / 32] |= static_cast<uint32_t>(1) << (bin % 32);
+}
+
+//! \internal
+//!
+//! Unlink `node` from its free bin.
+static void vMemMgrUnlinkBin(VMemMgr* self, MemNode* node) noexcept {
+  uint32_t bin = node->bin;
+  MemNode* prev = node->binPrev;
+  MemNode* next = node->binNext;
+
+  if (prev != nullptr)
+    prev->binNext = next;
+  else
+    self->_bins[bin] = next;
+
+  if (next != nullptr)
+    next->binPrev = prev;
+
+  if (self->_bins[bin] == nullptr)
+    self->_binMask[bin / 32] &= ~(static_cast<uint32_t>(1) << (bin % 32));
+}
+
+//! \internal
+//!
+//! Set the largest free run of `node` and move it to a matching bin.
+static void vMemMgrUpdateBin(VMemMgr* self, MemNode* node, size_t largest) noexcept {
+  node->largestBlock = largest;
+
+  if (node->bin != vMemMgrGetBin(largest)) {
+    vMemMgrUnlinkBin(self, node);
+    vMemMgrLinkBin(self, node);
+  }
+}
+
+//! \internal
+//!
+//! Update the largest free run of `node` after blocks [`start`, `end`) have
+//! been freed.
+static void vMemMgrUpdateBinFreed(VMemMgr* self, MemNode* node, size_t start, size_t end) noexcept {
+  // Free run that contains the freed blocks, including its neighbors.
+  start = _FindBitBack(node->baUsed, start, true);
+  end = _FindBit(node->baUsed, end, node->blocks, true);
+
+  if (end - start > node->largestBlock)
+    vMemMgrUpdateBin(self, node, end - start);
+}
+
+//! \internal
+//!
+//! Find a node whose largest free run is at least `need` blocks.
+static MemNode* vMemMgrFindBin(VMemMgr* self, size_t need) noexcept {
+  uint32_t bin = vMemMgrGetBin(need);
+
+  // Logarithmic bins contain nodes that may not be large enough.
+  if (bin >= VMemMgr::kBinExact) {
+    for (MemNode* node = self->_bins[bin]; node != nullptr; node = node->binNext)
+      if (node->largestBlock >= need)
+        return node;
+    bin++;
+  }
+
+  // Any node in the first non-empty bin that follows is large enough.
+  for (uint32_t i = bin / 32; i < VMemMgr::kBinCount / 32; i++) {
+    uint32_t mask = self->_binMask[i];
+    if (i == bin / 32)
+      mask &= ~static_cast<uint32_t>(0) << (bin % 32);
+
+    if (mask != 0)
+      return self->_bins[i * 32 + Utils::findFirstBit(mask)];
+  }
+
+  return nullptr;
+}
+
+//! \internal
+//!
+//! Find a node that has at least `need` free blocks in a row and store the
+//! index of the first such run to `index`.
+//!
+//! Allocations don't rescan nodes, so the largest free run of a node is only
+//! an upper bound. A node that doesn't have the run is rescanned and moved to
+//! the bin of its real largest run, then the search continues.
+static MemNode* vMemMgrFindNode(VMemMgr* self, size_t need, size_t* index) noexcept {
+  // The node of the last allocation is tried first, it's most likely cached.
+  MemNode* node = self->_rover;
+  if (node == nullptr || node->largestBlock < need)
+    node = vMemMgrFindBin(self, need);
+
+  while (node != nullptr) {
+    size_t i = _FindRun(node->baUsed, node->blocks, need);
+    if (i != kInvalidIndex) {
+      self->_rover = node;
+      *index = i;
+      return node;
+    }
+
+    vMemMgrUpdateBin(self, node, _LongestRun(node->baUsed, node->blocks));
+    node = vMemMgrFindBin(self, need);
+  }
+
+  return nullptr;
+}
+
 //! \internal
 //!
 //! Check whether the Red-Black tree is valid.
@@ -458,7 +1090,8 @@ static bool vMemMgrCheckTree(VMemMgr* self) noexcept {
 //! Returns set-up `MemNode*` or nullptr if allocation failed.
 static MemNode* vMemMgrCreateNode(VMemMgr* self, size_t size, size_t density) noexcept {
   size_t vSize;
-  uint8_t* vmem = vMemMgrAllocVMem(self, size, &vSize);
+  uint8_t* vmemRw;
+  uint8_t* vmem = vMemMgrAllocVMem(self, size, &vSize, &vmemRw);
 
   // Out of memory.
   if (vmem == nullptr)
@@ -472,7 +1105,7 @@ static MemNode* vMemMgrCreateNode(VMemMgr* self, size_t size, size_t density) no
 
   // Out of memory.
   if (node == nullptr || data == nullptr) {
-    vMemMgrReleaseVMem(self, vmem, vSize);
+    vMemMgrReleaseVMem(self, vmem, vmemRw, vSize);
     if (node) ASMJIT_FREE(node);
     if (data) ASMJIT_FREE(data);
     return nullptr;
@@ -487,12 +1120,13 @@ static MemNode* vMemMgrCreateNode(VMemMgr* self, size_t size, size_t density) no
   // Initialize MemNode data.
   node->prev = nullptr;
   node->next = nullptr;
+  node->memRw = vmemRw;
 
   node->size = vSize;
   node->used = 0;
   node->blocks = blocks;
   node->density = density;
-  node->largestBlock = vSize;
+  node->largestBlock = blocks;
 
   ::memset(data, 0, bsize * 2);
   node->baUsed = reinterpret_cast<size_t*>(data);
@@ -570,13 +1204,14 @@ static void vMemMgrInsertNode(VMemMgr* self, MemNode* node) noexcept {
   if (self->_first == nullptr) {
     self->_first = node;
     self->_last = node;
-    self->_optimal = node;
   }
   else {
     node->prev = self->_last;
     self->_last->next = node;
     self->_last = node;
   }
+
+  vMemMgrLinkBin(self, node);
 }
 
 //! \internal
@@ -653,9 +1288,13 @@ static MemNode* vMemMgrRemoveNode(VMemMgr* self, MemNode* node) noexcept {
   ASMJIT_ASSERT(f != &head);
   ASMJIT_ASSERT(q != &head);
 
+  // The removed `node` has been already unlinked from its bin by the caller,
+  // `q` is going to be freed instead, so `f` takes its place.
   if (f != q) {
     ASMJIT_ASSERT(f != &head);
+    vMemMgrUnlinkBin(self, static_cast<MemNode*>(q));
     static_cast<MemNode*>(f)->fillData(static_cast<MemNode*>(q));
+    vMemMgrLinkBin(self, static_cast<MemNode*>(f));
   }
 
   p->node[p->node[1] == q] = q->node[q->node[0] == nullptr];
@@ -679,9 +1318,6 @@ static MemNode* vMemMgrRemoveNode(VMemMgr* self, MemNode* node) noexcept {
   else
     self->_last  = prev;
 
-  if (self->_optimal == q)
-    self->_optimal = prev ? prev : next;
-
   return static_cast<MemNode*>(q);
 }
 
@@ -735,7 +1371,7 @@ static void* vMemMgrAllocPermanent(VMemMgr* self, size_t vSize) noexcept {
     if (node == nullptr)
       return nullptr;
 
-    node->mem = vMemMgrAllocVMem(self, nodeSize, &node->size);
+    node->mem = vMemMgrAllocVMem(self, nodeSize, &node->size, &node->memRw);
 
     // Out of memory.
     if (node->mem == nullptr) {
@@ -759,115 +1395,44 @@ static void* vMemMgrAllocPermanent(VMemMgr* self, size_t vSize) noexcept {
   return static_cast<void*>(result);
 }
 
+//! \internal
+//!
+//! Allocate freeable memory, the caller must hold `VMemMgr::_lock`.
 static void* vMemMgrAllocFreeable(VMemMgr* self, size_t vSize) noexcept {
-  // Current index.
-  size_t i;
-
-  // How many we need to be freed.
-  size_t need;
-  size_t minVSize;
-
   // Align to 32 bytes by default.
   vSize = Utils::alignTo<size_t>(vSize, 32);
   if (vSize == 0)
     return nullptr;
 
-  AutoLock locked(self->_lock);
-  MemNode* node = self->_optimal;
-  minVSize = self->_blockSize;
+  // All nodes share the same density.
+  size_t density = self->_blockDensity;
+  size_t need = (vSize + density - 1) / density;
+  size_t i;
 
   // Try to find memory block in existing nodes.
-  while (node) {
-    // Skip this node?
-    if ((node->getAvailable() < vSize) || (node->largestBlock < vSize && node->largestBlock != 0)) {
-      MemNode* next = node->next;
-
-      if (node->getAvailable() < minVSize && node == self->_optimal && next)
-        self->_optimal = next;
+  MemNode* node = vMemMgrFindNode(self, need, &i);
+  if (node == nullptr) {
+    // If we are here, we failed to find existing memory block and we must
+    // allocate a new one.
+    size_t blockSize = self->_blockSize;
+    if (blockSize < vSize)
+      blockSize = vSize;
 
-      node = next;
-      continue;
-    }
+    node = vMemMgrCreateNode(self, blockSize, density);
+    if (node == nullptr)
+      return nullptr;
 
-    size_t* up = node->baUsed;     // Current ubits address.
-    size_t ubits;                  // Current ubits[0] value.
-    size_t bit;                    // Current bit mask.
-    size_t blocks = node->blocks;  // Count of blocks in node.
-    size_t cont = 0;               // How many bits are currently freed in find loop.
-    size_t maxCont = 0;            // Largest continuous block (bits count).
-    size_t j;
+    // Update binary tree.
+    vMemMgrInsertNode(self, node);
+    ASMJIT_ASSERT(vMemMgrCheckTree(self));
 
-    need = M_DIV((vSize + node->density - 1), node->density);
+    // Alloc first node at start.
     i = 0;
 
-    // Try to find node that is large enough.
-    while (i < blocks) {
-      ubits = *up++;
-
-      // Fast skip used blocks.
-      if (ubits == ~(size_t)0) {
-        if (cont > maxCont)
-          maxCont = cont;
-        cont = 0;
-
-        i += kBitsPerEntity;
-        continue;
-      }
-
-      size_t max = kBitsPerEntity;
-      if (i + max > blocks)
-        max = blocks - i;
-
-      for (j = 0, bit = 1; j < max; bit <<= 1) {
-        j++;
-        if ((ubits & bit) == 0) {
-          if (++cont == need) {
-            i += j;
-            i -= cont;
-            goto L_Found;
-          }
-
-          continue;
-        }
-
-        if (cont > maxCont) maxCont = cont;
-        cont = 0;
-      }
-
-      i += kBitsPerEntity;
-    }
-
-    // Because we traversed the entire node, we can set largest node size that
-    // will be used to cache next traversing.
-    node->largestBlock = maxCont * node->density;
-
-    node = node->next;
-  }
-
-  // If we are here, we failed to find existing memory block and we must
-  // allocate a new one.
-  {
-    size_t blockSize = self->_blockSize;
-    if (blockSize < vSize)
-      blockSize = vSize;
-
-    node = vMemMgrCreateNode(self, blockSize, self->_blockDensity);
-    if (node == nullptr)
-      return nullptr;
-
-    // Update binary tree.
-    vMemMgrInsertNode(self, node);
-    ASMJIT_ASSERT(vMemMgrCheckTree(self));
-
-    // Alloc first node at start.
-    i = 0;
-    need = (vSize + node->density - 1) / node->density;
-
     // Update statistics.
     self->_allocatedBytes += node->size;
   }
 
-L_Found:
   // Update bits.
   _SetBits(node->baUsed, i, need);
   _SetBits(node->baCont, i, need - 1);
@@ -876,7 +1441,6 @@ L_Found:
   {
     size_t u = need * node->density;
     node->used += u;
-    node->largestBlock = 0;
     self->_usedBytes += u;
   }
 
@@ -886,6 +1450,57 @@ L_Found:
   return result;
 }
 
+//! \internal
+//!
+//! Release freeable memory, the caller must hold `VMemMgr::_lock`.
+static Error vMemMgrReleaseFreeable(VMemMgr* self, void* p) noexcept {
+  MemNode* node = vMemMgrFindNodeByPtr(self, static_cast<uint8_t*>(p));
+
+  if (node == nullptr)
+    return kErrorInvalidArgument;
+
+  size_t offset = (size_t)((uint8_t*)p - (uint8_t*)node->mem);
+  size_t bitpos = M_DIV(offset, node->density);
+
+  // The last block of the allocation is the first one that doesn't continue.
+  size_t end = _FindBit(node->baCont, bitpos, node->blocks, false) + 1;
+  size_t cont = end - bitpos;
+
+  _ClearBits(node->baUsed, bitpos, cont);
+  _ClearBits(node->baCont, bitpos, cont);
+
+  // Statistics.
+  cont *= node->density;
+  node->used -= cont;
+  self->_usedBytes -= cont;
+
+  // If page is empty, we can free it.
+  if (node->used == 0) {
+    // Free memory associated with node (this memory is not accessed
+    // anymore so it's safe).
+    vMemMgrReleaseVMem(self, node->mem, node->memRw, node->size);
+    ASMJIT_FREE(node->baUsed);
+
+    node->baUsed = nullptr;
+    node->baCont = nullptr;
+
+    // Statistics.
+    self->_allocatedBytes -= node->size;
+
+    // Remove node. This function can return different node than
+    // passed into, but data is copied into previous node if needed.
+    vMemMgrUnlinkBin(self, node);
+    self->_rover = nullptr;
+    ASMJIT_FREE(vMemMgrRemoveNode(self, node));
+    ASMJIT_ASSERT(vMemMgrCheckTree(self));
+  }
+  else {
+    vMemMgrUpdateBinFreed(self, node, bitpos, end);
+  }
+
+  return kErrorOk;
+}
+
 //! \internal
 //!
 //! Reset the whole `VMemMgr` instance, freeing all heap memory allocated an
@@ -898,7 +1513,7 @@ static void vMemMgrReset(VMemMgr* self, bool keepVirtualMemory) noexcept {
     MemNode* next = node->next;
 
     if (!keepVirtualMemory)
-      vMemMgrReleaseVMem(self, node->mem, node->size);
+      vMemMgrReleaseVMem(self, node->mem, node->memRw, node->size);
 
     ASMJIT_FREE(node->baUsed);
     ASMJIT_FREE(node);
@@ -912,7 +1527,370 @@ static void vMemMgrReset(VMemMgr* self, bool keepVirtualMemory) noexcept {
   self->_root = nullptr;
   self->_first = nullptr;
   self->_last = nullptr;
-  self->_optimal = nullptr;
+
+  ::memset(self->_bins, 0, sizeof(self->_bins));
+  ::memset(self->_binMask, 0, sizeof(self->_binMask));
+  self->_rover = nullptr;
+}
+
+// ============================================================================
+// [asmjit::VMemMgr - ThreadCache]
+// ============================================================================
+
+// Thread caches sit on top of the shared pool and keep small freeable chunks
+// grouped by size-class. Threads are hashed into `kCacheSlotCount` slots, each
+// having its own lock, so concurrent `alloc()` and `release()` calls don't
+// serialize on `VMemMgr::_lock`. Chunks are moved between slots and the shared
+// pool in batches of `kCacheBatch`, which is the only time the shared lock is
+// taken.
+//
+// Every chunk owned by thread caches (used or cached) is recorded in a chunk
+// registry, which is sharded by the chunk address into the same slots. This
+// allows `release()` to find the size-class of a chunk without consulting the
+// `MemNode` bit arrays, which are protected by the shared lock.
+
+//! \internal
+enum {
+  kCacheSlotCount = 32,  // Count of cache slots.
+  kCacheClassCount = kVMemCacheMaxSize / kVMemCacheGranularity,
+  kCacheBatch = 16,      // Count of chunks moved from/to the shared pool at once.
+  kCacheDepth = 64,      // Maximum count of cached chunks per size-class.
+  kCacheCapacity = kCacheDepth + kCacheBatch
+};
+
+//! \internal
+//!
+//! Stack of cached chunks of the same size-class.
+struct VMemCacheStack {
+  void** data;           // Cached chunks (allocated on first use).
+  size_t length;         // Count of cached chunks.
+};
+
+//! \internal
+//!
+//! Cache slot.
+struct VMemMgr::CacheSlot {
+  Lock lock;                                // Slot lock.
+  VMemCacheStack stack[kCacheClassCount];   // Cached chunks per size-class.
+
+  uintptr_t* regKeys;                       // Registry - chunk addresses (0 = unused).
+  uint8_t* regClass;                        // Registry - chunk size-classes.
+  size_t regCapacity;                       // Registry - capacity (power of 2).
+  size_t regLength;                         // Registry - count of chunks.
+};
+
+typedef VMemMgr::CacheSlot CacheSlot;
+
+//! \internal
+//!
+//! Get slot index of the calling thread.
+static ASMJIT_INLINE uint32_t vMemCacheThreadSlot() noexcept {
+#if ASMJIT_OS_WINDOWS
+  uint64_t h = static_cast<uint64_t>(::GetCurrentThreadId());
+#else
+  uint64_t h = static_cast<uint64_t>((uintptr_t)::pthread_self());
+#endif // ASMJIT_OS_WINDOWS
+
+  h ^= h >> 33;
+  h *= ASMJIT_UINT64_C(0xFF51AFD7ED558CCD);
+  h ^= h >> 33;
+  return static_cast<uint32_t>(h % kCacheSlotCount);
+}
+
+//! \internal
+//!
+//! Get slot index of the registry shard that records chunk `p`.
+static ASMJIT_INLINE uint32_t vMemCacheRegSlot(uintptr_t p) noexcept {
+  return static_cast<uint32_t>((p / kVMemCacheGranularity) % kCacheSlotCount);
+}
+
+//! \internal
+static ASMJIT_INLINE size_t vMemCacheRegHash(const CacheSlot* slot, uintptr_t p) noexcept {
+  return (p / (kVMemCacheGranularity * kCacheSlotCount)) & (slot->regCapacity - 1);
+}
+
+//! \internal
+//!
+//! Find chunk `p` in `slot` registry, returns its index or `kInvalidIndex`.
+static size_t vMemCacheRegFind(const CacheSlot* slot, uintptr_t p) noexcept {
+  if (slot->regLength == 0)
+    return kInvalidIndex;
+
+  size_t mask = slot->regCapacity - 1;
+  size_t i = vMemCacheRegHash(slot, p);
+
+  for (;;) {
+    uintptr_t key = slot->regKeys[i];
+    if (key == p)
+      return i;
+    if (key == 0)
+      return kInvalidIndex;
+    i = (i + 1) & mask;
+  }
+}
+
+//! \internal
+static void vMemCacheRegPut(CacheSlot* slot, uintptr_t p, uint32_t cls) noexcept {
+  size_t mask = slot->regCapacity - 1;
+  size_t i = vMemCacheRegHash(slot, p);
+
+  while (slot->regKeys[i] != 0)
+    i = (i + 1) & mask;
+
+  slot->regKeys[i] = p;
+  slot->regClass[i] = static_cast<uint8_t>(cls);
+  slot->regLength++;
+}
+
+//! \internal
+//!
+//! Add chunk `p` of size-class `cls` to `slot` registry.
+static bool vMemCacheRegAdd(CacheSlot* slot, uintptr_t p, uint32_t cls) noexcept {
+  // Keep the load factor below 50%.
+  if ((slot->regLength + 1) * 2 > slot->regCapacity) {
+    size_t oldCapacity = slot->regCapacity;
+    size_t newCapacity = oldCapacity ? oldCapacity * 2 : 256;
+
+    uint8_t* data = static_cast<uint8_t*>(
+      ASMJIT_ALLOC(newCapacity * (sizeof(uintptr_t) + sizeof(uint8_t))));
+    if (data == nullptr)
+      return false;
+
+    uintptr_t* oldKeys = slot->regKeys;
+    uint8_t* oldClass = slot->regClass;
+
+    ::memset(data, 0, newCapacity * sizeof(uintptr_t));
+    slot->regKeys = reinterpret_cast<uintptr_t*>(data);
+    slot->regClass = data + newCapacity * sizeof(uintptr_t);
+    slot->regCapacity = newCapacity;
+    slot->regLength = 0;
+
+    for (size_t i = 0; i < oldCapacity; i++)
+      if (oldKeys[i] != 0)
+        vMemCacheRegPut(slot, oldKeys[i], oldClass[i]);
+
+    if (oldKeys != nullptr)
+      ASMJIT_FREE(oldKeys);
+  }
+
+  vMemCacheRegPut(slot, p, cls);
+  return true;
+}
+
+//! \internal
+//!
+//! Remove registry entry at `index`, entries that follow are shifted back so
+//! no tombstones are necessary.
+static void vMemCacheRegRemove(CacheSlot* slot, size_t index) noexcept {
+  size_t mask = slot->regCapacity - 1;
+  size_t i = index;
+  size_t j = index;
+
+  for (;;) {
+    j = (j + 1) & mask;
+
+    uintptr_t key = slot->regKeys[j];
+    if (key == 0)
+      break;
+
+    // Move the entry at `j` to `i` if its home position isn't in (i, j].
+    size_t home = vMemCacheRegHash(slot, key);
+    if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+      continue;
+
+    slot->regKeys[i] = key;
+    slot->regClass[i] = slot->regClass[j];
+    i = j;
+  }
+
+  slot->regKeys[i] = 0;
+  slot->regLength--;
+}
+
+//! \internal
+//!
+//! Unregister `count` chunks and return them to the shared pool.
+static void vMemCacheReturn(VMemMgr* self, void** chunks, size_t count) noexcept {
+  CacheSlot* slots = self->_cacheSlots;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    uintptr_t p = (uintptr_t)chunks[i];
+    CacheSlot* slot = &slots[vMemCacheRegSlot(p)];
+
+    AutoLock locked(slot->lock);
+    size_t index = vMemCacheRegFind(slot, p);
+
+    ASMJIT_ASSERT(index != kInvalidIndex);
+    vMemCacheRegRemove(slot, index);
+  }
+
+  AutoLock locked(self->_lock);
+  for (i = 0; i < count; i++)
+    vMemMgrReleaseFreeable(self, chunks[i]);
+}
+
+//! \internal
+//!
+//! Push `count` chunks of size-class `cls` to the thread cache of the caller.
+//! If the cache becomes too deep a batch of chunks is returned to the shared
+//! pool.
+static void vMemCachePush(VMemMgr* self, uint32_t cls, void** chunks, size_t count) noexcept {
+  CacheSlot* slot = &self->_cacheSlots[vMemCacheThreadSlot()];
+  void* overflow[kCacheCapacity];
+  size_t overflowCount = 0;
+
+  {
+    AutoLock locked(slot->lock);
+    VMemCacheStack& stack = slot->stack[cls];
+
+    if (stack.data == nullptr)
+      stack.data = static_cast<void**>(ASMJIT_ALLOC(kCacheCapacity * sizeof(void*)));
+
+    if (stack.data != nullptr) {
+      ASMJIT_ASSERT(stack.length + count <= kCacheCapacity);
+      ::memcpy(stack.data + stack.length, chunks, count * sizeof(void*));
+      stack.length += count;
+
+      if (stack.length > kCacheDepth) {
+        overflowCount = stack.length - kCacheDepth + kCacheBatch / 2;
+        stack.length -= overflowCount;
+        ::memcpy(overflow, stack.data + stack.length, overflowCount * sizeof(void*));
+      }
+    }
+    else {
+      ::memcpy(overflow, chunks, count * sizeof(void*));
+      overflowCount = count;
+    }
+  }
+
+  if (overflowCount)
+    vMemCacheReturn(self, overflow, overflowCount);
+}
+
+//! \internal
+static void* vMemCacheAlloc(VMemMgr* self, size_t vSize) noexcept {
+  uint32_t cls = static_cast<uint32_t>((vSize - 1) / kVMemCacheGranularity);
+  CacheSlot* slots = self->_cacheSlots;
+
+  // Fast case - take a chunk from the thread cache.
+  {
+    CacheSlot* slot = &slots[vMemCacheThreadSlot()];
+    AutoLock locked(slot->lock);
+
+    VMemCacheStack& stack = slot->stack[cls];
+    if (stack.length != 0)
+      return stack.data[--stack.length];
+  }
+
+  // Slow case - refill the thread cache from the shared pool.
+  void* chunks[kCacheBatch];
+  size_t chunkSize = static_cast<size_t>(cls + 1) * kVMemCacheGranularity;
+  size_t count = 0;
+  size_t i;
+
+  {
+    AutoLock locked(self->_lock);
+    while (count < kCacheBatch) {
+      void* p = vMemMgrAllocFreeable(self, chunkSize);
+      if (p == nullptr)
+        break;
+      chunks[count++] = p;
+    }
+  }
+
+  // Register all chunks, chunks that can't be registered go back to the pool.
+  size_t registered = 0;
+  for (i = 0; i < count; i++) {
+    uintptr_t p = (uintptr_t)chunks[i];
+    CacheSlot* slot = &slots[vMemCacheRegSlot(p)];
+
+    bool ok;
+    {
+      AutoLock locked(slot->lock);
+      ok = vMemCacheRegAdd(slot, p, cls);
+    }
+
+    if (ok) {
+      chunks[registered++] = chunks[i];
+    }
+    else {
+      AutoLock locked(self->_lock);
+      vMemMgrReleaseFreeable(self, chunks[i]);
+    }
+  }
+
+  if (registered == 0)
+    return nullptr;
+
+  if (registered > 1)
+    vMemCachePush(self, cls, chunks + 1, registered - 1);
+  return chunks[0];
+}
+
+//! \internal
+//!
+//! Get size-class of chunk `p` or `kInvalidValue` if it's not owned by caches.
+static uint32_t vMemCacheGetClass(VMemMgr* self, void* p) noexcept {
+  CacheSlot* slot = &self->_cacheSlots[vMemCacheRegSlot((uintptr_t)p)];
+  AutoLock locked(slot->lock);
+
+  size_t index = vMemCacheRegFind(slot, (uintptr_t)p);
+  if (index == kInvalidIndex)
+    return kInvalidValue;
+  return slot->regClass[index];
+}
+
+//! \internal
+//!
+//! Reset all thread caches, chunks aren't returned to the shared pool.
+static void vMemCacheReset(VMemMgr* self) noexcept {
+  CacheSlot* slots = self->_cacheSlots;
+
+  for (uint32_t i = 0; i < kCacheSlotCount; i++) {
+    CacheSlot* slot = &slots[i];
+
+    for (uint32_t cls = 0; cls < kCacheClassCount; cls++)
+      slot->stack[cls].length = 0;
+
+    if (slot->regCapacity != 0)
+      ::memset(slot->regKeys, 0, slot->regCapacity * sizeof(uintptr_t));
+    slot->regLength = 0;
+  }
+}
+
+//! \internal
+//!
+//! Destroy all thread caches, cached chunks are returned to the shared pool.
+static void vMemCacheDestroy(VMemMgr* self, bool returnChunks) noexcept {
+  CacheSlot* slots = self->_cacheSlots;
+  if (slots == nullptr)
+    return;
+
+  for (uint32_t i = 0; i < kCacheSlotCount; i++) {
+    CacheSlot* slot = &slots[i];
+
+    for (uint32_t cls = 0; cls < kCacheClassCount; cls++) {
+      VMemCacheStack& stack = slot->stack[cls];
+      if (stack.data == nullptr)
+        continue;
+
+      if (returnChunks) {
+        AutoLock locked(self->_lock);
+        for (size_t j = 0; j < stack.length; j++)
+          vMemMgrReleaseFreeable(self, stack.data[j]);
+      }
+
+      ASMJIT_FREE(stack.data);
+    }
+
+    if (slot->regKeys != nullptr)
+      ASMJIT_FREE(slot->regKeys);
+    slot->~CacheSlot();
+  }
+
+  ASMJIT_FREE(slots);
+  self->_cacheSlots = nullptr;
 }
 
 // ============================================================================
@@ -935,13 +1913,22 @@ VMemMgr::VMemMgr(HANDLE hProcess) noexcept
   _root = nullptr;
   _first = nullptr;
   _last = nullptr;
-  _optimal = nullptr;
+
+  ::memset(_bins, 0, sizeof(_bins));
+  ::memset(_binMask, 0, sizeof(_binMask));
+  _rover = nullptr;
 
   _permanent = nullptr;
+  _cacheSlots = nullptr;
   _keepVirtualMemory = false;
+  _dualMapping = false;
+  _hugePages = false;
 }
 
 VMemMgr::~VMemMgr() noexcept {
+  // Thread caches cleanup - Cached chunks are freed together with the pool.
+  vMemCacheDestroy(this, false);
+
   // Freeable memory cleanup - Also frees the virtual memory if configured to.
   vMemMgrReset(this, _keepVirtualMemory);
 
@@ -959,107 +1946,179 @@ VMemMgr::~VMemMgr() noexcept {
 // ============================================================================
 
 void VMemMgr::reset() noexcept {
+  if (_cacheSlots != nullptr)
+    vMemCacheReset(this);
   vMemMgrReset(this, false);
 }
 
 // ============================================================================
-// [asmjit::VMemMgr - Alloc / Release]
+// [asmjit::VMemMgr - DualMapping]
 // ============================================================================
 
-void* VMemMgr::alloc(size_t size, uint32_t type) noexcept {
-  if (type == kVMemAllocPermanent)
-    return vMemMgrAllocPermanent(this, size);
-  else
-    return vMemMgrAllocFreeable(this, size);
+Error VMemMgr::setDualMappingEnabled(bool enabled) noexcept {
+  if (enabled == _dualMapping)
+    return kErrorOk;
+
+  if (_first != nullptr || _permanent != nullptr)
+    return kErrorInvalidState;
+
+#if ASMJIT_OS_WINDOWS
+  return kErrorNotSupported;
+#else
+  _dualMapping = enabled;
+  return kErrorOk;
+#endif // ASMJIT_OS_WINDOWS
 }
 
-Error VMemMgr::release(void* p) noexcept {
-  if (p == nullptr)
-    return kErrorOk;
+void* VMemMgr::getWritablePtr(void* p) noexcept {
+  if (!_dualMapping || p == nullptr)
+    return p;
 
+  uint8_t* mem = static_cast<uint8_t*>(p);
   AutoLock locked(_lock);
-  MemNode* node = vMemMgrFindNodeByPtr(this, static_cast<uint8_t*>(p));
 
-  if (node == nullptr)
-    return kErrorInvalidArgument;
+  MemNode* node = vMemMgrFindNodeByPtr(this, mem);
+  if (node != nullptr)
+    return node->memRw + (size_t)(mem - node->mem);
 
-  size_t offset = (size_t)((uint8_t*)p - (uint8_t*)node->mem);
-  size_t bitpos = M_DIV(offset, node->density);
-  size_t i = (bitpos / kBitsPerEntity);
+  for (PermanentNode* pNode = _permanent; pNode != nullptr; pNode = pNode->prev) {
+    if (mem >= pNode->mem && mem < pNode->mem + pNode->size)
+      return pNode->memRw + (size_t)(mem - pNode->mem);
+  }
 
-  size_t* up = node->baUsed + i;  // Current ubits address.
-  size_t* cp = node->baCont + i;  // Current cbits address.
-  size_t ubits = *up;             // Current ubits[0] value.
-  size_t cbits = *cp;             // Current cbits[0] value.
-  size_t bit = (size_t)1 << (bitpos % kBitsPerEntity);
+  return nullptr;
+}
 
-  size_t cont = 0;
-  bool stop;
+// ============================================================================
+// [asmjit::VMemMgr - HugePages]
+// ============================================================================
 
-  for (;;) {
-    stop = (cbits & bit) == 0;
-    ubits &= ~bit;
-    cbits &= ~bit;
+Error VMemMgr::setHugePagesEnabled(bool enabled) noexcept {
+  size_t hugePageSize = VMemUtil::getHugePageSize();
+  if (enabled && hugePageSize == 0)
+    return kErrorNotSupported;
 
-    bit <<= 1;
-    cont++;
+  AutoLock locked(_lock);
 
-    if (stop || bit == 0) {
-      *up = ubits;
-      *cp = cbits;
-      if (stop)
-        break;
+  // New nodes span a whole huge page, the existing nodes are kept as is.
+  _hugePages = enabled;
+  _blockSize = enabled ? hugePageSize : VMemUtil::getPageGranularity();
+  return kErrorOk;
+}
 
-      ubits = *++up;
-      cbits = *++cp;
-      bit = 1;
-    }
+// ============================================================================
+// [asmjit::VMemMgr - ThreadCache]
+// ============================================================================
+
+Error VMemMgr::setThreadCacheEnabled(bool enabled) noexcept {
+  if (enabled == isThreadCacheEnabled())
+    return kErrorOk;
+
+  if (!enabled) {
+    vMemCacheDestroy(this, true);
+    return kErrorOk;
   }
 
-  // If the freed block is fully allocated node then it's needed to
-  // update 'optimal' pointer in memory manager.
-  if (node->used == node->size) {
-    MemNode* cur = _optimal;
+  // Thread caches use size-classes that match the block density, otherwise
+  // the shared pool would round every chunk up.
+  ASMJIT_ASSERT(_blockDensity == kVMemCacheGranularity);
 
-    do {
-      cur = cur->prev;
-      if (cur == node) {
-        _optimal = node;
-        break;
-      }
-    } while (cur);
+  CacheSlot* slots = static_cast<CacheSlot*>(ASMJIT_ALLOC(kCacheSlotCount * sizeof(CacheSlot)));
+  if (slots == nullptr)
+    return kErrorNoHeapMemory;
+
+  for (uint32_t i = 0; i < kCacheSlotCount; i++) {
+    CacheSlot* slot = new(&slots[i]) CacheSlot();
+    ::memset(slot->stack, 0, sizeof(slot->stack));
+
+    slot->regKeys = nullptr;
+    slot->regClass = nullptr;
+    slot->regCapacity = 0;
+    slot->regLength = 0;
   }
 
-  // Statistics.
-  cont *= node->density;
-  if (node->largestBlock < cont)
-    node->largestBlock = cont;
+  _cacheSlots = slots;
+  return kErrorOk;
+}
 
-  node->used -= cont;
-  _usedBytes -= cont;
+// ============================================================================
+// [asmjit::VMemMgr - Alloc / Release]
+// ============================================================================
 
-  // If page is empty, we can free it.
-  if (node->used == 0) {
-    // Free memory associated with node (this memory is not accessed
-    // anymore so it's safe).
-    vMemMgrReleaseVMem(this, node->mem, node->size);
-    ASMJIT_FREE(node->baUsed);
+void* VMemMgr::alloc(size_t size, uint32_t type) noexcept {
+  if (type == kVMemAllocPermanent)
+    return vMemMgrAllocPermanent(this, size);
 
-    node->baUsed = nullptr;
-    node->baCont = nullptr;
+  if (_cacheSlots != nullptr && size - 1 < kVMemCacheMaxSize)
+    return vMemCacheAlloc(this, size);
 
-    // Statistics.
-    _allocatedBytes -= node->size;
+  AutoLock locked(_lock);
+  return vMemMgrAllocFreeable(this, size);
+}
 
-    // Remove node. This function can return different node than
-    // passed into, but data is copied into previous node if needed.
-    ASMJIT_FREE(vMemMgrRemoveNode(this, node));
-    ASMJIT_ASSERT(vMemMgrCheckTree(this));
+Error VMemMgr::allocBatch(void** dst, const size_t* sizes, size_t count, uint32_t type) noexcept {
+  size_t density = _blockDensity;
+  size_t total = 0;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    dst[i] = nullptr;
+    if (sizes[i] == 0)
+      return kErrorInvalidArgument;
+    total += Utils::alignTo<size_t>(sizes[i], density);
+  }
+
+  if (count == 0)
+    return kErrorOk;
+
+  uint8_t* p;
+  if (type == kVMemAllocPermanent) {
+    p = static_cast<uint8_t*>(vMemMgrAllocPermanent(this, total));
+  }
+  else {
+    AutoLock locked(_lock);
+    p = static_cast<uint8_t*>(vMemMgrAllocFreeable(this, total));
+
+    // Split the run into separate allocations by terminating the continuous
+    // bits at the last block of each chunk.
+    if (p != nullptr) {
+      MemNode* node = vMemMgrFindNodeByPtr(this, p);
+      size_t index = (size_t)(p - node->mem) / density;
+
+      for (i = 0; i < count - 1; i++) {
+        index += Utils::alignTo<size_t>(sizes[i], density) / density;
+        _ClearBits(node->baCont, index - 1, 1);
+      }
+    }
+  }
+
+  if (p == nullptr)
+    return kErrorNoVirtualMemory;
+
+  for (i = 0; i < count; i++) {
+    dst[i] = p;
+    p += Utils::alignTo<size_t>(sizes[i], density);
   }
 
   return kErrorOk;
 }
 
+Error VMemMgr::release(void* p) noexcept {
+  if (p == nullptr)
+    return kErrorOk;
+
+  if (_cacheSlots != nullptr) {
+    uint32_t cls = vMemCacheGetClass(this, p);
+    if (cls != kInvalidValue) {
+      vMemCachePush(this, cls, &p, 1);
+      return kErrorOk;
+    }
+  }
+
+  AutoLock locked(_lock);
+  return vMemMgrReleaseFreeable(this, p);
+}
+
 Error VMemMgr::shrink(void* p, size_t used) noexcept {
   if (p == nullptr)
     return kErrorOk;
@@ -1067,6 +2126,10 @@ Error VMemMgr::shrink(void* p, size_t used) noexcept {
   if (used == 0)
     return release(p);
 
+  // Chunks owned by thread caches always keep the size of their size-class.
+  if (_cacheSlots != nullptr && vMemCacheGetClass(this, p) != kInvalidValue)
+    return kErrorOk;
+
   AutoLock locked(_lock);
 
   MemNode* node = vMemMgrFindNodeByPtr(this, (uint8_t*)p);
@@ -1075,69 +2138,216 @@ Error VMemMgr::shrink(void* p, size_t used) noexcept {
 
   size_t offset = (size_t)((uint8_t*)p - (uint8_t*)node->mem);
   size_t bitpos = M_DIV(offset, node->density);
-  size_t i = (bitpos / kBitsPerEntity);
-
-  size_t* up = node->baUsed + i;  // Current ubits address.
-  size_t* cp = node->baCont + i;  // Current cbits address.
-  size_t ubits = *up;             // Current ubits[0] value.
-  size_t cbits = *cp;             // Current cbits[0] value.
-  size_t bit = (size_t)1 << (bitpos % kBitsPerEntity);
 
-  size_t cont = 0;
+  size_t end = _FindBit(node->baCont, bitpos, node->blocks, false) + 1;
   size_t usedBlocks = (used + node->density - 1) / node->density;
 
-  bool stop;
+  // Nothing to free.
+  if (end - bitpos <= usedBlocks)
+    return kErrorOk;
 
-  // Find the first block we can mark as free.
-  for (;;) {
-    stop = (cbits & bit) == 0;
-    if (stop)
-      return kErrorOk;
+  // Free the tail blocks, the last used block doesn't continue anymore.
+  size_t tail = bitpos + usedBlocks;
+  size_t cont = end - tail;
 
-    if (++cont == usedBlocks)
-      break;
+  _ClearBits(node->baUsed, tail, cont);
+  _ClearBits(node->baCont, tail - 1, cont);
+
+  // Statistics.
+  cont *= node->density;
+  node->used -= cont;
+  _usedBytes -= cont;
+
+  vMemMgrUpdateBinFreed(this, node, tail, end);
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::VMemMgr - Compact]
+// ============================================================================
+
+//! \internal
+//!
+//! Node considered for evacuation by `VMemMgr::compact()`.
+//!
+//! Nodes are identified by their memory as `vMemMgrRemoveNode()` can move
+//! `MemNode` data into a different instance.
+struct VMemCompactNode {
+  //! Memory of the node.
+  uint8_t* mem;
+  //! Used bytes of the node.
+  size_t used;
+  //! First chunk of the node (index to sorted chunks).
+  size_t start;
+  //! Last chunk of the node (exclusive).
+  size_t end;
+};
+
+static int ASMJIT_CDECL vMemCompactCompareChunks(const void* a, const void* b) noexcept {
+  uintptr_t pa = (uintptr_t)(*static_cast<VMemChunk* const*>(a))->ptr;
+  uintptr_t pb = (uintptr_t)(*static_cast<VMemChunk* const*>(b))->ptr;
+  return pa < pb ? -1 : (pa > pb ? 1 : 0);
+}
+
+static int ASMJIT_CDECL vMemCompactCompareNodes(const void* a, const void* b) noexcept {
+  size_t ua = static_cast<const VMemCompactNode*>(a)->used;
+  size_t ub = static_cast<const VMemCompactNode*>(b)->used;
+  return ua < ub ? -1 : (ua > ub ? 1 : 0);
+}
+
+//! \internal
+//!
+//! Get the count of blocks of an allocation that starts at `p`.
+static ASMJIT_INLINE size_t vMemMgrGetChunkBlocks(MemNode* node, void* p) noexcept {
+  size_t bitpos = (size_t)(static_cast<uint8_t*>(p) - node->mem) / node->density;
+  return _FindBit(node->baCont, bitpos, node->blocks, false) + 1 - bitpos;
+}
+
+//! \internal
+//!
+//! Move a single `chunk` out of its node, the caller must hold `_lock`.
+//!
+//! Returns `false` if there is no space in other nodes or the chunk couldn't
+//! be moved by `handler`.
+static bool vMemMgrMoveChunk(VMemMgr* self, VMemChunk* chunk, VMemMoveHandler handler) noexcept {
+  uint8_t* src = static_cast<uint8_t*>(chunk->ptr);
+  MemNode* srcNode = vMemMgrFindNodeByPtr(self, src);
+
+  size_t blocks = vMemMgrGetChunkBlocks(srcNode, src);
+  size_t size = blocks * srcNode->density;
+
+  // Evacuated nodes are hidden, so this never picks the source node and a
+  // successful lookup guarantees that no memory is mapped by the allocation.
+  size_t index;
+  if (vMemMgrFindNode(self, blocks, &index) == nullptr)
+    return false;
+
+  uint8_t* dst = static_cast<uint8_t*>(vMemMgrAllocFreeable(self, size));
+  MemNode* dstNode = vMemMgrFindNodeByPtr(self, dst);
+  uint8_t* dstRw = dstNode->memRw + (size_t)(dst - dstNode->mem);
+
+  ::memcpy(dstRw, srcNode->memRw + (size_t)(src - srcNode->mem), size);
+  if (handler != nullptr && !handler(dst, dstRw, src, size, chunk->data)) {
+    vMemMgrReleaseFreeable(self, dst);
+    return false;
+  }
+
+  chunk->ptr = dst;
+  vMemMgrReleaseFreeable(self, src);
 
-    bit <<= 1;
-    if (bit == 0) {
-      ubits = *++up;
-      cbits = *++cp;
-      bit = 1;
+  // Releasing made the node visible to the allocator again, hide it.
+  srcNode = vMemMgrFindNodeByPtr(self, src);
+  if (srcNode != nullptr)
+    vMemMgrUpdateBin(self, srcNode, 0);
+  return true;
+}
+
+Error VMemMgr::compact(VMemChunk* chunks, size_t count, VMemMoveHandler handler) noexcept {
+  if (_cacheSlots != nullptr)
+    return kErrorInvalidState;
+
+  if (count == 0)
+    return kErrorOk;
+
+  VMemChunk** sorted = static_cast<VMemChunk**>(ASMJIT_ALLOC(count * sizeof(VMemChunk*)));
+  VMemCompactNode* nodes = static_cast<VMemCompactNode*>(ASMJIT_ALLOC(count * sizeof(VMemCompactNode)));
+
+  if (sorted == nullptr || nodes == nullptr) {
+    if (sorted) ASMJIT_FREE(sorted);
+    if (nodes) ASMJIT_FREE(nodes);
+    return kErrorNoHeapMemory;
+  }
+
+  size_t i;
+  size_t n;
+  size_t nodeCount = 0;
+
+  // Sort chunks by address, so chunks of the same node are adjacent.
+  for (i = 0; i < count; i++)
+    sorted[i] = &chunks[i];
+  ::qsort(sorted, count, sizeof(VMemChunk*), vMemCompactCompareChunks);
+
+  AutoLock locked(_lock);
+
+  // Only nodes where all used memory can be moved are candidates.
+  i = 0;
+  while (i < count) {
+    MemNode* node = vMemMgrFindNodeByPtr(this, static_cast<uint8_t*>(sorted[i]->ptr));
+
+    // Permanent memory or not allocated by `VMemMgr`.
+    if (node == nullptr) {
+      i++;
+      continue;
+    }
+
+    uint8_t* nodeEnd = node->mem + node->size;
+    size_t start = i;
+    size_t movable = 0;
+
+    do {
+      movable += vMemMgrGetChunkBlocks(node, sorted[i]->ptr) * node->density;
+      i++;
+    } while (i < count && static_cast<uint8_t*>(sorted[i]->ptr) < nodeEnd);
+
+    if (movable == node->used) {
+      VMemCompactNode& cn = nodes[nodeCount++];
+      cn.mem = node->mem;
+      cn.used = node->used;
+      cn.start = start;
+      cn.end = i;
     }
   }
 
-  // Free the tail blocks.
-  cont = ~(size_t)0;
-  goto _EnterFreeLoop;
+  // Select the least used nodes as long as their content fits into the free
+  // space of the remaining nodes and hide them from the allocator.
+  ::qsort(nodes, nodeCount, sizeof(VMemCompactNode), vMemCompactCompareNodes);
 
-  for (;;) {
-    stop = (cbits & bit) == 0;
-    ubits &= ~bit;
+  size_t freeBytes = 0;
+  size_t moveBytes = 0;
 
-_EnterFreeLoop:
-    cbits &= ~bit;
+  // `_usedBytes` includes permanent memory, so sum free bytes of all nodes.
+  for (MemNode* node = _first; node != nullptr; node = node->next)
+    freeBytes += node->size - node->used;
 
-    bit <<= 1;
-    cont++;
+  size_t selected = 0;
 
-    if (stop || bit == 0) {
-      *up = ubits;
-      *cp = cbits;
-      if (stop)
-        break;
+  while (selected < nodeCount) {
+    MemNode* node = vMemMgrFindNodeByPtr(this, nodes[selected].mem);
+    size_t nodeFree = node->size - node->used;
+
+    if (moveBytes + node->used > freeBytes - nodeFree)
+      break;
 
-      ubits = *++up;
-      cbits = *++cp;
-      bit = 1;
+    freeBytes -= nodeFree;
+    moveBytes += node->used;
+
+    vMemMgrUpdateBin(this, node, 0);
+    selected++;
+  }
+
+  // Evacuate. Fragmentation of the remaining nodes can prevent moving all the
+  // content, compaction stops at the first chunk that doesn't fit.
+  bool exhausted = false;
+  for (n = 0; n < selected && !exhausted; n++) {
+    const VMemCompactNode& cn = nodes[n];
+
+    for (i = cn.start; i < cn.end; i++) {
+      if (!vMemMgrMoveChunk(this, sorted[i], handler)) {
+        exhausted = true;
+        break;
+      }
     }
   }
 
-  // Statistics.
-  cont *= node->density;
-  if (node->largestBlock < cont)
-    node->largestBlock = cont;
+  // Make nodes that have not been emptied visible to the allocator again.
+  for (n = 0; n < selected; n++) {
+    MemNode* node = vMemMgrFindNodeByPtr(this, nodes[n].mem);
+    if (node != nullptr)
+      vMemMgrUpdateBin(this, node, _LongestRun(node->baUsed, node->blocks));
+  }
 
-  node->used -= cont;
-  _usedBytes -= cont;
+  ASMJIT_FREE(sorted);
+  ASMJIT_FREE(nodes);
 
   return kErrorOk;
 }
@@ -1277,6 +2487,247 @@ UNIT(base_vmem) {
   ASMJIT_FREE(a);
   ASMJIT_FREE(b);
 }
+
+UNIT(base_vmem_batch) {
+  VMemMgr memmgr;
+
+  size_t sizes[64];
+  void* a[64];
+  uint32_t i;
+
+  for (i = 0; i < ASMJIT_ARRAY_SIZE(sizes); i++)
+    sizes[i] = (rand() % 500) + 4;
+
+  INFO("Batch alloc/free test - %u allocations.", static_cast<unsigned int>(ASMJIT_ARRAY_SIZE(sizes)));
+  EXPECT(memmgr.allocBatch(a, sizes, ASMJIT_ARRAY_SIZE(sizes)) == kErrorOk,
+    "Couldn't allocate a batch of virtual memory.");
+
+  for (i = 1; i < ASMJIT_ARRAY_SIZE(sizes); i++) {
+    size_t expected = Utils::alignTo<size_t>(sizes[i - 1], 64);
+    EXPECT(static_cast<uint8_t*>(a[i]) == static_cast<uint8_t*>(a[i - 1]) + expected,
+      "Chunk #%u should follow the previous one.", i);
+  }
+  VMemTest_stats(memmgr);
+
+  // Release every other chunk first, then the rest.
+  for (i = 0; i < ASMJIT_ARRAY_SIZE(sizes); i += 2)
+    EXPECT(memmgr.release(a[i]) == kErrorOk,
+      "Failed to free %p.", a[i]);
+
+  for (i = 1; i < ASMJIT_ARRAY_SIZE(sizes); i += 2) {
+    ::memset(a[i], 0, sizes[i]);
+    EXPECT(memmgr.release(a[i]) == kErrorOk,
+      "Failed to free %p.", a[i]);
+  }
+  VMemTest_stats(memmgr);
+
+  EXPECT(memmgr.getUsedBytes() == 0,
+    "All chunks of the batch should be released.");
+}
+
+static bool ASMJIT_CDECL VMemTest_move(void* dst, void* dstRw, void* src, size_t size, void* data) noexcept {
+  ASMJIT_UNUSED(dst);
+
+  // Verify the copy and count moved chunks.
+  if (::memcmp(dstRw, src, size) == 0)
+    (*static_cast<uint32_t*>(data))++;
+  return true;
+}
+
+UNIT(base_vmem_compact) {
+  VMemMgr memmgr;
+
+  void* a[2000];
+  VMemChunk chunks[ASMJIT_ARRAY_SIZE(a)];
+
+  uint32_t moved = 0;
+  uint32_t count = 0;
+  uint32_t i;
+
+  INFO("Compaction test - %u allocations.", static_cast<unsigned int>(ASMJIT_ARRAY_SIZE(a)));
+  for (i = 0; i < ASMJIT_ARRAY_SIZE(a); i++) {
+    int r = (rand() % 500) + 64;
+
+    a[i] = memmgr.alloc(r);
+    EXPECT(a[i] != nullptr,
+      "Couldn't allocate %d bytes of virtual memory.", r);
+    ::memset(a[i], static_cast<int>(i & 0xFF), 64);
+  }
+
+  // Keep only every 10th allocation alive, which leaves all nodes sparse.
+  for (i = 0; i < ASMJIT_ARRAY_SIZE(a); i++) {
+    if ((i % 10) != 0) {
+      EXPECT(memmgr.release(a[i]) == kErrorOk,
+        "Failed to free %p.", a[i]);
+      continue;
+    }
+
+    chunks[count].ptr = a[i];
+    chunks[count].data = &moved;
+    count++;
+  }
+  VMemTest_stats(memmgr);
+
+  size_t allocatedBefore = memmgr.getAllocatedBytes();
+  size_t usedBefore = memmgr.getUsedBytes();
+
+  EXPECT(memmgr.compact(chunks, count, VMemTest_move) == kErrorOk,
+    "Compaction failed.");
+  VMemTest_stats(memmgr);
+
+  EXPECT(moved > 0,
+    "Compaction should move at least one chunk.");
+  EXPECT(memmgr.getAllocatedBytes() < allocatedBefore,
+    "Compaction should unmap at least one node.");
+  EXPECT(memmgr.getUsedBytes() == usedBefore,
+    "Compaction must not change the count of used bytes.");
+
+  for (i = 0; i < count; i++) {
+    const uint8_t* p = static_cast<const uint8_t*>(chunks[i].ptr);
+    uint8_t pattern = static_cast<uint8_t>((i * 10) & 0xFF);
+
+    EXPECT(p[0] == pattern && p[63] == pattern,
+      "Content of chunk #%u has not been preserved.", i);
+    EXPECT(memmgr.release(chunks[i].ptr) == kErrorOk,
+      "Failed to free %p.", chunks[i].ptr);
+  }
+  VMemTest_stats(memmgr);
+
+  EXPECT(memmgr.getUsedBytes() == 0,
+    "All chunks should be released.");
+}
+
+UNIT(base_vmem_huge) {
+  VMemMgr memmgr;
+
+  if (memmgr.setHugePagesEnabled(true) == kErrorNotSupported) {
+    INFO("Huge pages are not supported by the host.");
+    return;
+  }
+
+  size_t hugePageSize = VMemUtil::getHugePageSize();
+  void* a[256];
+  uint32_t i;
+
+  INFO("Huge page alloc/free test - %u allocations.", static_cast<unsigned int>(ASMJIT_ARRAY_SIZE(a)));
+  for (i = 0; i < ASMJIT_ARRAY_SIZE(a); i++) {
+    int r = (rand() % 16000) + 4;
+
+    a[i] = memmgr.alloc(r);
+    EXPECT(a[i] != nullptr,
+      "Couldn't allocate %d bytes of virtual memory.", r);
+    ::memset(a[i], 0, r);
+  }
+  VMemTest_stats(memmgr);
+
+  EXPECT((memmgr.getAllocatedBytes() % hugePageSize) == 0,
+    "Allocated memory should be a multiple of the huge page size.");
+
+  for (i = 0; i < ASMJIT_ARRAY_SIZE(a); i++)
+    EXPECT(memmgr.release(a[i]) == kErrorOk,
+      "Failed to free %p.", a[i]);
+  VMemTest_stats(memmgr);
+}
+
+UNIT(base_vmem_dual) {
+  VMemMgr memmgr;
+
+  Error err = memmgr.setDualMappingEnabled(true);
+  if (err == kErrorNotSupported) {
+    INFO("Dual-mapping is not supported by the host.");
+    return;
+  }
+
+  EXPECT(err == kErrorOk,
+    "Couldn't enable dual-mapping.");
+
+  INFO("Dual-mapped alloc/free test.");
+  for (int i = 0; i < 1000; i++) {
+    int r = (rand() % 1000) + 4;
+    uint32_t type = (i & 7) == 0 ? kVMemAllocPermanent : kVMemAllocFreeable;
+
+    uint8_t* rx = static_cast<uint8_t*>(memmgr.alloc(r, type));
+    EXPECT(rx != nullptr,
+      "Couldn't allocate %d bytes of virtual memory.", r);
+
+    uint8_t* rw = static_cast<uint8_t*>(memmgr.getWritablePtr(rx));
+    EXPECT(rw != nullptr && rw != rx,
+      "Writable alias of %p should be a different address.", rx);
+
+    ::memset(rw, i & 0xFF, r);
+    EXPECT(rx[0] == (i & 0xFF) && rx[r - 1] == (i & 0xFF),
+      "Data written to %p should be visible at %p.", rw, rx);
+
+    if (type == kVMemAllocFreeable && (i & 1) == 0)
+      EXPECT(memmgr.release(rx) == kErrorOk,
+        "Failed to free %p.", rx);
+  }
+  VMemTest_stats(memmgr);
+
+  EXPECT(memmgr.setDualMappingEnabled(false) == kErrorInvalidState,
+    "Dual-mapping can't be disabled after memory has been allocated.");
+}
+
+UNIT(base_vmem_cache) {
+  VMemMgr memmgr;
+
+  // Should be predictible.
+  srand(100);
+
+  int i;
+  int kCount = 50000;
+
+  EXPECT(memmgr.setThreadCacheEnabled(true) == kErrorOk,
+    "Couldn't enable thread caches.");
+
+  INFO("Cached alloc/free test - %d allocations.", static_cast<int>(kCount));
+
+  void** a = (void**)ASMJIT_ALLOC(sizeof(void*) * kCount);
+  void** b = (void**)ASMJIT_ALLOC(sizeof(void*) * kCount);
+
+  EXPECT(a != nullptr && b != nullptr,
+    "Couldn't allocate %u bytes on heap.", kCount * 2);
+
+  for (i = 0; i < kCount; i++) {
+    int r = (rand() % 6000) + 4;
+
+    a[i] = memmgr.alloc(r);
+    EXPECT(a[i] != nullptr,
+      "Couldn't allocate %d bytes of virtual memory.", r);
+
+    b[i] = ASMJIT_ALLOC(r);
+    EXPECT(b[i] != nullptr,
+      "Couldn't allocate %d bytes on heap.", r);
+
+    VMemTest_fill(a[i], b[i], r);
+    EXPECT(memmgr.shrink(a[i], r) == kErrorOk,
+      "Failed to shrink %p.", a[i]);
+  }
+  VMemTest_stats(memmgr);
+
+  INFO("Shuffling...");
+  VMemTest_shuffle(a, b, kCount);
+
+  INFO("Verify and free...");
+  for (i = 0; i < kCount; i++) {
+    VMemTest_verify(a[i], b[i]);
+    EXPECT(memmgr.release(a[i]) == kErrorOk,
+      "Failed to free %p.", a[i]);
+    ASMJIT_FREE(b[i]);
+  }
+  VMemTest_stats(memmgr);
+
+  INFO("Disabling thread caches...");
+  EXPECT(memmgr.setThreadCacheEnabled(false) == kErrorOk,
+    "Couldn't disable thread caches.");
+  VMemTest_stats(memmgr);
+
+  EXPECT(memmgr.getUsedBytes() == 0,
+    "All memory should be returned to the shared pool.");
+
+  ASMJIT_FREE(a);
+  ASMJIT_FREE(b);
+}
 #endif // ASMJIT_TEST
 
 } // asmjit namespace
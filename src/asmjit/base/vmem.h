@@ -40,9 +40,46 @@ ASMJIT_ENUM(VMemFlags) {
   //! Memory is writable.
   kVMemFlagWritable = 0x00000001,
   //! Memory is executable.
-  kVMemFlagExecutable = 0x00000002
+  kVMemFlagExecutable = 0x00000002,
+  //! Memory should be backed by huge pages if the host supports it.
+  //!
+  //! The allocated size is aligned to \ref VMemUtil::getHugePageSize(). If
+  //! huge pages are not available the memory is backed by regular pages.
+  kVMemFlagHugePages = 0x00000004
 };
 
+// ============================================================================
+// [asmjit::VMemCache]
+// ============================================================================
+
+//! Thread cache limits, see `VMemMgr::setThreadCacheEnabled()`.
+ASMJIT_ENUM(VMemCache) {
+  //! Size of each thread cache size-class (and minimum size of cached chunks).
+  kVMemCacheGranularity = 64,
+  //! Largest allocation served by thread caches, bigger go to the shared pool.
+  kVMemCacheMaxSize = 4096
+};
+
+// ============================================================================
+// [asmjit::VMemChunk]
+// ============================================================================
+
+//! Chunk of virtual memory that can be moved by `VMemMgr::compact()`.
+struct VMemChunk {
+  //! Address of the chunk, updated when the chunk has been moved.
+  void* ptr;
+  //! User data passed to \ref VMemMoveHandler.
+  void* data;
+};
+
+//! Handler called by `VMemMgr::compact()` after a chunk has been copied.
+//!
+//! The content of the chunk at `src` has been copied to `dst`, which is
+//! writable through `dstRw`. The handler has to patch all position-dependent
+//! parts of the chunk and return `false` if that's not possible, in that case
+//! the chunk stays at `src`.
+typedef bool (ASMJIT_CDECL* VMemMoveHandler)(void* dst, void* dstRw, void* src, size_t size, void* data);
+
 // ============================================================================
 // [asmjit::VMemUtil]
 // ============================================================================
@@ -65,6 +102,10 @@ struct VMemUtil {
   //! Get a recommended granularity for a single `alloc` call.
   static ASMJIT_API size_t getPageGranularity() noexcept;
 
+  //! Get a size/alignment of a single huge page or zero if the host doesn't
+  //! support huge pages.
+  static ASMJIT_API size_t getHugePageSize() noexcept;
+
   //! Allocate virtual memory.
   //!
   //! Pages are readable/writeable, but they are not guaranteed to be
@@ -74,6 +115,16 @@ struct VMemUtil {
   //! Free memory allocated by `alloc()`.
   static ASMJIT_API Error release(void* addr, size_t length) noexcept;
 
+  //! Allocate virtual memory that is mapped twice.
+  //!
+  //! The same physical pages are mapped as [Readable, Executable] at `rx` and
+  //! as [Readable, Writable] at `rw`, so the code can be written and executed
+  //! without having pages that are both writable and executable (W^X). Returns
+  //! `kErrorNotSupported` if the host doesn't support shared memory mappings.
+  static ASMJIT_API Error allocDualMapping(size_t length, size_t* allocated, void** rx, void** rw) noexcept;
+  //! Free memory allocated by `allocDualMapping()`.
+  static ASMJIT_API Error releaseDualMapping(void* rx, void* rw, size_t length) noexcept;
+
 #if ASMJIT_OS_WINDOWS
   //! Allocate virtual memory of `hProcess` (Windows only).
   static ASMJIT_API void* allocProcessMemory(HANDLE hProcess, size_t length, size_t* allocated, uint32_t flags) noexcept;
@@ -134,6 +185,8 @@ class VMemMgr {
   }
 
   //! Get how many bytes are currently used.
+  //!
+  //! NOTE: Chunks held by thread caches are reported as used.
   ASMJIT_INLINE size_t getUsedBytes() const noexcept {
     return _usedBytes;
   }
@@ -145,6 +198,52 @@ class VMemMgr {
     return _keepVirtualMemory;
   }
 
+  //! Get whether the memory is dual-mapped.
+  //!
+  //! \sa \ref setDualMappingEnabled.
+  ASMJIT_INLINE bool isDualMappingEnabled() const noexcept {
+    return _dualMapping;
+  }
+
+  //! Enable or disable dual-mapping of virtual memory.
+  //!
+  //! If enabled, the memory manager never creates pages that are writable and
+  //! executable at the same time. Each chunk of virtual memory is mapped twice,
+  //! pointers returned by `alloc()` point to the executable view and the code
+  //! has to be written through the address returned by `getWritablePtr()`.
+  //!
+  //! The mode can only be changed when no memory has been allocated, returns
+  //! `kErrorInvalidState` otherwise and `kErrorNotSupported` if the host is
+  //! not able to map the same memory twice.
+  ASMJIT_API Error setDualMappingEnabled(bool enabled) noexcept;
+
+  //! Get whether the memory is backed by huge pages.
+  //!
+  //! \sa \ref setHugePagesEnabled.
+  ASMJIT_INLINE bool isHugePagesEnabled() const noexcept {
+    return _hugePages;
+  }
+
+  //! Enable or disable huge pages.
+  //!
+  //! If enabled, the memory manager reserves regions of at least one huge page
+  //! (typically 2MB) and suballocates code from them, which reduces iTLB misses
+  //! when a lot of generated code is executed. Explicit huge pages are used if
+  //! the host has reserved them, transparent huge pages otherwise, and regular
+  //! pages if neither is available.
+  //!
+  //! The mode only affects memory allocated after it has been changed. Returns
+  //! `kErrorNotSupported` if the host doesn't support huge pages at all.
+  //!
+  //! NOTE: Dual-mapped memory is always backed by regular pages.
+  ASMJIT_API Error setHugePagesEnabled(bool enabled) noexcept;
+
+  //! Get a writable alias of memory `p` returned by `alloc()`.
+  //!
+  //! Returns `p` if dual-mapping is disabled, and `nullptr` if `p` was not
+  //! allocated by this memory manager.
+  ASMJIT_API void* getWritablePtr(void* p) noexcept;
+
   //! Set whether to keep allocated memory after memory manager is
   //! destroyed.
   //!
@@ -161,6 +260,26 @@ class VMemMgr {
     _keepVirtualMemory = keepVirtualMemory;
   }
 
+  //! Get whether thread caches are enabled.
+  //!
+  //! \sa \ref setThreadCacheEnabled.
+  ASMJIT_INLINE bool isThreadCacheEnabled() const noexcept {
+    return _cacheSlots != nullptr;
+  }
+
+  //! Enable or disable thread caches.
+  //!
+  //! Thread caches keep small freeable chunks (see \ref kVMemCacheMaxSize)
+  //! in slots selected by the calling thread, so concurrent `alloc()` and
+  //! `release()` calls don't serialize on a single lock. Chunks are moved
+  //! between thread caches and the shared pool in batches.
+  //!
+  //! NOTE: This function is not thread-safe, it must be called before the
+  //! memory manager is shared with other threads or after all of them have
+  //! finished using it. Disabling returns all cached chunks to the shared pool,
+  //! chunks that are still in use can be released as usual.
+  ASMJIT_API Error setThreadCacheEnabled(bool enabled) noexcept;
+
   // --------------------------------------------------------------------------
   // [Alloc / Release]
   // --------------------------------------------------------------------------
@@ -172,12 +291,39 @@ class VMemMgr {
   //! manager that allocated memory will be never freed.
   ASMJIT_API void* alloc(size_t size, uint32_t type = kVMemAllocFreeable) noexcept;
 
+  //! Allocate `count` chunks of virtual memory of `sizes` in a single run.
+  //!
+  //! All chunks are placed one after another in the same virtual memory and
+  //! are aligned to the block density (64 bytes). Freeable chunks are still
+  //! separate allocations that can be released individually by `release()`.
+  //! The memory manager is locked only once and thread caches are bypassed.
+  //!
+  //! On failure all pointers in `dst` are set to `nullptr`.
+  ASMJIT_API Error allocBatch(void** dst, const size_t* sizes, size_t count, uint32_t type = kVMemAllocFreeable) noexcept;
+
   //! Free previously allocated memory at a given `address`.
   ASMJIT_API Error release(void* p) noexcept;
 
   //! Free extra memory allocated with `p`.
   ASMJIT_API Error shrink(void* p, size_t used) noexcept;
 
+  // --------------------------------------------------------------------------
+  // [Compact]
+  // --------------------------------------------------------------------------
+
+  //! Move freeable `chunks` into fewer nodes and unmap nodes that end up empty.
+  //!
+  //! Only a node where all used memory is covered by `chunks` can be emptied,
+  //! memory not passed to `compact()` pins its node. The least used nodes are
+  //! evacuated first and only into free space of other nodes, compaction never
+  //! maps new memory. Each moved chunk has its `ptr` updated and `handler` is
+  //! called while the old memory is still mapped.
+  //!
+  //! Returns `kErrorInvalidState` if thread caches are enabled.
+  //!
+  //! NOTE: None of the `chunks` can be accessed or executed during compaction.
+  ASMJIT_API Error compact(VMemChunk* chunks, size_t count, VMemMoveHandler handler) noexcept;
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
@@ -197,6 +343,10 @@ class VMemMgr {
 
   // Whether to keep virtual memory after destroy.
   bool _keepVirtualMemory;
+  // Whether virtual memory is mapped twice (RX and RW).
+  bool _dualMapping;
+  // Whether virtual memory is backed by huge pages.
+  bool _hugePages;
 
   //! How many bytes are currently allocated.
   size_t _allocatedBytes;
@@ -206,18 +356,33 @@ class VMemMgr {
   //! \internal
   //! \{
 
+  enum {
+    //! Count of free bins that match the largest free run exactly.
+    kBinExact = 64,
+    //! Count of all free bins (exact and logarithmic).
+    kBinCount = 128
+  };
+
   struct RbNode;
   struct MemNode;
   struct PermanentNode;
+  struct CacheSlot;
 
   // Memory nodes root.
   MemNode* _root;
   // Memory nodes list.
   MemNode* _first;
   MemNode* _last;
-  MemNode* _optimal;
+  // Memory nodes segregated by their largest free run.
+  MemNode* _bins[kBinCount];
+  // Mask of non-empty bins.
+  uint32_t _binMask[kBinCount / 32];
+  // Node of the last allocation, tried first (nullptr if not known).
+  MemNode* _rover;
   // Permanent memory.
   PermanentNode* _permanent;
+  // Thread cache slots (nullptr if thread caches are disabled).
+  CacheSlot* _cacheSlots;
 
   //! \}
 };
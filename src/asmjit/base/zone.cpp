@@ -88,13 +88,30 @@ void* Zone::_alloc(size_t size) noexcept {
 
   // If the `Zone` has been reset the current block doesn't have to be the
   // last one. Check if there is a block that can be used instead of allocating
-  // a new one. If there is a `next` block it's completely unused, we don't have
-  // to check for remaining bytes.
+  // a new one. All blocks after the current one are completely unused, we
+  // don't have to check for remaining bytes. A block that is not the `next`
+  // one is moved after the current block, so the skipped blocks can still be
+  // used, which keeps a reused zone from allocating if the sizes requested
+  // vary.
   Block* next = curBlock->next;
-  if (next != nullptr && next->getBlockSize() >= size) {
-    next->pos = next->data + size;
-    _block = next;
-    return static_cast<void*>(next->data);
+  for (Block* block = next; block != nullptr; block = block->next) {
+    if (block->getBlockSize() < size)
+      continue;
+
+    if (block != next) {
+      block->prev->next = block->next;
+      if (block->next != nullptr)
+        block->next->prev = block->prev;
+
+      block->prev = curBlock;
+      block->next = next;
+      curBlock->next = block;
+      next->prev = block;
+    }
+
+    block->pos = block->data + size;
+    _block = block;
+    return static_cast<void*>(block->data);
   }
 
   // Prevent arithmetic overflow.
@@ -187,6 +204,29 @@ char* Zone::sformat(const char* fmt, ...) noexcept {
   return static_cast<char*>(dup(buf, len));
 }
 
+// ============================================================================
+// [asmjit::Zone - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST)
+UNIT(base_zone) {
+  Zone zone(1024 - Zone::kZoneOverhead);
+
+  INFO("Allocating small and large chunks.");
+  EXPECT(zone.alloc(512) != nullptr && zone.alloc(600) != nullptr && zone.alloc(4096) != nullptr,
+    "Zone::alloc() failed.");
+
+  INFO("Allocating the same chunks in a different order after reset.");
+  DebugUtils::resetAllocCount();
+  zone.reset(false);
+
+  EXPECT(zone.alloc(512) != nullptr && zone.alloc(4096) != nullptr && zone.alloc(600) != nullptr,
+    "Zone::alloc() failed.");
+  EXPECT(DebugUtils::getAllocCount() == 0,
+    "Zone::alloc() shouldn't allocate after reset if a large enough block exists.");
+}
+#endif // ASMJIT_TEST
+
 } // asmjit namespace
 
 // [Api-End]
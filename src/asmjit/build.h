@@ -49,6 +49,8 @@
 // #define ASMJIT_DEBUG              // Define to enable debug-mode.
 // #define ASMJIT_RELEASE            // Define to enable release-mode.
 // #define ASMJIT_TRACE              // Define to enable tracing.
+// #define ASMJIT_TRACE_ALLOC        // Define to count heap allocations, see
+//                                   // `DebugUtils::getAllocCount()`.
 
 // AsmJit Build Backends
 // ---------------------
@@ -284,6 +286,27 @@
 #define ASMJIT_ARCH_64BIT (ASMJIT_ARCH_X64 || ASMJIT_ARCH_ARM64)
 // [@ARCH}@]
 
+// [@ARCH_SIMD{@]
+// \def ASMJIT_ARCH_SSE2
+// True if the compiler targets SSE2 (always true on X64).
+//
+// \def ASMJIT_ARCH_AVX2
+// True if the compiler targets AVX2.
+
+#if ASMJIT_ARCH_X64 || (ASMJIT_ARCH_X86 && (defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+# define ASMJIT_ARCH_SSE2 1
+#else
+# define ASMJIT_ARCH_SSE2 0
+#endif
+
+#if ASMJIT_ARCH_SSE2 && defined(__AVX2__)
+# define ASMJIT_ARCH_AVX2 1
+#else
+# define ASMJIT_ARCH_AVX2 0
+#endif
+// [@ARCH_SIMD}@]
+
 // [@ARCH_UNALIGNED_RW{@]
 // \def ASMJIT_ARCH_UNALIGNED_16
 // True if the target architecture allows unaligned 16-bit reads and writes.
@@ -868,8 +891,13 @@ typedef unsigned __int64 uint64_t;
 #endif
 
 #if !defined(ASMJIT_ALLOC) && !defined(ASMJIT_REALLOC) && !defined(ASMJIT_FREE)
-# define ASMJIT_ALLOC(size) ::malloc(size)
-# define ASMJIT_REALLOC(ptr, size) ::realloc(ptr, size)
+# if defined(ASMJIT_TRACE_ALLOC)
+#  define ASMJIT_ALLOC(size) ::asmjit::DebugUtils::tracedAlloc(size)
+#  define ASMJIT_REALLOC(ptr, size) ::asmjit::DebugUtils::tracedRealloc(ptr, size)
+# else
+#  define ASMJIT_ALLOC(size) ::malloc(size)
+#  define ASMJIT_REALLOC(ptr, size) ::realloc(ptr, size)
+# endif // ASMJIT_TRACE_ALLOC
 # define ASMJIT_FREE(ptr) ::free(ptr)
 #else
 # if !defined(ASMJIT_ALLOC) || !defined(ASMJIT_REALLOC) || !defined(ASMJIT_FREE)
@@ -912,6 +940,14 @@ static inline int disabledTrace(...) { return 0; }
 # endif // ASMJIT_TRACE
 #endif // ASMJIT_EXPORTS
 
+// Allocation functions used by `ASMJIT_ALLOC` and `ASMJIT_REALLOC` if
+// ASMJIT_TRACE_ALLOC is defined, they count calls of `malloc()` and
+// `realloc()`.
+#if defined(ASMJIT_TRACE_ALLOC)
+ASMJIT_API void* tracedAlloc(size_t size) ASMJIT_NOEXCEPT;
+ASMJIT_API void* tracedRealloc(void* p, size_t size) ASMJIT_NOEXCEPT;
+#endif // ASMJIT_TRACE_ALLOC
+
 } // DebugUtils namespace
 } // asmjit namespace
 
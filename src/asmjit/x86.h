@@ -14,6 +14,7 @@
 #include "./x86/x86assembler.h"
 #include "./x86/x86compiler.h"
 #include "./x86/x86compilerfunc.h"
+#include "./x86/x86disassembler.h"
 #include "./x86/x86inst.h"
 #include "./x86/x86operand.h"
 
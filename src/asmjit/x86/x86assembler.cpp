@@ -31,6 +31,23 @@ namespace asmjit {
 
 enum { kX86RexNoRexMask = kX86InstOptionRex | _kX86InstOptionNoRex };
 
+//! \internal
+//!
+//! Static rounding options (EVEX), each of them implies `SAE`.
+enum {
+  kX86EvexRoundingMask = kX86InstOptionEvexRnSae | kX86InstOptionEvexRdSae |
+                         kX86InstOptionEvexRuSae | kX86InstOptionEvexRzSae
+};
+
+//! \internal
+//!
+//! All options that can only be encoded by EVEX prefix.
+enum {
+  kX86EvexOptionsMask = kX86InstOptionEvex     | kX86InstOptionEvexZero |
+                        kX86InstOptionEvexOneN | kX86InstOptionEvexSae  |
+                        kX86EvexRoundingMask   | kX86InstOptionEvexK
+};
+
 //! \internal
 //!
 //! X86/X64 bytes used to encode important prefixes.
@@ -200,6 +217,55 @@ static ASMJIT_INLINE bool x86IsYmm(const X86Reg* reg) { return reg->isYmm(); }
 static ASMJIT_INLINE bool x86IsZmm(const Operand* op) { return op->isRegType(kX86RegTypeZmm); }
 static ASMJIT_INLINE bool x86IsZmm(const X86Reg* reg) { return reg->isZmm(); }
 
+//! Get whether `disp` can be encoded as 8-bit displacement scaled by `1 << shift`.
+//!
+//! The shift is always zero, except for EVEX encoded instructions, which use
+//! a compressed displacement (disp8*N), where `N` depends on the vector length,
+//! element size, and broadcast.
+static ASMJIT_INLINE bool x86IsDisp8(int32_t disp, uint32_t shift) {
+  return (disp & ((1 << shift) - 1)) == 0 && Utils::isInt8(disp >> shift);
+}
+
+//! Get whether an AVX instruction has to be encoded by EVEX instead of VEX.
+//!
+//! Instructions that support AVX-512 masking are EVEX encoded if they don't
+//! have a VEX form, if they use ZMM or K register, or if any of their register
+//! indexes (combined in `regs`) is greater than 15. Any EVEX option always
+//! requires EVEX, it's validated later.
+static ASMJIT_INLINE bool x86UseEvex(const X86InstExtendedInfo& extendedInfo,
+  uint32_t options, uint32_t regs, const Operand* o0, const Operand* o1, const Operand* o2) {
+
+  if ((options & kX86EvexOptionsMask) != 0)
+    return true;
+
+  if (!extendedInfo.hasFlag(kX86InstFlagAvx512KMask))
+    return false;
+
+  return !extendedInfo.hasFlag(kX86InstFlagAvx) || (regs & 0x10) != 0 ||
+         x86IsZmm(o0) || x86IsZmm(o1) || x86IsZmm(o2) || o0->isRegType(kX86RegTypeK);
+}
+
+//! Get whether EVEX `options` are supported by the instruction.
+static ASMJIT_INLINE bool x86IsEvexValid(const X86InstExtendedInfo& extendedInfo, uint32_t options) {
+  if (!extendedInfo.hasFlag(kX86InstFlagAvx512KMask))
+    return false;
+
+  if ((options & kX86InstOptionEvexZero) != 0 &&
+      (!extendedInfo.hasFlag(kX86InstFlagAvx512KZero) || (options & kX86InstOptionEvexK) == 0))
+    return false;
+
+  if ((options & kX86InstOptionEvexOneN) != 0 && !extendedInfo.hasFlag(kX86InstFlagAvx512BCast))
+    return false;
+
+  if ((options & kX86InstOptionEvexSae) != 0 && !extendedInfo.hasFlag(kX86InstFlagAvx512Sae))
+    return false;
+
+  if ((options & kX86EvexRoundingMask) != 0 && !extendedInfo.hasFlag(kX86InstFlagAvx512Rnd))
+    return false;
+
+  return true;
+}
+
 // ============================================================================
 // [Macros]
 // ============================================================================
@@ -377,6 +443,7 @@ Error X86Assembler::embedLabel(const Label& op) {
   if (label->offset != -1) {
     // Bound label.
     rd.data = static_cast<Ptr>(static_cast<SignedPtr>(label->offset));
+    ASMJIT_PROPAGATE_ERROR(_linkSection(label, getOffset(), regSize));
   }
   else {
     // Non-bound label. Need to chain.
@@ -406,35 +473,15 @@ Error X86Assembler::embedLabel(const Label& op) {
 // [asmjit::X86Assembler - Align]
 // ============================================================================
 
-Error X86Assembler::align(uint32_t alignMode, uint32_t offset) noexcept {
-#if !defined(ASMJIT_DISABLE_LOGGER)
-  if (_logger)
-    _logger->logFormat(Logger::kStyleDirective,
-      "%s.align %u\n", _logger->getIndentation(), static_cast<unsigned int>(offset));
-#endif // !ASMJIT_DISABLE_LOGGER
-
-  if (alignMode > kAlignZero)
-    return setLastError(kErrorInvalidArgument);
-
-  if (offset <= 1)
-    return kErrorOk;
-
-  if (!Utils::isPowerOf2(offset) || offset > 64)
-    return setLastError(kErrorInvalidArgument);
-
-  uint32_t i = static_cast<uint32_t>(Utils::alignDiff<size_t>(getOffset(), offset));
-  if (i == 0)
-    return kErrorOk;
-
-  if (getRemainingSpace() < i)
-    ASMJIT_PROPAGATE_ERROR(_grow(i));
-
-  uint8_t* cursor = getCursor();
+//! \internal
+//!
+//! Fill `n` bytes at `cursor` with the alignment sequence of `alignMode`.
+static void x86FillAlign(uint8_t* cursor, uint32_t n, uint32_t alignMode, bool optimizedAlign) noexcept {
   uint8_t pattern = 0x00;
 
   switch (alignMode) {
     case kAlignCode: {
-      if (hasAsmOption(kOptionOptimizedAlign)) {
+      if (optimizedAlign) {
         // Intel 64 and IA-32 Architectures Software Developer's Manual - Volume 2B (NOP).
         enum { kMaxNopSize = 9 };
 
@@ -450,15 +497,13 @@ Error X86Assembler::align(uint32_t alignMode, uint32_t offset) noexcept {
           { 0x66, 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00 }
         };
 
-        do {
-          uint32_t n = Utils::iMin<uint32_t>(i, kMaxNopSize);
-          const uint8_t* p = nopData[n - 1];
+        while (n) {
+          uint32_t i = Utils::iMin<uint32_t>(n, kMaxNopSize);
+          ::memcpy(cursor, nopData[i - 1], i);
 
-          i -= n;
-          do {
-            EMIT_BYTE(*p++);
-          } while (--n);
-        } while (i);
+          cursor += i;
+          n -= i;
+        }
       }
 
       pattern = 0x90;
@@ -476,12 +521,40 @@ Error X86Assembler::align(uint32_t alignMode, uint32_t offset) noexcept {
     }
   }
 
-  while (i) {
-    EMIT_BYTE(pattern);
-    i--;
-  }
+  ::memset(cursor, pattern, n);
+}
 
-  setCursor(cursor);
+Error X86Assembler::align(uint32_t alignMode, uint32_t offset) noexcept {
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  if (_logger)
+    _logger->logFormat(Logger::kStyleDirective,
+      "%s.align %u\n", _logger->getIndentation(), static_cast<unsigned int>(offset));
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  if (alignMode > kAlignZero)
+    return setLastError(kErrorInvalidArgument);
+
+  if (offset <= 1)
+    return kErrorOk;
+
+  if (!Utils::isPowerOf2(offset) || offset > 64)
+    return setLastError(kErrorInvalidArgument);
+
+  // Relaxed jumps before the alignment can change its size, so it's recorded
+  // even if no padding is needed now.
+  uint32_t i = static_cast<uint32_t>(Utils::alignDiff<size_t>(getOffset(), offset));
+  ASMJIT_PROPAGATE_ERROR(_relaxItem(nullptr, getOffset(), i, alignMode, offset));
+
+  if (i == 0)
+    return kErrorOk;
+
+  if (getRemainingSpace() < i)
+    ASMJIT_PROPAGATE_ERROR(_grow(i));
+
+  uint8_t* cursor = getCursor();
+  x86FillAlign(cursor, i, alignMode, hasAsmOption(kOptionOptimizedAlign));
+
+  setCursor(cursor + i);
   return kErrorOk;
 }
 
@@ -500,12 +573,16 @@ size_t X86Assembler::_relocCode(void* _dst, Ptr baseAddress) const noexcept {
   size_t minCodeSize = getOffset();   // Current offset is the minimum code size.
   size_t maxCodeSize = getCodeSize(); // Includes all possible trampolines.
 
+  // Sections other than `.text` follow the code, trampolines are at the end
+  // so the unused space reserved for them can be released.
+  size_t sectionsEnd = getRoDataOffset() + getSection(kSectionRoData).content.length;
+
   // We will copy the exact size of the generated code. Extra code for trampolines
   // is generated on-the-fly by the relocator (this code doesn't exist at the moment).
-  ::memcpy(dst, _buffer, minCodeSize);
+  copyCode(dst, minCodeSize);
 
   // Trampoline pointer.
-  uint8_t* tramp = dst + minCodeSize;
+  uint8_t* tramp = dst + sectionsEnd;
 
   // Relocate all recorded locations.
   size_t relocCount = _relocations.getLength();
@@ -539,7 +616,7 @@ size_t X86Assembler::_relocCode(void* _dst, Ptr baseAddress) const noexcept {
       case kRelocTrampoline:
         ptr -= baseAddress + rd.from + 4;
         if (!Utils::isInt32(static_cast<SignedPtr>(ptr))) {
-          ptr = (Ptr)tramp - (baseAddress + rd.from + 4);
+          ptr = static_cast<Ptr>(tramp - dst) - (rd.from + 4);
           useTrampoline = true;
         }
         break;
@@ -592,10 +669,13 @@ size_t X86Assembler::_relocCode(void* _dst, Ptr baseAddress) const noexcept {
     }
   }
 
+  // Lay out other sections and patch references to them.
+  _relocSections(dst);
+
   if (arch == kArchX64)
     return (size_t)(tramp - dst);
   else
-    return (size_t)(minCodeSize);
+    return (size_t)(sectionsEnd);
 }
 
 // ============================================================================
@@ -844,6 +924,32 @@ static void X86Assembler_dumpOperand(StringBuilder& sb, uint32_t arch, const Ope
   }
 }
 
+//! Dump `{k}` and `{z}` after the destination operand.
+static void X86Assembler_dumpEvexMask(StringBuilder& sb, uint32_t options) {
+  if (options & kX86InstOptionEvexK) {
+    sb._appendString("{k", 2);
+    sb._appendUInt32((options & kX86InstOptionEvexK) >> kX86InstOptionEvexKShift);
+    sb._appendChar('}');
+  }
+
+  if (options & kX86InstOptionEvexZero)
+    sb._appendString("{z}", 3);
+}
+
+//! Dump `{1toN}` after a broadcasted memory operand `op`, `N` is calculated
+//! from the size of the vector register `vec` and the instruction element size.
+static void X86Assembler_dumpEvexBroadcast(StringBuilder& sb, uint32_t code, uint32_t options, const Operand* op, const Operand* vec) {
+  if (!(options & kX86InstOptionEvexOneN) || !op->isMem() || !vec->isReg())
+    return;
+
+  uint32_t opCode = _x86InstInfo[code].getPrimaryOpCode();
+  uint32_t elementSize = 4 << ((opCode & kX86InstOpCode_EW) >> kX86InstOpCode_EW_Shift);
+
+  sb._appendString("{1to", 4);
+  sb._appendUInt32(vec->getSize() / elementSize);
+  sb._appendChar('}');
+}
+
 static bool X86Assembler_dumpInstruction(StringBuilder& sb,
   uint32_t arch,
   uint32_t code,
@@ -874,16 +980,20 @@ static bool X86Assembler_dumpInstruction(StringBuilder& sb,
   if (!o0->isNone()) {
     sb._appendChar(' ');
     X86Assembler_dumpOperand(sb, arch, o0, loggerOptions);
+    X86Assembler_dumpEvexMask(sb, options);
+    X86Assembler_dumpEvexBroadcast(sb, code, options, o0, o1);
   }
 
   if (!o1->isNone()) {
     sb._appendString(", ", 2);
     X86Assembler_dumpOperand(sb, arch, o1, loggerOptions);
+    X86Assembler_dumpEvexBroadcast(sb, code, options, o1, o0);
   }
 
   if (!o2->isNone()) {
     sb._appendString(", ", 2);
     X86Assembler_dumpOperand(sb, arch, o2, loggerOptions);
+    X86Assembler_dumpEvexBroadcast(sb, code, options, o2, o1);
   }
 
   if (!o3->isNone()) {
@@ -891,10 +1001,393 @@ static bool X86Assembler_dumpInstruction(StringBuilder& sb,
     X86Assembler_dumpOperand(sb, arch, o3, loggerOptions);
   }
 
+  // Dump SAE and embedded rounding as a last pseudo-operand.
+  if (options & (kX86InstOptionEvexSae | kX86EvexRoundingMask)) {
+    static const char roundingNames[] = "rn-sae\0" "rd-sae\0" "ru-sae\0" "rz-sae\0";
+
+    sb._appendString(", {", 3);
+    if (options & kX86EvexRoundingMask) {
+      uint32_t rc = Utils::findFirstBit(options & kX86EvexRoundingMask) -
+                    Utils::findFirstBit(kX86InstOptionEvexRnSae);
+      sb._appendString(&roundingNames[rc * 7]);
+    }
+    else {
+      sb._appendString("sae", 3);
+    }
+    sb._appendChar('}');
+  }
+
   return true;
 }
+
+// ============================================================================
+// [asmjit::X86Util - Formatting]
+// ============================================================================
+
+Error X86Util::formatInst(StringBuilder& sb, uint32_t arch,
+  uint32_t instId, uint32_t options, const Operand* opList, uint32_t opCount,
+  uint32_t loggerOptions) noexcept {
+
+  if (instId == kInstIdNone || instId >= _kX86InstIdCount)
+    return kErrorUnknownInst;
+
+  const Operand* ops[4];
+  for (uint32_t i = 0; i < 4; i++)
+    ops[i] = i < opCount ? &opList[i] : &noOperand;
+
+  if (!X86Assembler_dumpInstruction(sb, arch, instId, options, ops[0], ops[1], ops[2], ops[3], loggerOptions))
+    return kErrorNoHeapMemory;
+
+  return kErrorOk;
+}
 #endif // !ASMJIT_DISABLE_LOGGER
 
+// ============================================================================
+// [asmjit::X86Assembler - Relax]
+// ============================================================================
+
+//! \internal
+//!
+//! State of a jump during relaxation.
+ASMJIT_ENUM(X86RelaxState) {
+  //! Long form, can be relaxed.
+  kX86RelaxLong = 0,
+  //! Short form.
+  kX86RelaxShort = 1,
+  //! Long form, the short form doesn't fit.
+  kX86RelaxPinned = 2
+};
+
+//! \internal
+//!
+//! Compute `delta[i]`, the number of bytes removed by items `0...i`.
+static void x86RelaxLayout(const RelaxItem* items, const uint8_t* state, intptr_t* delta, size_t count) noexcept {
+  intptr_t d = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    const RelaxItem& item = items[i];
+
+    if (item.label != nullptr) {
+      if (state[i] == kX86RelaxShort)
+        d += static_cast<intptr_t>(item.size) - 2;
+    }
+    else {
+      size_t start = item.offset - d;
+      d += static_cast<intptr_t>(item.size) - static_cast<intptr_t>(Utils::alignDiff<size_t>(start, item.alignment));
+    }
+
+    delta[i] = d;
+  }
+}
+
+//! \internal
+//!
+//! Map `offset` of the original code to the relaxed code.
+//!
+//! An offset at the position of an empty alignment is ambiguous. Labels bound
+//! there are mapped after the padding (`isLabel`), the end of the instruction
+//! that precedes the alignment is mapped before it.
+static size_t x86RelaxMap(const RelaxItem* items, const intptr_t* delta, size_t count, size_t offset, bool isLabel) noexcept {
+  // Count items that end before `offset`.
+  size_t lo = 0;
+  size_t hi = count;
+
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (items[mid].offset + items[mid].size < offset)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  // And items that end at `offset`.
+  while (lo < count) {
+    const RelaxItem& item = items[lo];
+    if (item.offset + item.size != offset || (item.size == 0 && !isLabel))
+      break;
+    lo++;
+  }
+
+  return lo == 0 ? offset : offset - delta[lo - 1];
+}
+
+//! \internal
+//!
+//! Get index of the jump that contains `offset` or `kInvalidIndex`.
+static size_t x86RelaxFind(const RelaxItem* items, size_t count, size_t offset) noexcept {
+  size_t lo = 0;
+  size_t hi = count;
+
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (items[mid].offset < offset)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if (lo == 0)
+    return kInvalidIndex;
+
+  const RelaxItem& item = items[lo - 1];
+  if (item.label == nullptr || offset >= item.offset + item.size)
+    return kInvalidIndex;
+
+  return lo - 1;
+}
+
+static int ASMJIT_CDECL x86RelaxCompareOffset(const void* a, const void* b) noexcept {
+  size_t x = *static_cast<const size_t*>(a);
+  size_t y = *static_cast<const size_t*>(b);
+  return x < y ? -1 : static_cast<int>(x > y);
+}
+
+Error X86Assembler::_relax() noexcept {
+  RelaxItem* items = _relaxItems.getData();
+  size_t count = _relaxItems.getLength();
+
+  RelaxRef* refs = _relaxRefs.getData();
+  size_t refCount = _relaxRefs.getLength();
+
+  size_t codeSize = getOffset();
+  size_t i;
+
+  // All labels must be bound. Try again later if they are not.
+  for (i = 0; i < refCount; i++) {
+    if (refs[i].label->offset == -1)
+      return kErrorOk;
+  }
+
+  // Items must follow each other, which is not the case if the code has been
+  // patched through `setOffset()`. Relaxation is not possible in such case.
+  size_t prevEnd = 0;
+  for (i = 0; i < count; i++) {
+    const RelaxItem& item = items[i];
+    if (item.offset < prevEnd) {
+      _relaxItems.reset();
+      return kErrorOk;
+    }
+    prevEnd = item.offset + item.size;
+  }
+
+  if (prevEnd > codeSize) {
+    _relaxItems.reset();
+    return kErrorOk;
+  }
+
+  size_t linkCount = _sectionLinks.getLength();
+  uint8_t* tmp = static_cast<uint8_t*>(ASMJIT_ALLOC(
+    count    * (sizeof(intptr_t) + sizeof(size_t) + sizeof(uint8_t)) +
+    refCount * sizeof(int32_t) +
+    linkCount * sizeof(size_t)));
+
+  if (tmp == nullptr)
+    return setLastError(kErrorNoHeapMemory);
+
+  intptr_t* delta = reinterpret_cast<intptr_t*>(tmp);
+  size_t* newOffsets = reinterpret_cast<size_t*>(delta + count);
+  size_t* linkOffsets = newOffsets + count;
+  int32_t* values = reinterpret_cast<int32_t*>(linkOffsets + linkCount);
+  uint8_t* state = reinterpret_cast<uint8_t*>(values + refCount);
+
+  // Jumps to other sections stay long, they are not valid anyway.
+  for (i = 0; i < count; i++) {
+    const RelaxItem& item = items[i];
+    state[i] = item.label != nullptr && item.label->sectionId != kSectionText
+      ? static_cast<uint8_t>(kX86RelaxPinned)
+      : static_cast<uint8_t>(kX86RelaxLong);
+  }
+
+  // Shrink all jumps that fit and repeat until nothing changes. Alignments can
+  // make distances longer, a jump that doesn't fit anymore is pinned to its
+  // long form, so the loop always terminates.
+  for (;;) {
+    bool changed = false;
+    x86RelaxLayout(items, state, delta, count);
+
+    for (i = 0; i < count; i++) {
+      const RelaxItem& item = items[i];
+      if (item.label == nullptr || state[i] == kX86RelaxPinned)
+        continue;
+
+      intptr_t disp = static_cast<intptr_t>(x86RelaxMap(items, delta, count, item.label->offset, true)) -
+                      static_cast<intptr_t>(x86RelaxMap(items, delta, count, item.offset + item.size, false));
+
+      if (state[i] == kX86RelaxShort) {
+        if (!Utils::isInt8(disp)) {
+          state[i] = kX86RelaxPinned;
+          changed = true;
+        }
+      }
+      else if (Utils::isInt8(disp)) {
+        state[i] = kX86RelaxShort;
+        changed = true;
+      }
+    }
+
+    if (!changed)
+      break;
+  }
+
+  // Recompute displacements of all other references. If a short one doesn't
+  // fit anymore the code is left as is.
+  for (i = 0; i < refCount; i++) {
+    const RelaxRef& ref = refs[i];
+    if (x86RelaxFind(items, count, ref.offset) != kInvalidIndex)
+      continue;
+
+    LabelData* label = ref.label;
+    intptr_t value = ref.size == 1 ? readI8At(ref.offset) : readI32At(ref.offset);
+    intptr_t base = static_cast<intptr_t>(x86RelaxMap(items, delta, count, ref.base, false));
+
+    if (label->sectionId == kSectionText) {
+      intptr_t addend = value - (label->offset - static_cast<intptr_t>(ref.base));
+      value = static_cast<intptr_t>(x86RelaxMap(items, delta, count, label->offset, true)) - base + addend;
+    }
+    else {
+      // Relative to the start of the section, see `_relocSections()`.
+      value += static_cast<intptr_t>(ref.base) - base;
+    }
+
+    if (ref.size == 1 && !Utils::isInt8(value)) {
+      ASMJIT_FREE(tmp);
+      _relaxItems.reset();
+      return kErrorOk;
+    }
+
+    values[i] = static_cast<int32_t>(value);
+  }
+
+  Error error = _flatten();
+  if (error != kErrorOk) {
+    ASMJIT_FREE(tmp);
+    return error;
+  }
+
+  uint8_t* buf = _buffer;
+
+  // Move the code.
+  bool optimizedAlign = hasAsmOption(kOptionOptimizedAlign);
+  size_t src = 0;
+  size_t dst = 0;
+
+  for (i = 0; i < count; i++) {
+    const RelaxItem& item = items[i];
+
+    ::memmove(buf + dst, buf + src, item.offset - src);
+    dst += item.offset - src;
+    newOffsets[i] = dst;
+
+    if (item.label != nullptr) {
+      if (state[i] == kX86RelaxShort) {
+        // Jmp (E9 -> EB) or Jcc (0F 8x -> 7x).
+        uint32_t opCode = buf[item.offset] == 0xE9 ? 0xEB : buf[item.offset + 1] - 0x10;
+        buf[dst] = static_cast<uint8_t>(opCode);
+        dst += 2;
+      }
+      else {
+        ::memmove(buf + dst, buf + item.offset, item.size);
+        dst += item.size;
+      }
+    }
+    else {
+      size_t padding = Utils::alignDiff<size_t>(dst, item.alignment);
+      x86FillAlign(buf + dst, static_cast<uint32_t>(padding), item.alignMode, optimizedAlign);
+      dst += padding;
+    }
+
+    src = item.offset + item.size;
+  }
+
+  ::memmove(buf + dst, buf + src, codeSize - src);
+  dst += codeSize - src;
+
+  // Patch the jumps.
+  for (i = 0; i < count; i++) {
+    const RelaxItem& item = items[i];
+    if (item.label == nullptr)
+      continue;
+
+    size_t size = state[i] == kX86RelaxShort ? 2 : item.size;
+    uint8_t* p = buf + newOffsets[i] + size - 4;
+
+    if (item.label->sectionId != kSectionText) {
+      // Relative to the start of the section, see `_relocSections()`.
+      Utils::writeI32u(p, Utils::readI32u(p) + static_cast<int32_t>(item.offset - newOffsets[i]));
+      continue;
+    }
+
+    intptr_t disp = static_cast<intptr_t>(x86RelaxMap(items, delta, count, item.label->offset, true)) -
+                    static_cast<intptr_t>(newOffsets[i] + size);
+
+    if (size == 2)
+      buf[newOffsets[i] + 1] = static_cast<uint8_t>(disp & 0xFF);
+    else
+      Utils::writeI32u(p, static_cast<int32_t>(disp));
+  }
+
+  // Patch and update other references.
+  for (i = 0; i < refCount; i++) {
+    RelaxRef& ref = refs[i];
+    size_t index = x86RelaxFind(items, count, ref.offset);
+
+    if (index != kInvalidIndex) {
+      size_t size = state[index] == kX86RelaxShort ? 2 : items[index].size;
+
+      ref.size = size == 2 ? 1 : 4;
+      ref.base = newOffsets[index] + size;
+      ref.offset = ref.base - ref.size;
+      continue;
+    }
+
+    ref.offset = x86RelaxMap(items, delta, count, ref.offset, false);
+    ref.base = x86RelaxMap(items, delta, count, ref.base, false);
+
+    if (ref.size == 1)
+      buf[ref.offset] = static_cast<uint8_t>(values[i] & 0xFF);
+    else
+      Utils::writeI32u(buf + ref.offset, values[i]);
+  }
+
+  // Update relocations, absolute addresses of labels in other sections are
+  // relative to the start of the section.
+  SectionLink* links = _sectionLinks.getData();
+  for (i = 0; i < linkCount; i++)
+    linkOffsets[i] = links[i].offset;
+  ::qsort(linkOffsets, linkCount, sizeof(size_t), x86RelaxCompareOffset);
+
+  RelocData* rdList = _relocations.getData();
+  size_t rdCount = _relocations.getLength();
+
+  for (i = 0; i < rdCount; i++) {
+    RelocData& rd = rdList[i];
+    size_t from = static_cast<size_t>(rd.from);
+
+    if (rd.type == kRelocRelToAbs && ::bsearch(&from, linkOffsets, linkCount, sizeof(size_t), x86RelaxCompareOffset) == nullptr)
+      rd.data = static_cast<Ptr>(x86RelaxMap(items, delta, count, static_cast<size_t>(rd.data), true));
+    rd.from = static_cast<Ptr>(x86RelaxMap(items, delta, count, from, false));
+  }
+
+  for (i = 0; i < linkCount; i++)
+    links[i].offset = x86RelaxMap(items, delta, count, links[i].offset, false);
+
+  // Update labels.
+  LabelData** labels = _labels.getData();
+  size_t labelCount = _labels.getLength();
+
+  for (i = 0; i < labelCount; i++) {
+    LabelData* label = labels[i];
+    if (label->offset != -1 && label->sectionId == kSectionText)
+      label->offset = static_cast<intptr_t>(x86RelaxMap(items, delta, count, label->offset, true));
+  }
+
+  _cursor = buf + dst;
+  _relaxItems.reset();
+
+  ASMJIT_FREE(tmp);
+  return kErrorOk;
+}
+
 // ============================================================================
 // [asmjit::X86Assembler - Emit]
 // ============================================================================
@@ -970,6 +1463,8 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
   int32_t dispOffset;
   // Displacement size.
   uint32_t dispSize = 0;
+  // Displacement shift (EVEX compressed displacement), zero otherwise.
+  uint32_t dispShift = 0;
   // Displacement relocation id.
   intptr_t relocId;
 
@@ -1274,10 +1769,11 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
         if (label->offset != -1) {
           // Bound label.
           static const intptr_t kRel32Size = 5;
-          intptr_t offs = label->offset - (intptr_t)(cursor - self->_buffer);
+          intptr_t offs = label->offset - (intptr_t)self->_getOffsetOf(cursor);
 
           ASMJIT_ASSERT(offs <= 0);
           EMIT_BYTE(opCode);
+          ASMJIT_PROPAGATE_ERROR(self->_relaxRef(label, self->_getOffsetOf(cursor), 4));
           EMIT_DWORD(static_cast<int32_t>(offs - kRel32Size));
         }
         else {
@@ -1456,11 +1952,12 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
           static const intptr_t kRel8Size = 2;
           static const intptr_t kRel32Size = 6;
 
-          intptr_t offs = label->offset - (intptr_t)(cursor - self->_buffer);
+          intptr_t offs = label->offset - (intptr_t)self->_getOffsetOf(cursor);
           ASMJIT_ASSERT(offs <= 0);
 
           if ((options & kInstOptionLongForm) == 0 && Utils::isInt8(offs - kRel8Size)) {
             EMIT_BYTE(opCode);
+            ASMJIT_PROPAGATE_ERROR(self->_relaxRef(label, self->_getOffsetOf(cursor), 1));
             EMIT_BYTE(offs - kRel8Size);
 
             options |= kInstOptionShortForm;
@@ -1469,6 +1966,7 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
           else {
             EMIT_BYTE(0x0F);
             EMIT_BYTE(opCode + 0x10);
+            ASMJIT_PROPAGATE_ERROR(self->_relaxRef(label, self->_getOffsetOf(cursor), 4));
             EMIT_DWORD(static_cast<int32_t>(offs - kRel32Size));
 
             options &= ~kInstOptionShortForm;
@@ -1485,6 +1983,9 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
             goto _EmitDisplacement;
           }
           else {
+            if ((options & kInstOptionLongForm) == 0)
+              ASMJIT_PROPAGATE_ERROR(self->_relaxItem(label, self->_getOffsetOf(cursor), 6));
+
             EMIT_BYTE(0x0F);
             EMIT_BYTE(opCode + 0x10);
             dispOffset = -4;
@@ -1511,10 +2012,11 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
 
         if (label->offset != -1) {
           // Bound label.
-          intptr_t offs = label->offset - (intptr_t)(cursor - self->_buffer) - 1;
+          intptr_t offs = label->offset - (intptr_t)self->_getOffsetOf(cursor) - 1;
           if (!Utils::isInt8(offs))
             goto _IllegalInst;
 
+          ASMJIT_PROPAGATE_ERROR(self->_relaxRef(label, self->_getOffsetOf(cursor), 1));
           EMIT_BYTE(offs);
           goto _EmitDone;
         }
@@ -1554,12 +2056,13 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
           const intptr_t kRel8Size = 2;
           const intptr_t kRel32Size = 5;
 
-          intptr_t offs = label->offset - (intptr_t)(cursor - self->_buffer);
+          intptr_t offs = label->offset - (intptr_t)self->_getOffsetOf(cursor);
 
           if ((options & kInstOptionLongForm) == 0 && Utils::isInt8(offs - kRel8Size)) {
             options |= kInstOptionShortForm;
 
             EMIT_BYTE(0xEB);
+            ASMJIT_PROPAGATE_ERROR(self->_relaxRef(label, self->_getOffsetOf(cursor), 1));
             EMIT_BYTE(offs - kRel8Size);
             goto _EmitDone;
           }
@@ -1567,6 +2070,7 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
             options &= ~kInstOptionShortForm;
 
             EMIT_BYTE(0xE9);
+            ASMJIT_PROPAGATE_ERROR(self->_relaxRef(label, self->_getOffsetOf(cursor), 4));
             EMIT_DWORD(static_cast<int32_t>(offs - kRel32Size));
             goto _EmitDone;
           }
@@ -1581,6 +2085,9 @@ static ASMJIT_INLINE Error X86Assembler_emit(Assembler* self_, uint32_t code, co
             goto _EmitDisplacement;
           }
           else {
+            if ((options & kInstOptionLongForm) == 0)
+              ASMJIT_PROPAGATE_ERROR(self->_relaxItem(label, self->_getOffsetOf(cursor), 5));
+
             EMIT_BYTE(0xE9);
             dispOffset = -4;
             dispSize = 4;
@@ -2134,7 +2641,7 @@ _GroupPop_Gp:
         if (!Utils::inInterval<uint32_t>(static_cast<const X86Reg*>(o0)->getRegType(), kX86RegTypeGpd, kX86RegTypeGpq))
           goto _IllegalInst;
 
-        opCode += o0->getSize() != 1;
+        opCode += o1->getSize() != 1;
         opReg = x86OpReg(o0);
         rmReg = x86OpReg(o1);
         goto _EmitX86R;
@@ -2144,7 +2651,7 @@ _GroupPop_Gp:
         if (!Utils::inInterval<uint32_t>(static_cast<const X86Reg*>(o0)->getRegType(), kX86RegTypeGpd, kX86RegTypeGpq))
           goto _IllegalInst;
 
-        opCode += o0->getSize() != 1;
+        opCode += o1->getSize() != 1;
         opReg = x86OpReg(o0);
         rmMem = x86OpMem(o1);
         goto _EmitX86M;
@@ -2705,7 +3212,8 @@ _EmitMmMovD:
                 (static_cast<const Imm*>(o2)->getUInt32() << 8) ;
         imLen = 2;
 
-        rmReg = x86ExtractO(opCode);
+        opReg = x86ExtractO(opCode);
+        rmReg = x86OpReg(o0);
         goto _EmitX86R;
       }
       break;
@@ -2766,6 +3274,7 @@ _EmitMmMovD:
       }
       break;
 
+    case kX86InstEncodingAvxMr_T1S:
     case kX86InstEncodingAvxMr_OptL:
       ADD_VEX_L(x86IsYmm(o0) | x86IsYmm(o1));
       ASMJIT_FALLTHROUGH;
@@ -2805,6 +3314,7 @@ _EmitMmMovD:
       }
       break;
 
+    case kX86InstEncodingAvxRm_T1S:
     case kX86InstEncodingAvxRm_OptL:
       ADD_VEX_L(x86IsYmm(static_cast<const X86Reg*>(o0)) | x86IsYmm(o1));
       ASMJIT_FALLTHROUGH;
@@ -2960,6 +3470,34 @@ CaseAvxRmv:
       }
       break;
 
+    case kX86InstEncodingAvxKMov:
+      // The primary opcode is `K <- K/Mem`, `K <- Gp` follows it by 2. The
+      // secondary opcode is `Mem <- K`, `Gp <- K` follows it by 2.
+      if (encoded == ENC_OPS(Reg, Reg, None)) {
+        if (static_cast<const X86Reg*>(o0)->isGp())
+          opCode = extendedInfo.getSecondaryOpCode() + 2;
+        else if (static_cast<const X86Reg*>(o1)->isGp())
+          opCode += 2;
+
+        opReg = x86OpReg(o0);
+        rmReg = x86OpReg(o1);
+        goto _EmitAvxR;
+      }
+
+      if (encoded == ENC_OPS(Reg, Mem, None)) {
+        opReg = x86OpReg(o0);
+        rmMem = x86OpMem(o1);
+        goto _EmitAvxM;
+      }
+
+      if (encoded == ENC_OPS(Mem, Reg, None)) {
+        opCode = extendedInfo.getSecondaryOpCode();
+        opReg = x86OpReg(o1);
+        rmMem = x86OpMem(o0);
+        goto _EmitAvxM;
+      }
+      break;
+
     case kX86InstEncodingAvxMovDQ:
       if (encoded == ENC_OPS(Reg, Reg, None)) {
         if (static_cast<const X86Reg*>(o0)->isGp()) {
@@ -3163,7 +3701,7 @@ CaseAvxVm:
       ASMJIT_FALLTHROUGH;
 
     case kX86InstEncodingAvxVmi:
-      imVal = static_cast<const Imm*>(o3)->getInt64();
+      imVal = static_cast<const Imm*>(o2)->getInt64();
       imLen = 1;
 
       if (encoded == ENC_OPS(Reg, Reg, Imm)) {
@@ -3680,11 +4218,11 @@ _EmitSib:
           EMIT_BYTE(x86EncodeMod(0, opReg, 4));
           EMIT_BYTE(x86EncodeSib(0, 4, 4));
         }
-        else if (Utils::isInt8(dispOffset)) {
+        else if (x86IsDisp8(dispOffset, dispShift)) {
           // [Esp/Rsp/R12 + Disp8].
           EMIT_BYTE(x86EncodeMod(1, opReg, 4));
           EMIT_BYTE(x86EncodeSib(0, 4, 4));
-          EMIT_BYTE(static_cast<int8_t>(dispOffset));
+          EMIT_BYTE(static_cast<int8_t>(dispOffset >> dispShift));
         }
         else {
           // [Esp/Rsp/R12 + Disp32].
@@ -3697,10 +4235,10 @@ _EmitSib:
         // [Base].
         EMIT_BYTE(x86EncodeMod(0, opReg, mBase));
       }
-      else if (Utils::isInt8(dispOffset)) {
+      else if (x86IsDisp8(dispOffset, dispShift)) {
         // [Base + Disp8].
         EMIT_BYTE(x86EncodeMod(1, opReg, mBase));
-        EMIT_BYTE(static_cast<int8_t>(dispOffset));
+        EMIT_BYTE(static_cast<int8_t>(dispOffset >> dispShift));
       }
       else {
         // [Base + Disp32].
@@ -3720,11 +4258,11 @@ _EmitSib:
         EMIT_BYTE(x86EncodeMod(0, opReg, 4));
         EMIT_BYTE(x86EncodeSib(shift, mIndex, mBase));
       }
-      else if (Utils::isInt8(dispOffset)) {
+      else if (x86IsDisp8(dispOffset, dispShift)) {
         // [Base + Index * Scale + Disp8].
         EMIT_BYTE(x86EncodeMod(1, opReg, 4));
         EMIT_BYTE(x86EncodeSib(shift, mIndex, mBase));
-        EMIT_BYTE(static_cast<int8_t>(dispOffset));
+        EMIT_BYTE(static_cast<int8_t>(dispOffset >> dispShift));
       }
       else {
         // [Base + Index * Scale + Disp32].
@@ -3760,7 +4298,7 @@ _EmitSib:
       RelocData rd;
       rd.type = kRelocRelToAbs;
       rd.size = 4;
-      rd.from = static_cast<Ptr>((uintptr_t)(cursor - self->_buffer));
+      rd.from = static_cast<Ptr>((uintptr_t)self->_getOffsetOf(cursor));
       rd.data = static_cast<SignedPtr>(dispOffset);
 
       if (self->_relocations.append(rd) != kErrorOk)
@@ -3769,6 +4307,7 @@ _EmitSib:
       if (label->offset != -1) {
         // Bound label.
         self->_relocations[relocId].data += static_cast<SignedPtr>(label->offset);
+        ASMJIT_PROPAGATE_ERROR(self->_linkSection(label, self->_getOffsetOf(cursor), 4));
         EMIT_DWORD(0);
       }
       else {
@@ -3785,7 +4324,7 @@ _EmitSib:
       RelocData rd;
       rd.type = kRelocRelToAbs;
       rd.size = 4;
-      rd.from = static_cast<Ptr>((uintptr_t)(cursor - self->_buffer));
+      rd.from = static_cast<Ptr>((uintptr_t)self->_getOffsetOf(cursor));
       rd.data = rd.from + static_cast<SignedPtr>(dispOffset);
 
       if (self->_relocations.append(rd) != kErrorOk)
@@ -3824,7 +4363,9 @@ _EmitSib:
 
       if (label->offset != -1) {
         // Bound label.
-        dispOffset += label->offset - static_cast<int32_t>((intptr_t)(cursor - self->_buffer));
+        dispOffset += label->offset - static_cast<int32_t>((intptr_t)self->_getOffsetOf(cursor));
+        ASMJIT_PROPAGATE_ERROR(self->_linkSection(label, self->_getOffsetOf(cursor), 4));
+        ASMJIT_PROPAGATE_ERROR(self->_relaxRef(label, self->_getOffsetOf(cursor), 4, imLen));
         EMIT_DWORD(static_cast<int32_t>(dispOffset));
       }
       else {
@@ -3955,6 +4496,9 @@ _EmitAvxOp:
   goto _EmitDone;
 
 _EmitAvxR:
+  if (x86UseEvex(extendedInfo, options, opReg | (opReg >> kVexVVVVShift) | static_cast<uint32_t>(rmReg), o0, o1, o2))
+    goto _EmitEvexR;
+
   {
     uint32_t vex_XvvvvLpp;
     uint32_t vex_rxbmmmmm;
@@ -3998,6 +4542,9 @@ _EmitAvxR:
   goto _EmitDone;
 
 _EmitAvxM:
+  if (x86UseEvex(extendedInfo, options, opReg | (opReg >> kVexVVVVShift), o0, o1, o2))
+    goto _EmitEvexM;
+
   EMIT_AVX_M
   goto _EmitSib;
 
@@ -4051,7 +4598,7 @@ _EmitAvxV:
         RelocData rd;
         rd.type = kRelocRelToAbs;
         rd.size = 4;
-        rd.from = static_cast<Ptr>((uintptr_t)(cursor - self->_buffer));
+        rd.from = static_cast<Ptr>((uintptr_t)self->_getOffsetOf(cursor));
         rd.data = static_cast<SignedPtr>(dispOffset);
 
         if (self->_relocations.append(rd) != kErrorOk)
@@ -4061,6 +4608,7 @@ _EmitAvxV:
       if (label->offset != -1) {
         // Bound label.
         self->_relocations[relocId].data += static_cast<SignedPtr>(label->offset);
+        ASMJIT_PROPAGATE_ERROR(self->_linkSection(label, self->_getOffsetOf(cursor), 4));
         EMIT_DWORD(0);
       }
       else {
@@ -4077,6 +4625,115 @@ _EmitAvxV:
   }
   goto _EmitDone;
 
+  // --------------------------------------------------------------------------
+  // [Emit - Evex]
+  // --------------------------------------------------------------------------
+
+  // The EVEX payload is composed as `P[23:0]`, see `kX86ByteEvex`. The `R`,
+  // `X`, `B`, `R'`, `V'`, and `vvvv` fields are stored inverted. Vector length
+  // `L'L` is taken from `L` field, which is promoted to 512-bit if any operand
+  // is a ZMM register.
+#define EMIT_EVEX_PREFIX(_Payload_) \
+  uint32_t evex_P = (_Payload_); \
+  \
+  if (!x86IsEvexValid(extendedInfo, options)) \
+    goto _IllegalInst; \
+  \
+  if (x86IsZmm(o0) | x86IsZmm(o1) | x86IsZmm(o2)) \
+    opCode = (opCode & ~kX86InstOpCode_L_Mask) | kX86InstOpCode_L_512; \
+  \
+  evex_P |= (opCode >> kX86InstOpCode_MM_Shift) & 0x03; \
+  evex_P |= (opReg & 0x08) << 4; \
+  evex_P |= (opReg & 0x10); \
+  evex_P |= (opCode >> kX86InstOpCode_PP_Shift & 0x03) << 8; \
+  evex_P |= 0x0400; \
+  evex_P |= (opReg >> 1) & 0x7800; \
+  evex_P |= (opCode >> kX86InstOpCode_EW_Shift & 0x01) << 15; \
+  evex_P |= (options >> kX86InstOptionEvexKShift & 0x07) << 16; \
+  evex_P |= (opReg << 3) & 0x80000; \
+  evex_P |= (opCode >> kX86InstOpCode_L_Shift & 0x03) << 21; \
+  evex_P |= (options & kX86InstOptionEvexZero) << (23 - 17); \
+  evex_P ^= 0x0878F0;
+
+_EmitEvexR:
+  {
+    EMIT_EVEX_PREFIX(((static_cast<uint32_t>(rmReg) & 0x10) << 2) |
+                     ((static_cast<uint32_t>(rmReg) & 0x08) << 2))
+
+    if ((options & kX86InstOptionEvexOneN) != 0)
+      goto _IllegalInst;
+
+    // `EVEX.b` in a register form turns `L'L` into the rounding control
+    // field (vector length is implied 512-bit), SAE alone leaves it zero.
+    if ((options & (kX86InstOptionEvexSae | kX86EvexRoundingMask)) != 0) {
+      evex_P &= ~0x600000U;
+      evex_P |= 0x100000;
+      if ((options & kX86EvexRoundingMask) != 0) {
+        evex_P |= (Utils::findFirstBit(options & kX86EvexRoundingMask) -
+                   Utils::findFirstBit(kX86InstOptionEvexRnSae)) << 21;
+      }
+    }
+
+    EMIT_BYTE(kX86ByteEvex);
+    EMIT_BYTE(evex_P);
+    EMIT_BYTE(evex_P >> 8);
+    EMIT_BYTE(evex_P >> 16);
+    EMIT_BYTE(opCode);
+  }
+
+  EMIT_BYTE(x86EncodeMod(3, opReg & 0x07, static_cast<uint32_t>(rmReg) & 0x07));
+
+  if (imLen == 0)
+    goto _EmitDone;
+
+  EMIT_BYTE(imVal & 0xFF);
+  goto _EmitDone;
+
+_EmitEvexM:
+  ASMJIT_ASSERT(rmMem != nullptr);
+  ASMJIT_ASSERT(rmMem->getOp() == Operand::kTypeMem);
+
+  if (rmMem->hasSegment()) {
+    EMIT_BYTE(x86SegmentPrefix[rmMem->getSegment()]);
+  }
+
+  mBase = rmMem->getBase();
+  mIndex = rmMem->getIndex();
+
+  {
+    EMIT_EVEX_PREFIX((static_cast<uint32_t>(mIndex - 8 < 8) << 6) |
+                     (static_cast<uint32_t>(mBase  - 8 < 8) << 5))
+
+    // SAE and embedded rounding are only allowed in register forms.
+    if ((options & (kX86InstOptionEvexSae | kX86EvexRoundingMask)) != 0)
+      goto _IllegalInst;
+
+    // Compressed displacement (disp8*N) - `N` is the element size if the
+    // memory operand is broadcasted or the instruction accesses only one
+    // element (Tuple1 Scalar), otherwise it's the whole vector length.
+    if ((options & kX86InstOptionEvexOneN) != 0) {
+      evex_P |= 0x100000;
+      dispShift = 2 + (opCode >> kX86InstOpCode_EW_Shift & 0x01);
+    }
+    else if (info.getEncoding() == kX86InstEncodingAvxRm_T1S ||
+             info.getEncoding() == kX86InstEncodingAvxMr_T1S) {
+      dispShift = 2 + (opCode >> kX86InstOpCode_EW_Shift & 0x01);
+    }
+    else {
+      dispShift = 4 + (opCode >> kX86InstOpCode_L_Shift & 0x03);
+    }
+
+    EMIT_BYTE(kX86ByteEvex);
+    EMIT_BYTE(evex_P);
+    EMIT_BYTE(evex_P >> 8);
+    EMIT_BYTE(evex_P >> 16);
+    EMIT_BYTE(opCode);
+  }
+
+  mBase &= 0x07;
+  opReg &= 0x07;
+  goto _EmitSib;
+
   // --------------------------------------------------------------------------
   // [Xop]
   // --------------------------------------------------------------------------
@@ -4174,7 +4831,7 @@ _EmitJmpOrCallAbs:
     RelocData rd;
     rd.type = kRelocAbsToRel;
     rd.size = 4;
-    rd.from = (intptr_t)(cursor - self->_buffer) + 1;
+    rd.from = (intptr_t)self->_getOffsetOf(cursor) + 1;
     rd.data = static_cast<SignedPtr>(imVal);
 
     uint32_t trampolineSize = 0;
@@ -4222,11 +4879,14 @@ _EmitDisplacement:
     // Chain with label.
     LabelLink* link = self->_newLabelLink();
     link->prev = label->links;
-    link->offset = (intptr_t)(cursor - self->_buffer);
+    link->offset = (intptr_t)self->_getOffsetOf(cursor);
     link->displacement = dispOffset;
     link->relocId = relocId;
     label->links = link;
 
+    if (relocId == -1)
+      ASMJIT_PROPAGATE_ERROR(self->_relaxRef(label, link->offset, dispSize, imLen));
+
     // Emit label size as dummy data.
     if (dispSize == 1)
       EMIT_BYTE(0x01);
@@ -4281,6 +4941,18 @@ _EmitDone:
 }
 
 Error X86Assembler::_emit(uint32_t code, const Operand& o0, const Operand& o1, const Operand& o2, const Operand& o3) {
+  if (hasAsmOption(kOptionStrictValidation)) {
+    Operand opList[4] = { o0, o1, o2, o3 };
+    const CpuInfo* cpuInfo = _runtime ? &_runtime->getCpuInfo() : static_cast<const CpuInfo*>(nullptr);
+
+    Error error = X86Util::validateInst(_arch, cpuInfo, code, _instOptions, opList, 4);
+    if (error != kErrorOk) {
+      _instOptions = 0;
+      _comment = nullptr;
+      return setLastError(error);
+    }
+  }
+
 #if defined(ASMJIT_BUILD_X86) && !defined(ASMJIT_BUILD_X64)
   ASMJIT_ASSERT(_arch == kArchX86);
   return X86Assembler_emit<kArchX86>(this, code, &o0, &o1, &o2, &o3);
@@ -4295,6 +4967,435 @@ Error X86Assembler::_emit(uint32_t code, const Operand& o0, const Operand& o1, c
 #endif
 }
 
+// ============================================================================
+// [asmjit::X86Assembler - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST)
+static void X86AssemblerTest_generate(X86Assembler& a, uint32_t count) noexcept {
+  // Forward jump patched after the code spans many chunks.
+  Label end = a.newLabel();
+
+  a.xor_(x86::eax, x86::eax);
+  a.test(x86::eax, x86::eax);
+  a.jnz(end);
+
+  for (uint32_t i = 0; i < count; i++) {
+    a.add(x86::eax, 1);
+
+    if ((i % 1000) == 0) {
+      static const uint8_t trap[3] = { 0xCC, 0xCC, 0xCC };
+      Label skip = a.newLabel();
+
+      a.jmp(skip);
+      a.embed(trap, ASMJIT_ARRAY_SIZE(trap));
+      a.bind(skip);
+    }
+  }
+
+  a.bind(end);
+  a.ret();
+}
+
+UNIT(x86_assembler_chunks) {
+  typedef int (*Func)(void);
+  static const uint32_t kCount = 100000;
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Assembler b(&runtime);
+
+  // `b` emits the whole code into a single chunk.
+  b._reserve(1024 * 1024);
+
+  INFO("Emitting %u instructions into a chunked code-buffer.", kCount);
+  X86AssemblerTest_generate(a, kCount);
+  X86AssemblerTest_generate(b, kCount);
+
+  size_t size = a.getOffset();
+  EXPECT(size == b.getOffset() && size > static_cast<size_t>(Assembler::kChunkSize),
+    "The code should span multiple chunks.");
+
+  uint8_t* codeA = static_cast<uint8_t*>(ASMJIT_ALLOC(size));
+  uint8_t* codeB = static_cast<uint8_t*>(ASMJIT_ALLOC(size));
+
+  a.copyCode(codeA, size);
+  b.copyCode(codeB, size);
+
+  EXPECT(::memcmp(codeA, codeB, size) == 0,
+    "Chunked and contiguous code-buffers should contain the same code.");
+
+  ASMJIT_FREE(codeA);
+  ASMJIT_FREE(codeB);
+
+  Func func = asmjit_cast<Func>(a.make());
+  EXPECT(func != nullptr,
+    "Couldn't relocate the chunked code-buffer.");
+
+  int result = func();
+  EXPECT(result == static_cast<int>(kCount),
+    "Function returned %d instead of %u.", result, kCount);
+  runtime.release((void*)func);
+}
+
+UNIT(x86_assembler_rodata) {
+  typedef int (*Func)(void);
+  static const int32_t kValues[2] = { 1000, 234 };
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+
+  Label bound = a.newLabel();
+  Label unbound = a.newLabel();
+
+  // `bound` is bound before it's used and `unbound` after.
+  EXPECT(a.embedRoData(bound, &kValues[0], 4, 4) == kErrorOk,
+    "Couldn't embed data to .rodata.");
+
+  a.mov(x86::eax, x86::dword_ptr(bound));
+  a.add(x86::eax, x86::dword_ptr(unbound));
+  a.ret();
+
+  EXPECT(a.embedRoData(unbound, &kValues[1], 4, 32) == kErrorOk,
+    "Couldn't embed data to .rodata.");
+
+  size_t roDataOffset = a.getRoDataOffset();
+  EXPECT(roDataOffset >= a.getOffset() && (roDataOffset % 32) == 0,
+    ".rodata should follow .text aligned to 32 bytes, not at %u.", static_cast<unsigned int>(roDataOffset));
+  EXPECT(a.getCodeSize() == roDataOffset + 36,
+    "Code size should include .rodata.");
+
+  Func func = asmjit_cast<Func>(a.make());
+  EXPECT(func != nullptr,
+    "Couldn't relocate the code.");
+
+  int result = func();
+  EXPECT(result == 1234,
+    "Function returned %d instead of 1234.", result);
+  runtime.release((void*)func);
+}
+
+static void X86AssemblerTest_generateRelax(X86Assembler& a) noexcept {
+  Label L_Skip = a.newLabel();
+  Label L_Loop = a.newLabel();
+  Label L_End = a.newLabel();
+  Label L_Far = a.newLabel();
+  Label L_Func = a.newLabel();
+  Label L_Data = a.newLabel();
+  Label L_RoData = a.newLabel();
+
+  // Sum of 1...10 (55) through forward and backward jumps.
+  a.xor_(x86::eax, x86::eax);
+  a.mov(x86::ecx, 10);
+  a.jmp(L_Skip);
+  a.int3();
+
+  a.align(kAlignCode, 16);
+  a.bind(L_Skip);
+  a.bind(L_Loop);
+  a.add(x86::eax, x86::ecx);
+  a.dec(x86::ecx);
+  a.jz(L_End);
+  a.jmp(L_Loop);
+  a.bind(L_End);
+
+  // +100 by a call, +1000 from .text and +10000 from .rodata.
+  a.call(L_Func);
+  a.add(x86::eax, x86::dword_ptr(L_Data));
+  a.add(x86::eax, x86::dword_ptr(L_RoData));
+
+  // Too far to be relaxed.
+  a.test(x86::eax, x86::eax);
+  a.jnz(L_Far);
+  a.int3();
+  for (uint32_t i = 0; i < 200; i++)
+    a.nop();
+  a.bind(L_Far);
+  a.ret();
+
+  a.bind(L_Func);
+  a.add(x86::eax, 100);
+  a.ret();
+
+  static const int32_t kRoData = 10000;
+  a.embedRoData(L_RoData, &kRoData, 4, 4);
+
+  a.align(kAlignData, 4);
+  a.bind(L_Data);
+  a.dd(1000);
+}
+
+UNIT(x86_assembler_relax) {
+  typedef int (*Func)(void);
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Assembler b(&runtime);
+
+  // Only `a` relaxes jumps.
+  a.addAsmOptions(Assembler::kOptionRelaxJumps);
+  X86AssemblerTest_generateRelax(a);
+  X86AssemblerTest_generateRelax(b);
+
+  size_t size = b.getCodeSize();
+  EXPECT(a.getCodeSize() == size,
+    "Code size shouldn't change before relax().");
+
+  EXPECT(a.relax() == kErrorOk,
+    "Relaxation failed.");
+
+  // `jmp L_Skip` and `jz L_End` save 3 and 4 bytes, but the alignment that
+  // follows `jmp L_Skip` may absorb some of them.
+  INFO("Code size %u -> %u bytes.",
+    static_cast<unsigned int>(size),
+    static_cast<unsigned int>(a.getCodeSize()));
+  EXPECT(a.getCodeSize() < size,
+    "Relaxed code should be smaller.");
+
+  Func fa = asmjit_cast<Func>(a.make());
+  Func fb = asmjit_cast<Func>(b.make());
+  EXPECT(fa != nullptr && fb != nullptr,
+    "Couldn't relocate the code.");
+
+  int ra = fa();
+  int rb = fb();
+  EXPECT(ra == 11155 && rb == 11155,
+    "Functions returned %d and %d instead of 11155.", ra, rb);
+
+  runtime.release((void*)fa);
+  runtime.release((void*)fb);
+}
+
+UNIT(x86_assembler_add_batch) {
+  typedef int (*Func)(void);
+  enum { kCount = 5 };
+
+  JitRuntime runtime;
+  X86Assembler a0(&runtime), a1(&runtime), a2(&runtime), a3(&runtime), a4(&runtime);
+
+  Assembler* a[kCount] = { &a0, &a1, &a2, &a3, &a4 };
+  void* p[kCount];
+  uint32_t i;
+
+  for (i = 0; i < kCount; i++) {
+    X86Assembler* x = static_cast<X86Assembler*>(a[i]);
+    x->mov(x86::eax, static_cast<int>(i * 7 + 1));
+    x->ret();
+  }
+
+  EXPECT(runtime.addBatch(p, a, kCount) == kErrorOk,
+    "Couldn't add the batch.");
+
+  for (i = 0; i < kCount; i++) {
+    EXPECT(p[i] != nullptr,
+      "Function #%u wasn't added.", i);
+    EXPECT(((uintptr_t)p[i] & 63) == 0,
+      "Function #%u isn't aligned to 64 bytes.", i);
+
+    if (i != 0) {
+      EXPECT((uintptr_t)p[i] > (uintptr_t)p[i - 1],
+        "Function #%u isn't placed after function #%u.", i, i - 1);
+    }
+
+    int result = asmjit_cast<Func>(p[i])();
+    EXPECT(result == static_cast<int>(i * 7 + 1),
+      "Function #%u returned %d instead of %d.", i, result, static_cast<int>(i * 7 + 1));
+  }
+
+  for (i = 0; i < kCount; i++)
+    EXPECT(runtime.release(p[i]) == kErrorOk,
+      "Couldn't release function #%u.", i);
+
+  // A batch that contains an assembler without code fails as a whole.
+  a[2]->reset();
+  for (i = 0; i < kCount; i++)
+    p[i] = (void*)&runtime;
+
+  EXPECT(runtime.addBatch(p, a, kCount) == kErrorNoCodeGenerated,
+    "Batch with an empty function should fail with kErrorNoCodeGenerated.");
+
+  for (i = 0; i < kCount; i++)
+    EXPECT(p[i] == nullptr,
+      "Function #%u should be nullptr after a failed batch.", i);
+}
+
+// Emits the same instructions either through the `X86Assembler` intrinsics,
+// which use the fast path if possible, or through the generic `emit()`.
+#define X86_FAST_2(inst, id, o0, o1) \
+  do { \
+    if (generic) \
+      a.emit(kX86InstId##id, o0, o1); \
+    else \
+      a.inst(o0, o1); \
+  } while (0)
+
+static void X86AssemblerTest_generateFast(X86Assembler& a, bool generic) noexcept {
+  using namespace x86;
+  bool is64 = a.getArch() == kArchX64;
+
+  X86GpReg gp[] = {
+    eax, ecx, esp, ebp, edi, ax, si,
+    is64 ? rax : eax, is64 ? rsp : esp, is64 ? r8 : edx, is64 ? r12d : ebx,
+    is64 ? r13 : ebp, is64 ? r15w : di, al, cl
+  };
+
+  X86XmmReg xmm[] = {
+    xmm0, xmm1, xmm4, xmm5, xmm7,
+    is64 ? xmm8 : xmm2, is64 ? xmm12 : xmm3, is64 ? xmm15 : xmm6
+  };
+
+  const X86GpReg& zsp = a.zsp;
+  const X86GpReg& zbp = a.zbp;
+  const X86GpReg& zsi = a.zsi;
+  const X86GpReg& zdi = a.zdi;
+  const X86GpReg& rX = is64 ? r12 : a.zbx;
+  const X86GpReg& rY = is64 ? r13 : a.zdx;
+
+  Label L = a.newLabel();
+  X86Mem mem[] = {
+    ptr(a.zax), ptr(zsp), ptr(zbp), ptr(rX), ptr(rY),
+    ptr(zsi, 8), ptr(zsp, -128), ptr(zbp, 127), ptr(rY, 0x1000), ptr(rX, -0x12345),
+    ptr(zsi, zdi), ptr(zsp, zbp, 3), ptr(zbp, zsi, 1, 16), ptr(rX, rY, 2, -0x8000),
+    ptr(L), ptr(zsi)
+  };
+  mem[ASMJIT_ARRAY_SIZE(mem) - 1].setSegment(fs);
+
+  int64_t imm[] = {
+    0, 1, 2, -1, 127, -128, 128, 0x7FFF, 0x12345, -0x12345, 0x7FFFFFFF
+  };
+
+  for (size_t i = 0; i < ASMJIT_ARRAY_SIZE(gp); i++) {
+    const X86GpReg& r = gp[i];
+
+    for (size_t j = 0; j < ASMJIT_ARRAY_SIZE(gp); j++) {
+      if (gp[j].getSize() != r.getSize())
+        continue;
+
+      X86_FAST_2(add , Add , r, gp[j]);
+      X86_FAST_2(xor_, Xor , r, gp[j]);
+      X86_FAST_2(mov , Mov , r, gp[j]);
+      X86_FAST_2(test, Test, r, gp[j]);
+      if (r.getSize() != 1)
+        X86_FAST_2(imul, Imul, r, gp[j]);
+    }
+
+    for (size_t j = 0; j < ASMJIT_ARRAY_SIZE(mem); j++) {
+      X86_FAST_2(sub , Sub , r, mem[j]);
+      X86_FAST_2(cmp , Cmp , mem[j], r);
+      X86_FAST_2(mov , Mov , r, mem[j]);
+      X86_FAST_2(mov , Mov , mem[j], r);
+      if (r.getSize() != 1) {
+        X86_FAST_2(lea , Lea , r, mem[j]);
+        X86_FAST_2(imul, Imul, r, mem[j]);
+      }
+    }
+
+    for (size_t j = 0; j < ASMJIT_ARRAY_SIZE(imm); j++) {
+      int64_t v = imm[j];
+
+      X86_FAST_2(adc , Adc , r, v);
+      X86_FAST_2(add , Add , r, v);
+      X86_FAST_2(and_, And , r, v);
+      X86_FAST_2(cmp , Cmp , r, v);
+      X86_FAST_2(or_ , Or  , r, v);
+      X86_FAST_2(sbb , Sbb , r, v);
+      X86_FAST_2(sub , Sub , r, v);
+      X86_FAST_2(xor_, Xor , r, v);
+      X86_FAST_2(mov , Mov , r, v);
+      X86_FAST_2(test, Test, r, v);
+      X86_FAST_2(shl , Shl , r, v);
+      X86_FAST_2(sar , Sar , r, v);
+      X86_FAST_2(rol , Rol , r, v);
+    }
+
+    if (is64 && r.getSize() == 8)
+      X86_FAST_2(mov , Mov , r, static_cast<int64_t>(ASMJIT_UINT64_C(0x123456789A)));
+  }
+
+  for (size_t i = 0; i < ASMJIT_ARRAY_SIZE(xmm); i++) {
+    const X86XmmReg& r = xmm[i];
+
+    for (size_t j = 0; j < ASMJIT_ARRAY_SIZE(xmm); j++) {
+      X86_FAST_2(addps  , Addps  , r, xmm[j]);
+      X86_FAST_2(mulsd  , Mulsd  , r, xmm[j]);
+      X86_FAST_2(sqrtss , Sqrtss , r, xmm[j]);
+      X86_FAST_2(pmulld , Pmulld , r, xmm[j]);
+      X86_FAST_2(paddd  , Paddd  , r, xmm[j]);
+      X86_FAST_2(pxor   , Pxor   , r, xmm[j]);
+      X86_FAST_2(movaps , Movaps , r, xmm[j]);
+      X86_FAST_2(movsd  , Movsd  , r, xmm[j]);
+    }
+
+    for (size_t j = 0; j < ASMJIT_ARRAY_SIZE(mem); j++) {
+      X86_FAST_2(divpd  , Divpd  , r, mem[j]);
+      X86_FAST_2(ucomiss, Ucomiss, r, mem[j]);
+      X86_FAST_2(pcmpgtd, Pcmpgtd, r, mem[j]);
+      X86_FAST_2(movdqu , Movdqu , r, mem[j]);
+      X86_FAST_2(movdqu , Movdqu , mem[j], r);
+      X86_FAST_2(movss  , Movss  , mem[j], r);
+    }
+  }
+
+  // Instruction options are handled by the generic path.
+  a.lock();
+  X86_FAST_2(add, Add, ptr(zsi), a.zax);
+
+  a.bind(L);
+}
+
+#undef X86_FAST_2
+
+UNIT(x86_assembler_fast) {
+  static const uint32_t archList[] = {
+#if defined(ASMJIT_BUILD_X86)
+    kArchX86,
+#endif // ASMJIT_BUILD_X86
+#if defined(ASMJIT_BUILD_X64)
+    kArchX64
+#endif // ASMJIT_BUILD_X64
+  };
+  JitRuntime runtime;
+
+  for (size_t i = 0; i < ASMJIT_ARRAY_SIZE(archList); i++) {
+    uint32_t arch = archList[i];
+
+    X86Assembler a(&runtime, arch);
+    X86Assembler b(&runtime, arch);
+
+    // Repeat enough times to cross code-buffer chunks, where the fast path
+    // has to fall back to the generic path to grow the buffer.
+    for (uint32_t n = 0; n < 4; n++) {
+      X86AssemblerTest_generateFast(a, false);
+      X86AssemblerTest_generateFast(b, true);
+    }
+
+    size_t size = a.getOffset();
+    INFO("Emitted %u bytes (%s).", static_cast<unsigned int>(size), arch == kArchX86 ? "X86" : "X64");
+
+    EXPECT(size == b.getOffset(),
+      "Fast and generic paths emitted %u and %u bytes.",
+      static_cast<unsigned int>(size),
+      static_cast<unsigned int>(b.getOffset()));
+
+    uint8_t* codeA = static_cast<uint8_t*>(ASMJIT_ALLOC(size));
+    uint8_t* codeB = static_cast<uint8_t*>(ASMJIT_ALLOC(size));
+
+    a.copyCode(codeA, size);
+    b.copyCode(codeB, size);
+
+    size_t pos = 0;
+    while (pos < size && codeA[pos] == codeB[pos])
+      pos++;
+
+    EXPECT(pos == size,
+      "Fast and generic paths differ at offset %u.", static_cast<unsigned int>(pos));
+
+    ASMJIT_FREE(codeA);
+    ASMJIT_FREE(codeB);
+  }
+}
+#endif // ASMJIT_TEST
+
 } // asmjit namespace
 
 // [Api-End]
@@ -75,6 +75,13 @@ namespace asmjit {
     return *this; \
   } \
   \
+  /*! Use opmask register `kreg` to merge or zero elements (AVX512+). */ \
+  ASMJIT_INLINE T& k(const X86KReg& kreg) noexcept { \
+    _instOptions = (_instOptions & ~static_cast<uint32_t>(kX86InstOptionEvexK)) | \
+                   (static_cast<uint32_t>(kreg.getRegIndex()) << kX86InstOptionEvexKShift); \
+    return *this; \
+  } \
+  \
   /*! Use zeroing instead of merging (AVX512+). */ \
   ASMJIT_INLINE T& z() noexcept { \
     _instOptions |= kX86InstOptionEvexZero; \
@@ -500,12 +507,380 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
 
   ASMJIT_API virtual size_t _relocCode(void* dst, Ptr baseAddress) const noexcept;
 
+  // --------------------------------------------------------------------------
+  // [Relax]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_API virtual Error _relax() noexcept;
+
   // --------------------------------------------------------------------------
   // [Emit]
   // --------------------------------------------------------------------------
 
   ASMJIT_API virtual Error _emit(uint32_t code, const Operand& o0, const Operand& o1, const Operand& o2, const Operand& o3);
 
+  // --------------------------------------------------------------------------
+  // [Fast Path]
+  // --------------------------------------------------------------------------
+
+  //! \internal
+  //!
+  //! Get whether the next instruction can be encoded by the fast path.
+  //!
+  //! The hottest instructions (GP arithmetic, MOV, LEA, shifts, and SSE
+  //! arithmetic and moves) are encoded inline by `_emitFast...()` helpers
+  //! without going through `Assembler::_emit()`. This is only possible if
+  //! there is no logger attached, no instruction option has been set, strict
+  //! validation is disabled, and the current chunk of the code-buffer has
+  //! room for the longest encoding. The generic path is used if any of these
+  //! doesn't hold, or if an operand is not supported by the fast path.
+  ASMJIT_INLINE bool _canEmitFast() const noexcept {
+    return (reinterpret_cast<uintptr_t>(_logger) | _instOptions | (_asmOptions & kOptionStrictValidation)) == 0 &&
+           static_cast<size_t>(_end - _cursor) >= 16;
+  }
+
+  //! \internal
+  //!
+  //! Get whether GP register `reg` is supported by the fast path (not 8-bit,
+  //! and encodable without REX in 32-bit mode).
+  ASMJIT_INLINE bool _isFastGp(const X86GpReg& reg) const noexcept {
+    return reg.getSize() != 1 && ((reg.getRegIndex() | (reg.getSize() & 0x8)) < 8 || _arch == kArchX64);
+  }
+
+  //! \internal
+  //!
+  //! Get whether XMM register `reg` is supported by the fast path.
+  ASMJIT_INLINE bool _isFastXmm(const X86XmmReg& reg) const noexcept {
+    return reg.getRegIndex() < 8 || (reg.getRegIndex() < 16 && _arch == kArchX64);
+  }
+
+  //! \internal
+  //!
+  //! Get whether memory operand `mem` is supported by the fast path, which
+  //! is `[base + index * scale + disp]` using the native address size and no
+  //! segment override.
+  ASMJIT_INLINE bool _isFastMem(const X86Mem& mem) const noexcept {
+    uint32_t regs = mem.getBase() | (mem.hasIndex() ? mem.getIndex() : 0);
+
+    return mem.isBaseIndexType() && mem.hasBase() && !mem.hasSegment() &&
+           mem.getVSib() == kX86MemVSibGpz &&
+           mem.hasGpdBase() == (_arch == kArchX86) &&
+           (regs < 8 || (regs < 16 && _arch == kArchX64)) &&
+           (!mem.hasIndex() || (mem.getIndex() & 0x7) != kX86RegIndexSp);
+  }
+
+  //! \internal
+  //!
+  //! Add operand-size prefix and REX.W to `opCode` based on the size of `reg`.
+  static ASMJIT_INLINE uint32_t _fastGpOpCode(const X86GpReg& reg, uint32_t opCode) noexcept {
+    uint32_t size = reg.getSize();
+    return opCode | ((size & 0x2) << (kX86InstOpCode_PP_Shift - 1))
+                  | ((size & 0x8) << (kX86InstOpCode_W_Shift - 3));
+  }
+
+  //! \internal
+  //!
+  //! Emit mandatory prefix, REX prefix (`rex` contains R, X, and B bits), and
+  //! opcode of `opCode`.
+  static ASMJIT_INLINE uint8_t* _emitFastOpCode(uint8_t* cursor, uint32_t opCode, uint32_t rex) noexcept {
+    uint32_t pp = (opCode >> kX86InstOpCode_PP_Shift) & 0x3;
+    uint32_t mm = (opCode >> kX86InstOpCode_MM_Shift) & 0x3;
+
+    // 66, F3, and F2 prefixes (no prefix if `pp` is zero).
+    if (pp != 0)
+      *cursor++ = static_cast<uint8_t>(0xF2F36600U >> (pp * 8));
+
+    rex |= (opCode >> (kX86InstOpCode_W_Shift - 3)) & 0x8;
+    if (rex != 0)
+      *cursor++ = static_cast<uint8_t>(0x40 | rex);
+
+    // 0F, 0F38, and 0F3A opcode maps.
+    if (mm != 0) {
+      *cursor++ = 0x0F;
+      if (mm != 1)
+        *cursor++ = static_cast<uint8_t>(mm == 2 ? 0x38 : 0x3A);
+    }
+
+    *cursor++ = static_cast<uint8_t>(opCode);
+    return cursor;
+  }
+
+  //! \internal
+  //!
+  //! Emit the immediate value and commit the instruction ending at `cursor`.
+  ASMJIT_INLINE Error _emitFastDone(uint8_t* cursor, int64_t imVal, uint32_t imLen) noexcept {
+    switch (imLen) {
+      case 1: Utils::writeU8(cursor, static_cast<uint32_t>(imVal & 0xFF)); break;
+      case 2: Utils::writeU16u(cursor, static_cast<uint32_t>(imVal & 0xFFFF)); break;
+      case 4: Utils::writeU32u(cursor, static_cast<uint32_t>(imVal & 0xFFFFFFFF)); break;
+      case 8: Utils::writeU64u(cursor, static_cast<uint64_t>(imVal)); break;
+    }
+
+    _cursor = cursor + imLen;
+    _comment = nullptr;
+    return kErrorOk;
+  }
+
+  //! \internal
+  //!
+  //! Emit `opCode` with register `opReg` and ModR/M register `rmReg`.
+  ASMJIT_INLINE Error _emitFastR(uint32_t opCode, uint32_t opReg, uint32_t rmReg, int64_t imVal = 0, uint32_t imLen = 0) noexcept {
+    uint8_t* cursor = _emitFastOpCode(_cursor, opCode, ((opReg & 0x8) >> 1) | (rmReg >> 3));
+    *cursor++ = static_cast<uint8_t>(0xC0 | ((opReg & 0x7) << 3) | (rmReg & 0x7));
+    return _emitFastDone(cursor, imVal, imLen);
+  }
+
+  //! \internal
+  //!
+  //! Emit `opCode` with register `opReg` and ModR/M memory operand `mem`,
+  //! which has to be checked by `_isFastMem()`.
+  ASMJIT_INLINE Error _emitFastM(uint32_t opCode, uint32_t opReg, const X86Mem& mem) noexcept {
+    uint32_t base = mem.getBase();
+    uint32_t index = mem.hasIndex() ? mem.getIndex() : 0;
+    int32_t disp = mem.getDisplacement();
+
+    uint8_t* cursor = _emitFastOpCode(_cursor, opCode, ((opReg & 0x8) >> 1) | ((index & 0x8) >> 2) | (base >> 3));
+    base &= 0x7;
+
+    // Disp8 is used if the displacement fits, [EBP/RBP/R13] requires it.
+    uint32_t mod = (disp == 0 && base != kX86RegIndexBp) ? 0 : Utils::isInt8(disp) ? 1 : 2;
+    opReg = (mod << 6) | ((opReg & 0x7) << 3);
+
+    if (mem.hasIndex()) {
+      *cursor++ = static_cast<uint8_t>(opReg | 0x04);
+      *cursor++ = static_cast<uint8_t>((mem.getShift() << 6) | ((index & 0x7) << 3) | base);
+    }
+    else if (base == kX86RegIndexSp) {
+      *cursor++ = static_cast<uint8_t>(opReg | 0x04);
+      *cursor++ = static_cast<uint8_t>(0x24);
+    }
+    else {
+      *cursor++ = static_cast<uint8_t>(opReg | base);
+    }
+
+    if (mod == 1)
+      *cursor++ = static_cast<uint8_t>(disp & 0xFF);
+    else if (mod == 2)
+      Utils::writeI32u(cursor, disp), cursor += 4;
+
+    return _emitFastDone(cursor, 0, 0);
+  }
+
+  //! \internal
+  //!
+  //! ADC, ADD, AND, CMP, OR, SBB, SUB, XOR (the table contains the base
+  //! opcode and ModR/M `/r` used by the immediate form).
+  ASMJIT_INLINE Error _emitFastArith(uint32_t code, const X86GpReg& o0, const X86GpReg& o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0) || !_isFastGp(o1))
+      return emit(code, o0, o1);
+
+    uint32_t opCode = (_x86InstInfo[code].getPrimaryOpCode() & 0xFF) + 3;
+    return _emitFastR(_fastGpOpCode(o0, opCode), o0.getRegIndex(), o1.getRegIndex());
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastArith(uint32_t code, const X86GpReg& o0, const X86Mem& o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0) || !_isFastMem(o1))
+      return emit(code, o0, o1);
+
+    uint32_t opCode = (_x86InstInfo[code].getPrimaryOpCode() & 0xFF) + 3;
+    return _emitFastM(_fastGpOpCode(o0, opCode), o0.getRegIndex(), o1);
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastArith(uint32_t code, const X86Mem& o0, const X86GpReg& o1) noexcept {
+    if (!_canEmitFast() || !_isFastMem(o0) || !_isFastGp(o1))
+      return emit(code, o0, o1);
+
+    uint32_t opCode = (_x86InstInfo[code].getPrimaryOpCode() & 0xFF) + 1;
+    return _emitFastM(_fastGpOpCode(o1, opCode), o1.getRegIndex(), o0);
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastArith(uint32_t code, const X86GpReg& o0, int64_t o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0))
+      return emit(code, o0, o1);
+
+    uint32_t opReg = (_x86InstInfo[code].getPrimaryOpCode() >> kX86InstOpCode_O_Shift) & 0x7;
+    uint32_t rmReg = o0.getRegIndex();
+    uint32_t imLen = Utils::isInt8(o1) ? 1 : Utils::iMin<uint32_t>(o0.getSize(), 4);
+
+    // Alternate form - AX, EAX, RAX.
+    if (rmReg == 0 && imLen != 1) {
+      uint8_t* cursor = _emitFastOpCode(_cursor, _fastGpOpCode(o0, (opReg << 3) | 0x05), 0);
+      return _emitFastDone(cursor, o1, imLen);
+    }
+
+    return _emitFastR(_fastGpOpCode(o0, imLen != 1 ? 0x81 : 0x83), opReg, rmReg, o1, imLen);
+  }
+
+  //! \internal
+  //!
+  //! MOV.
+  ASMJIT_INLINE Error _emitFastMov(uint32_t code, const X86GpReg& o0, const X86GpReg& o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0) || !_isFastGp(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastR(_fastGpOpCode(o0, 0x8B), o0.getRegIndex(), o1.getRegIndex());
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastMov(uint32_t code, const X86GpReg& o0, const X86Mem& o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0) || !_isFastMem(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastM(_fastGpOpCode(o0, 0x8B), o0.getRegIndex(), o1);
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastMov(uint32_t code, const X86Mem& o0, const X86GpReg& o1) noexcept {
+    if (!_canEmitFast() || !_isFastMem(o0) || !_isFastGp(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastM(_fastGpOpCode(o1, 0x89), o1.getRegIndex(), o0);
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastMov(uint32_t code, const X86GpReg& o0, int64_t o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0))
+      return emit(code, o0, o1);
+
+    // Use sign-extended 32-bit immediate if possible.
+    uint32_t size = o0.getSize();
+    if (size == 8 && Utils::isInt32(o1))
+      return _emitFastR(_fastGpOpCode(o0, 0xC7), 0, o0.getRegIndex(), o1, 4);
+
+    uint32_t index = o0.getRegIndex();
+    uint8_t* cursor = _emitFastOpCode(_cursor, _fastGpOpCode(o0, 0xB8 + (index & 0x7)), index >> 3);
+    return _emitFastDone(cursor, o1, size);
+  }
+
+  //! \internal
+  //!
+  //! TEST.
+  ASMJIT_INLINE Error _emitFastTest(uint32_t code, const X86GpReg& o0, const X86GpReg& o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0) || !_isFastGp(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastR(_fastGpOpCode(o0, 0x85), o1.getRegIndex(), o0.getRegIndex());
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastTest(uint32_t code, const X86GpReg& o0, int64_t o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0))
+      return emit(code, o0, o1);
+
+    uint32_t rmReg = o0.getRegIndex();
+    uint32_t imLen = Utils::iMin<uint32_t>(o0.getSize(), 4);
+
+    // Alternate form - AX, EAX, RAX.
+    if (rmReg == 0) {
+      uint8_t* cursor = _emitFastOpCode(_cursor, _fastGpOpCode(o0, 0xA9), 0);
+      return _emitFastDone(cursor, o1, imLen);
+    }
+
+    return _emitFastR(_fastGpOpCode(o0, 0xF7), 0, rmReg, o1, imLen);
+  }
+
+  //! \internal
+  //!
+  //! LEA.
+  ASMJIT_INLINE Error _emitFastLea(uint32_t code, const X86GpReg& o0, const X86Mem& o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0) || !_isFastMem(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastM(_fastGpOpCode(o0, 0x8D), o0.getRegIndex(), o1);
+  }
+
+  //! \internal
+  //!
+  //! IMUL (two operand form).
+  ASMJIT_INLINE Error _emitFastImul(uint32_t code, const X86GpReg& o0, const X86GpReg& o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0) || !_isFastGp(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastR(_fastGpOpCode(o0, kX86InstOpCode_MM_0F | 0xAF), o0.getRegIndex(), o1.getRegIndex());
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastImul(uint32_t code, const X86GpReg& o0, const X86Mem& o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0) || !_isFastMem(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastM(_fastGpOpCode(o0, kX86InstOpCode_MM_0F | 0xAF), o0.getRegIndex(), o1);
+  }
+
+  //! \internal
+  //!
+  //! RCL, RCR, ROL, ROR, SAL, SAR, SHL, SHR (immediate form).
+  ASMJIT_INLINE Error _emitFastRot(uint32_t code, const X86GpReg& o0, int64_t o1) noexcept {
+    if (!_canEmitFast() || !_isFastGp(o0))
+      return emit(code, o0, o1);
+
+    uint32_t opReg = (_x86InstInfo[code].getPrimaryOpCode() >> kX86InstOpCode_O_Shift) & 0x7;
+    uint32_t imLen = (o1 & 0xFF) != 1;
+
+    return _emitFastR(_fastGpOpCode(o0, imLen ? 0xC1 : 0xD1), opReg, o0.getRegIndex(), o1, imLen);
+  }
+
+  //! \internal
+  //!
+  //! SSE instructions using `xmm, xmm/mem` form, the table contains the whole
+  //! opcode including the mandatory prefix.
+  ASMJIT_INLINE Error _emitFastSimd(uint32_t code, const X86XmmReg& o0, const X86XmmReg& o1) noexcept {
+    if (!_canEmitFast() || !_isFastXmm(o0) || !_isFastXmm(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastR(_x86InstInfo[code].getPrimaryOpCode(), o0.getRegIndex(), o1.getRegIndex());
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastSimd(uint32_t code, const X86XmmReg& o0, const X86Mem& o1) noexcept {
+    if (!_canEmitFast() || !_isFastXmm(o0) || !_isFastMem(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastM(_x86InstInfo[code].getPrimaryOpCode(), o0.getRegIndex(), o1);
+  }
+
+  //! \internal
+  //!
+  //! MMX/SSE2 instructions using `xmm, xmm/mem` form, the 66 prefix selects
+  //! the XMM version.
+  ASMJIT_INLINE Error _emitFastSimdP(uint32_t code, const X86XmmReg& o0, const X86XmmReg& o1) noexcept {
+    if (!_canEmitFast() || !_isFastXmm(o0) || !_isFastXmm(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastR(_x86InstInfo[code].getPrimaryOpCode() | kX86InstOpCode_PP_66, o0.getRegIndex(), o1.getRegIndex());
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastSimdP(uint32_t code, const X86XmmReg& o0, const X86Mem& o1) noexcept {
+    if (!_canEmitFast() || !_isFastXmm(o0) || !_isFastMem(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastM(_x86InstInfo[code].getPrimaryOpCode() | kX86InstOpCode_PP_66, o0.getRegIndex(), o1);
+  }
+
+  //! \internal
+  //!
+  //! SSE moves, the store form uses the secondary opcode.
+  ASMJIT_INLINE Error _emitFastSimdMov(uint32_t code, const X86XmmReg& o0, const X86XmmReg& o1) noexcept {
+    return _emitFastSimd(code, o0, o1);
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastSimdMov(uint32_t code, const X86XmmReg& o0, const X86Mem& o1) noexcept {
+    return _emitFastSimd(code, o0, o1);
+  }
+
+  //! \overload
+  ASMJIT_INLINE Error _emitFastSimdMov(uint32_t code, const X86Mem& o0, const X86XmmReg& o1) noexcept {
+    if (!_canEmitFast() || !_isFastMem(o0) || !_isFastXmm(o1))
+      return emit(code, o0, o1);
+
+    return _emitFastM(_x86InstInfo[code].getExtendedInfo().getSecondaryOpCode(), o1.getRegIndex(), o0);
+  }
+
   // -------------------------------------------------------------------------
   // [Options]
   // -------------------------------------------------------------------------
@@ -613,6 +988,28 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   /*! \overload */ \
   ASMJIT_INLINE Error inst(const T0& o0, uint64_t o1) { return emit(code, o0, Utils::asInt(o1)); }
 
+//! \internal
+//!
+//! Like `INST_2x`, but encoded by `_Fast_` family if possible.
+#define INST_2f(inst, code, _Fast_, T0, T1) \
+  ASMJIT_INLINE Error inst(const T0& o0, const T1& o1) { \
+    return _Fast_(code, o0, o1); \
+  }
+
+//! \internal
+//!
+//! Like `INST_2i` (immediate only), but encoded by `_Fast_` family if possible.
+#define INST_2fi(inst, code, _Fast_, T0) \
+  ASMJIT_INLINE Error inst(const T0& o0, const Imm& o1) { return _Fast_(code, o0, o1.getInt64()); } \
+  /*! \overload */ \
+  ASMJIT_INLINE Error inst(const T0& o0, int o1) { return _Fast_(code, o0, Utils::asInt(o1)); } \
+  /*! \overload */ \
+  ASMJIT_INLINE Error inst(const T0& o0, unsigned int o1) { return _Fast_(code, o0, Utils::asInt(o1)); } \
+  /*! \overload */ \
+  ASMJIT_INLINE Error inst(const T0& o0, int64_t o1) { return _Fast_(code, o0, Utils::asInt(o1)); } \
+  /*! \overload */ \
+  ASMJIT_INLINE Error inst(const T0& o0, uint64_t o1) { return _Fast_(code, o0, Utils::asInt(o1)); }
+
 #define INST_2cc(inst, code, _Translate_, T0, T1) \
   ASMJIT_INLINE Error inst(uint32_t cc, const T0& o0, const T1& o1) { \
     return emit(_Translate_(cc), o0, o1); \
@@ -704,35 +1101,35 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   // --------------------------------------------------------------------------
 
   //! Add with Carry.
-  INST_2x(adc, kX86InstIdAdc, X86GpReg, X86GpReg)
+  INST_2f(adc, kX86InstIdAdc, _emitFastArith, X86GpReg, X86GpReg)
   //! \overload
-  INST_2x(adc, kX86InstIdAdc, X86GpReg, X86Mem)
+  INST_2f(adc, kX86InstIdAdc, _emitFastArith, X86GpReg, X86Mem)
   //! \overload
-  INST_2i(adc, kX86InstIdAdc, X86GpReg, Imm)
+  INST_2fi(adc, kX86InstIdAdc, _emitFastArith, X86GpReg)
   //! \overload
-  INST_2x(adc, kX86InstIdAdc, X86Mem, X86GpReg)
+  INST_2f(adc, kX86InstIdAdc, _emitFastArith, X86Mem, X86GpReg)
   //! \overload
   INST_2i(adc, kX86InstIdAdc, X86Mem, Imm)
 
   //! Add.
-  INST_2x(add, kX86InstIdAdd, X86GpReg, X86GpReg)
+  INST_2f(add, kX86InstIdAdd, _emitFastArith, X86GpReg, X86GpReg)
   //! \overload
-  INST_2x(add, kX86InstIdAdd, X86GpReg, X86Mem)
+  INST_2f(add, kX86InstIdAdd, _emitFastArith, X86GpReg, X86Mem)
   //! \overload
-  INST_2i(add, kX86InstIdAdd, X86GpReg, Imm)
+  INST_2fi(add, kX86InstIdAdd, _emitFastArith, X86GpReg)
   //! \overload
-  INST_2x(add, kX86InstIdAdd, X86Mem, X86GpReg)
+  INST_2f(add, kX86InstIdAdd, _emitFastArith, X86Mem, X86GpReg)
   //! \overload
   INST_2i(add, kX86InstIdAdd, X86Mem, Imm)
 
   //! And.
-  INST_2x(and_, kX86InstIdAnd, X86GpReg, X86GpReg)
+  INST_2f(and_, kX86InstIdAnd, _emitFastArith, X86GpReg, X86GpReg)
   //! \overload
-  INST_2x(and_, kX86InstIdAnd, X86GpReg, X86Mem)
+  INST_2f(and_, kX86InstIdAnd, _emitFastArith, X86GpReg, X86Mem)
   //! \overload
-  INST_2i(and_, kX86InstIdAnd, X86GpReg, Imm)
+  INST_2fi(and_, kX86InstIdAnd, _emitFastArith, X86GpReg)
   //! \overload
-  INST_2x(and_, kX86InstIdAnd, X86Mem, X86GpReg)
+  INST_2f(and_, kX86InstIdAnd, _emitFastArith, X86Mem, X86GpReg)
   //! \overload
   INST_2i(and_, kX86InstIdAnd, X86Mem, Imm)
 
@@ -822,13 +1219,13 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2cc(cmov, kX86InstIdCmov, X86Util::condToCmovcc, X86GpReg, X86Mem)
 
   //! Compare two operands.
-  INST_2x(cmp, kX86InstIdCmp, X86GpReg, X86GpReg)
+  INST_2f(cmp, kX86InstIdCmp, _emitFastArith, X86GpReg, X86GpReg)
   //! \overload
-  INST_2x(cmp, kX86InstIdCmp, X86GpReg, X86Mem)
+  INST_2f(cmp, kX86InstIdCmp, _emitFastArith, X86GpReg, X86Mem)
   //! \overload
-  INST_2i(cmp, kX86InstIdCmp, X86GpReg, Imm)
+  INST_2fi(cmp, kX86InstIdCmp, _emitFastArith, X86GpReg)
   //! \overload
-  INST_2x(cmp, kX86InstIdCmp, X86Mem, X86GpReg)
+  INST_2f(cmp, kX86InstIdCmp, _emitFastArith, X86Mem, X86GpReg)
   //! \overload
   INST_2i(cmp, kX86InstIdCmp, X86Mem, Imm)
 
@@ -883,9 +1280,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_1x(imul, kX86InstIdImul, X86Mem)
 
   //! Signed multiply.
-  INST_2x(imul, kX86InstIdImul, X86GpReg, X86GpReg)
+  INST_2f(imul, kX86InstIdImul, _emitFastImul, X86GpReg, X86GpReg)
   //! \overload
-  INST_2x(imul, kX86InstIdImul, X86GpReg, X86Mem)
+  INST_2f(imul, kX86InstIdImul, _emitFastImul, X86GpReg, X86Mem)
   //! \overload
   INST_2i(imul, kX86InstIdImul, X86GpReg, Imm)
 
@@ -925,7 +1322,7 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_0x(lahf, kX86InstIdLahf)
 
   //! Load effective address
-  INST_2x(lea, kX86InstIdLea, X86GpReg, X86Mem)
+  INST_2f(lea, kX86InstIdLea, _emitFastLea, X86GpReg, X86Mem)
 
   //! High level procedure exit.
   INST_0x(leave, kX86InstIdLeave)
@@ -940,13 +1337,13 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_0x(lodsw, kX86InstIdLodsW)
 
   //! Move.
-  INST_2x(mov, kX86InstIdMov, X86GpReg, X86GpReg)
+  INST_2f(mov, kX86InstIdMov, _emitFastMov, X86GpReg, X86GpReg)
   //! \overload
-  INST_2x(mov, kX86InstIdMov, X86GpReg, X86Mem)
+  INST_2f(mov, kX86InstIdMov, _emitFastMov, X86GpReg, X86Mem)
   //! \overload
-  INST_2i(mov, kX86InstIdMov, X86GpReg, Imm)
+  INST_2fi(mov, kX86InstIdMov, _emitFastMov, X86GpReg)
   //! \overload
-  INST_2x(mov, kX86InstIdMov, X86Mem, X86GpReg)
+  INST_2f(mov, kX86InstIdMov, _emitFastMov, X86Mem, X86GpReg)
   //! \overload
   INST_2i(mov, kX86InstIdMov, X86Mem, Imm)
 
@@ -1021,13 +1418,13 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_1x(not_, kX86InstIdNot, X86Mem)
 
   //! Or.
-  INST_2x(or_, kX86InstIdOr, X86GpReg, X86GpReg)
+  INST_2f(or_, kX86InstIdOr, _emitFastArith, X86GpReg, X86GpReg)
   //! \overload
-  INST_2x(or_, kX86InstIdOr, X86GpReg, X86Mem)
+  INST_2f(or_, kX86InstIdOr, _emitFastArith, X86GpReg, X86Mem)
   //! \overload
-  INST_2i(or_, kX86InstIdOr, X86GpReg, Imm)
+  INST_2fi(or_, kX86InstIdOr, _emitFastArith, X86GpReg)
   //! \overload
-  INST_2x(or_, kX86InstIdOr, X86Mem, X86GpReg)
+  INST_2f(or_, kX86InstIdOr, _emitFastArith, X86Mem, X86GpReg)
   //! \overload
   INST_2i(or_, kX86InstIdOr, X86Mem, Imm)
 
@@ -1069,7 +1466,7 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! \overload
   INST_2x(rcl, kX86InstIdRcl, X86Mem, X86GpReg)
   //! Rotate bits left.
-  INST_2i(rcl, kX86InstIdRcl, X86GpReg, Imm)
+  INST_2fi(rcl, kX86InstIdRcl, _emitFastRot, X86GpReg)
   //! \overload
   INST_2i(rcl, kX86InstIdRcl, X86Mem, Imm)
 
@@ -1080,7 +1477,7 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! \overload
   INST_2x(rcr, kX86InstIdRcr, X86Mem, X86GpReg)
   //! Rotate bits right.
-  INST_2i(rcr, kX86InstIdRcr, X86GpReg, Imm)
+  INST_2fi(rcr, kX86InstIdRcr, _emitFastRot, X86GpReg)
   //! \overload
   INST_2i(rcr, kX86InstIdRcr, X86Mem, Imm)
 
@@ -1164,7 +1561,7 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! \overload
   INST_2x(rol, kX86InstIdRol, X86Mem, X86GpReg)
   //! Rotate bits left.
-  INST_2i(rol, kX86InstIdRol, X86GpReg, Imm)
+  INST_2fi(rol, kX86InstIdRol, _emitFastRot, X86GpReg)
   //! \overload
   INST_2i(rol, kX86InstIdRol, X86Mem, Imm)
 
@@ -1175,7 +1572,7 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! \overload
   INST_2x(ror, kX86InstIdRor, X86Mem, X86GpReg)
   //! Rotate bits right.
-  INST_2i(ror, kX86InstIdRor, X86GpReg, Imm)
+  INST_2fi(ror, kX86InstIdRor, _emitFastRot, X86GpReg)
   //! \overload
   INST_2i(ror, kX86InstIdRor, X86Mem, Imm)
 
@@ -1183,13 +1580,13 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_0x(sahf, kX86InstIdSahf)
 
   //! Integer subtraction with borrow.
-  INST_2x(sbb, kX86InstIdSbb, X86GpReg, X86GpReg)
+  INST_2f(sbb, kX86InstIdSbb, _emitFastArith, X86GpReg, X86GpReg)
   //! \overload
-  INST_2x(sbb, kX86InstIdSbb, X86GpReg, X86Mem)
+  INST_2f(sbb, kX86InstIdSbb, _emitFastArith, X86GpReg, X86Mem)
   //! \overload
-  INST_2i(sbb, kX86InstIdSbb, X86GpReg, Imm)
+  INST_2fi(sbb, kX86InstIdSbb, _emitFastArith, X86GpReg)
   //! \overload
-  INST_2x(sbb, kX86InstIdSbb, X86Mem, X86GpReg)
+  INST_2f(sbb, kX86InstIdSbb, _emitFastArith, X86Mem, X86GpReg)
   //! \overload
   INST_2i(sbb, kX86InstIdSbb, X86Mem, Imm)
 
@@ -1200,7 +1597,7 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! \overload
   INST_2x(sal, kX86InstIdSal, X86Mem, X86GpReg)
   //! Shift bits left.
-  INST_2i(sal, kX86InstIdSal, X86GpReg, Imm)
+  INST_2fi(sal, kX86InstIdSal, _emitFastRot, X86GpReg)
   //! \overload
   INST_2i(sal, kX86InstIdSal, X86Mem, Imm)
 
@@ -1211,7 +1608,7 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! \overload
   INST_2x(sar, kX86InstIdSar, X86Mem, X86GpReg)
   //! Shift bits right.
-  INST_2i(sar, kX86InstIdSar, X86GpReg, Imm)
+  INST_2fi(sar, kX86InstIdSar, _emitFastRot, X86GpReg)
   //! \overload
   INST_2i(sar, kX86InstIdSar, X86Mem, Imm)
 
@@ -1236,7 +1633,7 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! \overload
   INST_2x(shl, kX86InstIdShl, X86Mem, X86GpReg)
   //! Shift bits left.
-  INST_2i(shl, kX86InstIdShl, X86GpReg, Imm)
+  INST_2fi(shl, kX86InstIdShl, _emitFastRot, X86GpReg)
   //! \overload
   INST_2i(shl, kX86InstIdShl, X86Mem, Imm)
 
@@ -1247,7 +1644,7 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! \overload
   INST_2x(shr, kX86InstIdShr, X86Mem, X86GpReg)
   //! Shift bits right.
-  INST_2i(shr, kX86InstIdShr, X86GpReg, Imm)
+  INST_2fi(shr, kX86InstIdShr, _emitFastRot, X86GpReg)
   //! \overload
   INST_2i(shr, kX86InstIdShr, X86Mem, Imm)
 
@@ -1288,20 +1685,20 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_0x(stosw, kX86InstIdStosW)
 
   //! Subtract.
-  INST_2x(sub, kX86InstIdSub, X86GpReg, X86GpReg)
+  INST_2f(sub, kX86InstIdSub, _emitFastArith, X86GpReg, X86GpReg)
   //! \overload
-  INST_2x(sub, kX86InstIdSub, X86GpReg, X86Mem)
+  INST_2f(sub, kX86InstIdSub, _emitFastArith, X86GpReg, X86Mem)
   //! \overload
-  INST_2i(sub, kX86InstIdSub, X86GpReg, Imm)
+  INST_2fi(sub, kX86InstIdSub, _emitFastArith, X86GpReg)
   //! \overload
-  INST_2x(sub, kX86InstIdSub, X86Mem, X86GpReg)
+  INST_2f(sub, kX86InstIdSub, _emitFastArith, X86Mem, X86GpReg)
   //! \overload
   INST_2i(sub, kX86InstIdSub, X86Mem, Imm)
 
   //! Logical compare.
-  INST_2x(test, kX86InstIdTest, X86GpReg, X86GpReg)
+  INST_2f(test, kX86InstIdTest, _emitFastTest, X86GpReg, X86GpReg)
   //! \overload
-  INST_2i(test, kX86InstIdTest, X86GpReg, Imm)
+  INST_2fi(test, kX86InstIdTest, _emitFastTest, X86GpReg)
   //! \overload
   INST_2x(test, kX86InstIdTest, X86Mem, X86GpReg)
   //! \overload
@@ -1323,13 +1720,13 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(xchg, kX86InstIdXchg, X86GpReg, X86Mem)
 
   //! Xor.
-  INST_2x(xor_, kX86InstIdXor, X86GpReg, X86GpReg)
+  INST_2f(xor_, kX86InstIdXor, _emitFastArith, X86GpReg, X86GpReg)
   //! \overload
-  INST_2x(xor_, kX86InstIdXor, X86GpReg, X86Mem)
+  INST_2f(xor_, kX86InstIdXor, _emitFastArith, X86GpReg, X86Mem)
   //! \overload
-  INST_2i(xor_, kX86InstIdXor, X86GpReg, Imm)
+  INST_2fi(xor_, kX86InstIdXor, _emitFastArith, X86GpReg)
   //! \overload
-  INST_2x(xor_, kX86InstIdXor, X86Mem, X86GpReg)
+  INST_2f(xor_, kX86InstIdXor, _emitFastArith, X86Mem, X86GpReg)
   //! \overload
   INST_2i(xor_, kX86InstIdXor, X86Mem, Imm)
 
@@ -2237,24 +2634,24 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   // --------------------------------------------------------------------------
 
   //! Packed SP-FP add (SSE).
-  INST_2x(addps, kX86InstIdAddps, X86XmmReg, X86XmmReg)
+  INST_2f(addps, kX86InstIdAddps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(addps, kX86InstIdAddps, X86XmmReg, X86Mem)
+  INST_2f(addps, kX86InstIdAddps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar SP-FP add (SSE).
-  INST_2x(addss, kX86InstIdAddss, X86XmmReg, X86XmmReg)
+  INST_2f(addss, kX86InstIdAddss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(addss, kX86InstIdAddss, X86XmmReg, X86Mem)
+  INST_2f(addss, kX86InstIdAddss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed SP-FP bitwise and-not (SSE).
-  INST_2x(andnps, kX86InstIdAndnps, X86XmmReg, X86XmmReg)
+  INST_2f(andnps, kX86InstIdAndnps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(andnps, kX86InstIdAndnps, X86XmmReg, X86Mem)
+  INST_2f(andnps, kX86InstIdAndnps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed SP-FP bitwise and (SSE).
-  INST_2x(andps, kX86InstIdAndps, X86XmmReg, X86XmmReg)
+  INST_2f(andps, kX86InstIdAndps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(andps, kX86InstIdAndps, X86XmmReg, X86Mem)
+  INST_2f(andps, kX86InstIdAndps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed SP-FP compare (SSE).
   INST_3i(cmpps, kX86InstIdCmpps, X86XmmReg, X86XmmReg, Imm)
@@ -2267,14 +2664,14 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(cmpss, kX86InstIdCmpss, X86XmmReg, X86Mem, Imm)
 
   //! Scalar ordered SP-FP compare and set EFLAGS (SSE).
-  INST_2x(comiss, kX86InstIdComiss, X86XmmReg, X86XmmReg)
+  INST_2f(comiss, kX86InstIdComiss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(comiss, kX86InstIdComiss, X86XmmReg, X86Mem)
+  INST_2f(comiss, kX86InstIdComiss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed signed INT32 to packed SP-FP conversion (SSE).
   INST_2x(cvtpi2ps, kX86InstIdCvtpi2ps, X86XmmReg, X86MmReg)
   //! \overload
-  INST_2x(cvtpi2ps, kX86InstIdCvtpi2ps, X86XmmReg, X86Mem)
+  INST_2f(cvtpi2ps, kX86InstIdCvtpi2ps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed SP-FP to packed INT32 conversion (SSE).
   INST_2x(cvtps2pi, kX86InstIdCvtps2pi, X86MmReg, X86XmmReg)
@@ -2302,14 +2699,14 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(cvttss2si, kX86InstIdCvttss2si, X86GpReg, X86Mem)
 
   //! Packed SP-FP divide (SSE).
-  INST_2x(divps, kX86InstIdDivps, X86XmmReg, X86XmmReg)
+  INST_2f(divps, kX86InstIdDivps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(divps, kX86InstIdDivps, X86XmmReg, X86Mem)
+  INST_2f(divps, kX86InstIdDivps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar SP-FP divide (SSE).
-  INST_2x(divss, kX86InstIdDivss, X86XmmReg, X86XmmReg)
+  INST_2f(divss, kX86InstIdDivss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(divss, kX86InstIdDivss, X86XmmReg, X86Mem)
+  INST_2f(divss, kX86InstIdDivss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Load streaming SIMD extension control/status (SSE).
   INST_1x(ldmxcsr, kX86InstIdLdmxcsr, X86Mem)
@@ -2318,31 +2715,31 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(maskmovq, kX86InstIdMaskmovq, X86MmReg, X86MmReg)
 
   //! Packed SP-FP maximum (SSE).
-  INST_2x(maxps, kX86InstIdMaxps, X86XmmReg, X86XmmReg)
+  INST_2f(maxps, kX86InstIdMaxps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(maxps, kX86InstIdMaxps, X86XmmReg, X86Mem)
+  INST_2f(maxps, kX86InstIdMaxps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar SP-FP maximum (SSE).
-  INST_2x(maxss, kX86InstIdMaxss, X86XmmReg, X86XmmReg)
+  INST_2f(maxss, kX86InstIdMaxss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(maxss, kX86InstIdMaxss, X86XmmReg, X86Mem)
+  INST_2f(maxss, kX86InstIdMaxss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed SP-FP minimum (SSE).
-  INST_2x(minps, kX86InstIdMinps, X86XmmReg, X86XmmReg)
+  INST_2f(minps, kX86InstIdMinps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(minps, kX86InstIdMinps, X86XmmReg, X86Mem)
+  INST_2f(minps, kX86InstIdMinps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar SP-FP minimum (SSE).
-  INST_2x(minss, kX86InstIdMinss, X86XmmReg, X86XmmReg)
+  INST_2f(minss, kX86InstIdMinss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(minss, kX86InstIdMinss, X86XmmReg, X86Mem)
+  INST_2f(minss, kX86InstIdMinss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Move aligned packed SP-FP (SSE).
-  INST_2x(movaps, kX86InstIdMovaps, X86XmmReg, X86XmmReg)
+  INST_2f(movaps, kX86InstIdMovaps, _emitFastSimdMov, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(movaps, kX86InstIdMovaps, X86XmmReg, X86Mem)
+  INST_2f(movaps, kX86InstIdMovaps, _emitFastSimdMov, X86XmmReg, X86Mem)
   //! Move aligned packed SP-FP (SSE).
-  INST_2x(movaps, kX86InstIdMovaps, X86Mem, X86XmmReg)
+  INST_2f(movaps, kX86InstIdMovaps, _emitFastSimdMov, X86Mem, X86XmmReg)
 
   //! Move DWORD.
   INST_2x(movd, kX86InstIdMovd, X86Mem, X86XmmReg)
@@ -2388,33 +2785,33 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(movntps, kX86InstIdMovntps, X86Mem, X86XmmReg)
 
   //! Move scalar SP-FP (SSE).
-  INST_2x(movss, kX86InstIdMovss, X86XmmReg, X86XmmReg)
+  INST_2f(movss, kX86InstIdMovss, _emitFastSimdMov, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(movss, kX86InstIdMovss, X86XmmReg, X86Mem)
+  INST_2f(movss, kX86InstIdMovss, _emitFastSimdMov, X86XmmReg, X86Mem)
   //! \overload
-  INST_2x(movss, kX86InstIdMovss, X86Mem, X86XmmReg)
+  INST_2f(movss, kX86InstIdMovss, _emitFastSimdMov, X86Mem, X86XmmReg)
 
   //! Move unaligned packed SP-FP (SSE).
-  INST_2x(movups, kX86InstIdMovups, X86XmmReg, X86XmmReg)
+  INST_2f(movups, kX86InstIdMovups, _emitFastSimdMov, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(movups, kX86InstIdMovups, X86XmmReg, X86Mem)
+  INST_2f(movups, kX86InstIdMovups, _emitFastSimdMov, X86XmmReg, X86Mem)
   //! \overload
-  INST_2x(movups, kX86InstIdMovups, X86Mem, X86XmmReg)
+  INST_2f(movups, kX86InstIdMovups, _emitFastSimdMov, X86Mem, X86XmmReg)
 
   //! Packed SP-FP multiply (SSE).
-  INST_2x(mulps, kX86InstIdMulps, X86XmmReg, X86XmmReg)
+  INST_2f(mulps, kX86InstIdMulps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(mulps, kX86InstIdMulps, X86XmmReg, X86Mem)
+  INST_2f(mulps, kX86InstIdMulps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar SP-FP multiply (SSE).
-  INST_2x(mulss, kX86InstIdMulss, X86XmmReg, X86XmmReg)
+  INST_2f(mulss, kX86InstIdMulss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(mulss, kX86InstIdMulss, X86XmmReg, X86Mem)
+  INST_2f(mulss, kX86InstIdMulss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed SP-FP bitwise or (SSE).
-  INST_2x(orps, kX86InstIdOrps, X86XmmReg, X86XmmReg)
+  INST_2f(orps, kX86InstIdOrps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(orps, kX86InstIdOrps, X86XmmReg, X86Mem)
+  INST_2f(orps, kX86InstIdOrps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed BYTE average (SSE).
   INST_2x(pavgb, kX86InstIdPavgb, X86MmReg, X86MmReg)
@@ -2473,32 +2870,32 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(pshufw, kX86InstIdPshufw, X86MmReg, X86Mem, Imm)
 
   //! Packed SP-FP reciprocal (SSE).
-  INST_2x(rcpps, kX86InstIdRcpps, X86XmmReg, X86XmmReg)
+  INST_2f(rcpps, kX86InstIdRcpps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(rcpps, kX86InstIdRcpps, X86XmmReg, X86Mem)
+  INST_2f(rcpps, kX86InstIdRcpps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar SP-FP reciprocal (SSE).
-  INST_2x(rcpss, kX86InstIdRcpss, X86XmmReg, X86XmmReg)
+  INST_2f(rcpss, kX86InstIdRcpss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(rcpss, kX86InstIdRcpss, X86XmmReg, X86Mem)
+  INST_2f(rcpss, kX86InstIdRcpss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Prefetch (SSE).
   INST_2i(prefetch, kX86InstIdPrefetch, X86Mem, Imm)
 
   //! Packed WORD sum of absolute differences (SSE).
-  INST_2x(psadbw, kX86InstIdPsadbw, X86XmmReg, X86XmmReg)
+  INST_2f(psadbw, kX86InstIdPsadbw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psadbw, kX86InstIdPsadbw, X86XmmReg, X86Mem)
+  INST_2f(psadbw, kX86InstIdPsadbw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed SP-FP square root reciprocal (SSE).
-  INST_2x(rsqrtps, kX86InstIdRsqrtps, X86XmmReg, X86XmmReg)
+  INST_2f(rsqrtps, kX86InstIdRsqrtps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(rsqrtps, kX86InstIdRsqrtps, X86XmmReg, X86Mem)
+  INST_2f(rsqrtps, kX86InstIdRsqrtps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar SP-FP square root reciprocal (SSE).
-  INST_2x(rsqrtss, kX86InstIdRsqrtss, X86XmmReg, X86XmmReg)
+  INST_2f(rsqrtss, kX86InstIdRsqrtss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(rsqrtss, kX86InstIdRsqrtss, X86XmmReg, X86Mem)
+  INST_2f(rsqrtss, kX86InstIdRsqrtss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Store fence (SSE).
   INST_0x(sfence, kX86InstIdSfence)
@@ -2509,71 +2906,71 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(shufps, kX86InstIdShufps, X86XmmReg, X86Mem, Imm)
 
   //! Packed SP-FP square root (SSE).
-  INST_2x(sqrtps, kX86InstIdSqrtps, X86XmmReg, X86XmmReg)
+  INST_2f(sqrtps, kX86InstIdSqrtps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(sqrtps, kX86InstIdSqrtps, X86XmmReg, X86Mem)
+  INST_2f(sqrtps, kX86InstIdSqrtps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar SP-FP square root (SSE).
-  INST_2x(sqrtss, kX86InstIdSqrtss, X86XmmReg, X86XmmReg)
+  INST_2f(sqrtss, kX86InstIdSqrtss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(sqrtss, kX86InstIdSqrtss, X86XmmReg, X86Mem)
+  INST_2f(sqrtss, kX86InstIdSqrtss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Store streaming SIMD extension control/status (SSE).
   INST_1x(stmxcsr, kX86InstIdStmxcsr, X86Mem)
 
   //! Packed SP-FP subtract (SSE).
-  INST_2x(subps, kX86InstIdSubps, X86XmmReg, X86XmmReg)
+  INST_2f(subps, kX86InstIdSubps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(subps, kX86InstIdSubps, X86XmmReg, X86Mem)
+  INST_2f(subps, kX86InstIdSubps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar SP-FP subtract (SSE).
-  INST_2x(subss, kX86InstIdSubss, X86XmmReg, X86XmmReg)
+  INST_2f(subss, kX86InstIdSubss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(subss, kX86InstIdSubss, X86XmmReg, X86Mem)
+  INST_2f(subss, kX86InstIdSubss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Unordered scalar SP-FP compare and set EFLAGS (SSE).
-  INST_2x(ucomiss, kX86InstIdUcomiss, X86XmmReg, X86XmmReg)
+  INST_2f(ucomiss, kX86InstIdUcomiss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(ucomiss, kX86InstIdUcomiss, X86XmmReg, X86Mem)
+  INST_2f(ucomiss, kX86InstIdUcomiss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Unpack high packed SP-FP data (SSE).
-  INST_2x(unpckhps, kX86InstIdUnpckhps, X86XmmReg, X86XmmReg)
+  INST_2f(unpckhps, kX86InstIdUnpckhps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(unpckhps, kX86InstIdUnpckhps, X86XmmReg, X86Mem)
+  INST_2f(unpckhps, kX86InstIdUnpckhps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Unpack low packed SP-FP data (SSE).
-  INST_2x(unpcklps, kX86InstIdUnpcklps, X86XmmReg, X86XmmReg)
+  INST_2f(unpcklps, kX86InstIdUnpcklps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(unpcklps, kX86InstIdUnpcklps, X86XmmReg, X86Mem)
+  INST_2f(unpcklps, kX86InstIdUnpcklps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed SP-FP bitwise xor (SSE).
-  INST_2x(xorps, kX86InstIdXorps, X86XmmReg, X86XmmReg)
+  INST_2f(xorps, kX86InstIdXorps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(xorps, kX86InstIdXorps, X86XmmReg, X86Mem)
+  INST_2f(xorps, kX86InstIdXorps, _emitFastSimd, X86XmmReg, X86Mem)
 
   // --------------------------------------------------------------------------
   // [SSE2]
   // --------------------------------------------------------------------------
 
   //! Packed DP-FP add (SSE2).
-  INST_2x(addpd, kX86InstIdAddpd, X86XmmReg, X86XmmReg)
+  INST_2f(addpd, kX86InstIdAddpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(addpd, kX86InstIdAddpd, X86XmmReg, X86Mem)
+  INST_2f(addpd, kX86InstIdAddpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar DP-FP add (SSE2).
-  INST_2x(addsd, kX86InstIdAddsd, X86XmmReg, X86XmmReg)
+  INST_2f(addsd, kX86InstIdAddsd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(addsd, kX86InstIdAddsd, X86XmmReg, X86Mem)
+  INST_2f(addsd, kX86InstIdAddsd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DP-FP bitwise and-not (SSE2).
-  INST_2x(andnpd, kX86InstIdAndnpd, X86XmmReg, X86XmmReg)
+  INST_2f(andnpd, kX86InstIdAndnpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(andnpd, kX86InstIdAndnpd, X86XmmReg, X86Mem)
+  INST_2f(andnpd, kX86InstIdAndnpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DP-FP bitwise and (SSE2).
-  INST_2x(andpd, kX86InstIdAndpd, X86XmmReg, X86XmmReg)
+  INST_2f(andpd, kX86InstIdAndpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(andpd, kX86InstIdAndpd, X86XmmReg, X86Mem)
+  INST_2f(andpd, kX86InstIdAndpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DP-FP compare (SSE2).
   INST_3i(cmppd, kX86InstIdCmppd, X86XmmReg, X86XmmReg, Imm)
@@ -2586,24 +2983,24 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(cmpsd, kX86InstIdCmpsd, X86XmmReg, X86Mem, Imm)
 
   //! Scalar ordered DP-FP compare and set EFLAGS (SSE2).
-  INST_2x(comisd, kX86InstIdComisd, X86XmmReg, X86XmmReg)
+  INST_2f(comisd, kX86InstIdComisd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(comisd, kX86InstIdComisd, X86XmmReg, X86Mem)
+  INST_2f(comisd, kX86InstIdComisd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert packed DWORDs to packed DP-FP (SSE2).
-  INST_2x(cvtdq2pd, kX86InstIdCvtdq2pd, X86XmmReg, X86XmmReg)
+  INST_2f(cvtdq2pd, kX86InstIdCvtdq2pd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(cvtdq2pd, kX86InstIdCvtdq2pd, X86XmmReg, X86Mem)
+  INST_2f(cvtdq2pd, kX86InstIdCvtdq2pd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert packed DWORDs to packed SP-FP (SSE2).
-  INST_2x(cvtdq2ps, kX86InstIdCvtdq2ps, X86XmmReg, X86XmmReg)
+  INST_2f(cvtdq2ps, kX86InstIdCvtdq2ps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(cvtdq2ps, kX86InstIdCvtdq2ps, X86XmmReg, X86Mem)
+  INST_2f(cvtdq2ps, kX86InstIdCvtdq2ps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert packed DP-FP to packed DWORDs (SSE2).
-  INST_2x(cvtpd2dq, kX86InstIdCvtpd2dq, X86XmmReg, X86XmmReg)
+  INST_2f(cvtpd2dq, kX86InstIdCvtpd2dq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(cvtpd2dq, kX86InstIdCvtpd2dq, X86XmmReg, X86Mem)
+  INST_2f(cvtpd2dq, kX86InstIdCvtpd2dq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert packed DP-FP to packed DWORDs (SSE2).
   INST_2x(cvtpd2pi, kX86InstIdCvtpd2pi, X86MmReg, X86XmmReg)
@@ -2611,24 +3008,24 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(cvtpd2pi, kX86InstIdCvtpd2pi, X86MmReg, X86Mem)
 
   //! Convert packed DP-FP to packed SP-FP (SSE2).
-  INST_2x(cvtpd2ps, kX86InstIdCvtpd2ps, X86XmmReg, X86XmmReg)
+  INST_2f(cvtpd2ps, kX86InstIdCvtpd2ps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(cvtpd2ps, kX86InstIdCvtpd2ps, X86XmmReg, X86Mem)
+  INST_2f(cvtpd2ps, kX86InstIdCvtpd2ps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert packed DWORDs integers to packed DP-FP (SSE2).
   INST_2x(cvtpi2pd, kX86InstIdCvtpi2pd, X86XmmReg, X86MmReg)
   //! \overload
-  INST_2x(cvtpi2pd, kX86InstIdCvtpi2pd, X86XmmReg, X86Mem)
+  INST_2f(cvtpi2pd, kX86InstIdCvtpi2pd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert packed SP-FP to packed DWORDs (SSE2).
-  INST_2x(cvtps2dq, kX86InstIdCvtps2dq, X86XmmReg, X86XmmReg)
+  INST_2f(cvtps2dq, kX86InstIdCvtps2dq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(cvtps2dq, kX86InstIdCvtps2dq, X86XmmReg, X86Mem)
+  INST_2f(cvtps2dq, kX86InstIdCvtps2dq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert packed SP-FP to packed DP-FP (SSE2).
-  INST_2x(cvtps2pd, kX86InstIdCvtps2pd, X86XmmReg, X86XmmReg)
+  INST_2f(cvtps2pd, kX86InstIdCvtps2pd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(cvtps2pd, kX86InstIdCvtps2pd, X86XmmReg, X86Mem)
+  INST_2f(cvtps2pd, kX86InstIdCvtps2pd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert scalar DP-FP to DWORD integer (SSE2).
   INST_2x(cvtsd2si, kX86InstIdCvtsd2si, X86GpReg, X86XmmReg)
@@ -2636,9 +3033,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(cvtsd2si, kX86InstIdCvtsd2si, X86GpReg, X86Mem)
 
   //! Convert scalar DP-FP to scalar SP-FP (SSE2).
-  INST_2x(cvtsd2ss, kX86InstIdCvtsd2ss, X86XmmReg, X86XmmReg)
+  INST_2f(cvtsd2ss, kX86InstIdCvtsd2ss, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(cvtsd2ss, kX86InstIdCvtsd2ss, X86XmmReg, X86Mem)
+  INST_2f(cvtsd2ss, kX86InstIdCvtsd2ss, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert DWORD integer to scalar DP-FP (SSE2).
   INST_2x(cvtsi2sd, kX86InstIdCvtsi2sd, X86XmmReg, X86GpReg)
@@ -2646,9 +3043,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(cvtsi2sd, kX86InstIdCvtsi2sd, X86XmmReg, X86Mem)
 
   //! Convert scalar SP-FP to DP-FP (SSE2).
-  INST_2x(cvtss2sd, kX86InstIdCvtss2sd, X86XmmReg, X86XmmReg)
+  INST_2f(cvtss2sd, kX86InstIdCvtss2sd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(cvtss2sd, kX86InstIdCvtss2sd, X86XmmReg, X86Mem)
+  INST_2f(cvtss2sd, kX86InstIdCvtss2sd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert with truncation packed DP-FP to packed DWORDs (SSE2).
   INST_2x(cvttpd2pi, kX86InstIdCvttpd2pi, X86MmReg, X86XmmReg)
@@ -2656,14 +3053,14 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(cvttpd2pi, kX86InstIdCvttpd2pi, X86MmReg, X86Mem)
 
   //! Convert with truncation packed DP-FP to packed DWORDs (SSE2).
-  INST_2x(cvttpd2dq, kX86InstIdCvttpd2dq, X86XmmReg, X86XmmReg)
+  INST_2f(cvttpd2dq, kX86InstIdCvttpd2dq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(cvttpd2dq, kX86InstIdCvttpd2dq, X86XmmReg, X86Mem)
+  INST_2f(cvttpd2dq, kX86InstIdCvttpd2dq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert with truncation packed SP-FP to packed DWORDs (SSE2).
-  INST_2x(cvttps2dq, kX86InstIdCvttps2dq, X86XmmReg, X86XmmReg)
+  INST_2f(cvttps2dq, kX86InstIdCvttps2dq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(cvttps2dq, kX86InstIdCvttps2dq, X86XmmReg, X86Mem)
+  INST_2f(cvttps2dq, kX86InstIdCvttps2dq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Convert with truncation scalar DP-FP to signed DWORDs (SSE2).
   INST_2x(cvttsd2si, kX86InstIdCvttsd2si, X86GpReg, X86XmmReg)
@@ -2671,14 +3068,14 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(cvttsd2si, kX86InstIdCvttsd2si, X86GpReg, X86Mem)
 
   //! Packed DP-FP divide (SSE2).
-  INST_2x(divpd, kX86InstIdDivpd, X86XmmReg, X86XmmReg)
+  INST_2f(divpd, kX86InstIdDivpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(divpd, kX86InstIdDivpd, X86XmmReg, X86Mem)
+  INST_2f(divpd, kX86InstIdDivpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar DP-FP divide (SSE2).
-  INST_2x(divsd, kX86InstIdDivsd, X86XmmReg, X86XmmReg)
+  INST_2f(divsd, kX86InstIdDivsd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(divsd, kX86InstIdDivsd, X86XmmReg, X86Mem)
+  INST_2f(divsd, kX86InstIdDivsd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Load fence (SSE2).
   INST_0x(lfence, kX86InstIdLfence)
@@ -2687,41 +3084,41 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(maskmovdqu, kX86InstIdMaskmovdqu, X86XmmReg, X86XmmReg)
 
   //! Packed DP-FP maximum (SSE2).
-  INST_2x(maxpd, kX86InstIdMaxpd, X86XmmReg, X86XmmReg)
+  INST_2f(maxpd, kX86InstIdMaxpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(maxpd, kX86InstIdMaxpd, X86XmmReg, X86Mem)
+  INST_2f(maxpd, kX86InstIdMaxpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar DP-FP maximum (SSE2).
-  INST_2x(maxsd, kX86InstIdMaxsd, X86XmmReg, X86XmmReg)
+  INST_2f(maxsd, kX86InstIdMaxsd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(maxsd, kX86InstIdMaxsd, X86XmmReg, X86Mem)
+  INST_2f(maxsd, kX86InstIdMaxsd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Memory fence (SSE2).
   INST_0x(mfence, kX86InstIdMfence)
 
   //! Packed DP-FP minimum (SSE2).
-  INST_2x(minpd, kX86InstIdMinpd, X86XmmReg, X86XmmReg)
+  INST_2f(minpd, kX86InstIdMinpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(minpd, kX86InstIdMinpd, X86XmmReg, X86Mem)
+  INST_2f(minpd, kX86InstIdMinpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar DP-FP minimum (SSE2).
-  INST_2x(minsd, kX86InstIdMinsd, X86XmmReg, X86XmmReg)
+  INST_2f(minsd, kX86InstIdMinsd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(minsd, kX86InstIdMinsd, X86XmmReg, X86Mem)
+  INST_2f(minsd, kX86InstIdMinsd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Move aligned DQWORD (SSE2).
-  INST_2x(movdqa, kX86InstIdMovdqa, X86XmmReg, X86XmmReg)
+  INST_2f(movdqa, kX86InstIdMovdqa, _emitFastSimdMov, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(movdqa, kX86InstIdMovdqa, X86XmmReg, X86Mem)
+  INST_2f(movdqa, kX86InstIdMovdqa, _emitFastSimdMov, X86XmmReg, X86Mem)
   //! \overload
-  INST_2x(movdqa, kX86InstIdMovdqa, X86Mem, X86XmmReg)
+  INST_2f(movdqa, kX86InstIdMovdqa, _emitFastSimdMov, X86Mem, X86XmmReg)
 
   //! Move unaligned DQWORD (SSE2).
-  INST_2x(movdqu, kX86InstIdMovdqu, X86XmmReg, X86XmmReg)
+  INST_2f(movdqu, kX86InstIdMovdqu, _emitFastSimdMov, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(movdqu, kX86InstIdMovdqu, X86XmmReg, X86Mem)
+  INST_2f(movdqu, kX86InstIdMovdqu, _emitFastSimdMov, X86XmmReg, X86Mem)
   //! \overload
-  INST_2x(movdqu, kX86InstIdMovdqu, X86Mem, X86XmmReg)
+  INST_2f(movdqu, kX86InstIdMovdqu, _emitFastSimdMov, X86Mem, X86XmmReg)
 
   //! Extract packed SP-FP sign mask (SSE2).
   INST_2x(movmskps, kX86InstIdMovmskps, X86GpReg, X86XmmReg)
@@ -2730,18 +3127,18 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(movmskpd, kX86InstIdMovmskpd, X86GpReg, X86XmmReg)
 
   //! Move scalar DP-FP (SSE2).
-  INST_2x(movsd, kX86InstIdMovsd, X86XmmReg, X86XmmReg)
+  INST_2f(movsd, kX86InstIdMovsd, _emitFastSimdMov, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(movsd, kX86InstIdMovsd, X86XmmReg, X86Mem)
+  INST_2f(movsd, kX86InstIdMovsd, _emitFastSimdMov, X86XmmReg, X86Mem)
   //! \overload
-  INST_2x(movsd, kX86InstIdMovsd, X86Mem, X86XmmReg)
+  INST_2f(movsd, kX86InstIdMovsd, _emitFastSimdMov, X86Mem, X86XmmReg)
 
   //! Move aligned packed DP-FP (SSE2).
-  INST_2x(movapd, kX86InstIdMovapd, X86XmmReg, X86XmmReg)
+  INST_2f(movapd, kX86InstIdMovapd, _emitFastSimdMov, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(movapd, kX86InstIdMovapd, X86XmmReg, X86Mem)
+  INST_2f(movapd, kX86InstIdMovapd, _emitFastSimdMov, X86XmmReg, X86Mem)
   //! \overload
-  INST_2x(movapd, kX86InstIdMovapd, X86Mem, X86XmmReg)
+  INST_2f(movapd, kX86InstIdMovapd, _emitFastSimdMov, X86Mem, X86XmmReg)
 
   //! Move QWORD from XMM to MMX register (SSE2).
   INST_2x(movdq2q, kX86InstIdMovdq2q, X86MmReg, X86XmmReg)
@@ -2769,56 +3166,56 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(movntpd, kX86InstIdMovntpd, X86Mem, X86XmmReg)
 
   //! Move unaligned packed DP-FP (SSE2).
-  INST_2x(movupd, kX86InstIdMovupd, X86XmmReg, X86XmmReg)
+  INST_2f(movupd, kX86InstIdMovupd, _emitFastSimdMov, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(movupd, kX86InstIdMovupd, X86XmmReg, X86Mem)
+  INST_2f(movupd, kX86InstIdMovupd, _emitFastSimdMov, X86XmmReg, X86Mem)
   //! \overload
-  INST_2x(movupd, kX86InstIdMovupd, X86Mem, X86XmmReg)
+  INST_2f(movupd, kX86InstIdMovupd, _emitFastSimdMov, X86Mem, X86XmmReg)
 
   //! Packed DP-FP multiply (SSE2).
-  INST_2x(mulpd, kX86InstIdMulpd, X86XmmReg, X86XmmReg)
+  INST_2f(mulpd, kX86InstIdMulpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(mulpd, kX86InstIdMulpd, X86XmmReg, X86Mem)
+  INST_2f(mulpd, kX86InstIdMulpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar DP-FP multiply (SSE2).
-  INST_2x(mulsd, kX86InstIdMulsd, X86XmmReg, X86XmmReg)
+  INST_2f(mulsd, kX86InstIdMulsd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(mulsd, kX86InstIdMulsd, X86XmmReg, X86Mem)
+  INST_2f(mulsd, kX86InstIdMulsd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DP-FP bitwise or (SSE2).
-  INST_2x(orpd, kX86InstIdOrpd, X86XmmReg, X86XmmReg)
+  INST_2f(orpd, kX86InstIdOrpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(orpd, kX86InstIdOrpd, X86XmmReg, X86Mem)
+  INST_2f(orpd, kX86InstIdOrpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Pack WORDs to BYTEs with signed saturation (SSE2).
-  INST_2x(packsswb, kX86InstIdPacksswb, X86XmmReg, X86XmmReg)
+  INST_2f(packsswb, kX86InstIdPacksswb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(packsswb, kX86InstIdPacksswb, X86XmmReg, X86Mem)
+  INST_2f(packsswb, kX86InstIdPacksswb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Pack DWORDs to WORDs with signed saturation (SSE2).
-  INST_2x(packssdw, kX86InstIdPackssdw, X86XmmReg, X86XmmReg)
+  INST_2f(packssdw, kX86InstIdPackssdw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(packssdw, kX86InstIdPackssdw, X86XmmReg, X86Mem)
+  INST_2f(packssdw, kX86InstIdPackssdw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Pack WORDs to BYTEs with unsigned saturation (SSE2).
-  INST_2x(packuswb, kX86InstIdPackuswb, X86XmmReg, X86XmmReg)
+  INST_2f(packuswb, kX86InstIdPackuswb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(packuswb, kX86InstIdPackuswb, X86XmmReg, X86Mem)
+  INST_2f(packuswb, kX86InstIdPackuswb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed BYTE Add (SSE2).
-  INST_2x(paddb, kX86InstIdPaddb, X86XmmReg, X86XmmReg)
+  INST_2f(paddb, kX86InstIdPaddb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(paddb, kX86InstIdPaddb, X86XmmReg, X86Mem)
+  INST_2f(paddb, kX86InstIdPaddb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD add (SSE2).
-  INST_2x(paddw, kX86InstIdPaddw, X86XmmReg, X86XmmReg)
+  INST_2f(paddw, kX86InstIdPaddw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(paddw, kX86InstIdPaddw, X86XmmReg, X86Mem)
+  INST_2f(paddw, kX86InstIdPaddw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed DWORD add (SSE2).
-  INST_2x(paddd, kX86InstIdPaddd, X86XmmReg, X86XmmReg)
+  INST_2f(paddd, kX86InstIdPaddd, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(paddd, kX86InstIdPaddd, X86XmmReg, X86Mem)
+  INST_2f(paddd, kX86InstIdPaddd, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed QWORD add (SSE2).
   INST_2x(paddq, kX86InstIdPaddq, X86MmReg, X86MmReg)
@@ -2826,82 +3223,82 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(paddq, kX86InstIdPaddq, X86MmReg, X86Mem)
 
   //! Packed QWORD add (SSE2).
-  INST_2x(paddq, kX86InstIdPaddq, X86XmmReg, X86XmmReg)
+  INST_2f(paddq, kX86InstIdPaddq, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(paddq, kX86InstIdPaddq, X86XmmReg, X86Mem)
+  INST_2f(paddq, kX86InstIdPaddq, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed BYTE add with saturation (SSE2).
-  INST_2x(paddsb, kX86InstIdPaddsb, X86XmmReg, X86XmmReg)
+  INST_2f(paddsb, kX86InstIdPaddsb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(paddsb, kX86InstIdPaddsb, X86XmmReg, X86Mem)
+  INST_2f(paddsb, kX86InstIdPaddsb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD add with saturation (SSE2).
-  INST_2x(paddsw, kX86InstIdPaddsw, X86XmmReg, X86XmmReg)
+  INST_2f(paddsw, kX86InstIdPaddsw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(paddsw, kX86InstIdPaddsw, X86XmmReg, X86Mem)
+  INST_2f(paddsw, kX86InstIdPaddsw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed BYTE add with unsigned saturation (SSE2).
-  INST_2x(paddusb, kX86InstIdPaddusb, X86XmmReg, X86XmmReg)
+  INST_2f(paddusb, kX86InstIdPaddusb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(paddusb, kX86InstIdPaddusb, X86XmmReg, X86Mem)
+  INST_2f(paddusb, kX86InstIdPaddusb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD add with unsigned saturation (SSE2).
-  INST_2x(paddusw, kX86InstIdPaddusw, X86XmmReg, X86XmmReg)
+  INST_2f(paddusw, kX86InstIdPaddusw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(paddusw, kX86InstIdPaddusw, X86XmmReg, X86Mem)
+  INST_2f(paddusw, kX86InstIdPaddusw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed bitwise and (SSE2).
-  INST_2x(pand, kX86InstIdPand, X86XmmReg, X86XmmReg)
+  INST_2f(pand, kX86InstIdPand, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pand, kX86InstIdPand, X86XmmReg, X86Mem)
+  INST_2f(pand, kX86InstIdPand, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed bitwise and-not (SSE2).
-  INST_2x(pandn, kX86InstIdPandn, X86XmmReg, X86XmmReg)
+  INST_2f(pandn, kX86InstIdPandn, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pandn, kX86InstIdPandn, X86XmmReg, X86Mem)
+  INST_2f(pandn, kX86InstIdPandn, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Spin loop hint (SSE2).
   INST_0x(pause, kX86InstIdPause)
 
   //! Packed BYTE average (SSE2).
-  INST_2x(pavgb, kX86InstIdPavgb, X86XmmReg, X86XmmReg)
+  INST_2f(pavgb, kX86InstIdPavgb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pavgb, kX86InstIdPavgb, X86XmmReg, X86Mem)
+  INST_2f(pavgb, kX86InstIdPavgb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD average (SSE2).
-  INST_2x(pavgw, kX86InstIdPavgw, X86XmmReg, X86XmmReg)
+  INST_2f(pavgw, kX86InstIdPavgw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pavgw, kX86InstIdPavgw, X86XmmReg, X86Mem)
+  INST_2f(pavgw, kX86InstIdPavgw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed BYTE compare for equality (SSE2).
-  INST_2x(pcmpeqb, kX86InstIdPcmpeqb, X86XmmReg, X86XmmReg)
+  INST_2f(pcmpeqb, kX86InstIdPcmpeqb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pcmpeqb, kX86InstIdPcmpeqb, X86XmmReg, X86Mem)
+  INST_2f(pcmpeqb, kX86InstIdPcmpeqb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD compare for equality (SSE2).
-  INST_2x(pcmpeqw, kX86InstIdPcmpeqw, X86XmmReg, X86XmmReg)
+  INST_2f(pcmpeqw, kX86InstIdPcmpeqw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pcmpeqw, kX86InstIdPcmpeqw, X86XmmReg, X86Mem)
+  INST_2f(pcmpeqw, kX86InstIdPcmpeqw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed DWORD compare for equality (SSE2).
-  INST_2x(pcmpeqd, kX86InstIdPcmpeqd, X86XmmReg, X86XmmReg)
+  INST_2f(pcmpeqd, kX86InstIdPcmpeqd, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pcmpeqd, kX86InstIdPcmpeqd, X86XmmReg, X86Mem)
+  INST_2f(pcmpeqd, kX86InstIdPcmpeqd, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed BYTE compare if greater than (SSE2).
-  INST_2x(pcmpgtb, kX86InstIdPcmpgtb, X86XmmReg, X86XmmReg)
+  INST_2f(pcmpgtb, kX86InstIdPcmpgtb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pcmpgtb, kX86InstIdPcmpgtb, X86XmmReg, X86Mem)
+  INST_2f(pcmpgtb, kX86InstIdPcmpgtb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD compare if greater than (SSE2).
-  INST_2x(pcmpgtw, kX86InstIdPcmpgtw, X86XmmReg, X86XmmReg)
+  INST_2f(pcmpgtw, kX86InstIdPcmpgtw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pcmpgtw, kX86InstIdPcmpgtw, X86XmmReg, X86Mem)
+  INST_2f(pcmpgtw, kX86InstIdPcmpgtw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed DWORD compare if greater than (SSE2).
-  INST_2x(pcmpgtd, kX86InstIdPcmpgtd, X86XmmReg, X86XmmReg)
+  INST_2f(pcmpgtd, kX86InstIdPcmpgtd, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pcmpgtd, kX86InstIdPcmpgtd, X86XmmReg, X86Mem)
+  INST_2f(pcmpgtd, kX86InstIdPcmpgtd, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Extract WORD based on selector (SSE2).
   INST_3i(pextrw, kX86InstIdPextrw, X86GpReg, X86XmmReg, Imm)
@@ -2912,42 +3309,42 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(pinsrw, kX86InstIdPinsrw, X86XmmReg, X86Mem, Imm)
 
   //! Packed WORD maximum (SSE2).
-  INST_2x(pmaxsw, kX86InstIdPmaxsw, X86XmmReg, X86XmmReg)
+  INST_2f(pmaxsw, kX86InstIdPmaxsw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmaxsw, kX86InstIdPmaxsw, X86XmmReg, X86Mem)
+  INST_2f(pmaxsw, kX86InstIdPmaxsw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed BYTE unsigned maximum (SSE2).
-  INST_2x(pmaxub, kX86InstIdPmaxub, X86XmmReg, X86XmmReg)
+  INST_2f(pmaxub, kX86InstIdPmaxub, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmaxub, kX86InstIdPmaxub, X86XmmReg, X86Mem)
+  INST_2f(pmaxub, kX86InstIdPmaxub, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD minimum (SSE2).
-  INST_2x(pminsw, kX86InstIdPminsw, X86XmmReg, X86XmmReg)
+  INST_2f(pminsw, kX86InstIdPminsw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pminsw, kX86InstIdPminsw, X86XmmReg, X86Mem)
+  INST_2f(pminsw, kX86InstIdPminsw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed BYTE unsigned minimum (SSE2).
-  INST_2x(pminub, kX86InstIdPminub, X86XmmReg, X86XmmReg)
+  INST_2f(pminub, kX86InstIdPminub, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pminub, kX86InstIdPminub, X86XmmReg, X86Mem)
+  INST_2f(pminub, kX86InstIdPminub, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Move byte mask (SSE2).
   INST_2x(pmovmskb, kX86InstIdPmovmskb, X86GpReg, X86XmmReg)
 
   //! Packed WORD multiply high (SSE2).
-  INST_2x(pmulhw, kX86InstIdPmulhw, X86XmmReg, X86XmmReg)
+  INST_2f(pmulhw, kX86InstIdPmulhw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmulhw, kX86InstIdPmulhw, X86XmmReg, X86Mem)
+  INST_2f(pmulhw, kX86InstIdPmulhw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD unsigned multiply high (SSE2).
-  INST_2x(pmulhuw, kX86InstIdPmulhuw, X86XmmReg, X86XmmReg)
+  INST_2f(pmulhuw, kX86InstIdPmulhuw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmulhuw, kX86InstIdPmulhuw, X86XmmReg, X86Mem)
+  INST_2f(pmulhuw, kX86InstIdPmulhuw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD multiply low (SSE2).
-  INST_2x(pmullw, kX86InstIdPmullw, X86XmmReg, X86XmmReg)
+  INST_2f(pmullw, kX86InstIdPmullw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmullw, kX86InstIdPmullw, X86XmmReg, X86Mem)
+  INST_2f(pmullw, kX86InstIdPmullw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed DWORD multiply to QWORD (SSE2).
   INST_2x(pmuludq, kX86InstIdPmuludq, X86MmReg, X86MmReg)
@@ -2955,14 +3352,14 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(pmuludq, kX86InstIdPmuludq, X86MmReg, X86Mem)
 
   //! Packed DWORD multiply to QWORD (SSE2).
-  INST_2x(pmuludq, kX86InstIdPmuludq, X86XmmReg, X86XmmReg)
+  INST_2f(pmuludq, kX86InstIdPmuludq, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmuludq, kX86InstIdPmuludq, X86XmmReg, X86Mem)
+  INST_2f(pmuludq, kX86InstIdPmuludq, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed bitwise or (SSE2).
-  INST_2x(por, kX86InstIdPor, X86XmmReg, X86XmmReg)
+  INST_2f(por, kX86InstIdPor, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(por, kX86InstIdPor, X86XmmReg, X86Mem)
+  INST_2f(por, kX86InstIdPor, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed DWORD shift left logical (SSE2).
   INST_2x(pslld, kX86InstIdPslld, X86XmmReg, X86XmmReg)
@@ -3003,14 +3400,14 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2i(psraw, kX86InstIdPsraw, X86XmmReg, Imm)
 
   //! Packed BYTE subtract (SSE2).
-  INST_2x(psubb, kX86InstIdPsubb, X86XmmReg, X86XmmReg)
+  INST_2f(psubb, kX86InstIdPsubb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psubb, kX86InstIdPsubb, X86XmmReg, X86Mem)
+  INST_2f(psubb, kX86InstIdPsubb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed DWORD subtract (SSE2).
-  INST_2x(psubd, kX86InstIdPsubd, X86XmmReg, X86XmmReg)
+  INST_2f(psubd, kX86InstIdPsubd, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psubd, kX86InstIdPsubd, X86XmmReg, X86Mem)
+  INST_2f(psubd, kX86InstIdPsubd, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed QWORD subtract (SSE2).
   INST_2x(psubq, kX86InstIdPsubq, X86MmReg, X86MmReg)
@@ -3018,19 +3415,19 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(psubq, kX86InstIdPsubq, X86MmReg, X86Mem)
 
   //! Packed QWORD subtract (SSE2).
-  INST_2x(psubq, kX86InstIdPsubq, X86XmmReg, X86XmmReg)
+  INST_2f(psubq, kX86InstIdPsubq, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psubq, kX86InstIdPsubq, X86XmmReg, X86Mem)
+  INST_2f(psubq, kX86InstIdPsubq, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD subtract (SSE2).
-  INST_2x(psubw, kX86InstIdPsubw, X86XmmReg, X86XmmReg)
+  INST_2f(psubw, kX86InstIdPsubw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psubw, kX86InstIdPsubw, X86XmmReg, X86Mem)
+  INST_2f(psubw, kX86InstIdPsubw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD to DWORD multiply and add (SSE2).
-  INST_2x(pmaddwd, kX86InstIdPmaddwd, X86XmmReg, X86XmmReg)
+  INST_2f(pmaddwd, kX86InstIdPmaddwd, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmaddwd, kX86InstIdPmaddwd, X86XmmReg, X86Mem)
+  INST_2f(pmaddwd, kX86InstIdPmaddwd, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed DWORD shuffle (SSE2).
   INST_3i(pshufd, kX86InstIdPshufd, X86XmmReg, X86XmmReg, Imm)
@@ -3072,69 +3469,69 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2i(psrlw, kX86InstIdPsrlw, X86XmmReg, Imm)
 
   //! Packed BYTE subtract with saturation (SSE2).
-  INST_2x(psubsb, kX86InstIdPsubsb, X86XmmReg, X86XmmReg)
+  INST_2f(psubsb, kX86InstIdPsubsb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psubsb, kX86InstIdPsubsb, X86XmmReg, X86Mem)
+  INST_2f(psubsb, kX86InstIdPsubsb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD subtract with saturation (SSE2).
-  INST_2x(psubsw, kX86InstIdPsubsw, X86XmmReg, X86XmmReg)
+  INST_2f(psubsw, kX86InstIdPsubsw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psubsw, kX86InstIdPsubsw, X86XmmReg, X86Mem)
+  INST_2f(psubsw, kX86InstIdPsubsw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed BYTE subtract with unsigned saturation (SSE2).
-  INST_2x(psubusb, kX86InstIdPsubusb, X86XmmReg, X86XmmReg)
+  INST_2f(psubusb, kX86InstIdPsubusb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psubusb, kX86InstIdPsubusb, X86XmmReg, X86Mem)
+  INST_2f(psubusb, kX86InstIdPsubusb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD subtract with unsigned saturation (SSE2).
-  INST_2x(psubusw, kX86InstIdPsubusw, X86XmmReg, X86XmmReg)
+  INST_2f(psubusw, kX86InstIdPsubusw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psubusw, kX86InstIdPsubusw, X86XmmReg, X86Mem)
+  INST_2f(psubusw, kX86InstIdPsubusw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Unpack high packed BYTEs to WORDs (SSE2).
-  INST_2x(punpckhbw, kX86InstIdPunpckhbw, X86XmmReg, X86XmmReg)
+  INST_2f(punpckhbw, kX86InstIdPunpckhbw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(punpckhbw, kX86InstIdPunpckhbw, X86XmmReg, X86Mem)
+  INST_2f(punpckhbw, kX86InstIdPunpckhbw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Unpack high packed DWORDs to QWORDs (SSE2).
-  INST_2x(punpckhdq, kX86InstIdPunpckhdq, X86XmmReg, X86XmmReg)
+  INST_2f(punpckhdq, kX86InstIdPunpckhdq, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(punpckhdq, kX86InstIdPunpckhdq, X86XmmReg, X86Mem)
+  INST_2f(punpckhdq, kX86InstIdPunpckhdq, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Unpack high packed QWORDs to DQWORD (SSE2).
-  INST_2x(punpckhqdq, kX86InstIdPunpckhqdq, X86XmmReg, X86XmmReg)
+  INST_2f(punpckhqdq, kX86InstIdPunpckhqdq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(punpckhqdq, kX86InstIdPunpckhqdq, X86XmmReg, X86Mem)
+  INST_2f(punpckhqdq, kX86InstIdPunpckhqdq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Unpack high packed WORDs to DWORDs (SSE2).
-  INST_2x(punpckhwd, kX86InstIdPunpckhwd, X86XmmReg, X86XmmReg)
+  INST_2f(punpckhwd, kX86InstIdPunpckhwd, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(punpckhwd, kX86InstIdPunpckhwd, X86XmmReg, X86Mem)
+  INST_2f(punpckhwd, kX86InstIdPunpckhwd, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Unpack low packed BYTEs to WORDs (SSE2).
-  INST_2x(punpcklbw, kX86InstIdPunpcklbw, X86XmmReg, X86XmmReg)
+  INST_2f(punpcklbw, kX86InstIdPunpcklbw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(punpcklbw, kX86InstIdPunpcklbw, X86XmmReg, X86Mem)
+  INST_2f(punpcklbw, kX86InstIdPunpcklbw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Unpack low packed DWORDs to QWORDs (SSE2).
-  INST_2x(punpckldq, kX86InstIdPunpckldq, X86XmmReg, X86XmmReg)
+  INST_2f(punpckldq, kX86InstIdPunpckldq, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(punpckldq, kX86InstIdPunpckldq, X86XmmReg, X86Mem)
+  INST_2f(punpckldq, kX86InstIdPunpckldq, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Unpack low packed QWORDs to DQWORD (SSE2).
-  INST_2x(punpcklqdq, kX86InstIdPunpcklqdq, X86XmmReg, X86XmmReg)
+  INST_2f(punpcklqdq, kX86InstIdPunpcklqdq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(punpcklqdq, kX86InstIdPunpcklqdq, X86XmmReg, X86Mem)
+  INST_2f(punpcklqdq, kX86InstIdPunpcklqdq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Unpack low packed WORDs to DWORDs (SSE2).
-  INST_2x(punpcklwd, kX86InstIdPunpcklwd, X86XmmReg, X86XmmReg)
+  INST_2f(punpcklwd, kX86InstIdPunpcklwd, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(punpcklwd, kX86InstIdPunpcklwd, X86XmmReg, X86Mem)
+  INST_2f(punpcklwd, kX86InstIdPunpcklwd, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed bitwise xor (SSE2).
-  INST_2x(pxor, kX86InstIdPxor, X86XmmReg, X86XmmReg)
+  INST_2f(pxor, kX86InstIdPxor, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pxor, kX86InstIdPxor, X86XmmReg, X86Mem)
+  INST_2f(pxor, kX86InstIdPxor, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Shuffle DP-FP (SSE2).
   INST_3i(shufpd, kX86InstIdShufpd, X86XmmReg, X86XmmReg, Imm)
@@ -3142,84 +3539,84 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(shufpd, kX86InstIdShufpd, X86XmmReg, X86Mem, Imm)
 
   //! Packed DP-FP square root (SSE2).
-  INST_2x(sqrtpd, kX86InstIdSqrtpd, X86XmmReg, X86XmmReg)
+  INST_2f(sqrtpd, kX86InstIdSqrtpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(sqrtpd, kX86InstIdSqrtpd, X86XmmReg, X86Mem)
+  INST_2f(sqrtpd, kX86InstIdSqrtpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar DP-FP square root (SSE2).
-  INST_2x(sqrtsd, kX86InstIdSqrtsd, X86XmmReg, X86XmmReg)
+  INST_2f(sqrtsd, kX86InstIdSqrtsd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(sqrtsd, kX86InstIdSqrtsd, X86XmmReg, X86Mem)
+  INST_2f(sqrtsd, kX86InstIdSqrtsd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DP-FP subtract (SSE2).
-  INST_2x(subpd, kX86InstIdSubpd, X86XmmReg, X86XmmReg)
+  INST_2f(subpd, kX86InstIdSubpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(subpd, kX86InstIdSubpd, X86XmmReg, X86Mem)
+  INST_2f(subpd, kX86InstIdSubpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar DP-FP subtract (SSE2).
-  INST_2x(subsd, kX86InstIdSubsd, X86XmmReg, X86XmmReg)
+  INST_2f(subsd, kX86InstIdSubsd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(subsd, kX86InstIdSubsd, X86XmmReg, X86Mem)
+  INST_2f(subsd, kX86InstIdSubsd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Scalar DP-FP unordered compare and set EFLAGS (SSE2).
-  INST_2x(ucomisd, kX86InstIdUcomisd, X86XmmReg, X86XmmReg)
+  INST_2f(ucomisd, kX86InstIdUcomisd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(ucomisd, kX86InstIdUcomisd, X86XmmReg, X86Mem)
+  INST_2f(ucomisd, kX86InstIdUcomisd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Unpack and interleave high packed DP-FP (SSE2).
-  INST_2x(unpckhpd, kX86InstIdUnpckhpd, X86XmmReg, X86XmmReg)
+  INST_2f(unpckhpd, kX86InstIdUnpckhpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(unpckhpd, kX86InstIdUnpckhpd, X86XmmReg, X86Mem)
+  INST_2f(unpckhpd, kX86InstIdUnpckhpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Unpack and interleave low packed DP-FP (SSE2).
-  INST_2x(unpcklpd, kX86InstIdUnpcklpd, X86XmmReg, X86XmmReg)
+  INST_2f(unpcklpd, kX86InstIdUnpcklpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(unpcklpd, kX86InstIdUnpcklpd, X86XmmReg, X86Mem)
+  INST_2f(unpcklpd, kX86InstIdUnpcklpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DP-FP bitwise xor (SSE2).
-  INST_2x(xorpd, kX86InstIdXorpd, X86XmmReg, X86XmmReg)
+  INST_2f(xorpd, kX86InstIdXorpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(xorpd, kX86InstIdXorpd, X86XmmReg, X86Mem)
+  INST_2f(xorpd, kX86InstIdXorpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   // --------------------------------------------------------------------------
   // [SSE3]
   // --------------------------------------------------------------------------
 
   //! Packed DP-FP add/subtract (SSE3).
-  INST_2x(addsubpd, kX86InstIdAddsubpd, X86XmmReg, X86XmmReg)
+  INST_2f(addsubpd, kX86InstIdAddsubpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(addsubpd, kX86InstIdAddsubpd, X86XmmReg, X86Mem)
+  INST_2f(addsubpd, kX86InstIdAddsubpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed SP-FP add/subtract (SSE3).
-  INST_2x(addsubps, kX86InstIdAddsubps, X86XmmReg, X86XmmReg)
+  INST_2f(addsubps, kX86InstIdAddsubps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(addsubps, kX86InstIdAddsubps, X86XmmReg, X86Mem)
+  INST_2f(addsubps, kX86InstIdAddsubps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Store truncated `fp0` to `short_or_int_or_long[o0]` and POP (FPU & SSE3).
   INST_1x(fisttp, kX86InstIdFisttp, X86Mem)
 
   //! Packed DP-FP horizontal add (SSE3).
-  INST_2x(haddpd, kX86InstIdHaddpd, X86XmmReg, X86XmmReg)
+  INST_2f(haddpd, kX86InstIdHaddpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(haddpd, kX86InstIdHaddpd, X86XmmReg, X86Mem)
+  INST_2f(haddpd, kX86InstIdHaddpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed SP-FP horizontal add (SSE3).
-  INST_2x(haddps, kX86InstIdHaddps, X86XmmReg, X86XmmReg)
+  INST_2f(haddps, kX86InstIdHaddps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(haddps, kX86InstIdHaddps, X86XmmReg, X86Mem)
+  INST_2f(haddps, kX86InstIdHaddps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DP-FP horizontal subtract (SSE3).
-  INST_2x(hsubpd, kX86InstIdHsubpd, X86XmmReg, X86XmmReg)
+  INST_2f(hsubpd, kX86InstIdHsubpd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(hsubpd, kX86InstIdHsubpd, X86XmmReg, X86Mem)
+  INST_2f(hsubpd, kX86InstIdHsubpd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed SP-FP horizontal subtract (SSE3).
-  INST_2x(hsubps, kX86InstIdHsubps, X86XmmReg, X86XmmReg)
+  INST_2f(hsubps, kX86InstIdHsubps, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(hsubps, kX86InstIdHsubps, X86XmmReg, X86Mem)
+  INST_2f(hsubps, kX86InstIdHsubps, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Load 128-bits unaligned (SSE3).
-  INST_2x(lddqu, kX86InstIdLddqu, X86XmmReg, X86Mem)
+  INST_2f(lddqu, kX86InstIdLddqu, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Setup monitor address (SSE3).
   INST_0x(monitor, kX86InstIdMonitor)
@@ -3230,14 +3627,14 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(movddup, kX86InstIdMovddup, X86XmmReg, X86Mem)
 
   //! Move packed SP-FP high and duplicate (SSE3).
-  INST_2x(movshdup, kX86InstIdMovshdup, X86XmmReg, X86XmmReg)
+  INST_2f(movshdup, kX86InstIdMovshdup, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(movshdup, kX86InstIdMovshdup, X86XmmReg, X86Mem)
+  INST_2f(movshdup, kX86InstIdMovshdup, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Move packed SP-FP low and duplicate (SSE3).
-  INST_2x(movsldup, kX86InstIdMovsldup, X86XmmReg, X86XmmReg)
+  INST_2f(movsldup, kX86InstIdMovsldup, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(movsldup, kX86InstIdMovsldup, X86XmmReg, X86Mem)
+  INST_2f(movsldup, kX86InstIdMovsldup, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Monitor wait (SSE3).
   INST_0x(mwait, kX86InstIdMwait)
@@ -3252,9 +3649,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(psignb, kX86InstIdPsignb, X86MmReg, X86Mem)
 
   //! Packed BYTE sign (SSSE3).
-  INST_2x(psignb, kX86InstIdPsignb, X86XmmReg, X86XmmReg)
+  INST_2f(psignb, kX86InstIdPsignb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psignb, kX86InstIdPsignb, X86XmmReg, X86Mem)
+  INST_2f(psignb, kX86InstIdPsignb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed DWORD sign (SSSE3).
   INST_2x(psignd, kX86InstIdPsignd, X86MmReg, X86MmReg)
@@ -3262,9 +3659,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(psignd, kX86InstIdPsignd, X86MmReg, X86Mem)
 
   //! Packed DWORD sign (SSSE3).
-  INST_2x(psignd, kX86InstIdPsignd, X86XmmReg, X86XmmReg)
+  INST_2f(psignd, kX86InstIdPsignd, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psignd, kX86InstIdPsignd, X86XmmReg, X86Mem)
+  INST_2f(psignd, kX86InstIdPsignd, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD sign (SSSE3).
   INST_2x(psignw, kX86InstIdPsignw, X86MmReg, X86MmReg)
@@ -3272,9 +3669,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(psignw, kX86InstIdPsignw, X86MmReg, X86Mem)
 
   //! Packed WORD sign (SSSE3).
-  INST_2x(psignw, kX86InstIdPsignw, X86XmmReg, X86XmmReg)
+  INST_2f(psignw, kX86InstIdPsignw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(psignw, kX86InstIdPsignw, X86XmmReg, X86Mem)
+  INST_2f(psignw, kX86InstIdPsignw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed DWORD horizontal add (SSSE3).
   INST_2x(phaddd, kX86InstIdPhaddd, X86MmReg, X86MmReg)
@@ -3282,9 +3679,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(phaddd, kX86InstIdPhaddd, X86MmReg, X86Mem)
 
   //! Packed DWORD horizontal add (SSSE3).
-  INST_2x(phaddd, kX86InstIdPhaddd, X86XmmReg, X86XmmReg)
+  INST_2f(phaddd, kX86InstIdPhaddd, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(phaddd, kX86InstIdPhaddd, X86XmmReg, X86Mem)
+  INST_2f(phaddd, kX86InstIdPhaddd, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD horizontal add with saturation (SSSE3).
   INST_2x(phaddsw, kX86InstIdPhaddsw, X86MmReg, X86MmReg)
@@ -3292,9 +3689,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(phaddsw, kX86InstIdPhaddsw, X86MmReg, X86Mem)
 
   //! Packed WORD horizontal add with saturation (SSSE3).
-  INST_2x(phaddsw, kX86InstIdPhaddsw, X86XmmReg, X86XmmReg)
+  INST_2f(phaddsw, kX86InstIdPhaddsw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(phaddsw, kX86InstIdPhaddsw, X86XmmReg, X86Mem)
+  INST_2f(phaddsw, kX86InstIdPhaddsw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD horizontal add (SSSE3).
   INST_2x(phaddw, kX86InstIdPhaddw, X86MmReg, X86MmReg)
@@ -3302,9 +3699,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(phaddw, kX86InstIdPhaddw, X86MmReg, X86Mem)
 
   //! Packed WORD horizontal add (SSSE3).
-  INST_2x(phaddw, kX86InstIdPhaddw, X86XmmReg, X86XmmReg)
+  INST_2f(phaddw, kX86InstIdPhaddw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(phaddw, kX86InstIdPhaddw, X86XmmReg, X86Mem)
+  INST_2f(phaddw, kX86InstIdPhaddw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed DWORD horizontal subtract (SSSE3).
   INST_2x(phsubd, kX86InstIdPhsubd, X86MmReg, X86MmReg)
@@ -3312,9 +3709,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(phsubd, kX86InstIdPhsubd, X86MmReg, X86Mem)
 
   //! Packed DWORD horizontal subtract (SSSE3).
-  INST_2x(phsubd, kX86InstIdPhsubd, X86XmmReg, X86XmmReg)
+  INST_2f(phsubd, kX86InstIdPhsubd, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(phsubd, kX86InstIdPhsubd, X86XmmReg, X86Mem)
+  INST_2f(phsubd, kX86InstIdPhsubd, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD horizontal subtract with saturation (SSSE3).
   INST_2x(phsubsw, kX86InstIdPhsubsw, X86MmReg, X86MmReg)
@@ -3322,9 +3719,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(phsubsw, kX86InstIdPhsubsw, X86MmReg, X86Mem)
 
   //! Packed WORD horizontal subtract with saturation (SSSE3).
-  INST_2x(phsubsw, kX86InstIdPhsubsw, X86XmmReg, X86XmmReg)
+  INST_2f(phsubsw, kX86InstIdPhsubsw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(phsubsw, kX86InstIdPhsubsw, X86XmmReg, X86Mem)
+  INST_2f(phsubsw, kX86InstIdPhsubsw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD horizontal subtract (SSSE3).
   INST_2x(phsubw, kX86InstIdPhsubw, X86MmReg, X86MmReg)
@@ -3332,9 +3729,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(phsubw, kX86InstIdPhsubw, X86MmReg, X86Mem)
 
   //! Packed WORD horizontal subtract (SSSE3).
-  INST_2x(phsubw, kX86InstIdPhsubw, X86XmmReg, X86XmmReg)
+  INST_2f(phsubw, kX86InstIdPhsubw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(phsubw, kX86InstIdPhsubw, X86XmmReg, X86Mem)
+  INST_2f(phsubw, kX86InstIdPhsubw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed multiply and add signed and unsigned bytes (SSSE3).
   INST_2x(pmaddubsw, kX86InstIdPmaddubsw, X86MmReg, X86MmReg)
@@ -3342,9 +3739,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(pmaddubsw, kX86InstIdPmaddubsw, X86MmReg, X86Mem)
 
   //! Packed multiply and add signed and unsigned bytes (SSSE3).
-  INST_2x(pmaddubsw, kX86InstIdPmaddubsw, X86XmmReg, X86XmmReg)
+  INST_2f(pmaddubsw, kX86InstIdPmaddubsw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmaddubsw, kX86InstIdPmaddubsw, X86XmmReg, X86Mem)
+  INST_2f(pmaddubsw, kX86InstIdPmaddubsw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed BYTE absolute value (SSSE3).
   INST_2x(pabsb, kX86InstIdPabsb, X86MmReg, X86MmReg)
@@ -3352,9 +3749,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(pabsb, kX86InstIdPabsb, X86MmReg, X86Mem)
 
   //! Packed BYTE absolute value (SSSE3).
-  INST_2x(pabsb, kX86InstIdPabsb, X86XmmReg, X86XmmReg)
+  INST_2f(pabsb, kX86InstIdPabsb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pabsb, kX86InstIdPabsb, X86XmmReg, X86Mem)
+  INST_2f(pabsb, kX86InstIdPabsb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed DWORD absolute value (SSSE3).
   INST_2x(pabsd, kX86InstIdPabsd, X86MmReg, X86MmReg)
@@ -3362,9 +3759,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(pabsd, kX86InstIdPabsd, X86MmReg, X86Mem)
 
   //! Packed DWORD absolute value (SSSE3).
-  INST_2x(pabsd, kX86InstIdPabsd, X86XmmReg, X86XmmReg)
+  INST_2f(pabsd, kX86InstIdPabsd, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pabsd, kX86InstIdPabsd, X86XmmReg, X86Mem)
+  INST_2f(pabsd, kX86InstIdPabsd, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD absolute value (SSSE3).
   INST_2x(pabsw, kX86InstIdPabsw, X86MmReg, X86MmReg)
@@ -3372,9 +3769,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(pabsw, kX86InstIdPabsw, X86MmReg, X86Mem)
 
   //! Packed WORD absolute value (SSSE3).
-  INST_2x(pabsw, kX86InstIdPabsw, X86XmmReg, X86XmmReg)
+  INST_2f(pabsw, kX86InstIdPabsw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pabsw, kX86InstIdPabsw, X86XmmReg, X86Mem)
+  INST_2f(pabsw, kX86InstIdPabsw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed WORD multiply high, round and scale (SSSE3).
   INST_2x(pmulhrsw, kX86InstIdPmulhrsw, X86MmReg, X86MmReg)
@@ -3382,9 +3779,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(pmulhrsw, kX86InstIdPmulhrsw, X86MmReg, X86Mem)
 
   //! Packed WORD multiply high, round and scale (SSSE3).
-  INST_2x(pmulhrsw, kX86InstIdPmulhrsw, X86XmmReg, X86XmmReg)
+  INST_2f(pmulhrsw, kX86InstIdPmulhrsw, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmulhrsw, kX86InstIdPmulhrsw, X86XmmReg, X86Mem)
+  INST_2f(pmulhrsw, kX86InstIdPmulhrsw, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed BYTE shuffle (SSSE3).
   INST_2x(pshufb, kX86InstIdPshufb, X86MmReg, X86MmReg)
@@ -3392,9 +3789,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_2x(pshufb, kX86InstIdPshufb, X86MmReg, X86Mem)
 
   //! Packed BYTE shuffle (SSSE3).
-  INST_2x(pshufb, kX86InstIdPshufb, X86XmmReg, X86XmmReg)
+  INST_2f(pshufb, kX86InstIdPshufb, _emitFastSimdP, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pshufb, kX86InstIdPshufb, X86XmmReg, X86Mem)
+  INST_2f(pshufb, kX86InstIdPshufb, _emitFastSimdP, X86XmmReg, X86Mem)
 
   //! Packed align right (SSSE3).
   INST_3i(palignr, kX86InstIdPalignr, X86MmReg, X86MmReg, Imm)
@@ -3459,9 +3856,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(mpsadbw, kX86InstIdMpsadbw, X86XmmReg, X86Mem, Imm)
 
   //! Pack DWORDs to WORDs with unsigned saturation (SSE4.1).
-  INST_2x(packusdw, kX86InstIdPackusdw, X86XmmReg, X86XmmReg)
+  INST_2f(packusdw, kX86InstIdPackusdw, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(packusdw, kX86InstIdPackusdw, X86XmmReg, X86Mem)
+  INST_2f(packusdw, kX86InstIdPackusdw, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed BYTE variable blend (SSE4.1).
   INST_2x(pblendvb, kX86InstIdPblendvb, X86XmmReg, X86XmmReg)
@@ -3474,9 +3871,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(pblendw, kX86InstIdPblendw, X86XmmReg, X86Mem, Imm)
 
   //! Packed QWORD compare for equality (SSE4.1).
-  INST_2x(pcmpeqq, kX86InstIdPcmpeqq, X86XmmReg, X86XmmReg)
+  INST_2f(pcmpeqq, kX86InstIdPcmpeqq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pcmpeqq, kX86InstIdPcmpeqq, X86XmmReg, X86Mem)
+  INST_2f(pcmpeqq, kX86InstIdPcmpeqq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Extract BYTE based on selector (SSE4.1).
   INST_3i(pextrb, kX86InstIdPextrb, X86GpReg, X86XmmReg, Imm)
@@ -3497,9 +3894,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(pextrw, kX86InstIdPextrw, X86Mem, X86XmmReg, Imm)
 
   //! Packed WORD horizontal minimum (SSE4.1).
-  INST_2x(phminposuw, kX86InstIdPhminposuw, X86XmmReg, X86XmmReg)
+  INST_2f(phminposuw, kX86InstIdPhminposuw, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(phminposuw, kX86InstIdPhminposuw, X86XmmReg, X86Mem)
+  INST_2f(phminposuw, kX86InstIdPhminposuw, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Insert BYTE based on selector (SSE4.1).
   INST_3i(pinsrb, kX86InstIdPinsrb, X86XmmReg, X86GpReg, Imm)
@@ -3517,119 +3914,119 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(pinsrq, kX86InstIdPinsrq, X86XmmReg, X86Mem, Imm)
 
   //! Packed BYTE maximum (SSE4.1).
-  INST_2x(pmaxsb, kX86InstIdPmaxsb, X86XmmReg, X86XmmReg)
+  INST_2f(pmaxsb, kX86InstIdPmaxsb, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmaxsb, kX86InstIdPmaxsb, X86XmmReg, X86Mem)
+  INST_2f(pmaxsb, kX86InstIdPmaxsb, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DWORD maximum (SSE4.1).
-  INST_2x(pmaxsd, kX86InstIdPmaxsd, X86XmmReg, X86XmmReg)
+  INST_2f(pmaxsd, kX86InstIdPmaxsd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmaxsd, kX86InstIdPmaxsd, X86XmmReg, X86Mem)
+  INST_2f(pmaxsd, kX86InstIdPmaxsd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DWORD unsigned maximum (SSE4.1).
-  INST_2x(pmaxud, kX86InstIdPmaxud, X86XmmReg, X86XmmReg)
+  INST_2f(pmaxud, kX86InstIdPmaxud, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmaxud, kX86InstIdPmaxud, X86XmmReg, X86Mem)
+  INST_2f(pmaxud, kX86InstIdPmaxud, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed WORD unsigned maximum (SSE4.1).
-  INST_2x(pmaxuw, kX86InstIdPmaxuw, X86XmmReg, X86XmmReg)
+  INST_2f(pmaxuw, kX86InstIdPmaxuw, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmaxuw, kX86InstIdPmaxuw, X86XmmReg, X86Mem)
+  INST_2f(pmaxuw, kX86InstIdPmaxuw, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed BYTE minimum (SSE4.1).
-  INST_2x(pminsb, kX86InstIdPminsb, X86XmmReg, X86XmmReg)
+  INST_2f(pminsb, kX86InstIdPminsb, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pminsb, kX86InstIdPminsb, X86XmmReg, X86Mem)
+  INST_2f(pminsb, kX86InstIdPminsb, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DWORD minimum (SSE4.1).
-  INST_2x(pminsd, kX86InstIdPminsd, X86XmmReg, X86XmmReg)
+  INST_2f(pminsd, kX86InstIdPminsd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pminsd, kX86InstIdPminsd, X86XmmReg, X86Mem)
+  INST_2f(pminsd, kX86InstIdPminsd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed WORD unsigned minimum (SSE4.1).
-  INST_2x(pminuw, kX86InstIdPminuw, X86XmmReg, X86XmmReg)
+  INST_2f(pminuw, kX86InstIdPminuw, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pminuw, kX86InstIdPminuw, X86XmmReg, X86Mem)
+  INST_2f(pminuw, kX86InstIdPminuw, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DWORD unsigned minimum (SSE4.1).
-  INST_2x(pminud, kX86InstIdPminud, X86XmmReg, X86XmmReg)
+  INST_2f(pminud, kX86InstIdPminud, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pminud, kX86InstIdPminud, X86XmmReg, X86Mem)
+  INST_2f(pminud, kX86InstIdPminud, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! BYTE to DWORD with sign extend (SSE4.1).
-  INST_2x(pmovsxbd, kX86InstIdPmovsxbd, X86XmmReg, X86XmmReg)
+  INST_2f(pmovsxbd, kX86InstIdPmovsxbd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovsxbd, kX86InstIdPmovsxbd, X86XmmReg, X86Mem)
+  INST_2f(pmovsxbd, kX86InstIdPmovsxbd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed BYTE to QWORD with sign extend (SSE4.1).
-  INST_2x(pmovsxbq, kX86InstIdPmovsxbq, X86XmmReg, X86XmmReg)
+  INST_2f(pmovsxbq, kX86InstIdPmovsxbq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovsxbq, kX86InstIdPmovsxbq, X86XmmReg, X86Mem)
+  INST_2f(pmovsxbq, kX86InstIdPmovsxbq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed BYTE to WORD with sign extend (SSE4.1).
-  INST_2x(pmovsxbw, kX86InstIdPmovsxbw, X86XmmReg, X86XmmReg)
+  INST_2f(pmovsxbw, kX86InstIdPmovsxbw, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovsxbw, kX86InstIdPmovsxbw, X86XmmReg, X86Mem)
+  INST_2f(pmovsxbw, kX86InstIdPmovsxbw, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DWORD to QWORD with sign extend (SSE4.1).
-  INST_2x(pmovsxdq, kX86InstIdPmovsxdq, X86XmmReg, X86XmmReg)
+  INST_2f(pmovsxdq, kX86InstIdPmovsxdq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovsxdq, kX86InstIdPmovsxdq, X86XmmReg, X86Mem)
+  INST_2f(pmovsxdq, kX86InstIdPmovsxdq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed WORD to DWORD with sign extend (SSE4.1).
-  INST_2x(pmovsxwd, kX86InstIdPmovsxwd, X86XmmReg, X86XmmReg)
+  INST_2f(pmovsxwd, kX86InstIdPmovsxwd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovsxwd, kX86InstIdPmovsxwd, X86XmmReg, X86Mem)
+  INST_2f(pmovsxwd, kX86InstIdPmovsxwd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed WORD to QWORD with sign extend (SSE4.1).
-  INST_2x(pmovsxwq, kX86InstIdPmovsxwq, X86XmmReg, X86XmmReg)
+  INST_2f(pmovsxwq, kX86InstIdPmovsxwq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovsxwq, kX86InstIdPmovsxwq, X86XmmReg, X86Mem)
+  INST_2f(pmovsxwq, kX86InstIdPmovsxwq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! BYTE to DWORD with zero extend (SSE4.1).
-  INST_2x(pmovzxbd, kX86InstIdPmovzxbd, X86XmmReg, X86XmmReg)
+  INST_2f(pmovzxbd, kX86InstIdPmovzxbd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovzxbd, kX86InstIdPmovzxbd, X86XmmReg, X86Mem)
+  INST_2f(pmovzxbd, kX86InstIdPmovzxbd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed BYTE to QWORD with zero extend (SSE4.1).
-  INST_2x(pmovzxbq, kX86InstIdPmovzxbq, X86XmmReg, X86XmmReg)
+  INST_2f(pmovzxbq, kX86InstIdPmovzxbq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovzxbq, kX86InstIdPmovzxbq, X86XmmReg, X86Mem)
+  INST_2f(pmovzxbq, kX86InstIdPmovzxbq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! BYTE to WORD with zero extend (SSE4.1).
-  INST_2x(pmovzxbw, kX86InstIdPmovzxbw, X86XmmReg, X86XmmReg)
+  INST_2f(pmovzxbw, kX86InstIdPmovzxbw, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovzxbw, kX86InstIdPmovzxbw, X86XmmReg, X86Mem)
+  INST_2f(pmovzxbw, kX86InstIdPmovzxbw, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DWORD to QWORD with zero extend (SSE4.1).
-  INST_2x(pmovzxdq, kX86InstIdPmovzxdq, X86XmmReg, X86XmmReg)
+  INST_2f(pmovzxdq, kX86InstIdPmovzxdq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovzxdq, kX86InstIdPmovzxdq, X86XmmReg, X86Mem)
+  INST_2f(pmovzxdq, kX86InstIdPmovzxdq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed WORD to DWORD with zero extend (SSE4.1).
-  INST_2x(pmovzxwd, kX86InstIdPmovzxwd, X86XmmReg, X86XmmReg)
+  INST_2f(pmovzxwd, kX86InstIdPmovzxwd, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovzxwd, kX86InstIdPmovzxwd, X86XmmReg, X86Mem)
+  INST_2f(pmovzxwd, kX86InstIdPmovzxwd, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed WORD to QWORD with zero extend (SSE4.1).
-  INST_2x(pmovzxwq, kX86InstIdPmovzxwq, X86XmmReg, X86XmmReg)
+  INST_2f(pmovzxwq, kX86InstIdPmovzxwq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmovzxwq, kX86InstIdPmovzxwq, X86XmmReg, X86Mem)
+  INST_2f(pmovzxwq, kX86InstIdPmovzxwq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DWORD to QWORD multiply (SSE4.1).
-  INST_2x(pmuldq, kX86InstIdPmuldq, X86XmmReg, X86XmmReg)
+  INST_2f(pmuldq, kX86InstIdPmuldq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmuldq, kX86InstIdPmuldq, X86XmmReg, X86Mem)
+  INST_2f(pmuldq, kX86InstIdPmuldq, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DWORD multiply low (SSE4.1).
-  INST_2x(pmulld, kX86InstIdPmulld, X86XmmReg, X86XmmReg)
+  INST_2f(pmulld, kX86InstIdPmulld, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pmulld, kX86InstIdPmulld, X86XmmReg, X86Mem)
+  INST_2f(pmulld, kX86InstIdPmulld, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Logical compare (SSE4.1).
-  INST_2x(ptest, kX86InstIdPtest, X86XmmReg, X86XmmReg)
+  INST_2f(ptest, kX86InstIdPtest, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(ptest, kX86InstIdPtest, X86XmmReg, X86Mem)
+  INST_2f(ptest, kX86InstIdPtest, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Packed DP-FP round (SSE4.1).
   INST_3i(roundpd, kX86InstIdRoundpd, X86XmmReg, X86XmmReg, Imm)
@@ -3681,9 +4078,9 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(pcmpistrm, kX86InstIdPcmpistrm, X86XmmReg, X86Mem, Imm)
 
   //! Packed QWORD compare if greater than (SSE4.2).
-  INST_2x(pcmpgtq, kX86InstIdPcmpgtq, X86XmmReg, X86XmmReg)
+  INST_2f(pcmpgtq, kX86InstIdPcmpgtq, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(pcmpgtq, kX86InstIdPcmpgtq, X86XmmReg, X86Mem)
+  INST_2f(pcmpgtq, kX86InstIdPcmpgtq, _emitFastSimd, X86XmmReg, X86Mem)
 
   // --------------------------------------------------------------------------
   // [SSE4a]
@@ -3709,29 +4106,29 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   // --------------------------------------------------------------------------
 
   //! Perform a single round of the AES decryption flow (AESNI).
-  INST_2x(aesdec, kX86InstIdAesdec, X86XmmReg, X86XmmReg)
+  INST_2f(aesdec, kX86InstIdAesdec, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(aesdec, kX86InstIdAesdec, X86XmmReg, X86Mem)
+  INST_2f(aesdec, kX86InstIdAesdec, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Perform the last round of the AES decryption flow (AESNI).
-  INST_2x(aesdeclast, kX86InstIdAesdeclast, X86XmmReg, X86XmmReg)
+  INST_2f(aesdeclast, kX86InstIdAesdeclast, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(aesdeclast, kX86InstIdAesdeclast, X86XmmReg, X86Mem)
+  INST_2f(aesdeclast, kX86InstIdAesdeclast, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Perform a single round of the AES encryption flow (AESNI).
-  INST_2x(aesenc, kX86InstIdAesenc, X86XmmReg, X86XmmReg)
+  INST_2f(aesenc, kX86InstIdAesenc, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(aesenc, kX86InstIdAesenc, X86XmmReg, X86Mem)
+  INST_2f(aesenc, kX86InstIdAesenc, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Perform the last round of the AES encryption flow (AESNI).
-  INST_2x(aesenclast, kX86InstIdAesenclast, X86XmmReg, X86XmmReg)
+  INST_2f(aesenclast, kX86InstIdAesenclast, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(aesenclast, kX86InstIdAesenclast, X86XmmReg, X86Mem)
+  INST_2f(aesenclast, kX86InstIdAesenclast, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Perform the InvMixColumns transformation (AESNI).
-  INST_2x(aesimc, kX86InstIdAesimc, X86XmmReg, X86XmmReg)
+  INST_2f(aesimc, kX86InstIdAesimc, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(aesimc, kX86InstIdAesimc, X86XmmReg, X86Mem)
+  INST_2f(aesimc, kX86InstIdAesimc, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Assist in expanding the AES cipher key (AESNI).
   INST_3i(aeskeygenassist, kX86InstIdAeskeygenassist, X86XmmReg, X86XmmReg, Imm)
@@ -3743,19 +4140,19 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   // --------------------------------------------------------------------------
 
   //! Perform an intermediate calculation for the next four SHA1 message DWORDs (SHA).
-  INST_2x(sha1msg1, kX86InstIdSha1msg1, X86XmmReg, X86XmmReg)
+  INST_2f(sha1msg1, kX86InstIdSha1msg1, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(sha1msg1, kX86InstIdSha1msg1, X86XmmReg, X86Mem)
+  INST_2f(sha1msg1, kX86InstIdSha1msg1, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Perform a final calculation for the next four SHA1 message DWORDs (SHA).
-  INST_2x(sha1msg2, kX86InstIdSha1msg2, X86XmmReg, X86XmmReg)
+  INST_2f(sha1msg2, kX86InstIdSha1msg2, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(sha1msg2, kX86InstIdSha1msg2, X86XmmReg, X86Mem)
+  INST_2f(sha1msg2, kX86InstIdSha1msg2, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Calculate SHA1 state variable E after four rounds (SHA).
-  INST_2x(sha1nexte, kX86InstIdSha1nexte, X86XmmReg, X86XmmReg)
+  INST_2f(sha1nexte, kX86InstIdSha1nexte, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(sha1nexte, kX86InstIdSha1nexte, X86XmmReg, X86Mem)
+  INST_2f(sha1nexte, kX86InstIdSha1nexte, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Perform four rounds of SHA1 operation (SHA).
   INST_3i(sha1rnds4, kX86InstIdSha1rnds4, X86XmmReg, X86XmmReg, Imm)
@@ -3763,19 +4160,19 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   INST_3i(sha1rnds4, kX86InstIdSha1rnds4, X86XmmReg, X86Mem, Imm)
 
   //! Perform an intermediate calculation for the next four SHA256 message DWORDs (SHA).
-  INST_2x(sha256msg1, kX86InstIdSha256msg1, X86XmmReg, X86XmmReg)
+  INST_2f(sha256msg1, kX86InstIdSha256msg1, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(sha256msg1, kX86InstIdSha256msg1, X86XmmReg, X86Mem)
+  INST_2f(sha256msg1, kX86InstIdSha256msg1, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Perform a final calculation for the next four SHA256 message DWORDs (SHA).
-  INST_2x(sha256msg2, kX86InstIdSha256msg2, X86XmmReg, X86XmmReg)
+  INST_2f(sha256msg2, kX86InstIdSha256msg2, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(sha256msg2, kX86InstIdSha256msg2, X86XmmReg, X86Mem)
+  INST_2f(sha256msg2, kX86InstIdSha256msg2, _emitFastSimd, X86XmmReg, X86Mem)
 
   //! Perform two rounds of SHA256 operation (SHA).
-  INST_2x(sha256rnds2, kX86InstIdSha256rnds2, X86XmmReg, X86XmmReg)
+  INST_2f(sha256rnds2, kX86InstIdSha256rnds2, _emitFastSimd, X86XmmReg, X86XmmReg)
   //! \overload
-  INST_2x(sha256rnds2, kX86InstIdSha256rnds2, X86XmmReg, X86Mem)
+  INST_2f(sha256rnds2, kX86InstIdSha256rnds2, _emitFastSimd, X86XmmReg, X86Mem)
 
   // --------------------------------------------------------------------------
   // [PCLMULQDQ]
@@ -6687,6 +7084,573 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
   //! \overload
   INST_3i(vcvtps2ph, kX86InstIdVcvtps2ph, X86Mem, X86YmmReg, Imm)
 
+  // --------------------------------------------------------------------------
+  // [AVX512]
+  // --------------------------------------------------------------------------
+
+  //! Bitwise AND NOT 16-bit masks (AVX512F).
+  INST_3x(kandnw, kX86InstIdKandnw, X86KReg, X86KReg, X86KReg)
+
+  //! Bitwise AND 16-bit masks (AVX512F).
+  INST_3x(kandw, kX86InstIdKandw, X86KReg, X86KReg, X86KReg)
+
+  //! Move 16-bit mask (AVX512F).
+  INST_2x(kmovw, kX86InstIdKmovw, X86KReg, X86KReg)
+  //! \overload
+  INST_2x(kmovw, kX86InstIdKmovw, X86KReg, X86Mem)
+  //! \overload
+  INST_2x(kmovw, kX86InstIdKmovw, X86Mem, X86KReg)
+  //! \overload
+  INST_2x(kmovw, kX86InstIdKmovw, X86KReg, X86GpReg)
+  //! \overload
+  INST_2x(kmovw, kX86InstIdKmovw, X86GpReg, X86KReg)
+
+  //! Bitwise NOT 16-bit mask (AVX512F).
+  INST_2x(knotw, kX86InstIdKnotw, X86KReg, X86KReg)
+
+  //! Bitwise OR 16-bit masks and set flags (AVX512F).
+  INST_2x(kortestw, kX86InstIdKortestw, X86KReg, X86KReg)
+
+  //! Bitwise OR 16-bit masks (AVX512F).
+  INST_3x(korw, kX86InstIdKorw, X86KReg, X86KReg, X86KReg)
+
+  //! Bitwise XNOR 16-bit masks (AVX512F).
+  INST_3x(kxnorw, kX86InstIdKxnorw, X86KReg, X86KReg, X86KReg)
+
+  //! Bitwise XOR 16-bit masks (AVX512F).
+  INST_3x(kxorw, kX86InstIdKxorw, X86KReg, X86KReg, X86KReg)
+
+  //! Packed DP-FP add (AVX512F).
+  INST_3x(vaddpd, kX86InstIdVaddpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vaddpd, kX86InstIdVaddpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP add (AVX512F).
+  INST_3x(vaddps, kX86InstIdVaddps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vaddps, kX86InstIdVaddps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Broadcast SP-FP element (AVX512F).
+  INST_2x(vbroadcastss, kX86InstIdVbroadcastss, X86ZmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vbroadcastss, kX86InstIdVbroadcastss, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP divide (AVX512F).
+  INST_3x(vdivpd, kX86InstIdVdivpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vdivpd, kX86InstIdVdivpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP divide (AVX512F).
+  INST_3x(vdivps, kX86InstIdVdivps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vdivps, kX86InstIdVdivps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP maximum (AVX512F).
+  INST_3x(vmaxpd, kX86InstIdVmaxpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vmaxpd, kX86InstIdVmaxpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP maximum (AVX512F).
+  INST_3x(vmaxps, kX86InstIdVmaxps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vmaxps, kX86InstIdVmaxps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP minimum (AVX512F).
+  INST_3x(vminpd, kX86InstIdVminpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vminpd, kX86InstIdVminpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP minimum (AVX512F).
+  INST_3x(vminps, kX86InstIdVminps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vminps, kX86InstIdVminps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Move packed DP-FP aligned (AVX512F).
+  INST_2x(vmovapd, kX86InstIdVmovapd, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovapd, kX86InstIdVmovapd, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovapd, kX86InstIdVmovapd, X86Mem, X86ZmmReg)
+
+  //! Move packed SP-FP aligned (AVX512F).
+  INST_2x(vmovaps, kX86InstIdVmovaps, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovaps, kX86InstIdVmovaps, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovaps, kX86InstIdVmovaps, X86Mem, X86ZmmReg)
+
+  //! Move packed DWORDs aligned (AVX512F).
+  INST_2x(vmovdqa32, kX86InstIdVmovdqa32, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vmovdqa32, kX86InstIdVmovdqa32, X86XmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqa32, kX86InstIdVmovdqa32, X86Mem, X86XmmReg)
+  //! \overload
+  INST_2x(vmovdqa32, kX86InstIdVmovdqa32, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_2x(vmovdqa32, kX86InstIdVmovdqa32, X86YmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqa32, kX86InstIdVmovdqa32, X86Mem, X86YmmReg)
+  //! \overload
+  INST_2x(vmovdqa32, kX86InstIdVmovdqa32, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovdqa32, kX86InstIdVmovdqa32, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqa32, kX86InstIdVmovdqa32, X86Mem, X86ZmmReg)
+
+  //! Move packed QWORDs aligned (AVX512F).
+  INST_2x(vmovdqa64, kX86InstIdVmovdqa64, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vmovdqa64, kX86InstIdVmovdqa64, X86XmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqa64, kX86InstIdVmovdqa64, X86Mem, X86XmmReg)
+  //! \overload
+  INST_2x(vmovdqa64, kX86InstIdVmovdqa64, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_2x(vmovdqa64, kX86InstIdVmovdqa64, X86YmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqa64, kX86InstIdVmovdqa64, X86Mem, X86YmmReg)
+  //! \overload
+  INST_2x(vmovdqa64, kX86InstIdVmovdqa64, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovdqa64, kX86InstIdVmovdqa64, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqa64, kX86InstIdVmovdqa64, X86Mem, X86ZmmReg)
+
+  //! Move packed DWORDs unaligned (AVX512F).
+  INST_2x(vmovdqu32, kX86InstIdVmovdqu32, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vmovdqu32, kX86InstIdVmovdqu32, X86XmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqu32, kX86InstIdVmovdqu32, X86Mem, X86XmmReg)
+  //! \overload
+  INST_2x(vmovdqu32, kX86InstIdVmovdqu32, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_2x(vmovdqu32, kX86InstIdVmovdqu32, X86YmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqu32, kX86InstIdVmovdqu32, X86Mem, X86YmmReg)
+  //! \overload
+  INST_2x(vmovdqu32, kX86InstIdVmovdqu32, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovdqu32, kX86InstIdVmovdqu32, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqu32, kX86InstIdVmovdqu32, X86Mem, X86ZmmReg)
+
+  //! Move packed QWORDs unaligned (AVX512F).
+  INST_2x(vmovdqu64, kX86InstIdVmovdqu64, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vmovdqu64, kX86InstIdVmovdqu64, X86XmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqu64, kX86InstIdVmovdqu64, X86Mem, X86XmmReg)
+  //! \overload
+  INST_2x(vmovdqu64, kX86InstIdVmovdqu64, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_2x(vmovdqu64, kX86InstIdVmovdqu64, X86YmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqu64, kX86InstIdVmovdqu64, X86Mem, X86YmmReg)
+  //! \overload
+  INST_2x(vmovdqu64, kX86InstIdVmovdqu64, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovdqu64, kX86InstIdVmovdqu64, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovdqu64, kX86InstIdVmovdqu64, X86Mem, X86ZmmReg)
+
+  //! Move packed DP-FP unaligned (AVX512F).
+  INST_2x(vmovupd, kX86InstIdVmovupd, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovupd, kX86InstIdVmovupd, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovupd, kX86InstIdVmovupd, X86Mem, X86ZmmReg)
+
+  //! Move packed SP-FP unaligned (AVX512F).
+  INST_2x(vmovups, kX86InstIdVmovups, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vmovups, kX86InstIdVmovups, X86ZmmReg, X86Mem)
+  //! \overload
+  INST_2x(vmovups, kX86InstIdVmovups, X86Mem, X86ZmmReg)
+
+  //! Packed DP-FP multiply (AVX512F).
+  INST_3x(vmulpd, kX86InstIdVmulpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vmulpd, kX86InstIdVmulpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP multiply (AVX512F).
+  INST_3x(vmulps, kX86InstIdVmulps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vmulps, kX86InstIdVmulps, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD add (AVX512F).
+  INST_3x(vpaddd, kX86InstIdVpaddd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpaddd, kX86InstIdVpaddd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed QWORD add (AVX512F).
+  INST_3x(vpaddq, kX86InstIdVpaddq, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpaddq, kX86InstIdVpaddq, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD bitwise and (AVX512F).
+  INST_3x(vpandd, kX86InstIdVpandd, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpandd, kX86InstIdVpandd, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpandd, kX86InstIdVpandd, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpandd, kX86InstIdVpandd, X86YmmReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpandd, kX86InstIdVpandd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpandd, kX86InstIdVpandd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD bitwise and-not (AVX512F).
+  INST_3x(vpandnd, kX86InstIdVpandnd, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpandnd, kX86InstIdVpandnd, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpandnd, kX86InstIdVpandnd, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpandnd, kX86InstIdVpandnd, X86YmmReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpandnd, kX86InstIdVpandnd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpandnd, kX86InstIdVpandnd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed QWORD bitwise and-not (AVX512F).
+  INST_3x(vpandnq, kX86InstIdVpandnq, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpandnq, kX86InstIdVpandnq, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpandnq, kX86InstIdVpandnq, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpandnq, kX86InstIdVpandnq, X86YmmReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpandnq, kX86InstIdVpandnq, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpandnq, kX86InstIdVpandnq, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed QWORD bitwise and (AVX512F).
+  INST_3x(vpandq, kX86InstIdVpandq, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpandq, kX86InstIdVpandq, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpandq, kX86InstIdVpandq, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpandq, kX86InstIdVpandq, X86YmmReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpandq, kX86InstIdVpandq, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpandq, kX86InstIdVpandq, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Broadcast DWORD element (AVX512F).
+  INST_2x(vpbroadcastd, kX86InstIdVpbroadcastd, X86ZmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vpbroadcastd, kX86InstIdVpbroadcastd, X86ZmmReg, X86Mem)
+
+  //! Broadcast QWORD element (AVX512F).
+  INST_2x(vpbroadcastq, kX86InstIdVpbroadcastq, X86ZmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vpbroadcastq, kX86InstIdVpbroadcastq, X86ZmmReg, X86Mem)
+
+  //! Compare packed signed DWORDs to mask (AVX512F).
+  INST_4i(vpcmpd, kX86InstIdVpcmpd, X86KReg, X86XmmReg, X86XmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpd, kX86InstIdVpcmpd, X86KReg, X86XmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpcmpd, kX86InstIdVpcmpd, X86KReg, X86YmmReg, X86YmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpd, kX86InstIdVpcmpd, X86KReg, X86YmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpcmpd, kX86InstIdVpcmpd, X86KReg, X86ZmmReg, X86ZmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpd, kX86InstIdVpcmpd, X86KReg, X86ZmmReg, X86Mem, Imm)
+
+  //! Packed DWORD compare for equality to mask (AVX512F).
+  INST_3x(vpcmpeqd, kX86InstIdVpcmpeqd, X86KReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpcmpeqd, kX86InstIdVpcmpeqd, X86KReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpcmpeqd, kX86InstIdVpcmpeqd, X86KReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpcmpeqd, kX86InstIdVpcmpeqd, X86KReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpcmpeqd, kX86InstIdVpcmpeqd, X86KReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpcmpeqd, kX86InstIdVpcmpeqd, X86KReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD compare if greater than to mask (AVX512F).
+  INST_3x(vpcmpgtd, kX86InstIdVpcmpgtd, X86KReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpcmpgtd, kX86InstIdVpcmpgtd, X86KReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpcmpgtd, kX86InstIdVpcmpgtd, X86KReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpcmpgtd, kX86InstIdVpcmpgtd, X86KReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpcmpgtd, kX86InstIdVpcmpgtd, X86KReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpcmpgtd, kX86InstIdVpcmpgtd, X86KReg, X86ZmmReg, X86Mem)
+
+  //! Compare packed signed QWORDs to mask (AVX512F).
+  INST_4i(vpcmpq, kX86InstIdVpcmpq, X86KReg, X86XmmReg, X86XmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpq, kX86InstIdVpcmpq, X86KReg, X86XmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpcmpq, kX86InstIdVpcmpq, X86KReg, X86YmmReg, X86YmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpq, kX86InstIdVpcmpq, X86KReg, X86YmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpcmpq, kX86InstIdVpcmpq, X86KReg, X86ZmmReg, X86ZmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpq, kX86InstIdVpcmpq, X86KReg, X86ZmmReg, X86Mem, Imm)
+
+  //! Compare packed unsigned DWORDs to mask (AVX512F).
+  INST_4i(vpcmpud, kX86InstIdVpcmpud, X86KReg, X86XmmReg, X86XmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpud, kX86InstIdVpcmpud, X86KReg, X86XmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpcmpud, kX86InstIdVpcmpud, X86KReg, X86YmmReg, X86YmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpud, kX86InstIdVpcmpud, X86KReg, X86YmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpcmpud, kX86InstIdVpcmpud, X86KReg, X86ZmmReg, X86ZmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpud, kX86InstIdVpcmpud, X86KReg, X86ZmmReg, X86Mem, Imm)
+
+  //! Compare packed unsigned QWORDs to mask (AVX512F).
+  INST_4i(vpcmpuq, kX86InstIdVpcmpuq, X86KReg, X86XmmReg, X86XmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpuq, kX86InstIdVpcmpuq, X86KReg, X86XmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpcmpuq, kX86InstIdVpcmpuq, X86KReg, X86YmmReg, X86YmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpuq, kX86InstIdVpcmpuq, X86KReg, X86YmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpcmpuq, kX86InstIdVpcmpuq, X86KReg, X86ZmmReg, X86ZmmReg, Imm)
+  //! \overload
+  INST_4i(vpcmpuq, kX86InstIdVpcmpuq, X86KReg, X86ZmmReg, X86Mem, Imm)
+
+  //! Store sparse packed DWORDs into dense memory/register (AVX512F).
+  INST_2x(vpcompressd, kX86InstIdVpcompressd, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vpcompressd, kX86InstIdVpcompressd, X86Mem, X86XmmReg)
+  //! \overload
+  INST_2x(vpcompressd, kX86InstIdVpcompressd, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_2x(vpcompressd, kX86InstIdVpcompressd, X86Mem, X86YmmReg)
+  //! \overload
+  INST_2x(vpcompressd, kX86InstIdVpcompressd, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vpcompressd, kX86InstIdVpcompressd, X86Mem, X86ZmmReg)
+
+  //! Store sparse packed QWORDs into dense memory/register (AVX512F).
+  INST_2x(vpcompressq, kX86InstIdVpcompressq, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vpcompressq, kX86InstIdVpcompressq, X86Mem, X86XmmReg)
+  //! \overload
+  INST_2x(vpcompressq, kX86InstIdVpcompressq, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_2x(vpcompressq, kX86InstIdVpcompressq, X86Mem, X86YmmReg)
+  //! \overload
+  INST_2x(vpcompressq, kX86InstIdVpcompressq, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vpcompressq, kX86InstIdVpcompressq, X86Mem, X86ZmmReg)
+
+  //! Load sparse packed DWORDs from dense memory/register (AVX512F).
+  INST_2x(vpexpandd, kX86InstIdVpexpandd, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vpexpandd, kX86InstIdVpexpandd, X86XmmReg, X86Mem)
+  //! \overload
+  INST_2x(vpexpandd, kX86InstIdVpexpandd, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_2x(vpexpandd, kX86InstIdVpexpandd, X86YmmReg, X86Mem)
+  //! \overload
+  INST_2x(vpexpandd, kX86InstIdVpexpandd, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vpexpandd, kX86InstIdVpexpandd, X86ZmmReg, X86Mem)
+
+  //! Load sparse packed QWORDs from dense memory/register (AVX512F).
+  INST_2x(vpexpandq, kX86InstIdVpexpandq, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_2x(vpexpandq, kX86InstIdVpexpandq, X86XmmReg, X86Mem)
+  //! \overload
+  INST_2x(vpexpandq, kX86InstIdVpexpandq, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_2x(vpexpandq, kX86InstIdVpexpandq, X86YmmReg, X86Mem)
+  //! \overload
+  INST_2x(vpexpandq, kX86InstIdVpexpandq, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vpexpandq, kX86InstIdVpexpandq, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD multiply and store low result (AVX512F).
+  INST_3x(vpmulld, kX86InstIdVpmulld, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpmulld, kX86InstIdVpmulld, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD bitwise or (AVX512F).
+  INST_3x(vpord, kX86InstIdVpord, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpord, kX86InstIdVpord, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpord, kX86InstIdVpord, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpord, kX86InstIdVpord, X86YmmReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpord, kX86InstIdVpord, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpord, kX86InstIdVpord, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed QWORD bitwise or (AVX512F).
+  INST_3x(vporq, kX86InstIdVporq, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vporq, kX86InstIdVporq, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vporq, kX86InstIdVporq, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vporq, kX86InstIdVporq, X86YmmReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vporq, kX86InstIdVporq, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vporq, kX86InstIdVporq, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD shuffle (AVX512F).
+  INST_3i(vpshufd, kX86InstIdVpshufd, X86ZmmReg, X86ZmmReg, Imm)
+  //! \overload
+  INST_3i(vpshufd, kX86InstIdVpshufd, X86ZmmReg, X86Mem, Imm)
+
+  //! Packed DWORD subtract (AVX512F).
+  INST_3x(vpsubd, kX86InstIdVpsubd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpsubd, kX86InstIdVpsubd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed QWORD subtract (AVX512F).
+  INST_3x(vpsubq, kX86InstIdVpsubq, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpsubq, kX86InstIdVpsubq, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Bitwise ternary logic of packed DWORDs (AVX512F).
+  INST_4i(vpternlogd, kX86InstIdVpternlogd, X86XmmReg, X86XmmReg, X86XmmReg, Imm)
+  //! \overload
+  INST_4i(vpternlogd, kX86InstIdVpternlogd, X86XmmReg, X86XmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpternlogd, kX86InstIdVpternlogd, X86YmmReg, X86YmmReg, X86YmmReg, Imm)
+  //! \overload
+  INST_4i(vpternlogd, kX86InstIdVpternlogd, X86YmmReg, X86YmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpternlogd, kX86InstIdVpternlogd, X86ZmmReg, X86ZmmReg, X86ZmmReg, Imm)
+  //! \overload
+  INST_4i(vpternlogd, kX86InstIdVpternlogd, X86ZmmReg, X86ZmmReg, X86Mem, Imm)
+
+  //! Bitwise ternary logic of packed QWORDs (AVX512F).
+  INST_4i(vpternlogq, kX86InstIdVpternlogq, X86XmmReg, X86XmmReg, X86XmmReg, Imm)
+  //! \overload
+  INST_4i(vpternlogq, kX86InstIdVpternlogq, X86XmmReg, X86XmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpternlogq, kX86InstIdVpternlogq, X86YmmReg, X86YmmReg, X86YmmReg, Imm)
+  //! \overload
+  INST_4i(vpternlogq, kX86InstIdVpternlogq, X86YmmReg, X86YmmReg, X86Mem, Imm)
+  //! \overload
+  INST_4i(vpternlogq, kX86InstIdVpternlogq, X86ZmmReg, X86ZmmReg, X86ZmmReg, Imm)
+  //! \overload
+  INST_4i(vpternlogq, kX86InstIdVpternlogq, X86ZmmReg, X86ZmmReg, X86Mem, Imm)
+
+  //! Logical AND of packed DWORDs and set mask (AVX512F).
+  INST_3x(vptestmd, kX86InstIdVptestmd, X86KReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vptestmd, kX86InstIdVptestmd, X86KReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vptestmd, kX86InstIdVptestmd, X86KReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vptestmd, kX86InstIdVptestmd, X86KReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vptestmd, kX86InstIdVptestmd, X86KReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vptestmd, kX86InstIdVptestmd, X86KReg, X86ZmmReg, X86Mem)
+
+  //! Logical AND of packed QWORDs and set mask (AVX512F).
+  INST_3x(vptestmq, kX86InstIdVptestmq, X86KReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vptestmq, kX86InstIdVptestmq, X86KReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vptestmq, kX86InstIdVptestmq, X86KReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vptestmq, kX86InstIdVptestmq, X86KReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vptestmq, kX86InstIdVptestmq, X86KReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vptestmq, kX86InstIdVptestmq, X86KReg, X86ZmmReg, X86Mem)
+
+  //! Logical NAND of packed DWORDs and set mask (AVX512F).
+  INST_3x(vptestnmd, kX86InstIdVptestnmd, X86KReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vptestnmd, kX86InstIdVptestnmd, X86KReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vptestnmd, kX86InstIdVptestnmd, X86KReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vptestnmd, kX86InstIdVptestnmd, X86KReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vptestnmd, kX86InstIdVptestnmd, X86KReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vptestnmd, kX86InstIdVptestnmd, X86KReg, X86ZmmReg, X86Mem)
+
+  //! Logical NAND of packed QWORDs and set mask (AVX512F).
+  INST_3x(vptestnmq, kX86InstIdVptestnmq, X86KReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vptestnmq, kX86InstIdVptestnmq, X86KReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vptestnmq, kX86InstIdVptestnmq, X86KReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vptestnmq, kX86InstIdVptestnmq, X86KReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vptestnmq, kX86InstIdVptestnmq, X86KReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vptestnmq, kX86InstIdVptestnmq, X86KReg, X86ZmmReg, X86Mem)
+
+  //! Packed DWORD bitwise xor (AVX512F).
+  INST_3x(vpxord, kX86InstIdVpxord, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpxord, kX86InstIdVpxord, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpxord, kX86InstIdVpxord, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpxord, kX86InstIdVpxord, X86YmmReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpxord, kX86InstIdVpxord, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpxord, kX86InstIdVpxord, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed QWORD bitwise xor (AVX512F).
+  INST_3x(vpxorq, kX86InstIdVpxorq, X86XmmReg, X86XmmReg, X86XmmReg)
+  //! \overload
+  INST_3x(vpxorq, kX86InstIdVpxorq, X86XmmReg, X86XmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpxorq, kX86InstIdVpxorq, X86YmmReg, X86YmmReg, X86YmmReg)
+  //! \overload
+  INST_3x(vpxorq, kX86InstIdVpxorq, X86YmmReg, X86YmmReg, X86Mem)
+  //! \overload
+  INST_3x(vpxorq, kX86InstIdVpxorq, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vpxorq, kX86InstIdVpxorq, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP square root (AVX512F).
+  INST_2x(vsqrtpd, kX86InstIdVsqrtpd, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vsqrtpd, kX86InstIdVsqrtpd, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP square root (AVX512F).
+  INST_2x(vsqrtps, kX86InstIdVsqrtps, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_2x(vsqrtps, kX86InstIdVsqrtps, X86ZmmReg, X86Mem)
+
+  //! Packed DP-FP subtract (AVX512F).
+  INST_3x(vsubpd, kX86InstIdVsubpd, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vsubpd, kX86InstIdVsubpd, X86ZmmReg, X86ZmmReg, X86Mem)
+
+  //! Packed SP-FP subtract (AVX512F).
+  INST_3x(vsubps, kX86InstIdVsubps, X86ZmmReg, X86ZmmReg, X86ZmmReg)
+  //! \overload
+  INST_3x(vsubps, kX86InstIdVsubps, X86ZmmReg, X86ZmmReg, X86Mem)
+
 #undef INST_0x
 
 #undef INST_1x
@@ -6695,6 +7659,8 @@ class ASMJIT_VIRTAPI X86Assembler : public Assembler {
 
 #undef INST_2x
 #undef INST_2i
+#undef INST_2f
+#undef INST_2fi
 #undef INST_2cc
 
 #undef INST_3x
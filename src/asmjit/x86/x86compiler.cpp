@@ -13,6 +13,8 @@
 
 // [Dependencies]
 #include "../base/containers.h"
+#include "../base/cpuinfo.h"
+#include "../base/runtime.h"
 #include "../base/utils.h"
 #include "../x86/x86assembler.h"
 #include "../x86/x86compiler.h"
@@ -133,6 +135,26 @@ const uint8_t _x64VarMapping[kX86VarTypeCount] = {
 };
 #endif // ASMJIT_BUILD_X64
 
+// ============================================================================
+// [asmjit::X86TuneInfo]
+// ============================================================================
+
+#define F(flag) kX86TuneFusible##flag
+const X86TuneInfo _x86TuneInfo[kX86TuneArchCount] = {
+  // Fusible                                  | Alu | Lea | Lea3 | Partial | AvxSse | VZU | YmmSplit
+  { F(CmpTest)                                , 1   , 1   , 2    , 1       , 10     , 1   , 1 }, // Auto.
+  { F(CmpTest)                                , 1   , 1   , 2    , 1       , 10     , 1   , 1 }, // Generic.
+  { F(CmpTest)                                , 1   , 1   , 1    , 6       , 0      , 0   , 0 }, // Core2.
+  { F(CmpTest) | F(AddSub) | F(And) | F(IncDec), 1   , 1   , 3    , 1       , 70     , 1   , 0 }, // SandyBridge.
+  { F(CmpTest) | F(AddSub) | F(And) | F(IncDec), 1   , 1   , 3    , 1       , 10     , 1   , 0 }, // Skylake.
+  { 0                                         , 1   , 4   , 4    , 1       , 0      , 0   , 0 }, // Atom.
+  { 0                                         , 1   , 1   , 2    , 1       , 0      , 0   , 0 }, // K10.
+  { F(CmpTest)                                , 1   , 1   , 2    , 1       , 0      , 4   , 1 }, // Bulldozer.
+  { 0                                         , 1   , 1   , 2    , 1       , 0      , 1   , 1 }, // Jaguar.
+  { F(CmpTest)                                , 1   , 1   , 2    , 1       , 0      , 1   , 1 }  // Zen.
+};
+#undef F
+
 // ============================================================================
 // [asmjit::X86CallNode - Arg / Ret]
 // ============================================================================
@@ -159,6 +181,9 @@ bool X86CallNode::_setRet(uint32_t i, const Operand& op) noexcept {
 
 X86Compiler::X86Compiler(X86Assembler* assembler) noexcept
   : Compiler(),
+    _context(nullptr),
+    _tuneOptions(0),
+    _tuneArch(kX86TuneArchAuto),
     zax(NoInit),
     zcx(NoInit),
     zdx(NoInit),
@@ -236,6 +261,15 @@ Error X86Compiler::attach(Assembler* assembler) noexcept {
 void X86Compiler::reset(bool releaseMemory) noexcept {
   Compiler::reset(releaseMemory);
 
+  if (releaseMemory && _context != nullptr) {
+    _context->~X86Context();
+    ASMJIT_FREE(_context);
+    _context = nullptr;
+  }
+
+  _tuneOptions = 0;
+  _tuneArch = kX86TuneArchAuto;
+
   _regCount.reset();
   zax = x86::noGpReg;
   zcx = x86::noGpReg;
@@ -247,10 +281,290 @@ void X86Compiler::reset(bool releaseMemory) noexcept {
   zdi = x86::noGpReg;
 }
 
+// ============================================================================
+// [asmjit::X86Compiler - Tune]
+// ============================================================================
+
+uint32_t X86Compiler::getResolvedTuneArch() const noexcept {
+  if (_tuneArch != kX86TuneArchAuto)
+    return _tuneArch;
+
+  Runtime* runtime = getRuntime();
+  if (runtime == nullptr)
+    return kX86TuneArchGeneric;
+
+  return detectTuneArch(runtime->getCpuInfo());
+}
+
+uint32_t X86Compiler::detectTuneArch(const CpuInfo& cpuInfo) noexcept {
+  uint32_t family = cpuInfo.getFamily();
+  uint32_t model = cpuInfo.getModel();
+
+  switch (cpuInfo.getVendorId()) {
+    case CpuInfo::kVendorIntel: {
+      if (family != 0x06)
+        return kX86TuneArchGeneric;
+
+      switch (model) {
+        // Core2, Nehalem, and Westmere.
+        case 0x0F: case 0x16: case 0x17: case 0x1D:
+        case 0x1A: case 0x1E: case 0x1F: case 0x2E:
+        case 0x25: case 0x2C: case 0x2F:
+          return kX86TuneArchCore2;
+
+        // Sandy Bridge and Ivy Bridge.
+        case 0x2A: case 0x2D: case 0x3A: case 0x3E:
+          return kX86TuneArchSandyBridge;
+
+        // Bonnell, Saltwell, Silvermont, Airmont, and Goldmont.
+        case 0x1C: case 0x26: case 0x27: case 0x35: case 0x36:
+        case 0x37: case 0x4A: case 0x4C: case 0x4D: case 0x5A:
+        case 0x5C: case 0x5D: case 0x5F: case 0x7A:
+          return kX86TuneArchAtom;
+      }
+
+      // Newer big cores (Haswell and later) are recognized by AVX2.
+      if (cpuInfo.hasFeature(CpuInfo::kX86FeatureAVX2))
+        return kX86TuneArchSkylake;
+
+      if (cpuInfo.hasFeature(CpuInfo::kX86FeatureAVX))
+        return kX86TuneArchSandyBridge;
+
+      return kX86TuneArchGeneric;
+    }
+
+    case CpuInfo::kVendorAMD: {
+      switch (family) {
+        case 0x10:
+        case 0x11:
+        case 0x12:
+          return kX86TuneArchK10;
+
+        case 0x14:
+        case 0x16:
+          return kX86TuneArchJaguar;
+
+        case 0x15:
+          return kX86TuneArchBulldozer;
+      }
+
+      if (family >= 0x17)
+        return kX86TuneArchZen;
+
+      return kX86TuneArchGeneric;
+    }
+
+    default:
+      return kX86TuneArchGeneric;
+  }
+}
+
 // ============================================================================
 // [asmjit::X86Compiler - Finalize]
 // ============================================================================
 
+//! \internal
+//!
+//! Count of functions prepared per thread before they are analyzed.
+static const uint32_t kX86CompilerFuncsPerThread = 4;
+
+//! \internal
+//!
+//! Functions prepared by `X86Compiler_finalizeParallel()`, analyzed by all
+//! threads. Worker threads live for the whole `finalize()` and wait for the
+//! next batch between batches.
+struct X86CompilerBatch {
+  //! Lock that protects the members below.
+  Lock lock;
+  //! Signaled when a new batch is ready or workers should quit.
+  Condition ready;
+  //! Signaled when all contexts of the batch were analyzed.
+  Condition done;
+  //! Contexts of prepared functions (context of a non-function part has no
+  //! function).
+  X86Context** contexts;
+  //! Errors returned by `Context::analyze()`.
+  Error* errors;
+  //! Count of contexts.
+  uint32_t count;
+  //! Index of the next context to analyze.
+  uint32_t next;
+  //! Count of contexts not analyzed yet.
+  uint32_t pending;
+  //! Whether workers should quit.
+  bool quit;
+};
+
+//! \internal
+//!
+//! Analyze contexts of the current batch until there is none left, the lock
+//! has to be held and is released while a context is being analyzed.
+static void X86Compiler_analyzeBatch(X86CompilerBatch* batch) noexcept {
+  while (batch->next < batch->count) {
+    uint32_t i = batch->next++;
+    X86Context* context = batch->contexts[i];
+
+    batch->lock.unlock();
+    Error error = kErrorOk;
+    if (context->getFunc() != nullptr)
+      error = context->analyze();
+    batch->lock.lock();
+
+    batch->errors[i] = error;
+    if (--batch->pending == 0)
+      batch->done.signal();
+  }
+}
+
+static void ASMJIT_CDECL X86Compiler_analyzeWorker(void* arg) noexcept {
+  X86CompilerBatch* batch = static_cast<X86CompilerBatch*>(arg);
+  AutoLock locked(batch->lock);
+
+  for (;;) {
+    X86Compiler_analyzeBatch(batch);
+    if (batch->quit)
+      break;
+    batch->ready.wait(batch->lock);
+  }
+}
+
+//! \internal
+//!
+//! Finalize using `threadCount` threads (including the calling one).
+//!
+//! Functions are processed in batches. Each function of a batch is prepared
+//! by its own context, then all of them are analyzed in parallel, and finally
+//! translated and serialized in their original order. Worker threads are
+//! started by the first batch that needs them and joined at the end.
+static Error X86Compiler_finalizeParallel(X86Compiler* self, X86Assembler* assembler, uint32_t threadCount) noexcept {
+  uint32_t batchSize = threadCount * kX86CompilerFuncsPerThread;
+
+  uint8_t* p = static_cast<uint8_t*>(ASMJIT_ALLOC(batchSize *
+    (sizeof(X86Context) + sizeof(X86Context*) + sizeof(HLNode*) * 2 + sizeof(Error))));
+  Thread* threads = static_cast<Thread*>(ASMJIT_ALLOC((threadCount - 1) * sizeof(Thread)));
+
+  if (p == nullptr || threads == nullptr) {
+    if (p != nullptr) ASMJIT_FREE(p);
+    if (threads != nullptr) ASMJIT_FREE(threads);
+    return self->setLastError(kErrorNoHeapMemory);
+  }
+
+  X86Context* contextData = reinterpret_cast<X86Context*>(p);
+  HLNode** starts = reinterpret_cast<HLNode**>(p + batchSize * sizeof(X86Context));
+  HLNode** stops = starts + batchSize;
+  X86Context** contexts = reinterpret_cast<X86Context**>(stops + batchSize);
+  Error* errors = reinterpret_cast<Error*>(contexts + batchSize);
+
+  uint32_t i;
+  for (i = 0; i < batchSize; i++)
+    contexts[i] = new(&contextData[i]) X86Context(self);
+
+  for (i = 0; i < threadCount - 1; i++)
+    new(&threads[i]) Thread();
+
+  X86CompilerBatch batch;
+  batch.contexts = contexts;
+  batch.errors = errors;
+  batch.count = 0;
+  batch.next = 0;
+  batch.pending = 0;
+  batch.quit = false;
+
+  // Count of started worker threads.
+  uint32_t started = 0;
+
+  Error error = kErrorOk;
+  HLNode* node = self->getFirstNode();
+
+  while (node != nullptr && error == kErrorOk) {
+    uint32_t count = 0;
+
+    // Prepare functions of the batch, a function starts a part which ends
+    // at the next function.
+    while (node != nullptr && count < batchSize) {
+      HLNode* start = node;
+      X86Context* context = contexts[count];
+
+      starts[count] = start;
+      errors[count] = kErrorOk;
+      count++;
+
+      if (node->getType() == HLNode::kTypeFunc) {
+        node = static_cast<X86FuncNode*>(start)->getEnd();
+        error = context->prepare(static_cast<X86FuncNode*>(start));
+
+        if (error != kErrorOk)
+          break;
+      }
+
+      do {
+        node = node->getNext();
+      } while (node != nullptr && node->getType() != HLNode::kTypeFunc);
+
+      stops[count - 1] = node;
+    }
+
+    // Analyze them in parallel, the calling thread is one of the workers.
+    if (error == kErrorOk) {
+      uint32_t workerCount = Utils::iMin<uint32_t>(threadCount, count) - 1;
+      AutoLock locked(batch.lock);
+
+      batch.count = count;
+      batch.next = 0;
+      batch.pending = count;
+      batch.ready.broadcast();
+
+      // If a thread fails to start its share is analyzed by the others.
+      while (started < workerCount && threads[started].start(X86Compiler_analyzeWorker, &batch))
+        started++;
+
+      X86Compiler_analyzeBatch(&batch);
+      while (batch.pending != 0)
+        batch.done.wait(batch.lock);
+    }
+
+    // Translate and serialize in order, contexts are cleaned up even after
+    // a failure as their variables are still bound to them.
+    for (i = 0; i < count; i++) {
+      X86Context* context = contexts[i];
+
+      if (error == kErrorOk) {
+        if (errors[i] != kErrorOk) {
+          error = self->setLastError(errors[i]);
+        }
+        else {
+          if (context->getFunc() != nullptr) {
+            self->_resetTokenGenerator();
+            error = context->generate();
+          }
+
+          if (error == kErrorOk)
+            error = context->serialize(assembler, starts[i], stops[i]);
+        }
+      }
+
+      context->cleanup();
+      context->reset(false);
+    }
+  }
+
+  {
+    AutoLock locked(batch.lock);
+    batch.quit = true;
+    batch.ready.broadcast();
+  }
+
+  for (i = 0; i < threadCount - 1; i++)
+    threads[i].~Thread();
+
+  for (i = 0; i < batchSize; i++)
+    contexts[i]->~X86Context();
+
+  ASMJIT_FREE(threads);
+  ASMJIT_FREE(p);
+  return error;
+}
+
 Error X86Compiler::finalize() noexcept {
   X86Assembler* assembler = getAssembler();
   if (assembler == nullptr)
@@ -258,7 +572,7 @@ Error X86Compiler::finalize() noexcept {
 
   // Flush the global constant pool.
   if (_globalConstPoolLabel.isInitialized()) {
-    embedConstPool(_globalConstPoolLabel, _globalConstPool);
+    embedRoConstPool(_globalConstPoolLabel, _globalConstPool);
 
     _globalConstPoolLabel.reset();
     _globalConstPool.reset();
@@ -267,7 +581,25 @@ Error X86Compiler::finalize() noexcept {
   if (_firstNode == nullptr)
     return kErrorOk;
 
-  X86Context context(this);
+  if (_threadCount > 1) {
+    Error error = X86Compiler_finalizeParallel(this, assembler, _threadCount);
+    reset(false);
+    return error;
+  }
+
+  // The context is created by the first `finalize()` and reused by all
+  // following calls, its zone keeps all memory blocks it allocated.
+  X86Context* context = _context;
+  if (context == nullptr) {
+    void* p = ASMJIT_ALLOC(sizeof(X86Context));
+    if (p == nullptr)
+      return setLastError(kErrorNoHeapMemory);
+    context = _context = new(p) X86Context(this);
+  }
+  else {
+    context->reinit();
+  }
+
   Error error = kErrorOk;
 
   HLNode* node = _firstNode;
@@ -280,7 +612,7 @@ Error X86Compiler::finalize() noexcept {
 
     if (node->getType() == HLNode::kTypeFunc) {
       node = static_cast<X86FuncNode*>(start)->getEnd();
-      error = context.compile(static_cast<X86FuncNode*>(start));
+      error = context->compile(static_cast<X86FuncNode*>(start));
 
       if (error != kErrorOk)
         break;
@@ -290,9 +622,9 @@ Error X86Compiler::finalize() noexcept {
       node = node->getNext();
     } while (node != nullptr && node->getType() != HLNode::kTypeFunc);
 
-    error = context.serialize(assembler, start, node);
-    context.cleanup();
-    context.reset(false);
+    error = context->serialize(assembler, start, node);
+    context->cleanup();
+    context->reset(false);
 
     if (error != kErrorOk)
       break;
@@ -302,6 +634,33 @@ Error X86Compiler::finalize() noexcept {
   return error;
 }
 
+// ============================================================================
+// [asmjit::X86Compiler - Validate]
+// ============================================================================
+
+Error X86Compiler::validate(HLInst** invalidInst) const noexcept {
+  Runtime* runtime = getRuntime();
+  const CpuInfo* cpuInfo = runtime ? &runtime->getCpuInfo() : static_cast<const CpuInfo*>(nullptr);
+
+  for (HLNode* node = _firstNode; node != nullptr; node = node->getNext()) {
+    if (node->getType() != HLNode::kTypeInst)
+      continue;
+
+    HLInst* inst = static_cast<HLInst*>(node);
+    Error error = X86Util::validateInst(_arch, cpuInfo, inst->getInstId(), inst->getOptions(), inst->getOpList(), inst->getOpCount());
+
+    if (error != kErrorOk) {
+      if (invalidInst != nullptr)
+        *invalidInst = inst;
+      return error;
+    }
+  }
+
+  if (invalidInst != nullptr)
+    *invalidInst = nullptr;
+  return kErrorOk;
+}
+
 // ============================================================================
 // [asmjit::X86Compiler - Inst]
 // ============================================================================
@@ -312,6 +671,18 @@ static ASMJIT_INLINE size_t X86Compiler_getInstSize(uint32_t code) noexcept {
 }
 
 static HLInst* X86Compiler_newInst(X86Compiler* self, void* p, uint32_t code, uint32_t options, Operand* opList, uint32_t opCount) noexcept {
+  Assembler* assembler = self->getAssembler();
+  if (assembler != nullptr && assembler->hasAsmOption(Assembler::kOptionStrictValidation)) {
+    Runtime* runtime = assembler->getRuntime();
+    const CpuInfo* cpuInfo = runtime ? &runtime->getCpuInfo() : static_cast<const CpuInfo*>(nullptr);
+
+    Error error = X86Util::validateInst(self->getArch(), cpuInfo, code, options, opList, opCount);
+    if (error != kErrorOk) {
+      self->setLastError(error);
+      return nullptr;
+    }
+  }
+
   if (Utils::inInterval<uint32_t>(code, _kX86InstIdJbegin, _kX86InstIdJend)) {
     HLJump* node = new(p) HLJump(self, code, options, opList, opCount);
     HLLabel* jTarget = nullptr;
@@ -654,7 +1025,7 @@ HLSentinel* X86Compiler::endFunc() noexcept {
   setCursor(func->getExitNode());
 
   if (_localConstPoolLabel.isInitialized()) {
-    embedConstPool(_localConstPoolLabel, _localConstPool);
+    embedRoConstPool(_localConstPoolLabel, _localConstPool);
     _localConstPoolLabel.reset();
     _localConstPool.reset();
   }
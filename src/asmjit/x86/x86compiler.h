@@ -13,6 +13,7 @@
 
 // [Dependencies]
 #include "../base/compiler.h"
+#include "../base/cpuinfo.h"
 #include "../base/vectypes.h"
 #include "../x86/x86assembler.h"
 #include "../x86/x86compilerfunc.h"
@@ -28,6 +29,7 @@ namespace asmjit {
 
 class X86CallNode;
 class X86FuncNode;
+struct X86Context;
 
 //! \addtogroup asmjit_x86
 //! \{
@@ -59,6 +61,140 @@ ASMJIT_VARAPI const uint8_t _x86VarMapping[kX86VarTypeCount];
 ASMJIT_VARAPI const uint8_t _x64VarMapping[kX86VarTypeCount];
 #endif // ASMJIT_BUILD_X64
 
+// ============================================================================
+// [asmjit::X86TuneOptions]
+// ============================================================================
+
+//! X86/X64 compiler tuning options, see \ref X86Compiler::setTuneOptions().
+//!
+//! Each option selects instruction forms preferred by the target CPU, see
+//! \ref X86TuneArch, instead of emitting exactly what was added to the
+//! compiler. The semantics of the code doesn't change, except of status flags
+//! that are not read afterwards.
+ASMJIT_ENUM(X86TuneOptions) {
+  //! Move `cmp|test|add|sub|and|inc|dec` producing flags of a conditional
+  //! jump next to it, so the pair is macro-fused, if the target fuses the
+  //! instruction (after register allocation). Also replace `cmp r, 0`
+  //! followed by a conditional jump by shorter `test r, r`.
+  kX86TuneFusion = 0x00000001,
+
+  //! Choose between `lea` and `add` depending on their latency, if flags are
+  //! not read afterwards (after register allocation):
+  //!   - `lea d, [b + i * s + disp]` is split into `lea d, [b + i * s]` and
+  //!     `add d, disp` if a three component `lea` is slow.
+  //!   - `lea a, [a + b]` and `lea a, [a + disp]` become `add` if `lea` is
+  //!     slower than `add`.
+  //!   - `mov a, b` followed by `add|sub a, c` becomes `lea a, [b + c]` if
+  //!     `lea` is not slower than `add`.
+  kX86TuneLea = 0x00000002,
+
+  //! Avoid partial register writes of 8-bit and 16-bit variables, which
+  //! depend on the previous content of the register. `mov` of a variable of
+  //! the same size is replaced by `movzx` or a 32-bit `mov` of the whole
+  //! register (before register allocation).
+  kX86TunePartialRegs = 0x00000004,
+
+  //! Insert `vzeroupper` between 256-bit AVX code and legacy SSE code, before
+  //! calls, and before the function returns, if no 256-bit variable is alive
+  //! at that point and the function doesn't use YMM/ZMM registers directly.
+  kX86TuneVZeroUpper = 0x00000008,
+
+  //! Use zero idioms recognized by register renaming (after register
+  //! allocation):
+  //!   - `mov r, 0` and `sub r, r` become `xor r32, r32` if flags are not
+  //!     read afterwards, `xor r64, r64` becomes `xor r32, r32`.
+  //!   - 256-bit `vxorps|vxorpd|vpxor ymm, ymm, ymm` of the same register
+  //!     becomes its 128-bit form if the target splits 256-bit operations.
+  kX86TuneZeroIdioms = 0x00000010,
+
+  //! All tuning options.
+  kX86TuneAll = 0x0000001F
+};
+
+// ============================================================================
+// [asmjit::X86TuneArch]
+// ============================================================================
+
+//! X86/X64 micro-architecture used by \ref X86TuneOptions.
+ASMJIT_ENUM(X86TuneArch) {
+  //! Detected from `CpuInfo` of the runtime when the compiler is finalized,
+  //! \ref kX86TuneArchGeneric if there is no runtime.
+  kX86TuneArchAuto = 0,
+  //! Generic, choices that don't hurt any modern CPU.
+  kX86TuneArchGeneric = 1,
+  //! Intel Core2, Nehalem, and Westmere.
+  kX86TuneArchCore2 = 2,
+  //! Intel Sandy Bridge and Ivy Bridge.
+  kX86TuneArchSandyBridge = 3,
+  //! Intel Haswell, Broadwell, Skylake and later big cores.
+  kX86TuneArchSkylake = 4,
+  //! Intel Atom (Bonnell, Silvermont, Goldmont).
+  kX86TuneArchAtom = 5,
+  //! AMD K10.
+  kX86TuneArchK10 = 6,
+  //! AMD Bulldozer family (Bulldozer, Piledriver, Steamroller, Excavator).
+  kX86TuneArchBulldozer = 7,
+  //! AMD Jaguar family (Bobcat, Jaguar).
+  kX86TuneArchJaguar = 8,
+  //! AMD Zen family.
+  kX86TuneArchZen = 9,
+
+  //! Count of tuning architectures.
+  kX86TuneArchCount = 10
+};
+
+// ============================================================================
+// [asmjit::X86TuneFusible]
+// ============================================================================
+
+//! Instructions macro-fused with a following conditional jump, see
+//! \ref X86TuneInfo::fusible.
+ASMJIT_ENUM(X86TuneFusible) {
+  //! `cmp` and `test`.
+  kX86TuneFusibleCmpTest = 0x01,
+  //! `add` and `sub`.
+  kX86TuneFusibleAddSub = 0x02,
+  //! `and`.
+  kX86TuneFusibleAnd = 0x04,
+  //! `inc` and `dec`.
+  kX86TuneFusibleIncDec = 0x08
+};
+
+// ============================================================================
+// [asmjit::X86TuneInfo]
+// ============================================================================
+
+//! X86/X64 cost table of a micro-architecture used by \ref X86TuneOptions.
+//!
+//! Latencies and penalties are in cycles, they are approximations used to
+//! compare instruction forms, not to predict performance.
+struct X86TuneInfo {
+  //! Instructions fused with a conditional jump, see \ref X86TuneFusible.
+  uint8_t fusible;
+  //! Latency of a simple ALU instruction (`add`).
+  uint8_t aluLatency;
+  //! Latency of `lea` with one or two address components.
+  uint8_t leaLatency;
+  //! Latency of `lea` with base, index and displacement.
+  uint8_t leaComplexLatency;
+  //! Penalty of a partial register write (merge or false dependency).
+  uint8_t partialRegPenalty;
+  //! Penalty of a legacy SSE instruction executed when upper halves of YMM
+  //! registers are not zero.
+  uint8_t avxSseTransition;
+  //! Cost of `vzeroupper`.
+  uint8_t vzeroupperCost;
+  //! Whether 256-bit operations are executed as two 128-bit halves, zeroing
+  //! by the 128-bit form is cheaper.
+  uint8_t ymmZeroSplit;
+};
+
+//! \internal
+//!
+//! Cost tables indexed by \ref X86TuneArch (`kX86TuneArchAuto` is the same as
+//! `kX86TuneArchGeneric`).
+ASMJIT_VARAPI const X86TuneInfo _x86TuneInfo[kX86TuneArchCount];
+
 // ============================================================================
 // [asmjit::X86FuncNode]
 // ============================================================================
@@ -711,6 +847,22 @@ class X86CallNode : public HLCall {
 //! Other use cases are waiting for you! Be sure that instruction that are
 //! being emitted are correct and encodable, otherwise the Assembler will
 //! fail and set the status code to `kErrorUnknownInst`.
+//!
+//! Tuning
+//! ------
+//!
+//! The compiler can replace instructions by forms preferred by the CPU the
+//! code runs on, which is enabled by `setTuneOptions()`. The CPU is detected
+//! from `CpuInfo` of the runtime, or can be set by `setTuneArch()`:
+//!
+//! ~~~
+//! c.setTuneArch(kX86TuneArchSkylake);
+//! c.setTuneOptions(kX86TuneFusion | kX86TuneZeroIdioms | kX86TuneVZeroUpper);
+//! ~~~
+//!
+//! Each option is only applied if the cost table of the CPU, see
+//! \ref X86TuneInfo, says the replacement is faster, so the same options
+//! can be used for all targets.
 class ASMJIT_VIRTAPI X86Compiler : public Compiler {
  public:
   ASMJIT_NO_COPY(X86Compiler)
@@ -739,6 +891,23 @@ class ASMJIT_VIRTAPI X86Compiler : public Compiler {
 
   ASMJIT_API virtual Error finalize() noexcept;
 
+  // -------------------------------------------------------------------------
+  // [Validate]
+  // -------------------------------------------------------------------------
+
+  //! Validate all instructions added to the compiler without emitting them.
+  //!
+  //! Each instruction is validated by `X86Util::validateInst()` for the arch
+  //! of the compiler and CPU features of the runtime (if attached). Returns
+  //! the first error found and stores the invalid instruction to `invalidInst`
+  //! (if not `nullptr`), or `kErrorOk` if all instructions are valid. The
+  //! stream is not modified and no error is reported through `setLastError()`.
+  //!
+  //! This can be used to check a whole instruction stream at once instead of
+  //! enabling `Assembler::kOptionStrictValidation`, which validates each
+  //! instruction when it's added.
+  ASMJIT_API Error validate(HLInst** invalidInst = nullptr) const noexcept;
+
   // --------------------------------------------------------------------------
   // [Assembler]
   // --------------------------------------------------------------------------
@@ -803,6 +972,50 @@ class ASMJIT_VIRTAPI X86Compiler : public Compiler {
     return x86::ptr_abs(pAbs, index, shift, disp, zax.getSize());
   }
 
+  // --------------------------------------------------------------------------
+  // [Tune]
+  // --------------------------------------------------------------------------
+
+  //! Get tuning options, see \ref X86TuneOptions.
+  ASMJIT_INLINE uint32_t getTuneOptions() const noexcept { return _tuneOptions; }
+  //! Set tuning options to `options` (0 to disable tuning, which is the
+  //! default).
+  ASMJIT_INLINE void setTuneOptions(uint32_t options) noexcept { _tuneOptions = options & kX86TuneAll; }
+
+  //! Get whether the tuning `option` is enabled.
+  ASMJIT_INLINE bool hasTuneOption(uint32_t option) const noexcept { return (_tuneOptions & option) != 0; }
+  //! Enable tuning `options`.
+  ASMJIT_INLINE void addTuneOptions(uint32_t options) noexcept { _tuneOptions |= options & kX86TuneAll; }
+  //! Disable tuning `options`.
+  ASMJIT_INLINE void clearTuneOptions(uint32_t options) noexcept { _tuneOptions &= ~options; }
+
+  //! Get the micro-architecture to tune for, see \ref X86TuneArch.
+  ASMJIT_INLINE uint32_t getTuneArch() const noexcept { return _tuneArch; }
+  //! Set the micro-architecture to tune for to `tuneArch`.
+  //!
+  //! Returns `kErrorInvalidArgument` if `tuneArch` is not a \ref X86TuneArch.
+  ASMJIT_INLINE Error setTuneArch(uint32_t tuneArch) noexcept {
+    if (tuneArch >= kX86TuneArchCount)
+      return kErrorInvalidArgument;
+
+    _tuneArch = tuneArch;
+    return kErrorOk;
+  }
+
+  //! Get the micro-architecture to tune for, `kX86TuneArchAuto` is resolved
+  //! by the runtime's `CpuInfo`.
+  ASMJIT_API uint32_t getResolvedTuneArch() const noexcept;
+
+  //! Get the cost table used to tune the code, see \ref X86TuneInfo.
+  ASMJIT_INLINE const X86TuneInfo& getTuneInfo() const noexcept {
+    return _x86TuneInfo[getResolvedTuneArch()];
+  }
+
+  //! Detect the micro-architecture of `cpuInfo` by its vendor, family and
+  //! model. Unknown CPUs of a known vendor are mapped to the closest family
+  //! by their features, other CPUs to `kX86TuneArchGeneric`.
+  static ASMJIT_API uint32_t detectTuneArch(const CpuInfo& cpuInfo) noexcept;
+
   // --------------------------------------------------------------------------
   // [Inst / Emit]
   // --------------------------------------------------------------------------
@@ -1219,6 +1432,15 @@ class ASMJIT_VIRTAPI X86Compiler : public Compiler {
   //! Count of registers depending on the current architecture.
   X86RegCount _regCount;
 
+  //! Context used by `finalize()`, kept with its memory between `finalize()`
+  //! calls and released by `reset(true)`.
+  X86Context* _context;
+
+  //! Tuning options, see \ref X86TuneOptions.
+  uint32_t _tuneOptions;
+  //! Micro-architecture to tune for, see \ref X86TuneArch.
+  uint32_t _tuneArch;
+
   //! EAX or RAX register depending on the current architecture.
   X86GpReg zax;
   //! ECX or RCX register depending on the current architecture.
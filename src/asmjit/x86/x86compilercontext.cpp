@@ -14,10 +14,12 @@
 // [Dependencies]
 #include "../base/containers.h"
 #include "../base/cpuinfo.h"
+#include "../base/runtime.h"
 #include "../base/utils.h"
 #include "../x86/x86assembler.h"
 #include "../x86/x86compiler.h"
 #include "../x86/x86compilercontext_p.h"
+#include "../x86/x86disassembler.h"
 
 // [Api-Begin]
 #include "../apibegin.h"
@@ -255,24 +257,14 @@ static void ASMJIT_CDECL X86Context_traceNode(X86Context* self, HLNode* node_, c
 
 X86Context::X86Context(X86Compiler* compiler) : Context(compiler) {
   _varMapToVaListOffset = ASMJIT_OFFSET_OF(X86VarMap, _list);
-  _regCount = compiler->_regCount;
-
-  _zsp = compiler->zsp;
-  _zbp = compiler->zbp;
-
   _memSlot._vmem.type = kMemTypeStackIndex;
-  _memSlot.setGpdBase(compiler->getArch() == kArchX86);
 
 #if defined(ASMJIT_TRACE)
   _traceNode = (TraceNodeFunc)X86Context_traceNode;
 #endif // ASMJIT_TRACE
 
-#if !defined(ASMJIT_DISABLE_LOGGER)
-  _emitComments = compiler->getAssembler()->hasLogger();
-#endif // !ASMJIT_DISABLE_LOGGER
-
   _state = &_x86State;
-  reset();
+  reinit();
 }
 X86Context::~X86Context() {}
 
@@ -280,6 +272,22 @@ X86Context::~X86Context() {}
 // [asmjit::X86Context - Reset]
 // ============================================================================
 
+void X86Context::reinit() {
+  X86Compiler* compiler = getCompiler();
+  _regCount = compiler->_regCount;
+
+  _zsp = compiler->zsp;
+  _zbp = compiler->zbp;
+
+  _memSlot.setGpdBase(compiler->getArch() == kArchX86);
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  _emitComments = compiler->getAssembler()->hasLogger();
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  reset();
+}
+
 void X86Context::reset(bool releaseMemory) {
   Context::reset(releaseMemory);
 
@@ -291,6 +299,9 @@ void X86Context::reset(bool releaseMemory) {
   _gaRegs[kX86RegClassMm ] = Utils::bits(_regCount.getMm());
   _gaRegs[kX86RegClassK  ] = Utils::bits(_regCount.getK());
   _gaRegs[kX86RegClassXyz] = Utils::bits(_regCount.getXyz());
+  _lsRanges = nullptr;
+  _lsHeap.reset(releaseMemory);
+  _usesYmmRegs = false;
 
   _argBaseReg = kInvalidReg; // Used by patcher.
   _varBaseReg = kInvalidReg; // Used by patcher.
@@ -2093,7 +2104,9 @@ static ASMJIT_INLINE Error X86Context_insertHLCallArg(
     sArg->setMap(map);
     sArg->_args |= Utils::mask(argIndex);
 
+    // Inserted after the call has been fetched, share its flow index.
     compiler->addNodeBefore(sArg, call);
+    sArg->setFlowId(call->getFlowId());
     ::memmove(sArgData + 1, sArgData, (sArgCount - i) * sizeof(SArgData));
 
     sArgData->sVd = sVd;
@@ -2130,6 +2143,7 @@ static ASMJIT_INLINE Error X86Context_insertHLCallArg(
       sArgData->sArg = sArg;
 
       compiler->addNodeBefore(sArg, call);
+      sArg->setFlowId(call->getFlowId());
     }
 
     sArg->_args |= Utils::mask(argIndex);
@@ -2138,452 +2152,1009 @@ static ASMJIT_INLINE Error X86Context_insertHLCallArg(
 }
 
 // ============================================================================
-// [asmjit::X86Context - Fetch]
+// [asmjit::X86Context - ValueNumbering]
 // ============================================================================
 
 //! \internal
 //!
-//! Prepare the given function `func`.
+//! Maximum count of values remembered at the same time, the oldest value is
+//! forgotten if a new one doesn't fit.
+static const uint32_t kX86VnMaxValues = 32;
+
+//! \internal
 //!
-//! For each node:
-//! - Create and assign groupId and flowId.
-//! - Collect all variables and merge them to vaList.
-Error X86Context::fetch() {
-  ASMJIT_TLOG("[F] ======= Fetch (Begin)\n");
+//! Flags of `varFlags` entries used by value numbering.
+enum X86VnVarFlags {
+  //! Count of definitions of the variable (saturated to 2).
+  kX86VnVarDefs = 0x03,
+  //! The variable can't be renamed (function argument or used by a hint).
+  kX86VnVarPinned = 0x04,
+  //! The home memory of the variable is accessed directly, instructions that
+  //! use the variable are never numbered.
+  kX86VnVarMem = 0x08
+};
 
-  X86Compiler* compiler = getCompiler();
-  X86FuncNode* func = getFunc();
+//! \internal
+//!
+//! Value computed by an instruction and available in its first operand.
+struct X86VnValue {
+  //! Instruction that computed the value.
+  HLInst* inst;
+  //! Position of the instruction.
+  uint32_t position;
+  //! Whether the value was loaded from memory.
+  bool memRead;
+};
 
-  uint32_t arch = compiler->getArch();
+//! \internal
+//!
+//! Get whether the operand `i` of `inst` can be written by the instruction,
+//! follows the rules used by `fetch()`.
+static ASMJIT_INLINE bool X86Context_isVnWrite(const HLInst* inst, const X86InstExtendedInfo& extendedInfo, uint32_t i) {
+  if (extendedInfo.isSpecial() || extendedInfo.isXchg())
+    return true;
 
-  HLNode* node_ = func;
-  HLNode* next = nullptr;
-  HLNode* stop = getStop();
+  if (i == 0)
+    return !extendedInfo.isRO();
 
-  uint32_t flowId = 0;
+  return i == 1 && inst->getInstId() == kX86InstIdImul && inst->getOpCount() == 3;
+}
 
-  VarAttr vaTmpList[80];
-  SArgData sArgList[80];
+//! \internal
+//!
+//! Get whether `inst` uses the variable `id` in any of its operands starting
+//! at `first`.
+static bool X86Context_hasVnVar(const HLInst* inst, uint32_t id, uint32_t first) {
+  const Operand* opList = inst->getOpList();
+  uint32_t opCount = inst->getOpCount();
+
+  for (uint32_t i = first; i < opCount; i++) {
+    const Operand& op = opList[i];
+
+    if (op.isVar()) {
+      if (op.getId() == id)
+        return true;
+    }
+    else if (op.isMem()) {
+      const X86Mem& m = static_cast<const X86Mem&>(op);
+      if (m.getBase() == id || m.getIndex() == id)
+        return true;
+    }
+  }
 
-  PodList<HLNode*>::Link* jLink = nullptr;
+  return false;
+}
 
-  // Function flags.
-  func->clearFuncFlags(
-    kFuncFlagIsNaked    |
-    kFuncFlagX86Emms    |
-    kFuncFlagX86SFence  |
-    kFuncFlagX86LFence  );
+//! \internal
+//!
+//! Replace variables renamed by `varRename` in `op`.
+static ASMJIT_INLINE void X86Context_renameVnOp(Operand* op, const uint32_t* varRename) {
+  if (op->isVar()) {
+    uint32_t id = varRename[op->getId() & Operand::kIdIndexMask];
+    if (id != kInvalidValue)
+      op->_base.id = id;
+  }
+  else if (op->isMem()) {
+    X86Mem* m = static_cast<X86Mem*>(op);
 
-  if (func->getHint(kFuncHintNaked    ) != 0) func->addFuncFlags(kFuncFlagIsNaked);
-  if (func->getHint(kFuncHintCompact  ) != 0) func->addFuncFlags(kFuncFlagX86Leave);
-  if (func->getHint(kFuncHintX86Emms  ) != 0) func->addFuncFlags(kFuncFlagX86Emms);
-  if (func->getHint(kFuncHintX86SFence) != 0) func->addFuncFlags(kFuncFlagX86SFence);
-  if (func->getHint(kFuncHintX86LFence) != 0) func->addFuncFlags(kFuncFlagX86LFence);
+    if (OperandUtil::isVarId(m->getBase()) && m->isBaseIndexType()) {
+      uint32_t id = varRename[m->getBase() & Operand::kIdIndexMask];
+      if (id != kInvalidValue)
+        m->setBase(id);
+    }
 
-  // Global allocable registers.
-  uint32_t* gaRegs = _gaRegs;
+    if (OperandUtil::isVarId(m->getIndex())) {
+      uint32_t id = varRename[m->getIndex() & Operand::kIdIndexMask];
+      if (id != kInvalidValue)
+        m->setIndex(id);
+    }
+  }
+}
 
-  if (!func->hasFuncFlag(kFuncFlagIsNaked))
-    gaRegs[kX86RegClassGp] &= ~Utils::mask(kX86RegIndexBp);
+//! \internal
+//!
+//! Get whether `inst` is a pure computation of its first operand.
+//!
+//! The instruction has to overwrite the whole variable in its first operand
+//! from the other operands without touching flags or anything else. Sources
+//! can only be variables, immediates and memory addressed by variables or
+//! labels, at least one source has to be a variable or memory.
+static bool X86Context_isVnPure(X86Compiler* compiler, const HLInst* inst,
+  const X86InstExtendedInfo& extendedInfo, const uint8_t* varFlags) {
+
+  const Operand* opList = inst->getOpList();
+  uint32_t opCount = inst->getOpCount();
+
+  if (opCount < 2 || !opList[0].isVar() || !extendedInfo.isWO())
+    return false;
+
+  if (extendedInfo.getEFlagsIn() != 0 || extendedInfo.getEFlagsOut() != 0 ||
+      extendedInfo.isSpecial() || extendedInfo.isSpecialMem() || extendedInfo.isXchg())
+    return false;
+
+  // EVEX opmask is an input the compiler doesn't track (merge-masking also
+  // reads the destination).
+  if ((inst->getOptions() & kX86InstOptionEvexK) != 0)
+    return false;
+
+  // The same rules as used by `fetch()` to decide whether the instruction
+  // overwrites the whole variable; AVX instructions always zero the rest of
+  // the destination register.
+  const X86Var& var = static_cast<const X86Var&>(opList[0]);
+  uint32_t varSize = compiler->getVdById(var.getId())->getSize();
+  uint32_t movSize = extendedInfo.getWriteSize();
+
+  if (extendedInfo.isZeroIfMem() && opList[1].isMem())
+    movSize = 16;
+
+  if (var.isGp()) {
+    if (movSize == 0)
+      movSize = var.getSize();
+
+    if (movSize < 4 && movSize < varSize)
+      return false;
+  }
+  else if (!extendedInfo.hasFlag(kX86InstFlagAvx) && movSize < varSize) {
+    return false;
+  }
 
-  // Allowed index registers (GP/XMM/YMM).
-  const uint32_t indexMask = Utils::bits(_regCount.getGp()) & ~(Utils::mask(4, 12));
+  bool hasSource = false;
+  for (uint32_t i = 0; i < opCount; i++) {
+    const Operand& op = opList[i];
 
-  // --------------------------------------------------------------------------
-  // [VI Macros]
-  // --------------------------------------------------------------------------
+    if (op.isVar()) {
+      if (varFlags[op.getId() & Operand::kIdIndexMask] & kX86VnVarMem)
+        return false;
+      hasSource |= i != 0;
+    }
+    else if (op.isMem()) {
+      const X86Mem& m = static_cast<const X86Mem&>(op);
+      uint32_t base = m.getBase();
+      uint32_t index = m.getIndex();
 
-#define VI_BEGIN() \
-  do { \
-    uint32_t vaCount = 0; \
-    X86RegCount regCount; \
-    \
-    X86RegMask inRegs; \
-    X86RegMask outRegs; \
-    X86RegMask clobberedRegs; \
-    \
-    regCount.reset(); \
-    inRegs.reset(); \
-    outRegs.reset(); \
-    clobberedRegs.reset()
+      if (m.getMemType() == kMemTypeStackIndex)
+        return false;
 
-#define VI_END(_Node_) \
-    if (vaCount == 0 && clobberedRegs.isEmpty()) \
-      break; \
-    \
-    X86RegCount _vaIndex; \
-    _vaIndex.indexFromRegCount(regCount); \
-    \
-    X86VarMap* _map = newVarMap(vaCount); \
-    if (_map == nullptr) \
-      goto _NoMemory; \
-    \
-    _map->_vaCount = vaCount; \
-    _map->_count = regCount; \
-    _map->_start = _vaIndex; \
-    \
-    _map->_inRegs = inRegs; \
-    _map->_outRegs = outRegs; \
-    _map->_clobberedRegs = clobberedRegs; \
-    \
-    VarAttr* _va = vaTmpList; \
-    while (vaCount) { \
-      VarData* _vd = _va->getVd(); \
-      \
-      uint32_t _class = _vd->getClass(); \
-      uint32_t _index = _vaIndex.get(_class); \
-      \
-      _vaIndex.add(_class); \
-      \
-      if (_va->_inRegs) \
-        _va->_allocableRegs = _va->_inRegs; \
-      else if (_va->_outRegIndex != kInvalidReg) \
-        _va->_allocableRegs = Utils::mask(_va->_outRegIndex); \
-      else \
-        _va->_allocableRegs &= ~inRegs.get(_class); \
-      \
-      _vd->_va = nullptr; \
-      _map->getVa(_index)[0] = _va[0]; \
-      \
-      _va++; \
-      vaCount--; \
-    } \
-    \
-    _Node_->setMap(_map); \
-  } while (0)
+      if (m.getMemType() == kMemTypeBaseIndex && base != kInvalidValue) {
+        if (!OperandUtil::isVarId(base) || (varFlags[base & Operand::kIdIndexMask] & kX86VnVarMem))
+          return false;
+      }
 
-#define VI_ADD_VAR(_Vd_, _Va_, _Flags_, _NewAllocable_) \
-  do { \
-    ASMJIT_ASSERT(_Vd_->_va == nullptr); \
-    \
-    _Va_ = &vaTmpList[vaCount++]; \
-    _Va_->setup(_Vd_, _Flags_, 0, _NewAllocable_); \
-    _Va_->addVarCount(1); \
-    _Vd_->setVa(_Va_); \
-    \
-    if (_registerContextVar(_Vd_) != kErrorOk) \
-      goto _NoMemory; \
-    regCount.add(_Vd_->getClass()); \
-  } while (0)
+      if (index != kInvalidValue) {
+        if (!OperandUtil::isVarId(index) || (varFlags[index & Operand::kIdIndexMask] & kX86VnVarMem))
+          return false;
+      }
+      hasSource = true;
+    }
+    else if (!op.isImm()) {
+      return false;
+    }
+  }
 
-#define VI_MERGE_VAR(_Vd_, _Va_, _Flags_, _NewAllocable_) \
-  do { \
-    _Va_ = _Vd_->getVa(); \
-    \
-    if (_Va_ == nullptr) { \
-      _Va_ = &vaTmpList[vaCount++]; \
-      _Va_->setup(_Vd_, 0, 0, _NewAllocable_); \
-      _Vd_->setVa(_Va_); \
-      \
-      if (_registerContextVar(_Vd_) != kErrorOk) \
-        goto _NoMemory; \
-      regCount.add(_Vd_->getClass()); \
-    } \
-    \
-    _Va_->orFlags(_Flags_); \
-    _Va_->addVarCount(1); \
-  } while (0)
+  return hasSource;
+}
 
-  // --------------------------------------------------------------------------
-  // [Loop]
-  // --------------------------------------------------------------------------
+//! \internal
+//!
+//! Get whether operands `a` and `b` are equal, ids of variables are compared
+//! only if `compareId` is true.
+static ASMJIT_INLINE bool X86Context_isVnOpEqual(const Operand& a, const Operand& b, bool compareId) {
+  if (a._packed[0].u32[0] != b._packed[0].u32[0])
+    return false;
 
-  do {
-_Do:
-    while (node_->isFetched()) {
-_NextGroup:
-      if (jLink == nullptr)
-        jLink = _jccList.getFirst();
-      else
-        jLink = jLink->getNext();
+  // Only the variable type is used by variables, the rest is not initialized.
+  if (a.isVar())
+    return (!compareId || a.getId() == b.getId()) && a._vreg.vType == b._vreg.vType;
 
-      if (jLink == nullptr)
-        goto _Done;
-      node_ = X86Context_getOppositeJccFlow(static_cast<HLJump*>(jLink->getValue()));
-    }
+  return a._packed[0] == b._packed[0] && a._packed[1] == b._packed[1];
+}
 
-    flowId++;
+//! \internal
+//!
+//! Get whether `a` and `b` compute the same value (from the same sources).
+static bool X86Context_isVnEqual(const HLInst* a, const HLInst* b) {
+  uint32_t opCount = a->getOpCount();
 
-    next = node_->getNext();
-    node_->setFlowId(flowId);
+  if (a->getInstId() != b->getInstId() || a->getOptions() != b->getOptions() || b->getOpCount() != opCount)
+    return false;
 
-    ASMJIT_TSEC({
-      this->_traceNode(this, node_, "[F] ");
-    });
+  const Operand* aList = a->getOpList();
+  const Operand* bList = b->getOpList();
 
-    switch (node_->getType()) {
-      // ----------------------------------------------------------------------
-      // [Align/Embed]
-      // ----------------------------------------------------------------------
+  // Only type and size of the destination have to match.
+  if (!X86Context_isVnOpEqual(aList[0], bList[0], false))
+    return false;
 
-      case HLNode::kTypeAlign:
-      case HLNode::kTypeData:
-        break;
+  for (uint32_t i = 1; i < opCount; i++) {
+    if (!X86Context_isVnOpEqual(aList[i], bList[i], true))
+      return false;
+  }
 
-      // ----------------------------------------------------------------------
-      // [Hint]
-      // ----------------------------------------------------------------------
+  return true;
+}
 
-      case HLNode::kTypeHint: {
-        HLHint* node = static_cast<HLHint*>(node_);
-        VI_BEGIN();
+//! \internal
+//!
+//! Get an instruction that copies `var` from a variable of the same type, or
+//! `kInstIdNone` if there is no such instruction.
+static uint32_t X86Context_getVnMoveId(const X86Var& var, const X86InstExtendedInfo& extendedInfo) {
+  if (var.isGp())
+    return kX86InstIdMov;
 
-        if (node->getHint() == kVarHintAlloc) {
-          uint32_t remain[_kX86RegClassManagedCount];
-          HLHint* cur = node;
+  if (var.isMm())
+    return kX86InstIdMovq;
 
-          remain[kX86RegClassGp ] = _regCount.getGp() - 1 - func->hasFuncFlag(kFuncFlagIsNaked);
-          remain[kX86RegClassMm ] = _regCount.getMm();
-          remain[kX86RegClassK  ] = _regCount.getK();
-          remain[kX86RegClassXyz] = _regCount.getXyz();
+  if (var.isYmm())
+    return kX86InstIdVmovaps;
 
-          // Merge as many alloc-hints as possible.
-          for (;;) {
-            VarData* vd = static_cast<VarData*>(cur->getVd());
-            VarAttr* va = vd->getVa();
+  if (var.isXmm())
+    return extendedInfo.hasFlag(kX86InstFlagAvx) ? kX86InstIdVmovaps : kX86InstIdMovaps;
 
-            uint32_t regClass = vd->getClass();
-            uint32_t regIndex = cur->getValue();
-            uint32_t regMask = 0;
+  return kInstIdNone;
+}
 
-            // We handle both kInvalidReg and kInvalidValue.
-            if (regIndex < kInvalidReg)
-              regMask = Utils::mask(regIndex);
+//! \internal
+//!
+//! Forget all values computed from or kept in the variable `id`.
+static uint32_t X86Context_forgetVnVar(X86VnValue* values, uint32_t count, uint32_t id) {
+  uint32_t n = 0;
 
-            if (va == nullptr) {
-              if (inRegs.has(regClass, regMask))
-                break;
-              if (remain[regClass] == 0)
-                break;
-              VI_ADD_VAR(vd, va, kVarAttrRReg, gaRegs[regClass]);
+  for (uint32_t i = 0; i < count; i++) {
+    if (!X86Context_hasVnVar(values[i].inst, id, 0))
+      values[n++] = values[i];
+  }
 
-              if (regMask != 0) {
-                inRegs.xor_(regClass, regMask);
-                va->setInRegs(regMask);
-                va->setInRegIndex(regIndex);
-              }
+  return n;
+}
 
-              remain[regClass]--;
-            }
-            else if (regMask != 0) {
-              if (inRegs.has(regClass, regMask) && va->getInRegs() != regMask)
-                break;
+//! \internal
+//!
+//! Forget all values loaded from memory.
+static uint32_t X86Context_forgetVnMem(X86VnValue* values, uint32_t count) {
+  uint32_t n = 0;
 
-              inRegs.xor_(regClass, va->getInRegs() | regMask);
-              va->setInRegs(regMask);
-              va->setInRegIndex(regIndex);
-            }
+  for (uint32_t i = 0; i < count; i++) {
+    if (!values[i].memRead)
+      values[n++] = values[i];
+  }
 
-            if (cur != node)
-              compiler->removeNode(cur);
+  return n;
+}
 
-            cur = static_cast<HLHint*>(node->getNext());
-            if (cur == nullptr || cur->getType() != HLNode::kTypeHint || cur->getHint() != kVarHintAlloc)
-              break;
-          }
+//! \internal
+//!
+//! Number values computed by instructions of the function.
+//!
+//! Values are numbered locally, from a label or a jump to the next one, a
+//! call, a hint or a return. An instruction that computes a value which is
+//! still available in a variable is either removed and its variable renamed,
+//! if both variables are defined only once, or it's replaced by a move from
+//! the variable that holds the value. A value is no longer available when any
+//! of its sources or its variable is written, and values loaded from memory
+//! are forgotten by any memory write.
+Error X86Context::valueNumbering() {
+  ASMJIT_TLOG("[V] ======= ValueNumbering (Begin)\n");
 
-          next = node->getNext();
-        }
-        else  {
-          VarData* vd = static_cast<VarData*>(node->getVd());
-          VarAttr* va;
+  X86Compiler* compiler = getCompiler();
+  X86FuncNode* func = getFunc();
 
-          uint32_t flags = 0;
+  HLNode* node_;
+  HLNode* next;
+  HLNode* stop = getStop();
 
-          switch (node->getHint()) {
-            case kVarHintSpill:
-              flags = kVarAttrRMem | kVarAttrSpill;
-              break;
-            case kVarHintSave:
-              flags = kVarAttrRMem;
-              break;
-            case kVarHintSaveAndUnuse:
-              flags = kVarAttrRMem | kVarAttrUnuse;
-              break;
-            case kVarHintUnuse:
-              flags = kVarAttrUnuse;
-              break;
-          }
+  uint32_t varCount = static_cast<uint32_t>(compiler->_varList.getLength());
+  if (varCount == 0)
+    return kErrorOk;
 
-          VI_ADD_VAR(vd, va, flags, 0);
-        }
+  uint8_t* varFlags = _zoneAllocator.allocT<uint8_t>(varCount);
+  uint32_t* varRename = _zoneAllocator.allocT<uint32_t>(varCount * sizeof(uint32_t));
+  uint32_t* varLastUse = _zoneAllocator.allocT<uint32_t>(varCount * sizeof(uint32_t));
 
-        VI_END(node_);
+  if (varFlags == nullptr || varRename == nullptr || varLastUse == nullptr)
+    return kErrorNoHeapMemory;
+
+  ::memset(varFlags, 0, varCount);
+  ::memset(varRename, 0xFF, varCount * sizeof(uint32_t));
+  ::memset(varLastUse, 0, varCount * sizeof(uint32_t));
+
+  uint32_t i;
+
+  // --------------------------------------------------------------------------
+  // [Count Definitions]
+  // --------------------------------------------------------------------------
+
+  for (node_ = func; node_ != stop; node_ = node_->getNext()) {
+    switch (node_->getType()) {
+      case HLNode::kTypeInst: {
+        HLInst* node = static_cast<HLInst*>(node_);
+        const X86InstExtendedInfo& extendedInfo = _x86InstInfo[node->getInstId()].getExtendedInfo();
+
+        Operand* opList = node->getOpList();
+        uint32_t opCount = node->getOpCount();
+
+        for (i = 0; i < opCount; i++) {
+          Operand* op = &opList[i];
+
+          if (op->isVar()) {
+            uint8_t& flags = varFlags[op->getId() & Operand::kIdIndexMask];
+            if (X86Context_isVnWrite(node, extendedInfo, i) && (flags & kX86VnVarDefs) < 2)
+              flags++;
+          }
+          else if (op->isMem()) {
+            X86Mem* m = static_cast<X86Mem*>(op);
+            if (m->getMemType() == kMemTypeStackIndex && OperandUtil::isVarId(m->getBase()))
+              varFlags[m->getBase() & Operand::kIdIndexMask] |= kX86VnVarMem | kX86VnVarPinned;
+          }
+        }
         break;
       }
 
-      // ----------------------------------------------------------------------
-      // [Target]
-      // ----------------------------------------------------------------------
+      case HLNode::kTypeHint: {
+        HLHint* node = static_cast<HLHint*>(node_);
+        varFlags[node->getVd()->getId() & Operand::kIdIndexMask] |= kX86VnVarPinned;
+        break;
+      }
 
-      case HLNode::kTypeLabel: {
-        if (node_ == func->getExitNode()) {
-          ASMJIT_PROPAGATE_ERROR(addReturningNode(node_));
-          goto _NextGroup;
+      case HLNode::kTypeFunc: {
+        for (i = 0; i < func->getNumArgs(); i++) {
+          VarData* vd = func->getArg(i);
+          if (vd != nullptr)
+            varFlags[vd->getId() & Operand::kIdIndexMask] |= kX86VnVarPinned | 2;
         }
         break;
       }
 
-      // ----------------------------------------------------------------------
-      // [Inst]
-      // ----------------------------------------------------------------------
+      case HLNode::kTypeCall: {
+        X86CallNode* node = static_cast<X86CallNode*>(node_);
 
-      case HLNode::kTypeInst: {
-        HLInst* node = static_cast<HLInst*>(node_);
+        for (i = 0; i < 2; i++) {
+          Operand* op = &node->_ret[i];
+          if (op->isVar()) {
+            uint8_t& flags = varFlags[op->getId() & Operand::kIdIndexMask];
+            if ((flags & kX86VnVarDefs) < 2)
+              flags++;
+          }
+        }
 
-        uint32_t instId = node->getInstId();
-        uint32_t flags = node->getFlags();
+        if (node->_target.isMem()) {
+          X86Mem* m = static_cast<X86Mem*>(&node->_target);
+          if (m->getMemType() == kMemTypeStackIndex && OperandUtil::isVarId(m->getBase()))
+            varFlags[m->getBase() & Operand::kIdIndexMask] |= kX86VnVarMem | kX86VnVarPinned;
+        }
+        break;
+      }
 
-        Operand* opList = node->getOpList();
-        uint32_t opCount = node->getOpCount();
+      default:
+        break;
+    }
+  }
 
-        if (opCount) {
-          const X86InstExtendedInfo& extendedInfo = _x86InstInfo[instId].getExtendedInfo();
-          const X86SpecialInst* special = nullptr;
-          VI_BEGIN();
+  // --------------------------------------------------------------------------
+  // [Number Values]
+  // --------------------------------------------------------------------------
 
-          // Collect instruction flags and merge all 'VarAttr's.
-          if (extendedInfo.isFp())
-            flags |= HLNode::kFlagIsFp;
+  X86VnValue values[kX86VnMaxValues];
+  uint32_t count = 0;
+  uint32_t position = 0;
+  bool renamed = false;
 
-          if (extendedInfo.isSpecial() && (special = X86SpecialInst_get(instId, opList, opCount)) != nullptr)
-            flags |= HLNode::kFlagIsSpecial;
+  for (node_ = func; node_ != stop; node_ = next) {
+    next = node_->getNext();
 
-          uint32_t gpAllowedMask = 0xFFFFFFFF;
+    if (node_->getType() != HLNode::kTypeInst) {
+      // Comments don't affect anything, any other node ends the numbering.
+      if (node_->getType() != HLNode::kTypeComment)
+        count = 0;
+      continue;
+    }
 
-          for (uint32_t i = 0; i < opCount; i++) {
-            Operand* op = &opList[i];
-            VarData* vd;
-            VarAttr* va;
+    HLInst* node = static_cast<HLInst*>(node_);
+    const X86InstExtendedInfo& extendedInfo = _x86InstInfo[node->getInstId()].getExtendedInfo();
 
-            if (op->isVar()) {
-              vd = compiler->getVdById(op->getId());
-              VI_MERGE_VAR(vd, va, 0, gaRegs[vd->getClass()] & gpAllowedMask);
+    Operand* opList = node->getOpList();
+    uint32_t opCount = node->getOpCount();
 
-              if (static_cast<X86Var*>(op)->isGpb()) {
-                va->orFlags(static_cast<X86GpVar*>(op)->isGpbLo() ? kVarAttrX86GpbLo : kVarAttrX86GpbHi);
-                if (arch == kArchX86) {
-                  // If a byte register is accessed in 32-bit mode we have to limit
-                  // all allocable registers for that variable to eax/ebx/ecx/edx.
-                  // Other variables are not affected.
-                  va->_allocableRegs &= 0x0F;
-                }
-                else {
-                  // It's fine if lo-byte register is accessed in 64-bit mode;
-                  // however, hi-byte has to be checked and if it's used all
-                  // registers (GP/XMM) could be only allocated in the lower eight
-                  // half. To do that, we patch 'allocableRegs' of all variables
-                  // we collected until now and change the allocable restriction
-                  // for variables that come after.
-                  if (static_cast<X86GpVar*>(op)->isGpbHi()) {
-                    va->_allocableRegs &= 0x0F;
+    if (renamed) {
+      for (i = 0; i < opCount; i++)
+        X86Context_renameVnOp(&opList[i], varRename);
+    }
 
-                    if (gpAllowedMask != 0xFF) {
-                      for (uint32_t j = 0; j < i; j++)
-                        vaTmpList[j]._allocableRegs &= vaTmpList[j].hasFlag(kVarAttrX86GpbHi) ? 0x0F : 0xFF;
-                      gpAllowedMask = 0xFF;
-                    }
-                  }
-                }
-              }
+    if (opCount == 0 || node->isJmpOrJcc() || extendedInfo.isFlow() || extendedInfo.isVolatile() || extendedInfo.isFp()) {
+      count = 0;
+      continue;
+    }
 
-              if (special != nullptr) {
-                uint32_t inReg = special[i].inReg;
-                uint32_t outReg = special[i].outReg;
-                uint32_t c;
+    position++;
+    bool isPure = X86Context_isVnPure(compiler, node, extendedInfo, varFlags);
 
-                if (static_cast<const X86Reg*>(op)->isGp())
-                  c = kX86RegClassGp;
-                else
-                  c = kX86RegClassXyz;
+    if (isPure) {
+      for (i = 0; i < count; i++) {
+        if (X86Context_isVnEqual(values[i].inst, node))
+          break;
+      }
 
-                if (inReg != kInvalidReg) {
-                  uint32_t mask = Utils::mask(inReg);
-                  inRegs.or_(c, mask);
-                  va->addInRegs(mask);
-                }
+      if (i < count) {
+        const Operand& src = values[i].inst->getOpList()[0];
+        uint32_t srcId = src.getId();
+        uint32_t dstId = opList[0].getId();
 
-                if (outReg != kInvalidReg) {
-                  uint32_t mask = Utils::mask(outReg);
-                  outRegs.or_(c, mask);
-                  va->setOutRegIndex(outReg);
-                }
+        uint32_t srcIndex = srcId & Operand::kIdIndexMask;
+        uint32_t dstIndex = dstId & Operand::kIdIndexMask;
 
-                va->orFlags(special[i].flags);
-              }
-              else {
-                uint32_t inFlags = kVarAttrRReg;
-                uint32_t outFlags = kVarAttrWReg;
-                uint32_t combinedFlags;
+        // The variable already holds the value.
+        if (srcId == dstId) {
+          ASMJIT_TLOG("[V] Remove redundant instruction\n");
+          compiler->removeNode(node);
+          continue;
+        }
 
-                if (i == 0) {
-                  // Read/Write is usually the combination of the first operand.
-                  combinedFlags = inFlags | outFlags;
+        // Both variables are defined only once and the destination is not
+        // used since the value was computed, all its uses can use the source.
+        if ((varFlags[srcIndex] & (kX86VnVarDefs | kX86VnVarPinned)) == 1 &&
+            (varFlags[dstIndex] & (kX86VnVarDefs | kX86VnVarPinned)) == 1 &&
+            varLastUse[dstIndex] < values[i].position &&
+            compiler->getVdById(srcId)->getType() == compiler->getVdById(dstId)->getType()) {
+          ASMJIT_TLOG("[V] Rename variable %u to %u\n", dstIndex, srcIndex);
+          varRename[dstIndex] = srcId;
+          renamed = true;
+
+          count = X86Context_forgetVnVar(values, count, dstId);
+          compiler->removeNode(node);
+          continue;
+        }
 
-                  if (node->getOptions() & kInstOptionOverwrite) {
-                    // Manually forcing write-only.
-                    combinedFlags = outFlags;
-                  }
-                  else if (extendedInfo.isWO()) {
-                    // Write-only instruction.
-                    uint32_t movSize = extendedInfo.getWriteSize();
-                    uint32_t varSize = vd->getSize();
+        uint32_t moveId = X86Context_getVnMoveId(static_cast<const X86Var&>(opList[0]), extendedInfo);
+        if (moveId != kInstIdNone) {
+          ASMJIT_TLOG("[V] Replace by a move from variable %u\n", srcIndex);
+          node->setInstId(moveId);
+          node->setOptions(0);
+          node->resetMemOpIndex();
 
-                    // Exception - If the source operand is a memory location
-                    // promote move size into 16 bytes.
-                    if (extendedInfo.isZeroIfMem() && opList[1].isMem())
-                      movSize = 16;
+          node->_opCount = 2;
+          opList[1] = src;
 
-                    if (static_cast<const X86Var*>(op)->isGp()) {
-                      uint32_t opSize = static_cast<const X86Var*>(op)->getSize();
+          opCount = 2;
+          isPure = false;
+        }
+      }
+    }
 
-                      // Move size is zero in case that it should be determined
-                      // from the destination register.
-                      if (movSize == 0)
-                        movSize = opSize;
+    bool memWrite = extendedInfo.isSpecialMem() || (node->getOptions() & kX86InstOptionLock) != 0;
+    bool memRead = false;
 
-                      // Handle the case that a 32-bit operation in 64-bit mode
-                      // always clears the rest of the destination register and
-                      // the case that move size is actually greater than or
-                      // equal to the size of the variable.
-                      if (movSize >= 4 || movSize >= varSize)
-                        combinedFlags = outFlags;
-                    }
-                    else if (movSize >= varSize) {
-                      // If move size is greater than or equal to the size of
-                      // the variable there is nothing to do, because the move
-                      // will overwrite the variable in all cases.
-                      combinedFlags = outFlags;
-                    }
-                  }
-                  else if (extendedInfo.isRO()) {
-                    // Comparison/Test instructions don't modify any operand.
-                    combinedFlags = inFlags;
-                  }
-                  else if (instId == kX86InstIdImul && opCount == 3) {
-                    // Imul.
-                    combinedFlags = outFlags;
-                  }
-                }
-                else {
-                  // Read-Only is usualy the combination of the second/third/fourth operands.
-                  combinedFlags = inFlags;
+    for (i = 0; i < opCount; i++) {
+      Operand* op = &opList[i];
 
-                  // Idiv is a special instruction, never handled here.
-                  ASMJIT_ASSERT(instId != kX86InstIdIdiv);
+      if (op->isVar()) {
+        varLastUse[op->getId() & Operand::kIdIndexMask] = position;
+        if (X86Context_isVnWrite(node, extendedInfo, i))
+          count = X86Context_forgetVnVar(values, count, op->getId());
+      }
+      else if (op->isMem()) {
+        X86Mem* m = static_cast<X86Mem*>(op);
 
-                  // Xchg/Xadd/Imul.
-                  if (extendedInfo.isXchg() || (instId == kX86InstIdImul && opCount == 3 && i == 1))
-                    combinedFlags = inFlags | outFlags;
-                }
-                va->orFlags(combinedFlags);
-              }
-            }
-            else if (op->isMem()) {
-              X86Mem* m = static_cast<X86Mem*>(op);
-              node->setMemOpIndex(i);
+        if (OperandUtil::isVarId(m->getBase()) && m->isBaseIndexType())
+          varLastUse[m->getBase() & Operand::kIdIndexMask] = position;
 
-              if (OperandUtil::isVarId(m->getBase()) && m->isBaseIndexType()) {
+        if (OperandUtil::isVarId(m->getIndex()))
+          varLastUse[m->getIndex() & Operand::kIdIndexMask] = position;
+
+        memRead = true;
+        memWrite |= X86Context_isVnWrite(node, extendedInfo, i);
+      }
+    }
+
+    if (memWrite)
+      count = X86Context_forgetVnMem(values, count);
+
+    // Remember the value unless it's computed from the previous value of
+    // its own variable.
+    if (isPure && !X86Context_hasVnVar(node, opList[0].getId(), 1)) {
+      if (count == kX86VnMaxValues) {
+        ::memmove(values, values + 1, (kX86VnMaxValues - 1) * sizeof(X86VnValue));
+        count--;
+      }
+
+      values[count].inst = node;
+      values[count].position = position;
+      values[count].memRead = memRead;
+      count++;
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // [Rename Variables]
+  // --------------------------------------------------------------------------
+
+  if (renamed) {
+    for (node_ = func; node_ != stop; node_ = node_->getNext()) {
+      switch (node_->getType()) {
+        case HLNode::kTypeInst: {
+          HLInst* node = static_cast<HLInst*>(node_);
+          Operand* opList = node->getOpList();
+          uint32_t opCount = node->getOpCount();
+
+          for (i = 0; i < opCount; i++)
+            X86Context_renameVnOp(&opList[i], varRename);
+          break;
+        }
+
+        case HLNode::kTypeRet: {
+          HLRet* node = static_cast<HLRet*>(node_);
+          for (i = 0; i < 2; i++)
+            X86Context_renameVnOp(&node->_ret[i], varRename);
+          break;
+        }
+
+        case HLNode::kTypeCall: {
+          X86CallNode* node = static_cast<X86CallNode*>(node_);
+          uint32_t argCount = node->getDecl()->getNumArgs();
+
+          X86Context_renameVnOp(&node->_target, varRename);
+          for (i = 0; i < 2; i++)
+            X86Context_renameVnOp(&node->_ret[i], varRename);
+          for (i = 0; i < argCount; i++)
+            X86Context_renameVnOp(&node->_args[i], varRename);
+          break;
+        }
+
+        default:
+          break;
+      }
+    }
+  }
+
+  ASMJIT_TLOG("[V] ======= ValueNumbering (End)\n");
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86Context - Fetch]
+// ============================================================================
+
+//! \internal
+//!
+//! Prepare the given function `func`.
+//!
+//! For each node:
+//! - Create and assign groupId and flowId.
+//! - Collect all variables and merge them to vaList.
+Error X86Context::fetch() {
+  ASMJIT_TLOG("[F] ======= Fetch (Begin)\n");
+
+  X86Compiler* compiler = getCompiler();
+  X86FuncNode* func = getFunc();
+
+  uint32_t arch = compiler->getArch();
+
+  HLNode* node_ = func;
+  HLNode* next = nullptr;
+  HLNode* stop = getStop();
+
+  uint32_t flowId = 0;
+
+  VarAttr vaTmpList[80];
+  SArgData sArgList[80];
+
+  PodList<HLNode*>::Link* jLink = nullptr;
+
+  // Function flags.
+  func->clearFuncFlags(
+    kFuncFlagIsNaked    |
+    kFuncFlagX86Emms    |
+    kFuncFlagX86SFence  |
+    kFuncFlagX86LFence  );
+
+  if (func->getHint(kFuncHintNaked    ) != 0) func->addFuncFlags(kFuncFlagIsNaked);
+  if (func->getHint(kFuncHintCompact  ) != 0) func->addFuncFlags(kFuncFlagX86Leave);
+  if (func->getHint(kFuncHintX86Emms  ) != 0) func->addFuncFlags(kFuncFlagX86Emms);
+  if (func->getHint(kFuncHintX86SFence) != 0) func->addFuncFlags(kFuncFlagX86SFence);
+  if (func->getHint(kFuncHintX86LFence) != 0) func->addFuncFlags(kFuncFlagX86LFence);
+
+  // Global allocable registers.
+  uint32_t* gaRegs = _gaRegs;
+
+  if (!func->hasFuncFlag(kFuncFlagIsNaked))
+    gaRegs[kX86RegClassGp] &= ~Utils::mask(kX86RegIndexBp);
+
+  // Allowed index registers (GP/XMM/YMM).
+  const uint32_t indexMask = Utils::bits(_regCount.getGp()) & ~(Utils::mask(4, 12));
+
+  // --------------------------------------------------------------------------
+  // [VI Macros]
+  // --------------------------------------------------------------------------
+
+#define VI_BEGIN() \
+  do { \
+    uint32_t vaCount = 0; \
+    X86RegCount regCount; \
+    \
+    X86RegMask inRegs; \
+    X86RegMask outRegs; \
+    X86RegMask clobberedRegs; \
+    \
+    regCount.reset(); \
+    inRegs.reset(); \
+    outRegs.reset(); \
+    clobberedRegs.reset()
+
+#define VI_END(_Node_) \
+    if (vaCount == 0 && clobberedRegs.isEmpty()) \
+      break; \
+    \
+    X86RegCount _vaIndex; \
+    _vaIndex.indexFromRegCount(regCount); \
+    \
+    X86VarMap* _map = newVarMap(vaCount); \
+    if (_map == nullptr) \
+      goto _NoMemory; \
+    \
+    _map->_vaCount = vaCount; \
+    _map->_count = regCount; \
+    _map->_start = _vaIndex; \
+    \
+    _map->_inRegs = inRegs; \
+    _map->_outRegs = outRegs; \
+    _map->_clobberedRegs = clobberedRegs; \
+    \
+    VarAttr* _va = vaTmpList; \
+    while (vaCount) { \
+      VarData* _vd = _va->getVd(); \
+      \
+      uint32_t _class = _vd->getClass(); \
+      uint32_t _index = _vaIndex.get(_class); \
+      \
+      _vaIndex.add(_class); \
+      \
+      if (_va->_inRegs) \
+        _va->_allocableRegs = _va->_inRegs; \
+      else if (_va->_outRegIndex != kInvalidReg) \
+        _va->_allocableRegs = Utils::mask(_va->_outRegIndex); \
+      else \
+        _va->_allocableRegs &= ~inRegs.get(_class); \
+      \
+      _vd->_va = nullptr; \
+      _map->getVa(_index)[0] = _va[0]; \
+      \
+      _va++; \
+      vaCount--; \
+    } \
+    \
+    _Node_->setMap(_map); \
+  } while (0)
+
+#define VI_ADD_VAR(_Vd_, _Va_, _Flags_, _NewAllocable_) \
+  do { \
+    ASMJIT_ASSERT(_Vd_->_va == nullptr); \
+    \
+    _Va_ = &vaTmpList[vaCount++]; \
+    _Va_->setup(_Vd_, _Flags_, 0, _NewAllocable_); \
+    _Va_->addVarCount(1); \
+    _Vd_->setVa(_Va_); \
+    \
+    if (_registerContextVar(_Vd_) != kErrorOk) \
+      goto _NoMemory; \
+    regCount.add(_Vd_->getClass()); \
+  } while (0)
+
+#define VI_MERGE_VAR(_Vd_, _Va_, _Flags_, _NewAllocable_) \
+  do { \
+    _Va_ = _Vd_->getVa(); \
+    \
+    if (_Va_ == nullptr) { \
+      _Va_ = &vaTmpList[vaCount++]; \
+      _Va_->setup(_Vd_, 0, 0, _NewAllocable_); \
+      _Vd_->setVa(_Va_); \
+      \
+      if (_registerContextVar(_Vd_) != kErrorOk) \
+        goto _NoMemory; \
+      regCount.add(_Vd_->getClass()); \
+    } \
+    \
+    _Va_->orFlags(_Flags_); \
+    _Va_->addVarCount(1); \
+  } while (0)
+
+  // --------------------------------------------------------------------------
+  // [Loop]
+  // --------------------------------------------------------------------------
+
+  do {
+_Do:
+    while (node_->isFetched()) {
+_NextGroup:
+      if (jLink == nullptr)
+        jLink = _jccList.getFirst();
+      else
+        jLink = jLink->getNext();
+
+      if (jLink == nullptr)
+        goto _Done;
+      node_ = X86Context_getOppositeJccFlow(static_cast<HLJump*>(jLink->getValue()));
+    }
+
+    flowId++;
+
+    next = node_->getNext();
+    node_->setFlowId(flowId);
+
+    ASMJIT_TSEC({
+      this->_traceNode(this, node_, "[F] ");
+    });
+
+    switch (node_->getType()) {
+      // ----------------------------------------------------------------------
+      // [Align/Embed]
+      // ----------------------------------------------------------------------
+
+      case HLNode::kTypeAlign:
+      case HLNode::kTypeData:
+        break;
+
+      // ----------------------------------------------------------------------
+      // [Hint]
+      // ----------------------------------------------------------------------
+
+      case HLNode::kTypeHint: {
+        HLHint* node = static_cast<HLHint*>(node_);
+        VI_BEGIN();
+
+        if (node->getHint() == kVarHintAlloc) {
+          uint32_t remain[_kX86RegClassManagedCount];
+          HLHint* cur = node;
+
+          remain[kX86RegClassGp ] = _regCount.getGp() - 1 - func->hasFuncFlag(kFuncFlagIsNaked);
+          remain[kX86RegClassMm ] = _regCount.getMm();
+          remain[kX86RegClassK  ] = _regCount.getK();
+          remain[kX86RegClassXyz] = _regCount.getXyz();
+
+          // Merge as many alloc-hints as possible.
+          for (;;) {
+            VarData* vd = static_cast<VarData*>(cur->getVd());
+            VarAttr* va = vd->getVa();
+
+            uint32_t regClass = vd->getClass();
+            uint32_t regIndex = cur->getValue();
+            uint32_t regMask = 0;
+
+            // We handle both kInvalidReg and kInvalidValue.
+            if (regIndex < kInvalidReg)
+              regMask = Utils::mask(regIndex);
+
+            if (va == nullptr) {
+              if (inRegs.has(regClass, regMask))
+                break;
+              if (remain[regClass] == 0)
+                break;
+              VI_ADD_VAR(vd, va, kVarAttrRReg, gaRegs[regClass]);
+
+              if (regMask != 0) {
+                inRegs.xor_(regClass, regMask);
+                va->setInRegs(regMask);
+                va->setInRegIndex(regIndex);
+              }
+
+              remain[regClass]--;
+            }
+            else if (regMask != 0) {
+              if (inRegs.has(regClass, regMask) && va->getInRegs() != regMask)
+                break;
+
+              inRegs.xor_(regClass, va->getInRegs() | regMask);
+              va->setInRegs(regMask);
+              va->setInRegIndex(regIndex);
+            }
+
+            if (cur != node)
+              compiler->removeNode(cur);
+
+            cur = static_cast<HLHint*>(node->getNext());
+            if (cur == nullptr || cur->getType() != HLNode::kTypeHint || cur->getHint() != kVarHintAlloc)
+              break;
+          }
+
+          next = node->getNext();
+        }
+        else  {
+          VarData* vd = static_cast<VarData*>(node->getVd());
+          VarAttr* va;
+
+          uint32_t flags = 0;
+
+          switch (node->getHint()) {
+            case kVarHintSpill:
+              flags = kVarAttrRMem | kVarAttrSpill;
+              break;
+            case kVarHintSave:
+              flags = kVarAttrRMem;
+              break;
+            case kVarHintSaveAndUnuse:
+              flags = kVarAttrRMem | kVarAttrUnuse;
+              break;
+            case kVarHintUnuse:
+              flags = kVarAttrUnuse;
+              break;
+          }
+
+          VI_ADD_VAR(vd, va, flags, 0);
+        }
+
+        VI_END(node_);
+        break;
+      }
+
+      // ----------------------------------------------------------------------
+      // [Target]
+      // ----------------------------------------------------------------------
+
+      case HLNode::kTypeLabel: {
+        if (node_ == func->getExitNode()) {
+          ASMJIT_PROPAGATE_ERROR(addReturningNode(node_));
+          goto _NextGroup;
+        }
+        break;
+      }
+
+      // ----------------------------------------------------------------------
+      // [Inst]
+      // ----------------------------------------------------------------------
+
+      case HLNode::kTypeInst: {
+        HLInst* node = static_cast<HLInst*>(node_);
+
+        uint32_t instId = node->getInstId();
+        uint32_t flags = node->getFlags();
+
+        Operand* opList = node->getOpList();
+        uint32_t opCount = node->getOpCount();
+
+        if (opCount) {
+          const X86InstExtendedInfo& extendedInfo = _x86InstInfo[instId].getExtendedInfo();
+          const X86SpecialInst* special = nullptr;
+          VI_BEGIN();
+
+          // Collect instruction flags and merge all 'VarAttr's.
+          if (extendedInfo.isFp())
+            flags |= HLNode::kFlagIsFp;
+
+          if (extendedInfo.isSpecial() && (special = X86SpecialInst_get(instId, opList, opCount)) != nullptr)
+            flags |= HLNode::kFlagIsSpecial;
+
+          uint32_t gpAllowedMask = 0xFFFFFFFF;
+
+          for (uint32_t i = 0; i < opCount; i++) {
+            Operand* op = &opList[i];
+            VarData* vd;
+            VarAttr* va;
+
+            if (op->isVar()) {
+              vd = compiler->getVdById(op->getId());
+              VI_MERGE_VAR(vd, va, 0, gaRegs[vd->getClass()] & gpAllowedMask);
+
+              if (static_cast<X86Var*>(op)->isGpb()) {
+                va->orFlags(static_cast<X86GpVar*>(op)->isGpbLo() ? kVarAttrX86GpbLo : kVarAttrX86GpbHi);
+                if (arch == kArchX86) {
+                  // If a byte register is accessed in 32-bit mode we have to limit
+                  // all allocable registers for that variable to eax/ebx/ecx/edx.
+                  // Other variables are not affected.
+                  va->_allocableRegs &= 0x0F;
+                }
+                else {
+                  // It's fine if lo-byte register is accessed in 64-bit mode;
+                  // however, hi-byte has to be checked and if it's used all
+                  // registers (GP/XMM) could be only allocated in the lower eight
+                  // half. To do that, we patch 'allocableRegs' of all variables
+                  // we collected until now and change the allocable restriction
+                  // for variables that come after.
+                  if (static_cast<X86GpVar*>(op)->isGpbHi()) {
+                    va->_allocableRegs &= 0x0F;
+
+                    if (gpAllowedMask != 0xFF) {
+                      for (uint32_t j = 0; j < i; j++)
+                        vaTmpList[j]._allocableRegs &= vaTmpList[j].hasFlag(kVarAttrX86GpbHi) ? 0x0F : 0xFF;
+                      gpAllowedMask = 0xFF;
+                    }
+                  }
+                }
+              }
+
+              if (special != nullptr) {
+                uint32_t inReg = special[i].inReg;
+                uint32_t outReg = special[i].outReg;
+                uint32_t c;
+
+                if (static_cast<const X86Reg*>(op)->isGp())
+                  c = kX86RegClassGp;
+                else
+                  c = kX86RegClassXyz;
+
+                if (inReg != kInvalidReg) {
+                  uint32_t mask = Utils::mask(inReg);
+                  inRegs.or_(c, mask);
+                  va->addInRegs(mask);
+                }
+
+                if (outReg != kInvalidReg) {
+                  uint32_t mask = Utils::mask(outReg);
+                  outRegs.or_(c, mask);
+                  va->setOutRegIndex(outReg);
+                }
+
+                va->orFlags(special[i].flags);
+              }
+              else {
+                uint32_t inFlags = kVarAttrRReg;
+                uint32_t outFlags = kVarAttrWReg;
+                uint32_t combinedFlags;
+
+                if (i == 0) {
+                  // Read/Write is usually the combination of the first operand.
+                  combinedFlags = inFlags | outFlags;
+
+                  if (node->getOptions() & kInstOptionOverwrite) {
+                    // Manually forcing write-only.
+                    combinedFlags = outFlags;
+                  }
+                  else if (extendedInfo.isWO()) {
+                    // Write-only instruction.
+                    uint32_t movSize = extendedInfo.getWriteSize();
+                    uint32_t varSize = vd->getSize();
+
+                    // Exception - If the source operand is a memory location
+                    // promote move size into 16 bytes.
+                    if (extendedInfo.isZeroIfMem() && opList[1].isMem())
+                      movSize = 16;
+
+                    if (static_cast<const X86Var*>(op)->isGp()) {
+                      uint32_t opSize = static_cast<const X86Var*>(op)->getSize();
+
+                      // Move size is zero in case that it should be determined
+                      // from the destination register.
+                      if (movSize == 0)
+                        movSize = opSize;
+
+                      // Handle the case that a 32-bit operation in 64-bit mode
+                      // always clears the rest of the destination register and
+                      // the case that move size is actually greater than or
+                      // equal to the size of the variable.
+                      if (movSize >= 4 || movSize >= varSize)
+                        combinedFlags = outFlags;
+                    }
+                    else if (movSize >= varSize) {
+                      // If move size is greater than or equal to the size of
+                      // the variable there is nothing to do, because the move
+                      // will overwrite the variable in all cases.
+                      combinedFlags = outFlags;
+                    }
+                  }
+                  else if (extendedInfo.isRO()) {
+                    // Comparison/Test instructions don't modify any operand.
+                    combinedFlags = inFlags;
+                  }
+                  else if (instId == kX86InstIdImul && opCount == 3) {
+                    // Imul.
+                    combinedFlags = outFlags;
+                  }
+                }
+                else {
+                  // Read-Only is usualy the combination of the second/third/fourth operands.
+                  combinedFlags = inFlags;
+
+                  // Idiv is a special instruction, never handled here.
+                  ASMJIT_ASSERT(instId != kX86InstIdIdiv);
+
+                  // Xchg/Xadd/Imul.
+                  if (extendedInfo.isXchg() || (instId == kX86InstIdImul && opCount == 3 && i == 1))
+                    combinedFlags = inFlags | outFlags;
+                }
+                va->orFlags(combinedFlags);
+              }
+            }
+            else if (op->isMem()) {
+              X86Mem* m = static_cast<X86Mem*>(op);
+              node->setMemOpIndex(i);
+
+              if (OperandUtil::isVarId(m->getBase()) && m->isBaseIndexType()) {
                 vd = compiler->getVdById(m->getBase());
                 if (!vd->isStack()) {
                   VI_MERGE_VAR(vd, va, 0, gaRegs[vd->getClass()] & gpAllowedMask);
@@ -2595,631 +3166,2816 @@ _NextGroup:
                     uint32_t outFlags = kVarAttrWMem;
                     uint32_t combinedFlags;
 
-                    if (i == 0) {
-                      // Default for the first operand.
-                      combinedFlags = inFlags | outFlags;
+                    if (i == 0) {
+                      // Default for the first operand.
+                      combinedFlags = inFlags | outFlags;
+
+                      if (extendedInfo.isWO()) {
+                        // Move to memory - setting the right flags is important
+                        // as if it's just move to the register. It's just a bit
+                        // simpler as there are no special cases.
+                        uint32_t movSize = Utils::iMax<uint32_t>(extendedInfo.getWriteSize(), m->getSize());
+                        uint32_t varSize = vd->getSize();
+
+                        if (movSize >= varSize)
+                          combinedFlags = outFlags;
+                      }
+                      else if (extendedInfo.isRO()) {
+                        // Comparison/Test instructions don't modify any operand.
+                        combinedFlags = inFlags;
+                      }
+                    }
+                    else {
+                      // Default for the second operand.
+                      combinedFlags = inFlags;
+
+                      // Handle Xchg instruction (modifies both operands).
+                      if (extendedInfo.isXchg())
+                        combinedFlags = inFlags | outFlags;
+                    }
+
+                    va->orFlags(combinedFlags);
+                  }
+                }
+              }
+
+              if (OperandUtil::isVarId(m->getIndex())) {
+                // Restrict allocation to all registers except ESP/RSP/R12.
+                vd = compiler->getVdById(m->getIndex());
+                VI_MERGE_VAR(vd, va, 0, gaRegs[kX86RegClassGp] & gpAllowedMask);
+                va->andAllocableRegs(indexMask);
+                va->orFlags(kVarAttrRReg);
+              }
+            }
+          }
+
+          node->setFlags(flags);
+          if (vaCount) {
+            // Handle instructions which result in zeros/ones or nop if used with the
+            // same destination and source operand.
+            if (vaCount == 1 && opCount >= 2 && opList[0].isVar() && opList[1].isVar() && !node->hasMemOp())
+              X86Context_prepareSingleVarInst(instId, &vaTmpList[0]);
+          }
+
+          VI_END(node_);
+        }
+
+        // Handle conditional/unconditional jump.
+        if (node->isJmpOrJcc()) {
+          HLJump* jNode = static_cast<HLJump*>(node);
+          HLLabel* jTarget = jNode->getTarget();
+
+          // If this jump is unconditional we put next node to unreachable node
+          // list so we can eliminate possible dead code. We have to do this in
+          // all cases since we are unable to translate without fetch() step.
+          //
+          // We also advance our node pointer to the target node to simulate
+          // natural flow of the function.
+          if (jNode->isJmp()) {
+            if (!next->isFetched())
+              ASMJIT_PROPAGATE_ERROR(addUnreachableNode(next));
+
+            // Jump not followed.
+            if (jTarget == nullptr) {
+              ASMJIT_PROPAGATE_ERROR(addReturningNode(jNode));
+              goto _NextGroup;
+            }
+
+            node_ = jTarget;
+            goto _Do;
+          }
+          else {
+            // Jump not followed.
+            if (jTarget == nullptr)
+              break;
+
+            if (jTarget->isFetched()) {
+              uint32_t jTargetFlowId = jTarget->getFlowId();
+
+              // Update HLNode::kFlagIsTaken flag to true if this is a
+              // conditional backward jump. This behavior can be overridden
+              // by using `kInstOptionTaken` when the instruction is created.
+              if (!jNode->isTaken() && opCount == 1 && jTargetFlowId <= flowId) {
+                jNode->orFlags(HLNode::kFlagIsTaken);
+              }
+            }
+            else if (next->isFetched()) {
+              node_ = jTarget;
+              goto _Do;
+            }
+            else {
+              ASMJIT_PROPAGATE_ERROR(addJccNode(jNode));
+              node_ = X86Context_getJccFlow(jNode);
+              goto _Do;
+            }
+          }
+        }
+        break;
+      }
+
+      // ----------------------------------------------------------------------
+      // [Func]
+      // ----------------------------------------------------------------------
+
+      case HLNode::kTypeFunc: {
+        ASMJIT_ASSERT(node_ == func);
+        X86FuncDecl* decl = func->getDecl();
+
+        VI_BEGIN();
+        for (uint32_t i = 0, argCount = decl->getNumArgs(); i < argCount; i++) {
+          const FuncInOut& arg = decl->getArg(i);
+
+          VarData* vd = func->getArg(i);
+          VarAttr* va;
+
+          if (vd == nullptr)
+            continue;
+
+          // Overlapped function arguments.
+          if (vd->getVa() != nullptr)
+            return compiler->setLastError(kErrorOverlappedArgs);
+          VI_ADD_VAR(vd, va, 0, 0);
+
+          uint32_t aType = arg.getVarType();
+          uint32_t vType = vd->getType();
+
+          if (arg.hasRegIndex()) {
+            if (x86VarTypeToClass(aType) == vd->getClass()) {
+              va->orFlags(kVarAttrWReg);
+              va->setOutRegIndex(arg.getRegIndex());
+            }
+            else {
+              va->orFlags(kVarAttrWConv);
+            }
+          }
+          else {
+            if ((x86VarTypeToClass(aType) == vd->getClass()) ||
+                (vType == kX86VarTypeXmmSs && aType == kVarTypeFp32) ||
+                (vType == kX86VarTypeXmmSd && aType == kVarTypeFp64)) {
+              va->orFlags(kVarAttrWMem);
+            }
+            else {
+              // TODO: [COMPILER] Not implemented.
+              ASMJIT_ASSERT(!"Implemented");
+            }
+          }
+        }
+        VI_END(node_);
+        break;
+      }
+
+      // ----------------------------------------------------------------------
+      // [End]
+      // ----------------------------------------------------------------------
+
+      case HLNode::kTypeSentinel: {
+        ASMJIT_PROPAGATE_ERROR(addReturningNode(node_));
+        goto _NextGroup;
+      }
+
+      // ----------------------------------------------------------------------
+      // [Ret]
+      // ----------------------------------------------------------------------
+
+      case HLNode::kTypeRet: {
+        HLRet* node = static_cast<HLRet*>(node_);
+        ASMJIT_PROPAGATE_ERROR(addReturningNode(node));
+
+        X86FuncDecl* decl = func->getDecl();
+        if (decl->hasRet()) {
+          const FuncInOut& ret = decl->getRet(0);
+          uint32_t retClass = x86VarTypeToClass(ret.getVarType());
+
+          VI_BEGIN();
+          for (uint32_t i = 0; i < 2; i++) {
+            Operand* op = &node->_ret[i];
+
+            if (op->isVar()) {
+              VarData* vd = compiler->getVdById(op->getId());
+              VarAttr* va;
+
+              VI_MERGE_VAR(vd, va, 0, 0);
+
+              if (retClass == vd->getClass()) {
+                // TODO: [COMPILER] Fix HLRet fetch.
+                va->orFlags(kVarAttrRReg);
+                va->setInRegs(i == 0 ? Utils::mask(kX86RegIndexAx) : Utils::mask(kX86RegIndexDx));
+                inRegs.or_(retClass, va->getInRegs());
+              }
+              else if (retClass == kX86RegClassFp) {
+                uint32_t fldFlag = ret.getVarType() == kVarTypeFp32 ? kVarAttrX86Fld4 : kVarAttrX86Fld8;
+                va->orFlags(kVarAttrRMem | fldFlag);
+              }
+              else {
+                // TODO: Fix possible other return type conversions.
+                ASMJIT_NOT_REACHED();
+              }
+            }
+          }
+          VI_END(node_);
+        }
+
+        if (!next->isFetched())
+          ASMJIT_PROPAGATE_ERROR(addUnreachableNode(next));
+        goto _NextGroup;
+      }
+
+      // ----------------------------------------------------------------------
+      // [Call]
+      // ----------------------------------------------------------------------
+
+      case HLNode::kTypeCall: {
+        X86CallNode* node = static_cast<X86CallNode*>(node_);
+        X86FuncDecl* decl = node->getDecl();
+
+        Operand* target = &node->_target;
+        Operand* args = node->_args;
+        Operand* rets = node->_ret;
+
+        func->addFuncFlags(kFuncFlagIsCaller);
+        func->mergeCallStackSize(node->_x86Decl.getArgStackSize());
+        node->_usedArgs = X86Context_getUsedArgs(this, node, decl);
+
+        uint32_t i;
+        uint32_t argCount = decl->getNumArgs();
+        uint32_t sArgCount = 0;
+        uint32_t gpAllocableMask = gaRegs[kX86RegClassGp] & ~node->_usedArgs.get(kX86RegClassGp);
+
+        VarData* vd;
+        VarAttr* va;
+
+        VI_BEGIN();
+
+        // Function-call operand.
+        if (target->isVar()) {
+          vd = compiler->getVdById(target->getId());
+          VI_MERGE_VAR(vd, va, 0, 0);
+
+          va->orFlags(kVarAttrRReg | kVarAttrRCall);
+          if (va->getInRegs() == 0)
+            va->addAllocableRegs(gpAllocableMask);
+        }
+        else if (target->isMem()) {
+          X86Mem* m = static_cast<X86Mem*>(target);
+
+          if (OperandUtil::isVarId(m->getBase()) && m->isBaseIndexType()) {
+            vd = compiler->getVdById(m->getBase());
+            if (!vd->isStack()) {
+              VI_MERGE_VAR(vd, va, 0, 0);
+              if (m->getMemType() == kMemTypeBaseIndex) {
+                va->orFlags(kVarAttrRReg | kVarAttrRCall);
+                if (va->getInRegs() == 0)
+                  va->addAllocableRegs(gpAllocableMask);
+              }
+              else {
+                va->orFlags(kVarAttrRMem | kVarAttrRCall);
+              }
+            }
+          }
+
+          if (OperandUtil::isVarId(m->getIndex())) {
+            // Restrict allocation to all registers except ESP/RSP/R12.
+            vd = compiler->getVdById(m->getIndex());
+            VI_MERGE_VAR(vd, va, 0, 0);
+
+            va->orFlags(kVarAttrRReg | kVarAttrRCall);
+            if ((va->getInRegs() & ~indexMask) == 0)
+              va->andAllocableRegs(gpAllocableMask & indexMask);
+          }
+        }
+
+        // Function-call arguments.
+        for (i = 0; i < argCount; i++) {
+          Operand* op = &args[i];
+          if (!op->isVar())
+            continue;
+
+          vd = compiler->getVdById(op->getId());
+          const FuncInOut& arg = decl->getArg(i);
+
+          if (arg.hasRegIndex()) {
+            VI_MERGE_VAR(vd, va, 0, 0);
+
+            uint32_t argType = arg.getVarType();
+            uint32_t argClass = x86VarTypeToClass(argType);
+
+            if (vd->getClass() == argClass) {
+              va->addInRegs(Utils::mask(arg.getRegIndex()));
+              va->orFlags(kVarAttrRReg | kVarAttrRFunc);
+            }
+            else {
+              va->orFlags(kVarAttrRConv | kVarAttrRFunc);
+            }
+          }
+          // If this is a stack-based argument we insert HLCallArg instead of
+          // using VarAttr. It improves the code, because the argument can be
+          // moved onto stack as soon as it is ready and the register used by
+          // the variable can be reused for something else. It is also much
+          // easier to handle argument conversions, because there will be at
+          // most only one node per conversion.
+          else {
+            if (X86Context_insertHLCallArg(this, node, vd, gaRegs, arg, i, sArgList, sArgCount) != kErrorOk)
+              goto _NoMemory;
+          }
+        }
+
+        // Function-call return(s).
+        for (i = 0; i < 2; i++) {
+          Operand* op = &rets[i];
+          if (!op->isVar())
+            continue;
+
+          const FuncInOut& ret = decl->getRet(i);
+          if (ret.hasRegIndex()) {
+            uint32_t retType = ret.getVarType();
+            uint32_t retClass = x86VarTypeToClass(retType);
+
+            vd = compiler->getVdById(op->getId());
+            VI_MERGE_VAR(vd, va, 0, 0);
+
+            if (vd->getClass() == retClass) {
+              va->setOutRegIndex(ret.getRegIndex());
+              va->orFlags(kVarAttrWReg | kVarAttrWFunc);
+            }
+            else {
+              va->orFlags(kVarAttrWConv | kVarAttrWFunc);
+            }
+          }
+        }
+
+        // Init clobbered.
+        clobberedRegs.set(kX86RegClassGp , Utils::bits(_regCount.getGp())  & (~decl->getPreserved(kX86RegClassGp )));
+        clobberedRegs.set(kX86RegClassMm , Utils::bits(_regCount.getMm())  & (~decl->getPreserved(kX86RegClassMm )));
+        clobberedRegs.set(kX86RegClassK  , Utils::bits(_regCount.getK())   & (~decl->getPreserved(kX86RegClassK  )));
+        clobberedRegs.set(kX86RegClassXyz, Utils::bits(_regCount.getXyz()) & (~decl->getPreserved(kX86RegClassXyz)));
+
+        VI_END(node_);
+        break;
+      }
+
+      default:
+        break;
+    }
+
+    node_ = next;
+  } while (node_ != stop);
+
+_Done:
+  // Mark exit label and end node as fetched, otherwise they can be removed by
+  // `removeUnreachableCode()`, which would lead to crash in some later step.
+  node_ = func->getEnd();
+  if (!node_->isFetched()) {
+    func->getExitNode()->setFlowId(++flowId);
+    node_->setFlowId(++flowId);
+  }
+
+  ASMJIT_TLOG("[F] ======= Fetch (Done)\n");
+  return kErrorOk;
+
+  // --------------------------------------------------------------------------
+  // [Failure]
+  // --------------------------------------------------------------------------
+
+_NoMemory:
+  ASMJIT_TLOG("[F] ======= Fetch (Out of Memory)\n");
+  return compiler->setLastError(kErrorNoHeapMemory);
+}
+
+// ============================================================================
+// [asmjit::X86Context - Schedule]
+// ============================================================================
+
+//! \internal
+//!
+//! Maximum count of instructions scheduled together, a longer run of
+//! instructions is split into several regions.
+static const uint32_t kX86SchedMaxNodes = 64;
+
+//! \internal
+//!
+//! Instruction of a scheduling region.
+struct X86SchedNode {
+  //! Instruction.
+  HLInst* inst;
+  //! Variables used by the instruction (can be `nullptr`).
+  X86VarMap* map;
+
+  //! Successors that have to be scheduled after this instruction.
+  uint64_t succs;
+  //! Successors that read a result of this instruction (subset of `succs`).
+  uint64_t dataSuccs;
+
+  //! Flow id of the instruction before scheduling.
+  uint32_t flowId;
+  //! Estimated latency of the result.
+  uint32_t latency;
+  //! Length of the longest latency path from the instruction to the end of
+  //! the region (including its own latency).
+  uint32_t height;
+  //! The earliest cycle when all inputs are ready.
+  uint32_t readyTime;
+  //! Count of predecessors not scheduled yet.
+  uint32_t predCount;
+
+  //! EFLAGS read by the instruction.
+  uint32_t eflagsIn;
+  //! EFLAGS written by the instruction.
+  uint32_t eflagsOut;
+
+  //! Whether the instruction reads memory.
+  bool memRead;
+  //! Whether the instruction writes memory.
+  bool memWrite;
+};
+
+//! \internal
+//!
+//! Get whether `node` can be reordered by the scheduler.
+//!
+//! Only instructions whose register operands are all variables can be moved,
+//! as their dependencies are fully described by their `X86VarMap`. Anything
+//! else (labels, jumps, calls, hints, volatile instructions, instructions
+//! that use physical registers, x87 or implicit memory) splits regions.
+static bool X86Context_isSchedulable(HLNode* node) {
+  if (node->getType() != HLNode::kTypeInst || !node->isFetched() || node->isJmpOrJcc() || node->isFp())
+    return false;
+
+  HLInst* inst = static_cast<HLInst*>(node);
+  uint32_t opCount = inst->getOpCount();
+
+  if (opCount == 0 || (inst->getOptions() & kX86InstOptionLock) != 0)
+    return false;
+
+  const X86InstExtendedInfo& extendedInfo = _x86InstInfo[inst->getInstId()].getExtendedInfo();
+  if (extendedInfo.isVolatile() || extendedInfo.isFlow() || extendedInfo.isSpecialMem())
+    return false;
+
+  X86VarMap* map = inst->getMap<X86VarMap>();
+  if (map != nullptr && !map->_clobberedRegs.isEmpty())
+    return false;
+
+  const Operand* opList = inst->getOpList();
+  for (uint32_t i = 0; i < opCount; i++) {
+    if (opList[i].isReg())
+      return false;
+  }
+
+  return true;
+}
+
+//! \internal
+//!
+//! Get estimated latency of `inst`.
+//!
+//! The model is a coarse approximation of recent x86 cores, it only has to
+//! tell short and long operations apart. A memory operand adds the latency
+//! of a load that hits L1.
+static uint32_t X86Context_getSchedLatency(const HLInst* inst) {
+  uint32_t latency;
+
+  switch (inst->getInstId()) {
+    case kX86InstIdDiv:
+    case kX86InstIdIdiv:
+      latency = 26;
+      break;
+
+    case kX86InstIdSqrtps:
+    case kX86InstIdSqrtpd:
+    case kX86InstIdSqrtss:
+    case kX86InstIdSqrtsd:
+    case kX86InstIdVsqrtps:
+    case kX86InstIdVsqrtpd:
+    case kX86InstIdVsqrtss:
+    case kX86InstIdVsqrtsd:
+      latency = 18;
+      break;
+
+    case kX86InstIdDivps:
+    case kX86InstIdDivpd:
+    case kX86InstIdDivss:
+    case kX86InstIdDivsd:
+    case kX86InstIdVdivps:
+    case kX86InstIdVdivpd:
+    case kX86InstIdVdivss:
+    case kX86InstIdVdivsd:
+      latency = 14;
+      break;
+
+    case kX86InstIdPmulld:
+    case kX86InstIdVpmulld:
+    case kX86InstIdDpps:
+    case kX86InstIdDppd:
+    case kX86InstIdVdpps:
+    case kX86InstIdVdppd:
+      latency = 10;
+      break;
+
+    case kX86InstIdPmullw:
+    case kX86InstIdPmulhw:
+    case kX86InstIdPmulhuw:
+    case kX86InstIdPmuludq:
+    case kX86InstIdPmaddwd:
+    case kX86InstIdVpmullw:
+    case kX86InstIdVpmulhw:
+    case kX86InstIdVpmulhuw:
+    case kX86InstIdVpmuludq:
+    case kX86InstIdVpmaddwd:
+    case kX86InstIdHaddps:
+    case kX86InstIdHaddpd:
+    case kX86InstIdVhaddps:
+    case kX86InstIdVhaddpd:
+    case kX86InstIdVfmadd132ps:
+    case kX86InstIdVfmadd213ps:
+    case kX86InstIdVfmadd231ps:
+    case kX86InstIdVfmadd132pd:
+    case kX86InstIdVfmadd213pd:
+    case kX86InstIdVfmadd231pd:
+      latency = 5;
+      break;
+
+    case kX86InstIdAddps:
+    case kX86InstIdAddpd:
+    case kX86InstIdAddss:
+    case kX86InstIdAddsd:
+    case kX86InstIdSubps:
+    case kX86InstIdSubpd:
+    case kX86InstIdSubss:
+    case kX86InstIdSubsd:
+    case kX86InstIdMulps:
+    case kX86InstIdMulpd:
+    case kX86InstIdMulss:
+    case kX86InstIdMulsd:
+    case kX86InstIdMinps:
+    case kX86InstIdMinpd:
+    case kX86InstIdMaxps:
+    case kX86InstIdMaxpd:
+    case kX86InstIdCvtdq2ps:
+    case kX86InstIdCvtps2dq:
+    case kX86InstIdCvttps2dq:
+    case kX86InstIdCvtsi2sd:
+    case kX86InstIdCvtsi2ss:
+    case kX86InstIdRcpps:
+    case kX86InstIdRsqrtps:
+    case kX86InstIdVaddps:
+    case kX86InstIdVaddpd:
+    case kX86InstIdVsubps:
+    case kX86InstIdVsubpd:
+    case kX86InstIdVmulps:
+    case kX86InstIdVmulpd:
+    case kX86InstIdVminps:
+    case kX86InstIdVmaxps:
+    case kX86InstIdVcvtdq2ps:
+    case kX86InstIdVcvtps2dq:
+      latency = 4;
+      break;
+
+    case kX86InstIdImul:
+    case kX86InstIdMul:
+    case kX86InstIdPopcnt:
+    case kX86InstIdLzcnt:
+    case kX86InstIdTzcnt:
+    case kX86InstIdBsf:
+    case kX86InstIdBsr:
+      latency = 3;
+      break;
+
+    default:
+      latency = 1;
+      break;
+  }
+
+  if (inst->hasMemOp())
+    latency += 4;
+
+  return latency;
+}
+
+//! \internal
+//!
+//! Get whether `b` has to stay after `a` and whether it reads a result of `a`
+//! (returned as `isData`).
+static bool X86Context_isSchedDependent(const X86SchedNode& a, const X86SchedNode& b, bool& isData) {
+  bool dependent = false;
+  isData = false;
+
+  if (a.map != nullptr && b.map != nullptr) {
+    uint32_t vaCount = b.map->getVaCount();
+
+    for (uint32_t i = 0; i < vaCount; i++) {
+      VarAttr* vb = b.map->getVa(i);
+      VarAttr* va = a.map->findVa(vb->getVd());
+
+      if (va == nullptr)
+        continue;
+
+      if (va->hasFlag(kVarAttrWAll) && vb->hasFlag(kVarAttrRAll))
+        isData = true;
+
+      if (va->hasFlag(kVarAttrWAll) || vb->hasFlag(kVarAttrWAll))
+        dependent = true;
+    }
+  }
+
+  if ((a.eflagsOut & b.eflagsIn) != 0)
+    isData = true;
+
+  if ((b.eflagsOut & (a.eflagsIn | a.eflagsOut)) != 0)
+    dependent = true;
+
+  if (a.memWrite && b.memRead)
+    isData = true;
+
+  if (b.memWrite && (a.memRead || a.memWrite))
+    dependent = true;
+
+  return dependent || isData;
+}
+
+//! \internal
+//!
+//! Flags of `varUses` entries, the rest is count of instructions of the
+//! region not scheduled yet that use the variable.
+enum X86SchedVarFlags {
+  //! The variable is alive at the current position.
+  kX86SchedVarLive = 0x80000000,
+  //! The variable is alive after the region.
+  kX86SchedVarLiveOut = 0x40000000,
+  //! Mask of the use count.
+  kX86SchedVarUses = 0x3FFFFFFF
+};
+
+//! \internal
+//!
+//! Get whether `va` writes its variable without reading it.
+static ASMJIT_INLINE bool X86Context_isSchedDef(VarAttr* va) {
+  return !va->hasFlag(kVarAttrRAll) && va->hasFlag(kVarAttrWAll);
+}
+
+//! \internal
+//!
+//! Get whether scheduling `sn` now would make more variables of some class
+//! alive than there are `limits` registers for and than there are now.
+static bool X86Context_isSchedOverLimit(const X86SchedNode& sn, const uint32_t* varUses, const uint32_t* pressure, const uint32_t* limits) {
+  if (sn.map == nullptr)
+    return false;
+
+  for (uint32_t rc = 0; rc < _kX86RegClassManagedCount; rc++) {
+    uint32_t vaCount = sn.map->getVaCountByClass(rc);
+    uint32_t opened = 0;
+    uint32_t closed = 0;
+
+    for (uint32_t i = 0; i < vaCount; i++) {
+      VarAttr* va = sn.map->getVaByClass(rc, i);
+      uint32_t uses = varUses[va->getVd()->getLocalId()];
+
+      if (X86Context_isSchedDef(va)) {
+        // Starts a variable that stays alive after this instruction.
+        if ((uses & kX86SchedVarLive) == 0 &&
+            ((uses & kX86SchedVarUses) > 1 || (uses & kX86SchedVarLiveOut) != 0))
+          opened++;
+      }
+      else {
+        // Ends a variable by its last use.
+        if ((uses & kX86SchedVarLive) != 0 &&
+            (uses & kX86SchedVarUses) == 1 && (uses & kX86SchedVarLiveOut) == 0)
+          closed++;
+      }
+    }
+
+    if (opened > closed && pressure[rc] + opened - closed > limits[rc])
+      return true;
+  }
+
+  return false;
+}
+
+//! \internal
+//!
+//! Get the count of variables alive over `limits` registers of each class,
+//! summed over all instructions of `list` in their original order, starting
+//! with `pressure` variables alive. It estimates how many spills and allocs
+//! the order needs.
+//!
+//! Uses `kVarAttrDead` flags of the liveness analysis, a variable starts at
+//! a write that is not dead and ends at a read that is.
+static uint32_t X86Context_getSchedExcess(const X86SchedNode* list, uint32_t count, const uint32_t* pressure, const uint32_t* limits) {
+  uint32_t current[_kX86RegClassManagedCount];
+  uint32_t excess = 0;
+  uint32_t rc;
+
+  for (rc = 0; rc < _kX86RegClassManagedCount; rc++)
+    current[rc] = pressure[rc];
+
+  for (uint32_t i = 0; i < count; i++) {
+    X86VarMap* map = list[i].map;
+    if (map == nullptr)
+      continue;
+
+    uint32_t vaCount = map->getVaCount();
+    for (uint32_t j = 0; j < vaCount; j++) {
+      VarAttr* va = map->getVa(j);
+      rc = va->getVd()->getClass();
+
+      if (X86Context_isSchedDef(va)) {
+        if (!va->hasFlag(kVarAttrDead))
+          current[rc]++;
+      }
+      else if (va->hasFlag(kVarAttrDead)) {
+        current[rc]--;
+      }
+    }
+
+    for (rc = 0; rc < _kX86RegClassManagedCount; rc++) {
+      if (current[rc] > limits[rc])
+        excess += current[rc] - limits[rc];
+    }
+  }
+
+  return excess;
+}
+
+//! \internal
+//!
+//! Schedule `count` instructions of `list` (all inside `block`) and relink
+//! them in the new order. `next` is the node following the region.
+//!
+//! `varUses` (indexed by local id) has to contain uses and `kX86SchedVar...`
+//! flags of all variables of the region and is cleared on return. `pressure`
+//! is count of variables of each class alive at the start of the region and
+//! `limits` count of registers of each class. Instructions that would make
+//! more variables alive than there are registers are only picked if there is
+//! no other choice to avoid introducing spills. If the new order still keeps
+//! more variables alive over the limits than the original order did (see
+//! `X86Context_getSchedExcess()`), the original order is kept.
+static void X86Context_scheduleRegion(BasicBlock* block, X86SchedNode* list, uint32_t count, HLNode* next,
+  uint32_t* varUses, uint32_t* pressure, const uint32_t* limits) {
+
+  uint32_t i, j;
+
+  for (i = 0; i < count; i++) {
+    X86SchedNode& sn = list[i];
+    HLInst* inst = sn.inst;
+
+    const X86InstInfo& info = _x86InstInfo[inst->getInstId()];
+    const X86InstExtendedInfo& extendedInfo = info.getExtendedInfo();
+
+    sn.map = inst->getMap<X86VarMap>();
+    sn.succs = 0;
+    sn.dataSuccs = 0;
+    sn.flowId = inst->getFlowId();
+    sn.latency = X86Context_getSchedLatency(inst);
+    sn.readyTime = 0;
+    sn.predCount = 0;
+    sn.eflagsIn = info.getEFlagsIn();
+    sn.eflagsOut = info.getEFlagsOut();
+    sn.memRead = false;
+    sn.memWrite = false;
+
+    if (inst->hasMemOp()) {
+      if (inst->getMemOp() != inst->getOpList()) {
+        sn.memRead = true;
+        sn.memWrite = extendedInfo.isXchg();
+      }
+      else {
+        sn.memRead = !extendedInfo.isWO();
+        sn.memWrite = !extendedInfo.isRO();
+      }
+    }
+  }
+
+  // Build dependencies, the region is small enough to compare all pairs.
+  for (j = 1; j < count; j++) {
+    for (i = 0; i < j; i++) {
+      bool isData;
+      if (X86Context_isSchedDependent(list[i], list[j], isData)) {
+        list[i].succs |= static_cast<uint64_t>(1) << j;
+        if (isData)
+          list[i].dataSuccs |= static_cast<uint64_t>(1) << j;
+        list[j].predCount++;
+      }
+    }
+  }
+
+  // Keep the instruction that sets flags for a conditional jump right before
+  // it, so the pair can be fused by the CPU.
+  if (next->isJcc()) {
+    X86SchedNode& last = list[count - 1];
+    uint32_t eflagsIn = _x86InstInfo[static_cast<HLInst*>(next)->getInstId()].getEFlagsIn();
+
+    if ((last.eflagsOut & eflagsIn) != 0) {
+      uint64_t mask = static_cast<uint64_t>(1) << (count - 1);
+      for (i = 0; i < count - 1; i++) {
+        if ((list[i].succs & mask) == 0) {
+          list[i].succs |= mask;
+          last.predCount++;
+        }
+      }
+    }
+  }
+
+  // Compute heights in reverse order, successors always follow.
+  i = count;
+  while (i != 0) {
+    X86SchedNode& sn = list[--i];
+    uint32_t height = sn.latency;
+
+    for (j = i + 1; j < count; j++) {
+      uint64_t mask = static_cast<uint64_t>(1) << j;
+      if ((sn.succs & mask) == 0)
+        continue;
+
+      uint32_t h = list[j].height;
+      if ((sn.dataSuccs & mask) != 0)
+        h += sn.latency;
+      height = Utils::iMax<uint32_t>(height, h);
+    }
+
+    sn.height = height;
+  }
+
+  // List scheduling - issue one instruction per cycle, pick the one that can
+  // start first and prefer the longest remaining path, then the original
+  // order. Instructions over the register limit only come last.
+  uint32_t flowIds[kX86SchedMaxNodes];
+  uint8_t order[kX86SchedMaxNodes];
+
+  uint32_t excess = X86Context_getSchedExcess(list, count, pressure, limits);
+  uint32_t schedExcess = 0;
+  uint32_t rc;
+
+  for (i = 0; i < count; i++)
+    flowIds[i] = list[i].flowId;
+
+  uint64_t done = 0;
+  uint32_t cycle = 0;
+
+  for (uint32_t n = 0; n < count; n++) {
+    uint32_t best = kInvalidValue;
+    uint32_t bestStart = 0;
+    bool bestOver = false;
+
+    for (i = 0; i < count; i++) {
+      if ((done & (static_cast<uint64_t>(1) << i)) != 0 || list[i].predCount != 0)
+        continue;
+
+      bool over = X86Context_isSchedOverLimit(list[i], varUses, pressure, limits);
+      uint32_t start = Utils::iMax<uint32_t>(list[i].readyTime, cycle);
+
+      if (best != kInvalidValue) {
+        if (over != bestOver) {
+          if (over)
+            continue;
+        }
+        else if (start > bestStart || (start == bestStart && list[i].height <= list[best].height)) {
+          continue;
+        }
+      }
+
+      best = i;
+      bestStart = start;
+      bestOver = over;
+    }
+
+    ASMJIT_ASSERT(best != kInvalidValue);
+    X86SchedNode& sn = list[best];
+
+    order[n] = static_cast<uint8_t>(best);
+    done |= static_cast<uint64_t>(1) << best;
+    cycle = bestStart + 1;
+
+    for (j = best + 1; j < count; j++) {
+      uint64_t mask = static_cast<uint64_t>(1) << j;
+      if ((sn.succs & mask) == 0)
+        continue;
+
+      if ((sn.dataSuccs & mask) != 0)
+        list[j].readyTime = Utils::iMax<uint32_t>(list[j].readyTime, bestStart + sn.latency);
+      list[j].predCount--;
+    }
+
+    // Update variables alive after the instruction.
+    if (sn.map != nullptr) {
+      uint32_t vaCount = sn.map->getVaCount();
+
+      for (j = 0; j < vaCount; j++) {
+        VarAttr* va = sn.map->getVa(j);
+        VarData* vd = va->getVd();
+        uint32_t& uses = varUses[vd->getLocalId()];
+
+        uses--;
+        if ((uses & kX86SchedVarUses) != 0 || (uses & kX86SchedVarLiveOut) != 0) {
+          if ((uses & kX86SchedVarLive) == 0 && X86Context_isSchedDef(va)) {
+            uses |= kX86SchedVarLive;
+            pressure[vd->getClass()]++;
+          }
+        }
+        else if ((uses & kX86SchedVarLive) != 0) {
+          uses &= ~kX86SchedVarLive;
+          pressure[vd->getClass()]--;
+        }
+      }
+    }
+
+    for (rc = 0; rc < _kX86RegClassManagedCount; rc++) {
+      if (pressure[rc] > limits[rc])
+        schedExcess += pressure[rc] - limits[rc];
+    }
+  }
+
+  // Keep the original order if the new one needs any spills and doesn't need
+  // fewer than the original, even the same count of spills is not the same
+  // spill code as the allocator picks different variables to spill.
+  if (schedExcess != 0 && schedExcess >= excess) {
+    for (i = 0; i < count; i++)
+      order[i] = static_cast<uint8_t>(i);
+  }
+
+  // Relink nodes and exchange their flow ids.
+  HLNode* prev = list[0].inst->getPrev();
+  bool isFirst = block->_first == list[0].inst;
+
+  for (i = 0; i < count; i++) {
+    HLInst* inst = list[order[i]].inst;
+
+    inst->setFlowId(flowIds[i]);
+    inst->orFlags(HLNode::kFlagIsScheduled);
+
+    prev->_next = inst;
+    inst->_prev = prev;
+    prev = inst;
+  }
+
+  prev->_next = next;
+  next->_prev = prev;
+
+  if (isFirst)
+    block->_first = list[order[0]].inst;
+  if (block->_last == list[count - 1].inst)
+    block->_last = prev;
+
+  // Mark variables not alive after the instruction in the new order by
+  // `kVarAttrDead` the same way as `livenessAnalysis()` does.
+  for (i = 0; i < count; i++) {
+    X86VarMap* map = list[i].map;
+    if (map == nullptr)
+      continue;
+
+    uint32_t vaCount = map->getVaCount();
+    for (j = 0; j < vaCount; j++) {
+      VarAttr* va = map->getVa(j);
+      uint32_t& uses = varUses[va->getVd()->getLocalId()];
+
+      va->andNotFlags(kVarAttrDead);
+      uses = (uses & kX86SchedVarLiveOut) ? kX86SchedVarLiveOut | kX86SchedVarLive : 0;
+    }
+  }
+
+  i = count;
+  while (i != 0) {
+    X86VarMap* map = list[order[--i]].map;
+    if (map == nullptr)
+      continue;
+
+    uint32_t vaCount = map->getVaCount();
+    for (j = 0; j < vaCount; j++) {
+      VarAttr* va = map->getVa(j);
+      uint32_t& uses = varUses[va->getVd()->getLocalId()];
+
+      if ((uses & kX86SchedVarLive) == 0)
+        va->orFlags(kVarAttrDead);
+
+      uses = X86Context_isSchedDef(va) ? 0 : kX86SchedVarLive;
+    }
+  }
+
+  // Clear the state of all variables of the region.
+  for (i = 0; i < count; i++) {
+    X86VarMap* map = list[i].map;
+    if (map == nullptr)
+      continue;
+
+    uint32_t vaCount = map->getVaCount();
+    for (j = 0; j < vaCount; j++)
+      varUses[map->getVa(j)->getVd()->getLocalId()] = 0;
+  }
+}
+
+//! \internal
+//!
+//! Update variables alive before `node` from variables alive after it.
+static ASMJIT_INLINE void X86Context_updateSchedLive(BitArray* live, uint32_t* liveCount, HLNode* node) {
+  X86VarMap* map = node->getMap<X86VarMap>();
+  if (map == nullptr)
+    return;
+
+  uint32_t vaCount = map->getVaCount();
+  for (uint32_t i = 0; i < vaCount; i++) {
+    VarAttr* va = map->getVa(i);
+    VarData* vd = va->getVd();
+    uint32_t localId = vd->getLocalId();
+
+    if (X86Context_isSchedDef(va)) {
+      if (live->getBit(localId)) {
+        live->delBit(localId);
+        liveCount[vd->getClass()]--;
+      }
+    }
+    else if (!live->getBit(localId)) {
+      live->setBit(localId);
+      liveCount[vd->getClass()]++;
+    }
+  }
+}
+
+//! \internal
+//!
+//! Schedule region of `count` instructions collected by `schedule()`, `live`
+//! are variables alive before the region.
+static void X86Context_flushSchedRegion(BasicBlock* block, X86SchedNode* region, uint32_t count, HLNode* next,
+  const BitArray* live, uint32_t* varUses, const uint32_t* liveCount, const uint32_t* limits) {
+
+  uint32_t i, j;
+
+  for (i = 0; i < count; i++) {
+    X86VarMap* map = region[i].inst->getMap<X86VarMap>();
+    if (map == nullptr)
+      continue;
+
+    uint32_t vaCount = map->getVaCount();
+    for (j = 0; j < vaCount; j++) {
+      uint32_t localId = map->getVa(j)->getVd()->getLocalId();
+      if (count == 1)
+        varUses[localId] = 0;
+      else if (live->getBit(localId))
+        varUses[localId] |= kX86SchedVarLive;
+    }
+  }
+
+  if (count > 1) {
+    uint32_t pressure[_kX86RegClassManagedCount];
+    ::memcpy(pressure, liveCount, sizeof(pressure));
+    X86Context_scheduleRegion(block, region, count, next, varUses, pressure, limits);
+  }
+}
+
+Error X86Context::schedule() {
+  ASMJIT_TLOG("[S] ======= Schedule (Begin)\n");
+
+  uint32_t varCount = static_cast<uint32_t>(_contextVd.getLength());
+  uint32_t bLen = (varCount + BitArray::kEntityBits - 1) / BitArray::kEntityBits;
+
+  // No variables, there is nothing the scheduler could reorder.
+  if (bLen == 0)
+    return kErrorOk;
+
+  BitArray* live = newBits(bLen);
+  uint32_t* varUses = _zoneAllocator.allocT<uint32_t>(varCount * sizeof(uint32_t));
+
+  if (live == nullptr || varUses == nullptr)
+    return kErrorNoHeapMemory;
+  ::memset(varUses, 0, varCount * sizeof(uint32_t));
+
+  uint32_t limits[_kX86RegClassManagedCount];
+  uint32_t liveCount[_kX86RegClassManagedCount];
+  uint32_t rc;
+
+  for (rc = 0; rc < _kX86RegClassManagedCount; rc++)
+    limits[rc] = Utils::bitCount(_gaRegs[rc]);
+
+  X86SchedNode list[kX86SchedMaxNodes];
+  X86SchedNode* listEnd = list + kX86SchedMaxNodes;
+
+  // Each block is walked backwards so variables alive before and after each
+  // region are known, the instructions of a region are collected backwards
+  // too.
+  for (uint32_t blockIndex = 0; blockIndex < _blockCount; blockIndex++) {
+    BasicBlock* block = _blocks[blockIndex];
+
+    HLNode* first = block->_first;
+    HLNode* node = block->_last;
+    HLNode* next = nullptr;
+
+    uint32_t count = 0;
+    uint32_t i;
+
+    live->copyBits(block->_liveOut, bLen);
+    for (rc = 0; rc < _kX86RegClassManagedCount; rc++)
+      liveCount[rc] = 0;
+
+    for (i = 0; i < varCount; i++) {
+      if (live->getBit(i))
+        liveCount[_contextVd[i]->getClass()]++;
+    }
+
+    for (;;) {
+      HLNode* prev = node->getPrev();
+
+      if (X86Context_isSchedulable(node)) {
+        if (count == kX86SchedMaxNodes) {
+          X86Context_flushSchedRegion(block, listEnd - count, count, next, live, varUses, liveCount, limits);
+          count = 0;
+        }
+
+        if (count == 0)
+          next = node->getNext();
+
+        // The first use of a variable found walking backwards is its last
+        // use in the region, the variable is alive after the region if it's
+        // alive after that use.
+        X86VarMap* map = node->getMap<X86VarMap>();
+        if (map != nullptr) {
+          uint32_t vaCount = map->getVaCount();
+          for (uint32_t j = 0; j < vaCount; j++) {
+            uint32_t localId = map->getVa(j)->getVd()->getLocalId();
+            uint32_t& uses = varUses[localId];
+
+            if (uses == 0 && live->getBit(localId))
+              uses = kX86SchedVarLiveOut;
+            uses++;
+          }
+        }
+
+        (listEnd - ++count)->inst = static_cast<HLInst*>(node);
+      }
+      else if (count != 0) {
+        X86Context_flushSchedRegion(block, listEnd - count, count, next, live, varUses, liveCount, limits);
+        count = 0;
+      }
+
+      X86Context_updateSchedLive(live, liveCount, node);
+
+      if (node == first)
+        break;
+      node = prev;
+    }
+
+    if (count != 0)
+      X86Context_flushSchedRegion(block, listEnd - count, count, next, live, varUses, liveCount, limits);
+  }
+
+  ASMJIT_TLOG("[S] ======= Schedule (End)\n");
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86Context - LinearScan]
+// ============================================================================
+
+//! \internal
+//!
+//! Position where a variable is used (referenced by a node).
+struct X86LsUse {
+  //! Next use of the same variable.
+  X86LsUse* next;
+  //! Position.
+  uint32_t position;
+};
+
+//! \internal
+//!
+//! Live interval of a variable (or of its remainder after a split). Each
+//! run of consecutive nodes where the variable is alive has its own interval.
+struct X86LsInterval {
+  //! Next interval (in the order of creation).
+  X86LsInterval* next;
+  //! Variable.
+  VarData* vd;
+  //! First use at or after `start` (cursor, only moves forward).
+  X86LsUse* uses;
+  //! First position (inclusive).
+  uint32_t start;
+  //! Last position (inclusive).
+  uint32_t end;
+  //! Registers the variable can be allocated in at all of its uses.
+  uint32_t allocableRegs;
+};
+
+//! \internal
+//!
+//! Position where a physical register is required by a fixed use of `vd` or
+//! clobbered (`vd` is null in that case).
+struct X86LsFixed {
+  //! Next fixed position of the same register.
+  X86LsFixed* next;
+  //! Position.
+  uint32_t position;
+  //! Variable that owns the register at `position`.
+  VarData* vd;
+};
+
+//! \internal
+static ASMJIT_INLINE bool X86Context_lsLess(const X86LsInterval* a, const X86LsInterval* b) {
+  return a->start < b->start || (a->start == b->start && a->end < b->end);
+}
+
+//! \internal
+//!
+//! Push `interval` into the min-heap of intervals ordered by start.
+static Error X86Context_lsPush(PodVector<X86LsInterval*>& heap, X86LsInterval* interval) {
+  ASMJIT_PROPAGATE_ERROR(heap.append(interval));
+
+  X86LsInterval** data = heap.getData();
+  uint32_t i = static_cast<uint32_t>(heap.getLength()) - 1;
+
+  while (i != 0) {
+    uint32_t parent = (i - 1) / 2;
+    if (!X86Context_lsLess(interval, data[parent]))
+      break;
+
+    data[i] = data[parent];
+    i = parent;
+  }
+
+  data[i] = interval;
+  return kErrorOk;
+}
+
+//! \internal
+//!
+//! Pop the interval that starts first from the min-heap.
+static X86LsInterval* X86Context_lsPop(PodVector<X86LsInterval*>& heap) {
+  X86LsInterval** data = heap.getData();
+  uint32_t length = static_cast<uint32_t>(heap.getLength()) - 1;
+
+  X86LsInterval* result = data[0];
+  X86LsInterval* last = data[length];
+  heap.truncate(length);
+
+  uint32_t i = 0;
+  for (;;) {
+    uint32_t child = i * 2 + 1;
+    if (child >= length)
+      break;
+
+    if (child + 1 < length && X86Context_lsLess(data[child + 1], data[child]))
+      child++;
+
+    if (!X86Context_lsLess(data[child], last))
+      break;
+
+    data[i] = data[child];
+    i = child;
+  }
+
+  if (length != 0)
+    data[i] = last;
+  return result;
+}
+
+//! \internal
+//!
+//! Get the first position at or after `position` where the register is needed
+//! by something else than `vd`, or `kInvalidValue`. The first position where
+//! `vd` itself needs the register before that is stored to `owned`. The
+//! `fixed` cursor only moves forward as the scan never goes back.
+static ASMJIT_INLINE uint32_t X86Context_lsNextFixed(X86LsFixed*& fixed, uint32_t position, VarData* vd, uint32_t& owned) {
+  X86LsFixed* cur = fixed;
+  while (cur != nullptr && cur->position < position)
+    cur = cur->next;
+  fixed = cur;
+
+  owned = kInvalidValue;
+  if (cur != nullptr && cur->vd == vd) {
+    owned = cur->position;
+    do {
+      cur = cur->next;
+    } while (cur != nullptr && cur->vd == vd);
+  }
+
+  return cur != nullptr ? cur->position : static_cast<uint32_t>(kInvalidValue);
+}
+
+//! \internal
+//!
+//! Get the first use of `interval` at or after `position`, or `kInvalidValue`.
+static ASMJIT_INLINE uint32_t X86Context_lsNextUse(X86LsInterval* interval, uint32_t position) {
+  X86LsUse* use = interval->uses;
+  while (use != nullptr && use->position < position)
+    use = use->next;
+  interval->uses = use;
+
+  if (use == nullptr || use->position > interval->end)
+    return kInvalidValue;
+  return use->position;
+}
+
+//! \internal
+//!
+//! Create a remainder of `interval` starting at `start` and push it to `heap`.
+static ASMJIT_INLINE Error X86Context_lsRequeue(X86Context* self,
+  PodVector<X86LsInterval*>& heap,
+  X86LsInterval* interval, uint32_t start, uint32_t end) {
+
+  X86LsInterval* rest = self->_zoneAllocator.allocT<X86LsInterval>();
+  if (rest == nullptr)
+    return kErrorNoHeapMemory;
+
+  *rest = *interval;
+  rest->start = start;
+  rest->end = end;
+
+  return X86Context_lsPush(heap, rest);
+}
+
+//! \internal
+//!
+//! Run the linear scan of all intervals of class `C`.
+template<int C>
+static Error X86Context_lsScan(X86Context* self,
+  X86LsInterval* intervals, X86LsFixed** fixedList) {
+
+  Zone& zone = self->_zoneAllocator;
+  X86LsRange** lsRanges = self->_lsRanges;
+  PodVector<X86LsInterval*>& heap = self->_lsHeap;
+
+  for (X86LsInterval* interval = intervals; interval != nullptr; interval = interval->next) {
+    if (interval->vd->getClass() == C)
+      ASMJIT_PROPAGATE_ERROR(X86Context_lsPush(heap, interval));
+  }
+
+  // Active interval and its range, per register.
+  X86LsInterval* active[32];
+  X86LsRange* activeRange[32];
+  uint32_t activeRegs = 0;
+
+  while (!heap.isEmpty()) {
+    X86LsInterval* cur = X86Context_lsPop(heap);
+    VarData* vd = cur->vd;
+    uint32_t localId = vd->getLocalId();
+
+    uint32_t start = cur->start;
+    uint32_t end = cur->end;
+
+    // Expire ranges that ended before `cur`, their registers are free again.
+    uint32_t regs = activeRegs;
+    while (regs != 0) {
+      uint32_t regIndex = Utils::findFirstBit(regs);
+      regs ^= Utils::mask(regIndex);
+
+      if (activeRange[regIndex]->end < start)
+        activeRegs ^= Utils::mask(regIndex);
+    }
+
+    // Find free registers and how long they stay free. A register that can
+    // keep `cur` for its whole lifetime is preferred, the one `cur` needs for
+    // a fixed use first, then the one it was assigned to before (to avoid a
+    // move on the edge), otherwise the one that stays free longest, so the
+    // registers needed by fixed uses of other variables are taken last.
+    uint32_t prevIndex = lsRanges[localId] != nullptr ? lsRanges[localId]->regIndex : kInvalidReg;
+
+    uint32_t bestIndex = kInvalidReg;
+    uint32_t bestOwned = kInvalidValue;
+    uint32_t bestUntil = 0;
+
+    uint32_t splitIndex = kInvalidReg;
+    uint32_t splitUntil = start;
+
+    regs = cur->allocableRegs & ~activeRegs;
+    while (regs != 0) {
+      uint32_t regIndex = Utils::findFirstBit(regs);
+      regs ^= Utils::mask(regIndex);
+
+      uint32_t owned;
+      uint32_t until = X86Context_lsNextFixed(fixedList[regIndex], start, vd, owned);
+
+      if (until > end) {
+        if (bestIndex == kInvalidReg || owned < bestOwned || (owned == bestOwned && (
+              (regIndex == prevIndex) != (bestIndex == prevIndex) ? regIndex == prevIndex : until > bestUntil))) {
+          bestIndex = regIndex;
+          bestOwned = owned;
+          bestUntil = until;
+        }
+      }
+      else if (until > splitUntil) {
+        splitIndex = regIndex;
+        splitUntil = until;
+      }
+    }
+
+    uint32_t regIndex = bestIndex;
+    uint32_t rangeEnd = end;
+
+    if (regIndex == kInvalidReg && splitIndex == kInvalidReg) {
+      // No register is free - evict the active interval that is used again
+      // furthest from now, if it's used later than `cur`. The evicted part
+      // continues from its next use, where it competes for a register again.
+      uint32_t curUse = X86Context_lsNextUse(cur, start);
+      uint32_t victimIndex = kInvalidReg;
+      uint32_t victimUse = curUse;
+      uint32_t victimUntil = start;
+
+      regs = activeRegs & cur->allocableRegs;
+      while (regs != 0) {
+        uint32_t index = Utils::findFirstBit(regs);
+        regs ^= Utils::mask(index);
+
+        uint32_t owned;
+        uint32_t until = X86Context_lsNextFixed(fixedList[index], start, vd, owned);
+        if (until <= start)
+          continue;
+
+        uint32_t use = X86Context_lsNextUse(active[index], start);
+        if (victimIndex == kInvalidReg ? use > victimUse : use > victimUse || (use == victimUse && until > victimUntil)) {
+          victimIndex = index;
+          victimUse = use;
+          victimUntil = until;
+        }
+      }
+
+      if (victimIndex == kInvalidReg) {
+        // `cur` is used later than all active intervals - it stays in memory
+        // until its next use.
+        if (curUse != kInvalidValue && curUse > start)
+          ASMJIT_PROPAGATE_ERROR(X86Context_lsRequeue(self, heap, cur, curUse, end));
+
+        ASMJIT_TLOG("[LS] %s [%u:%u] in memory\n", vd->getName(), start, end);
+        continue;
+      }
+
+      // The rest after the end of the victim's range is already queued if the
+      // victim was split before.
+      X86LsRange* victim = activeRange[victimIndex];
+      if (victimUse <= victim->end)
+        ASMJIT_PROPAGATE_ERROR(X86Context_lsRequeue(self, heap, active[victimIndex], victimUse, victim->end));
+
+      // The victim lives in memory from now on. Its range can become empty
+      // if it starts at the same position, `start > end` never matches.
+      victim->end = start - 1;
+      activeRegs ^= Utils::mask(victimIndex);
+
+      if (victimUntil > end)
+        regIndex = victimIndex;
+      else
+        splitIndex = victimIndex, splitUntil = victimUntil;
+    }
+
+    if (regIndex == kInvalidReg) {
+      // Split - keep `cur` in the register until it's needed by a fixed use
+      // and continue with the rest of the interval later.
+      ASMJIT_PROPAGATE_ERROR(X86Context_lsRequeue(self, heap, cur, splitUntil, end));
+
+      regIndex = splitIndex;
+      rangeEnd = splitUntil - 1;
+    }
+
+    X86LsRange* range = zone.allocT<X86LsRange>();
+    if (range == nullptr)
+      return kErrorNoHeapMemory;
+
+    range->next = lsRanges[localId];
+    range->start = start;
+    range->end = rangeEnd;
+    range->regIndex = regIndex;
+    lsRanges[localId] = range;
+
+    ASMJIT_TLOG("[LS] %s [%u:%u] -> %u\n", vd->getName(), start, rangeEnd, regIndex);
+
+    active[regIndex] = cur;
+    activeRange[regIndex] = range;
+    activeRegs |= Utils::mask(regIndex);
+  }
+
+  return kErrorOk;
+}
+
+// The linear scan works on the whole function at once. Positions are flow-ids
+// renumbered in layout order; nodes get even positions and the odd position
+// after a node is where its outputs and clobbered registers are written. The
+// live interval of each variable spans from the first to the last node where
+// the variable is alive, as reported by the liveness analysis. The translator
+// then allocates each variable to the register assigned here; moves on block
+// edges are resolved by its state switching, the same way as without the
+// linear scan.
+Error X86Context::linearScan() {
+  uint32_t vdCount = static_cast<uint32_t>(_contextVd.getLength());
+  if (vdCount == 0)
+    return kErrorOk;
+
+  ASMJIT_TLOG("[LS] ======= LinearScan (Begin)\n");
+
+  HLNode* node = getFunc();
+  HLNode* stop = getStop();
+
+  uint32_t bLen = static_cast<uint32_t>(
+    ((vdCount + BitArray::kEntityBits - 1) / BitArray::kEntityBits));
+
+  // Ranges are indexed by local-id, `current` holds the last interval and
+  // `lastUse` the last use of each variable while they are being built.
+  _lsRanges = _zoneAllocator.allocT<X86LsRange*>(vdCount * sizeof(X86LsRange*));
+  X86LsInterval** current = _zoneAllocator.allocT<X86LsInterval*>(vdCount * sizeof(X86LsInterval*));
+  X86LsUse** lastUse = _zoneAllocator.allocT<X86LsUse*>(vdCount * sizeof(X86LsUse*));
+
+  if (_lsRanges == nullptr || current == nullptr || lastUse == nullptr)
+    return kErrorNoHeapMemory;
+
+  ::memset(_lsRanges, 0, vdCount * sizeof(X86LsRange*));
+  ::memset(current, 0, vdCount * sizeof(X86LsInterval*));
+  ::memset(lastUse, 0, vdCount * sizeof(X86LsUse*));
+
+  VarData** vdArray = _contextVd.getData();
+  uint32_t i;
+
+  X86LsInterval* intervals = nullptr;
+  X86LsInterval** pIntervals = &intervals;
+
+  // Fixed positions of all physical registers, indexed as `class * 32 + reg`.
+  X86LsFixed* fixedFirst[kX86RegClassCount * 32];
+  X86LsFixed* fixedLast[kX86RegClassCount * 32];
+  ::memset(fixedFirst, 0, sizeof(fixedFirst));
+
+  // --------------------------------------------------------------------------
+  // [Intervals]
+  // --------------------------------------------------------------------------
+
+  uint32_t position = 0;
+  uint32_t lastPosition = 0;
+
+  // Variables alive at the current node, see `Context::getLiveness()`.
+  BitArray* liveness = newBits(bLen);
+  if (liveness == nullptr)
+    return kErrorNoHeapMemory;
+
+  do {
+    position += 2;
+    node->setFlowId(position);
+
+    if (node->hasBlockId()) {
+      BasicBlock* block = getBlockOf(node);
+      if (block->getFirst() == node)
+        liveness->copyBits(block->getLiveIn(), bLen);
+      addUsedVars(liveness, node);
+
+      for (uint32_t w = 0; w < bLen; w++) {
+        uintptr_t bits = liveness->data[w];
+
+        for (i = w * BitArray::kEntityBits; bits != 0; i++, bits >>= 1) {
+          if ((bits & 1) == 0)
+            continue;
+
+          // Extend the interval if the variable was alive at the previous
+          // node, otherwise start a new one.
+          X86LsInterval* interval = current[i];
+          if (interval == nullptr || interval->end != lastPosition) {
+            VarData* vd = vdArray[i];
+
+            interval = _zoneAllocator.allocT<X86LsInterval>();
+            if (interval == nullptr)
+              return kErrorNoHeapMemory;
+
+            interval->next = nullptr;
+            interval->vd = vd;
+            interval->uses = nullptr;
+            interval->start = position;
+            interval->allocableRegs = _gaRegs[vd->getClass()];
+
+            current[i] = interval;
+            *pIntervals = interval;
+            pIntervals = &interval->next;
+          }
+          interval->end = position;
+        }
+      }
+
+      lastPosition = position;
+    }
+
+    X86VarMap* map = node->getMap<X86VarMap>();
+    if (map != nullptr) {
+      uint32_t vaCount = map->getVaCount();
+
+      for (i = 0; i < vaCount; i++) {
+        VarAttr* va = map->getVa(i);
+        uint32_t localId = va->getVd()->getLocalId();
+
+        X86LsInterval* interval = current[localId];
+        if (interval == nullptr)
+          continue;
+
+        X86LsUse* use = _zoneAllocator.allocT<X86LsUse>();
+        if (use == nullptr)
+          return kErrorNoHeapMemory;
+
+        use->next = nullptr;
+        use->position = position;
+
+        if (lastUse[localId] != nullptr)
+          lastUse[localId]->next = use;
+        lastUse[localId] = use;
+
+        if (interval->uses == nullptr)
+          interval->uses = use;
+
+        // Fixed uses are handled by the translator, only restrictions of the
+        // other uses (like 8-bit registers on X86) are propagated.
+        uint32_t allocableRegs = interval->allocableRegs & va->getAllocableRegs();
+        if (!va->hasInRegs() && !va->hasOutRegIndex() && allocableRegs != 0)
+          interval->allocableRegs = allocableRegs;
+      }
+
+      // Inputs are required at the node's position, outputs and clobbered
+      // registers right after it, so a variable that dies at a call can still
+      // be passed in a register the call clobbers.
+      for (uint32_t rc = 0; rc < _kX86RegClassManagedCount; rc++) {
+        VarAttr* vaList = map->getVaListByClass(rc);
+        uint32_t vaCount = map->getVaCountByClass(rc);
+
+        // A fixed output register of a read/write variable is used as input
+        // too. Function arguments are only described by their `VarAttr`s.
+        uint32_t inRegs = 0;
+        uint32_t outRegs = map->_clobberedRegs.get(rc);
+
+        for (uint32_t j = 0; j < vaCount; j++) {
+          VarAttr* va = &vaList[j];
+          inRegs |= va->getInRegs();
+
+          if (va->hasOutRegIndex()) {
+            uint32_t regMask = Utils::mask(va->getOutRegIndex());
+            if (va->hasFlag(kVarAttrRReg))
+              inRegs |= regMask;
+            outRegs |= regMask;
+          }
+        }
+
+        for (uint32_t phase = 0; phase < 2; phase++) {
+          uint32_t regs = phase == 0 ? inRegs : outRegs;
+
+          while (regs != 0) {
+            uint32_t regIndex = Utils::findFirstBit(regs);
+            regs ^= Utils::mask(regIndex);
+
+            X86LsFixed* fixed = _zoneAllocator.allocT<X86LsFixed>();
+            if (fixed == nullptr)
+              return kErrorNoHeapMemory;
+
+            fixed->next = nullptr;
+            fixed->position = position + phase;
+            fixed->vd = nullptr;
+
+            for (uint32_t j = 0; j < vaCount; j++) {
+              VarAttr* va = &vaList[j];
+
+              uint32_t vaRegs = va->hasOutRegIndex() ? Utils::mask(va->getOutRegIndex()) : 0;
+              if (phase == 0)
+                vaRegs = va->hasFlag(kVarAttrRReg) ? vaRegs | va->getInRegs() : va->getInRegs();
+
+              if ((vaRegs & Utils::mask(regIndex)) != 0) {
+                fixed->vd = va->getVd();
+                break;
+              }
+            }
+
+            uint32_t fixedIndex = rc * 32 + regIndex;
+            if (fixedFirst[fixedIndex] == nullptr)
+              fixedFirst[fixedIndex] = fixed;
+            else
+              fixedLast[fixedIndex]->next = fixed;
+            fixedLast[fixedIndex] = fixed;
+          }
+        }
+      }
+    }
+
+    if (node->hasBlockId())
+      delDeadVars(liveness, node);
+
+    node = node->getNext();
+  } while (node != stop);
+
+  // --------------------------------------------------------------------------
+  // [Scan]
+  // --------------------------------------------------------------------------
+
+  // The heap grows as needed, an interval popped from it can push back the
+  // remainder of an evicted interval and its own remainder after a split.
+  _lsHeap.reset(false);
+
+  ASMJIT_PROPAGATE_ERROR(X86Context_lsScan<kX86RegClassGp >(this, intervals, &fixedFirst[kX86RegClassGp  * 32]));
+  ASMJIT_PROPAGATE_ERROR(X86Context_lsScan<kX86RegClassMm >(this, intervals, &fixedFirst[kX86RegClassMm  * 32]));
+  ASMJIT_PROPAGATE_ERROR(X86Context_lsScan<kX86RegClassXyz>(this, intervals, &fixedFirst[kX86RegClassXyz * 32]));
+
+  ASMJIT_TLOG("[LS] ======= LinearScan (Done)\n");
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86Context - Annotate]
+// ============================================================================
+
+Error X86Context::annotate() {
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  HLFunc* func = getFunc();
+
+  HLNode* node_ = func;
+  HLNode* end = func->getEnd();
+
+  Zone& sa = _compiler->_stringAllocator;
+  StringBuilderTmp<128> sb;
+
+  uint32_t maxLen = 0;
+  while (node_ != end) {
+    if (node_->getComment() == nullptr) {
+      if (node_->getType() == HLNode::kTypeInst) {
+        HLInst* node = static_cast<HLInst*>(node_);
+        X86Context_annotateInstruction(this, sb, node->getInstId(), node->getOpList(), node->getOpCount());
+
+        node_->setComment(static_cast<char*>(sa.dup(sb.getData(), sb.getLength() + 1)));
+        maxLen = Utils::iMax<uint32_t>(maxLen, static_cast<uint32_t>(sb.getLength()));
+
+        sb.clear();
+      }
+    }
+
+    node_ = node_->getNext();
+  }
+  _annotationLength = maxLen + 1;
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86BaseAlloc]
+// ============================================================================
+
+struct X86BaseAlloc {
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_INLINE X86BaseAlloc(X86Context* context) {
+    _context = context;
+    _compiler = context->getCompiler();
+  }
+  ASMJIT_INLINE ~X86BaseAlloc() {}
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get the context.
+  ASMJIT_INLINE X86Context* getContext() const { return _context; }
+  //! Get the current state (always the same instance as X86Context::_x86State).
+  ASMJIT_INLINE X86VarState* getState() const { return _context->getState(); }
+
+  //! Get the node.
+  ASMJIT_INLINE HLNode* getNode() const { return _node; }
+
+  //! Get VarAttr list (all).
+  ASMJIT_INLINE VarAttr* getVaList() const { return _vaList[0]; }
+  //! Get VarAttr list (per class).
+  ASMJIT_INLINE VarAttr* getVaListByClass(uint32_t rc) const { return _vaList[rc]; }
+
+  //! Get VarAttr count (all).
+  ASMJIT_INLINE uint32_t getVaCount() const { return _vaCount; }
+  //! Get VarAttr count (per class).
+  ASMJIT_INLINE uint32_t getVaCountByClass(uint32_t rc) const { return _count.get(rc); }
+
+  //! Get whether all variables of class `c` are done.
+  ASMJIT_INLINE bool isVaDone(uint32_t rc) const { return _done.get(rc) == _count.get(rc); }
+
+  //! Get how many variables have been allocated.
+  ASMJIT_INLINE uint32_t getVaDone(uint32_t rc) const { return _done.get(rc); }
+  //! Add to the count of variables allocated.
+  ASMJIT_INLINE void addVaDone(uint32_t rc, uint32_t n = 1) { _done.add(rc, n); }
+
+  //! Get number of allocable registers per class.
+  ASMJIT_INLINE uint32_t getGaRegs(uint32_t rc) const {
+    return _context->_gaRegs[rc];
+  }
+
+  // --------------------------------------------------------------------------
+  // [Init / Cleanup]
+  // --------------------------------------------------------------------------
+
+protected:
+  // Just to prevent calling these methods by X86Context::translate().
+
+  ASMJIT_INLINE void init(HLNode* node, X86VarMap* map);
+  ASMJIT_INLINE void cleanup();
+
+  // --------------------------------------------------------------------------
+  // [Unuse]
+  // --------------------------------------------------------------------------
+
+  template<int C>
+  ASMJIT_INLINE void unuseBefore();
+
+  template<int C>
+  ASMJIT_INLINE void unuseAfter();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Context.
+  X86Context* _context;
+  //! Compiler.
+  X86Compiler* _compiler;
+
+  //! Node.
+  HLNode* _node;
+
+  //! Variable map.
+  X86VarMap* _map;
+  //! VarAttr list (per register class).
+  VarAttr* _vaList[_kX86RegClassManagedCount];
+
+  //! Count of all VarAttr's.
+  uint32_t _vaCount;
+
+  //! VarAttr's total counter.
+  X86RegCount _count;
+  //! VarAttr's done counter.
+  X86RegCount _done;
+};
+
+// ============================================================================
+// [asmjit::X86BaseAlloc - Init / Cleanup]
+// ============================================================================
+
+ASMJIT_INLINE void X86BaseAlloc::init(HLNode* node, X86VarMap* map) {
+  _node = node;
+  _map = map;
+
+  // We have to set the correct cursor in case any instruction is emitted
+  // during the allocation phase; it has to be emitted before the current
+  // instruction.
+  _compiler->_setCursor(node->getPrev());
+
+  // Setup the lists of variables.
+  {
+    VarAttr* va = map->getVaList();
+    _vaList[kX86RegClassGp ] = va;
+    _vaList[kX86RegClassMm ] = va + map->getVaStart(kX86RegClassMm );
+    _vaList[kX86RegClassK  ] = va + map->getVaStart(kX86RegClassK  );
+    _vaList[kX86RegClassXyz] = va + map->getVaStart(kX86RegClassXyz);
+  }
+
+  // Setup counters.
+  _vaCount = map->getVaCount();
+
+  _count = map->_count;
+  _done.reset();
+
+  // Connect Vd->Va.
+  for (uint32_t i = 0; i < _vaCount; i++) {
+    VarAttr* va = &_vaList[0][i];
+    VarData* vd = va->getVd();
+
+    vd->setVa(va);
+  }
+}
+
+ASMJIT_INLINE void X86BaseAlloc::cleanup() {
+  // Disconnect Vd->Va.
+  for (uint32_t i = 0; i < _vaCount; i++) {
+    VarAttr* va = &_vaList[0][i];
+    VarData* vd = va->getVd();
+
+    vd->setVa(nullptr);
+  }
+}
+
+// ============================================================================
+// [asmjit::X86BaseAlloc - Unuse]
+// ============================================================================
+
+template<int C>
+ASMJIT_INLINE void X86BaseAlloc::unuseBefore() {
+  VarAttr* list = getVaListByClass(C);
+  uint32_t count = getVaCountByClass(C);
+
+  const uint32_t checkFlags =
+    kVarAttrXReg  |
+    kVarAttrRMem  |
+    kVarAttrRFunc |
+    kVarAttrRCall |
+    kVarAttrRConv ;
+
+  for (uint32_t i = 0; i < count; i++) {
+    VarAttr* va = &list[i];
+
+    if ((va->getFlags() & checkFlags) == kVarAttrWReg) {
+      _context->unuse<C>(va->getVd());
+    }
+  }
+}
+
+template<int C>
+ASMJIT_INLINE void X86BaseAlloc::unuseAfter() {
+  VarAttr* list = getVaListByClass(C);
+  uint32_t count = getVaCountByClass(C);
+
+  for (uint32_t i = 0; i < count; i++) {
+    VarAttr* va = &list[i];
+
+    if (va->getFlags() & kVarAttrUnuse)
+      _context->unuse<C>(va->getVd());
+  }
+}
+
+// ============================================================================
+// [asmjit::X86VarAlloc]
+// ============================================================================
+
+//! \internal
+//!
+//! Register allocator context (asm instructions).
+struct X86VarAlloc : public X86BaseAlloc {
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_INLINE X86VarAlloc(X86Context* context) : X86BaseAlloc(context) {}
+  ASMJIT_INLINE ~X86VarAlloc() {}
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_INLINE Error run(HLNode* node);
+
+  // --------------------------------------------------------------------------
+  // [Init / Cleanup]
+  // --------------------------------------------------------------------------
+
+protected:
+  // Just to prevent calling these methods by X86Context::translate().
+
+  ASMJIT_INLINE void init(HLNode* node, X86VarMap* map);
+  ASMJIT_INLINE void cleanup();
+
+  // --------------------------------------------------------------------------
+  // [Plan / Spill / Alloc]
+  // --------------------------------------------------------------------------
+
+  template<int C>
+  ASMJIT_INLINE void plan();
+
+  template<int C>
+  ASMJIT_INLINE void spill();
+
+  template<int C>
+  ASMJIT_INLINE void alloc();
+
+  // --------------------------------------------------------------------------
+  // [GuessAlloc / GuessSpill]
+  // --------------------------------------------------------------------------
+
+  //! Guess which register is the best candidate for 'vd' from
+  //! 'allocableRegs'.
+  //!
+  //! The guess is based on looking ahead and inspecting register allocator
+  //! instructions. The main reason is to prevent allocation to a register
+  //! which is needed by next instruction(s). The guess look tries to go as far
+  //! as possible, after the remaining registers are zero, the mask of previous
+  //! registers (called 'safeRegs') is returned.
+  template<int C>
+  ASMJIT_INLINE uint32_t guessAlloc(VarData* vd, uint32_t allocableRegs);
+
+  //! Guess whether to move the given 'vd' instead of spill.
+  template<int C>
+  ASMJIT_INLINE uint32_t guessSpill(VarData* vd, uint32_t allocableRegs);
+
+  // --------------------------------------------------------------------------
+  // [Modified]
+  // --------------------------------------------------------------------------
+
+  template<int C>
+  ASMJIT_INLINE void modified();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Will alloc to these registers.
+  X86RegMask _willAlloc;
+  //! Will spill these registers.
+  X86RegMask _willSpill;
+};
+
+// ============================================================================
+// [asmjit::X86VarAlloc - Run]
+// ============================================================================
 
-                      if (extendedInfo.isWO()) {
-                        // Move to memory - setting the right flags is important
-                        // as if it's just move to the register. It's just a bit
-                        // simpler as there are no special cases.
-                        uint32_t movSize = Utils::iMax<uint32_t>(extendedInfo.getWriteSize(), m->getSize());
-                        uint32_t varSize = vd->getSize();
+ASMJIT_INLINE Error X86VarAlloc::run(HLNode* node_) {
+  // Initialize.
+  X86VarMap* map = node_->getMap<X86VarMap>();
+  if (map == nullptr)
+    return kErrorOk;
 
-                        if (movSize >= varSize)
-                          combinedFlags = outFlags;
-                      }
-                      else if (extendedInfo.isRO()) {
-                        // Comparison/Test instructions don't modify any operand.
-                        combinedFlags = inFlags;
-                      }
-                    }
-                    else {
-                      // Default for the second operand.
-                      combinedFlags = inFlags;
+  // Initialize the allocator; connect Vd->Va.
+  init(node_, map);
 
-                      // Handle Xchg instruction (modifies both operands).
-                      if (extendedInfo.isXchg())
-                        combinedFlags = inFlags | outFlags;
-                    }
+  // Unuse overwritten variables.
+  unuseBefore<kX86RegClassGp>();
+  unuseBefore<kX86RegClassMm>();
+  unuseBefore<kX86RegClassXyz>();
 
-                    va->orFlags(combinedFlags);
-                  }
-                }
-              }
+  // Plan the allocation. Planner assigns input/output registers for each
+  // variable and decides whether to allocate it in register or stack.
+  plan<kX86RegClassGp>();
+  plan<kX86RegClassMm>();
+  plan<kX86RegClassXyz>();
 
-              if (OperandUtil::isVarId(m->getIndex())) {
-                // Restrict allocation to all registers except ESP/RSP/R12.
-                vd = compiler->getVdById(m->getIndex());
-                VI_MERGE_VAR(vd, va, 0, gaRegs[kX86RegClassGp] & gpAllowedMask);
-                va->andAllocableRegs(indexMask);
-                va->orFlags(kVarAttrRReg);
-              }
-            }
-          }
+  // Spill all variables marked by plan().
+  spill<kX86RegClassGp>();
+  spill<kX86RegClassMm>();
+  spill<kX86RegClassXyz>();
 
-          node->setFlags(flags);
-          if (vaCount) {
-            // Handle instructions which result in zeros/ones or nop if used with the
-            // same destination and source operand.
-            if (vaCount == 1 && opCount >= 2 && opList[0].isVar() && opList[1].isVar() && !node->hasMemOp())
-              X86Context_prepareSingleVarInst(instId, &vaTmpList[0]);
-          }
+  // Alloc all variables marked by plan().
+  alloc<kX86RegClassGp>();
+  alloc<kX86RegClassMm>();
+  alloc<kX86RegClassXyz>();
 
-          VI_END(node_);
-        }
+  // Translate node operands.
+  if (node_->getType() == HLNode::kTypeInst) {
+    HLInst* node = static_cast<HLInst*>(node_);
+    ASMJIT_PROPAGATE_ERROR(X86Context_translateOperands(_context, node->getOpList(), node->getOpCount()));
+  }
+  else if (node_->getType() == HLNode::kTypeCallArg) {
+    HLCallArg* node = static_cast<HLCallArg*>(node_);
 
-        // Handle conditional/unconditional jump.
-        if (node->isJmpOrJcc()) {
-          HLJump* jNode = static_cast<HLJump*>(node);
-          HLLabel* jTarget = jNode->getTarget();
+    X86CallNode* call = static_cast<X86CallNode*>(node->getCall());
+    X86FuncDecl* decl = call->getDecl();
 
-          // If this jump is unconditional we put next node to unreachable node
-          // list so we can eliminate possible dead code. We have to do this in
-          // all cases since we are unable to translate without fetch() step.
-          //
-          // We also advance our node pointer to the target node to simulate
-          // natural flow of the function.
-          if (jNode->isJmp()) {
-            if (!next->isFetched())
-              ASMJIT_PROPAGATE_ERROR(addUnreachableNode(next));
+    uint32_t argIndex = 0;
+    uint32_t argMask = node->_args;
 
-            // Jump not followed.
-            if (jTarget == nullptr) {
-              ASMJIT_PROPAGATE_ERROR(addReturningNode(jNode));
-              goto _NextGroup;
-            }
+    VarData* sVd = node->getSVd();
+    VarData* cVd = node->getCVd();
 
-            node_ = jTarget;
-            goto _Do;
-          }
-          else {
-            // Jump not followed.
-            if (jTarget == nullptr)
-              break;
+    // Convert first.
+    ASMJIT_ASSERT(sVd->getRegIndex() != kInvalidReg);
 
-            if (jTarget->isFetched()) {
-              uint32_t jTargetFlowId = jTarget->getFlowId();
+    if (cVd != nullptr) {
+      ASMJIT_ASSERT(cVd->getRegIndex() != kInvalidReg);
+      _context->emitConvertVarToVar(
+        cVd->getType(), cVd->getRegIndex(),
+        sVd->getType(), sVd->getRegIndex());
+      sVd = cVd;
+    }
 
-              // Update HLNode::kFlagIsTaken flag to true if this is a
-              // conditional backward jump. This behavior can be overridden
-              // by using `kInstOptionTaken` when the instruction is created.
-              if (!jNode->isTaken() && opCount == 1 && jTargetFlowId <= flowId) {
-                jNode->orFlags(HLNode::kFlagIsTaken);
-              }
-            }
-            else if (next->isFetched()) {
-              node_ = jTarget;
-              goto _Do;
-            }
-            else {
-              ASMJIT_PROPAGATE_ERROR(addJccNode(jNode));
-              node_ = X86Context_getJccFlow(jNode);
-              goto _Do;
-            }
-          }
-        }
-        break;
+    while (argMask != 0) {
+      if (argMask & 0x1) {
+        FuncInOut& arg = decl->getArg(argIndex);
+        ASMJIT_ASSERT(arg.hasStackOffset());
+
+        X86Mem dst = x86::ptr(_context->_zsp, -static_cast<int>(_context->getRegSize()) + arg.getStackOffset());
+        _context->emitMoveVarOnStack(arg.getVarType(), &dst, sVd->getType(), sVd->getRegIndex());
       }
 
-      // ----------------------------------------------------------------------
-      // [Func]
-      // ----------------------------------------------------------------------
+      argIndex++;
+      argMask >>= 1;
+    }
+  }
 
-      case HLNode::kTypeFunc: {
-        ASMJIT_ASSERT(node_ == func);
-        X86FuncDecl* decl = func->getDecl();
+  // Mark variables as modified.
+  modified<kX86RegClassGp>();
+  modified<kX86RegClassMm>();
+  modified<kX86RegClassXyz>();
 
-        VI_BEGIN();
-        for (uint32_t i = 0, argCount = decl->getNumArgs(); i < argCount; i++) {
-          const FuncInOut& arg = decl->getArg(i);
+  // Cleanup; disconnect Vd->Va.
+  cleanup();
 
-          VarData* vd = func->getArg(i);
-          VarAttr* va;
+  // Update clobbered mask.
+  _context->_clobberedRegs.or_(_willAlloc);
+  _context->_clobberedRegs.or_(map->_clobberedRegs);
 
-          if (vd == nullptr)
-            continue;
+  // Unuse.
+  unuseAfter<kX86RegClassGp>();
+  unuseAfter<kX86RegClassMm>();
+  unuseAfter<kX86RegClassXyz>();
+
+  return kErrorOk;
+}
+
+// ============================================================================
+// [asmjit::X86VarAlloc - Init / Cleanup]
+// ============================================================================
+
+ASMJIT_INLINE void X86VarAlloc::init(HLNode* node, X86VarMap* map) {
+  X86BaseAlloc::init(node, map);
+
+  // These will block planner from assigning them during planning. Planner will
+  // add more registers when assigning registers to variables that don't need
+  // any specific register.
+  _willAlloc = map->_inRegs;
+  _willAlloc.or_(map->_outRegs);
+  _willSpill.reset();
+}
+
+ASMJIT_INLINE void X86VarAlloc::cleanup() {
+  X86BaseAlloc::cleanup();
+}
+
+// ============================================================================
+// [asmjit::X86VarAlloc - Plan / Spill / Alloc]
+// ============================================================================
+
+//! \internal
+//!
+//! Get the depth of the innermost loop around `node` that uses `vd`, which is
+//! where `vd` would be reloaded if it's spilled at `node`, or zero if no loop
+//! around `node` uses it.
+static ASMJIT_INLINE uint32_t X86Context_getReloadDepth(X86Context* self, HLNode* node, VarData* vd) {
+  BasicBlock* block = self->getBlockOf(node);
+  if (block == nullptr)
+    return 0;
+
+  uint32_t localId = vd->getLocalId();
+  for (BasicBlock* loop = block->getLoop(); loop != nullptr; loop = loop->getParentLoop()) {
+    if (loop->getLoopVars()->getBit(localId))
+      return loop->getLoopDepth();
+  }
+
+  return 0;
+}
+
+template<int C>
+ASMJIT_INLINE void X86VarAlloc::plan() {
+  if (isVaDone(C))
+    return;
+
+  uint32_t i;
+  uint32_t willAlloc = _willAlloc.get(C);
+  uint32_t willFree = 0;
+
+  VarAttr* list = getVaListByClass(C);
+  uint32_t count = getVaCountByClass(C);
+  X86VarState* state = getState();
+
+  // Calculate 'willAlloc' and 'willFree' masks based on mandatory masks.
+  for (i = 0; i < count; i++) {
+    VarAttr* va = &list[i];
+    VarData* vd = va->getVd();
+
+    uint32_t vaFlags = va->getFlags();
+    uint32_t regIndex = vd->getRegIndex();
+    uint32_t regMask = (regIndex != kInvalidReg) ? Utils::mask(regIndex) : 0;
+
+    if ((vaFlags & kVarAttrXReg) != 0) {
+      // Planning register allocation. First check whether the variable is
+      // already allocated in register and if it can stay allocated there.
+      //
+      // The following conditions may happen:
+      //
+      // a) Allocated register is one of the mandatoryRegs.
+      // b) Allocated register is one of the allocableRegs.
+      uint32_t mandatoryRegs = va->getInRegs();
+      uint32_t allocableRegs = va->getAllocableRegs();
+
+      ASMJIT_TLOG("[RA-PLAN] %s (%s)\n",
+        vd->getName(),
+        (vaFlags & kVarAttrXReg) == kVarAttrWReg ? "R-Reg" : "X-Reg");
+
+      ASMJIT_TLOG("[RA-PLAN] RegMask=%08X Mandatory=%08X Allocable=%08X\n",
+        regMask, mandatoryRegs, allocableRegs);
 
-          // Overlapped function arguments.
-          if (vd->getVa() != nullptr)
-            return compiler->setLastError(kErrorOverlappedArgs);
-          VI_ADD_VAR(vd, va, 0, 0);
+      if (regMask != 0) {
+        // Special path for planning output-only registers.
+        if ((vaFlags & kVarAttrXReg) == kVarAttrWReg) {
+          uint32_t outRegIndex = va->getOutRegIndex();
+          mandatoryRegs = (outRegIndex != kInvalidReg) ? Utils::mask(outRegIndex) : 0;
 
-          uint32_t aType = arg.getVarType();
-          uint32_t vType = vd->getType();
+          if ((mandatoryRegs | allocableRegs) & regMask) {
+            va->setOutRegIndex(regIndex);
+            va->orFlags(kVarAttrAllocWDone);
 
-          if (arg.hasRegIndex()) {
-            if (x86VarTypeToClass(aType) == vd->getClass()) {
-              va->orFlags(kVarAttrWReg);
-              va->setOutRegIndex(arg.getRegIndex());
+            if (mandatoryRegs & regMask) {
+              // Case 'a' - 'willAlloc' contains initially all inRegs from all VarAttr's.
+              ASMJIT_ASSERT((willAlloc & regMask) != 0);
             }
             else {
-              va->orFlags(kVarAttrWConv);
+              // Case 'b'.
+              va->setOutRegIndex(regIndex);
+              willAlloc |= regMask;
             }
+
+            ASMJIT_TLOG("[RA-PLAN] WillAlloc\n");
+            addVaDone(C);
+
+            continue;
           }
-          else {
-            if ((x86VarTypeToClass(aType) == vd->getClass()) ||
-                (vType == kX86VarTypeXmmSs && aType == kVarTypeFp32) ||
-                (vType == kX86VarTypeXmmSd && aType == kVarTypeFp64)) {
-              va->orFlags(kVarAttrWMem);
+        }
+        else {
+          if ((mandatoryRegs | allocableRegs) & regMask) {
+            va->setInRegIndex(regIndex);
+            va->orFlags(kVarAttrAllocRDone);
+
+            if (mandatoryRegs & regMask) {
+              // Case 'a' - 'willAlloc' contains initially all inRegs from all VarAttr's.
+              ASMJIT_ASSERT((willAlloc & regMask) != 0);
             }
             else {
-              // TODO: [COMPILER] Not implemented.
-              ASMJIT_ASSERT(!"Implemented");
+              // Case 'b'.
+              va->addInRegs(regMask);
+              willAlloc |= regMask;
             }
+
+            ASMJIT_TLOG("[RA-PLAN] WillAlloc\n");
+            addVaDone(C);
+
+            continue;
           }
         }
-        VI_END(node_);
-        break;
-      }
-
-      // ----------------------------------------------------------------------
-      // [End]
-      // ----------------------------------------------------------------------
 
-      case HLNode::kTypeSentinel: {
-        ASMJIT_PROPAGATE_ERROR(addReturningNode(node_));
-        goto _NextGroup;
+        // Trace it here so we don't pollute log by `WillFree` of zero regMask.
+        ASMJIT_TLOG("[RA-PLAN] WillFree\n");
       }
 
-      // ----------------------------------------------------------------------
-      // [Ret]
-      // ----------------------------------------------------------------------
+      // Variable is not allocated or allocated in register that doesn't
+      // match inRegs or allocableRegs. The next step is to pick the best
+      // register for this variable. If `inRegs` contains any register the
+      // decision is simple - we have to follow, in other case will use
+      // the advantage of `guessAlloc()` to find a register (or registers)
+      // by looking ahead. But the best way to find a good register is not
+      // here since now we have no information about the registers that
+      // will be freed. So instead of finding register here, we just mark
+      // the current register (if variable is allocated) as `willFree` so
+      // the planner can use this information in the second step to plan the
+      // allocation as a whole.
+      willFree |= regMask;
+      continue;
+    }
+    else {
+      // Memory access - if variable is allocated it has to be freed.
+      ASMJIT_TLOG("[RA-PLAN] %s (Memory)\n", vd->getName());
 
-      case HLNode::kTypeRet: {
-        HLRet* node = static_cast<HLRet*>(node_);
-        ASMJIT_PROPAGATE_ERROR(addReturningNode(node));
+      if (regMask != 0) {
+        ASMJIT_TLOG("[RA-PLAN] WillFree\n");
+        willFree |= regMask;
+        continue;
+      }
+      else {
+        ASMJIT_TLOG("[RA-PLAN] Done\n");
+        va->orFlags(kVarAttrAllocRDone);
+        addVaDone(C);
+        continue;
+      }
+    }
+  }
 
-        X86FuncDecl* decl = func->getDecl();
-        if (decl->hasRet()) {
-          const FuncInOut& ret = decl->getRet(0);
-          uint32_t retClass = x86VarTypeToClass(ret.getVarType());
+  // Occupied registers without 'willFree' registers; contains basically
+  // all the registers we can use to allocate variables without inRegs
+  // speficied.
+  uint32_t occupied = state->_occupied.get(C) & ~willFree;
+  uint32_t willSpill = 0;
 
-          VI_BEGIN();
-          for (uint32_t i = 0; i < 2; i++) {
-            Operand* op = &node->_ret[i];
+  // Find the best registers for variables that are not allocated yet.
+  for (i = 0; i < count; i++) {
+    VarAttr* va = &list[i];
+    VarData* vd = va->getVd();
 
-            if (op->isVar()) {
-              VarData* vd = compiler->getVdById(op->getId());
-              VarAttr* va;
+    uint32_t vaFlags = va->getFlags();
 
-              VI_MERGE_VAR(vd, va, 0, 0);
+    if ((vaFlags & kVarAttrXReg) != 0) {
+      if ((vaFlags & kVarAttrXReg) == kVarAttrWReg) {
+        if (vaFlags & kVarAttrAllocWDone)
+          continue;
 
-              if (retClass == vd->getClass()) {
-                // TODO: [COMPILER] Fix HLRet fetch.
-                va->orFlags(kVarAttrRReg);
-                va->setInRegs(i == 0 ? Utils::mask(kX86RegIndexAx) : Utils::mask(kX86RegIndexDx));
-                inRegs.or_(retClass, va->getInRegs());
-              }
-              else if (retClass == kX86RegClassFp) {
-                uint32_t fldFlag = ret.getVarType() == kVarTypeFp32 ? kVarAttrX86Fld4 : kVarAttrX86Fld8;
-                va->orFlags(kVarAttrRMem | fldFlag);
-              }
-              else {
-                // TODO: Fix possible other return type conversions.
-                ASMJIT_NOT_REACHED();
-              }
-            }
-          }
-          VI_END(node_);
+        // Skip all registers that have assigned outRegIndex. Spill if occupied.
+        if (va->hasOutRegIndex()) {
+          uint32_t outRegs = Utils::mask(va->getOutRegIndex());
+          willSpill |= occupied & outRegs;
+          continue;
         }
+      }
+      else {
+        if (vaFlags & kVarAttrAllocRDone)
+          continue;
 
-        if (!next->isFetched())
-          ASMJIT_PROPAGATE_ERROR(addUnreachableNode(next));
-        goto _NextGroup;
+        // We skip all registers that have assigned inRegIndex, indicates that
+        // the register to allocate in is known.
+        if (va->hasInRegIndex()) {
+          uint32_t inRegs = va->getInRegs();
+          willSpill |= occupied & inRegs;
+          continue;
+        }
       }
 
-      // ----------------------------------------------------------------------
-      // [Call]
-      // ----------------------------------------------------------------------
+      uint32_t m = va->getInRegs();
+      if (va->hasOutRegIndex())
+        m |= Utils::mask(va->getOutRegIndex());
 
-      case HLNode::kTypeCall: {
-        X86CallNode* node = static_cast<X86CallNode*>(node_);
-        X86FuncDecl* decl = node->getDecl();
+      m = va->getAllocableRegs() & ~(willAlloc ^ m);
+      m = guessAlloc<C>(vd, m);
+      ASMJIT_ASSERT(m != 0);
 
-        Operand* target = &node->_target;
-        Operand* args = node->_args;
-        Operand* rets = node->_ret;
+      uint32_t candidateRegs = m & ~occupied;
+      uint32_t homeMask = vd->getHomeMask();
 
-        func->addFuncFlags(kFuncFlagIsCaller);
-        func->mergeCallStackSize(node->_x86Decl.getArgStackSize());
-        node->_usedArgs = X86Context_getUsedArgs(this, node, decl);
+      uint32_t regIndex;
+      uint32_t regMask;
 
-        uint32_t i;
-        uint32_t argCount = decl->getNumArgs();
-        uint32_t sArgCount = 0;
-        uint32_t gpAllocableMask = gaRegs[kX86RegClassGp] & ~node->_usedArgs.get(kX86RegClassGp);
+      // All registers are occupied, evict the variable that is the cheapest
+      // to spill. A reload inside of a loop costs more than a store, so the
+      // depth of the loop where the variable would be reloaded comes first.
+      if (candidateRegs == 0) {
+        VarData** sVars = state->getListByClass(C);
+        uint32_t modifiedRegs = state->_modified.get(C);
+        uint32_t bestCost = 0xFFFFFFFF;
+        uint32_t regs = m;
 
-        VarData* vd;
-        VarAttr* va;
+        while (regs != 0) {
+          uint32_t otherIndex = Utils::findFirstBit(regs);
+          uint32_t otherMask = Utils::mask(otherIndex);
+          regs ^= otherMask;
 
-        VI_BEGIN();
+          VarData* otherVd = sVars[otherIndex];
+          uint32_t cost = (modifiedRegs & otherMask) != 0;
 
-        // Function-call operand.
-        if (target->isVar()) {
-          vd = compiler->getVdById(target->getId());
-          VI_MERGE_VAR(vd, va, 0, 0);
+          if (otherVd != nullptr)
+            cost += X86Context_getReloadDepth(_context, _node, otherVd) * 2;
 
-          va->orFlags(kVarAttrRReg | kVarAttrRCall);
-          if (va->getInRegs() == 0)
-            va->addAllocableRegs(gpAllocableMask);
+          if (cost < bestCost) {
+            bestCost = cost;
+            candidateRegs = otherMask;
+          }
+          else if (cost == bestCost) {
+            candidateRegs |= otherMask;
+          }
         }
-        else if (target->isMem()) {
-          X86Mem* m = static_cast<X86Mem*>(target);
+      }
 
-          if (OperandUtil::isVarId(m->getBase()) && m->isBaseIndexType()) {
-            vd = compiler->getVdById(m->getBase());
-            if (!vd->isStack()) {
-              VI_MERGE_VAR(vd, va, 0, 0);
-              if (m->getMemType() == kMemTypeBaseIndex) {
-                va->orFlags(kVarAttrRReg | kVarAttrRCall);
-                if (va->getInRegs() == 0)
-                  va->addAllocableRegs(gpAllocableMask);
-              }
-              else {
-                va->orFlags(kVarAttrRMem | kVarAttrRCall);
-              }
-            }
-          }
+      // printf("CANDIDATE: %s %08X\n", vd->getName(), homeMask);
+      if (candidateRegs & homeMask)
+        candidateRegs &= homeMask;
 
-          if (OperandUtil::isVarId(m->getIndex())) {
-            // Restrict allocation to all registers except ESP/RSP/R12.
-            vd = compiler->getVdById(m->getIndex());
-            VI_MERGE_VAR(vd, va, 0, 0);
+      regIndex = Utils::findFirstBit(candidateRegs);
+      regMask = Utils::mask(regIndex);
+
+      if ((vaFlags & kVarAttrXReg) == kVarAttrWReg) {
+        va->setOutRegIndex(regIndex);
+      }
+      else {
+        va->setInRegIndex(regIndex);
+        va->setInRegs(regMask);
+      }
+
+      willAlloc |= regMask;
+      willSpill |= regMask & occupied;
+      willFree  &=~regMask;
+      occupied  |= regMask;
+
+      continue;
+    }
+    else if ((vaFlags & kVarAttrXMem) != 0) {
+      uint32_t regIndex = vd->getRegIndex();
+      if (regIndex != kInvalidReg && (vaFlags & kVarAttrXMem) != kVarAttrWMem) {
+        willSpill |= Utils::mask(regIndex);
+      }
+    }
+  }
+
+  // Set calculated masks back to the allocator; needed by spill() and alloc().
+  _willSpill.set(C, willSpill);
+  _willAlloc.set(C, willAlloc);
+}
 
-            va->orFlags(kVarAttrRReg | kVarAttrRCall);
-            if ((va->getInRegs() & ~indexMask) == 0)
-              va->andAllocableRegs(gpAllocableMask & indexMask);
-          }
-        }
+template<int C>
+ASMJIT_INLINE void X86VarAlloc::spill() {
+  uint32_t m = _willSpill.get(C);
+  uint32_t i = static_cast<uint32_t>(0) - 1;
 
-        // Function-call arguments.
-        for (i = 0; i < argCount; i++) {
-          Operand* op = &args[i];
-          if (!op->isVar())
-            continue;
+  if (m == 0)
+    return;
 
-          vd = compiler->getVdById(op->getId());
-          const FuncInOut& arg = decl->getArg(i);
+  X86VarState* state = getState();
+  VarData** sVars = state->getListByClass(C);
 
-          if (arg.hasRegIndex()) {
-            VI_MERGE_VAR(vd, va, 0, 0);
+  // Available registers for decision if move has any benefit over spill.
+  uint32_t availableRegs = getGaRegs(C) & ~(state->_occupied.get(C) | m | _willAlloc.get(C));
 
-            uint32_t argType = arg.getVarType();
-            uint32_t argClass = x86VarTypeToClass(argType);
+  do {
+    // We always advance one more to destroy the bit that we have found.
+    uint32_t bitIndex = Utils::findFirstBit(m) + 1;
 
-            if (vd->getClass() == argClass) {
-              va->addInRegs(Utils::mask(arg.getRegIndex()));
-              va->orFlags(kVarAttrRReg | kVarAttrRFunc);
-            }
-            else {
-              va->orFlags(kVarAttrRConv | kVarAttrRFunc);
-            }
-          }
-          // If this is a stack-based argument we insert HLCallArg instead of
-          // using VarAttr. It improves the code, because the argument can be
-          // moved onto stack as soon as it is ready and the register used by
-          // the variable can be reused for something else. It is also much
-          // easier to handle argument conversions, because there will be at
-          // most only one node per conversion.
-          else {
-            if (X86Context_insertHLCallArg(this, node, vd, gaRegs, arg, i, sArgList, sArgCount) != kErrorOk)
-              goto _NoMemory;
-          }
-        }
+    i += bitIndex;
+    m >>= bitIndex;
 
-        // Function-call return(s).
-        for (i = 0; i < 2; i++) {
-          Operand* op = &rets[i];
-          if (!op->isVar())
-            continue;
+    VarData* vd = sVars[i];
+    ASMJIT_ASSERT(vd != nullptr);
 
-          const FuncInOut& ret = decl->getRet(i);
-          if (ret.hasRegIndex()) {
-            uint32_t retType = ret.getVarType();
-            uint32_t retClass = x86VarTypeToClass(retType);
+    VarAttr* va = vd->getVa();
+    ASMJIT_ASSERT(va == nullptr || !va->hasFlag(kVarAttrXReg));
 
-            vd = compiler->getVdById(op->getId());
-            VI_MERGE_VAR(vd, va, 0, 0);
+    if (vd->isModified() && availableRegs) {
+      // Don't check for alternatives if the variable has to be spilled.
+      if (va == nullptr || !va->hasFlag(kVarAttrSpill)) {
+        uint32_t altRegs = guessSpill<C>(vd, availableRegs);
 
-            if (vd->getClass() == retClass) {
-              va->setOutRegIndex(ret.getRegIndex());
-              va->orFlags(kVarAttrWReg | kVarAttrWFunc);
-            }
-            else {
-              va->orFlags(kVarAttrWConv | kVarAttrWFunc);
-            }
-          }
+        if (altRegs != 0) {
+          uint32_t regIndex = Utils::findFirstBit(altRegs);
+          uint32_t regMask = Utils::mask(regIndex);
+
+          _context->move<C>(vd, regIndex);
+          availableRegs ^= regMask;
+          continue;
         }
+      }
+    }
 
-        // Init clobbered.
-        clobberedRegs.set(kX86RegClassGp , Utils::bits(_regCount.getGp())  & (~decl->getPreserved(kX86RegClassGp )));
-        clobberedRegs.set(kX86RegClassMm , Utils::bits(_regCount.getMm())  & (~decl->getPreserved(kX86RegClassMm )));
-        clobberedRegs.set(kX86RegClassK  , Utils::bits(_regCount.getK())   & (~decl->getPreserved(kX86RegClassK  )));
-        clobberedRegs.set(kX86RegClassXyz, Utils::bits(_regCount.getXyz()) & (~decl->getPreserved(kX86RegClassXyz)));
+    _context->spill<C>(vd);
+  } while (m != 0);
+}
 
-        VI_END(node_);
-        break;
-      }
+template<int C>
+ASMJIT_INLINE void X86VarAlloc::alloc() {
+  if (isVaDone(C))
+    return;
 
-      default:
-        break;
-    }
+  uint32_t i;
+  bool didWork;
 
-    node_ = next;
-  } while (node_ != stop);
+  VarAttr* list = getVaListByClass(C);
+  uint32_t count = getVaCountByClass(C);
 
-_Done:
-  // Mark exit label and end node as fetched, otherwise they can be removed by
-  // `removeUnreachableCode()`, which would lead to crash in some later step.
-  node_ = func->getEnd();
-  if (!node_->isFetched()) {
-    func->getExitNode()->setFlowId(++flowId);
-    node_->setFlowId(++flowId);
-  }
+  // Alloc 'in' regs.
+  do {
+    didWork = false;
+    for (i = 0; i < count; i++) {
+      VarAttr* aVa = &list[i];
+      VarData* aVd = aVa->getVd();
 
-  ASMJIT_TLOG("[F] ======= Fetch (Done)\n");
-  return kErrorOk;
+      if ((aVa->getFlags() & (kVarAttrRReg | kVarAttrAllocRDone)) != kVarAttrRReg)
+        continue;
 
-  // --------------------------------------------------------------------------
-  // [Failure]
-  // --------------------------------------------------------------------------
+      uint32_t aIndex = aVd->getRegIndex();
+      uint32_t bIndex = aVa->getInRegIndex();
 
-_NoMemory:
-  ASMJIT_TLOG("[F] ======= Fetch (Out of Memory)\n");
-  return compiler->setLastError(kErrorNoHeapMemory);
-}
+      // Shouldn't be the same.
+      ASMJIT_ASSERT(aIndex != bIndex);
 
-// ============================================================================
-// [asmjit::X86Context - Annotate]
-// ============================================================================
+      VarData* bVd = getState()->getListByClass(C)[bIndex];
+      if (bVd != nullptr) {
+        // Gp registers only - Swap two registers if we can solve two
+        // allocation tasks by a single 'xchg' instruction, swapping
+        // two registers required by the instruction/node or one register
+        // required with another non-required.
+        if (C == kX86RegClassGp && aIndex != kInvalidReg) {
+          VarAttr* bVa = bVd->getVa();
+          _context->swapGp(aVd, bVd);
 
-Error X86Context::annotate() {
-#if !defined(ASMJIT_DISABLE_LOGGER)
-  HLFunc* func = getFunc();
+          aVa->orFlags(kVarAttrAllocRDone);
+          addVaDone(C);
 
-  HLNode* node_ = func;
-  HLNode* end = func->getEnd();
+          // Doublehit, two registers allocated by a single swap.
+          if (bVa != nullptr && bVa->getInRegIndex() == aIndex) {
+            bVa->orFlags(kVarAttrAllocRDone);
+            addVaDone(C);
+          }
 
-  Zone& sa = _compiler->_stringAllocator;
-  StringBuilderTmp<128> sb;
+          didWork = true;
+          continue;
+        }
+      }
+      else if (aIndex != kInvalidReg) {
+        _context->move<C>(aVd, bIndex);
 
-  uint32_t maxLen = 0;
-  while (node_ != end) {
-    if (node_->getComment() == nullptr) {
-      if (node_->getType() == HLNode::kTypeInst) {
-        HLInst* node = static_cast<HLInst*>(node_);
-        X86Context_annotateInstruction(this, sb, node->getInstId(), node->getOpList(), node->getOpCount());
+        aVa->orFlags(kVarAttrAllocRDone);
+        addVaDone(C);
 
-        node_->setComment(static_cast<char*>(sa.dup(sb.getData(), sb.getLength() + 1)));
-        maxLen = Utils::iMax<uint32_t>(maxLen, static_cast<uint32_t>(sb.getLength()));
+        didWork = true;
+        continue;
+      }
+      else {
+        _context->alloc<C>(aVd, bIndex);
 
-        sb.clear();
+        aVa->orFlags(kVarAttrAllocRDone);
+        addVaDone(C);
+
+        didWork = true;
+        continue;
       }
     }
+  } while (didWork);
 
-    node_ = node_->getNext();
-  }
-  _annotationLength = maxLen + 1;
-#endif // !ASMJIT_DISABLE_LOGGER
+  // Alloc 'out' regs.
+  for (i = 0; i < count; i++) {
+    VarAttr* va = &list[i];
+    VarData* vd = va->getVd();
 
-  return kErrorOk;
+    if ((va->getFlags() & (kVarAttrXReg | kVarAttrAllocWDone)) != kVarAttrWReg)
+      continue;
+
+    uint32_t regIndex = va->getOutRegIndex();
+    ASMJIT_ASSERT(regIndex != kInvalidReg);
+
+    if (vd->getRegIndex() != regIndex) {
+      ASMJIT_ASSERT(getState()->getListByClass(C)[regIndex] == nullptr);
+      _context->attach<C>(vd, regIndex, false);
+    }
+
+    va->orFlags(kVarAttrAllocWDone);
+    addVaDone(C);
+  }
 }
 
 // ============================================================================
-// [asmjit::X86BaseAlloc]
+// [asmjit::X86VarAlloc - GuessAlloc / GuessSpill]
 // ============================================================================
 
-struct X86BaseAlloc {
-  // --------------------------------------------------------------------------
-  // [Construction / Destruction]
-  // --------------------------------------------------------------------------
+//! \internal
+//!
+//! Maximum number of code-flow paths remembered by `X86VarAlloc::guessAlloc()`.
+enum { kMaxGuessFlow = 10 };
 
-  ASMJIT_INLINE X86BaseAlloc(X86Context* context) {
-    _context = context;
-    _compiler = context->getCompiler();
+//! \internal
+//!
+//! Code-flow path to be visited by `X86VarAlloc::guessAlloc()`.
+struct GuessFlowData {
+  ASMJIT_INLINE void init(HLNode* node, uint32_t counter) {
+    _node = node;
+    _counter = counter;
   }
-  ASMJIT_INLINE ~X86BaseAlloc() {}
 
-  // --------------------------------------------------------------------------
-  // [Accessors]
-  // --------------------------------------------------------------------------
+  //! Node to start.
+  HLNode* _node;
+  //! Number of nodes processed before the code-flow has been split.
+  uint32_t _counter;
+};
 
-  //! Get the context.
-  ASMJIT_INLINE X86Context* getContext() const { return _context; }
-  //! Get the current state (always the same instance as X86Context::_x86State).
-  ASMJIT_INLINE X86VarState* getState() const { return _context->getState(); }
+//! \internal
+//!
+//! Get the node that follows `node` in the code-flow, or `nullptr` if the flow
+//! ends by a return or a jump that is not followed. If `node` is a conditional
+//! jump its target is returned and the other path is remembered in `gfArray`.
+static ASMJIT_INLINE HLNode* X86VarAlloc_guessNext(HLNode* node,
+  GuessFlowData* gfArray, uint32_t& gfIndex, uint32_t counter) {
 
-  //! Get the node.
-  ASMJIT_INLINE HLNode* getNode() const { return _node; }
+  if (node->hasFlag(HLNode::kFlagIsRet))
+    return nullptr;
 
-  //! Get VarAttr list (all).
-  ASMJIT_INLINE VarAttr* getVaList() const { return _vaList[0]; }
-  //! Get VarAttr list (per class).
-  ASMJIT_INLINE VarAttr* getVaListByClass(uint32_t rc) const { return _vaList[rc]; }
+  if (node->hasFlag(HLNode::kFlagIsJmp))
+    return static_cast<HLJump*>(node)->getTarget();
+
+  HLNode* next = node->getNext();
+  if (node->hasFlag(HLNode::kFlagIsJcc)) {
+    HLNode* target = static_cast<HLJump*>(node)->getTarget();
+    if (target != nullptr) {
+      if (gfIndex < kMaxGuessFlow)
+        gfArray[gfIndex++].init(next, counter);
+      next = target;
+    }
+  }
+  return next;
+}
 
-  //! Get VarAttr count (all).
-  ASMJIT_INLINE uint32_t getVaCount() const { return _vaCount; }
-  //! Get VarAttr count (per class).
-  ASMJIT_INLINE uint32_t getVaCountByClass(uint32_t rc) const { return _count.get(rc); }
+//! \internal
+//!
+//! Restrict `safeRegs` to `mask`. Returns false and keeps `safeRegs` if there
+//! would be no register left.
+static ASMJIT_INLINE bool X86VarAlloc_restrictRegs(uint32_t& safeRegs, uint32_t mask) {
+  uint32_t tempRegs = safeRegs & mask;
+  if (tempRegs == 0)
+    return false;
+
+  safeRegs = tempRegs;
+  return true;
+}
 
-  //! Get whether all variables of class `c` are done.
-  ASMJIT_INLINE bool isVaDone(uint32_t rc) const { return _done.get(rc) == _count.get(rc); }
+// The idea is to follow the code-flow and to restrict the possible registers
+// where to allocate as much as possible, so `vd` is not allocated to a register
+// needed by a special instruction (div, mul, shifts, ...), clobbered by a call,
+// or that is a home of another variable used together with `vd`. Both paths of
+// conditional jumps are visited until `getMaxLookAhead()` nodes are processed.
+template<int C>
+ASMJIT_INLINE uint32_t X86VarAlloc::guessAlloc(VarData* vd, uint32_t allocableRegs) {
+  ASMJIT_TLOG("[RA-GUESS] === %s (Input=%08X) ===\n", vd->getName(), allocableRegs);
+  ASMJIT_ASSERT(allocableRegs != 0);
 
-  //! Get how many variables have been allocated.
-  ASMJIT_INLINE uint32_t getVaDone(uint32_t rc) const { return _done.get(rc); }
-  //! Add to the count of variables allocated.
-  ASMJIT_INLINE void addVaDone(uint32_t rc, uint32_t n = 1) { _done.add(rc, n); }
+  // Stop now if there is only one bit (register) set in `allocableRegs` mask.
+  uint32_t safeRegs = allocableRegs;
+  if (Utils::isPowerOf2(safeRegs))
+    return safeRegs;
 
-  //! Get number of allocable registers per class.
-  ASMJIT_INLINE uint32_t getGaRegs(uint32_t rc) const {
-    return _context->_gaRegs[rc];
+  // Use the register assigned by the linear scan, if any, unless it's held
+  // by another variable used by this node.
+  if (_node->hasBlockId()) {
+    uint32_t lsRegIndex = _context->getLsRegIndex(vd, _node->getFlowId());
+    if (lsRegIndex != kInvalidReg && (safeRegs & Utils::mask(lsRegIndex)) != 0) {
+      VarData* lsVd = _context->getState()->getListByClass(C)[lsRegIndex];
+      if (lsVd == nullptr || lsVd->getVa() == nullptr)
+        return Utils::mask(lsRegIndex);
+    }
   }
 
-  // --------------------------------------------------------------------------
-  // [Init / Cleanup]
-  // --------------------------------------------------------------------------
+  uint32_t counter = 0;
+  uint32_t maxLookAhead = _compiler->getMaxLookAhead();
 
-protected:
-  // Just to prevent calling these methods by X86Context::translate().
+  uint32_t localId = vd->getLocalId();
+  uint32_t localToken = _compiler->_generateUniqueToken();
 
-  ASMJIT_INLINE void init(HLNode* node, X86VarMap* map);
-  ASMJIT_INLINE void cleanup();
+  uint32_t homeRegs = 0;
+  uint32_t gfIndex = 0;
+  GuessFlowData gfArray[kMaxGuessFlow];
 
-  // --------------------------------------------------------------------------
-  // [Unuse]
-  // --------------------------------------------------------------------------
+  // Mark this node and also exit node, it will terminate the flow if encountered.
+  _node->setTokenId(localToken);
+  _context->getFunc()->getExitNode()->setTokenId(localToken);
 
-  template<int C>
-  ASMJIT_INLINE void unuseBefore();
+  // Whether `vd` is alive at `node`. It's alive after `_node` unless marked
+  // dead there and it's known at the start of every block, as the flow only
+  // enters a block at its first node.
+  VarAttr* va = vd->getVa();
+  bool alive = va == nullptr || !va->hasFlag(kVarAttrDead);
 
-  template<int C>
-  ASMJIT_INLINE void unuseAfter();
+  HLNode* node = X86VarAlloc_guessNext(_node, gfArray, gfIndex, counter);
+  for (;;) {
+    // Terminate if we have seen this node already or looked far enough.
+    if (node == nullptr || node->hasTokenId(localToken) || counter >= maxLookAhead)
+      goto _NextFlow;
+
+    if (node->hasBlockId()) {
+      BasicBlock* block = _context->getBlockOf(node);
+      if (block->getFirst() == node)
+        alive = block->getLiveIn()->getBit(localId) != 0;
+    }
 
-  // --------------------------------------------------------------------------
-  // [Members]
-  // --------------------------------------------------------------------------
+    ASMJIT_TSEC({
+      _context->_traceNode(_context, node, "  ");
+    });
 
-  //! Context.
-  X86Context* _context;
-  //! Compiler.
-  X86Compiler* _compiler;
+    node->setTokenId(localToken);
+    counter++;
+    va = nullptr;
+
+    if (node->hasState()) {
+      // If this node contains a state, we have to consider only the state
+      // and then we can terminate safely - this happens if we jumped to a
+      // label that is backward (i.e. start of the loop). Prefer the register
+      // of `vd` in the state so no move is needed on the jump, or at least a
+      // register that is not used by other variables.
+      X86VarState* state = node->getState<X86VarState>();
+      VarData** vdArray = state->getListByClass(C);
+      uint32_t vdCount = _compiler->getRegCount().get(C);
+
+      uint32_t stateRegs = 0;
+      uint32_t usedRegs = 0;
+
+      for (uint32_t vdIndex = 0; vdIndex < vdCount; vdIndex++) {
+        if (vdArray[vdIndex] == vd)
+          stateRegs |= Utils::mask(vdIndex);
+        else if (vdArray[vdIndex] != nullptr)
+          usedRegs |= Utils::mask(vdIndex);
+      }
 
-  //! Node.
-  HLNode* _node;
+      if (!X86VarAlloc_restrictRegs(safeRegs, stateRegs))
+        X86VarAlloc_restrictRegs(safeRegs, ~usedRegs);
+      goto _NextFlow;
+    }
 
-  //! Variable map.
-  X86VarMap* _map;
-  //! VarAttr list (per register class).
-  VarAttr* _vaList[_kX86RegClassManagedCount];
+    {
+      // Process the current node if it has any variables associated in.
+      X86VarMap* map = node->getMap<X86VarMap>();
+      if (map != nullptr) {
+        va = map->findVaByClass(C, vd);
+        uint32_t avoidRegs = map->_outRegs.get(C) | map->_clobberedRegs.get(C);
 
-  //! Count of all VarAttr's.
-  uint32_t _vaCount;
+        if (va != nullptr) {
+          // Terminate if the variable is overwritten here.
+          if (!(va->getFlags() & kVarAttrRAll))
+            goto _NextFlow;
 
-  //! VarAttr's total counter.
-  X86RegCount _count;
-  //! VarAttr's done counter.
-  X86RegCount _done;
-};
+          // Terminate if the variable is required in a fixed register here,
+          // allocating it to that register now saves a move.
+          uint32_t inRegs = va->getInRegs();
+          if (inRegs != 0) {
+            X86VarAlloc_restrictRegs(safeRegs, inRegs);
+            goto _NextFlow;
+          }
 
-// ============================================================================
-// [asmjit::X86BaseAlloc - Init / Cleanup]
-// ============================================================================
+          uint32_t mask = va->getAllocableRegs();
+          if (mask != 0 && !X86VarAlloc_restrictRegs(safeRegs, mask))
+            goto _NextFlow;
+        }
+        else {
+          // Fixed registers used by other variables (special instructions).
+          avoidRegs |= map->_inRegs.get(C);
+        }
 
-ASMJIT_INLINE void X86BaseAlloc::init(HLNode* node, X86VarMap* map) {
-  _node = node;
-  _map = map;
+        if (!X86VarAlloc_restrictRegs(safeRegs, ~avoidRegs))
+          goto _NextFlow;
 
-  // We have to set the correct cursor in case any instruction is emitted
-  // during the allocation phase; it has to be emitted before the current
-  // instruction.
-  _compiler->_setCursor(node->getPrev());
+        // Collect home registers of other variables, see the end.
+        VarAttr* vaList = map->getVaListByClass(C);
+        uint32_t vaCount = map->getVaCountByClass(C);
 
-  // Setup the lists of variables.
-  {
-    VarAttr* va = map->getVaList();
-    _vaList[kX86RegClassGp ] = va;
-    _vaList[kX86RegClassMm ] = va + map->getVaStart(kX86RegClassMm );
-    _vaList[kX86RegClassK  ] = va + map->getVaStart(kX86RegClassK  );
-    _vaList[kX86RegClassXyz] = va + map->getVaStart(kX86RegClassXyz);
-  }
+        for (uint32_t vaIndex = 0; vaIndex < vaCount; vaIndex++) {
+          VarData* otherVd = vaList[vaIndex].getVd();
+          if (otherVd != vd)
+            homeRegs |= otherVd->getHomeMask();
+        }
+      }
+    }
 
-  // Setup counters.
-  _vaCount = map->getVaCount();
+    // Terminate if the variable is dead here. The node is still considered as
+    // registers it uses are going to be allocated while `vd` is alive.
+    if (node->hasBlockId()) {
+      if (va == nullptr && !alive) {
+        ASMJIT_TLOG("[RA-GUESS] %s (Terminating, Not alive here)\n", vd->getName());
+        goto _NextFlow;
+      }
 
-  _count = map->_count;
-  _done.reset();
+      if (va != nullptr)
+        alive = !va->hasFlag(kVarAttrDead);
+    }
 
-  // Connect Vd->Va.
-  for (uint32_t i = 0; i < _vaCount; i++) {
-    VarAttr* va = &_vaList[0][i];
-    VarData* vd = va->getVd();
+    node = X86VarAlloc_guessNext(node, gfArray, gfIndex, counter);
+    continue;
 
-    vd->setVa(va);
+_NextFlow:
+    if (gfIndex == 0)
+      break;
+
+    GuessFlowData* data = &gfArray[--gfIndex];
+    node = data->_node;
+    counter = data->_counter;
   }
+
+  // It happens often that one variable is used across many blocks of
+  // assembly code. It can sometimes cause one variable to be allocated
+  // in a different register, which can cause state switch to generate
+  // moves in case of jumps and state intersections. We try to prevent
+  // this case by also considering variables' home registers, but only
+  // if it doesn't conflict with any requirement found above.
+  X86VarAlloc_restrictRegs(safeRegs, ~homeRegs);
+
+  ASMJIT_TLOG("[RA-GUESS] === %s (Output=%08X) ===\n", vd->getName(), safeRegs);
+  return safeRegs;
 }
 
-ASMJIT_INLINE void X86BaseAlloc::cleanup() {
-  // Disconnect Vd->Va.
-  for (uint32_t i = 0; i < _vaCount; i++) {
-    VarAttr* va = &_vaList[0][i];
-    VarData* vd = va->getVd();
+template<int C>
+ASMJIT_INLINE uint32_t X86VarAlloc::guessSpill(VarData* vd, uint32_t allocableRegs) {
+  ASMJIT_ASSERT(allocableRegs != 0);
 
-    vd->setVa(nullptr);
-  }
+  return 0;
 }
 
 // ============================================================================
-// [asmjit::X86BaseAlloc - Unuse]
+// [asmjit::X86VarAlloc - Modified]
 // ============================================================================
 
 template<int C>
-ASMJIT_INLINE void X86BaseAlloc::unuseBefore() {
+ASMJIT_INLINE void X86VarAlloc::modified() {
   VarAttr* list = getVaListByClass(C);
   uint32_t count = getVaCountByClass(C);
 
-  const uint32_t checkFlags =
-    kVarAttrXReg  |
-    kVarAttrRMem  |
-    kVarAttrRFunc |
-    kVarAttrRCall |
-    kVarAttrRConv ;
-
   for (uint32_t i = 0; i < count; i++) {
     VarAttr* va = &list[i];
 
-    if ((va->getFlags() & checkFlags) == kVarAttrWReg) {
-      _context->unuse<C>(va->getVd());
-    }
-  }
-}
-
-template<int C>
-ASMJIT_INLINE void X86BaseAlloc::unuseAfter() {
-  VarAttr* list = getVaListByClass(C);
-  uint32_t count = getVaCountByClass(C);
+    if (va->hasFlag(kVarAttrWReg)) {
+      VarData* vd = va->getVd();
 
-  for (uint32_t i = 0; i < count; i++) {
-    VarAttr* va = &list[i];
+      uint32_t regIndex = vd->getRegIndex();
+      uint32_t regMask = Utils::mask(regIndex);
 
-    if (va->getFlags() & kVarAttrUnuse)
-      _context->unuse<C>(va->getVd());
+      vd->setModified(true);
+      _context->_x86State._modified.or_(C, regMask);
+    }
   }
 }
 
 // ============================================================================
-// [asmjit::X86VarAlloc]
+// [asmjit::X86CallAlloc]
 // ============================================================================
 
 //! \internal
 //!
-//! Register allocator context (asm instructions).
-struct X86VarAlloc : public X86BaseAlloc {
+//! Register allocator context (function call).
+struct X86CallAlloc : public X86BaseAlloc {
   // --------------------------------------------------------------------------
   // [Construction / Destruction]
   // --------------------------------------------------------------------------
 
-  ASMJIT_INLINE X86VarAlloc(X86Context* context) : X86BaseAlloc(context) {}
-  ASMJIT_INLINE ~X86VarAlloc() {}
+  ASMJIT_INLINE X86CallAlloc(X86Context* context) : X86BaseAlloc(context) {}
+  ASMJIT_INLINE ~X86CallAlloc() {}
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get the node.
+  ASMJIT_INLINE X86CallNode* getNode() const { return static_cast<X86CallNode*>(_node); }
 
   // --------------------------------------------------------------------------
   // [Run]
   // --------------------------------------------------------------------------
 
-  ASMJIT_INLINE Error run(HLNode* node);
+  ASMJIT_INLINE Error run(X86CallNode* node);
 
   // --------------------------------------------------------------------------
   // [Init / Cleanup]
   // --------------------------------------------------------------------------
 
 protected:
-  // Just to prevent calling these methods by X86Context::translate().
-
-  ASMJIT_INLINE void init(HLNode* node, X86VarMap* map);
+  // Just to prevent calling these methods from X86Context::translate().
+  ASMJIT_INLINE void init(X86CallNode* node, X86VarMap* map);
   ASMJIT_INLINE void cleanup();
 
   // --------------------------------------------------------------------------
-  // [Plan / Spill / Alloc]
+  // [Plan / Alloc / Spill / Move]
   // --------------------------------------------------------------------------
 
   template<int C>
@@ -3231,31 +5987,48 @@ protected:
   template<int C>
   ASMJIT_INLINE void alloc();
 
+  // --------------------------------------------------------------------------
+  // [AllocImmsOnStack]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_INLINE void allocImmsOnStack();
+
+  // --------------------------------------------------------------------------
+  // [Duplicate]
+  // --------------------------------------------------------------------------
+
+  template<int C>
+  ASMJIT_INLINE void duplicate();
+
   // --------------------------------------------------------------------------
   // [GuessAlloc / GuessSpill]
   // --------------------------------------------------------------------------
 
-  //! Guess which register is the best candidate for 'vd' from
-  //! 'allocableRegs'.
-  //!
-  //! The guess is based on looking ahead and inspecting register allocator
-  //! instructions. The main reason is to prevent allocation to a register
-  //! which is needed by next instruction(s). The guess look tries to go as far
-  //! as possible, after the remaining registers are zero, the mask of previous
-  //! registers (called 'safeRegs') is returned.
   template<int C>
   ASMJIT_INLINE uint32_t guessAlloc(VarData* vd, uint32_t allocableRegs);
 
-  //! Guess whether to move the given 'vd' instead of spill.
   template<int C>
   ASMJIT_INLINE uint32_t guessSpill(VarData* vd, uint32_t allocableRegs);
 
   // --------------------------------------------------------------------------
-  // [Modified]
+  // [Save]
   // --------------------------------------------------------------------------
 
   template<int C>
-  ASMJIT_INLINE void modified();
+  ASMJIT_INLINE void save();
+
+  // --------------------------------------------------------------------------
+  // [Clobber]
+  // --------------------------------------------------------------------------
+
+  template<int C>
+  ASMJIT_INLINE void clobber();
+
+  // --------------------------------------------------------------------------
+  // [Ret]
+  // --------------------------------------------------------------------------
+
+  ASMJIT_INLINE void ret();
 
   // --------------------------------------------------------------------------
   // [Members]
@@ -3268,135 +6041,110 @@ protected:
 };
 
 // ============================================================================
-// [asmjit::X86VarAlloc - Run]
+// [asmjit::X86CallAlloc - Run]
 // ============================================================================
 
-ASMJIT_INLINE Error X86VarAlloc::run(HLNode* node_) {
+ASMJIT_INLINE Error X86CallAlloc::run(X86CallNode* node) {
   // Initialize.
-  X86VarMap* map = node_->getMap<X86VarMap>();
+  X86VarMap* map = node->getMap<X86VarMap>();
   if (map == nullptr)
     return kErrorOk;
 
-  // Initialize the allocator; connect Vd->Va.
-  init(node_, map);
-
-  // Unuse overwritten variables.
-  unuseBefore<kX86RegClassGp>();
-  unuseBefore<kX86RegClassMm>();
-  unuseBefore<kX86RegClassXyz>();
+  // Initialize the allocator; prepare basics and connect Vd->Va.
+  init(node, map);
 
-  // Plan the allocation. Planner assigns input/output registers for each
-  // variable and decides whether to allocate it in register or stack.
-  plan<kX86RegClassGp>();
-  plan<kX86RegClassMm>();
+  // Plan register allocation. Planner is only able to assign one register per
+  // variable. If any variable is used multiple times it will be handled later.
+  plan<kX86RegClassGp >();
+  plan<kX86RegClassMm >();
   plan<kX86RegClassXyz>();
 
-  // Spill all variables marked by plan().
-  spill<kX86RegClassGp>();
-  spill<kX86RegClassMm>();
+  // Spill.
+  spill<kX86RegClassGp >();
+  spill<kX86RegClassMm >();
   spill<kX86RegClassXyz>();
 
-  // Alloc all variables marked by plan().
-  alloc<kX86RegClassGp>();
-  alloc<kX86RegClassMm>();
+  // Alloc.
+  alloc<kX86RegClassGp >();
+  alloc<kX86RegClassMm >();
   alloc<kX86RegClassXyz>();
 
-  // Translate node operands.
-  if (node_->getType() == HLNode::kTypeInst) {
-    HLInst* node = static_cast<HLInst*>(node_);
-    ASMJIT_PROPAGATE_ERROR(X86Context_translateOperands(_context, node->getOpList(), node->getOpCount()));
-  }
-  else if (node_->getType() == HLNode::kTypeCallArg) {
-    HLCallArg* node = static_cast<HLCallArg*>(node_);
-
-    X86CallNode* call = static_cast<X86CallNode*>(node->getCall());
-    X86FuncDecl* decl = call->getDecl();
-
-    uint32_t argIndex = 0;
-    uint32_t argMask = node->_args;
-
-    VarData* sVd = node->getSVd();
-    VarData* cVd = node->getCVd();
+  // Unuse clobbered registers that are not used to pass function arguments and
+  // save variables used to pass function arguments that will be reused later on.
+  save<kX86RegClassGp >();
+  save<kX86RegClassMm >();
+  save<kX86RegClassXyz>();
 
-    // Convert first.
-    ASMJIT_ASSERT(sVd->getRegIndex() != kInvalidReg);
+  // Allocate immediates in registers and on the stack.
+  allocImmsOnStack();
 
-    if (cVd != nullptr) {
-      ASMJIT_ASSERT(cVd->getRegIndex() != kInvalidReg);
-      _context->emitConvertVarToVar(
-        cVd->getType(), cVd->getRegIndex(),
-        sVd->getType(), sVd->getRegIndex());
-      sVd = cVd;
-    }
+  // Duplicate.
+  duplicate<kX86RegClassGp >();
+  duplicate<kX86RegClassMm >();
+  duplicate<kX86RegClassXyz>();
 
-    while (argMask != 0) {
-      if (argMask & 0x1) {
-        FuncInOut& arg = decl->getArg(argIndex);
-        ASMJIT_ASSERT(arg.hasStackOffset());
+  // Translate call operand.
+  ASMJIT_PROPAGATE_ERROR(X86Context_translateOperands(_context, &node->_target, 1));
 
-        X86Mem dst = x86::ptr(_context->_zsp, -static_cast<int>(_context->getRegSize()) + arg.getStackOffset());
-        _context->emitMoveVarOnStack(arg.getVarType(), &dst, sVd->getType(), sVd->getRegIndex());
-      }
+  // To emit instructions after call.
+  _compiler->_setCursor(node);
 
-      argIndex++;
-      argMask >>= 1;
-    }
+  // If the callee pops stack it has to be manually adjusted back.
+  X86FuncDecl* decl = node->getDecl();
+  if (decl->getCalleePopsStack() && decl->getArgStackSize() != 0) {
+    _compiler->emit(kX86InstIdSub, _context->_zsp, static_cast<int>(decl->getArgStackSize()));
   }
 
-  // Mark variables as modified.
-  modified<kX86RegClassGp>();
-  modified<kX86RegClassMm>();
-  modified<kX86RegClassXyz>();
-
-  // Cleanup; disconnect Vd->Va.
-  cleanup();
+  // Clobber.
+  clobber<kX86RegClassGp >();
+  clobber<kX86RegClassMm >();
+  clobber<kX86RegClassXyz>();
 
-  // Update clobbered mask.
-  _context->_clobberedRegs.or_(_willAlloc);
-  _context->_clobberedRegs.or_(map->_clobberedRegs);
+  // Return.
+  ret();
 
   // Unuse.
-  unuseAfter<kX86RegClassGp>();
-  unuseAfter<kX86RegClassMm>();
+  unuseAfter<kX86RegClassGp >();
+  unuseAfter<kX86RegClassMm >();
   unuseAfter<kX86RegClassXyz>();
 
+  // Cleanup; disconnect Vd->Va.
+  cleanup();
+
   return kErrorOk;
 }
 
 // ============================================================================
-// [asmjit::X86VarAlloc - Init / Cleanup]
+// [asmjit::X86CallAlloc - Init / Cleanup]
 // ============================================================================
 
-ASMJIT_INLINE void X86VarAlloc::init(HLNode* node, X86VarMap* map) {
+ASMJIT_INLINE void X86CallAlloc::init(X86CallNode* node, X86VarMap* map) {
   X86BaseAlloc::init(node, map);
 
-  // These will block planner from assigning them during planning. Planner will
-  // add more registers when assigning registers to variables that don't need
-  // any specific register.
-  _willAlloc = map->_inRegs;
-  _willAlloc.or_(map->_outRegs);
+  // Create mask of all registers that will be used to pass function arguments.
+  _willAlloc = node->_usedArgs;
   _willSpill.reset();
 }
 
-ASMJIT_INLINE void X86VarAlloc::cleanup() {
+ASMJIT_INLINE void X86CallAlloc::cleanup() {
   X86BaseAlloc::cleanup();
 }
 
 // ============================================================================
-// [asmjit::X86VarAlloc - Plan / Spill / Alloc]
+// [asmjit::X86CallAlloc - Plan / Spill / Alloc]
 // ============================================================================
 
 template<int C>
-ASMJIT_INLINE void X86VarAlloc::plan() {
-  if (isVaDone(C))
-    return;
-
+ASMJIT_INLINE void X86CallAlloc::plan() {
   uint32_t i;
+  uint32_t clobbered = _map->_clobberedRegs.get(C);
+
   uint32_t willAlloc = _willAlloc.get(C);
-  uint32_t willFree = 0;
+  uint32_t willFree = clobbered & ~willAlloc;
 
   VarAttr* list = getVaListByClass(C);
   uint32_t count = getVaCountByClass(C);
+
   X86VarState* state = getState();
 
   // Calculate 'willAlloc' and 'willFree' masks based on mandatory masks.
@@ -3408,194 +6156,92 @@ ASMJIT_INLINE void X86VarAlloc::plan() {
     uint32_t regIndex = vd->getRegIndex();
     uint32_t regMask = (regIndex != kInvalidReg) ? Utils::mask(regIndex) : 0;
 
-    if ((vaFlags & kVarAttrXReg) != 0) {
+    if ((vaFlags & kVarAttrRReg) != 0) {
       // Planning register allocation. First check whether the variable is
-      // already allocated in register and if it can stay allocated there.
-      //
-      // The following conditions may happen:
-      //
-      // a) Allocated register is one of the mandatoryRegs.
-      // b) Allocated register is one of the allocableRegs.
-      uint32_t mandatoryRegs = va->getInRegs();
-      uint32_t allocableRegs = va->getAllocableRegs();
-
-      ASMJIT_TLOG("[RA-PLAN] %s (%s)\n",
-        vd->getName(),
-        (vaFlags & kVarAttrXReg) == kVarAttrWReg ? "R-Reg" : "X-Reg");
-
-      ASMJIT_TLOG("[RA-PLAN] RegMask=%08X Mandatory=%08X Allocable=%08X\n",
-        regMask, mandatoryRegs, allocableRegs);
-
-      if (regMask != 0) {
-        // Special path for planning output-only registers.
-        if ((vaFlags & kVarAttrXReg) == kVarAttrWReg) {
-          uint32_t outRegIndex = va->getOutRegIndex();
-          mandatoryRegs = (outRegIndex != kInvalidReg) ? Utils::mask(outRegIndex) : 0;
-
-          if ((mandatoryRegs | allocableRegs) & regMask) {
-            va->setOutRegIndex(regIndex);
-            va->orFlags(kVarAttrAllocWDone);
-
-            if (mandatoryRegs & regMask) {
-              // Case 'a' - 'willAlloc' contains initially all inRegs from all VarAttr's.
-              ASMJIT_ASSERT((willAlloc & regMask) != 0);
-            }
-            else {
-              // Case 'b'.
-              va->setOutRegIndex(regIndex);
-              willAlloc |= regMask;
-            }
-
-            ASMJIT_TLOG("[RA-PLAN] WillAlloc\n");
-            addVaDone(C);
-
-            continue;
-          }
-        }
-        else {
-          if ((mandatoryRegs | allocableRegs) & regMask) {
-            va->setInRegIndex(regIndex);
-            va->orFlags(kVarAttrAllocRDone);
-
-            if (mandatoryRegs & regMask) {
-              // Case 'a' - 'willAlloc' contains initially all inRegs from all VarAttr's.
-              ASMJIT_ASSERT((willAlloc & regMask) != 0);
-            }
-            else {
-              // Case 'b'.
-              va->addInRegs(regMask);
-              willAlloc |= regMask;
-            }
-
-            ASMJIT_TLOG("[RA-PLAN] WillAlloc\n");
-            addVaDone(C);
-
-            continue;
-          }
-        }
+      // already allocated in register and if it can stay there. Function
+      // arguments are passed either in a specific register or in stack so
+      // we care mostly of mandatory registers.
+      uint32_t inRegs = va->getInRegs();
 
-        // Trace it here so we don't pollute log by `WillFree` of zero regMask.
-        ASMJIT_TLOG("[RA-PLAN] WillFree\n");
+      if (inRegs == 0) {
+        inRegs = va->getAllocableRegs();
       }
 
-      // Variable is not allocated or allocated in register that doesn't
-      // match inRegs or allocableRegs. The next step is to pick the best
-      // register for this variable. If `inRegs` contains any register the
-      // decision is simple - we have to follow, in other case will use
-      // the advantage of `guessAlloc()` to find a register (or registers)
-      // by looking ahead. But the best way to find a good register is not
-      // here since now we have no information about the registers that
-      // will be freed. So instead of finding register here, we just mark
-      // the current register (if variable is allocated) as `willFree` so
-      // the planner can use this information in the second step to plan the
-      // allocation as a whole.
-      willFree |= regMask;
-      continue;
+      // Optimize situation where the variable has to be allocated in a
+      // mandatory register, but it's already allocated in register that
+      // is not clobbered (i.e. it will survive function call).
+      if ((regMask & inRegs) != 0 || ((regMask & ~clobbered) != 0 && (vaFlags & kVarAttrUnuse) == 0)) {
+        va->setInRegIndex(regIndex);
+        va->orFlags(kVarAttrAllocRDone);
+        addVaDone(C);
+      }
+      else {
+        willFree |= regMask;
+      }
     }
     else {
       // Memory access - if variable is allocated it has to be freed.
-      ASMJIT_TLOG("[RA-PLAN] %s (Memory)\n", vd->getName());
-
       if (regMask != 0) {
-        ASMJIT_TLOG("[RA-PLAN] WillFree\n");
         willFree |= regMask;
-        continue;
-      }
-      else {
-        ASMJIT_TLOG("[RA-PLAN] Done\n");
-        va->orFlags(kVarAttrAllocRDone);
-        addVaDone(C);
-        continue;
-      }
-    }
-  }
-
-  // Occupied registers without 'willFree' registers; contains basically
-  // all the registers we can use to allocate variables without inRegs
-  // speficied.
-  uint32_t occupied = state->_occupied.get(C) & ~willFree;
-  uint32_t willSpill = 0;
-
-  // Find the best registers for variables that are not allocated yet.
-  for (i = 0; i < count; i++) {
-    VarAttr* va = &list[i];
-    VarData* vd = va->getVd();
-
-    uint32_t vaFlags = va->getFlags();
-
-    if ((vaFlags & kVarAttrXReg) != 0) {
-      if ((vaFlags & kVarAttrXReg) == kVarAttrWReg) {
-        if (vaFlags & kVarAttrAllocWDone)
-          continue;
-
-        // Skip all registers that have assigned outRegIndex. Spill if occupied.
-        if (va->hasOutRegIndex()) {
-          uint32_t outRegs = Utils::mask(va->getOutRegIndex());
-          willSpill |= occupied & outRegs;
-          continue;
-        }
       }
-      else {
-        if (vaFlags & kVarAttrAllocRDone)
-          continue;
-
-        // We skip all registers that have assigned inRegIndex, indicates that
-        // the register to allocate in is known.
-        if (va->hasInRegIndex()) {
-          uint32_t inRegs = va->getInRegs();
-          willSpill |= occupied & inRegs;
-          continue;
-        }
+      else {
+        va->orFlags(kVarAttrAllocRDone);
+        addVaDone(C);
       }
+    }
+  }
 
-      uint32_t m = va->getInRegs();
-      if (va->hasOutRegIndex())
-        m |= Utils::mask(va->getOutRegIndex());
+  // Occupied registers without 'willFree' registers; contains basically
+  // all the registers we can use to allocate variables without inRegs
+  // speficied.
+  uint32_t occupied = state->_occupied.get(C) & ~willFree;
+  uint32_t willSpill = 0;
 
-      m = va->getAllocableRegs() & ~(willAlloc ^ m);
-      m = guessAlloc<C>(vd, m);
-      ASMJIT_ASSERT(m != 0);
+  // Find the best registers for variables that are not allocated yet. Only
+  // useful for Gp registers used as call operand.
+  for (i = 0; i < count; i++) {
+    VarAttr* va = &list[i];
+    VarData* vd = va->getVd();
 
-      uint32_t candidateRegs = m & ~occupied;
-      uint32_t homeMask = vd->getHomeMask();
+    uint32_t vaFlags = va->getFlags();
+    if ((vaFlags & kVarAttrAllocRDone) != 0 || (vaFlags & kVarAttrRReg) == 0)
+      continue;
 
-      uint32_t regIndex;
-      uint32_t regMask;
+    // All registers except Gp used by call itself must have inRegIndex.
+    uint32_t m = va->getInRegs();
+    if (C != kX86RegClassGp || m) {
+      ASMJIT_ASSERT(m != 0);
+      va->setInRegIndex(Utils::findFirstBit(m));
+      willSpill |= occupied & m;
+      continue;
+    }
 
-      if (candidateRegs == 0) {
-        candidateRegs = m & occupied & ~state->_modified.get(C);
-        if (candidateRegs == 0)
-          candidateRegs = m;
-      }
+    m = va->getAllocableRegs() & ~(willAlloc ^ m);
+    m = guessAlloc<C>(vd, m);
+    ASMJIT_ASSERT(m != 0);
 
-      // printf("CANDIDATE: %s %08X\n", vd->getName(), homeMask);
-      if (candidateRegs & homeMask)
-        candidateRegs &= homeMask;
+    uint32_t candidateRegs = m & ~occupied;
+    if (candidateRegs == 0) {
+      candidateRegs = m & occupied & ~state->_modified.get(C);
+      if (candidateRegs == 0)
+        candidateRegs = m;
+    }
 
-      regIndex = Utils::findFirstBit(candidateRegs);
-      regMask = Utils::mask(regIndex);
+    if (!(vaFlags & (kVarAttrWReg | kVarAttrUnuse)) && (candidateRegs & ~clobbered))
+      candidateRegs &= ~clobbered;
 
-      if ((vaFlags & kVarAttrXReg) == kVarAttrWReg) {
-        va->setOutRegIndex(regIndex);
-      }
-      else {
-        va->setInRegIndex(regIndex);
-        va->setInRegs(regMask);
-      }
+    uint32_t regIndex = Utils::findFirstBit(candidateRegs);
+    uint32_t regMask = Utils::mask(regIndex);
 
-      willAlloc |= regMask;
-      willSpill |= regMask & occupied;
-      willFree  &=~regMask;
-      occupied  |= regMask;
+    va->setInRegIndex(regIndex);
+    va->setInRegs(regMask);
 
-      continue;
-    }
-    else if ((vaFlags & kVarAttrXMem) != 0) {
-      uint32_t regIndex = vd->getRegIndex();
-      if (regIndex != kInvalidReg && (vaFlags & kVarAttrXMem) != kVarAttrWMem) {
-        willSpill |= Utils::mask(regIndex);
-      }
-    }
+    willAlloc |= regMask;
+    willSpill |= regMask & occupied;
+    willFree &= ~regMask;
+
+    occupied |= regMask;
+    continue;
   }
 
   // Set calculated masks back to the allocator; needed by spill() and alloc().
@@ -3604,7 +6250,7 @@ ASMJIT_INLINE void X86VarAlloc::plan() {
 }
 
 template<int C>
-ASMJIT_INLINE void X86VarAlloc::spill() {
+ASMJIT_INLINE void X86CallAlloc::spill() {
   uint32_t m = _willSpill.get(C);
   uint32_t i = static_cast<uint32_t>(0) - 1;
 
@@ -3626,2063 +6272,2668 @@ ASMJIT_INLINE void X86VarAlloc::spill() {
 
     VarData* vd = sVars[i];
     ASMJIT_ASSERT(vd != nullptr);
-
-    VarAttr* va = vd->getVa();
-    ASMJIT_ASSERT(va == nullptr || !va->hasFlag(kVarAttrXReg));
+    ASMJIT_ASSERT(vd->getVa() == nullptr);
 
     if (vd->isModified() && availableRegs) {
-      // Don't check for alternatives if the variable has to be spilled.
-      if (va == nullptr || !va->hasFlag(kVarAttrSpill)) {
-        uint32_t altRegs = guessSpill<C>(vd, availableRegs);
+      uint32_t available = guessSpill<C>(vd, availableRegs);
+      if (available != 0) {
+        uint32_t regIndex = Utils::findFirstBit(available);
+        uint32_t regMask = Utils::mask(regIndex);
 
-        if (altRegs != 0) {
-          uint32_t regIndex = Utils::findFirstBit(altRegs);
-          uint32_t regMask = Utils::mask(regIndex);
+        _context->move<C>(vd, regIndex);
+        availableRegs ^= regMask;
+        continue;
+      }
+    }
 
-          _context->move<C>(vd, regIndex);
-          availableRegs ^= regMask;
+    _context->spill<C>(vd);
+  } while (m != 0);
+}
+
+template<int C>
+ASMJIT_INLINE void X86CallAlloc::alloc() {
+  if (isVaDone(C))
+    return;
+
+  VarAttr* list = getVaListByClass(C);
+  uint32_t count = getVaCountByClass(C);
+
+  X86VarState* state = getState();
+  VarData** sVars = state->getListByClass(C);
+
+  uint32_t i;
+  bool didWork;
+
+  do {
+    didWork = false;
+    for (i = 0; i < count; i++) {
+      VarAttr* aVa = &list[i];
+      VarData* aVd = aVa->getVd();
+
+      if ((aVa->getFlags() & (kVarAttrRReg | kVarAttrAllocRDone)) != kVarAttrRReg)
+        continue;
+
+      uint32_t aIndex = aVd->getRegIndex();
+      uint32_t bIndex = aVa->getInRegIndex();
+
+      // Shouldn't be the same.
+      ASMJIT_ASSERT(aIndex != bIndex);
+
+      VarData* bVd = getState()->getListByClass(C)[bIndex];
+      if (bVd != nullptr) {
+        VarAttr* bVa = bVd->getVa();
+
+        // Gp registers only - Swap two registers if we can solve two
+        // allocation tasks by a single 'xchg' instruction, swapping
+        // two registers required by the instruction/node or one register
+        // required with another non-required.
+        if (C == kX86RegClassGp && aIndex != kInvalidReg) {
+          _context->swapGp(aVd, bVd);
+
+          aVa->orFlags(kVarAttrAllocRDone);
+          addVaDone(C);
+
+          // Doublehit, two registers allocated by a single swap.
+          if (bVa != nullptr && bVa->getInRegIndex() == aIndex) {
+            bVa->orFlags(kVarAttrAllocRDone);
+            addVaDone(C);
+          }
+
+          didWork = true;
           continue;
         }
+
+        // The register is held by a variable not used by the call, which
+        // would be saved by the call anyway, spill it now.
+        if (bVa == nullptr) {
+          _context->spill<C>(bVd);
+
+          didWork = true;
+          continue;
+        }
+      }
+      else if (aIndex != kInvalidReg) {
+        _context->move<C>(aVd, bIndex);
+        _context->_clobberedRegs.or_(C, Utils::mask(bIndex));
+
+        aVa->orFlags(kVarAttrAllocRDone);
+        addVaDone(C);
+
+        didWork = true;
+        continue;
+      }
+      else {
+        _context->alloc<C>(aVd, bIndex);
+        _context->_clobberedRegs.or_(C, Utils::mask(bIndex));
+
+        aVa->orFlags(kVarAttrAllocRDone);
+        addVaDone(C);
+
+        didWork = true;
+        continue;
       }
     }
+  } while (didWork);
+}
 
-    _context->spill<C>(vd);
-  } while (m != 0);
+// ============================================================================
+// [asmjit::X86CallAlloc - AllocImmsOnStack]
+// ============================================================================
+
+ASMJIT_INLINE void X86CallAlloc::allocImmsOnStack() {
+  X86CallNode* node = getNode();
+  X86FuncDecl* decl = node->getDecl();
+
+  uint32_t argCount = decl->getNumArgs();
+  Operand* args = node->_args;
+
+  for (uint32_t i = 0; i < argCount; i++) {
+    Operand& op = args[i];
+
+    if (!op.isImm())
+      continue;
+
+    const Imm& imm = static_cast<const Imm&>(op);
+    const FuncInOut& arg = decl->getArg(i);
+    uint32_t varType = arg.getVarType();
+
+    if (arg.hasStackOffset()) {
+      X86Mem dst = x86::ptr(_context->_zsp, -static_cast<int>(_context->getRegSize()) + arg.getStackOffset());
+      _context->emitMoveImmOnStack(varType, &dst, &imm);
+    }
+    else {
+      _context->emitMoveImmToReg(varType, arg.getRegIndex(), &imm);
+    }
+  }
+}
+
+// ============================================================================
+// [asmjit::X86CallAlloc - Duplicate]
+// ============================================================================
+
+template<int C>
+ASMJIT_INLINE void X86CallAlloc::duplicate() {
+  VarAttr* list = getVaListByClass(C);
+  uint32_t count = getVaCountByClass(C);
+
+  for (uint32_t i = 0; i < count; i++) {
+    VarAttr* va = &list[i];
+    if (!va->hasFlag(kVarAttrRReg))
+      continue;
+
+    uint32_t inRegs = va->getInRegs();
+    if (!inRegs)
+      continue;
+
+    VarData* vd = va->getVd();
+    uint32_t regIndex = vd->getRegIndex();
+
+    ASMJIT_ASSERT(regIndex != kInvalidReg);
+
+    inRegs &= ~Utils::mask(regIndex);
+    if (!inRegs)
+      continue;
+
+    for (uint32_t dupIndex = 0; inRegs != 0; dupIndex++, inRegs >>= 1) {
+      if (inRegs & 0x1) {
+        _context->emitMove(vd, dupIndex, regIndex, "Duplicate");
+        _context->_clobberedRegs.or_(C, Utils::mask(dupIndex));
+      }
+    }
+  }
 }
 
+// ============================================================================
+// [asmjit::X86CallAlloc - GuessAlloc / GuessSpill]
+// ============================================================================
+
 template<int C>
-ASMJIT_INLINE void X86VarAlloc::alloc() {
-  if (isVaDone(C))
-    return;
-
-  uint32_t i;
-  bool didWork;
+ASMJIT_INLINE uint32_t X86CallAlloc::guessAlloc(VarData* vd, uint32_t allocableRegs) {
+  ASMJIT_ASSERT(allocableRegs != 0);
 
-  VarAttr* list = getVaListByClass(C);
-  uint32_t count = getVaCountByClass(C);
+  // Stop now if there is only one bit (register) set in 'allocableRegs' mask.
+  if (Utils::isPowerOf2(allocableRegs))
+    return allocableRegs;
 
-  // Alloc 'in' regs.
-  do {
-    didWork = false;
-    for (i = 0; i < count; i++) {
-      VarAttr* aVa = &list[i];
-      VarData* aVd = aVa->getVd();
+  // Use the register assigned by the linear scan, if any, but only if it's
+  // free as the call doesn't spill variables in registers it clobbers.
+  if (_node->hasBlockId()) {
+    uint32_t lsRegIndex = _context->getLsRegIndex(vd, _node->getFlowId());
+    if (lsRegIndex != kInvalidReg && (allocableRegs & Utils::mask(lsRegIndex)) != 0) {
+      if (_context->getState()->getListByClass(C)[lsRegIndex] == nullptr)
+        return Utils::mask(lsRegIndex);
+    }
+  }
 
-      if ((aVa->getFlags() & (kVarAttrRReg | kVarAttrAllocRDone)) != kVarAttrRReg)
-        continue;
+  uint32_t i;
+  uint32_t safeRegs = allocableRegs;
+  uint32_t maxLookAhead = _compiler->getMaxLookAhead();
 
-      uint32_t aIndex = aVd->getRegIndex();
-      uint32_t bIndex = aVa->getInRegIndex();
+  // Look ahead and calculate mask of special registers on both - input/output.
+  HLNode* node = _node;
+  for (i = 0; i < maxLookAhead; i++) {
+    // Stop on 'HLRet' and 'HLSentinel.
+    if (node->hasFlag(HLNode::kFlagIsRet))
+      break;
 
-      // Shouldn't be the same.
-      ASMJIT_ASSERT(aIndex != bIndex);
+    // Stop on conditional jump, we don't follow them.
+    if (node->hasFlag(HLNode::kFlagIsJcc))
+      break;
 
-      VarData* bVd = getState()->getListByClass(C)[bIndex];
-      if (bVd != nullptr) {
-        // Gp registers only - Swap two registers if we can solve two
-        // allocation tasks by a single 'xchg' instruction, swapping
-        // two registers required by the instruction/node or one register
-        // required with another non-required.
-        if (C == kX86RegClassGp && aIndex != kInvalidReg) {
-          VarAttr* bVa = bVd->getVa();
-          _context->swapGp(aVd, bVd);
+    // Advance on non-conditional jump.
+    if (node->hasFlag(HLNode::kFlagIsJmp)) {
+      node = static_cast<HLJump*>(node)->getTarget();
+      // Stop on jump that is not followed.
+      if (node == nullptr)
+        break;
+    }
 
-          aVa->orFlags(kVarAttrAllocRDone);
-          addVaDone(C);
+    node = node->getNext();
+    ASMJIT_ASSERT(node != nullptr);
 
-          // Doublehit, two registers allocated by a single swap.
-          if (bVa != nullptr && bVa->getInRegIndex() == aIndex) {
-            bVa->orFlags(kVarAttrAllocRDone);
-            addVaDone(C);
-          }
+    X86VarMap* map = node->getMap<X86VarMap>();
+    if (map != nullptr) {
+      VarAttr* va = map->findVaByClass(C, vd);
+      if (va != nullptr) {
+        uint32_t inRegs = va->getInRegs();
+        if (inRegs != 0) {
+          safeRegs = allocableRegs;
+          allocableRegs &= inRegs;
 
-          didWork = true;
-          continue;
+          if (allocableRegs == 0)
+            goto _UseSafeRegs;
+          else
+            return allocableRegs;
         }
       }
-      else if (aIndex != kInvalidReg) {
-        _context->move<C>(aVd, bIndex);
 
-        aVa->orFlags(kVarAttrAllocRDone);
-        addVaDone(C);
+      safeRegs = allocableRegs;
+      allocableRegs &= ~(map->_inRegs.get(C) | map->_outRegs.get(C) | map->_clobberedRegs.get(C));
 
-        didWork = true;
-        continue;
-      }
-      else {
-        _context->alloc<C>(aVd, bIndex);
+      if (allocableRegs == 0)
+        break;
+    }
+  }
 
-        aVa->orFlags(kVarAttrAllocRDone);
-        addVaDone(C);
+_UseSafeRegs:
+  return safeRegs;
+}
 
-        didWork = true;
-        continue;
-      }
-    }
-  } while (didWork);
+template<int C>
+ASMJIT_INLINE uint32_t X86CallAlloc::guessSpill(VarData* vd, uint32_t allocableRegs) {
+  ASMJIT_ASSERT(allocableRegs != 0);
 
-  // Alloc 'out' regs.
-  for (i = 0; i < count; i++) {
-    VarAttr* va = &list[i];
-    VarData* vd = va->getVd();
+  return 0;
+}
 
-    if ((va->getFlags() & (kVarAttrXReg | kVarAttrAllocWDone)) != kVarAttrWReg)
-      continue;
+// ============================================================================
+// [asmjit::X86CallAlloc - Save]
+// ============================================================================
 
-    uint32_t regIndex = va->getOutRegIndex();
-    ASMJIT_ASSERT(regIndex != kInvalidReg);
+template<int C>
+ASMJIT_INLINE void X86CallAlloc::save() {
+  X86VarState* state = getState();
+  VarData** sVars = state->getListByClass(C);
 
-    if (vd->getRegIndex() != regIndex) {
-      ASMJIT_ASSERT(getState()->getListByClass(C)[regIndex] == nullptr);
-      _context->attach<C>(vd, regIndex, false);
-    }
+  uint32_t i;
+  uint32_t affected = _map->_clobberedRegs.get(C) & state->_occupied.get(C) & state->_modified.get(C);
 
-    va->orFlags(kVarAttrAllocWDone);
-    addVaDone(C);
+  for (i = 0; affected != 0; i++, affected >>= 1) {
+    if (affected & 0x1) {
+      VarData* vd = sVars[i];
+      ASMJIT_ASSERT(vd != nullptr);
+      ASMJIT_ASSERT(vd->isModified());
+
+      VarAttr* va = vd->getVa();
+      if (va == nullptr || (va->getFlags() & (kVarAttrWReg | kVarAttrUnuse)) == 0) {
+        _context->save<C>(vd);
+      }
+    }
   }
 }
 
 // ============================================================================
-// [asmjit::X86VarAlloc - GuessAlloc / GuessSpill]
+// [asmjit::X86CallAlloc - Clobber]
 // ============================================================================
 
-#if 0
-// TODO: This works, but should be improved a bit. The idea is to follow code
-// flow and to restrict the possible registers where to allocate as much as
-// possible so we won't allocate to a register which is home of some variable
-// that's gonna be used together with `vd`. The previous implementation didn't
-// care about it and produced suboptimal results even in code which didn't
-// require any allocs & spills.
-enum { kMaxGuessFlow = 10 };
+template<int C>
+ASMJIT_INLINE void X86CallAlloc::clobber() {
+  X86VarState* state = getState();
+  VarData** sVars = state->getListByClass(C);
 
-struct GuessFlowData {
-  ASMJIT_INLINE void init(HLNode* node, uint32_t counter, uint32_t safeRegs) {
-    _node = node;
-    _counter = counter;
-    _safeRegs = safeRegs;
-  }
+  uint32_t i;
+  uint32_t affected = _map->_clobberedRegs.get(C) & state->_occupied.get(C);
 
-  //! Node to start.
-  HLNode* _node;
-  //! Number of instructions processed from the beginning.
-  uint32_t _counter;
-  //! Safe registers, which can be used for the allocation.
-  uint32_t _safeRegs;
-};
+  for (i = 0; affected != 0; i++, affected >>= 1) {
+    if (affected & 0x1) {
+      VarData* vd = sVars[i];
+      ASMJIT_ASSERT(vd != nullptr);
 
-template<int C>
-ASMJIT_INLINE uint32_t X86VarAlloc::guessAlloc(VarData* vd, uint32_t allocableRegs) {
-  ASMJIT_TLOG("[RA-GUESS] === %s (Input=%08X) ===\n", vd->getName(), allocableRegs);
-  ASMJIT_ASSERT(allocableRegs != 0);
+      VarAttr* va = vd->getVa();
+      uint32_t vdState = kVarStateNone;
 
-  return allocableRegs;
+      if (!vd->isModified() || (va != nullptr && (va->getFlags() & (kVarAttrWAll | kVarAttrUnuse)) != 0)) {
+        vdState = kVarStateMem;
+      }
 
-  // Stop now if there is only one bit (register) set in `allocableRegs` mask.
-  uint32_t safeRegs = allocableRegs;
-  if (Utils::isPowerOf2(safeRegs))
-    return safeRegs;
+      _context->unuse<C>(vd, vdState);
+    }
+  }
+}
 
-  uint32_t counter = 0;
-  uint32_t maxInst = _compiler->getMaxLookAhead();
+// ============================================================================
+// [asmjit::X86CallAlloc - Ret]
+// ============================================================================
 
-  uint32_t localId = vd->getLocalId();
-  uint32_t localToken = _compiler->_generateUniqueToken();
+ASMJIT_INLINE void X86CallAlloc::ret() {
+  X86CallNode* node = getNode();
+  X86FuncDecl* decl = node->getDecl();
 
-  uint32_t gfIndex = 0;
-  GuessFlowData gfArray[kMaxGuessFlow];
+  uint32_t i;
+  Operand* rets = node->_ret;
 
-  HLNode* node = _node;
+  for (i = 0; i < 2; i++) {
+    const FuncInOut& ret = decl->getRet(i);
+    Operand* op = &rets[i];
 
-  // Mark this node and also exit node, it will terminate the loop if encountered.
-  node->setTokenId(localToken);
-  _context->getFunc()->getExitNode()->setTokenId(localToken);
+    if (!ret.hasRegIndex() || !op->isVar())
+      continue;
 
-  // TODO: I don't like this jump, maybe some refactor would help to eliminate it.
-  goto _Advance;
+    VarData* vd = _compiler->getVdById(op->getId());
+    uint32_t vf = _x86VarInfo[vd->getType()].getFlags();
+    uint32_t regIndex = ret.getRegIndex();
 
-  // Look ahead and calculate mask of special registers on both - input/output.
-  for (;;) {
-    do {
-      ASMJIT_TSEC({
-        _context->_traceNode(_context, node, "  ");
-      });
+    switch (vd->getClass()) {
+      case kX86RegClassGp:
+        ASMJIT_ASSERT(x86VarTypeToClass(ret.getVarType()) == vd->getClass());
 
-      // Terminate if we have seen this node already.
-      if (node->hasTokenId(localToken))
+        _context->unuse<kX86RegClassGp>(vd);
+        _context->attach<kX86RegClassGp>(vd, regIndex, true);
         break;
 
-      node->setTokenId(localToken);
-      counter++;
+      case kX86RegClassMm:
+        ASMJIT_ASSERT(x86VarTypeToClass(ret.getVarType()) == vd->getClass());
 
-      // Terminate if the variable is dead here.
-      if (node->hasLiveness() && !node->getLiveness()->getBit(localId)) {
-        ASMJIT_TLOG("[RA-GUESS] %s (Terminating, Not alive here)\n", vd->getName());
+        _context->unuse<kX86RegClassMm>(vd);
+        _context->attach<kX86RegClassMm>(vd, regIndex, true);
         break;
-      }
-
-      if (node->hasState()) {
-        // If this node contains a state, we have to consider only the state
-        // and then we can terminate safely - this happens if we jumped to a
-        // label that is backward (i.e. start of the loop). If we survived
-        // the liveness check it means that the variable is actually used.
-        X86VarState* state = node->getState<X86VarState>();
-        uint32_t homeRegs = 0;
-        uint32_t tempRegs = 0;
 
-        VarData** vdArray = state->getListByClass(C);
-        uint32_t vdCount = _compiler->getRegCount().get(C);
-
-        for (uint32_t vdIndex = 0; vdIndex < vdCount; vdIndex++) {
-          if (vdArray[vdIndex] != nullptr)
-            tempRegs |= Utils::mask(vdIndex);
+      case kX86RegClassXyz:
+        if (ret.getVarType() == kVarTypeFp32 || ret.getVarType() == kVarTypeFp64) {
+          X86Mem m = _context->getVarMem(vd);
+          m.setSize(
+            (vf & VarInfo::kFlagSP) ? 4 :
+            (vf & VarInfo::kFlagDP) ? 8 :
+            (ret.getVarType() == kVarTypeFp32) ? 4 : 8);
 
-          if (vdArray[vdIndex] == vd)
-            homeRegs = Utils::mask(vdIndex);
+          _context->unuse<kX86RegClassXyz>(vd, kVarStateMem);
+          _compiler->fstp(m);
         }
+        else {
+          ASMJIT_ASSERT(x86VarTypeToClass(ret.getVarType()) == vd->getClass());
 
-        tempRegs = safeRegs & ~tempRegs;
-        if (!tempRegs)
-          goto _Done;
-        safeRegs = tempRegs;
-
-        tempRegs = safeRegs & homeRegs;
-        if (!tempRegs)
-          goto _Done;
-        safeRegs = tempRegs;
-
-        goto _Done;
-      }
-      else {
-        // Process the current node if it has any variables associated in.
-        X86VarMap* map = node->getMap<X86VarMap>();
-        if (map != nullptr) {
-          VarAttr* vaList = map->getVaListByClass(C);
-          uint32_t vaCount = map->getVaCountByClass(C);
-
-          uint32_t homeRegs = 0;
-          uint32_t tempRegs = safeRegs;
-          bool found = false;
-
-          for (uint32_t vaIndex = 0; vaIndex < vaCount; vaIndex++) {
-            VarAttr* va = &vaList[vaIndex];
+          _context->unuse<kX86RegClassXyz>(vd);
+          _context->attach<kX86RegClassXyz>(vd, regIndex, true);
+        }
+        break;
+    }
+  }
+}
 
-            if (va->getVd() == vd) {
-              found = true;
+// ============================================================================
+// [asmjit::X86Context - TranslateOperands]
+// ============================================================================
 
-              // Terminate if the variable is overwritten here.
-              if (!(va->getFlags() & kVarAttrRAll))
-                goto _Done;
+//! \internal
+static Error X86Context_translateOperands(X86Context* self, Operand* opList, uint32_t opCount) {
+  X86Compiler* compiler = self->getCompiler();
+  uint32_t hasGpdBase = compiler->getRegSize() == 4;
 
-              uint32_t mask = va->getAllocableRegs();
-              if (mask != 0) {
-                tempRegs &= mask;
-                if (!tempRegs)
-                  goto _Done;
-                safeRegs = tempRegs;
-              }
+  // Translate variables into registers.
+  for (uint32_t i = 0; i < opCount; i++) {
+    Operand* op = &opList[i];
 
-              mask = va->getInRegs();
-              if (mask != 0) {
-                tempRegs &= mask;
-                if (!tempRegs)
-                  goto _Done;
+    if (op->isVar()) {
+      VarData* vd = compiler->getVdById(op->getId());
+      ASMJIT_ASSERT(vd != nullptr);
+      ASMJIT_ASSERT(vd->getRegIndex() != kInvalidReg);
 
-                safeRegs = tempRegs;
-                goto _Done;
-              }
-            }
-            else {
-              // It happens often that one variable is used across many blocks of
-              // assembly code. It can sometimes cause one variable to be allocated
-              // in a different register, which can cause state switch to generate
-              // moves in case of jumps and state intersections. We try to prevent
-              // this case by also considering variables' home registers.
-              homeRegs |= va->getVd()->getHomeMask();
-            }
-          }
+      op->_vreg.op = Operand::kTypeReg;
+      op->_vreg.index = vd->getRegIndex();
+    }
+    else if (op->isMem()) {
+      X86Mem* m = static_cast<X86Mem*>(op);
 
-          tempRegs &= ~(map->_outRegs.get(C) | map->_clobberedRegs.get(C));
-          if (!found)
-            tempRegs &= ~map->_inRegs.get(C);
+      if (m->isBaseIndexType() && OperandUtil::isVarId(m->getBase())) {
+        VarData* vd = compiler->getVdById(m->getBase());
 
-          if (!tempRegs)
-            goto _Done;
-          safeRegs = tempRegs;
+        if (m->getMemType() == kMemTypeBaseIndex) {
+          ASMJIT_ASSERT(vd->getRegIndex() != kInvalidReg);
+          op->_vmem.base = vd->getRegIndex();
+        }
+        else {
+          if (!vd->isMemArg())
+            self->getVarCell(vd);
 
-          if (homeRegs) {
-            tempRegs = safeRegs & ~homeRegs;
-            if (!tempRegs)
-              goto _Done;
-            safeRegs = tempRegs;
-          }
+          // Offset will be patched later by X86Context_patchFuncMem().
+          m->setGpdBase(hasGpdBase);
+          m->adjust(vd->isMemArg() ? self->_argActualDisp : self->_varActualDisp);
         }
       }
 
-_Advance:
-      // Terminate if this is a return node.
-      if (node->hasFlag(HLNode::kFlagIsRet))
-        goto _Done;
-
-      // Advance on non-conditional jump.
-      if (node->hasFlag(HLNode::kFlagIsJmp)) {
-        // Stop on a jump that is not followed.
-        node = static_cast<HLJump*>(node)->getTarget();
-        if (node == nullptr)
-          break;
-        continue;
+      if (OperandUtil::isVarId(m->getIndex())) {
+        VarData* vd = compiler->getVdById(m->getIndex());
+        ASMJIT_ASSERT(vd->getRegIndex() != kInvalidReg);
+        ASMJIT_ASSERT(vd->getRegIndex() != kX86RegIndexR12);
+        op->_vmem.index = vd->getRegIndex();
       }
+    }
+  }
 
-      // Split flow on a conditional jump.
-      if (node->hasFlag(HLNode::kFlagIsJcc)) {
-        // Put the next node on the stack and follow the target if possible.
-        HLNode* next = node->getNext();
-        if (next != nullptr && gfIndex < kMaxGuessFlow)
-          gfArray[gfIndex++].init(next, counter, safeRegs);
+  return kErrorOk;
+}
 
-        node = static_cast<HLJump*>(node)->getTarget();
-        if (node == nullptr)
-          break;
-        continue;
-      }
+// ============================================================================
+// [asmjit::X86Context - TranslatePrologEpilog]
+// ============================================================================
 
-      node = node->getNext();
-      ASMJIT_ASSERT(node != nullptr);
-    } while (counter < maxInst);
+//! \internal
+static Error X86Context_initFunc(X86Context* self, X86FuncNode* func) {
+  X86Compiler* compiler = self->getCompiler();
+  X86FuncDecl* decl = func->getDecl();
 
-_Done:
-    for (;;) {
-      if (gfIndex == 0)
-        goto _Ret;
+  X86RegMask& clobberedRegs = self->_clobberedRegs;
+  uint32_t regSize = compiler->getRegSize();
 
-      GuessFlowData* data = &gfArray[--gfIndex];
-      node = data->_node;
-      counter = data->_counter;
+  // Setup "Save-Restore" registers.
+  func->_saveRestoreRegs.set(kX86RegClassGp , clobberedRegs.get(kX86RegClassGp ) & decl->getPreserved(kX86RegClassGp ));
+  func->_saveRestoreRegs.set(kX86RegClassMm , clobberedRegs.get(kX86RegClassMm ) & decl->getPreserved(kX86RegClassMm ));
+  func->_saveRestoreRegs.set(kX86RegClassK  , 0);
+  func->_saveRestoreRegs.set(kX86RegClassXyz, clobberedRegs.get(kX86RegClassXyz) & decl->getPreserved(kX86RegClassXyz));
 
-      uint32_t tempRegs = safeRegs & data->_safeRegs;
-      if (!tempRegs)
-        continue;
+  ASMJIT_ASSERT(!func->_saveRestoreRegs.has(kX86RegClassGp, Utils::mask(kX86RegIndexSp)));
 
-      safeRegs = tempRegs;
-      break;
+  // Setup required stack alignment and kFuncFlagIsStackMisaligned.
+  {
+    uint32_t requiredStackAlignment = Utils::iMax(self->_memMaxAlign, self->getRegSize());
+
+    if (requiredStackAlignment < 16) {
+      // Require 16-byte alignment if 8-byte vars are used.
+      if (self->_mem8ByteVarsUsed)
+        requiredStackAlignment = 16;
+      else if (func->_saveRestoreRegs.get(kX86RegClassMm) || func->_saveRestoreRegs.get(kX86RegClassXyz))
+        requiredStackAlignment = 16;
+      else if (Utils::inInterval<uint32_t>(func->getRequiredStackAlignment(), 8, 16))
+        requiredStackAlignment = 16;
     }
-  }
 
-_Ret:
-  ASMJIT_TLOG("[RA-GUESS] === %s (Output=%08X) ===\n", vd->getName(), safeRegs);
-  return safeRegs;
-}
-#endif
+    if (func->getRequiredStackAlignment() < requiredStackAlignment)
+      func->setRequiredStackAlignment(requiredStackAlignment);
 
-template<int C>
-ASMJIT_INLINE uint32_t X86VarAlloc::guessAlloc(VarData* vd, uint32_t allocableRegs) {
-  ASMJIT_ASSERT(allocableRegs != 0);
+    func->updateRequiredStackAlignment();
+  }
 
-  // Stop now if there is only one bit (register) set in `allocableRegs` mask.
-  if (Utils::isPowerOf2(allocableRegs))
-    return allocableRegs;
+  // Adjust stack pointer if function is caller.
+  if (func->isCaller()) {
+    func->addFuncFlags(kFuncFlagIsStackAdjusted);
+    func->_callStackSize = Utils::alignTo<uint32_t>(func->getCallStackSize(), func->getRequiredStackAlignment());
+  }
 
-  uint32_t localId = vd->getLocalId();
-  uint32_t safeRegs = allocableRegs;
+  // Adjust stack pointer if manual stack alignment is needed.
+  if (func->isStackMisaligned() && func->isNaked()) {
+    // Get a memory cell where the original stack frame will be stored.
+    VarCell* cell = self->_newStackCell(regSize, regSize);
+    if (cell == nullptr)
+      return self->getLastError(); // The error has already been set.
 
-  uint32_t i;
-  uint32_t maxLookAhead = _compiler->getMaxLookAhead();
+    func->addFuncFlags(kFuncFlagIsStackAdjusted);
+    self->_stackFrameCell = cell;
 
-  // Look ahead and calculate mask of special registers on both - input/output.
-  HLNode* node = _node;
-  for (i = 0; i < maxLookAhead; i++) {
-    BitArray* liveness = node->getLiveness();
+    if (decl->getArgStackSize() > 0) {
+      func->addFuncFlags(kFuncFlagX86MoveArgs);
+      func->setExtraStackSize(decl->getArgStackSize());
+    }
 
-    // If the variable becomes dead it doesn't make sense to continue.
-    if (liveness != nullptr && !liveness->getBit(localId))
-      break;
+    // Get temporary register which will be used to align the stack frame.
+    uint32_t fRegMask = Utils::bits(self->_regCount.getGp());
+    uint32_t stackFrameCopyRegs;
 
-    // Stop on `HLSentinel` and `HLRet`.
-    if (node->hasFlag(HLNode::kFlagIsRet))
-      break;
+    fRegMask &= ~(decl->getUsed(kX86RegClassGp) | Utils::mask(kX86RegIndexSp));
+    stackFrameCopyRegs = fRegMask;
 
-    // Stop on conditional jump, we don't follow them.
-    if (node->hasFlag(HLNode::kFlagIsJcc))
-      break;
+    // Try to remove modified registers from the mask.
+    uint32_t tRegMask = fRegMask & ~self->getClobberedRegs(kX86RegClassGp);
+    if (tRegMask != 0)
+      fRegMask = tRegMask;
 
-    // Advance on non-conditional jump.
-    if (node->hasFlag(HLNode::kFlagIsJmp)) {
-      node = static_cast<HLJump*>(node)->getTarget();
-      // Stop on jump that is not followed.
-      if (node == nullptr)
-        break;
-    }
+    // Try to remove preserved registers from the mask.
+    tRegMask = fRegMask & ~decl->getPreserved(kX86RegClassGp);
+    if (tRegMask != 0)
+      fRegMask = tRegMask;
 
-    node = node->getNext();
-    ASMJIT_ASSERT(node != nullptr);
+    ASMJIT_ASSERT(fRegMask != 0);
 
-    X86VarMap* map = node->getMap<X86VarMap>();
-    if (map != nullptr) {
-      VarAttr* va = map->findVaByClass(C, vd);
-      uint32_t mask;
+    uint32_t fRegIndex = Utils::findFirstBit(fRegMask);
+    func->_stackFrameRegIndex = static_cast<uint8_t>(fRegIndex);
 
-      if (va != nullptr) {
-        // If the variable is overwritten it doesn't mase sense to continue.
-        if (!(va->getFlags() & kVarAttrRAll))
-          break;
+    // We have to save the register on the stack (it will be the part of prolog
+    // and epilog), however we shouldn't save it twice, so we will remove it
+    // from '_saveRestoreRegs' in case that it is preserved.
+    fRegMask = Utils::mask(fRegIndex);
+    if ((fRegMask & decl->getPreserved(kX86RegClassGp)) != 0) {
+      func->_saveRestoreRegs.andNot(kX86RegClassGp, fRegMask);
+      func->_isStackFrameRegPreserved = true;
+    }
 
-        mask = va->getAllocableRegs();
-        if (mask != 0) {
-          allocableRegs &= mask;
-          if (allocableRegs == 0)
-            break;
-          safeRegs = allocableRegs;
-        }
+    if (func->hasFuncFlag(kFuncFlagX86MoveArgs)) {
+      uint32_t maxRegs = (func->getArgStackSize() + regSize - 1) / regSize;
+      stackFrameCopyRegs &= ~fRegMask;
 
-        mask = va->getInRegs();
-        if (mask != 0) {
-          allocableRegs &= mask;
-          if (allocableRegs == 0)
-            break;
-          safeRegs = allocableRegs;
-          break;
-        }
+      tRegMask = stackFrameCopyRegs & self->getClobberedRegs(kX86RegClassGp);
+      uint32_t tRegCnt = Utils::bitCount(tRegMask);
 
-        allocableRegs &= ~(map->_outRegs.get(C) | map->_clobberedRegs.get(C));
-        if (allocableRegs == 0)
-          break;
-      }
-      else {
-        allocableRegs &= ~(map->_inRegs.get(C) | map->_outRegs.get(C) | map->_clobberedRegs.get(C));
-        if (allocableRegs == 0)
-          break;
-      }
+      if (tRegCnt > 1 || (tRegCnt > 0 && tRegCnt <= maxRegs))
+        stackFrameCopyRegs = tRegMask;
+      else
+        stackFrameCopyRegs = Utils::keepNOnesFromRight(stackFrameCopyRegs, Utils::iMin<uint32_t>(maxRegs, 2));
 
-      safeRegs = allocableRegs;
+      func->_saveRestoreRegs.or_(kX86RegClassGp, stackFrameCopyRegs & decl->getPreserved(kX86RegClassGp));
+      Utils::indexNOnesFromRight(func->_stackFrameCopyGpIndex, stackFrameCopyRegs, maxRegs);
     }
   }
+  // If function is not naked we generate standard "EBP/RBP" stack frame.
+  else if (!func->isNaked()) {
+    uint32_t fRegIndex = kX86RegIndexBp;
 
-  return safeRegs;
-}
-
-template<int C>
-ASMJIT_INLINE uint32_t X86VarAlloc::guessSpill(VarData* vd, uint32_t allocableRegs) {
-  ASMJIT_ASSERT(allocableRegs != 0);
-
-  return 0;
-}
-
-// ============================================================================
-// [asmjit::X86VarAlloc - Modified]
-// ============================================================================
+    func->_stackFrameRegIndex = static_cast<uint8_t>(fRegIndex);
+    func->_isStackFrameRegPreserved = true;
+  }
 
-template<int C>
-ASMJIT_INLINE void X86VarAlloc::modified() {
-  VarAttr* list = getVaListByClass(C);
-  uint32_t count = getVaCountByClass(C);
+  ASMJIT_PROPAGATE_ERROR(self->resolveCellOffsets());
 
-  for (uint32_t i = 0; i < count; i++) {
-    VarAttr* va = &list[i];
+  // Adjust stack pointer if requested memory can't fit into "Red Zone" or "Spill Zone".
+  if (self->_memAllTotal > Utils::iMax<uint32_t>(func->getRedZoneSize(), func->getSpillZoneSize())) {
+    func->addFuncFlags(kFuncFlagIsStackAdjusted);
+  }
 
-    if (va->hasFlag(kVarAttrWReg)) {
-      VarData* vd = va->getVd();
+  // Setup stack size used to save preserved registers.
+  {
+    uint32_t memGpSize  = Utils::bitCount(func->_saveRestoreRegs.get(kX86RegClassGp )) * regSize;
+    uint32_t memMmSize  = Utils::bitCount(func->_saveRestoreRegs.get(kX86RegClassMm )) * 8;
+    uint32_t memXmmSize = Utils::bitCount(func->_saveRestoreRegs.get(kX86RegClassXyz)) * 16;
 
-      uint32_t regIndex = vd->getRegIndex();
-      uint32_t regMask = Utils::mask(regIndex);
+    func->_pushPopStackSize = memGpSize;
+    func->_moveStackSize = memXmmSize + Utils::alignTo<uint32_t>(memMmSize, 16);
+  }
 
-      vd->setModified(true);
-      _context->_x86State._modified.or_(C, regMask);
-    }
+  // Setup adjusted stack size.
+  if (func->isStackMisaligned()) {
+    func->_alignStackSize = 0;
   }
-}
+  else {
+    // If function is aligned, the RETURN address is stored in the aligned
+    // [ZSP - PtrSize] which makes current ZSP unaligned.
+    int32_t v = static_cast<int32_t>(regSize);
 
-// ============================================================================
-// [asmjit::X86CallAlloc]
-// ============================================================================
+    // If we have to store function frame pointer we have to count it as well,
+    // because it is the first thing pushed on the stack.
+    if (func->hasStackFrameReg() && func->isStackFrameRegPreserved())
+      v += regSize;
 
-//! \internal
-//!
-//! Register allocator context (function call).
-struct X86CallAlloc : public X86BaseAlloc {
-  // --------------------------------------------------------------------------
-  // [Construction / Destruction]
-  // --------------------------------------------------------------------------
+    // Count push/pop sequence.
+    v += func->getPushPopStackSize();
+
+    // Count save/restore sequence for XMM registers (should be already aligned).
+    v += func->getMoveStackSize();
 
-  ASMJIT_INLINE X86CallAlloc(X86Context* context) : X86BaseAlloc(context) {}
-  ASMJIT_INLINE ~X86CallAlloc() {}
+    // Maximum memory required to call all functions within this function.
+    v += func->getCallStackSize();
 
-  // --------------------------------------------------------------------------
-  // [Accessors]
-  // --------------------------------------------------------------------------
+    // Calculate the final offset to keep stack alignment.
+    func->_alignStackSize = Utils::alignDiff<uint32_t>(v, func->getRequiredStackAlignment());
+  }
 
-  //! Get the node.
-  ASMJIT_INLINE X86CallNode* getNode() const { return static_cast<X86CallNode*>(_node); }
+  // Memory stack size.
+  func->_memStackSize = self->_memAllTotal;
+  func->_alignedMemStackSize = Utils::alignTo<uint32_t>(func->_memStackSize, func->getRequiredStackAlignment());
 
-  // --------------------------------------------------------------------------
-  // [Run]
-  // --------------------------------------------------------------------------
+  if (func->isNaked()) {
+    self->_argBaseReg = kX86RegIndexSp;
 
-  ASMJIT_INLINE Error run(X86CallNode* node);
+    if (func->isStackAdjusted()) {
+      if (func->isStackMisaligned()) {
+        self->_argBaseOffset = static_cast<int32_t>(
+          func->getCallStackSize() +
+          func->getAlignedMemStackSize() +
+          func->getMoveStackSize() +
+          func->getAlignStackSize());
+        self->_argBaseOffset -= regSize;
+      }
+      else {
+        self->_argBaseOffset = static_cast<int32_t>(
+          func->getCallStackSize() +
+          func->getAlignedMemStackSize() +
+          func->getMoveStackSize() +
+          func->getPushPopStackSize() +
+          func->getExtraStackSize() +
+          func->getAlignStackSize());
+      }
+    }
+    else {
+      self->_argBaseOffset = func->getPushPopStackSize();
+    }
+  }
+  else {
+    self->_argBaseReg = kX86RegIndexBp;
+    // Caused by "push zbp".
+    self->_argBaseOffset = regSize;
+  }
 
-  // --------------------------------------------------------------------------
-  // [Init / Cleanup]
-  // --------------------------------------------------------------------------
+  self->_varBaseReg = kX86RegIndexSp;
+  self->_varBaseOffset = func->getCallStackSize();
 
-protected:
-  // Just to prevent calling these methods from X86Context::translate().
-  ASMJIT_INLINE void init(X86CallNode* node, X86VarMap* map);
-  ASMJIT_INLINE void cleanup();
+  if (!func->isStackAdjusted()) {
+    self->_varBaseOffset = -static_cast<int32_t>(
+      func->_alignStackSize +
+      func->_alignedMemStackSize +
+      func->_moveStackSize);
+  }
 
-  // --------------------------------------------------------------------------
-  // [Plan / Alloc / Spill / Move]
-  // --------------------------------------------------------------------------
+  return kErrorOk;
+}
 
-  template<int C>
-  ASMJIT_INLINE void plan();
+//! \internal
+static Error X86Context_patchFuncMem(X86Context* self, X86FuncNode* func, HLNode* stop) {
+  X86Compiler* compiler = self->getCompiler();
+  HLNode* node = func;
 
-  template<int C>
-  ASMJIT_INLINE void spill();
+  do {
+    if (node->getType() == HLNode::kTypeInst) {
+      HLInst* iNode = static_cast<HLInst*>(node);
 
-  template<int C>
-  ASMJIT_INLINE void alloc();
+      if (iNode->hasMemOp()) {
+        X86Mem* m = iNode->getMemOp<X86Mem>();
 
-  // --------------------------------------------------------------------------
-  // [AllocImmsOnStack]
-  // --------------------------------------------------------------------------
+        if (m->getMemType() == kMemTypeStackIndex && OperandUtil::isVarId(m->getBase())) {
+          VarData* vd = compiler->getVdById(m->getBase());
+          ASMJIT_ASSERT(vd != nullptr);
 
-  ASMJIT_INLINE void allocImmsOnStack();
+          if (vd->isMemArg()) {
+            m->_vmem.base = self->_argBaseReg;
+            m->_vmem.displacement += self->_argBaseOffset + vd->getMemOffset();
+          }
+          else {
+            VarCell* cell = vd->getMemCell();
+            ASMJIT_ASSERT(cell != nullptr);
 
-  // --------------------------------------------------------------------------
-  // [Duplicate]
-  // --------------------------------------------------------------------------
+            m->_vmem.base = self->_varBaseReg;
+            m->_vmem.displacement += self->_varBaseOffset + cell->getOffset();
+          }
+        }
+      }
+    }
 
-  template<int C>
-  ASMJIT_INLINE void duplicate();
+    node = node->getNext();
+  } while (node != stop);
 
-  // --------------------------------------------------------------------------
-  // [GuessAlloc / GuessSpill]
-  // --------------------------------------------------------------------------
+  return kErrorOk;
+}
 
-  template<int C>
-  ASMJIT_INLINE uint32_t guessAlloc(VarData* vd, uint32_t allocableRegs);
+//! \internal
+static Error X86Context_translatePrologEpilog(X86Context* self, X86FuncNode* func) {
+  X86Compiler* compiler = self->getCompiler();
+  X86FuncDecl* decl = func->getDecl();
 
-  template<int C>
-  ASMJIT_INLINE uint32_t guessSpill(VarData* vd, uint32_t allocableRegs);
+  uint32_t regSize = compiler->getRegSize();
 
-  // --------------------------------------------------------------------------
-  // [Save]
-  // --------------------------------------------------------------------------
+  int32_t stackSize = static_cast<int32_t>(
+    func->getAlignStackSize() +
+    func->getCallStackSize() +
+    func->getAlignedMemStackSize() +
+    func->getMoveStackSize() +
+    func->getExtraStackSize());
+  int32_t stackAlignment = func->getRequiredStackAlignment();
 
-  template<int C>
-  ASMJIT_INLINE void save();
+  int32_t stackBase;
+  int32_t stackPtr;
 
-  // --------------------------------------------------------------------------
-  // [Clobber]
-  // --------------------------------------------------------------------------
+  if (func->isStackAdjusted()) {
+    stackBase = static_cast<int32_t>(
+      func->getCallStackSize() +
+      func->getAlignedMemStackSize());
+  }
+  else {
+    stackBase = -static_cast<int32_t>(
+      func->getAlignedMemStackSize() +
+      func->getAlignStackSize() +
+      func->getExtraStackSize());
+  }
 
-  template<int C>
-  ASMJIT_INLINE void clobber();
+  uint32_t i, mask;
+  uint32_t regsGp  = func->getSaveRestoreRegs(kX86RegClassGp );
+  uint32_t regsMm  = func->getSaveRestoreRegs(kX86RegClassMm );
+  uint32_t regsXmm = func->getSaveRestoreRegs(kX86RegClassXyz);
 
-  // --------------------------------------------------------------------------
-  // [Ret]
-  // --------------------------------------------------------------------------
+  bool earlyPushPop = false;
+  bool useLeaEpilog = false;
 
-  ASMJIT_INLINE void ret();
+  X86GpReg gpReg(self->_zsp);
+  X86GpReg fpReg(self->_zbp);
+
+  X86Mem fpOffset;
 
   // --------------------------------------------------------------------------
-  // [Members]
+  // [Prolog]
   // --------------------------------------------------------------------------
 
-  //! Will alloc to these registers.
-  X86RegMask _willAlloc;
-  //! Will spill these registers.
-  X86RegMask _willSpill;
-};
+  compiler->_setCursor(func->getEntryNode());
 
-// ============================================================================
-// [asmjit::X86CallAlloc - Run]
-// ============================================================================
+  // Entry.
+  if (func->isNaked()) {
+    if (func->isStackMisaligned()) {
+      fpReg.setIndex(func->getStackFrameRegIndex());
+      fpOffset = x86::ptr(self->_zsp, self->_varBaseOffset + static_cast<int32_t>(self->_stackFrameCell->getOffset()));
 
-ASMJIT_INLINE Error X86CallAlloc::run(X86CallNode* node) {
-  // Initialize.
-  X86VarMap* map = node->getMap<X86VarMap>();
-  if (map == nullptr)
-    return kErrorOk;
+      earlyPushPop = true;
+      self->emitPushSequence(regsGp);
 
-  // Initialize the allocator; prepare basics and connect Vd->Va.
-  init(node, map);
+      if (func->isStackFrameRegPreserved())
+        compiler->emit(kX86InstIdPush, fpReg);
 
-  // Plan register allocation. Planner is only able to assign one register per
-  // variable. If any variable is used multiple times it will be handled later.
-  plan<kX86RegClassGp >();
-  plan<kX86RegClassMm >();
-  plan<kX86RegClassXyz>();
+      compiler->emit(kX86InstIdMov, fpReg, self->_zsp);
+    }
+  }
+  else {
+    compiler->emit(kX86InstIdPush, fpReg);
+    compiler->emit(kX86InstIdMov, fpReg, self->_zsp);
+  }
 
-  // Spill.
-  spill<kX86RegClassGp >();
-  spill<kX86RegClassMm >();
-  spill<kX86RegClassXyz>();
+  if (!earlyPushPop) {
+    self->emitPushSequence(regsGp);
+    if (func->isStackMisaligned() && regsGp != 0)
+      useLeaEpilog = true;
+  }
 
-  // Alloc.
-  alloc<kX86RegClassGp >();
-  alloc<kX86RegClassMm >();
-  alloc<kX86RegClassXyz>();
+  // Adjust stack pointer.
+  if (func->isStackAdjusted()) {
+    stackBase = static_cast<int32_t>(func->getAlignedMemStackSize() + func->getCallStackSize());
 
-  // Unuse clobbered registers that are not used to pass function arguments and
-  // save variables used to pass function arguments that will be reused later on.
-  save<kX86RegClassGp >();
-  save<kX86RegClassMm >();
-  save<kX86RegClassXyz>();
+    if (stackSize)
+      compiler->emit(kX86InstIdSub, self->_zsp, stackSize);
 
-  // Allocate immediates in registers and on the stack.
-  allocImmsOnStack();
+    if (func->isStackMisaligned())
+      compiler->emit(kX86InstIdAnd, self->_zsp, -stackAlignment);
 
-  // Duplicate.
-  duplicate<kX86RegClassGp >();
-  duplicate<kX86RegClassMm >();
-  duplicate<kX86RegClassXyz>();
+    if (func->isStackMisaligned() && func->isNaked())
+      compiler->emit(kX86InstIdMov, fpOffset, fpReg);
+  }
+  else {
+    stackBase = -static_cast<int32_t>(func->getAlignStackSize() + func->getMoveStackSize());
+  }
+
+  // Save XMM/MMX/GP (Mov).
+  stackPtr = stackBase;
+  for (i = 0, mask = regsXmm; mask != 0; i++, mask >>= 1) {
+    if (mask & 0x1) {
+      compiler->emit(kX86InstIdMovaps, x86::oword_ptr(self->_zsp, stackPtr), x86::xmm(i));
+      stackPtr += 16;
+    }
+  }
 
-  // Translate call operand.
-  ASMJIT_PROPAGATE_ERROR(X86Context_translateOperands(_context, &node->_target, 1));
+  for (i = 0, mask = regsMm; mask != 0; i++, mask >>= 1) {
+    if (mask & 0x1) {
+      compiler->emit(kX86InstIdMovq, x86::qword_ptr(self->_zsp, stackPtr), x86::mm(i));
+      stackPtr += 8;
+    }
+  }
 
-  // To emit instructions after call.
-  _compiler->_setCursor(node);
+  // --------------------------------------------------------------------------
+  // [Move-Args]
+  // --------------------------------------------------------------------------
 
-  // If the callee pops stack it has to be manually adjusted back.
-  X86FuncDecl* decl = node->getDecl();
-  if (decl->getCalleePopsStack() && decl->getArgStackSize() != 0) {
-    _compiler->emit(kX86InstIdSub, _context->_zsp, static_cast<int>(decl->getArgStackSize()));
-  }
+  if (func->hasFuncFlag(kFuncFlagX86MoveArgs)) {
+    uint32_t argStackPos = 0;
+    uint32_t argStackSize = decl->getArgStackSize();
 
-  // Clobber.
-  clobber<kX86RegClassGp >();
-  clobber<kX86RegClassMm >();
-  clobber<kX86RegClassXyz>();
+    uint32_t moveIndex = 0;
+    uint32_t moveCount = (argStackSize + regSize - 1) / regSize;
 
-  // Return.
-  ret();
+    X86GpReg r[8];
+    uint32_t numRegs = 0;
 
-  // Unuse.
-  unuseAfter<kX86RegClassGp >();
-  unuseAfter<kX86RegClassMm >();
-  unuseAfter<kX86RegClassXyz>();
+    for (i = 0; i < ASMJIT_ARRAY_SIZE(func->_stackFrameCopyGpIndex); i++)
+      if (func->_stackFrameCopyGpIndex[i] != kInvalidReg)
+        r[numRegs++] = gpReg.setIndex(func->_stackFrameCopyGpIndex[i]);
+    ASMJIT_ASSERT(numRegs > 0);
 
-  // Cleanup; disconnect Vd->Va.
-  cleanup();
+    int32_t dSrc = func->getPushPopStackSize() + regSize;
+    int32_t dDst = func->getAlignStackSize() +
+                   func->getCallStackSize() +
+                   func->getAlignedMemStackSize() +
+                   func->getMoveStackSize();
 
-  return kErrorOk;
-}
+    if (func->isStackFrameRegPreserved())
+      dSrc += regSize;
 
-// ============================================================================
-// [asmjit::X86CallAlloc - Init / Cleanup]
-// ============================================================================
+    X86Mem mSrc = x86::ptr(fpReg, dSrc);
+    X86Mem mDst = x86::ptr(self->_zsp, dDst);
 
-ASMJIT_INLINE void X86CallAlloc::init(X86CallNode* node, X86VarMap* map) {
-  X86BaseAlloc::init(node, map);
+    while (moveIndex < moveCount) {
+      uint32_t numMovs = Utils::iMin<uint32_t>(moveCount - moveIndex, numRegs);
 
-  // Create mask of all registers that will be used to pass function arguments.
-  _willAlloc = node->_usedArgs;
-  _willSpill.reset();
-}
+      for (i = 0; i < numMovs; i++)
+        compiler->emit(kX86InstIdMov, r[i], mSrc.adjusted((moveIndex + i) * regSize));
+      for (i = 0; i < numMovs; i++)
+        compiler->emit(kX86InstIdMov, mDst.adjusted((moveIndex + i) * regSize), r[i]);
 
-ASMJIT_INLINE void X86CallAlloc::cleanup() {
-  X86BaseAlloc::cleanup();
-}
+      argStackPos += numMovs * regSize;
+      moveIndex += numMovs;
+    }
+  }
 
-// ============================================================================
-// [asmjit::X86CallAlloc - Plan / Spill / Alloc]
-// ============================================================================
+  // --------------------------------------------------------------------------
+  // [Epilog]
+  // --------------------------------------------------------------------------
 
-template<int C>
-ASMJIT_INLINE void X86CallAlloc::plan() {
-  uint32_t i;
-  uint32_t clobbered = _map->_clobberedRegs.get(C);
+  compiler->_setCursor(func->getExitNode());
 
-  uint32_t willAlloc = _willAlloc.get(C);
-  uint32_t willFree = clobbered & ~willAlloc;
+  // Restore XMM/MMX/GP (Mov).
+  stackPtr = stackBase;
+  for (i = 0, mask = regsXmm; mask != 0; i++, mask >>= 1) {
+    if (mask & 0x1) {
+      compiler->emit(kX86InstIdMovaps, x86::xmm(i), x86::oword_ptr(self->_zsp, stackPtr));
+      stackPtr += 16;
+    }
+  }
 
-  VarAttr* list = getVaListByClass(C);
-  uint32_t count = getVaCountByClass(C);
+  for (i = 0, mask = regsMm; mask != 0; i++, mask >>= 1) {
+    if (mask & 0x1) {
+      compiler->emit(kX86InstIdMovq, x86::mm(i), x86::qword_ptr(self->_zsp, stackPtr));
+      stackPtr += 8;
+    }
+  }
 
-  X86VarState* state = getState();
+  // Adjust stack.
+  if (useLeaEpilog) {
+    compiler->emit(kX86InstIdLea, self->_zsp, x86::ptr(fpReg, -static_cast<int32_t>(func->getPushPopStackSize())));
+  }
+  else if (!func->isStackMisaligned()) {
+    if (func->isStackAdjusted() && stackSize != 0)
+      compiler->emit(kX86InstIdAdd, self->_zsp, stackSize);
+  }
 
-  // Calculate 'willAlloc' and 'willFree' masks based on mandatory masks.
-  for (i = 0; i < count; i++) {
-    VarAttr* va = &list[i];
-    VarData* vd = va->getVd();
+  // Restore Gp (Push/Pop).
+  if (!earlyPushPop)
+    self->emitPopSequence(regsGp);
 
-    uint32_t vaFlags = va->getFlags();
-    uint32_t regIndex = vd->getRegIndex();
-    uint32_t regMask = (regIndex != kInvalidReg) ? Utils::mask(regIndex) : 0;
+  // Emms.
+  if (func->hasFuncFlag(kFuncFlagX86Emms))
+    compiler->emit(kX86InstIdEmms);
 
-    if ((vaFlags & kVarAttrRReg) != 0) {
-      // Planning register allocation. First check whether the variable is
-      // already allocated in register and if it can stay there. Function
-      // arguments are passed either in a specific register or in stack so
-      // we care mostly of mandatory registers.
-      uint32_t inRegs = va->getInRegs();
+  // MFence/SFence/LFence.
+  if (func->hasFuncFlag(kFuncFlagX86SFence) & func->hasFuncFlag(kFuncFlagX86LFence))
+    compiler->emit(kX86InstIdMfence);
+  else if (func->hasFuncFlag(kFuncFlagX86SFence))
+    compiler->emit(kX86InstIdSfence);
+  else if (func->hasFuncFlag(kFuncFlagX86LFence))
+    compiler->emit(kX86InstIdLfence);
 
-      if (inRegs == 0) {
-        inRegs = va->getAllocableRegs();
-      }
+  // Leave.
+  if (func->isNaked()) {
+    if (func->isStackMisaligned()) {
+      compiler->emit(kX86InstIdMov, self->_zsp, fpOffset);
 
-      // Optimize situation where the variable has to be allocated in a
-      // mandatory register, but it's already allocated in register that
-      // is not clobbered (i.e. it will survive function call).
-      if ((regMask & inRegs) != 0 || ((regMask & ~clobbered) != 0 && (vaFlags & kVarAttrUnuse) == 0)) {
-        va->setInRegIndex(regIndex);
-        va->orFlags(kVarAttrAllocRDone);
-        addVaDone(C);
-      }
-      else {
-        willFree |= regMask;
-      }
+      if (func->isStackFrameRegPreserved())
+        compiler->emit(kX86InstIdPop, fpReg);
+
+      if (earlyPushPop)
+        self->emitPopSequence(regsGp);
+    }
+  }
+  else {
+    if (useLeaEpilog) {
+      compiler->emit(kX86InstIdPop, fpReg);
+    }
+    else if (func->hasFuncFlag(kFuncFlagX86Leave)) {
+      compiler->emit(kX86InstIdLeave);
     }
     else {
-      // Memory access - if variable is allocated it has to be freed.
-      if (regMask != 0) {
-        willFree |= regMask;
-      }
-      else {
-        va->orFlags(kVarAttrAllocRDone);
-        addVaDone(C);
-      }
+      compiler->emit(kX86InstIdMov, self->_zsp, fpReg);
+      compiler->emit(kX86InstIdPop, fpReg);
     }
   }
 
-  // Occupied registers without 'willFree' registers; contains basically
-  // all the registers we can use to allocate variables without inRegs
-  // speficied.
-  uint32_t occupied = state->_occupied.get(C) & ~willFree;
-  uint32_t willSpill = 0;
-
-  // Find the best registers for variables that are not allocated yet. Only
-  // useful for Gp registers used as call operand.
-  for (i = 0; i < count; i++) {
-    VarAttr* va = &list[i];
-    VarData* vd = va->getVd();
-
-    uint32_t vaFlags = va->getFlags();
-    if ((vaFlags & kVarAttrAllocRDone) != 0 || (vaFlags & kVarAttrRReg) == 0)
-      continue;
+  // Emit return.
+  if (decl->getCalleePopsStack())
+    compiler->emit(kX86InstIdRet, static_cast<int32_t>(decl->getArgStackSize()));
+  else
+    compiler->emit(kX86InstIdRet);
 
-    // All registers except Gp used by call itself must have inRegIndex.
-    uint32_t m = va->getInRegs();
-    if (C != kX86RegClassGp || m) {
-      ASMJIT_ASSERT(m != 0);
-      va->setInRegIndex(Utils::findFirstBit(m));
-      willSpill |= occupied & m;
-      continue;
-    }
+  return kErrorOk;
+}
 
-    m = va->getAllocableRegs() & ~(willAlloc ^ m);
-    m = guessAlloc<C>(vd, m);
-    ASMJIT_ASSERT(m != 0);
+// ============================================================================
+// [asmjit::X86Context - Translate - Jump]
+// ============================================================================
 
-    uint32_t candidateRegs = m & ~occupied;
-    if (candidateRegs == 0) {
-      candidateRegs = m & occupied & ~state->_modified.get(C);
-      if (candidateRegs == 0)
-        candidateRegs = m;
-    }
+//! \internal
+static void X86Context_translateJump(X86Context* self, HLJump* jNode, HLLabel* jTarget) {
+  X86Compiler* compiler = self->getCompiler();
+  HLNode* extNode = self->getExtraBlock();
 
-    if (!(vaFlags & (kVarAttrWReg | kVarAttrUnuse)) && (candidateRegs & ~clobbered))
-      candidateRegs &= ~clobbered;
+  compiler->_setCursor(extNode);
+  self->switchState(jTarget->getState());
 
-    uint32_t regIndex = Utils::findFirstBit(candidateRegs);
-    uint32_t regMask = Utils::mask(regIndex);
+  // If one or more instruction has been added during switchState() it will be
+  // moved at the end of the function body.
+  if (compiler->getCursor() != extNode) {
+    // TODO: Can fail.
+    HLLabel* jTrampolineTarget = compiler->newLabelNode();
 
-    va->setInRegIndex(regIndex);
-    va->setInRegs(regMask);
+    // Add the jump to the target.
+    compiler->jmp(jTarget->getLabel());
 
-    willAlloc |= regMask;
-    willSpill |= regMask & occupied;
-    willFree &= ~regMask;
+    // Add the trampoline-label we jump to change the state.
+    extNode = compiler->setCursor(extNode);
+    compiler->addNode(jTrampolineTarget);
 
-    occupied |= regMask;
-    continue;
+    // Finally, patch the jump target.
+    ASMJIT_ASSERT(jNode->getOpCount() > 0);
+    jNode->_opList[0] = jTrampolineTarget->getLabel();
+    jNode->_target = jTrampolineTarget;
   }
-
-  // Set calculated masks back to the allocator; needed by spill() and alloc().
-  _willSpill.set(C, willSpill);
-  _willAlloc.set(C, willAlloc);
+
+  // Store the `extNode` and load the state back.
+  self->setExtraBlock(extNode);
+  self->loadState(jNode->_state);
 }
 
+// ============================================================================
+// [asmjit::X86Context - Translate - Loop]
+// ============================================================================
+
+//! \internal
+//!
+//! Get the maximum count of variables of class `C` used inside the loop of
+//! `header` that are alive at the same time. Variables written inside the
+//! loop are stored to `written`.
 template<int C>
-ASMJIT_INLINE void X86CallAlloc::spill() {
-  uint32_t m = _willSpill.get(C);
-  uint32_t i = static_cast<uint32_t>(0) - 1;
+static uint32_t X86Context_getLoopPressure(X86Context* self, BasicBlock* header, BitArray* live, BitArray* written) {
+  VarData** vdArray = self->_contextVd.getData();
+  BitArray* loopVars = header->getLoopVars();
 
-  if (m == 0)
-    return;
+  uint32_t bLen = static_cast<uint32_t>(
+    ((self->_contextVd.getLength() + BitArray::kEntityBits - 1) / BitArray::kEntityBits));
 
-  X86VarState* state = getState();
-  VarData** sVars = state->getListByClass(C);
+  uint32_t blockCount = self->getBlockCount();
+  uint32_t pressure = 0;
 
-  // Available registers for decision if move has any benefit over spill.
-  uint32_t availableRegs = getGaRegs(C) & ~(state->_occupied.get(C) | m | _willAlloc.get(C));
+  ::memset(written, 0, bLen * BitArray::kEntitySize);
 
-  do {
-    // We always advance one more to destroy the bit that we have found.
-    uint32_t bitIndex = Utils::findFirstBit(m) + 1;
+  // Blocks of a loop are dominated by its header, so they follow it.
+  for (uint32_t blockId = header->getId(); blockId < blockCount; blockId++) {
+    BasicBlock* block = self->getBlock(blockId);
+    BasicBlock* loop = block->getLoop();
 
-    i += bitIndex;
-    m >>= bitIndex;
+    while (loop != nullptr && loop != header && loop->getId() > header->getId())
+      loop = loop->getParentLoop();
 
-    VarData* vd = sVars[i];
-    ASMJIT_ASSERT(vd != nullptr);
-    ASMJIT_ASSERT(vd->getVa() == nullptr);
+    if (loop != header)
+      continue;
 
-    if (vd->isModified() && availableRegs) {
-      uint32_t available = guessSpill<C>(vd, availableRegs);
-      if (available != 0) {
-        uint32_t regIndex = Utils::findFirstBit(available);
-        uint32_t regMask = Utils::mask(regIndex);
+    uint32_t count = 0;
+    for (uint32_t w = 0; w < bLen; w++) {
+      uintptr_t bits = block->getLiveIn()->data[w] & loopVars->data[w];
+      live->data[w] = bits;
 
-        _context->move<C>(vd, regIndex);
-        availableRegs ^= regMask;
-        continue;
+      for (uint32_t i = w * BitArray::kEntityBits; bits != 0; i++, bits >>= 1) {
+        if ((bits & 1) != 0 && vdArray[i]->getClass() == C)
+          count++;
       }
     }
 
-    _context->spill<C>(vd);
-  } while (m != 0);
-}
+    if (pressure < count)
+      pressure = count;
 
-template<int C>
-ASMJIT_INLINE void X86CallAlloc::alloc() {
-  if (isVaDone(C))
-    return;
+    HLNode* node = block->getFirst();
+    for (;;) {
+      X86VarMap* map = node->getMap<X86VarMap>();
+      if (map != nullptr && node->getBlockId() == blockId) {
+        VarAttr* vaList = map->getVaListByClass(C);
+        uint32_t vaCount = map->getVaCountByClass(C);
+        uint32_t i;
 
-  VarAttr* list = getVaListByClass(C);
-  uint32_t count = getVaCountByClass(C);
+        for (i = 0; i < vaCount; i++) {
+          uint32_t localId = vaList[i].getVd()->getLocalId();
+          if (!live->getBit(localId)) {
+            live->setBit(localId);
+            count++;
+          }
 
-  X86VarState* state = getState();
-  VarData** sVars = state->getListByClass(C);
+          if (vaList[i].hasFlag(kVarAttrWAll))
+            written->setBit(localId);
+        }
 
-  uint32_t i;
-  bool didWork;
+        if (pressure < count)
+          pressure = count;
 
-  do {
-    didWork = false;
-    for (i = 0; i < count; i++) {
-      VarAttr* aVa = &list[i];
-      VarData* aVd = aVa->getVd();
+        for (i = 0; i < vaCount; i++) {
+          uint32_t localId = vaList[i].getVd()->getLocalId();
+          if (vaList[i].hasFlag(kVarAttrDead)) {
+            live->delBit(localId);
+            count--;
+          }
+        }
+      }
 
-      if ((aVa->getFlags() & (kVarAttrRReg | kVarAttrAllocRDone)) != kVarAttrRReg)
-        continue;
+      if (node == block->getLast())
+        break;
+      node = node->getNext();
+    }
+  }
 
-      uint32_t aIndex = aVd->getRegIndex();
-      uint32_t bIndex = aVa->getInRegIndex();
+  return pressure;
+}
 
-      // Shouldn't be the same.
-      ASMJIT_ASSERT(aIndex != bIndex);
+//! \internal
+//!
+//! Prepare registers of class `C` for the loop of `header`. Variables alive
+//! through the loop, but not used inside, are spilled if keeping them would
+//! force spills inside the loop. Then, if all variables used inside the loop
+//! fit into registers, those in memory are loaded. Variables written inside
+//! the loop are marked as modified, so back edges don't have to save them
+//! to match the state of the header. The code is emitted after
+//! `cursor`, which must be on the path to the header taken by the translator,
+//! so it runs once before the loop instead of on every back edge. Spilled
+//! variables are reloaded at their next use after the loop.
+template<int C>
+static void X86Context_enterLoop(X86Context* self, BasicBlock* header, HLNode* cursor, BitArray* live, BitArray* written) {
+  X86VarState* state = self->getState();
+  VarData** sVars = state->getListByClass(C);
+  VarData** vdArray = self->_contextVd.getData();
 
-      VarData* bVd = getState()->getListByClass(C)[bIndex];
-      if (bVd != nullptr) {
-        VarAttr* bVa = bVd->getVa();
+  BitArray* liveIn = header->getLiveIn();
+  BitArray* loopVars = header->getLoopVars();
 
-        // Gp registers only - Swap two registers if we can solve two
-        // allocation tasks by a single 'xchg' instruction, swapping
-        // two registers required by the instruction/node or one register
-        // required with another non-required.
-        if (C == kX86RegClassGp) {
-          _context->swapGp(aVd, bVd);
+  uint32_t bLen = static_cast<uint32_t>(
+    ((self->_contextVd.getLength() + BitArray::kEntityBits - 1) / BitArray::kEntityBits));
 
-          aVa->orFlags(kVarAttrAllocRDone);
-          addVaDone(C);
+  uint32_t unusedRegs = 0;
+  uint32_t occupiedRegs = state->_occupied.get(C);
 
-          // Doublehit, two registers allocated by a single swap.
-          if (bVa != nullptr && bVa->getInRegIndex() == aIndex) {
-            bVa->orFlags(kVarAttrAllocRDone);
-            addVaDone(C);
-          }
+  while (occupiedRegs != 0) {
+    uint32_t regIndex = Utils::findFirstBit(occupiedRegs);
+    uint32_t regMask = Utils::mask(regIndex);
+    occupiedRegs ^= regMask;
 
-          didWork = true;
-          continue;
-        }
-      }
-      else if (aIndex != kInvalidReg) {
-        _context->move<C>(aVd, bIndex);
-        _context->_clobberedRegs.or_(C, Utils::mask(bIndex));
+    uint32_t localId = sVars[regIndex]->getLocalId();
+    if (liveIn->getBit(localId) && !loopVars->getBit(localId))
+      unusedRegs |= regMask;
+  }
 
-        aVa->orFlags(kVarAttrAllocRDone);
-        addVaDone(C);
+  uint32_t w;
+  bool hasMemVars = false;
 
-        didWork = true;
-        continue;
+  for (w = 0; w < bLen && !hasMemVars; w++) {
+    uintptr_t bits = liveIn->data[w] & loopVars->data[w];
+    for (uint32_t i = w * BitArray::kEntityBits; bits != 0; i++, bits >>= 1) {
+      if ((bits & 1) != 0 && vdArray[i]->getClass() == C && vdArray[i]->getState() == kVarStateMem) {
+        hasMemVars = true;
+        break;
       }
-      else {
-        _context->alloc<C>(aVd, bIndex);
-        _context->_clobberedRegs.or_(C, Utils::mask(bIndex));
+    }
+  }
 
-        aVa->orFlags(kVarAttrAllocRDone);
-        addVaDone(C);
+  if (unusedRegs == 0 && !hasMemVars)
+    return;
 
-        didWork = true;
-        continue;
-      }
-    }
-  } while (didWork);
-}
+  uint32_t unusedCount = Utils::bitCount(unusedRegs);
+  uint32_t available = Utils::bitCount(self->_gaRegs[C]);
+  uint32_t pressure = X86Context_getLoopPressure<C>(self, header, live, written);
 
-// ============================================================================
-// [asmjit::X86CallAlloc - AllocImmsOnStack]
-// ============================================================================
+  self->getCompiler()->_setCursor(cursor);
 
-ASMJIT_INLINE void X86CallAlloc::allocImmsOnStack() {
-  X86CallNode* node = getNode();
-  X86FuncDecl* decl = node->getDecl();
+  if (pressure + unusedCount > available) {
+    uint32_t spillCount = Utils::iMin<uint32_t>(unusedCount, pressure + unusedCount - available);
+    uint32_t modifiedRegs = state->_modified.get(C);
 
-  uint32_t argCount = decl->getNumArgs();
-  Operand* args = node->_args;
+    ASMJIT_TLOG("[T] Loop #%u - Spilling %u of %u variables not used inside\n",
+      header->getId(), spillCount, unusedCount);
 
-  for (uint32_t i = 0; i < argCount; i++) {
-    Operand& op = args[i];
+    // Unmodified variables first, they don't need to be stored.
+    for (uint32_t phase = 0; phase < 2 && spillCount != 0; phase++) {
+      uint32_t regs = phase == 0 ? unusedRegs & ~modifiedRegs : unusedRegs & modifiedRegs;
 
-    if (!op.isImm())
-      continue;
+      while (regs != 0 && spillCount != 0) {
+        uint32_t regIndex = Utils::findFirstBit(regs);
+        uint32_t regMask = Utils::mask(regIndex);
 
-    const Imm& imm = static_cast<const Imm&>(op);
-    const FuncInOut& arg = decl->getArg(i);
-    uint32_t varType = arg.getVarType();
+        regs ^= regMask;
+        unusedRegs ^= regMask;
 
-    if (arg.hasStackOffset()) {
-      X86Mem dst = x86::ptr(_context->_zsp, -static_cast<int>(_context->getRegSize()) + arg.getStackOffset());
-      _context->emitMoveImmOnStack(varType, &dst, &imm);
-    }
-    else {
-      _context->emitMoveImmToReg(varType, arg.getRegIndex(), &imm);
+        self->spill<C>(sVars[regIndex]);
+        unusedCount--;
+        spillCount--;
+      }
     }
   }
-}
-
-// ============================================================================
-// [asmjit::X86CallAlloc - Duplicate]
-// ============================================================================
-
-template<int C>
-ASMJIT_INLINE void X86CallAlloc::duplicate() {
-  VarAttr* list = getVaListByClass(C);
-  uint32_t count = getVaCountByClass(C);
 
-  for (uint32_t i = 0; i < count; i++) {
-    VarAttr* va = &list[i];
-    if (!va->hasFlag(kVarAttrRReg))
-      continue;
-
-    uint32_t inRegs = va->getInRegs();
-    if (!inRegs)
-      continue;
+  if (hasMemVars && pressure + unusedCount <= available) {
+    uint32_t freeRegs = self->_gaRegs[C] & ~state->_occupied.get(C);
 
-    VarData* vd = va->getVd();
-    uint32_t regIndex = vd->getRegIndex();
+    for (w = 0; w < bLen && freeRegs != 0; w++) {
+      uintptr_t bits = liveIn->data[w] & loopVars->data[w];
 
-    ASMJIT_ASSERT(regIndex != kInvalidReg);
+      for (uint32_t i = w * BitArray::kEntityBits; bits != 0 && freeRegs != 0; i++, bits >>= 1) {
+        VarData* vd = vdArray[i];
+        if ((bits & 1) == 0 || vd->getClass() != C || vd->getState() != kVarStateMem)
+          continue;
 
-    inRegs &= ~Utils::mask(regIndex);
-    if (!inRegs)
-      continue;
+        uint32_t regIndex = Utils::findFirstBit(
+          (freeRegs & vd->getHomeMask()) != 0 ? freeRegs & vd->getHomeMask() : freeRegs);
 
-    for (uint32_t dupIndex = 0; inRegs != 0; dupIndex++, inRegs >>= 1) {
-      if (inRegs & 0x1) {
-        _context->emitMove(vd, dupIndex, regIndex, "Duplicate");
-        _context->_clobberedRegs.or_(C, Utils::mask(dupIndex));
+        freeRegs ^= Utils::mask(regIndex);
+        self->load<C>(vd, regIndex);
       }
     }
   }
+
+  occupiedRegs = state->_occupied.get(C) & ~state->_modified.get(C);
+  while (occupiedRegs != 0) {
+    uint32_t regIndex = Utils::findFirstBit(occupiedRegs);
+    occupiedRegs ^= Utils::mask(regIndex);
+
+    VarData* vd = sVars[regIndex];
+    if (written->getBit(vd->getLocalId()))
+      self->modify<C>(vd);
+  }
 }
 
 // ============================================================================
-// [asmjit::X86CallAlloc - GuessAlloc / GuessSpill]
+// [asmjit::X86Context - Translate - Ret]
 // ============================================================================
 
-template<int C>
-ASMJIT_INLINE uint32_t X86CallAlloc::guessAlloc(VarData* vd, uint32_t allocableRegs) {
-  ASMJIT_ASSERT(allocableRegs != 0);
-
-  // Stop now if there is only one bit (register) set in 'allocableRegs' mask.
-  if (Utils::isPowerOf2(allocableRegs))
-    return allocableRegs;
+static Error X86Context_translateRet(X86Context* self, HLRet* rNode, HLLabel* exitTarget) {
+  X86Compiler* compiler = self->getCompiler();
+  HLNode* node = rNode->getNext();
 
-  uint32_t i;
-  uint32_t safeRegs = allocableRegs;
-  uint32_t maxLookAhead = _compiler->getMaxLookAhead();
+  // 32-bit mode requires to push floating point return value(s), handle it
+  // here as it's a special case.
+  X86VarMap* map = rNode->getMap<X86VarMap>();
+  if (map != nullptr) {
+    VarAttr* vaList = map->getVaList();
+    uint32_t vaCount = map->getVaCount();
 
-  // Look ahead and calculate mask of special registers on both - input/output.
-  HLNode* node = _node;
-  for (i = 0; i < maxLookAhead; i++) {
-    // Stop on 'HLRet' and 'HLSentinel.
-    if (node->hasFlag(HLNode::kFlagIsRet))
-      break;
+    for (uint32_t i = 0; i < vaCount; i++) {
+      VarAttr& va = vaList[i];
+      if (va.hasFlag(kVarAttrX86Fld4 | kVarAttrX86Fld8)) {
+        VarData* vd = va.getVd();
+        X86Mem m(self->getVarMem(vd));
 
-    // Stop on conditional jump, we don't follow them.
-    if (node->hasFlag(HLNode::kFlagIsJcc))
-      break;
+        uint32_t flags = _x86VarInfo[vd->getType()].getFlags();
+        m.setSize(
+          (flags & VarInfo::kFlagSP) ? 4 :
+          (flags & VarInfo::kFlagDP) ? 8 :
+          va.hasFlag(kVarAttrX86Fld4) ? 4 : 8);
 
-    // Advance on non-conditional jump.
-    if (node->hasFlag(HLNode::kFlagIsJmp)) {
-      node = static_cast<HLJump*>(node)->getTarget();
-      // Stop on jump that is not followed.
-      if (node == nullptr)
-        break;
+        compiler->fld(m);
+      }
     }
+  }
 
-    node = node->getNext();
-    ASMJIT_ASSERT(node != nullptr);
-
-    X86VarMap* map = node->getMap<X86VarMap>();
-    if (map != nullptr) {
-      VarAttr* va = map->findVaByClass(C, vd);
-      if (va != nullptr) {
-        uint32_t inRegs = va->getInRegs();
-        if (inRegs != 0) {
-          safeRegs = allocableRegs;
-          allocableRegs &= inRegs;
-
-          if (allocableRegs == 0)
-            goto _UseSafeRegs;
-          else
-            return allocableRegs;
-        }
-      }
+  // Decide whether to `jmp` or not in case we are next to the return label.
+  while (node != nullptr) {
+    switch (node->getType()) {
+      // If we have found an exit label we just return, there is no need to
+      // emit jump to that.
+      case HLNode::kTypeLabel:
+        if (static_cast<HLLabel*>(node) == exitTarget)
+          return kErrorOk;
+        goto _EmitRet;
 
-      safeRegs = allocableRegs;
-      allocableRegs &= ~(map->_inRegs.get(C) | map->_outRegs.get(C) | map->_clobberedRegs.get(C));
+      case HLNode::kTypeData:
+      case HLNode::kTypeInst:
+      case HLNode::kTypeCall:
+      case HLNode::kTypeRet:
+        goto _EmitRet;
 
-      if (allocableRegs == 0)
+      // Continue iterating.
+      case HLNode::kTypeComment:
+      case HLNode::kTypeAlign:
+      case HLNode::kTypeHint:
         break;
-    }
-  }
 
-_UseSafeRegs:
-  return safeRegs;
-}
+      // Invalid node to be here.
+      case HLNode::kTypeFunc:
+        return self->getCompiler()->setLastError(kErrorInvalidState);
 
-template<int C>
-ASMJIT_INLINE uint32_t X86CallAlloc::guessSpill(VarData* vd, uint32_t allocableRegs) {
-  ASMJIT_ASSERT(allocableRegs != 0);
+      // We can't go forward from here.
+      case HLNode::kTypeSentinel:
+        return kErrorOk;
+    }
 
-  return 0;
+    node = node->getNext();
+  }
+
+_EmitRet:
+  {
+    compiler->_setCursor(rNode);
+    compiler->jmp(exitTarget->getLabel());
+  }
+  return kErrorOk;
 }
 
 // ============================================================================
-// [asmjit::X86CallAlloc - Save]
+// [asmjit::X86Context - Translate - Func]
 // ============================================================================
 
-template<int C>
-ASMJIT_INLINE void X86CallAlloc::save() {
-  X86VarState* state = getState();
-  VarData** sVars = state->getListByClass(C);
+Error X86Context::translate() {
+  ASMJIT_TLOG("[T] ======= Translate (Begin)\n");
 
-  uint32_t i;
-  uint32_t affected = _map->_clobberedRegs.get(C) & state->_occupied.get(C) & state->_modified.get(C);
+  X86Compiler* compiler = getCompiler();
+  X86FuncNode* func = getFunc();
 
-  for (i = 0; affected != 0; i++, affected >>= 1) {
-    if (affected & 0x1) {
-      VarData* vd = sVars[i];
-      ASMJIT_ASSERT(vd != nullptr);
-      ASMJIT_ASSERT(vd->isModified());
+  // Register allocator contexts.
+  X86VarAlloc vAlloc(this);
+  X86CallAlloc cAlloc(this);
 
-      VarAttr* va = vd->getVa();
-      if (va == nullptr || (va->getFlags() & (kVarAttrWReg | kVarAttrUnuse)) == 0) {
-        _context->save<C>(vd);
-      }
-    }
-  }
-}
+  // Flow.
+  HLNode* node_ = func;
+  HLNode* next = nullptr;
+  HLNode* prev = nullptr;
+  HLNode* stop = getStop();
 
-// ============================================================================
-// [asmjit::X86CallAlloc - Clobber]
-// ============================================================================
+  // Only used by loop headers, see `X86Context_enterLoop()`.
+  BitArray* live = nullptr;
 
-template<int C>
-ASMJIT_INLINE void X86CallAlloc::clobber() {
-  X86VarState* state = getState();
-  VarData** sVars = state->getListByClass(C);
+  PodList<HLNode*>::Link* jLink = _jccList.getFirst();
 
-  uint32_t i;
-  uint32_t affected = _map->_clobberedRegs.get(C) & state->_occupied.get(C);
+  for (;;) {
+    while (node_->isTranslated()) {
+      // Switch state if we went to the already translated node.
+      if (node_->getType() == HLNode::kTypeLabel) {
+        HLLabel* node = static_cast<HLLabel*>(node_);
+        compiler->_setCursor(node->getPrev());
+        switchState(node->getState());
+      }
 
-  for (i = 0; affected != 0; i++, affected >>= 1) {
-    if (affected & 0x1) {
-      VarData* vd = sVars[i];
-      ASMJIT_ASSERT(vd != nullptr);
+_NextGroup:
+      if (jLink == nullptr) {
+        goto _Done;
+      }
+      else {
+        node_ = jLink->getValue();
+        jLink = jLink->getNext();
+        prev = nullptr;
 
-      VarAttr* va = vd->getVa();
-      uint32_t vdState = kVarStateNone;
+        HLNode* jFlow = X86Context_getOppositeJccFlow(static_cast<HLJump*>(node_));
+        loadState(node_->getState());
 
-      if (!vd->isModified() || (va != nullptr && (va->getFlags() & (kVarAttrWAll | kVarAttrUnuse)) != 0)) {
-        vdState = kVarStateMem;
-      }
+        if (jFlow->getState()) {
+          X86Context_translateJump(this,
+            static_cast<HLJump*>(node_),
+            static_cast<HLLabel*>(jFlow));
 
-      _context->unuse<C>(vd, vdState);
+          node_ = jFlow;
+          if (node_->isTranslated())
+            goto _NextGroup;
+        }
+        else {
+          node_ = jFlow;
+        }
+
+        break;
+      }
     }
-  }
-}
 
-// ============================================================================
-// [asmjit::X86CallAlloc - Ret]
-// ============================================================================
+    next = node_->getNext();
+    node_->orFlags(HLNode::kFlagIsTranslated);
 
-ASMJIT_INLINE void X86CallAlloc::ret() {
-  X86CallNode* node = getNode();
-  X86FuncDecl* decl = node->getDecl();
+    ASMJIT_TSEC({
+      this->_traceNode(this, node_, "[T] ");
+    });
 
-  uint32_t i;
-  Operand* rets = node->_ret;
+    switch (node_->getType()) {
+      // ----------------------------------------------------------------------
+      // [Align / Embed]
+      // ----------------------------------------------------------------------
 
-  for (i = 0; i < 2; i++) {
-    const FuncInOut& ret = decl->getRet(i);
-    Operand* op = &rets[i];
+      case HLNode::kTypeAlign:
+      case HLNode::kTypeData:
+        break;
 
-    if (!ret.hasRegIndex() || !op->isVar())
-      continue;
+      // ----------------------------------------------------------------------
+      // [Target]
+      // ----------------------------------------------------------------------
 
-    VarData* vd = _compiler->getVdById(op->getId());
-    uint32_t vf = _x86VarInfo[vd->getType()].getFlags();
-    uint32_t regIndex = ret.getRegIndex();
+      case HLNode::kTypeLabel: {
+        HLLabel* node = static_cast<HLLabel*>(node_);
+        ASMJIT_ASSERT(!node->hasState());
 
-    switch (vd->getClass()) {
-      case kX86RegClassGp:
-        ASMJIT_ASSERT(x86VarTypeToClass(ret.getVarType()) == vd->getClass());
+        // The state of a loop header is used by all back edges, so prepare
+        // registers for the loop before it's entered. Only possible if the
+        // header was reached by a fall-through or an unconditional jump.
+        BasicBlock* block = getBlockOf(node);
+        if (block != nullptr && block->isLoopHeader() && block->getFirst() == node && prev != nullptr) {
+          HLNode* cursor = nullptr;
+
+          if (prev->isJmp())
+            cursor = prev->getPrev();
+          else if (prev->getNext() == node && !prev->isRet())
+            cursor = prev;
+
+          if (cursor != nullptr) {
+            uint32_t bLen = static_cast<uint32_t>(
+              (_contextVd.getLength() + BitArray::kEntityBits - 1) / BitArray::kEntityBits);
+
+            if (live == nullptr) {
+              live = newBits(bLen * 2);
+              if (live == nullptr)
+                return compiler->setLastError(kErrorNoHeapMemory);
+            }
 
-        _context->unuse<kX86RegClassGp>(vd);
-        _context->attach<kX86RegClassGp>(vd, regIndex, true);
+            BitArray* written = reinterpret_cast<BitArray*>(live->data + bLen);
+            X86Context_enterLoop<kX86RegClassGp >(this, block, cursor, live, written);
+            X86Context_enterLoop<kX86RegClassMm >(this, block, cursor, live, written);
+            X86Context_enterLoop<kX86RegClassXyz>(this, block, cursor, live, written);
+          }
+        }
+
+        node->setState(saveState());
         break;
+      }
 
-      case kX86RegClassMm:
-        ASMJIT_ASSERT(x86VarTypeToClass(ret.getVarType()) == vd->getClass());
+      // ----------------------------------------------------------------------
+      // [Inst/Call/SArg/Ret]
+      // ----------------------------------------------------------------------
 
-        _context->unuse<kX86RegClassMm>(vd);
-        _context->attach<kX86RegClassMm>(vd, regIndex, true);
-        break;
+      case HLNode::kTypeInst:
+      case HLNode::kTypeCall:
+      case HLNode::kTypeCallArg:
+        // Unuse variables that are not alive after the node.
+        if (!node_->isJcc()) {
+          X86VarMap* map = static_cast<X86VarMap*>(node_->getMap());
 
-      case kX86RegClassXyz:
-        if (ret.getVarType() == kVarTypeFp32 || ret.getVarType() == kVarTypeFp64) {
-          X86Mem m = _context->getVarMem(vd);
-          m.setSize(
-            (vf & VarInfo::kFlagSP) ? 4 :
-            (vf & VarInfo::kFlagDP) ? 8 :
-            (ret.getVarType() == kVarTypeFp32) ? 4 : 8);
+          if (map != nullptr) {
+            VarAttr* vaList = map->getVaList();
+            uint32_t vaCount = map->getVaCount();
 
-          _context->unuse<kX86RegClassXyz>(vd, kVarStateMem);
-          _compiler->fstp(m);
+            for (uint32_t i = 0; i < vaCount; i++) {
+              VarAttr* va = &vaList[i];
+              if (va->hasFlag(kVarAttrDead))
+                va->orFlags(kVarAttrUnuse);
+            }
+          }
         }
-        else {
-          ASMJIT_ASSERT(x86VarTypeToClass(ret.getVarType()) == vd->getClass());
 
-          _context->unuse<kX86RegClassXyz>(vd);
-          _context->attach<kX86RegClassXyz>(vd, regIndex, true);
+        if (node_->getType() == HLNode::kTypeCall) {
+          ASMJIT_PROPAGATE_ERROR(cAlloc.run(static_cast<X86CallNode*>(node_)));
+          break;
+        }
+        ASMJIT_FALLTHROUGH;
+
+      case HLNode::kTypeHint:
+      case HLNode::kTypeRet: {
+        ASMJIT_PROPAGATE_ERROR(vAlloc.run(node_));
+
+        // Handle conditional/unconditional jump.
+        if (node_->isJmpOrJcc()) {
+          HLJump* node = static_cast<HLJump*>(node_);
+          HLLabel* jTarget = node->getTarget();
+
+          // Target not followed.
+          if (jTarget == nullptr) {
+            if (node->isJmp())
+              goto _NextGroup;
+            else
+              break;
+          }
+
+          if (node->isJmp()) {
+            if (jTarget->hasState()) {
+              compiler->_setCursor(node->getPrev());
+              switchState(jTarget->getState());
+
+              goto _NextGroup;
+            }
+            else {
+              next = jTarget;
+            }
+          }
+          else {
+            HLNode* jNext = node->getNext();
+
+            if (jTarget->isTranslated()) {
+              if (jNext->isTranslated()) {
+                ASMJIT_ASSERT(jNext->getType() == HLNode::kTypeLabel);
+                compiler->_setCursor(node->getPrev());
+                intersectStates(jTarget->getState(), jNext->getState());
+              }
+
+              VarState* savedState = saveState();
+              node->setState(savedState);
+
+              X86Context_translateJump(this, node, jTarget);
+              next = jNext;
+            }
+            else if (jNext->isTranslated()) {
+              ASMJIT_ASSERT(jNext->getType() == HLNode::kTypeLabel);
+
+              VarState* savedState = saveState();
+              node->setState(savedState);
+
+              compiler->_setCursor(node);
+              switchState(static_cast<HLLabel*>(jNext)->getState());
+              next = jTarget;
+            }
+            else {
+              node->setState(saveState());
+              next = X86Context_getJccFlow(node);
+            }
+          }
+        }
+        else if (node_->isRet()) {
+          ASMJIT_PROPAGATE_ERROR(
+            X86Context_translateRet(this, static_cast<HLRet*>(node_), func->getExitNode()));
         }
         break;
-    }
-  }
-}
+      }
 
-// ============================================================================
-// [asmjit::X86Context - TranslateOperands]
-// ============================================================================
+      // ----------------------------------------------------------------------
+      // [Func]
+      // ----------------------------------------------------------------------
 
-//! \internal
-static Error X86Context_translateOperands(X86Context* self, Operand* opList, uint32_t opCount) {
-  X86Compiler* compiler = self->getCompiler();
-  uint32_t hasGpdBase = compiler->getRegSize() == 4;
+      case HLNode::kTypeFunc: {
+        ASMJIT_ASSERT(node_ == func);
 
-  // Translate variables into registers.
-  for (uint32_t i = 0; i < opCount; i++) {
-    Operand* op = &opList[i];
+        X86FuncDecl* decl = func->getDecl();
+        X86VarMap* map = func->getMap<X86VarMap>();
 
-    if (op->isVar()) {
-      VarData* vd = compiler->getVdById(op->getId());
-      ASMJIT_ASSERT(vd != nullptr);
-      ASMJIT_ASSERT(vd->getRegIndex() != kInvalidReg);
+        if (map != nullptr) {
+          uint32_t i;
+          uint32_t argCount = func->_x86Decl.getNumArgs();
 
-      op->_vreg.op = Operand::kTypeReg;
-      op->_vreg.index = vd->getRegIndex();
-    }
-    else if (op->isMem()) {
-      X86Mem* m = static_cast<X86Mem*>(op);
+          for (i = 0; i < argCount; i++) {
+            const FuncInOut& arg = decl->getArg(i);
 
-      if (m->isBaseIndexType() && OperandUtil::isVarId(m->getBase())) {
-        VarData* vd = compiler->getVdById(m->getBase());
+            VarData* vd = func->getArg(i);
+            if (vd == nullptr)
+              continue;
 
-        if (m->getMemType() == kMemTypeBaseIndex) {
-          ASMJIT_ASSERT(vd->getRegIndex() != kInvalidReg);
-          op->_vmem.base = vd->getRegIndex();
-        }
-        else {
-          if (!vd->isMemArg())
-            self->getVarCell(vd);
+            VarAttr* va = map->findVa(vd);
+            ASMJIT_ASSERT(va != nullptr);
 
-          // Offset will be patched later by X86Context_patchFuncMem().
-          m->setGpdBase(hasGpdBase);
-          m->adjust(vd->isMemArg() ? self->_argActualDisp : self->_varActualDisp);
+            if (va->getFlags() & kVarAttrUnuse)
+              continue;
+
+            uint32_t regIndex = va->getOutRegIndex();
+            if (regIndex != kInvalidReg && (va->getFlags() & kVarAttrWConv) == 0) {
+              switch (vd->getClass()) {
+                case kX86RegClassGp : attach<kX86RegClassGp >(vd, regIndex, true); break;
+                case kX86RegClassMm : attach<kX86RegClassMm >(vd, regIndex, true); break;
+                case kX86RegClassXyz: attach<kX86RegClassXyz>(vd, regIndex, true); break;
+              }
+            }
+            else if (va->hasFlag(kVarAttrWConv)) {
+              // TODO: [COMPILER] Function Argument Conversion.
+              ASMJIT_NOT_REACHED();
+            }
+            else {
+              vd->_isMemArg = true;
+              vd->setMemOffset(arg.getStackOffset());
+              vd->setState(kVarStateMem);
+            }
+          }
         }
+        break;
       }
 
-      if (OperandUtil::isVarId(m->getIndex())) {
-        VarData* vd = compiler->getVdById(m->getIndex());
-        ASMJIT_ASSERT(vd->getRegIndex() != kInvalidReg);
-        ASMJIT_ASSERT(vd->getRegIndex() != kX86RegIndexR12);
-        op->_vmem.index = vd->getRegIndex();
+      // ----------------------------------------------------------------------
+      // [End]
+      // ----------------------------------------------------------------------
+
+      case HLNode::kTypeSentinel: {
+        goto _NextGroup;
       }
+
+      default:
+        break;
     }
+
+    if (next == stop)
+      goto _NextGroup;
+
+    prev = node_;
+    node_ = next;
   }
 
+_Done:
+  ASMJIT_PROPAGATE_ERROR(X86Context_initFunc(this, func));
+  ASMJIT_PROPAGATE_ERROR(X86Context_patchFuncMem(this, func, stop));
+  ASMJIT_PROPAGATE_ERROR(X86Context_translatePrologEpilog(this, func));
+
+  ASMJIT_TLOG("[T] ======= Translate (End)\n");
   return kErrorOk;
 }
 
 // ============================================================================
-// [asmjit::X86Context - TranslatePrologEpilog]
+// [asmjit::X86Context - Peephole]
 // ============================================================================
 
 //! \internal
-static Error X86Context_initFunc(X86Context* self, X86FuncNode* func) {
-  X86Compiler* compiler = self->getCompiler();
-  X86FuncDecl* decl = func->getDecl();
-
-  X86RegMask& clobberedRegs = self->_clobberedRegs;
-  uint32_t regSize = compiler->getRegSize();
-
-  // Setup "Save-Restore" registers.
-  func->_saveRestoreRegs.set(kX86RegClassGp , clobberedRegs.get(kX86RegClassGp ) & decl->getPreserved(kX86RegClassGp ));
-  func->_saveRestoreRegs.set(kX86RegClassMm , clobberedRegs.get(kX86RegClassMm ) & decl->getPreserved(kX86RegClassMm ));
-  func->_saveRestoreRegs.set(kX86RegClassK  , 0);
-  func->_saveRestoreRegs.set(kX86RegClassXyz, clobberedRegs.get(kX86RegClassXyz) & decl->getPreserved(kX86RegClassXyz));
-
-  ASMJIT_ASSERT(!func->_saveRestoreRegs.has(kX86RegClassGp, Utils::mask(kX86RegIndexSp)));
-
-  // Setup required stack alignment and kFuncFlagIsStackMisaligned.
-  {
-    uint32_t requiredStackAlignment = Utils::iMax(self->_memMaxAlign, self->getRegSize());
-
-    if (requiredStackAlignment < 16) {
-      // Require 16-byte alignment if 8-byte vars are used.
-      if (self->_mem8ByteVarsUsed)
-        requiredStackAlignment = 16;
-      else if (func->_saveRestoreRegs.get(kX86RegClassMm) || func->_saveRestoreRegs.get(kX86RegClassXyz))
-        requiredStackAlignment = 16;
-      else if (Utils::inInterval<uint32_t>(func->getRequiredStackAlignment(), 8, 16))
-        requiredStackAlignment = 16;
-    }
-
-    if (func->getRequiredStackAlignment() < requiredStackAlignment)
-      func->setRequiredStackAlignment(requiredStackAlignment);
-
-    func->updateRequiredStackAlignment();
-  }
-
-  // Adjust stack pointer if function is caller.
-  if (func->isCaller()) {
-    func->addFuncFlags(kFuncFlagIsStackAdjusted);
-    func->_callStackSize = Utils::alignTo<uint32_t>(func->getCallStackSize(), func->getRequiredStackAlignment());
-  }
-
-  // Adjust stack pointer if manual stack alignment is needed.
-  if (func->isStackMisaligned() && func->isNaked()) {
-    // Get a memory cell where the original stack frame will be stored.
-    VarCell* cell = self->_newStackCell(regSize, regSize);
-    if (cell == nullptr)
-      return self->getLastError(); // The error has already been set.
-
-    func->addFuncFlags(kFuncFlagIsStackAdjusted);
-    self->_stackFrameCell = cell;
-
-    if (decl->getArgStackSize() > 0) {
-      func->addFuncFlags(kFuncFlagX86MoveArgs);
-      func->setExtraStackSize(decl->getArgStackSize());
-    }
-
-    // Get temporary register which will be used to align the stack frame.
-    uint32_t fRegMask = Utils::bits(self->_regCount.getGp());
-    uint32_t stackFrameCopyRegs;
-
-    fRegMask &= ~(decl->getUsed(kX86RegClassGp) | Utils::mask(kX86RegIndexSp));
-    stackFrameCopyRegs = fRegMask;
+//!
+//! Get the first node after `node` that is not a comment or a hint.
+static ASMJIT_INLINE HLNode* X86Context_nextCode(HLNode* node) {
+  do {
+    node = node->getNext();
+  } while (node != nullptr && (node->getType() == HLNode::kTypeComment || node->getType() == HLNode::kTypeHint));
+  return node;
+}
 
-    // Try to remove modified registers from the mask.
-    uint32_t tRegMask = fRegMask & ~self->getClobberedRegs(kX86RegClassGp);
-    if (tRegMask != 0)
-      fRegMask = tRegMask;
+//! \internal
+//!
+//! Get whether status flags are overwritten before they can be read by the
+//! code following `node`. Calls and returns don't preserve flags. The check
+//! is conservative, it gives up after a few nodes or at a node it doesn't
+//! understand.
+static bool X86Context_isFlagsDead(HLNode* node) {
+  uint32_t flags = kX86EFlagO | kX86EFlagS | kX86EFlagZ | kX86EFlagA | kX86EFlagP | kX86EFlagC;
+  uint32_t remaining = 16;
+
+  for (node = node->getNext(); node != nullptr && remaining != 0; node = node->getNext(), remaining--) {
+    switch (node->getType()) {
+      case HLNode::kTypeLabel:
+      case HLNode::kTypeComment:
+      case HLNode::kTypeHint:
+      case HLNode::kTypeRet:
+        continue;
 
-    // Try to remove preserved registers from the mask.
-    tRegMask = fRegMask & ~decl->getPreserved(kX86RegClassGp);
-    if (tRegMask != 0)
-      fRegMask = tRegMask;
+      case HLNode::kTypeCall:
+      case HLNode::kTypeSentinel:
+        return true;
 
-    ASMJIT_ASSERT(fRegMask != 0);
+      case HLNode::kTypeInst: {
+        HLInst* inst = static_cast<HLInst*>(node);
+        uint32_t instId = inst->getInstId();
+        const X86InstInfo& info = _x86InstInfo[instId];
 
-    uint32_t fRegIndex = Utils::findFirstBit(fRegMask);
-    func->_stackFrameRegIndex = static_cast<uint8_t>(fRegIndex);
+        if ((info.getEFlagsIn() & flags) != 0)
+          return false;
 
-    // We have to save the register on the stack (it will be the part of prolog
-    // and epilog), however we shouldn't save it twice, so we will remove it
-    // from '_saveRestoreRegs' in case that it is preserved.
-    fRegMask = Utils::mask(fRegIndex);
-    if ((fRegMask & decl->getPreserved(kX86RegClassGp)) != 0) {
-      func->_saveRestoreRegs.andNot(kX86RegClassGp, fRegMask);
-      func->_isStackFrameRegPreserved = true;
-    }
+        if (instId == kX86InstIdRet || instId == kX86InstIdCall)
+          return true;
 
-    if (func->hasFuncFlag(kFuncFlagX86MoveArgs)) {
-      uint32_t maxRegs = (func->getArgStackSize() + regSize - 1) / regSize;
-      stackFrameCopyRegs &= ~fRegMask;
+        if (instId == kX86InstIdJmp) {
+          HLLabel* target = static_cast<HLJump*>(inst)->getTarget();
+          if (target == nullptr)
+            return false;
 
-      tRegMask = stackFrameCopyRegs & self->getClobberedRegs(kX86RegClassGp);
-      uint32_t tRegCnt = Utils::bitCount(tRegMask);
+          // Continues after the target.
+          node = target;
+          continue;
+        }
 
-      if (tRegCnt > 1 || (tRegCnt > 0 && tRegCnt <= maxRegs))
-        stackFrameCopyRegs = tRegMask;
-      else
-        stackFrameCopyRegs = Utils::keepNOnesFromRight(stackFrameCopyRegs, Utils::iMin<uint32_t>(maxRegs, 2));
+        flags &= ~info.getEFlagsOut();
+        if (flags == 0)
+          return true;
+        break;
+      }
 
-      func->_saveRestoreRegs.or_(kX86RegClassGp, stackFrameCopyRegs & decl->getPreserved(kX86RegClassGp));
-      Utils::indexNOnesFromRight(func->_stackFrameCopyGpIndex, stackFrameCopyRegs, maxRegs);
+      default:
+        return false;
     }
   }
-  // If function is not naked we generate standard "EBP/RBP" stack frame.
-  else if (!func->isNaked()) {
-    uint32_t fRegIndex = kX86RegIndexBp;
-
-    func->_stackFrameRegIndex = static_cast<uint8_t>(fRegIndex);
-    func->_isStackFrameRegPreserved = true;
-  }
-
-  ASMJIT_PROPAGATE_ERROR(self->resolveCellOffsets());
-
-  // Adjust stack pointer if requested memory can't fit into "Red Zone" or "Spill Zone".
-  if (self->_memAllTotal > Utils::iMax<uint32_t>(func->getRedZoneSize(), func->getSpillZoneSize())) {
-    func->addFuncFlags(kFuncFlagIsStackAdjusted);
-  }
 
-  // Setup stack size used to save preserved registers.
-  {
-    uint32_t memGpSize  = Utils::bitCount(func->_saveRestoreRegs.get(kX86RegClassGp )) * regSize;
-    uint32_t memMmSize  = Utils::bitCount(func->_saveRestoreRegs.get(kX86RegClassMm )) * 8;
-    uint32_t memXmmSize = Utils::bitCount(func->_saveRestoreRegs.get(kX86RegClassXyz)) * 16;
+  return false;
+}
 
-    func->_pushPopStackSize = memGpSize;
-    func->_moveStackSize = memXmmSize + Utils::alignTo<uint32_t>(memMmSize, 16);
-  }
+//! \internal
+//!
+//! Get whether `op` is a register that can be moved to itself by `instId`
+//! without any effect. A 32-bit `mov` clears the high part of the register
+//! in 64-bit mode and `movq` clears the high part of an XMM register.
+static ASMJIT_INLINE bool X86Context_isSelfMoveNop(uint32_t instId, const Operand& op, uint32_t regSize) {
+  uint32_t regType = static_cast<const X86Reg&>(op).getRegType();
+
+  if (instId == kX86InstIdMovq)
+    return regType == kX86RegTypeMm;
+  else
+    return regType != kX86RegTypeGpd || regSize == 4;
+}
 
-  // Setup adjusted stack size.
-  if (func->isStackMisaligned()) {
-    func->_alignStackSize = 0;
-  }
-  else {
-    // If function is aligned, the RETURN address is stored in the aligned
-    // [ZSP - PtrSize] which makes current ZSP unaligned.
-    int32_t v = static_cast<int32_t>(regSize);
+//! \internal
+//!
+//! Get whether `op` is a register that can receive a value forwarded from a
+//! spill slot by a register-to-register move of `instId`.
+static ASMJIT_INLINE bool X86Context_isForwardableReg(const Operand& op, uint32_t instId) {
+  if (!op.isReg())
+    return false;
+
+  uint32_t regType = static_cast<const X86Reg&>(op).getRegType();
+  if (instId == kX86InstIdMov)
+    return regType == kX86RegTypeGpw || regType == kX86RegTypeGpd || regType == kX86RegTypeGpq;
+  else
+    return regType == kX86RegTypeMm || regType == kX86RegTypeXmm;
+}
 
-    // If we have to store function frame pointer we have to count it as well,
-    // because it is the first thing pushed on the stack.
-    if (func->hasStackFrameReg() && func->isStackFrameRegPreserved())
-      v += regSize;
+//! \internal
+//!
+//! Get whether `op` reads the register of `index` (only GP registers).
+static ASMJIT_INLINE bool X86Context_isGpUsedBy(const Operand& op, uint32_t index) {
+  if (op.isReg())
+    return static_cast<const X86Reg&>(op).isGp() && static_cast<const X86Reg&>(op).getRegIndex() == index;
+
+  if (op.isMem()) {
+    const X86Mem& m = static_cast<const X86Mem&>(op);
+    return (m.getMemType() == kMemTypeBaseIndex && m.hasBase() && m.getBase() == index) ||
+           (m.hasIndex() && m.getIndex() == index);
+  }
 
-    // Count push/pop sequence.
-    v += func->getPushPopStackSize();
+  return false;
+}
 
-    // Count save/restore sequence for XMM registers (should be already aligned).
-    v += func->getMoveStackSize();
+Error X86Context::peephole() {
+  X86Compiler* compiler = getCompiler();
+  uint32_t regSize = compiler->getRegSize();
 
-    // Maximum memory required to call all functions within this function.
-    v += func->getCallStackSize();
+  HLNode* node_ = getFunc();
+  HLNode* stop = getStop();
 
-    // Calculate the final offset to keep stack alignment.
-    func->_alignStackSize = Utils::alignDiff<uint32_t>(v, func->getRequiredStackAlignment());
-  }
+  while (node_ != stop) {
+    HLNode* next = node_->getNext();
 
-  // Memory stack size.
-  func->_memStackSize = self->_memAllTotal;
-  func->_alignedMemStackSize = Utils::alignTo<uint32_t>(func->_memStackSize, func->getRequiredStackAlignment());
+    if (node_->getType() != HLNode::kTypeInst) {
+      node_ = next;
+      continue;
+    }
 
-  if (func->isNaked()) {
-    self->_argBaseReg = kX86RegIndexSp;
+    HLInst* node = static_cast<HLInst*>(node_);
+    uint32_t instId = node->getInstId();
+    uint32_t opCount = node->getOpCount();
+    Operand* opList = node->getOpList();
+
+    // Jump or conditional jump to the next instruction.
+    if (node->isJmpOrJcc()) {
+      HLLabel* target = static_cast<HLJump*>(node)->getTarget();
+      if (target != nullptr) {
+        HLNode* cur = next;
+        while (cur != stop && cur != target && (cur->getType() == HLNode::kTypeLabel ||
+                                                cur->getType() == HLNode::kTypeComment ||
+                                                cur->getType() == HLNode::kTypeHint)) {
+          cur = cur->getNext();
+        }
 
-    if (func->isStackAdjusted()) {
-      if (func->isStackMisaligned()) {
-        self->_argBaseOffset = static_cast<int32_t>(
-          func->getCallStackSize() +
-          func->getAlignedMemStackSize() +
-          func->getMoveStackSize() +
-          func->getAlignStackSize());
-        self->_argBaseOffset -= regSize;
-      }
-      else {
-        self->_argBaseOffset = static_cast<int32_t>(
-          func->getCallStackSize() +
-          func->getAlignedMemStackSize() +
-          func->getMoveStackSize() +
-          func->getPushPopStackSize() +
-          func->getExtraStackSize() +
-          func->getAlignStackSize());
+        if (cur == target)
+          compiler->removeNode(node);
       }
+
+      node_ = next;
+      continue;
     }
-    else {
-      self->_argBaseOffset = func->getPushPopStackSize();
-    }
-  }
-  else {
-    self->_argBaseReg = kX86RegIndexBp;
-    // Caused by "push zbp".
-    self->_argBaseOffset = regSize;
-  }
 
-  self->_varBaseReg = kX86RegIndexSp;
-  self->_varBaseOffset = func->getCallStackSize();
+    switch (instId) {
+      case kX86InstIdMov:
+      case kX86InstIdMovq:
+      case kX86InstIdMovaps:
+      case kX86InstIdMovapd:
+      case kX86InstIdMovdqa:
+      case kX86InstIdMovups:
+      case kX86InstIdMovupd:
+      case kX86InstIdMovdqu: {
+        if (opCount != 2)
+          break;
 
-  if (!func->isStackAdjusted()) {
-    self->_varBaseOffset = -static_cast<int32_t>(
-      func->_alignStackSize +
-      func->_alignedMemStackSize +
-      func->_moveStackSize);
-  }
+        Operand& o0 = opList[0];
+        Operand& o1 = opList[1];
 
-  return kErrorOk;
-}
+        // Move of a register to itself.
+        if (o0.isReg() && o1.isReg()) {
+          if (static_cast<X86Reg&>(o0) == static_cast<X86Reg&>(o1) && X86Context_isSelfMoveNop(instId, o0, regSize))
+            compiler->removeNode(node);
+          break;
+        }
 
-//! \internal
-static Error X86Context_patchFuncMem(X86Context* self, X86FuncNode* func, HLNode* stop) {
-  X86Compiler* compiler = self->getCompiler();
-  HLNode* node = func;
+        // Zero by `xor`, which is shorter, if flags are not read afterwards.
+        if (instId == kX86InstIdMov && o0.isReg() && o1.isImm() && static_cast<Imm&>(o1).getInt64() == 0) {
+          uint32_t regType = static_cast<X86Reg&>(o0).getRegType();
+          if ((regType == kX86RegTypeGpd || regType == kX86RegTypeGpq) && X86Context_isFlagsDead(node)) {
+            X86GpReg r = x86::gpd(static_cast<X86Reg&>(o0).getRegIndex());
 
-  do {
-    if (node->getType() == HLNode::kTypeInst) {
-      HLInst* iNode = static_cast<HLInst*>(node);
+            node->setInstId(kX86InstIdXor);
+            o0 = r;
+            o1 = r;
+          }
+          break;
+        }
 
-      if (iNode->hasMemOp()) {
-        X86Mem* m = iNode->getMemOp<X86Mem>();
+        // Load of a spill slot that was just stored, the register is still
+        // valid, so the load is either removed or turned into a move.
+        if (o0.isMem() && X86Context_isForwardableReg(o1, instId) &&
+            static_cast<X86Mem&>(o0).getMemType() == kMemTypeStackIndex) {
+          HLNode* loadNode = X86Context_nextCode(node);
+          if (loadNode == nullptr || loadNode == stop || loadNode->getType() != HLNode::kTypeInst)
+            break;
 
-        if (m->getMemType() == kMemTypeStackIndex && OperandUtil::isVarId(m->getBase())) {
-          VarData* vd = compiler->getVdById(m->getBase());
-          ASMJIT_ASSERT(vd != nullptr);
+          HLInst* load = static_cast<HLInst*>(loadNode);
+          Operand* loadOps = load->getOpList();
 
-          if (vd->isMemArg()) {
-            m->_vmem.base = self->_argBaseReg;
-            m->_vmem.displacement += self->_argBaseOffset + vd->getMemOffset();
+          if (load->getInstId() != instId || load->getOpCount() != 2 ||
+              !X86Context_isForwardableReg(loadOps[0], instId) ||
+              !loadOps[1].isMem() || static_cast<X86Mem&>(loadOps[1]) != static_cast<X86Mem&>(o0) ||
+              static_cast<X86Reg&>(loadOps[0]).getRegType() != static_cast<X86Reg&>(o1).getRegType()) {
+            break;
           }
-          else {
-            VarCell* cell = vd->getMemCell();
-            ASMJIT_ASSERT(cell != nullptr);
 
-            m->_vmem.base = self->_varBaseReg;
-            m->_vmem.displacement += self->_varBaseOffset + cell->getOffset();
+          if (static_cast<X86Reg&>(loadOps[0]) == static_cast<X86Reg&>(o1) && X86Context_isSelfMoveNop(instId, o1, regSize)) {
+            if (next == load)
+              next = load->getNext();
+            compiler->removeNode(load);
+          }
+          else {
+            loadOps[1] = o1;
+            load->_updateMemOp();
           }
         }
+        break;
       }
-    }
 
-    node = node->getNext();
-  } while (node != stop);
+      // Zeroing by `xor` that is overwritten by the next instruction.
+      case kX86InstIdXor: {
+        if (opCount != 2 || !opList[0].isReg() || !opList[1].isReg())
+          break;
 
-  return kErrorOk;
-}
+        X86Reg& r = static_cast<X86Reg&>(opList[0]);
+        if (r != static_cast<X86Reg&>(opList[1]) || (r.getRegType() != kX86RegTypeGpd && r.getRegType() != kX86RegTypeGpq))
+          break;
 
-//! \internal
-static Error X86Context_translatePrologEpilog(X86Context* self, X86FuncNode* func) {
-  X86Compiler* compiler = self->getCompiler();
-  X86FuncDecl* decl = func->getDecl();
+        HLNode* writeNode = X86Context_nextCode(node);
+        if (writeNode == nullptr || writeNode == stop || writeNode->getType() != HLNode::kTypeInst)
+          break;
 
-  uint32_t regSize = compiler->getRegSize();
+        HLInst* write = static_cast<HLInst*>(writeNode);
+        Operand* writeOps = write->getOpList();
 
-  int32_t stackSize = static_cast<int32_t>(
-    func->getAlignStackSize() +
-    func->getCallStackSize() +
-    func->getAlignedMemStackSize() +
-    func->getMoveStackSize() +
-    func->getExtraStackSize());
-  int32_t stackAlignment = func->getRequiredStackAlignment();
+        if (write->getInstId() != kX86InstIdMov || write->getOpCount() != 2 || !writeOps[0].isReg())
+          break;
 
-  int32_t stackBase;
-  int32_t stackPtr;
+        X86Reg& w = static_cast<X86Reg&>(writeOps[0]);
+        if ((w.getRegType() != kX86RegTypeGpd && w.getRegType() != kX86RegTypeGpq) ||
+            w.getRegIndex() != r.getRegIndex() ||
+            X86Context_isGpUsedBy(writeOps[1], r.getRegIndex())) {
+          break;
+        }
 
-  if (func->isStackAdjusted()) {
-    stackBase = static_cast<int32_t>(
-      func->getCallStackSize() +
-      func->getAlignedMemStackSize());
-  }
-  else {
-    stackBase = -static_cast<int32_t>(
-      func->getAlignedMemStackSize() +
-      func->getAlignStackSize() +
-      func->getExtraStackSize());
+        if (X86Context_isFlagsDead(node))
+          compiler->removeNode(node);
+        break;
+      }
+    }
+
+    node_ = next;
   }
 
-  uint32_t i, mask;
-  uint32_t regsGp  = func->getSaveRestoreRegs(kX86RegClassGp );
-  uint32_t regsMm  = func->getSaveRestoreRegs(kX86RegClassMm );
-  uint32_t regsXmm = func->getSaveRestoreRegs(kX86RegClassXyz);
+  return kErrorOk;
+}
 
-  bool earlyPushPop = false;
-  bool useLeaEpilog = false;
+// ============================================================================
+// [asmjit::X86Context - Tune]
+// ============================================================================
 
-  X86GpReg gpReg(self->_zsp);
-  X86GpReg fpReg(self->_zbp);
+//! \internal
+//!
+//! Maximum count of instructions a flags producer is moved over to be fused
+//! with a conditional jump.
+static const uint32_t kX86TuneMaxFusionDistance = 4;
 
-  X86Mem fpOffset;
+//! \internal
+//!
+//! Get the class of `instId` macro-fused with a conditional jump, see
+//! \ref X86TuneFusible.
+static ASMJIT_INLINE uint32_t X86Context_getFusibleClass(uint32_t instId) {
+  switch (instId) {
+    case kX86InstIdCmp:
+    case kX86InstIdTest:
+      return kX86TuneFusibleCmpTest;
 
-  // --------------------------------------------------------------------------
-  // [Prolog]
-  // --------------------------------------------------------------------------
+    case kX86InstIdAdd:
+    case kX86InstIdSub:
+      return kX86TuneFusibleAddSub;
 
-  compiler->_setCursor(func->getEntryNode());
+    case kX86InstIdAnd:
+      return kX86TuneFusibleAnd;
 
-  // Entry.
-  if (func->isNaked()) {
-    if (func->isStackMisaligned()) {
-      fpReg.setIndex(func->getStackFrameRegIndex());
-      fpOffset = x86::ptr(self->_zsp, self->_varBaseOffset + static_cast<int32_t>(self->_stackFrameCell->getOffset()));
+    case kX86InstIdInc:
+    case kX86InstIdDec:
+      return kX86TuneFusibleIncDec;
 
-      earlyPushPop = true;
-      self->emitPushSequence(regsGp);
+    default:
+      return 0;
+  }
+}
 
-      if (func->isStackFrameRegPreserved())
-        compiler->emit(kX86InstIdPush, fpReg);
+//! \internal
+//!
+//! Get whether `inst` is macro-fused with a following conditional jump by a
+//! CPU fusing `fusible` instructions. Instructions with a memory operand and
+//! an immediate, and instructions writing memory are never fused.
+static bool X86Context_isFusibleForm(const HLInst* inst, uint32_t fusible) {
+  uint32_t instId = inst->getInstId();
+  uint32_t opCount = inst->getOpCount();
 
-      compiler->emit(kX86InstIdMov, fpReg, self->_zsp);
-    }
-  }
-  else {
-    compiler->emit(kX86InstIdPush, fpReg);
-    compiler->emit(kX86InstIdMov, fpReg, self->_zsp);
-  }
+  if ((X86Context_getFusibleClass(instId) & fusible) == 0 || opCount == 0)
+    return false;
 
-  if (!earlyPushPop) {
-    self->emitPushSequence(regsGp);
-    if (func->isStackMisaligned() && regsGp != 0)
-      useLeaEpilog = true;
+  if (inst->hasMemOp()) {
+    const Operand* opList = inst->getOpList();
+
+    if (opCount == 2 && opList[1].isImm())
+      return false;
+
+    if (opList[0].isMem() && instId != kX86InstIdCmp && instId != kX86InstIdTest)
+      return false;
   }
 
-  // Adjust stack pointer.
-  if (func->isStackAdjusted()) {
-    stackBase = static_cast<int32_t>(func->getAlignedMemStackSize() + func->getCallStackSize());
+  return true;
+}
 
-    if (stackSize)
-      compiler->emit(kX86InstIdSub, self->_zsp, stackSize);
+//! \internal
+//!
+//! Get whether `inst` can be reordered with a flags producer. It must not
+//! change the control flow or access registers implicitly.
+static bool X86Context_isTuneMovable(const HLInst* inst) {
+  uint32_t instId = inst->getInstId();
+  const X86InstExtendedInfo& extendedInfo = _x86InstInfo[instId].getExtendedInfo();
+
+  if (extendedInfo.isFlow() || extendedInfo.isSpecial() || extendedInfo.isVolatile())
+    return false;
+
+  return instId != kX86InstIdPush  &&
+         instId != kX86InstIdPop   &&
+         instId != kX86InstIdEnter &&
+         instId != kX86InstIdLeave;
+}
 
-    if (func->isStackMisaligned())
-      compiler->emit(kX86InstIdAnd, self->_zsp, -stackAlignment);
+//! \internal
+//!
+//! Get whether any operand of `inst` uses the GP register of `index`.
+static ASMJIT_INLINE bool X86Context_isGpUsedByInst(const HLInst* inst, uint32_t index) {
+  const Operand* opList = inst->getOpList();
+  uint32_t opCount = inst->getOpCount();
+
+  for (uint32_t i = 0; i < opCount; i++)
+    if (X86Context_isGpUsedBy(opList[i], index))
+      return true;
+  return false;
+}
 
-    if (func->isStackMisaligned() && func->isNaked())
-      compiler->emit(kX86InstIdMov, fpOffset, fpReg);
-  }
-  else {
-    stackBase = -static_cast<int32_t>(func->getAlignStackSize() + func->getMoveStackSize());
-  }
+//! \internal
+//!
+//! Get whether `a` and `b` can't be reordered, because they use the same GP
+//! register or both access memory.
+static bool X86Context_isTuneDependent(const HLInst* a, const HLInst* b) {
+  if (a->hasMemOp() && b->hasMemOp())
+    return true;
 
-  // Save XMM/MMX/GP (Mov).
-  stackPtr = stackBase;
-  for (i = 0, mask = regsXmm; mask != 0; i++, mask >>= 1) {
-    if (mask & 0x1) {
-      compiler->emit(kX86InstIdMovaps, x86::oword_ptr(self->_zsp, stackPtr), x86::xmm(i));
-      stackPtr += 16;
-    }
-  }
+  const Operand* opList = a->getOpList();
+  uint32_t opCount = a->getOpCount();
 
-  for (i = 0, mask = regsMm; mask != 0; i++, mask >>= 1) {
-    if (mask & 0x1) {
-      compiler->emit(kX86InstIdMovq, x86::qword_ptr(self->_zsp, stackPtr), x86::mm(i));
-      stackPtr += 8;
+  for (uint32_t i = 0; i < opCount; i++) {
+    const Operand& op = opList[i];
+
+    if (op.isReg()) {
+      const X86Reg& r = static_cast<const X86Reg&>(op);
+      if (r.isGp() && X86Context_isGpUsedByInst(b, r.getRegIndex()))
+        return true;
+    }
+    else if (op.isMem()) {
+      const X86Mem& m = static_cast<const X86Mem&>(op);
+      if (m.getMemType() == kMemTypeBaseIndex && m.hasBase() && X86Context_isGpUsedByInst(b, m.getBase()))
+        return true;
+      if (m.hasIndex() && X86Context_isGpUsedByInst(b, m.getIndex()))
+        return true;
     }
   }
 
-  // --------------------------------------------------------------------------
-  // [Move-Args]
-  // --------------------------------------------------------------------------
+  return false;
+}
 
-  if (func->hasFuncFlag(kFuncFlagX86MoveArgs)) {
-    uint32_t argStackPos = 0;
-    uint32_t argStackSize = decl->getArgStackSize();
+//! \internal
+//!
+//! Move the instruction producing flags read by `jcc` next to it, if it's
+//! separated by a few independent instructions that don't touch flags, so
+//! the pair is macro-fused by a CPU fusing `fusible` instructions. Then
+//! replace `cmp r, 0` by `test r, r`, AF is the only flag they set
+//! differently and it's not read by conditional jumps.
+static void X86Context_tuneJcc(X86Compiler* compiler, HLJump* jcc, uint32_t fusible) {
+  uint32_t flagsIn = _x86InstInfo[jcc->getInstId()].getEFlagsIn();
+  if (flagsIn == 0)
+    return;
 
-    uint32_t moveIndex = 0;
-    uint32_t moveCount = (argStackSize + regSize - 1) / regSize;
+  HLNode* node = jcc->getPrev();
+  uint32_t distance = 0;
 
-    X86GpReg r[8];
-    uint32_t numRegs = 0;
+  for (;;) {
+    if (node == nullptr)
+      return;
 
-    for (i = 0; i < ASMJIT_ARRAY_SIZE(func->_stackFrameCopyGpIndex); i++)
-      if (func->_stackFrameCopyGpIndex[i] != kInvalidReg)
-        r[numRegs++] = gpReg.setIndex(func->_stackFrameCopyGpIndex[i]);
-    ASMJIT_ASSERT(numRegs > 0);
+    uint32_t type = node->getType();
+    if (type == HLNode::kTypeComment || type == HLNode::kTypeHint) {
+      node = node->getPrev();
+      continue;
+    }
 
-    int32_t dSrc = func->getPushPopStackSize() + regSize;
-    int32_t dDst = func->getAlignStackSize() +
-                   func->getCallStackSize() +
-                   func->getAlignedMemStackSize() +
-                   func->getMoveStackSize();
+    if (type != HLNode::kTypeInst)
+      return;
+
+    HLInst* inst = static_cast<HLInst*>(node);
+    const X86InstInfo& info = _x86InstInfo[inst->getInstId()];
+
+    if (info.getEFlagsIn() != 0 || info.getEFlagsOut() != 0)
+      break;
 
-    if (func->isStackFrameRegPreserved())
-      dSrc += regSize;
+    if (!X86Context_isTuneMovable(inst) || ++distance > kX86TuneMaxFusionDistance)
+      return;
 
-    X86Mem mSrc = x86::ptr(fpReg, dSrc);
-    X86Mem mDst = x86::ptr(self->_zsp, dDst);
+    node = node->getPrev();
+  }
 
-    while (moveIndex < moveCount) {
-      uint32_t numMovs = Utils::iMin<uint32_t>(moveCount - moveIndex, numRegs);
+  HLInst* producer = static_cast<HLInst*>(node);
+  uint32_t instId = producer->getInstId();
+  const X86InstInfo& info = _x86InstInfo[instId];
 
-      for (i = 0; i < numMovs; i++)
-        compiler->emit(kX86InstIdMov, r[i], mSrc.adjusted((moveIndex + i) * regSize));
-      for (i = 0; i < numMovs; i++)
-        compiler->emit(kX86InstIdMov, mDst.adjusted((moveIndex + i) * regSize), r[i]);
+  if ((info.getEFlagsOut() & flagsIn) != flagsIn || info.getEFlagsIn() != 0 ||
+      (producer->getOptions() & kX86InstOptionLock) != 0) {
+    return;
+  }
 
-      argStackPos += numMovs * regSize;
-      moveIndex += numMovs;
+  if (distance != 0 && X86Context_isFusibleForm(producer, fusible)) {
+    for (node = producer->getNext(); node != jcc; node = node->getNext()) {
+      if (node->getType() == HLNode::kTypeInst && X86Context_isTuneDependent(producer, static_cast<HLInst*>(node)))
+        return;
     }
+
+    compiler->removeNode(producer);
+    compiler->addNodeBefore(producer, jcc);
+    distance = 0;
   }
 
-  // --------------------------------------------------------------------------
-  // [Epilog]
-  // --------------------------------------------------------------------------
+  Operand* opList = producer->getOpList();
+  if (distance == 0 && instId == kX86InstIdCmp && producer->getOpCount() == 2 &&
+      opList[0].isReg() && static_cast<X86Reg&>(opList[0]).isGp() &&
+      opList[1].isImm() && static_cast<Imm&>(opList[1]).getInt64() == 0) {
+    producer->setInstId(kX86InstIdTest);
+    opList[1] = opList[0];
+  }
+}
 
-  compiler->_setCursor(func->getExitNode());
+//! \internal
+//!
+//! Merge `mov a, b` followed by `add|sub a, c` into `lea a, [b + c]` if the
+//! flags produced by `add|sub` are not read. Updates `next` if it's the node
+//! removed.
+static bool X86Context_tuneMovAdd(X86Compiler* compiler, HLInst* node, HLNode*& next) {
+  Operand* opList = node->getOpList();
 
-  // Restore XMM/MMX/GP (Mov).
-  stackPtr = stackBase;
-  for (i = 0, mask = regsXmm; mask != 0; i++, mask >>= 1) {
-    if (mask & 0x1) {
-      compiler->emit(kX86InstIdMovaps, x86::xmm(i), x86::oword_ptr(self->_zsp, stackPtr));
-      stackPtr += 16;
-    }
+  X86Reg& a = static_cast<X86Reg&>(opList[0]);
+  X86Reg& b = static_cast<X86Reg&>(opList[1]);
+
+  if (b.getRegType() != a.getRegType() || b.getRegIndex() == a.getRegIndex())
+    return false;
+
+  HLNode* addNode = X86Context_nextCode(node);
+  if (addNode == nullptr || addNode->getType() != HLNode::kTypeInst)
+    return false;
+
+  HLInst* add = static_cast<HLInst*>(addNode);
+  uint32_t addId = add->getInstId();
+  Operand* addOps = add->getOpList();
+
+  if ((addId != kX86InstIdAdd && addId != kX86InstIdSub) || add->getOpCount() != 2 ||
+      !addOps[0].isReg() || static_cast<X86Reg&>(addOps[0]) != a) {
+    return false;
   }
 
-  for (i = 0, mask = regsMm; mask != 0; i++, mask >>= 1) {
-    if (mask & 0x1) {
-      compiler->emit(kX86InstIdMovq, x86::mm(i), x86::qword_ptr(self->_zsp, stackPtr));
-      stackPtr += 8;
+  // The address uses registers of the native size, which is shorter than
+  // 32-bit address in 64-bit mode and gives the same low 32 bits.
+  bool isGpq = compiler->getRegSize() == 8;
+  uint32_t bIndex = b.getRegIndex();
+  X86Mem m;
+
+  if (addOps[1].isReg()) {
+    X86Reg& c = static_cast<X86Reg&>(addOps[1]);
+    if (addId != kX86InstIdAdd || c.getRegType() != a.getRegType())
+      return false;
+
+    // After the `mov` the register `a` contains `b`.
+    uint32_t cIndex = c.getRegIndex() == a.getRegIndex() ? bIndex : c.getRegIndex();
+
+    // The stack pointer can't be used as an index.
+    if (cIndex == kX86RegIndexSp) {
+      if (bIndex == kX86RegIndexSp)
+        return false;
+      cIndex = bIndex;
+      bIndex = kX86RegIndexSp;
     }
+
+    m = isGpq ? x86::ptr(x86::gpq(bIndex), x86::gpq(cIndex))
+              : x86::ptr(x86::gpd(bIndex), x86::gpd(cIndex));
   }
+  else if (addOps[1].isImm()) {
+    int64_t disp = static_cast<Imm&>(addOps[1]).getInt64();
+    if (addId == kX86InstIdSub)
+      disp = -disp;
 
-  // Adjust stack.
-  if (useLeaEpilog) {
-    compiler->emit(kX86InstIdLea, self->_zsp, x86::ptr(fpReg, -static_cast<int32_t>(func->getPushPopStackSize())));
+    if (!Utils::isInt32(disp))
+      return false;
+
+    m = isGpq ? x86::ptr(x86::gpq(bIndex), static_cast<int32_t>(disp))
+              : x86::ptr(x86::gpd(bIndex), static_cast<int32_t>(disp));
   }
-  else if (!func->isStackMisaligned()) {
-    if (func->isStackAdjusted() && stackSize != 0)
-      compiler->emit(kX86InstIdAdd, self->_zsp, stackSize);
+  else {
+    return false;
   }
 
-  // Restore Gp (Push/Pop).
-  if (!earlyPushPop)
-    self->emitPopSequence(regsGp);
-
-  // Emms.
-  if (func->hasFuncFlag(kFuncFlagX86Emms))
-    compiler->emit(kX86InstIdEmms);
+  if (!X86Context_isFlagsDead(add))
+    return false;
 
-  // MFence/SFence/LFence.
-  if (func->hasFuncFlag(kFuncFlagX86SFence) & func->hasFuncFlag(kFuncFlagX86LFence))
-    compiler->emit(kX86InstIdMfence);
-  else if (func->hasFuncFlag(kFuncFlagX86SFence))
-    compiler->emit(kX86InstIdSfence);
-  else if (func->hasFuncFlag(kFuncFlagX86LFence))
-    compiler->emit(kX86InstIdLfence);
+  node->setInstId(kX86InstIdLea);
+  opList[1] = m;
+  node->_updateMemOp();
 
-  // Leave.
-  if (func->isNaked()) {
-    if (func->isStackMisaligned()) {
-      compiler->emit(kX86InstIdMov, self->_zsp, fpOffset);
+  if (next == add)
+    next = add->getNext();
+  compiler->removeNode(add);
+  return true;
+}
 
-      if (func->isStackFrameRegPreserved())
-        compiler->emit(kX86InstIdPop, fpReg);
+//! \internal
+//!
+//! Get whether `inst` uses a YMM or ZMM register.
+static bool X86Context_usesYmm(const HLInst* inst) {
+  const Operand* opList = inst->getOpList();
+  uint32_t opCount = inst->getOpCount();
 
-      if (earlyPushPop)
-        self->emitPopSequence(regsGp);
-    }
+  for (uint32_t i = 0; i < opCount; i++) {
+    const Operand& op = opList[i];
+    if (op.isReg() && (static_cast<const X86Reg&>(op).isYmm() || static_cast<const X86Reg&>(op).isZmm()))
+      return true;
   }
-  else {
-    if (useLeaEpilog) {
-      compiler->emit(kX86InstIdPop, fpReg);
-    }
-    else if (func->hasFuncFlag(kFuncFlagX86Leave)) {
-      compiler->emit(kX86InstIdLeave);
-    }
-    else {
-      compiler->emit(kX86InstIdMov, self->_zsp, fpReg);
-      compiler->emit(kX86InstIdPop, fpReg);
-    }
+
+  return false;
+}
+
+//! \internal
+//!
+//! Get whether `inst` is a legacy SSE instruction using an XMM register,
+//! which is slow while upper halves of YMM registers are not zero.
+static bool X86Context_isLegacySse(const HLInst* inst) {
+  const X86InstExtendedInfo& extendedInfo = _x86InstInfo[inst->getInstId()].getExtendedInfo();
+  const uint32_t kVexFlags =
+    kX86InstFlagAvx      | kX86InstFlagXop      |
+    kX86InstFlagAvx512F  | kX86InstFlagAvx512CD | kX86InstFlagAvx512PF |
+    kX86InstFlagAvx512ER | kX86InstFlagAvx512DQ | kX86InstFlagAvx512BW |
+    kX86InstFlagAvx512VL;
+
+  if ((extendedInfo.getFlags() & kVexFlags) != 0)
+    return false;
+
+  const Operand* opList = inst->getOpList();
+  uint32_t opCount = inst->getOpCount();
+
+  for (uint32_t i = 0; i < opCount; i++) {
+    const Operand& op = opList[i];
+    if (op.isReg() && static_cast<const X86Reg&>(op).isXmm())
+      return true;
   }
 
-  // Emit return.
-  if (decl->getCalleePopsStack())
-    compiler->emit(kX86InstIdRet, static_cast<int32_t>(decl->getArgStackSize()));
-  else
-    compiler->emit(kX86InstIdRet);
+  return false;
+}
 
-  return kErrorOk;
+//! \internal
+//!
+//! Get whether a variable wider than 128 bits is alive at `node`, `true` if
+//! it can't be determined (the node was inserted by the translator).
+static bool X86Context_isYmmAlive(X86Context* self, BitArray* live, HLNode* node) {
+  if (!self->getLiveness(live, node))
+    return true;
+
+  uint32_t vdCount = static_cast<uint32_t>(self->_contextVd.getLength());
+  for (uint32_t i = 0; i < vdCount; i++) {
+    if (live->getBit(i) && _x86VarInfo[self->_contextVd[i]->getType()].getSize() > 16)
+      return true;
+  }
+
+  return false;
 }
 
-// ============================================================================
-// [asmjit::X86Context - Translate - Jump]
-// ============================================================================
+//! \internal
+//!
+//! Get whether `call` can be preceded by `vzeroupper`, its arguments must
+//! not be wider than 128 bits.
+static bool X86Context_canZeroUpperAtCall(X86Context* self, BitArray* live, X86CallNode* call) {
+  X86FuncDecl* decl = call->getDecl();
+  uint32_t argCount = decl->getNumArgs();
+
+  for (uint32_t i = 0; i < argCount; i++) {
+    uint32_t varType = decl->getArg(i).getVarType();
+    if (varType < kX86VarTypeCount && _x86VarInfo[varType].getSize() > 16)
+      return false;
+  }
+
+  return !X86Context_isYmmAlive(self, live, call);
+}
 
 //! \internal
-static void X86Context_translateJump(X86Context* self, HLJump* jNode, HLLabel* jTarget) {
+//!
+//! Insert `vzeroupper` where legacy SSE code, a call, or the epilog follows
+//! 256-bit code, see `kX86TuneVZeroUpper`.
+//!
+//! The state of upper halves is propagated forward in the node order, a label
+//! is dirty if it's reached by a dirty jump, which is repeated until labels
+//! don't change, the last pass inserts `vzeroupper`. Functions that use YMM
+//! registers directly or contain indirect jumps are not changed.
+static Error X86Context_insertVZeroUpper(X86Context* self) {
   X86Compiler* compiler = self->getCompiler();
-  HLNode* extNode = self->getExtraBlock();
+  X86FuncNode* func = self->getFunc();
+  HLNode* stop = self->getStop();
 
-  compiler->_setCursor(extNode);
-  self->switchState(jTarget->getState());
+  if (self->_usesYmmRegs)
+    return kErrorOk;
 
-  // If one or more instruction has been added during switchState() it will be
-  // moved at the end of the function body.
-  if (compiler->getCursor() != extNode) {
-    // TODO: Can fail.
-    HLLabel* jTrampolineTarget = compiler->newLabelNode();
+  bool usesYmm = false;
+  HLNode* node_;
 
-    // Add the jump to the target.
-    compiler->jmp(jTarget->getLabel());
+  for (node_ = func; node_ != stop; node_ = node_->getNext()) {
+    if (node_->getType() != HLNode::kTypeInst)
+      continue;
 
-    // Add the trampoline-label we jump to change the state.
-    extNode = compiler->setCursor(extNode);
-    compiler->addNode(jTrampolineTarget);
+    HLInst* node = static_cast<HLInst*>(node_);
+    if (node->isJmpOrJcc() && static_cast<HLJump*>(node)->getTarget() == nullptr)
+      return kErrorOk;
 
-    // Finally, patch the jump target.
-    ASMJIT_ASSERT(jNode->getOpCount() > 0);
-    jNode->_opList[0] = jTrampolineTarget->getLabel();
-    jNode->_target = jTrampolineTarget;
+    if (X86Context_usesYmm(node))
+      usesYmm = true;
   }
 
-  // Store the `extNode` and load the state back.
-  self->setExtraBlock(extNode);
-  self->loadState(jNode->_state);
-}
+  if (!usesYmm)
+    return kErrorOk;
 
-// ============================================================================
-// [asmjit::X86Context - Translate - Ret]
-// ============================================================================
+  uint32_t vdCount = static_cast<uint32_t>(self->_contextVd.getLength());
+  uint32_t labelCount = static_cast<uint32_t>(compiler->getAssembler()->getLabelsCount());
 
-static Error X86Context_translateRet(X86Context* self, HLRet* rNode, HLLabel* exitTarget) {
-  X86Compiler* compiler = self->getCompiler();
-  HLNode* node = rNode->getNext();
+  BitArray* live = self->newBits((vdCount + BitArray::kEntityBits) / BitArray::kEntityBits);
+  BitArray* dirtyLabels = self->newBits((labelCount + BitArray::kEntityBits) / BitArray::kEntityBits);
 
-  // 32-bit mode requires to push floating point return value(s), handle it
-  // here as it's a special case.
-  X86VarMap* map = rNode->getMap<X86VarMap>();
-  if (map != nullptr) {
-    VarAttr* vaList = map->getVaList();
-    uint32_t vaCount = map->getVaCount();
+  if (live == nullptr || dirtyLabels == nullptr)
+    return compiler->setLastError(kErrorNoHeapMemory);
 
-    for (uint32_t i = 0; i < vaCount; i++) {
-      VarAttr& va = vaList[i];
-      if (va.hasFlag(kVarAttrX86Fld4 | kVarAttrX86Fld8)) {
-        VarData* vd = va.getVd();
-        X86Mem m(self->getVarMem(vd));
+  // A function returning a YMM or ZMM register must keep it.
+  X86FuncDecl* decl = func->getDecl();
+  uint32_t retType = decl->hasRet() ? decl->getRet(0).getVarType() : static_cast<uint32_t>(kInvalidVar);
+  bool zeroAtExit = retType >= kX86VarTypeCount || _x86VarInfo[retType].getSize() <= 16;
 
-        uint32_t flags = _x86VarInfo[vd->getType()].getFlags();
-        m.setSize(
-          (flags & VarInfo::kFlagSP) ? 4 :
-          (flags & VarInfo::kFlagDP) ? 8 :
-          va.hasFlag(kVarAttrX86Fld4) ? 4 : 8);
+  HLLabel* exitNode = func->getExitNode();
+  bool insert = false;
 
-        compiler->fld(m);
+  for (;;) {
+    bool changed = false;
+    bool dirty = false;
+
+    for (node_ = func; node_ != stop; node_ = node_->getNext()) {
+      switch (node_->getType()) {
+        case HLNode::kTypeLabel: {
+          HLLabel* node = static_cast<HLLabel*>(node_);
+          if (dirtyLabels->getBit(node->getLabelId()))
+            dirty = true;
+
+          if (node == exitNode && dirty && zeroAtExit) {
+            if (insert) {
+              HLInst* vzeroupper = compiler->newInst(kX86InstIdVzeroupper);
+              if (vzeroupper == nullptr)
+                return compiler->getLastError();
+              compiler->addNodeAfter(vzeroupper, node);
+            }
+            dirty = false;
+          }
+          break;
+        }
+
+        case HLNode::kTypeCall: {
+          X86CallNode* node = static_cast<X86CallNode*>(node_);
+
+          if (dirty && X86Context_canZeroUpperAtCall(self, live, node) && insert) {
+            HLInst* vzeroupper = compiler->newInst(kX86InstIdVzeroupper);
+            if (vzeroupper == nullptr)
+              return compiler->getLastError();
+            compiler->addNodeBefore(vzeroupper, node);
+          }
+
+          // The called function returns with zeroed upper halves.
+          dirty = false;
+          break;
+        }
+
+        case HLNode::kTypeInst: {
+          HLInst* node = static_cast<HLInst*>(node_);
+          uint32_t instId = node->getInstId();
+
+          if (instId == kX86InstIdVzeroupper || instId == kX86InstIdVzeroall) {
+            dirty = false;
+            break;
+          }
+
+          if (X86Context_usesYmm(node)) {
+            dirty = true;
+          }
+          else if (dirty && X86Context_isLegacySse(node) && !X86Context_isYmmAlive(self, live, node)) {
+            if (insert) {
+              // Loads and spills inserted by the translator before the node
+              // would be executed with dirty upper halves too.
+              HLNode* ref = node;
+              HLNode* prev = ref->getPrev();
+
+              while (prev->getType() == HLNode::kTypeInst && self->getBlockOf(prev) == nullptr &&
+                     !prev->isJmpOrJcc() && !X86Context_usesYmm(static_cast<HLInst*>(prev))) {
+                ref = prev;
+                prev = prev->getPrev();
+              }
+
+              HLInst* vzeroupper = compiler->newInst(kX86InstIdVzeroupper);
+              if (vzeroupper == nullptr)
+                return compiler->getLastError();
+              compiler->addNodeBefore(vzeroupper, ref);
+            }
+            dirty = false;
+          }
+
+          if (node->isJmpOrJcc()) {
+            uint32_t labelId = static_cast<HLJump*>(node)->getTarget()->getLabelId();
+            if (dirty && !dirtyLabels->getBit(labelId)) {
+              dirtyLabels->setBit(labelId);
+              changed = true;
+            }
+
+            if (node->isJmp())
+              dirty = false;
+          }
+          else if (instId == kX86InstIdRet) {
+            dirty = false;
+          }
+          break;
+        }
       }
     }
+
+    if (insert)
+      break;
+
+    if (!changed)
+      insert = true;
   }
 
-  // Decide whether to `jmp` or not in case we are next to the return label.
-  while (node != nullptr) {
-    switch (node->getType()) {
-      // If we have found an exit label we just return, there is no need to
-      // emit jump to that.
-      case HLNode::kTypeLabel:
-        if (static_cast<HLLabel*>(node) == exitTarget)
-          return kErrorOk;
-        goto _EmitRet;
+  return kErrorOk;
+}
 
-      case HLNode::kTypeData:
-      case HLNode::kTypeInst:
-      case HLNode::kTypeCall:
-      case HLNode::kTypeRet:
-        goto _EmitRet;
+Error X86Context::tuneVars() {
+  X86Compiler* compiler = getCompiler();
+  uint32_t options = compiler->getTuneOptions();
 
-      // Continue iterating.
-      case HLNode::kTypeComment:
-      case HLNode::kTypeAlign:
-      case HLNode::kTypeHint:
-        break;
+  if (options == 0)
+    return kErrorOk;
 
-      // Invalid node to be here.
-      case HLNode::kTypeFunc:
-        return self->getCompiler()->setLastError(kErrorInvalidState);
+  const X86TuneInfo& tuneInfo = compiler->getTuneInfo();
+  bool partialRegs = (options & kX86TunePartialRegs) != 0 && tuneInfo.partialRegPenalty != 0;
 
-      // We can't go forward from here.
-      case HLNode::kTypeSentinel:
-        return kErrorOk;
+  HLNode* node_ = getFunc();
+  HLNode* stop = getStop();
+
+  for (; node_ != stop; node_ = node_->getNext()) {
+    if (node_->getType() != HLNode::kTypeInst)
+      continue;
+
+    HLInst* node = static_cast<HLInst*>(node_);
+    uint32_t opCount = node->getOpCount();
+    Operand* opList = node->getOpList();
+
+    for (uint32_t i = 0; i < opCount; i++) {
+      const Operand& op = opList[i];
+      if (op.isReg() && (static_cast<const X86Reg&>(op).isYmm() || static_cast<const X86Reg&>(op).isZmm()))
+        _usesYmmRegs = true;
     }
 
-    node = node->getNext();
-  }
+    if (!partialRegs || node->getInstId() != kX86InstIdMov || opCount != 2 || !opList[0].isVar())
+      continue;
 
-_EmitRet:
-  {
-    compiler->_setCursor(rNode);
-    compiler->jmp(exitTarget->getLabel());
+    // Only variables of the same size, wider variables may use the rest of
+    // the register.
+    X86GpVar& dst = static_cast<X86GpVar&>(opList[0]);
+    if (!dst.isGpbLo() && !dst.isGpw())
+      continue;
+
+    uint32_t size = dst.getSize();
+    if (compiler->getVdById(dst.getId())->getSize() != size)
+      continue;
+
+    Operand& src = opList[1];
+    if (src.isMem()) {
+      X86Mem& m = static_cast<X86Mem&>(src);
+      if (m.getSize() == 0)
+        m.setSize(size);
+      else if (m.getSize() != size)
+        continue;
+
+      node->setInstId(kX86InstIdMovzx);
+      opList[0] = dst.r32();
+    }
+    else if (src.isVar() || src.isReg()) {
+      if (!static_cast<X86Var&>(src).isGp() || src.getSize() != size)
+        continue;
+
+      node->setInstId(kX86InstIdMovzx);
+      opList[0] = dst.r32();
+    }
+    else if (src.isImm() && tuneInfo.partialRegPenalty > 1) {
+      // A 32-bit immediate is longer, only worth it if the penalty is high.
+      uint32_t mask = size == 1 ? 0xFFU : 0xFFFFU;
+      src = imm_u(static_cast<Imm&>(src).getUInt32() & mask);
+      opList[0] = dst.r32();
+    }
   }
+
   return kErrorOk;
 }
 
-// ============================================================================
-// [asmjit::X86Context - Translate - Func]
-// ============================================================================
+Error X86Context::tune() {
+  X86Compiler* compiler = getCompiler();
+  uint32_t options = compiler->getTuneOptions();
 
-Error X86Context::translate() {
-  ASMJIT_TLOG("[T] ======= Translate (Begin)\n");
+  if (options == 0)
+    return kErrorOk;
 
-  X86Compiler* compiler = getCompiler();
-  X86FuncNode* func = getFunc();
+  const X86TuneInfo& tuneInfo = compiler->getTuneInfo();
 
-  // Register allocator contexts.
-  X86VarAlloc vAlloc(this);
-  X86CallAlloc cAlloc(this);
+  if ((options & kX86TuneVZeroUpper) != 0 && tuneInfo.avxSseTransition > tuneInfo.vzeroupperCost)
+    ASMJIT_PROPAGATE_ERROR(X86Context_insertVZeroUpper(this));
 
-  // Flow.
-  HLNode* node_ = func;
-  HLNode* next = nullptr;
+  bool splitLea = tuneInfo.leaComplexLatency > tuneInfo.leaLatency + tuneInfo.aluLatency;
+  bool preferAdd = tuneInfo.leaLatency > tuneInfo.aluLatency;
+
+  HLNode* node_ = getFunc();
   HLNode* stop = getStop();
 
-  PodList<HLNode*>::Link* jLink = _jccList.getFirst();
+  while (node_ != stop) {
+    HLNode* next = node_->getNext();
 
-  for (;;) {
-    while (node_->isTranslated()) {
-      // Switch state if we went to the already translated node.
-      if (node_->getType() == HLNode::kTypeLabel) {
-        HLLabel* node = static_cast<HLLabel*>(node_);
-        compiler->_setCursor(node->getPrev());
-        switchState(node->getState());
-      }
+    if (node_->getType() != HLNode::kTypeInst) {
+      node_ = next;
+      continue;
+    }
 
-_NextGroup:
-      if (jLink == nullptr) {
-        goto _Done;
-      }
-      else {
-        node_ = jLink->getValue();
-        jLink = jLink->getNext();
+    HLInst* node = static_cast<HLInst*>(node_);
+    uint32_t instId = node->getInstId();
+    uint32_t opCount = node->getOpCount();
+    Operand* opList = node->getOpList();
 
-        HLNode* jFlow = X86Context_getOppositeJccFlow(static_cast<HLJump*>(node_));
-        loadState(node_->getState());
+    if (node->isJcc()) {
+      if ((options & kX86TuneFusion) != 0)
+        X86Context_tuneJcc(compiler, static_cast<HLJump*>(node), tuneInfo.fusible);
 
-        if (jFlow->getState()) {
-          X86Context_translateJump(this,
-            static_cast<HLJump*>(node_),
-            static_cast<HLLabel*>(jFlow));
+      node_ = next;
+      continue;
+    }
 
-          node_ = jFlow;
-          if (node_->isTranslated())
-            goto _NextGroup;
-        }
-        else {
-          node_ = jFlow;
+    switch (instId) {
+      case kX86InstIdMov: {
+        if (opCount != 2 || !opList[0].isReg())
+          break;
+
+        X86Reg& r = static_cast<X86Reg&>(opList[0]);
+        if (!r.isGpd() && !r.isGpq())
+          break;
+
+        // Zero idiom, `xor r32, r32` also clears the high part.
+        if (opList[1].isImm()) {
+          if ((options & kX86TuneZeroIdioms) != 0 && static_cast<Imm&>(opList[1]).getInt64() == 0 && X86Context_isFlagsDead(node)) {
+            X86GpReg z = x86::gpd(r.getRegIndex());
+
+            node->setInstId(kX86InstIdXor);
+            opList[0] = z;
+            opList[1] = z;
+          }
+          break;
         }
 
+        if ((options & kX86TuneLea) != 0 && !preferAdd && opList[1].isReg())
+          X86Context_tuneMovAdd(compiler, node, next);
         break;
       }
-    }
 
-    next = node_->getNext();
-    node_->orFlags(HLNode::kFlagIsTranslated);
-
-    ASMJIT_TSEC({
-      this->_traceNode(this, node_, "[T] ");
-    });
+      case kX86InstIdSub:
+      case kX86InstIdXor: {
+        if ((options & kX86TuneZeroIdioms) == 0 || opCount != 2 || !opList[0].isReg() || !opList[1].isReg())
+          break;
 
-    switch (node_->getType()) {
-      // ----------------------------------------------------------------------
-      // [Align / Embed]
-      // ----------------------------------------------------------------------
+        X86Reg& r = static_cast<X86Reg&>(opList[0]);
+        if ((!r.isGpd() && !r.isGpq()) || r != static_cast<X86Reg&>(opList[1]))
+          break;
 
-      case HLNode::kTypeAlign:
-      case HLNode::kTypeData:
-        break;
+        // `xor r64, r64` sets the same flags as `xor r32, r32`, `sub` differs
+        // in undefined AF.
+        if (instId == kX86InstIdXor && !r.isGpq())
+          break;
 
-      // ----------------------------------------------------------------------
-      // [Target]
-      // ----------------------------------------------------------------------
+        if (instId == kX86InstIdSub && !X86Context_isFlagsDead(node))
+          break;
 
-      case HLNode::kTypeLabel: {
-        HLLabel* node = static_cast<HLLabel*>(node_);
-        ASMJIT_ASSERT(!node->hasState());
-        node->setState(saveState());
+        X86GpReg z = x86::gpd(r.getRegIndex());
+        node->setInstId(kX86InstIdXor);
+        opList[0] = z;
+        opList[1] = z;
         break;
       }
 
-      // ----------------------------------------------------------------------
-      // [Inst/Call/SArg/Ret]
-      // ----------------------------------------------------------------------
+      case kX86InstIdVxorps:
+      case kX86InstIdVxorpd:
+      case kX86InstIdVpxor: {
+        if ((options & kX86TuneZeroIdioms) == 0 || !tuneInfo.ymmZeroSplit || opCount != 3 || node->getOptions() != 0)
+          break;
 
-      case HLNode::kTypeInst:
-      case HLNode::kTypeCall:
-      case HLNode::kTypeCallArg:
-        // Update VarAttr's unuse flags based on liveness of the next node.
-        if (!node_->isJcc()) {
-          X86VarMap* map = static_cast<X86VarMap*>(node_->getMap());
-          BitArray* liveness;
+        if (!opList[0].isReg() || !opList[1].isReg() || !opList[2].isReg())
+          break;
 
-          if (map != nullptr && next != nullptr && (liveness = next->getLiveness()) != nullptr) {
-            VarAttr* vaList = map->getVaList();
-            uint32_t vaCount = map->getVaCount();
+        // VEX encoded 128-bit instruction zeroes the upper half as well.
+        X86Reg& r = static_cast<X86Reg&>(opList[0]);
+        if (!r.isYmm() || r.getRegIndex() >= 16 ||
+            r != static_cast<X86Reg&>(opList[1]) ||
+            r != static_cast<X86Reg&>(opList[2])) {
+          break;
+        }
 
-            for (uint32_t i = 0; i < vaCount; i++) {
-              VarAttr* va = &vaList[i];
-              VarData* vd = va->getVd();
+        X86XmmReg x = x86::xmm(r.getRegIndex());
+        opList[0] = x;
+        opList[1] = x;
+        opList[2] = x;
+        break;
+      }
 
-              if (!liveness->getBit(vd->getLocalId()))
-                va->orFlags(kVarAttrUnuse);
-            }
-          }
-        }
+      case kX86InstIdLea: {
+        if ((options & kX86TuneLea) == 0 || opCount != 2 || !opList[0].isReg() || !opList[1].isMem())
+          break;
 
-        if (node_->getType() == HLNode::kTypeCall) {
-          ASMJIT_PROPAGATE_ERROR(cAlloc.run(static_cast<X86CallNode*>(node_)));
+        X86Reg& d = static_cast<X86Reg&>(opList[0]);
+        X86Mem& m = static_cast<X86Mem&>(opList[1]);
+
+        if ((!d.isGpd() && !d.isGpq()) || m.getMemType() != kMemTypeBaseIndex || !m.hasBase() ||
+            m.hasSegment() || m.getVSib() != 0) {
           break;
         }
-        ASMJIT_FALLTHROUGH;
 
-      case HLNode::kTypeHint:
-      case HLNode::kTypeRet: {
-        ASMJIT_PROPAGATE_ERROR(vAlloc.run(node_));
+        // A 64-bit destination needs a 64-bit address, a 32-bit destination
+        // only uses the low 32 bits of any address.
+        if (d.isGpq() && m.hasGpdBase())
+          break;
 
-        // Handle conditional/unconditional jump.
-        if (node_->isJmpOrJcc()) {
-          HLJump* node = static_cast<HLJump*>(node_);
-          HLLabel* jTarget = node->getTarget();
+        uint32_t dIndex = d.getRegIndex();
+        int32_t disp = m.getDisplacement();
 
-          // Target not followed.
-          if (jTarget == nullptr) {
-            if (node->isJmp())
-              goto _NextGroup;
-            else
+        if (m.hasIndex()) {
+          // `lea d, [b + i * s + disp]` -> `lea d, [b + i * s]` + `add d, disp`.
+          if (disp != 0 && splitLea) {
+            if (!X86Context_isFlagsDead(node))
               break;
-          }
 
-          if (node->isJmp()) {
-            if (jTarget->hasState()) {
-              compiler->_setCursor(node->getPrev());
-              switchState(jTarget->getState());
+            HLInst* add = compiler->newInst(kX86InstIdAdd, d, Imm(disp));
+            if (add == nullptr)
+              return compiler->getLastError();
 
-              goto _NextGroup;
-            }
-            else {
-              next = jTarget;
-            }
+            m.resetDisplacement();
+            compiler->addNodeAfter(add, node);
           }
-          else {
-            HLNode* jNext = node->getNext();
-
-            if (jTarget->isTranslated()) {
-              if (jNext->isTranslated()) {
-                ASMJIT_ASSERT(jNext->getType() == HLNode::kTypeLabel);
-                compiler->_setCursor(node->getPrev());
-                intersectStates(jTarget->getState(), jNext->getState());
-              }
-
-              VarState* savedState = saveState();
-              node->setState(savedState);
-
-              X86Context_translateJump(this, node, jTarget);
-              next = jNext;
-            }
-            else if (jNext->isTranslated()) {
-              ASMJIT_ASSERT(jNext->getType() == HLNode::kTypeLabel);
-
-              VarState* savedState = saveState();
-              node->setState(savedState);
+          // `lea a, [a + b]` -> `add a, b`.
+          else if (disp == 0 && !m.hasShift() && preferAdd && (m.getBase() == dIndex || m.getIndex() == dIndex)) {
+            if (!X86Context_isFlagsDead(node))
+              break;
 
-              compiler->_setCursor(node);
-              switchState(static_cast<HLLabel*>(jNext)->getState());
-              next = jTarget;
-            }
-            else {
-              node->setState(saveState());
-              next = X86Context_getJccFlow(node);
-            }
+            uint32_t other = m.getBase() == dIndex ? m.getIndex() : m.getBase();
+            node->setInstId(kX86InstIdAdd);
+            opList[1] = d.isGpq() ? X86GpReg(x86::gpq(other)) : X86GpReg(x86::gpd(other));
+            node->_updateMemOp();
           }
         }
-        else if (node_->isRet()) {
-          ASMJIT_PROPAGATE_ERROR(
-            X86Context_translateRet(this, static_cast<HLRet*>(node_), func->getExitNode()));
+        // `lea a, [a + disp]` -> `add a, disp`.
+        else if (disp != 0 && m.getBase() == dIndex && preferAdd) {
+          if (!X86Context_isFlagsDead(node))
+            break;
+
+          node->setInstId(kX86InstIdAdd);
+          opList[1] = Imm(disp);
+          node->_updateMemOp();
         }
         break;
       }
+    }
 
-      // ----------------------------------------------------------------------
-      // [Func]
-      // ----------------------------------------------------------------------
+    node_ = next;
+  }
 
-      case HLNode::kTypeFunc: {
-        ASMJIT_ASSERT(node_ == func);
+  return kErrorOk;
+}
 
-        X86FuncDecl* decl = func->getDecl();
-        X86VarMap* map = func->getMap<X86VarMap>();
+// ============================================================================
+// [asmjit::X86Context - Serialize]
+// ============================================================================
 
-        if (map != nullptr) {
-          uint32_t i;
-          uint32_t argCount = func->_x86Decl.getNumArgs();
+//! \internal
+//!
+//! Get whether the label `node` is targeted by a jump that follows it.
+//!
+//! NOTE: Flow ids have to be assigned in the order of nodes, see `serialize()`.
+static ASMJIT_INLINE bool X86Context_isLoopHeader(HLLabel* node) {
+  uint32_t flowId = node->getFlowId();
 
-          for (i = 0; i < argCount; i++) {
-            const FuncInOut& arg = decl->getArg(i);
+  for (HLJump* jNode = node->getFrom(); jNode != nullptr; jNode = jNode->getJumpNext()) {
+    if (jNode->getTarget() == node && jNode->getFlowId() > flowId)
+      return true;
+  }
 
-            VarData* vd = func->getArg(i);
-            if (vd == nullptr)
-              continue;
+  return false;
+}
 
-            VarAttr* va = map->findVa(vd);
-            ASMJIT_ASSERT(va != nullptr);
+//! \internal
+//!
+//! Get whether `instId` can be macro-fused with a following conditional jump.
+static ASMJIT_INLINE bool X86Context_isFusible(uint32_t instId) {
+  switch (instId) {
+    case kX86InstIdAdd:
+    case kX86InstIdAnd:
+    case kX86InstIdCmp:
+    case kX86InstIdDec:
+    case kX86InstIdInc:
+    case kX86InstIdSub:
+    case kX86InstIdTest:
+      return true;
 
-            if (va->getFlags() & kVarAttrUnuse)
-              continue;
+    default:
+      return false;
+  }
+}
 
-            uint32_t regIndex = va->getOutRegIndex();
-            if (regIndex != kInvalidReg && (va->getFlags() & kVarAttrWConv) == 0) {
-              switch (vd->getClass()) {
-                case kX86RegClassGp : attach<kX86RegClassGp >(vd, regIndex, true); break;
-                case kX86RegClassMm : attach<kX86RegClassMm >(vd, regIndex, true); break;
-                case kX86RegClassXyz: attach<kX86RegClassXyz>(vd, regIndex, true); break;
-              }
-            }
-            else if (va->hasFlag(kVarAttrWConv)) {
-              // TODO: [COMPILER] Function Argument Conversion.
-              ASMJIT_NOT_REACHED();
-            }
-            else {
-              vd->_isMemArg = true;
-              vd->setMemOffset(arg.getStackOffset());
-              vd->setState(kVarStateMem);
-            }
-          }
-        }
-        break;
-      }
+//! \internal
+//!
+//! Get the size of a jump `node` to a label emitted at `offset`, mirrors the
+//! form selection done by `X86Assembler`.
+static uint32_t X86Context_getJumpSize(X86Assembler* assembler, HLInst* node, size_t offset) {
+  uint32_t instId = node->getInstId();
+  uint32_t options = node->getOptions();
+
+  uint32_t prefixSize = 0;
+  uint32_t longSize = 5;
+
+  if (instId != kX86InstIdJmp) {
+    longSize = 6;
+    if (assembler->hasAsmOption(Assembler::kOptionPredictedJumps))
+      prefixSize = ((options & kInstOptionTaken) != 0) + ((options & kInstOptionNotTaken) != 0);
+  }
 
-      // ----------------------------------------------------------------------
-      // [End]
-      // ----------------------------------------------------------------------
+  const Label& label = static_cast<const Label&>(node->getOpList()[0]);
+  LabelData* data = assembler->getLabelData(label.getId());
 
-      case HLNode::kTypeSentinel: {
-        goto _NextGroup;
-      }
+  if (data->offset != -1) {
+    intptr_t offs = data->offset - static_cast<intptr_t>(offset + prefixSize);
+    if ((options & kInstOptionLongForm) == 0 && Utils::isInt8(offs - 2))
+      return prefixSize + 2;
+  }
+  else if ((options & kInstOptionShortForm) != 0) {
+    return prefixSize + 2;
+  }
 
-      default:
-        break;
-    }
+  return prefixSize + longSize;
+}
+
+//! \internal
+//!
+//! Get the size of an instruction by emitting it to `assembler` and rewinding
+//! the code-buffer back. Nothing is logged or reported while measuring.
+//!
+//! Returns zero if the instruction refers to a label, which would be linked
+//! by the emit, or if the instruction can't be encoded.
+static uint32_t X86Context_measureInst(X86Assembler* assembler, uint32_t instId, uint32_t options,
+  const Operand& o0, const Operand& o1, const Operand& o2, const Operand& o3) {
+
+  const Operand* opList[4] = { &o0, &o1, &o2, &o3 };
+  for (uint32_t i = 0; i < 4; i++) {
+    const Operand* op = opList[i];
+    if (op->isLabel() || (op->isMem() && static_cast<const BaseMem*>(op)->getMemType() == kMemTypeLabel))
+      return 0;
+  }
+
+  // Grow first so the instruction can't start a new chunk, which would make
+  // the rewind flatten the code-buffer.
+  if (assembler->getRemainingSpace() < 16 && assembler->_grow(16) != kErrorOk)
+    return 0;
+
+  size_t offset = assembler->getOffset();
+  size_t relocCount = assembler->_relocations.getLength();
+  uint32_t trampolinesSize = assembler->_trampolinesSize;
+  uint32_t lastError = assembler->_lastError;
+  const char* comment = assembler->_comment;
+  ErrorHandler* errorHandler = assembler->_errorHandler;
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  Logger* logger = assembler->_logger;
+  assembler->_logger = nullptr;
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  assembler->_errorHandler = nullptr;
+  assembler->_instOptions = options;
+
+  uint32_t size = 0;
+  if (assembler->emit(instId, o0, o1, o2, o3) == kErrorOk)
+    size = static_cast<uint32_t>(assembler->getOffset() - offset);
 
-    if (next == stop)
-      goto _NextGroup;
-    node_ = next;
-  }
+  assembler->setOffset(offset);
+  assembler->_relocations.truncate(relocCount);
+  assembler->_trampolinesSize = trampolinesSize;
+  assembler->_lastError = lastError;
+  assembler->_comment = comment;
+  assembler->_errorHandler = errorHandler;
 
-_Done:
-  ASMJIT_PROPAGATE_ERROR(X86Context_initFunc(this, func));
-  ASMJIT_PROPAGATE_ERROR(X86Context_patchFuncMem(this, func, stop));
-  ASMJIT_PROPAGATE_ERROR(X86Context_translatePrologEpilog(this, func));
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  assembler->_logger = logger;
+#endif // !ASMJIT_DISABLE_LOGGER
 
-  ASMJIT_TLOG("[T] ======= Translate (End)\n");
-  return kErrorOk;
+  assembler->_instOptions = options;
+  return size;
 }
 
-// ============================================================================
-// [asmjit::X86Context - Serialize]
-// ============================================================================
+//! \internal
+//!
+//! Pad the code so `size` bytes emitted next don't cross or end at `boundary`.
+static ASMJIT_INLINE void X86Context_alignJump(X86Assembler* assembler, uint32_t size, uint32_t boundary) {
+  size_t offset = assembler->getOffset();
+  if (size != 0 && offset / boundary != (offset + size) / boundary)
+    assembler->align(kAlignCode, boundary);
+}
 
 Error X86Context::serialize(Assembler* assembler_, HLNode* start, HLNode* stop) {
   X86Assembler* assembler = static_cast<X86Assembler*>(assembler_);
   HLNode* node_ = start;
 
+  X86Compiler* compiler = getCompiler();
+  uint32_t loopAlign = compiler->getLoopAlign();
+  uint32_t jumpBoundary = compiler->getJumpBoundary();
+
+  // Flow ids are no longer needed, renumber them in the order of nodes so
+  // backward jumps can be found by `X86Context_isLoopHeader()`.
+  if (loopAlign != 0) {
+    uint32_t flowId = 0;
+    do {
+      node_->setFlowId(++flowId);
+      node_ = node_->getNext();
+    } while (node_ != stop);
+    node_ = start;
+  }
+
 #if !defined(ASMJIT_DISABLE_LOGGER)
   Logger* logger = assembler->getLogger();
 #endif // !ASMJIT_DISABLE_LOGGER
@@ -5725,6 +8976,8 @@ Error X86Context::serialize(Assembler* assembler_, HLNode* start, HLNode* stop)
 
       case HLNode::kTypeLabel: {
         HLLabel* node = static_cast<HLLabel*>(node_);
+        if (loopAlign != 0 && X86Context_isLoopHeader(node))
+          assembler->align(kAlignCode, loopAlign);
         assembler->bind(node->getLabel());
         break;
       }
@@ -5881,6 +9134,35 @@ Error X86Context::serialize(Assembler* assembler_, HLNode* start, HLNode* stop)
           if (opCount > 3) o3 = &opList[3];
         }
 
+        if (jumpBoundary != 0) {
+          uint32_t size = 0;
+
+          if (Utils::inInterval<uint32_t>(instId, kX86InstIdJa, kX86InstIdJz) || instId == kX86InstIdJmp) {
+            size = o0->isLabel()
+              ? X86Context_getJumpSize(assembler, node, assembler->getOffset())
+              : X86Context_measureInst(assembler, instId, node->getOptions(), *o0, *o1, *o2, *o3);
+          }
+          else if (instId == kX86InstIdCall || instId == kX86InstIdRet) {
+            size = X86Context_measureInst(assembler, instId, node->getOptions(), *o0, *o1, *o2, *o3);
+          }
+          else if (X86Context_isFusible(instId)) {
+            HLNode* next = node->getNext();
+            while (next != stop && (next->getType() == HLNode::kTypeComment || next->getType() == HLNode::kTypeHint))
+              next = next->getNext();
+
+            if (next != stop && next->getType() == HLNode::kTypeInst) {
+              HLInst* jNode = static_cast<HLInst*>(next);
+              if (Utils::inInterval<uint32_t>(jNode->getInstId(), kX86InstIdJa, kX86InstIdJz) && jNode->getOpList()[0].isLabel()) {
+                size = X86Context_measureInst(assembler, instId, node->getOptions(), *o0, *o1, *o2, *o3);
+                if (size != 0)
+                  size += X86Context_getJumpSize(assembler, jNode, assembler->getOffset() + size);
+              }
+            }
+          }
+
+          X86Context_alignJump(assembler, size, jumpBoundary);
+        }
+
         // Should call _emit() directly as 4 operand form is the main form.
         assembler->emit(instId, *o0, *o1, *o2, *o3);
         break;
@@ -5898,6 +9180,14 @@ Error X86Context::serialize(Assembler* assembler_, HLNode* start, HLNode* stop)
       // the call instruction by itself.
       case HLNode::kTypeCall: {
         X86CallNode* node = static_cast<X86CallNode*>(node_);
+
+        if (jumpBoundary != 0) {
+          uint32_t size = node->_target.isLabel()
+            ? 5
+            : X86Context_measureInst(assembler, kX86InstIdCall, 0, node->_target, noOperand, noOperand, noOperand);
+          X86Context_alignJump(assembler, size, jumpBoundary);
+        }
+
         assembler->emit(kX86InstIdCall, node->_target, noOperand, noOperand);
         break;
       }
@@ -5912,6 +9202,908 @@ Error X86Context::serialize(Assembler* assembler_, HLNode* start, HLNode* stop)
   return kErrorOk;
 }
 
+// ============================================================================
+// [asmjit::X86Context - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST)
+UNIT(x86_compiler_cfg) {
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Compiler c(&a);
+
+  c.addFunc(FuncBuilder2<int, int, int>(kCallConvHost));
+
+  X86GpVar x = c.newInt32("x");
+  X86GpVar y = c.newInt32("y");
+  X86GpVar i = c.newInt32("i");
+  X86GpVar j = c.newInt32("j");
+  X86GpVar sum = c.newInt32("sum");
+
+  Label L_Outer = c.newLabel();
+  Label L_Inner = c.newLabel();
+  Label L_Exit = c.newLabel();
+
+  c.setArg(0, x);
+  c.setArg(1, y);
+  c.xor_(sum, sum);
+  c.test(x, x);
+  c.jz(L_Exit);
+  c.mov(i, x);
+
+  c.bind(L_Outer);
+  c.mov(j, y);
+
+  c.bind(L_Inner);
+  c.add(sum, i);
+  c.dec(j);
+  c.jnz(L_Inner);
+
+  c.dec(i);
+  c.jnz(L_Outer);
+
+  c.bind(L_Exit);
+  c.ret(sum);
+  c.endFunc();
+
+  HLFunc* func = static_cast<HLFunc*>(c.getFirstNode());
+  EXPECT(func->getType() == HLNode::kTypeFunc,
+    "The first node should be a function.");
+
+  X86Context context(&c);
+  EXPECT(context.compile(static_cast<X86FuncNode*>(func)) == kErrorOk,
+    "Couldn't compile the function.");
+
+  BasicBlock* entry = context.getBlock(0);
+  BasicBlock* outer = context.getBlockOf(c.getHLLabel(L_Outer));
+  BasicBlock* inner = context.getBlockOf(c.getHLLabel(L_Inner));
+  BasicBlock* exit = context.getBlockOf(c.getHLLabel(L_Exit));
+
+  EXPECT(entry->getFirst() == func && entry->getIDom() == nullptr,
+    "The function node should start the entry block.");
+  EXPECT(outer != nullptr && inner != nullptr && exit != nullptr,
+    "Bound labels should start basic blocks.");
+
+  INFO("Checking dominators.");
+  EXPECT(entry->dominates(outer) && entry->dominates(exit),
+    "The entry block should dominate all blocks.");
+  EXPECT(outer->dominates(inner) && !inner->dominates(outer),
+    "The outer loop header should dominate the inner loop.");
+  EXPECT(!outer->dominates(exit) && exit->getIDom() == context.getBlockOf(func->getEntryNode()),
+    "The exit is reachable around both loops.");
+
+  INFO("Checking loops.");
+  EXPECT(entry->getLoopDepth() == 0 && exit->getLoopDepth() == 0,
+    "Blocks outside of loops should have zero loop depth.");
+  EXPECT(outer->isLoopHeader() && outer->getLoopDepth() == 1,
+    "The outer loop header should have loop depth 1.");
+  EXPECT(inner->isLoopHeader() && inner->getLoopDepth() == 2,
+    "The inner loop header should have loop depth 2.");
+
+  context.cleanup();
+  context.reset(true);
+}
+
+static int X86Context_lsTestCall(int a, int b) {
+  return static_cast<int>(static_cast<uint32_t>(a) * 3U + static_cast<uint32_t>(b));
+}
+
+UNIT(x86_compiler_linear_scan) {
+  // Many variables live across calls and shifts by a variable count. An
+  // interval that evicts another one is split at the next fixed use of the
+  // register as well, which queues more intervals than the function has.
+  enum { kVarCount = 112, kStepCount = 240 };
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Compiler c(&a);
+
+  c.setFeature(kCompilerFeatureLinearScan, true);
+  c.addFunc(FuncBuilder0<int>(kCallConvHost));
+
+  X86GpVar v[kVarCount];
+  uint32_t values[kVarCount];
+
+  for (uint32_t i = 0; i < kVarCount; i++) {
+    v[i] = c.newInt32("v%u", i);
+    values[i] = i * 7 + 1;
+    c.mov(v[i], static_cast<int>(values[i]));
+  }
+
+  uint32_t seed = 459304;
+  for (uint32_t step = 0; step < kStepCount; step++) {
+    seed = seed * 1103515245U + 12345U;
+    uint32_t op = (seed >> 16) & 15;
+
+    seed = seed * 1103515245U + 12345U;
+    uint32_t x = ((seed >> 16) & 0x7FFF) % kVarCount;
+
+    seed = seed * 1103515245U + 12345U;
+    uint32_t y = ((seed >> 16) & 0x7FFF) % kVarCount;
+
+    if (op < 2) {
+      X86CallNode* call = c.call(imm_ptr(X86Context_lsTestCall), FuncBuilder2<int, int, int>(kCallConvHost));
+      call->setArg(0, v[x]);
+      call->setArg(1, v[y]);
+      call->setRet(0, v[x]);
+      values[x] = values[x] * 3U + values[y];
+    }
+    else if (op < 8) {
+      if (x == y)
+        continue;
+      c.shl(v[x], v[y]);
+      values[x] <<= values[y] & 31;
+    }
+    else {
+      c.add(v[x], v[y]);
+      values[x] += values[y];
+    }
+  }
+
+  for (uint32_t i = 1; i < kVarCount; i++) {
+    c.add(v[0], v[i]);
+    values[0] += values[i];
+  }
+
+  c.ret(v[0]);
+  c.endFunc();
+
+  EXPECT(c.finalize() == kErrorOk,
+    "Couldn't finalize the function.");
+
+  typedef int (*Func)(void);
+  Func func = asmjit_cast<Func>(a.make());
+  EXPECT(func != nullptr,
+    "Couldn't make the function.");
+
+  uint32_t result = static_cast<uint32_t>(func());
+  EXPECT(result == values[0],
+    "Returned %u, expected %u.", result, values[0]);
+
+  runtime.release((void*)func);
+}
+
+static void X86Context_callAllocTestCall() {}
+
+UNIT(x86_compiler_call_alloc) {
+  // The call target is in memory and all registers are occupied by variables
+  // not used by the call. The register the target is loaded to has to be
+  // freed by spilling its variable, it can't be swapped with a variable that
+  // isn't in a register. The linear scan assigns the target to a register
+  // that is occupied.
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Compiler c(&a);
+
+  c.setFeature(kCompilerFeatureLinearScan, true);
+  c.addFunc(FuncBuilder0<int>(kCallConvHost));
+
+  X86GpVar pFn = c.newIntPtr("pFn");
+  X86GpVar vars[16];
+
+  uint32_t i, regCount = c.getRegCount().getGp();
+  int expected = 0;
+
+  c.mov(pFn, imm_ptr(X86Context_callAllocTestCall));
+  c.spill(pFn);
+
+  for (i = 0; i < regCount; i++) {
+    if (i == kX86RegIndexBp || i == kX86RegIndexSp)
+      continue;
+
+    vars[i] = c.newInt32("v%u", i);
+    c.alloc(vars[i], i);
+    c.mov(vars[i], static_cast<int>(i));
+    expected += static_cast<int>(i);
+  }
+
+  c.call(pFn, FuncBuilder0<void>(kCallConvHost));
+
+  for (i = 1; i < regCount; i++) {
+    if (vars[i].isInitialized())
+      c.add(vars[0], vars[i]);
+  }
+
+  c.ret(vars[0]);
+  c.endFunc();
+
+  EXPECT(c.finalize() == kErrorOk,
+    "Couldn't finalize the function.");
+
+  typedef int (*Func)(void);
+  Func func = asmjit_cast<Func>(a.make());
+  EXPECT(func != nullptr,
+    "Couldn't make the function.");
+
+  int result = func();
+  EXPECT(result == expected,
+    "Returned %d, expected %d.", result, expected);
+
+  runtime.release((void*)func);
+}
+
+UNIT(x86_compiler_call_alloc_recursive) {
+  // The argument of a recursive call is in memory when the call is reached
+  // and the register it's passed in is occupied by `val`.
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Compiler c(&a);
+
+  c.setFeature(kCompilerFeatureLinearScan, true);
+
+  X86GpVar val = c.newInt32("val");
+  Label L_Skip = c.newLabel();
+
+  X86FuncNode* funcNode = c.addFunc(FuncBuilder1<int, int>(kCallConvHost));
+  c.setArg(0, val);
+
+  c.cmp(val, 1);
+  c.jle(L_Skip);
+
+  X86GpVar tmp = c.newInt32("tmp");
+  c.mov(tmp, val);
+  c.dec(tmp);
+
+  X86CallNode* call = c.call(funcNode->getEntryLabel(), FuncBuilder1<int, int>(kCallConvHost));
+  call->setArg(0, tmp);
+  call->setRet(0, tmp);
+  c.mul(c.newInt32(), val, tmp);
+
+  c.bind(L_Skip);
+  c.ret(val);
+  c.endFunc();
+
+  EXPECT(c.finalize() == kErrorOk,
+    "Couldn't finalize the function.");
+
+  typedef int (*Func)(int);
+  Func func = asmjit_cast<Func>(a.make());
+  EXPECT(func != nullptr,
+    "Couldn't make the function.");
+
+  int result = func(5);
+  EXPECT(result == 120,
+    "Returned %d, expected 120.", result);
+
+  runtime.release((void*)func);
+}
+
+UNIT(x86_compiler_features) {
+  X86Compiler c;
+
+  INFO("Setting and clearing features.");
+  c.setFeature(kCompilerFeatureEnableScheduler, true);
+  c.setFeature(kCompilerFeatureLinearScan, true);
+  EXPECT(c.hasFeature(kCompilerFeatureEnableScheduler) && c.hasFeature(kCompilerFeatureLinearScan),
+    "Should set both features.");
+
+  c.setFeature(kCompilerFeatureEnableScheduler, false);
+  EXPECT(!c.hasFeature(kCompilerFeatureEnableScheduler),
+    "Should clear the feature.");
+  EXPECT(c.hasFeature(kCompilerFeatureLinearScan),
+    "Should keep other features.");
+
+  c.setFeature(kCompilerFeatureLinearScan, false);
+  EXPECT(!c.hasFeature(kCompilerFeatureLinearScan) && !c.hasFeature(kCompilerFeatureEnableScheduler),
+    "Should clear all features.");
+}
+
+UNIT(x86_compiler_recycle) {
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Compiler c;
+
+  // Compile the same function several times by the same compiler and
+  // assembler, only the first iteration should allocate memory.
+  for (uint32_t i = 0; i < 4; i++) {
+    DebugUtils::resetAllocCount();
+    c.attach(&a);
+
+    c.addFunc(FuncBuilder2<int, int, int>(kCallConvHost));
+
+    X86GpVar x = c.newInt32("x");
+    X86GpVar y = c.newInt32("y");
+    X86GpVar sum = c.newInt32("sum");
+    Label L_Loop = c.newLabel();
+
+    c.setArg(0, x);
+    c.setArg(1, y);
+    c.xor_(sum, sum);
+
+    c.bind(L_Loop);
+    c.add(sum, x);
+    c.dec(y);
+    c.jnz(L_Loop);
+
+    c.ret(sum);
+    c.endFunc();
+
+    EXPECT(c.finalize() == kErrorOk,
+      "Couldn't finalize the function.");
+
+    size_t count = DebugUtils::getAllocCount();
+    INFO("Iteration #%u: %u allocations.", i, static_cast<unsigned int>(count));
+
+    if (i != 0)
+      EXPECT(count == 0,
+        "Reused compiler and assembler shouldn't allocate.");
+
+    a.reset(false);
+  }
+}
+
+UNIT(x86_compiler_validate) {
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Compiler c(&a);
+
+  c.addFunc(FuncBuilder1<int, int>(kCallConvHost));
+
+  X86GpVar x = c.newInt32("x");
+  X86GpVar y = c.newInt64("y");
+
+  c.setArg(0, x);
+  c.add(x, x);
+
+  INFO("Validating a valid instruction stream.");
+  HLInst* invalidInst = nullptr;
+  EXPECT(c.validate(&invalidInst) == kErrorOk && invalidInst == nullptr,
+    "Should validate `add x32, x32`.");
+
+  // Not validated by default, `validate()` has to find it.
+  INFO("Validating an invalid instruction stream.");
+  HLInst* inst = c.add(x, y);
+  EXPECT(inst != nullptr,
+    "Shouldn't validate instructions by default.");
+  EXPECT(c.validate(&invalidInst) == kErrorIllegalOperand && invalidInst == inst,
+    "Should refuse `add x32, x64`.");
+  c.removeNode(inst);
+
+  INFO("Validating instructions when they are added.");
+  a.addAsmOptions(Assembler::kOptionStrictValidation);
+  EXPECT(c.add(x, y) == nullptr && c.getLastError() == kErrorIllegalOperand,
+    "Should refuse `add x32, x64` in strict validation mode.");
+  c.resetLastError();
+
+  EXPECT(c.add(x, x) != nullptr,
+    "Should accept `add x32, x32` in strict validation mode.");
+
+  c.ret(x);
+  c.endFunc();
+
+  EXPECT(c.finalize() == kErrorOk,
+    "Couldn't finalize the function.");
+}
+
+UNIT(x86_compiler_tune) {
+  CpuInfo cpuInfo;
+
+  INFO("Detecting the tuning of known CPUs.");
+  cpuInfo._vendorId = CpuInfo::kVendorIntel;
+  cpuInfo._family = 0x06;
+  cpuInfo._model = 0x2A;
+  EXPECT(X86Compiler::detectTuneArch(cpuInfo) == kX86TuneArchSandyBridge,
+    "Intel family 6 model 0x2A should be SandyBridge.");
+
+  cpuInfo._model = 0x4D;
+  EXPECT(X86Compiler::detectTuneArch(cpuInfo) == kX86TuneArchAtom,
+    "Intel family 6 model 0x4D should be Atom.");
+
+  cpuInfo._model = 0x9E;
+  cpuInfo.addFeature(CpuInfo::kX86FeatureAVX2);
+  EXPECT(X86Compiler::detectTuneArch(cpuInfo) == kX86TuneArchSkylake,
+    "Intel family 6 with AVX2 should be Skylake.");
+
+  cpuInfo.reset();
+  cpuInfo._vendorId = CpuInfo::kVendorAMD;
+  cpuInfo._family = 0x15;
+  EXPECT(X86Compiler::detectTuneArch(cpuInfo) == kX86TuneArchBulldozer,
+    "AMD family 0x15 should be Bulldozer.");
+
+  cpuInfo._family = 0x17;
+  EXPECT(X86Compiler::detectTuneArch(cpuInfo) == kX86TuneArchZen,
+    "AMD family 0x17 should be Zen.");
+
+  cpuInfo.reset();
+  EXPECT(X86Compiler::detectTuneArch(cpuInfo) == kX86TuneArchGeneric,
+    "Unknown vendor should be Generic.");
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Compiler c(&a);
+  StringLogger logger;
+
+  a.setLogger(&logger);
+  EXPECT(c.setTuneArch(kX86TuneArchCount) == kErrorInvalidArgument,
+    "Should refuse an unknown tuning.");
+  EXPECT(c.setTuneArch(kX86TuneArchSkylake) == kErrorOk && c.getResolvedTuneArch() == kX86TuneArchSkylake,
+    "Should use the tuning set explicitly.");
+  c.setTuneOptions(kX86TuneAll);
+
+  INFO("Inserting vzeroupper between AVX and legacy SSE code.");
+  c.addFunc(FuncBuilder2<Void, float*, double*>(kCallConvHost));
+
+  X86GpVar p = c.newIntPtr("p");
+  X86GpVar q = c.newIntPtr("q");
+  X86YmmVar y = c.newYmmPs("y");
+  X86XmmVar x = c.newXmmSd("x");
+
+  c.setArg(0, p);
+  c.setArg(1, q);
+
+  c.vmovups(y, x86::yword_ptr(p));
+  c.vaddps(y, y, y);
+  c.vmovups(x86::yword_ptr(p), y);
+  c.movsd(x, x86::qword_ptr(q));
+  c.addsd(x, x);
+  c.movsd(x86::qword_ptr(q), x);
+
+  c.endFunc();
+  EXPECT(c.finalize() == kErrorOk,
+    "Couldn't finalize the function.");
+
+  const char* log = logger.getString();
+  const char* vzeroupper = ::strstr(log, "vzeroupper");
+  const char* vaddps = ::strstr(log, "vaddps");
+  const char* movsd = ::strstr(log, "movsd");
+
+  EXPECT(vzeroupper != nullptr && vaddps != nullptr && movsd != nullptr,
+    "Should insert vzeroupper.");
+  EXPECT(vaddps < vzeroupper && vzeroupper < movsd,
+    "Should insert vzeroupper before the legacy SSE code.");
+  EXPECT(::strstr(vzeroupper + 1, "vzeroupper") == nullptr,
+    "Should insert vzeroupper only once.");
+#endif // !ASMJIT_DISABLE_LOGGER
+}
+
+static int X86Context_alignTestCall(int a) {
+  return a + 1;
+}
+
+UNIT(x86_compiler_align) {
+  // The branch in the loop is moved by one addition at a time, so the jumps
+  // and the call would cross the boundary at some point if not padded.
+  enum { kBoundary = 32, kCount = 9 };
+
+  for (uint32_t split = 0; split < kCount; split++) {
+    JitRuntime runtime;
+    X86Assembler a(&runtime);
+    X86Compiler c(&a);
+
+    EXPECT(c.setLoopAlign(kBoundary) == kErrorOk && c.setJumpBoundary(kBoundary) == kErrorOk,
+      "Couldn't set the loop alignment and the jump boundary.");
+
+    c.addFunc(FuncBuilder1<int, int>(kCallConvHost));
+
+    X86GpVar n = c.newInt32("n");
+    X86GpVar i = c.newInt32("i");
+    X86GpVar sum = c.newInt32("sum");
+
+    Label L_Loop = c.newLabel();
+    Label L_Even = c.newLabel();
+    Label L_Exit = c.newLabel();
+
+    c.setArg(0, n);
+    c.xor_(sum, sum);
+    c.test(n, n);
+    c.jle(L_Exit);
+    c.mov(i, n);
+
+    c.bind(L_Loop);
+    for (uint32_t k = 0; k < kCount; k++) {
+      if (k == split) {
+        c.test(i, 1);
+        c.jz(L_Even);
+        X86CallNode* call = c.call(imm_ptr(X86Context_alignTestCall), FuncBuilder1<int, int>(kCallConvHost));
+        call->setArg(0, sum);
+        call->setRet(0, sum);
+        c.bind(L_Even);
+      }
+      c.add(sum, static_cast<int>(0x100 + k));
+    }
+    c.dec(i);
+    c.jnz(L_Loop);
+
+    c.bind(L_Exit);
+    c.ret(sum);
+    c.endFunc();
+
+    INFO("Checking a branch after %u additions.", split);
+    EXPECT(c.finalize() == kErrorOk,
+      "Couldn't finalize the function.");
+
+    typedef int (*Func)(int);
+    Func func = asmjit_cast<Func>(a.make());
+    EXPECT(func != nullptr,
+      "Couldn't make the function.");
+
+    int expected = 0;
+    for (int k = 13; k > 0; k--) {
+      for (uint32_t j = 0; j < kCount; j++) {
+        if (j == split && (k & 1) != 0)
+          expected++;
+        expected += static_cast<int>(0x100 + j);
+      }
+    }
+
+    int result = func(13);
+    EXPECT(result == expected,
+      "Function returned %d, expected %d.", result, expected);
+
+    intptr_t loopOffset = a.getLabelOffset(L_Loop);
+    EXPECT(loopOffset > 0 && loopOffset % kBoundary == 0,
+      "The loop header at %d should be aligned to %d bytes.", static_cast<int>(loopOffset), kBoundary);
+
+    // Trampolines follow the code, so only the code itself is decoded.
+    const uint8_t* code = reinterpret_cast<const uint8_t*>(func);
+    size_t codeSize = a.getOffset();
+
+    X86Disassembler disasm;
+    X86DecodedInst inst;
+    uint32_t jumpCount = 0;
+
+    size_t offset = 0;
+    while (offset < codeSize) {
+      Error err = disasm.decode(inst, code + offset, codeSize - offset);
+      EXPECT(err == kErrorOk,
+        "Couldn't decode the instruction at %u.", static_cast<unsigned int>(offset));
+
+      uint32_t instId = inst.instId;
+      if (Utils::inInterval<uint32_t>(instId, kX86InstIdJa, kX86InstIdJz) ||
+          instId == kX86InstIdJmp || instId == kX86InstIdCall) {
+        jumpCount++;
+        EXPECT(offset / kBoundary == (offset + inst.size) / kBoundary,
+          "The %s at %u (%u bytes) crosses or ends at the %d-byte boundary.",
+          X86Util::getInstNameById(instId), static_cast<unsigned int>(offset), inst.size, kBoundary);
+      }
+
+      offset += inst.size;
+    }
+
+    EXPECT(jumpCount >= 4,
+      "Should decode all jumps and the call, decoded %u.", jumpCount);
+
+    runtime.release((void*)func);
+  }
+}
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+//! \internal
+//!
+//! Rewrites checked by `x86_compiler_peephole`.
+ASMJIT_ENUM(X86PeepholeTest) {
+  kX86PeepholeTestJump = 0,
+  kX86PeepholeTestZero,
+  kX86PeepholeTestZeroFlags,
+  kX86PeepholeTestXor,
+  kX86PeepholeTestSelfMove,
+  kX86PeepholeTestSpill,
+  kX86PeepholeTestCount
+};
+
+//! \internal
+//!
+//! Compile a function of `test` with or without the peephole optimizer and
+//! return a result of `func(5, 3)`, the log is stored in `log`.
+static int X86Context_peepholeTest(StringBuilder& log, uint32_t test, bool peephole) {
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Compiler c(&a);
+  StringLogger logger;
+
+  a.setLogger(&logger);
+  c.setFeature(kCompilerFeaturePeephole, peephole);
+  c.addFunc(FuncBuilder2<int, int, int>(kCallConvHost));
+
+  X86GpVar x = c.newInt32("x");
+  X86GpVar y = c.newInt32("y");
+  X86GpVar r = c.newInt32("r");
+
+  c.setArg(0, x);
+  c.setArg(1, y);
+
+  switch (test) {
+    case kX86PeepholeTestJump: {
+      Label L_Next = c.newLabel();
+      Label L_Skip = c.newLabel();
+
+      c.mov(r, x);
+      c.jmp(L_Next);
+      c.bind(L_Next);
+      c.cmp(x, y);
+      c.jz(L_Skip);
+      c.bind(L_Skip);
+      c.add(r, y);
+      break;
+    }
+
+    case kX86PeepholeTestZero: {
+      c.mov(r, 0);
+      c.add(r, x);
+      break;
+    }
+
+    case kX86PeepholeTestZeroFlags: {
+      c.cmp(x, y);
+      c.mov(r, 0);
+      c.setg(r.r8());
+      break;
+    }
+
+    case kX86PeepholeTestXor: {
+      c.xor_(r, r);
+      c.mov(r, y);
+      c.add(r, x);
+      break;
+    }
+
+    case kX86PeepholeTestSelfMove: {
+      X86XmmVar v = c.newXmm("v");
+
+      c.movd(v, x);
+      c.movaps(v, v);
+      c.movd(r, v);
+      break;
+    }
+
+    case kX86PeepholeTestSpill: {
+      c.mov(r, x);
+      c.spill(r);
+      c.add(r, y);
+      break;
+    }
+  }
+
+  c.ret(r);
+  c.endFunc();
+
+  int result = -1;
+  if (c.finalize() == kErrorOk) {
+    typedef int (*Func)(int, int);
+    Func func = asmjit_cast<Func>(a.make());
+
+    if (func != nullptr) {
+      result = func(5, 3);
+      runtime.release((void*)func);
+    }
+  }
+
+  log.setString(logger.getString());
+  return result;
+}
+
+//! \internal
+//!
+//! Get count of instructions `name` in `log`, or count of instructions that
+//! have a memory operand if `name` is null.
+static uint32_t X86Context_peepholeCount(const StringBuilder& log, const char* name) {
+  const char* p = log.getData();
+  const char* end = p + log.getLength();
+
+  size_t nameLength = name ? ::strlen(name) : 0;
+  uint32_t count = 0;
+
+  while (p < end) {
+    const char* lineEnd = static_cast<const char*>(::memchr(p, '\n', (size_t)(end - p)));
+    if (lineEnd == nullptr)
+      lineEnd = end;
+
+    while (p < lineEnd && *p == ' ')
+      p++;
+
+    if (name == nullptr) {
+      // Skip the comment, which uses brackets as well.
+      const char* instEnd = static_cast<const char*>(::memchr(p, ';', (size_t)(lineEnd - p)));
+      if (instEnd == nullptr)
+        instEnd = lineEnd;
+
+      if (::memchr(p, '[', (size_t)(instEnd - p)) != nullptr)
+        count++;
+    }
+    else {
+      if ((size_t)(lineEnd - p) > 6 && ::strncmp(p, "short ", 6) == 0)
+        p += 6;
+
+      if ((size_t)(lineEnd - p) > nameLength && ::strncmp(p, name, nameLength) == 0 && p[nameLength] == ' ')
+        count++;
+    }
+
+    p = lineEnd + 1;
+  }
+
+  return count;
+}
+
+UNIT(x86_compiler_peephole) {
+  static const int expectedRet[kX86PeepholeTestCount] = { 8, 5, 1, 8, 5, 8 };
+
+  StringBuilder log[2];
+  const char* jz = X86Util::getInstNameById(kX86InstIdJz);
+
+  for (uint32_t test = 0; test < kX86PeepholeTestCount; test++) {
+    INFO("Checking rewrite #%u.", test);
+
+    for (uint32_t p = 0; p < 2; p++) {
+      int result = X86Context_peepholeTest(log[p], test, p != 0);
+      EXPECT(result == expectedRet[test],
+        "Function returned %d, expected %d.", result, expectedRet[test]);
+    }
+
+    switch (test) {
+      case kX86PeepholeTestJump:
+        EXPECT(X86Context_peepholeCount(log[0], "jmp") == 1 && X86Context_peepholeCount(log[0], jz) == 1,
+          "Should emit jumps to the next instruction without the peephole optimizer.");
+        EXPECT(X86Context_peepholeCount(log[1], "jmp") == 0 && X86Context_peepholeCount(log[1], jz) == 0,
+          "Should remove jumps to the next instruction.");
+        break;
+
+      case kX86PeepholeTestZero:
+        EXPECT(X86Context_peepholeCount(log[0], "xor") == 0 && X86Context_peepholeCount(log[1], "xor") == 1,
+          "Should zero by xor.");
+        EXPECT(X86Context_peepholeCount(log[1], "mov") + 1 == X86Context_peepholeCount(log[0], "mov"),
+          "Should replace mov by xor.");
+        break;
+
+      case kX86PeepholeTestZeroFlags:
+        EXPECT(X86Context_peepholeCount(log[1], "xor") == 0 && log[0].eq(log[1].getData()),
+          "Shouldn't zero by xor if the flags are read afterwards.");
+        break;
+
+      case kX86PeepholeTestXor:
+        EXPECT(X86Context_peepholeCount(log[0], "xor") == 1 && X86Context_peepholeCount(log[1], "xor") == 0,
+          "Should remove xor overwritten by the next instruction.");
+        break;
+
+      case kX86PeepholeTestSelfMove:
+        EXPECT(X86Context_peepholeCount(log[0], "movaps") == 1 && X86Context_peepholeCount(log[1], "movaps") == 0,
+          "Should remove a move of a register to itself.");
+        break;
+
+      case kX86PeepholeTestSpill:
+        EXPECT(X86Context_peepholeCount(log[1], nullptr) + 1 == X86Context_peepholeCount(log[0], nullptr),
+          "Should forward the spilled register instead of loading the spill slot.");
+        break;
+    }
+  }
+}
+
+//! \internal
+//!
+//! Count of variables kept alive by `X86Context_scheduleTest()` to exceed
+//! the count of registers.
+static const uint32_t kX86ScheduleTestVars = 16;
+
+//! \internal
+//!
+//! Compile a function that has two independent chains the scheduler can
+//! interleave, with or without `kX86ScheduleTestVars` variables alive around
+//! them (`pressure`), and return a result of `func(buffer)`. The log is stored
+//! in `log`.
+static int X86Context_scheduleTest(StringBuilder& log, bool pressure, bool schedule) {
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+  X86Compiler c(&a);
+  StringLogger logger;
+
+  a.setLogger(&logger);
+  c.setFeature(kCompilerFeatureEnableScheduler, schedule);
+  c.addFunc(FuncBuilder1<int, int*>(kCallConvHost));
+
+  X86GpVar p = c.newIntPtr("p");
+  X86GpVar x = c.newInt32("x");
+  X86GpVar y = c.newInt32("y");
+  X86GpVar v[kX86ScheduleTestVars];
+
+  uint32_t i;
+  uint32_t count = pressure ? kX86ScheduleTestVars : 0;
+
+  c.setArg(0, p);
+
+  for (i = 0; i < count; i++) {
+    v[i] = c.newInt32("v%u", i);
+    c.mov(v[i], x86::dword_ptr(p, static_cast<int32_t>(i) * 4));
+  }
+
+  // Labels split the function into regions scheduled separately.
+  Label L_Chains = c.newLabel();
+  Label L_Sum = c.newLabel();
+
+  c.bind(L_Chains);
+  c.mov(x, x86::dword_ptr(p, 64));
+  c.imul(x, x);
+  c.imul(x, x);
+  c.mov(y, x86::dword_ptr(p, 68));
+  c.add(y, 1);
+
+  c.bind(L_Sum);
+  c.add(x, y);
+  for (i = 0; i < count; i++)
+    c.add(x, v[i]);
+
+  c.ret(x);
+  c.endFunc();
+
+  int result = -1;
+  if (c.finalize() == kErrorOk) {
+    typedef int (*Func)(int*);
+    Func func = asmjit_cast<Func>(a.make());
+
+    int buffer[18];
+    for (i = 0; i < 18; i++)
+      buffer[i] = static_cast<int>(i + 1);
+
+    if (func != nullptr) {
+      result = func(buffer);
+      runtime.release((void*)func);
+    }
+  }
+
+  log.setString(logger.getString());
+  return result;
+}
+
+UNIT(x86_compiler_schedule) {
+  StringBuilder log[2];
+
+  for (uint32_t pressure = 0; pressure < 2; pressure++) {
+    // 17^4 + 18 + 1 and the sum of 1..16 if the variables are alive.
+    int expectedRet = 83521 + 19 + (pressure ? 136 : 0);
+
+    for (uint32_t s = 0; s < 2; s++) {
+      int result = X86Context_scheduleTest(log[s], pressure != 0, s != 0);
+      EXPECT(result == expectedRet,
+        "Function returned %d, expected %d.", result, expectedRet);
+    }
+
+    if (pressure)
+      EXPECT(log[0].eq(log[1].getData()),
+        "Shouldn't reorder instructions if it needs more registers than there are.");
+    else
+      EXPECT(!log[0].eq(log[1].getData()),
+        "Should start the second load before the multiplications.");
+  }
+}
+
+UNIT(x86_compiler_threads) {
+  // More functions than fit into a batch of 4 threads, so the workers are
+  // reused by following batches.
+  static const uint32_t kFuncCount = 40;
+
+  StringBuilder log[2];
+
+  for (uint32_t t = 0; t < 2; t++) {
+    JitRuntime runtime;
+    X86Assembler a(&runtime);
+    X86Compiler c(&a);
+    StringLogger logger;
+
+    a.setLogger(&logger);
+    c.setThreadCount(t ? 4 : 1);
+
+    for (uint32_t i = 0; i < kFuncCount; i++) {
+      c.addFunc(FuncBuilder1<int, int>(kCallConvHost));
+
+      X86GpVar x = c.newInt32("x");
+      c.setArg(0, x);
+      c.add(x, static_cast<int>(i));
+      c.ret(x);
+      c.endFunc();
+    }
+
+    Error error = c.finalize();
+    EXPECT(error == kErrorOk,
+      "Finalize failed (%s).", DebugUtils::errorAsString(error));
+
+    log[t].setString(logger.getString());
+  }
+
+  EXPECT(log[0].eq(log[1].getData()),
+    "Should generate the same code by 1 and 4 threads.");
+}
+#endif // !ASMJIT_DISABLE_LOGGER
+#endif // ASMJIT_TEST
+
 } // asmjit namespace
 
 // [Api-End]
@@ -127,6 +127,31 @@ struct X86VarMap : public VarMap {
   VarAttr _list[1];
 };
 
+// ============================================================================
+// [asmjit::X86LsRange]
+// ============================================================================
+
+//! \internal
+//!
+//! Part of a live interval assigned to a register by the linear-scan allocator.
+//!
+//! Positions are flow-ids of nodes, which are renumbered in layout order
+//! before the scan starts. A variable has a list of ranges, one per split,
+//! and no range for the positions where it lives in memory.
+struct X86LsRange {
+  //! Next range of the same variable.
+  X86LsRange* next;
+  //! First position (inclusive).
+  uint32_t start;
+  //! Last position (inclusive).
+  uint32_t end;
+  //! Assigned register index.
+  uint32_t regIndex;
+};
+
+//! \internal
+struct X86LsInterval;
+
 // ============================================================================
 // [asmjit::X86StateCell]
 // ============================================================================
@@ -282,6 +307,14 @@ struct X86Context : public Context {
 
   virtual void reset(bool releaseMemory = false) override;
 
+  //! Reload settings that depend on the architecture and the logger of the
+  //! compiler's assembler and reset the context.
+  //!
+  //! Called by `X86Compiler::finalize()` before the context kept from the
+  //! previous `finalize()` call is reused, as the compiler may have been
+  //! attached to a different assembler since.
+  void reinit();
+
   // --------------------------------------------------------------------------
   // [Arch]
   // --------------------------------------------------------------------------
@@ -644,12 +677,44 @@ struct X86Context : public Context {
     return mem;
   }
 
+  // --------------------------------------------------------------------------
+  // [ValueNumbering]
+  // --------------------------------------------------------------------------
+
+  virtual Error valueNumbering();
+
   // --------------------------------------------------------------------------
   // [Fetch]
   // --------------------------------------------------------------------------
 
   virtual Error fetch();
 
+  // --------------------------------------------------------------------------
+  // [Schedule]
+  // --------------------------------------------------------------------------
+
+  virtual Error schedule();
+
+  // --------------------------------------------------------------------------
+  // [LinearScan]
+  // --------------------------------------------------------------------------
+
+  virtual Error linearScan();
+
+  //! Get register assigned to `vd` at `position` by `linearScan()` or
+  //! `kInvalidReg` if there is none.
+  ASMJIT_INLINE uint32_t getLsRegIndex(VarData* vd, uint32_t position) const {
+    if (_lsRanges == nullptr)
+      return kInvalidReg;
+
+    for (X86LsRange* range = _lsRanges[vd->getLocalId()]; range != nullptr; range = range->next) {
+      if (position >= range->start && position <= range->end)
+        return range->regIndex;
+    }
+
+    return kInvalidReg;
+  }
+
   // --------------------------------------------------------------------------
   // [Annotate]
   // --------------------------------------------------------------------------
@@ -662,6 +727,19 @@ struct X86Context : public Context {
 
   virtual Error translate();
 
+  // --------------------------------------------------------------------------
+  // [Peephole]
+  // --------------------------------------------------------------------------
+
+  virtual Error peephole();
+
+  // --------------------------------------------------------------------------
+  // [Tune]
+  // --------------------------------------------------------------------------
+
+  virtual Error tuneVars();
+  virtual Error tune();
+
   // --------------------------------------------------------------------------
   // [Serialize]
   // --------------------------------------------------------------------------
@@ -693,12 +771,21 @@ struct X86Context : public Context {
   //! Global allocable registers mask.
   uint32_t _gaRegs[kX86RegClassCount];
 
+  //! Linear-scan ranges indexed by local-id, only used by `linearScan()`.
+  X86LsRange** _lsRanges;
+  //! Min-heap of intervals waiting for the linear scan, its memory is kept
+  //! by `reset(false)` so reused contexts don't allocate.
+  PodVector<X86LsInterval*> _lsHeap;
+
   //! Function arguments base pointer (register).
   uint8_t _argBaseReg;
   //! Function variables base pointer (register).
   uint8_t _varBaseReg;
   //! Whether to emit comments.
   uint8_t _emitComments;
+  //! Whether the function uses YMM/ZMM registers directly, not through
+  //! variables, set by `tuneVars()`.
+  uint8_t _usesYmmRegs;
 
   //! Function arguments base offset.
   int32_t _argBaseOffset;
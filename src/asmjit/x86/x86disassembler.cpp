@@ -0,0 +1,2431 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Export]
+#define ASMJIT_EXPORTS
+
+// [Guard]
+#include "../build.h"
+#if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
+
+// [Dependencies]
+#include "../base/containers.h"
+#include "../base/logger.h"
+#include "../base/runtime.h"
+#include "../base/utils.h"
+#include "../x86/x86assembler.h"
+#include "../x86/x86disassembler.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+// ============================================================================
+// [asmjit::X86Decoder - Enums]
+// ============================================================================
+
+//! \internal
+//!
+//! Maximum length of a single X86/X64 instruction.
+static const uint32_t kX86DecoderMaxInstSize = 15;
+
+//! \internal
+//!
+//! Opcode maps, each map holds 256 opcodes.
+ASMJIT_ENUM(X86DecoderMap) {
+  kX86DecoderMapLegacy   = 0,            // [OP].
+  kX86DecoderMap0F       = 1,            // 0F [OP].
+  kX86DecoderMap0F38     = 2,            // 0F 38 [OP].
+  kX86DecoderMap0F3A     = 3,            // 0F 3A [OP].
+  kX86DecoderMap3dNow    = 4,            // 0F 0F [MODRM...] [OP].
+  kX86DecoderMapVex0F    = 5,            // VEX.mmmmm == 1.
+  kX86DecoderMapVex0F38  = 6,            // VEX.mmmmm == 2.
+  kX86DecoderMapVex0F3A  = 7,            // VEX.mmmmm == 3.
+  kX86DecoderMapXop8     = 8,            // XOP.mmmmm == 8.
+  kX86DecoderMapXop9     = 9,            // XOP.mmmmm == 9.
+  kX86DecoderMapXopA     = 10,           // XOP.mmmmm == 10.
+  kX86DecoderMapEvex0F   = 11,           // EVEX.mm == 1.
+  kX86DecoderMapEvex0F38 = 12,           // EVEX.mm == 2.
+  kX86DecoderMapEvex0F3A = 13,           // EVEX.mm == 3.
+  kX86DecoderMapCount    = 14
+};
+
+//! \internal
+//!
+//! Count of decoder keys (map and opcode).
+static const uint32_t kX86DecoderKeyCount = kX86DecoderMapCount * 256;
+
+//! \internal
+//!
+//! Prefixes and VEX bits a form has to match exactly.
+ASMJIT_ENUM(X86DecoderFeature) {
+  kX86DecoderFeature66   = 0x01,         // 66 prefix or VEX.pp == 1.
+  kX86DecoderFeatureF3   = 0x02,         // F3 prefix or VEX.pp == 2.
+  kX86DecoderFeatureF2   = 0x04,         // F2 prefix or VEX.pp == 3.
+  kX86DecoderFeature9B   = 0x08,         // 9B prefix (FPU instructions that wait).
+  kX86DecoderFeature67   = 0x10,         // 67 prefix of forms without memory operand.
+  kX86DecoderFeatureW    = 0x20,         // REX.W or VEX.W.
+  kX86DecoderFeatureL    = 0x40,         // VEX.L.
+
+  kX86DecoderFeaturePP   = kX86DecoderFeature66 | kX86DecoderFeatureF3 | kX86DecoderFeatureF2
+};
+
+//! \internal
+//!
+//! Extension bits (REX or inverted VEX).
+ASMJIT_ENUM(X86DecoderExt) {
+  kX86DecoderExtB        = 0x01,
+  kX86DecoderExtX        = 0x02,
+  kX86DecoderExtR        = 0x04
+};
+
+//! \internal
+//!
+//! Where an operand of a form is encoded.
+ASMJIT_ENUM(X86DecoderField) {
+  kX86DecoderFieldNone   = 0,
+  kX86DecoderFieldFixed  = 1,            // Implicit register (`value` is its index).
+  kX86DecoderFieldReg    = 2,            // ModR/M.reg.
+  kX86DecoderFieldRm     = 3,            // ModR/M.rm.
+  kX86DecoderFieldRegRm  = 4,            // ModR/M.reg and ModR/M.rm (the same register).
+  kX86DecoderFieldOpLow  = 5,            // Low 3 bits of the opcode.
+  kX86DecoderFieldVvvv   = 6,            // VEX.vvvv.
+  kX86DecoderFieldIs4    = 7,            // Bits [7:4] of an immediate byte (`value` is its offset).
+  kX86DecoderFieldMem    = 8,            // Memory operand (`type` is VSIB, `size` is memory size).
+  kX86DecoderFieldImm    = 9,            // Immediate (`value` is its offset, `type` is non-zero if signed).
+  kX86DecoderFieldImmFixed = 10,         // Implicit immediate (`value`).
+  kX86DecoderFieldImmReg = 11,           // Immediate stored in ModR/M.reg (prefetch hint).
+  kX86DecoderFieldRel    = 12            // Relative displacement (`size`).
+};
+
+//! \internal
+//!
+//! Flags of a form.
+ASMJIT_ENUM(X86DecoderFormFlags) {
+  kX86DecoderFormModRm   = 0x01,         // Has ModR/M byte.
+  kX86DecoderFormMem     = 0x02,         // ModR/M describes a memory operand.
+  kX86DecoderFormVvvv    = 0x04,         // Uses VEX.vvvv.
+  kX86DecoderFormShort   = 0x08,         // Short form of a branch.
+  kX86DecoderFormJcc     = 0x10,         // Conditional jump (accepts branch hints).
+  kX86DecoderFormEvex    = 0x20          // EVEX encoded, only the length is decoded.
+};
+
+// ============================================================================
+// [asmjit::X86DecoderForm]
+// ============================================================================
+
+//! \internal
+//!
+//! Operand of a decoder form.
+struct X86DecoderOp {
+  //! Operand field, see \ref X86DecoderField.
+  uint8_t field;
+  //! Register type, VSIB of a memory operand, or signedness of an immediate.
+  uint8_t type;
+  //! Register, memory, or immediate size.
+  uint8_t size;
+  //! Fixed register index, fixed immediate, or offset of an immediate.
+  uint8_t value;
+};
+
+//! \internal
+//!
+//! Decoder form - a single encoding of an instruction.
+//!
+//! Forms are not written by hand. They are created by emitting each operand
+//! combination of every instruction by `X86Assembler` and by observing which
+//! bytes change when operands change, see `X86DecoderBuilder`. Forms of the
+//! same opcode are stored together and matched in instruction id order.
+struct X86DecoderForm {
+  //! Instruction id.
+  uint16_t instId;
+  //! Decoder key (map and opcode).
+  uint16_t key;
+  //! Features that must match, see \ref X86DecoderFeature.
+  uint8_t features;
+  //! Flags, see \ref X86DecoderFormFlags.
+  uint8_t flags;
+  //! Mask of ModR/M bits that are fixed.
+  uint8_t modRmMask;
+  //! Value of fixed ModR/M bits.
+  uint8_t modRmValue;
+  //! Extension bits that are allowed, see \ref X86DecoderExt.
+  uint8_t extMask;
+  //! Size of all immediates (or relative displacement) following ModR/M.
+  uint8_t immSize;
+  //! Count of operands.
+  uint8_t opCount;
+  //! Reserved.
+  uint8_t reserved;
+  //! Operands.
+  X86DecoderOp opList[4];
+};
+
+// ============================================================================
+// [asmjit::X86Decoder - Header]
+// ============================================================================
+
+//! \internal
+//!
+//! Prefixes and opcode of an instruction.
+struct X86DecoderHeader {
+  //! Opcode map, see \ref X86DecoderMap.
+  uint32_t map;
+  //! Opcode (3dNow opcode is resolved after ModR/M is parsed).
+  uint32_t opCode;
+  //! Features, see \ref X86DecoderFeature.
+  uint32_t features;
+  //! Instruction options implied by prefixes.
+  uint32_t options;
+  //! Segment override, see \ref X86Seg.
+  uint32_t segment;
+  //! REX prefix or zero.
+  uint32_t rex;
+  //! Extension bits, see \ref X86DecoderExt.
+  uint32_t ext;
+  //! VEX.vvvv (not inverted).
+  uint32_t vvvv;
+  //! Position of the byte holding VEX.vvvv or `kInvalidValue`.
+  uint32_t vvvvPos;
+  //! Position of the opcode or `kInvalidValue` (3dNow).
+  uint32_t opPos;
+  //! Position of ModR/M, which follows the opcode.
+  uint32_t modRmPos;
+};
+
+static ASMJIT_INLINE uint32_t X86Decoder_getSegment(uint32_t c) noexcept {
+  switch (c) {
+    case 0x26: return kX86SegEs;
+    case 0x2E: return kX86SegCs;
+    case 0x36: return kX86SegSs;
+    case 0x3E: return kX86SegDs;
+    case 0x64: return kX86SegFs;
+    case 0x65: return kX86SegGs;
+    default  : return kX86SegDefault;
+  }
+}
+
+static ASMJIT_INLINE uint32_t X86Decoder_ppToFeatures(uint32_t pp) noexcept {
+  static const uint8_t ppTable[4] = { 0, kX86DecoderFeature66, kX86DecoderFeatureF3, kX86DecoderFeatureF2 };
+  return ppTable[pp & 0x3];
+}
+
+//! \internal
+//!
+//! Parse prefixes and opcode of an instruction at `p`.
+//!
+//! 9B is a mandatory prefix of FPU instructions that wait (like `fstsw`) only
+//! if `waitPrefix` is true and the next byte is an FPU opcode, otherwise it's
+//! decoded as `fwait`.
+static bool X86Decoder_parseHeader(X86DecoderHeader& h, const uint8_t* p, size_t size, uint32_t arch, bool waitPrefix) noexcept {
+  ::memset(&h, 0, sizeof(X86DecoderHeader));
+  h.vvvvPos = kInvalidValue;
+
+  size_t i = 0;
+  uint32_t c;
+
+  // Legacy prefixes.
+  for (;;) {
+    if (i >= size)
+      return false;
+
+    c = p[i];
+    if (c == 0xF0) {
+      h.options |= kX86InstOptionLock;
+    }
+    else if (c == 0x66) {
+      h.features |= kX86DecoderFeature66;
+    }
+    else if (c == 0xF3) {
+      h.features |= kX86DecoderFeatureF3;
+    }
+    else if (c == 0xF2) {
+      h.features |= kX86DecoderFeatureF2;
+    }
+    else if (c == 0x67) {
+      h.features |= kX86DecoderFeature67;
+    }
+    else if (X86Decoder_getSegment(c) != kX86SegDefault) {
+      h.segment = X86Decoder_getSegment(c);
+    }
+    else if (c == 0x9B && waitPrefix && i + 1 < size) {
+      uint32_t next = p[i + 1];
+      if (arch == kArchX64 && (next & 0xF0) == 0x40 && i + 2 < size)
+        next = p[i + 2];
+
+      if (next != 0xD9 && next != 0xDB && next != 0xDD && next != 0xDF)
+        break;
+      h.features |= kX86DecoderFeature9B;
+    }
+    else {
+      break;
+    }
+
+    if (++i >= kX86DecoderMaxInstSize)
+      return false;
+  }
+
+  // REX prefix.
+  if (arch == kArchX64 && (c & 0xF0) == 0x40) {
+    h.rex = c;
+    h.ext = c & 0x07;
+    if (c & 0x08)
+      h.features |= kX86DecoderFeatureW;
+
+    if (++i >= size)
+      return false;
+    c = p[i];
+  }
+
+  // VEX, XOP, and EVEX prefixes. In 32-bit mode C4, C5, and 62 are only
+  // prefixes if the next byte would be a register ModR/M, and 8F is a prefix
+  // if the next byte isn't a valid `pop` ModR/M in both modes.
+  if ((c == 0xC5 || c == 0xC4 || c == 0x8F || c == 0x62) && i + 1 < size) {
+    uint32_t b1 = p[i + 1];
+
+    if ((arch == kArchX64 || (b1 & 0xC0) == 0xC0) && (c != 0x8F || (b1 & 0x1F) >= 8)) {
+      if (h.rex != 0 || (h.features & kX86DecoderFeaturePP) != 0)
+        return false;
+
+      if (c == 0xC5) {
+        if (i + 2 >= size)
+          return false;
+
+        h.map = kX86DecoderMapVex0F;
+        h.ext = (~b1 >> 5) & kX86DecoderExtR;
+        h.vvvv = (~b1 >> 3) & 0x0F;
+        h.vvvvPos = static_cast<uint32_t>(i + 1);
+        h.features |= X86Decoder_ppToFeatures(b1) | ((b1 & 0x04) ? kX86DecoderFeatureL : 0);
+        h.opPos = static_cast<uint32_t>(i + 2);
+      }
+      else if (c == 0x62) {
+        if (i + 4 >= size)
+          return false;
+
+        uint32_t p0 = b1;
+        uint32_t p1 = p[i + 2];
+        uint32_t mm = p0 & 0x03;
+
+        if (mm == 0 || (p0 & 0x0C) != 0 || (p1 & 0x04) == 0)
+          return false;
+
+        h.map = kX86DecoderMapEvex0F + mm - 1;
+        h.features |= X86Decoder_ppToFeatures(p1) | ((p1 & 0x80) ? kX86DecoderFeatureW : 0);
+        h.opPos = static_cast<uint32_t>(i + 4);
+      }
+      else {
+        if (i + 3 >= size)
+          return false;
+
+        uint32_t b2 = p[i + 2];
+        uint32_t mm = b1 & 0x1F;
+
+        if (c == 0xC4) {
+          if (mm < 1 || mm > 3)
+            return false;
+          h.map = kX86DecoderMapVex0F + mm - 1;
+        }
+        else {
+          if (mm > 10)
+            return false;
+          h.map = kX86DecoderMapXop8 + mm - 8;
+        }
+
+        h.ext = (~b1 >> 5) & 0x07;
+        h.vvvv = (~b2 >> 3) & 0x0F;
+        h.vvvvPos = static_cast<uint32_t>(i + 2);
+        h.features |= X86Decoder_ppToFeatures(b2) |
+                      ((b2 & 0x80) ? kX86DecoderFeatureW : 0) |
+                      ((b2 & 0x04) ? kX86DecoderFeatureL : 0);
+        h.opPos = static_cast<uint32_t>(i + 3);
+
+        // The 3-byte VEX prefix is only needed if the 2-byte one can't be used.
+        if (c == 0xC4 && mm == 1 && (b2 & 0x80) == 0 && (h.ext & (kX86DecoderExtX | kX86DecoderExtB)) == 0)
+          h.options |= kX86InstOptionVex3;
+      }
+
+      h.opCode = p[h.opPos];
+      h.modRmPos = h.opPos + 1;
+      return true;
+    }
+  }
+
+  // Legacy opcode maps.
+  if (c == 0x0F) {
+    if (i + 1 >= size)
+      return false;
+
+    uint32_t c2 = p[i + 1];
+    if (c2 == 0x38 || c2 == 0x3A) {
+      if (i + 2 >= size)
+        return false;
+
+      h.map = c2 == 0x38 ? kX86DecoderMap0F38 : kX86DecoderMap0F3A;
+      h.opPos = static_cast<uint32_t>(i + 2);
+    }
+    else if (c2 == 0x0F) {
+      h.map = kX86DecoderMap3dNow;
+      h.opPos = kInvalidValue;
+      h.modRmPos = static_cast<uint32_t>(i + 2);
+      return true;
+    }
+    else {
+      h.map = kX86DecoderMap0F;
+      h.opPos = static_cast<uint32_t>(i + 1);
+    }
+  }
+  else {
+    h.map = kX86DecoderMapLegacy;
+    h.opPos = static_cast<uint32_t>(i);
+  }
+
+  h.opCode = p[h.opPos];
+  h.modRmPos = h.opPos + 1;
+  return true;
+}
+
+// ============================================================================
+// [asmjit::X86Decoder - Operands]
+// ============================================================================
+
+static ASMJIT_INLINE uint32_t X86Decoder_getRegSize(uint32_t type) noexcept {
+  switch (type) {
+    case kX86RegTypeGpbLo:
+    case kX86RegTypeGpbHi: return 1;
+    case kX86RegTypeGpw  : return 2;
+    case kX86RegTypeGpd  : return 4;
+    case kX86RegTypeGpq  : return 8;
+    case kX86RegTypeFp   : return 10;
+    case kX86RegTypeMm   : return 8;
+    case kX86RegTypeK    : return 8;
+    case kX86RegTypeXmm  : return 16;
+    case kX86RegTypeYmm  : return 32;
+    case kX86RegTypeZmm  : return 64;
+    case kX86RegTypeSeg  : return 2;
+    default              : return 0;
+  }
+}
+
+static ASMJIT_INLINE uint64_t X86Decoder_readImm(const uint8_t* p, uint32_t size, bool isSigned) noexcept {
+  uint64_t value = 0;
+  for (uint32_t i = size; i != 0; i--)
+    value = (value << 8) | p[i - 1];
+
+  // Displacements and relative targets can be absent (zero size).
+  if (isSigned && size != 0 && size < 8) {
+    uint32_t shift = 64 - size * 8;
+    value = static_cast<uint64_t>(static_cast<int64_t>(value << shift) >> shift);
+  }
+
+  return value;
+}
+
+//! \internal
+//!
+//! Parse a memory operand starting at ModR/M `p[0]`.
+//!
+//! Returns the size of ModR/M, SIB, and displacement, or zero if the operand
+//! is invalid or can't be represented by `X86Mem`. The operand is stored to
+//! `mem` if not null.
+static uint32_t X86Decoder_parseMem(X86Mem* mem, const uint8_t* p, size_t size,
+  uint32_t arch, const X86DecoderHeader& h, uint32_t vSib, uint32_t memSize) noexcept {
+
+  if (size < 1)
+    return 0;
+
+  uint32_t modRm = p[0];
+  uint32_t mod = modRm >> 6;
+  uint32_t rm = modRm & 0x07;
+
+  if (mod == 3)
+    return 0;
+
+  // 16-bit addressing is not supported.
+  bool asz = (h.features & kX86DecoderFeature67) != 0;
+  if (asz && arch == kArchX86)
+    return 0;
+
+  uint32_t base = kInvalidReg;
+  uint32_t index = kInvalidReg;
+  uint32_t shift = 0;
+
+  bool hasSib = rm == 4;
+  bool isAbs = false;
+  bool isRip = false;
+
+  uint32_t n = 1;
+  if (hasSib) {
+    if (size < 2)
+      return 0;
+
+    uint32_t sib = p[1];
+    n = 2;
+
+    shift = sib >> 6;
+    index = ((sib >> 3) & 0x07) | ((h.ext & kX86DecoderExtX) << 2);
+    base = (sib & 0x07) | ((h.ext & kX86DecoderExtB) << 3);
+
+    if (index == kX86RegIndexSp && vSib == kX86MemVSibGpz)
+      index = kInvalidReg;
+
+    if ((sib & 0x07) == 5 && mod == 0) {
+      base = kInvalidReg;
+      isAbs = true;
+
+      // X86 encodes [Disp32] without SIB.
+      if (arch == kArchX86 && index == kInvalidReg)
+        return 0;
+    }
+  }
+  else if (rm == 5 && mod == 0) {
+    if (arch == kArchX64)
+      isRip = true;
+    else
+      isAbs = true;
+  }
+  else {
+    base = rm | ((h.ext & kX86DecoderExtB) << 3);
+  }
+
+  // VSIB always has an index.
+  if (vSib != kX86MemVSibGpz && index == kInvalidReg)
+    return 0;
+
+  uint32_t dispSize = (mod == 1) ? 1 : (mod == 2 || isAbs || isRip) ? 4 : 0;
+  if (n + dispSize > size)
+    return 0;
+
+  int32_t disp = static_cast<int32_t>(X86Decoder_readImm(p + n, dispSize, true));
+  n += dispSize;
+
+  if (mem == nullptr)
+    return n;
+
+  uint32_t gpType = (arch == kArchX86 || asz) ? kX86RegTypeGpd : kX86RegTypeGpq;
+  uint32_t gpSize = X86Decoder_getRegSize(gpType);
+
+  X86Reg indexReg;
+  if (index != kInvalidReg) {
+    if (vSib == kX86MemVSibXmm)
+      indexReg = X86XmmReg(kX86RegTypeXmm, index, 16);
+    else if (vSib == kX86MemVSibYmm)
+      indexReg = X86YmmReg(kX86RegTypeYmm, index, 32);
+    else
+      indexReg = X86GpReg(gpType, index, gpSize);
+  }
+
+  if (isRip) {
+    *mem = x86::ptr(x86::rip, disp, memSize);
+  }
+  else if (isAbs) {
+    if (index == kInvalidReg)
+      *mem = x86::ptr_abs(0, disp, memSize);
+    else
+      *mem = x86::ptr_abs(0, indexReg, shift, disp, memSize);
+  }
+  else {
+    X86GpReg baseReg(gpType, base, gpSize);
+    if (index == kInvalidReg)
+      *mem = x86::ptr(baseReg, disp, memSize);
+    else if (vSib == kX86MemVSibXmm)
+      *mem = x86::ptr(baseReg, static_cast<const X86XmmReg&>(indexReg), shift, disp, memSize);
+    else if (vSib == kX86MemVSibYmm)
+      *mem = x86::ptr(baseReg, static_cast<const X86YmmReg&>(indexReg), shift, disp, memSize);
+    else
+      *mem = x86::ptr(baseReg, static_cast<const X86GpReg&>(indexReg), shift, disp, memSize);
+  }
+
+  if (h.segment != kX86SegDefault)
+    mem->setSegment(h.segment);
+
+  return n;
+}
+
+// ============================================================================
+// [asmjit::X86Decoder - Match]
+// ============================================================================
+
+//! \internal
+//!
+//! Match `form` against the instruction at `p` and decode it to `inst`.
+static bool X86Decoder_matchForm(const X86DecoderForm& form, const X86DecoderHeader& h,
+  const uint8_t* p, size_t size, Ptr address, uint32_t arch, X86DecodedInst& inst) noexcept {
+
+  uint32_t features = h.features;
+  if (form.flags & kX86DecoderFormMem)
+    features &= ~kX86DecoderFeature67;
+
+  if (features != form.features)
+    return false;
+
+  // Extension bits and VEX.vvvv of unused fields must be zero.
+  if ((h.ext & ~static_cast<uint32_t>(form.extMask)) != 0)
+    return false;
+
+  if (!(form.flags & kX86DecoderFormVvvv) && h.vvvv != 0)
+    return false;
+
+  uint32_t modRm = 0;
+  uint32_t modRmSize = 0;
+  uint32_t memOpIndex = kInvalidValue;
+
+  if (form.flags & kX86DecoderFormModRm) {
+    if (h.modRmPos >= size)
+      return false;
+
+    modRm = p[h.modRmPos];
+    if ((modRm & form.modRmMask) != form.modRmValue)
+      return false;
+
+    if (form.flags & kX86DecoderFormMem) {
+      uint32_t vSib = kX86MemVSibGpz;
+      for (uint32_t i = 0; i < form.opCount; i++) {
+        if (form.opList[i].field == kX86DecoderFieldMem) {
+          vSib = form.opList[i].type;
+          memOpIndex = i;
+        }
+      }
+
+      modRmSize = X86Decoder_parseMem(nullptr, p + h.modRmPos, size - h.modRmPos, arch, h, vSib, 0);
+      if (modRmSize == 0)
+        return false;
+    }
+    else {
+      if ((modRm >> 6) != 3 && form.modRmMask != 0xFF)
+        return false;
+      modRmSize = 1;
+    }
+  }
+
+  uint32_t immPos = h.modRmPos + modRmSize + (h.map == kX86DecoderMap3dNow);
+  uint32_t instSize = immPos + form.immSize;
+
+  if (instSize > size || instSize > kX86DecoderMaxInstSize)
+    return false;
+
+  // Segment prefixes are only allowed with memory operands, CS and DS are
+  // also branch hints of conditional jumps.
+  uint32_t options = h.options;
+  if (h.segment != kX86SegDefault && memOpIndex == kInvalidValue) {
+    if (!(form.flags & kX86DecoderFormJcc))
+      return false;
+
+    if (h.segment == kX86SegCs)
+      options |= kInstOptionNotTaken;
+    else if (h.segment == kX86SegDs)
+      options |= kInstOptionTaken;
+    else
+      return false;
+  }
+
+  const X86InstInfo& info = X86Util::getInstInfo(form.instId);
+  if ((options & kX86InstOptionLock) != 0 && !info.getExtendedInfo().isLockable())
+    return false;
+
+  uint32_t flags = 0;
+  bool needsRex = false;
+  Ptr target = 0;
+
+  for (uint32_t i = 0; i < form.opCount; i++) {
+    const X86DecoderOp& src = form.opList[i];
+    Operand& dst = inst.opList[i];
+
+    uint32_t regType = src.type;
+    uint32_t regIndex = kInvalidReg;
+
+    switch (src.field) {
+      case kX86DecoderFieldFixed:
+        regIndex = src.value;
+        break;
+
+      case kX86DecoderFieldReg:
+        regIndex = ((modRm >> 3) & 0x07) | ((h.ext & kX86DecoderExtR) << 1);
+        break;
+
+      case kX86DecoderFieldRm:
+        regIndex = (modRm & 0x07) | ((h.ext & kX86DecoderExtB) << 3);
+        break;
+
+      case kX86DecoderFieldRegRm:
+        regIndex = ((modRm >> 3) & 0x07) | ((h.ext & kX86DecoderExtR) << 1);
+        if (regIndex != ((modRm & 0x07) | ((h.ext & kX86DecoderExtB) << 3)))
+          return false;
+        break;
+
+      case kX86DecoderFieldOpLow:
+        regIndex = (h.opCode & 0x07) | ((h.ext & kX86DecoderExtB) << 3);
+        break;
+
+      case kX86DecoderFieldVvvv:
+        regIndex = h.vvvv;
+        break;
+
+      case kX86DecoderFieldIs4: {
+        uint32_t imm8 = p[immPos + src.value];
+        if ((imm8 & 0x0F) != 0)
+          return false;
+        regIndex = imm8 >> 4;
+        break;
+      }
+
+      case kX86DecoderFieldMem: {
+        X86Mem& mem = static_cast<X86Mem&>(dst);
+        X86Decoder_parseMem(&mem, p + h.modRmPos, size - h.modRmPos, arch, h, src.type, src.size);
+        continue;
+      }
+
+      case kX86DecoderFieldImm: {
+        uint64_t imm = X86Decoder_readImm(p + immPos + src.value, src.size, src.type != 0);
+        dst = Imm(static_cast<int64_t>(imm));
+        continue;
+      }
+
+      case kX86DecoderFieldImmFixed:
+        dst = Imm(src.value);
+        continue;
+
+      case kX86DecoderFieldImmReg:
+        dst = Imm((modRm >> 3) & 0x03);
+        continue;
+
+      case kX86DecoderFieldRel: {
+        uint64_t rel = X86Decoder_readImm(p + immPos, src.size, true);
+        target = address + instSize + static_cast<Ptr>(rel);
+        if (arch == kArchX86)
+          target &= 0xFFFFFFFFU;
+
+        dst = Imm(static_cast<int64_t>(target));
+        flags |= kX86DecodedFlagTarget;
+        continue;
+      }
+
+      default:
+        return false;
+    }
+
+    if (arch == kArchX86 && regIndex >= 8)
+      return false;
+
+    if (regIndex >= 8 && (regType == kX86RegTypeFp || regType == kX86RegTypeMm || regType == kX86RegTypeK))
+      return false;
+
+    // Segment registers are indexed from 1, see \ref X86Seg.
+    if (regType == kX86RegTypeSeg) {
+      if (++regIndex > kX86SegGs)
+        return false;
+    }
+
+    if (regType == kX86RegTypeGpbLo && regIndex >= 4) {
+      if (h.rex == 0 && regIndex < 8) {
+        regType = kX86RegTypeGpbHi;
+        regIndex -= 4;
+      }
+      else {
+        needsRex = true;
+      }
+    }
+
+    dst = X86Reg(regType, regIndex, X86Decoder_getRegSize(regType));
+  }
+
+  if (h.rex == 0x40 && !needsRex)
+    options |= kX86InstOptionRex;
+
+  if (form.flags & kX86DecoderFormShort)
+    options |= kInstOptionShortForm;
+
+  inst.instId = form.instId;
+  inst.options = options;
+  inst.size = instSize;
+  inst.opCount = form.opCount;
+  inst.flags = flags;
+  inst.target = target;
+  return true;
+}
+
+// ============================================================================
+// [asmjit::X86DecoderBuilder]
+// ============================================================================
+
+//! \internal
+//!
+//! Probe flags.
+ASMJIT_ENUM(X86ProbeFlags) {
+  //! Ignore operand flags of the instruction table, use `kinds` only.
+  //!
+  //! Implied if the instruction table doesn't describe operands.
+  kX86ProbeFlagRaw = 0x01,
+  //! All registers of the probe have the same kind and sized memory operands
+  //! have the same size as GP registers.
+  kX86ProbeFlagSame = 0x02,
+  //! Probe also the short form of a branch.
+  kX86ProbeFlagShort = 0x04,
+  //! Probe also 64-bit immediates (X64).
+  kX86ProbeFlagImm64 = 0x08
+};
+
+//! \internal
+//!
+//! Register kinds used by probes.
+ASMJIT_ENUM(X86ProbeKinds) {
+  kX86ProbeGp       = kX86InstOpGb | kX86InstOpGw | kX86InstOpGd | kX86InstOpGq,
+  kX86ProbeGpNoGb   = kX86InstOpGw | kX86InstOpGd | kX86InstOpGq,
+  kX86ProbeVec      = kX86InstOpMm | kX86InstOpK | kX86InstOpXmm | kX86InstOpYmm | kX86InstOpZmm,
+  kX86ProbeAllRegs  = kX86ProbeGp | kX86InstOpFp | kX86ProbeVec
+};
+
+//! \internal
+//!
+//! Operand shapes of an instruction encoding, one letter per operand:
+//!
+//!   - 'R' - Register of any kind.
+//!   - 'G' - GP register.
+//!   - 'V' - MM, K, XMM, YMM, or ZMM register.
+//!   - 'N' - Native GP register.
+//!   - 'W' - Native or 16-bit GP register.
+//!   - 'a' - GP register at index 0 (accumulator).
+//!   - 'x' - GP register at index 1 (counter).
+//!   - 'c' - CL register.
+//!   - 's' - FP0 register.
+//!   - 'Z' - Segment register.
+//!   - 'M' - Memory without size.
+//!   - 'S' - Memory sized by GP kinds of the operand.
+//!   - 'F' - Memory sized by FPU memory flags of the instruction.
+//!   - 'D' - 32-bit or 64-bit memory (FPU compare).
+//!   - 'P' - 16-bit or native memory (push/pop).
+//!   - 'Q' - Memory without size or 64-bit memory.
+//!   - 'X' - VSIB memory.
+//!   - 'I' - Immediate.
+//!   - '1' - Immediate 1.
+//!   - '3' - Immediate 3.
+//!   - 'L' - Label.
+struct X86ProbeRow {
+  //! Instruction encoding.
+  uint8_t encoding;
+  //! Flags, see \ref X86ProbeFlags.
+  uint8_t flags;
+  //! Allowed register kinds (zero means all kinds of the instruction table).
+  uint16_t kinds;
+  //! Operand shape.
+  char shape[6];
+};
+
+#define ROW(_Encoding_, _Flags_, _Kinds_, _Shape_) \
+  { kX86InstEncoding##_Encoding_, _Flags_, _Kinds_, _Shape_ }
+
+static const X86ProbeRow x86ProbeRows[] = {
+  ROW(X86Op               , 0                   , 0              , ""     ),
+  ROW(X86Op_66H           , 0                   , 0              , ""     ),
+  ROW(X86Rm               , 0                   , kX86ProbeGp    , "R"    ),
+  ROW(X86Rm               , 0                   , kX86ProbeGp    , "S"    ),
+  ROW(X86Rm_B             , 0                   , kX86ProbeGp    , "R"    ),
+  ROW(X86Rm_B             , 0                   , kX86ProbeGp    , "S"    ),
+  ROW(X86RmReg            , kX86ProbeFlagSame   , kX86ProbeGp    , "RR"   ),
+  ROW(X86RmReg            , kX86ProbeFlagSame   , kX86ProbeGp    , "SR"   ),
+  ROW(X86RegRm            , 0                   , 0              , "RR"   ),
+  ROW(X86RegRm            , kX86ProbeFlagSame   , 0              , "RS"   ),
+  ROW(X86M                , 0                   , 0              , "M"    ),
+  ROW(X86Arith            , 0                   , 0              , "RR"   ),
+  ROW(X86Arith            , kX86ProbeFlagSame   , 0              , "RS"   ),
+  ROW(X86Arith            , kX86ProbeFlagSame   , 0              , "SR"   ),
+  ROW(X86Arith            , 0                   , 0              , "RI"   ),
+  ROW(X86Arith            , 0                   , 0              , "SI"   ),
+  ROW(X86Arith            , 0                   , 0              , "aI"   ),
+  ROW(X86BSwap            , 0                   , 0              , "R"    ),
+  ROW(X86BTest            , 0                   , 0              , "RR"   ),
+  ROW(X86BTest            , kX86ProbeFlagSame   , 0              , "SR"   ),
+  ROW(X86BTest            , 0                   , 0              , "RI"   ),
+  ROW(X86BTest            , 0                   , 0              , "SI"   ),
+  ROW(X86Call             , 0                   , 0              , "N"    ),
+  ROW(X86Call             , 0                   , 0              , "M"    ),
+  ROW(X86Call             , 0                   , 0              , "L"    ),
+  ROW(X86Enter            , kX86ProbeFlagRaw    , 0              , "II"   ),
+  ROW(X86Imul             , kX86ProbeFlagRaw    , kX86ProbeGp    , "R"    ),
+  ROW(X86Imul             , kX86ProbeFlagRaw    , kX86ProbeGp    , "S"    ),
+  ROW(X86Imul             , kX86ProbeFlagRaw | kX86ProbeFlagSame, kX86ProbeGpNoGb, "RR"   ),
+  ROW(X86Imul             , kX86ProbeFlagRaw | kX86ProbeFlagSame, kX86ProbeGpNoGb, "RS"   ),
+  ROW(X86Imul             , kX86ProbeFlagRaw    , kX86ProbeGpNoGb, "RI"   ),
+  ROW(X86Imul             , kX86ProbeFlagRaw | kX86ProbeFlagSame, kX86ProbeGpNoGb, "RRI"  ),
+  ROW(X86Imul             , kX86ProbeFlagRaw | kX86ProbeFlagSame, kX86ProbeGpNoGb, "RSI"  ),
+  ROW(X86IncDec           , 0                   , 0              , "R"    ),
+  ROW(X86IncDec           , 0                   , 0              , "S"    ),
+  ROW(X86Int              , kX86ProbeFlagRaw    , 0              , "I"    ),
+  ROW(X86Int              , kX86ProbeFlagRaw    , 0              , "3"    ),
+  ROW(X86Jcc              , kX86ProbeFlagShort  , 0              , "L"    ),
+  ROW(X86Jecxz            , 0                   , 0              , "xL"   ),
+  ROW(X86Jmp              , 0                   , 0              , "N"    ),
+  ROW(X86Jmp              , 0                   , 0              , "M"    ),
+  ROW(X86Jmp              , kX86ProbeFlagShort  , 0              , "L"    ),
+  ROW(X86Lea              , 0                   , 0              , "RM"   ),
+  ROW(X86Mov              , 0                   , 0              , "RR"   ),
+  ROW(X86Mov              , kX86ProbeFlagSame   , 0              , "RS"   ),
+  ROW(X86Mov              , kX86ProbeFlagSame   , 0              , "SR"   ),
+  ROW(X86Mov              , kX86ProbeFlagImm64  , 0              , "RI"   ),
+  ROW(X86Mov              , 0                   , 0              , "SI"   ),
+  ROW(X86Mov              , kX86ProbeFlagRaw    , kX86ProbeGpNoGb, "ZR"   ),
+  ROW(X86Mov              , kX86ProbeFlagRaw    , kX86ProbeGpNoGb, "RZ"   ),
+  ROW(X86Mov              , kX86ProbeFlagRaw    , 0              , "ZM"   ),
+  ROW(X86Mov              , kX86ProbeFlagRaw    , 0              , "MZ"   ),
+  ROW(X86MovsxMovzx       , 0                   , 0              , "RR"   ),
+  ROW(X86MovsxMovzx       , 0                   , 0              , "RS"   ),
+  ROW(X86Movsxd           , 0                   , 0              , "RR"   ),
+  ROW(X86Movsxd           , 0                   , 0              , "RS"   ),
+  ROW(X86MovPtr           , kX86ProbeFlagImm64  , 0              , "aI"   ),
+  ROW(X86MovPtr           , kX86ProbeFlagRaw | kX86ProbeFlagImm64, kX86ProbeGp, "Ia"   ),
+  ROW(X86Push             , kX86ProbeFlagRaw    , kX86ProbeGp    , "W"    ),
+  ROW(X86Push             , kX86ProbeFlagRaw    , 0              , "P"    ),
+  ROW(X86Push             , kX86ProbeFlagRaw    , 0              , "I"    ),
+  ROW(X86Pop              , kX86ProbeFlagRaw    , kX86ProbeGp    , "W"    ),
+  ROW(X86Pop              , kX86ProbeFlagRaw    , 0              , "P"    ),
+  ROW(X86Rep              , 0                   , 0              , ""     ),
+  ROW(X86Ret              , kX86ProbeFlagRaw    , 0              , ""     ),
+  ROW(X86Ret              , kX86ProbeFlagRaw    , 0              , "I"    ),
+  ROW(X86Rot              , 0                   , 0              , "Rc"   ),
+  ROW(X86Rot              , 0                   , 0              , "Sc"   ),
+  ROW(X86Rot              , 0                   , 0              , "R1"   ),
+  ROW(X86Rot              , 0                   , 0              , "S1"   ),
+  ROW(X86Rot              , 0                   , 0              , "RI"   ),
+  ROW(X86Rot              , 0                   , 0              , "SI"   ),
+  ROW(X86Set              , 0                   , 0              , "R"    ),
+  ROW(X86Set              , 0                   , 0              , "S"    ),
+  ROW(X86ShldShrd         , 0                   , 0              , "RRI"  ),
+  ROW(X86ShldShrd         , kX86ProbeFlagSame   , 0              , "SRI"  ),
+  ROW(X86ShldShrd         , 0                   , 0              , "RRc"  ),
+  ROW(X86ShldShrd         , kX86ProbeFlagSame   , 0              , "SRc"  ),
+  ROW(X86Test             , 0                   , 0              , "RR"   ),
+  ROW(X86Test             , kX86ProbeFlagSame   , 0              , "SR"   ),
+  ROW(X86Test             , 0                   , 0              , "RI"   ),
+  ROW(X86Test             , 0                   , 0              , "SI"   ),
+  ROW(X86Test             , 0                   , 0              , "aI"   ),
+  ROW(X86Xadd             , 0                   , 0              , "RR"   ),
+  ROW(X86Xadd             , kX86ProbeFlagSame   , 0              , "SR"   ),
+  ROW(X86Xchg             , kX86ProbeFlagSame   , 0              , "RS"   ),
+  ROW(X86Xchg             , 0                   , 0              , "RR"   ),
+  ROW(X86Xchg             , kX86ProbeFlagSame   , 0              , "SR"   ),
+  ROW(X86Xchg             , 0                   , 0              , "aR"   ),
+  ROW(X86Crc              , 0                   , 0              , "RR"   ),
+  ROW(X86Crc              , 0                   , 0              , "RS"   ),
+  ROW(X86Prefetch         , 0                   , 0              , "MI"   ),
+  ROW(X86Fence            , 0                   , 0              , ""     ),
+  ROW(FpuOp               , 0                   , 0              , ""     ),
+  ROW(FpuArith            , 0                   , 0              , "sR"   ),
+  ROW(FpuArith            , 0                   , 0              , "Rs"   ),
+  ROW(FpuArith            , 0                   , 0              , "F"    ),
+  ROW(FpuCom              , 0                   , 0              , ""     ),
+  ROW(FpuCom              , 0                   , 0              , "R"    ),
+  ROW(FpuCom              , 0                   , 0              , "D"    ),
+  ROW(FpuFldFst           , 0                   , 0              , "F"    ),
+  ROW(FpuFldFst           , kX86ProbeFlagRaw    , kX86InstOpFp   , "R"    ),
+  ROW(FpuM                , 0                   , 0              , "F"    ),
+  ROW(FpuR                , 0                   , 0              , "R"    ),
+  ROW(FpuRDef             , 0                   , 0              , ""     ),
+  ROW(FpuRDef             , 0                   , 0              , "R"    ),
+  ROW(FpuStsw             , kX86ProbeFlagRaw    , kX86InstOpGw   , "a"    ),
+  ROW(FpuStsw             , 0                   , 0              , "M"    ),
+  ROW(SimdRm              , 0                   , 0              , "RR"   ),
+  ROW(SimdRm              , 0                   , 0              , "RM"   ),
+  ROW(SimdRm_P            , 0                   , 0              , "RR"   ),
+  ROW(SimdRm_P            , 0                   , 0              , "RM"   ),
+  ROW(SimdRm_Q            , 0                   , 0              , "RR"   ),
+  ROW(SimdRm_Q            , 0                   , 0              , "RQ"   ),
+  ROW(SimdRm_PQ           , 0                   , 0              , "RR"   ),
+  ROW(SimdRm_PQ           , 0                   , 0              , "RQ"   ),
+  ROW(SimdRmRi            , 0                   , 0              , "RR"   ),
+  ROW(SimdRmRi            , 0                   , 0              , "RM"   ),
+  ROW(SimdRmRi            , 0                   , 0              , "RI"   ),
+  ROW(SimdRmRi_P          , 0                   , 0              , "RR"   ),
+  ROW(SimdRmRi_P          , 0                   , 0              , "RM"   ),
+  ROW(SimdRmRi_P          , 0                   , 0              , "RI"   ),
+  ROW(SimdRmi             , 0                   , 0              , "RRI"  ),
+  ROW(SimdRmi             , 0                   , 0              , "RMI"  ),
+  ROW(SimdRmi_P           , 0                   , 0              , "RRI"  ),
+  ROW(SimdRmi_P           , 0                   , 0              , "RMI"  ),
+  ROW(SimdPextrw          , 0                   , 0              , "RRI"  ),
+  ROW(SimdPextrw          , 0                   , 0              , "MRI"  ),
+  ROW(SimdExtract         , 0                   , 0              , "RRI"  ),
+  ROW(SimdExtract         , 0                   , 0              , "MRI"  ),
+  ROW(SimdMov             , 0                   , 0              , "RR"   ),
+  ROW(SimdMov             , 0                   , 0              , "RM"   ),
+  ROW(SimdMov             , 0                   , 0              , "MR"   ),
+  ROW(SimdMovNoRexW       , 0                   , 0              , "RR"   ),
+  ROW(SimdMovNoRexW       , 0                   , 0              , "RM"   ),
+  ROW(SimdMovNoRexW       , 0                   , 0              , "MR"   ),
+  ROW(SimdMovBe           , 0                   , 0              , "RM"   ),
+  ROW(SimdMovBe           , 0                   , 0              , "MR"   ),
+  ROW(SimdMovD            , 0                   , 0              , "VG"   ),
+  ROW(SimdMovD            , 0                   , 0              , "GV"   ),
+  ROW(SimdMovD            , 0                   , 0              , "VM"   ),
+  ROW(SimdMovD            , 0                   , 0              , "MV"   ),
+  ROW(SimdMovQ            , 0                   , 0              , "VV"   ),
+  ROW(SimdMovQ            , 0                   , 0              , "VM"   ),
+  ROW(SimdMovQ            , 0                   , 0              , "MV"   ),
+  ROW(SimdMovQ            , 0                   , 0              , "VG"   ),
+  ROW(SimdMovQ            , 0                   , 0              , "GV"   ),
+  ROW(SimdExtrq           , 0                   , 0              , "RR"   ),
+  ROW(SimdExtrq           , 0                   , 0              , "RII"  ),
+  ROW(SimdInsertq         , 0                   , 0              , "RR"   ),
+  ROW(SimdInsertq         , 0                   , 0              , "RRII" ),
+  ROW(Simd3dNow           , 0                   , 0              , "RR"   ),
+  ROW(Simd3dNow           , 0                   , 0              , "RM"   ),
+  ROW(AvxOp               , 0                   , 0              , ""     ),
+  ROW(AvxM                , 0                   , 0              , "M"    ),
+  ROW(AvxMr               , 0                   , 0              , "RR"   ),
+  ROW(AvxMr               , 0                   , 0              , "MR"   ),
+  ROW(AvxMr_OptL          , 0                   , 0              , "RR"   ),
+  ROW(AvxMr_OptL          , 0                   , 0              , "MR"   ),
+  ROW(AvxMr_T1S           , 0                   , 0              , "RR"   ),
+  ROW(AvxMr_T1S           , 0                   , 0              , "MR"   ),
+  ROW(AvxMri              , 0                   , 0              , "RRI"  ),
+  ROW(AvxMri              , 0                   , 0              , "MRI"  ),
+  ROW(AvxMri_OptL         , 0                   , 0              , "RRI"  ),
+  ROW(AvxMri_OptL         , 0                   , 0              , "MRI"  ),
+  ROW(AvxRm               , 0                   , 0              , "RR"   ),
+  ROW(AvxRm               , 0                   , 0              , "RM"   ),
+  ROW(AvxRm_OptL          , 0                   , 0              , "RR"   ),
+  ROW(AvxRm_OptL          , 0                   , 0              , "RM"   ),
+  ROW(AvxRm_T1S           , 0                   , 0              , "RR"   ),
+  ROW(AvxRm_T1S           , 0                   , 0              , "RM"   ),
+  ROW(AvxRmi              , 0                   , 0              , "RRI"  ),
+  ROW(AvxRmi              , 0                   , 0              , "RMI"  ),
+  ROW(AvxRmi_OptW         , 0                   , 0              , "RRI"  ),
+  ROW(AvxRmi_OptW         , 0                   , 0              , "RMI"  ),
+  ROW(AvxRmi_OptL         , 0                   , 0              , "RRI"  ),
+  ROW(AvxRmi_OptL         , 0                   , 0              , "RMI"  ),
+  ROW(AvxRvm              , 0                   , 0              , "RRR"  ),
+  ROW(AvxRvm              , 0                   , 0              , "RRM"  ),
+  ROW(AvxRvm_OptW         , 0                   , 0              , "RRR"  ),
+  ROW(AvxRvm_OptW         , 0                   , 0              , "RRM"  ),
+  ROW(AvxRvm_OptL         , 0                   , 0              , "RRR"  ),
+  ROW(AvxRvm_OptL         , 0                   , 0              , "RRM"  ),
+  ROW(AvxRvmr             , 0                   , 0              , "RRRR" ),
+  ROW(AvxRvmr             , 0                   , 0              , "RRMR" ),
+  ROW(AvxRvmr_OptL        , 0                   , 0              , "RRRR" ),
+  ROW(AvxRvmr_OptL        , 0                   , 0              , "RRMR" ),
+  ROW(AvxRvmi             , 0                   , 0              , "RRRI" ),
+  ROW(AvxRvmi             , 0                   , 0              , "RRMI" ),
+  ROW(AvxRvmi_OptL        , 0                   , 0              , "RRRI" ),
+  ROW(AvxRvmi_OptL        , 0                   , 0              , "RRMI" ),
+  ROW(AvxRmv              , 0                   , 0              , "RRR"  ),
+  ROW(AvxRmv              , 0                   , 0              , "RMR"  ),
+  ROW(AvxRmv_OptW         , 0                   , 0              , "RRR"  ),
+  ROW(AvxRmv_OptW         , 0                   , 0              , "RMR"  ),
+  ROW(AvxRmvi             , 0                   , 0              , "RRRI" ),
+  ROW(AvxRmvi             , 0                   , 0              , "RMRI" ),
+  ROW(AvxRmMr             , 0                   , 0              , "RR"   ),
+  ROW(AvxRmMr             , 0                   , 0              , "RM"   ),
+  ROW(AvxRmMr             , 0                   , 0              , "MR"   ),
+  ROW(AvxRmMr_OptL        , 0                   , 0              , "RR"   ),
+  ROW(AvxRmMr_OptL        , 0                   , 0              , "RM"   ),
+  ROW(AvxRmMr_OptL        , 0                   , 0              , "MR"   ),
+  ROW(AvxRvmRmi           , 0                   , 0              , "RRR"  ),
+  ROW(AvxRvmRmi           , 0                   , 0              , "RRM"  ),
+  ROW(AvxRvmRmi           , 0                   , 0              , "RRI"  ),
+  ROW(AvxRvmRmi           , 0                   , 0              , "RMI"  ),
+  ROW(AvxRvmRmi_OptL      , 0                   , 0              , "RRR"  ),
+  ROW(AvxRvmRmi_OptL      , 0                   , 0              , "RRM"  ),
+  ROW(AvxRvmRmi_OptL      , 0                   , 0              , "RRI"  ),
+  ROW(AvxRvmRmi_OptL      , 0                   , 0              , "RMI"  ),
+  ROW(AvxRvmMr            , 0                   , 0              , "RRR"  ),
+  ROW(AvxRvmMr            , 0                   , 0              , "RRM"  ),
+  ROW(AvxRvmMr            , 0                   , 0              , "RR"   ),
+  ROW(AvxRvmMr            , 0                   , 0              , "MR"   ),
+  ROW(AvxRvmMvr           , 0                   , 0              , "RRR"  ),
+  ROW(AvxRvmMvr           , 0                   , 0              , "RRM"  ),
+  ROW(AvxRvmMvr           , 0                   , 0              , "MRR"  ),
+  ROW(AvxRvmMvr_OptL      , 0                   , 0              , "RRR"  ),
+  ROW(AvxRvmMvr_OptL      , 0                   , 0              , "RRM"  ),
+  ROW(AvxRvmMvr_OptL      , 0                   , 0              , "MRR"  ),
+  ROW(AvxRvmVmi           , 0                   , 0              , "RRR"  ),
+  ROW(AvxRvmVmi           , 0                   , 0              , "RRM"  ),
+  ROW(AvxRvmVmi           , 0                   , 0              , "RRI"  ),
+  ROW(AvxRvmVmi           , 0                   , 0              , "RMI"  ),
+  ROW(AvxRvmVmi_OptL      , 0                   , 0              , "RRR"  ),
+  ROW(AvxRvmVmi_OptL      , 0                   , 0              , "RRM"  ),
+  ROW(AvxRvmVmi_OptL      , 0                   , 0              , "RRI"  ),
+  ROW(AvxRvmVmi_OptL      , 0                   , 0              , "RMI"  ),
+  ROW(AvxVm               , 0                   , 0              , "RR"   ),
+  ROW(AvxVm               , 0                   , 0              , "RM"   ),
+  ROW(AvxVm_OptW          , 0                   , 0              , "RR"   ),
+  ROW(AvxVm_OptW          , 0                   , 0              , "RM"   ),
+  ROW(AvxVmi              , 0                   , 0              , "RRI"  ),
+  ROW(AvxVmi              , 0                   , 0              , "RMI"  ),
+  ROW(AvxVmi_OptL         , 0                   , 0              , "RRI"  ),
+  ROW(AvxVmi_OptL         , 0                   , 0              , "RMI"  ),
+  ROW(AvxRvrmRvmr         , 0                   , 0              , "RRRR" ),
+  ROW(AvxRvrmRvmr         , 0                   , 0              , "RRRM" ),
+  ROW(AvxRvrmRvmr         , 0                   , 0              , "RRMR" ),
+  ROW(AvxRvrmRvmr_OptL    , 0                   , 0              , "RRRR" ),
+  ROW(AvxRvrmRvmr_OptL    , 0                   , 0              , "RRRM" ),
+  ROW(AvxRvrmRvmr_OptL    , 0                   , 0              , "RRMR" ),
+  ROW(AvxKMov             , 0                   , 0              , "VV"   ),
+  ROW(AvxKMov             , 0                   , 0              , "VG"   ),
+  ROW(AvxKMov             , 0                   , 0              , "GV"   ),
+  ROW(AvxKMov             , 0                   , 0              , "VM"   ),
+  ROW(AvxKMov             , 0                   , 0              , "MV"   ),
+  ROW(AvxMovDQ            , 0                   , 0              , "VG"   ),
+  ROW(AvxMovDQ            , 0                   , 0              , "GV"   ),
+  ROW(AvxMovDQ            , 0                   , 0              , "VM"   ),
+  ROW(AvxMovDQ            , 0                   , 0              , "MV"   ),
+  ROW(AvxMovSsSd          , 0                   , 0              , "RRR"  ),
+  ROW(AvxMovSsSd          , 0                   , 0              , "RM"   ),
+  ROW(AvxMovSsSd          , 0                   , 0              , "MR"   ),
+  ROW(AvxGather           , 0                   , 0              , "RXR"  ),
+  ROW(AvxGatherEx         , 0                   , 0              , "RXR"  ),
+  ROW(Fma4                , 0                   , 0              , "RRRR" ),
+  ROW(Fma4                , 0                   , 0              , "RRRM" ),
+  ROW(Fma4                , 0                   , 0              , "RRMR" ),
+  ROW(Fma4_OptL           , 0                   , 0              , "RRRR" ),
+  ROW(Fma4_OptL           , 0                   , 0              , "RRRM" ),
+  ROW(Fma4_OptL           , 0                   , 0              , "RRMR" ),
+  ROW(XopRm               , 0                   , 0              , "RR"   ),
+  ROW(XopRm               , 0                   , 0              , "RM"   ),
+  ROW(XopRm_OptL          , 0                   , 0              , "RR"   ),
+  ROW(XopRm_OptL          , 0                   , 0              , "RM"   ),
+  ROW(XopRvmRmv           , 0                   , 0              , "RRR"  ),
+  ROW(XopRvmRmv           , 0                   , 0              , "RMR"  ),
+  ROW(XopRvmRmv           , 0                   , 0              , "RRM"  ),
+  ROW(XopRvmRmi           , 0                   , 0              , "RRR"  ),
+  ROW(XopRvmRmi           , 0                   , 0              , "RMR"  ),
+  ROW(XopRvmRmi           , 0                   , 0              , "RRM"  ),
+  ROW(XopRvmRmi           , 0                   , 0              , "RRI"  ),
+  ROW(XopRvmRmi           , 0                   , 0              , "RMI"  ),
+  ROW(XopRvmr             , 0                   , 0              , "RRRR" ),
+  ROW(XopRvmr             , 0                   , 0              , "RRMR" ),
+  ROW(XopRvmr_OptL        , 0                   , 0              , "RRRR" ),
+  ROW(XopRvmr_OptL        , 0                   , 0              , "RRMR" ),
+  ROW(XopRvmi             , 0                   , 0              , "RRRI" ),
+  ROW(XopRvmi             , 0                   , 0              , "RRMI" ),
+  ROW(XopRvmi_OptL        , 0                   , 0              , "RRRI" ),
+  ROW(XopRvmi_OptL        , 0                   , 0              , "RRMI" ),
+  ROW(XopRvrmRvmr         , 0                   , 0              , "RRRR" ),
+  ROW(XopRvrmRvmr         , 0                   , 0              , "RRRM" ),
+  ROW(XopRvrmRvmr         , 0                   , 0              , "RRMR" ),
+  ROW(XopRvrmRvmr_OptL    , 0                   , 0              , "RRRR" ),
+  ROW(XopRvrmRvmr_OptL    , 0                   , 0              , "RRRM" ),
+  ROW(XopRvrmRvmr_OptL    , 0                   , 0              , "RRMR" ),
+  ROW(XopVm_OptW          , 0                   , 0              , "RR"   ),
+  ROW(XopVm_OptW          , 0                   , 0              , "RM"   )
+};
+
+#undef ROW
+
+//! \internal
+//!
+//! Register kind used by probes.
+struct X86ProbeKind {
+  uint16_t flag;
+  uint8_t regType;
+  uint8_t size;
+};
+
+static const X86ProbeKind x86ProbeKinds[] = {
+  { kX86InstOpGd , kX86RegTypeGpd  , 4  },
+  { kX86InstOpGq , kX86RegTypeGpq  , 8  },
+  { kX86InstOpGw , kX86RegTypeGpw  , 2  },
+  { kX86InstOpGb , kX86RegTypeGpbLo, 1  },
+  { kX86InstOpFp , kX86RegTypeFp   , 10 },
+  { kX86InstOpMm , kX86RegTypeMm   , 8  },
+  { kX86InstOpK  , kX86RegTypeK    , 8  },
+  { kX86InstOpXmm, kX86RegTypeXmm  , 16 },
+  { kX86InstOpYmm, kX86RegTypeYmm  , 32 },
+  { kX86InstOpZmm, kX86RegTypeZmm  , 64 }
+};
+
+//! \internal
+//!
+//! Immediate values used by probes, the first value of each class is used by
+//! the base probe and the second one by the probe that varies the immediate.
+static const uint64_t x86ProbeImm[3][2] = {
+  { ASMJIT_UINT64_C(0x0000000000000011), ASMJIT_UINT64_C(0x0000000000000022) },
+  { ASMJIT_UINT64_C(0x0000000011223344), ASMJIT_UINT64_C(0x0000000022334455) },
+  { ASMJIT_UINT64_C(0x1122334455667788), ASMJIT_UINT64_C(0x2233445566778899) }
+};
+
+//! \internal
+//!
+//! Register indexes used by probes - base and varied.
+static const uint32_t kX86ProbeRegBase = 1;
+static const uint32_t kX86ProbeRegVariant = 2;
+
+//! \internal
+//!
+//! Kind of a probe operand.
+ASMJIT_ENUM(X86ProbeOpKind) {
+  kX86ProbeOpNone = 0,
+  kX86ProbeOpReg = 1,
+  kX86ProbeOpFixedReg = 2,
+  kX86ProbeOpMem = 3,
+  kX86ProbeOpImm = 4,
+  kX86ProbeOpFixedImm = 5,
+  kX86ProbeOpLabel = 6
+};
+
+//! \internal
+//!
+//! Operand candidate of a probe.
+struct X86ProbeOp {
+  //! Kind, see \ref X86ProbeOpKind.
+  uint8_t kind;
+  //! Register type.
+  uint8_t regType;
+  //! Register or memory size.
+  uint8_t size;
+  //! Fixed register index, fixed immediate value, or VSIB.
+  uint8_t value;
+};
+
+//! \internal
+//!
+//! Builds decoder forms by emitting all instructions by `X86Assembler`.
+struct X86DecoderBuilder {
+  X86DecoderBuilder(uint32_t arch) noexcept
+    : _runtime(nullptr),
+      _assembler(&_runtime, arch),
+      _arch(arch) {}
+
+  Error build() noexcept;
+  void probeRow(uint32_t instId, const X86ProbeRow& row) noexcept;
+  void probe(uint32_t instId, const X86ProbeOp* ops, uint32_t opCount, uint32_t immClass, uint32_t options) noexcept;
+
+  uint32_t getCandidates(X86ProbeOp* out, uint32_t letter, uint32_t opFlags, uint32_t kinds, bool raw, uint32_t instFlags) const noexcept;
+  void makeOp(Operand& op, const X86ProbeOp& src, uint32_t regIndex, uint64_t imm) const noexcept;
+  uint32_t emit(uint8_t* dst, uint32_t instId, uint32_t options, const Operand* ops) noexcept;
+  void addForm(const X86DecoderForm& form, bool hasOpLow) noexcept;
+
+  StaticRuntime _runtime;
+  X86Assembler _assembler;
+  uint32_t _arch;
+  PodVector<X86DecoderForm> _forms;
+  Error _error;
+};
+
+uint32_t X86DecoderBuilder::getCandidates(X86ProbeOp* out, uint32_t letter, uint32_t opFlags, uint32_t kinds, bool raw, uint32_t instFlags) const noexcept {
+  uint32_t regKinds = raw ? kinds : (opFlags & (kinds ? kinds : static_cast<uint32_t>(kX86ProbeAllRegs)));
+  uint32_t nativeGp = _arch == kArchX86 ? kX86InstOpGd : kX86InstOpGq;
+  uint32_t nativeSize = _arch == kArchX86 ? 4 : 8;
+
+  if (_arch == kArchX86)
+    regKinds &= ~kX86InstOpGq;
+
+  bool canMem = raw || (opFlags & kX86InstOpMem) != 0;
+  bool canImm = raw || (opFlags & kX86InstOpImm) != 0;
+  bool canLabel = raw || (opFlags & kX86InstOpLabel) != 0;
+
+  uint32_t n = 0;
+  uint32_t letterKinds = 0;
+  uint32_t fixedIndex = 0;
+
+  switch (letter) {
+    case 'R': letterKinds = kX86ProbeAllRegs; break;
+    case 'G': letterKinds = kX86ProbeGp; break;
+    case 'V': letterKinds = kX86ProbeVec; break;
+    case 'N': letterKinds = nativeGp; break;
+    case 'W': letterKinds = nativeGp | kX86InstOpGw; break;
+
+    case 'x':
+      fixedIndex = kX86RegIndexCx;
+      ASMJIT_FALLTHROUGH;
+
+    case 'a':
+      for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(x86ProbeKinds); i++) {
+        const X86ProbeKind& k = x86ProbeKinds[i];
+        if ((regKinds & k.flag & kX86ProbeGp) == 0)
+          continue;
+
+        X86ProbeOp& op = out[n++];
+        op.kind = kX86ProbeOpFixedReg;
+        op.regType = k.regType;
+        op.size = k.size;
+        op.value = static_cast<uint8_t>(fixedIndex);
+      }
+      return n;
+
+    case 'c':
+    case 's': {
+      X86ProbeOp& op = out[n++];
+      op.kind = kX86ProbeOpFixedReg;
+      op.regType = letter == 'c' ? kX86RegTypeGpbLo : kX86RegTypeFp;
+      op.size = letter == 'c' ? 1 : 10;
+      op.value = letter == 'c' ? kX86RegIndexCx : 0;
+      return n;
+    }
+
+    case 'Z': {
+      X86ProbeOp& op = out[n++];
+      op.kind = kX86ProbeOpReg;
+      op.regType = kX86RegTypeSeg;
+      op.size = 2;
+      op.value = 0;
+      return n;
+    }
+
+    case 'M':
+    case 'S':
+    case 'F':
+    case 'D':
+    case 'P':
+    case 'Q':
+    case 'X': {
+      if (!canMem)
+        return 0;
+
+      uint8_t sizes[8];
+      uint32_t count = 0;
+
+      if (letter == 'M' || letter == 'Q') {
+        sizes[count++] = 0;
+        if (letter == 'Q')
+          sizes[count++] = 8;
+      }
+      else if (letter == 'S') {
+        for (uint32_t i = 0; i < 4; i++)
+          if (regKinds & x86ProbeKinds[i].flag)
+            sizes[count++] = x86ProbeKinds[i].size;
+      }
+      else if (letter == 'F') {
+        if (instFlags & kX86InstFlagMem2 ) sizes[count++] = 2;
+        if (instFlags & kX86InstFlagMem4 ) sizes[count++] = 4;
+        if (instFlags & kX86InstFlagMem8 ) sizes[count++] = 8;
+        if (instFlags & kX86InstFlagMem10) sizes[count++] = 10;
+      }
+      else if (letter == 'D') {
+        sizes[count++] = 4;
+        sizes[count++] = 8;
+      }
+      else if (letter == 'P') {
+        sizes[count++] = 2;
+        sizes[count++] = static_cast<uint8_t>(nativeSize);
+      }
+      else {
+        sizes[count++] = 0;
+        sizes[count++] = 0;
+      }
+
+      for (uint32_t i = 0; i < count; i++) {
+        X86ProbeOp& op = out[n++];
+        op.kind = kX86ProbeOpMem;
+        op.regType = 0;
+        op.size = sizes[i];
+        op.value = letter == 'X' ? static_cast<uint8_t>(kX86MemVSibXmm + i) : static_cast<uint8_t>(kX86MemVSibGpz);
+      }
+      return n;
+    }
+
+    case 'I':
+    case 'L': {
+      if (!(letter == 'I' ? canImm : canLabel))
+        return 0;
+
+      X86ProbeOp& op = out[n++];
+      op.kind = letter == 'I' ? kX86ProbeOpImm : kX86ProbeOpLabel;
+      op.regType = 0;
+      op.size = 0;
+      op.value = 0;
+      return n;
+    }
+
+    case '1':
+    case '3': {
+      X86ProbeOp& op = out[n++];
+      op.kind = kX86ProbeOpFixedImm;
+      op.regType = 0;
+      op.size = 0;
+      op.value = static_cast<uint8_t>(letter - '0');
+      return n;
+    }
+
+    default:
+      return 0;
+  }
+
+  for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(x86ProbeKinds); i++) {
+    const X86ProbeKind& k = x86ProbeKinds[i];
+    if ((regKinds & letterKinds & k.flag) == 0)
+      continue;
+
+    X86ProbeOp& op = out[n++];
+    op.kind = kX86ProbeOpReg;
+    op.regType = k.regType;
+    op.size = k.size;
+    op.value = 0;
+  }
+  return n;
+}
+
+void X86DecoderBuilder::makeOp(Operand& op, const X86ProbeOp& src, uint32_t regIndex, uint64_t imm) const noexcept {
+  switch (src.kind) {
+    case kX86ProbeOpReg:
+      op = X86Reg(src.regType, regIndex, src.size);
+      break;
+
+    case kX86ProbeOpFixedReg:
+      op = X86Reg(src.regType, src.value, src.size);
+      break;
+
+    case kX86ProbeOpMem: {
+      uint32_t gpType = _arch == kArchX86 ? kX86RegTypeGpd : kX86RegTypeGpq;
+      X86GpReg base(gpType, kX86RegIndexBx, X86Decoder_getRegSize(gpType));
+
+      if (src.value == kX86MemVSibXmm)
+        op = x86::ptr(base, X86XmmReg(kX86RegTypeXmm, 7, 16), 0, 0, src.size);
+      else if (src.value == kX86MemVSibYmm)
+        op = x86::ptr(base, X86YmmReg(kX86RegTypeYmm, 7, 32), 0, 0, src.size);
+      else
+        op = x86::ptr(base, 0, src.size);
+      break;
+    }
+
+    case kX86ProbeOpImm:
+      op = Imm(static_cast<int64_t>(imm));
+      break;
+
+    case kX86ProbeOpFixedImm:
+      op = Imm(src.value);
+      break;
+
+    case kX86ProbeOpLabel:
+      // Replaced by a new label when emitted.
+      op = Label();
+      break;
+
+    default:
+      op = noOperand;
+      break;
+  }
+}
+
+uint32_t X86DecoderBuilder::emit(uint8_t* dst, uint32_t instId, uint32_t options, const Operand* ops) noexcept {
+  X86Assembler& a = _assembler;
+  Operand opList[4];
+
+  a.reset(false);
+  for (uint32_t i = 0; i < 4; i++) {
+    if (ops[i].isLabel())
+      opList[i] = a.newLabel();
+    else
+      opList[i] = ops[i];
+  }
+
+  a.setInstOptions(options);
+  a.emit(instId, opList[0], opList[1], opList[2], opList[3]);
+
+  size_t size = a.getOffset();
+  if (a.getLastError() != kErrorOk || size == 0 || size > kX86DecoderMaxInstSize)
+    return 0;
+
+  a.copyCode(dst, size);
+  return static_cast<uint32_t>(size);
+}
+
+void X86DecoderBuilder::addForm(const X86DecoderForm& form, bool hasOpLow) noexcept {
+  if (!hasOpLow) {
+    if (_forms.append(form) != kErrorOk)
+      _error = kErrorNoHeapMemory;
+    return;
+  }
+
+  // The register is a part of the opcode, add the form to all 8 opcodes.
+  X86DecoderForm copy = form;
+  for (uint32_t i = 0; i < 8; i++) {
+    copy.key = static_cast<uint16_t>((form.key & ~0x7) | i);
+    if (_forms.append(copy) != kErrorOk)
+      _error = kErrorNoHeapMemory;
+  }
+}
+
+void X86DecoderBuilder::probe(uint32_t instId, const X86ProbeOp* ops, uint32_t opCount, uint32_t immClass, uint32_t options) noexcept {
+  const X86InstExtendedInfo& extendedInfo = X86Util::getInstInfo(instId).getExtendedInfo();
+  uint32_t encoding = extendedInfo.getEncoding();
+
+  Operand base[4];
+  uint32_t i;
+
+  for (i = 0; i < 4; i++) {
+    if (i < opCount)
+      makeOp(base[i], ops[i], kX86ProbeRegBase, x86ProbeImm[immClass][0]);
+    else
+      base[i] = noOperand;
+  }
+
+  uint8_t code[16];
+  uint32_t size = emit(code, instId, options, base);
+  if (size == 0)
+    return;
+
+  X86DecoderHeader h;
+  if (!X86Decoder_parseHeader(h, code, size, _arch, true) || h.modRmPos > size)
+    return;
+
+  X86DecoderForm form;
+  ::memset(&form, 0, sizeof(X86DecoderForm));
+  form.instId = static_cast<uint16_t>(instId);
+  form.opCount = static_cast<uint8_t>(opCount);
+
+  bool hasMem = false;
+  uint32_t vSib = kX86MemVSibGpz;
+
+  for (i = 0; i < opCount; i++) {
+    if (ops[i].kind == kX86ProbeOpMem) {
+      hasMem = true;
+      vSib = ops[i].value;
+    }
+  }
+
+  // EVEX - only the length is decoded, the form describes the immediate size.
+  if (h.map >= kX86DecoderMapEvex0F) {
+    uint32_t modRmSize = hasMem ? X86Decoder_parseMem(nullptr, code + h.modRmPos, size - h.modRmPos, _arch, h, vSib, 0) : 1;
+    uint32_t immPos = h.modRmPos + modRmSize;
+
+    if (modRmSize == 0 || immPos > size)
+      return;
+
+    form.key = static_cast<uint16_t>((h.map << 8) | h.opCode);
+    form.features = static_cast<uint8_t>(h.features & kX86DecoderFeaturePP);
+    form.flags = kX86DecoderFormModRm | kX86DecoderFormEvex;
+    form.immSize = static_cast<uint8_t>(size - immPos);
+    form.opCount = 0;
+
+    addForm(form, false);
+    return;
+  }
+
+  // Vary each register and immediate and look at what changed.
+  uint32_t immChanged[4];
+  bool hasReg = false;
+  bool hasRm = false;
+  bool hasOpLow = false;
+  bool hasVvvv = false;
+  bool hasImmReg = false;
+  bool hasLabel = false;
+
+  for (i = 0; i < opCount; i++) {
+    X86DecoderOp& dst = form.opList[i];
+    const X86ProbeOp& src = ops[i];
+
+    immChanged[i] = kInvalidValue;
+
+    switch (src.kind) {
+      case kX86ProbeOpFixedReg:
+        dst.field = kX86DecoderFieldFixed;
+        dst.type = src.regType;
+        dst.size = src.size;
+        dst.value = src.value;
+        continue;
+
+      case kX86ProbeOpFixedImm:
+        dst.field = kX86DecoderFieldImmFixed;
+        dst.value = src.value;
+        continue;
+
+      case kX86ProbeOpMem:
+        dst.field = kX86DecoderFieldMem;
+        dst.type = src.value;
+        dst.size = src.size;
+        continue;
+
+      case kX86ProbeOpLabel:
+        dst.field = kX86DecoderFieldRel;
+        hasLabel = true;
+        continue;
+    }
+
+    Operand variant[4];
+    for (uint32_t j = 0; j < 4; j++)
+      variant[j] = base[j];
+    makeOp(variant[i], src, kX86ProbeRegVariant, x86ProbeImm[immClass][1]);
+
+    uint8_t code2[16];
+    if (emit(code2, instId, options, variant) != size)
+      return;
+
+    uint32_t pos = 0;
+    while (pos < size && code[pos] == code2[pos])
+      pos++;
+
+    if (pos == size)
+      return;
+
+    uint32_t x = code[pos] ^ code2[pos];
+
+    if (src.kind == kX86ProbeOpImm) {
+      if (hasMem && pos == h.modRmPos && (x & ~0x18U) == 0) {
+        dst.field = kX86DecoderFieldImmReg;
+        hasImmReg = true;
+      }
+      else {
+        dst.field = kX86DecoderFieldImm;
+        immChanged[i] = pos;
+      }
+      continue;
+    }
+
+    // Only one byte can change if a register changes.
+    for (uint32_t j = pos + 1; j < size; j++)
+      if (code[j] != code2[j])
+        return;
+
+    dst.type = src.regType;
+    dst.size = src.size;
+
+    if (pos == h.modRmPos) {
+      if ((x & ~0x38U) == 0) {
+        dst.field = kX86DecoderFieldReg;
+        hasReg = true;
+      }
+      else if ((x & ~0x07U) == 0) {
+        dst.field = kX86DecoderFieldRm;
+        hasRm = true;
+      }
+      else if ((x & ~0x3FU) == 0) {
+        dst.field = kX86DecoderFieldRegRm;
+        hasReg = true;
+        hasRm = true;
+      }
+      else {
+        return;
+      }
+    }
+    else if (pos == h.opPos && (x & ~0x07U) == 0) {
+      dst.field = kX86DecoderFieldOpLow;
+      hasOpLow = true;
+    }
+    else if (pos == h.vvvvPos && (x & ~0x78U) == 0) {
+      dst.field = kX86DecoderFieldVvvv;
+      hasVvvv = true;
+    }
+    else if (pos > h.modRmPos && (x & ~0xF0U) == 0) {
+      dst.field = kX86DecoderFieldIs4;
+      immChanged[i] = pos;
+    }
+    else {
+      return;
+    }
+  }
+
+  // ModR/M is present if there is a memory operand or a register encoded in
+  // it, otherwise a single byte between the opcode and immediates is a fixed
+  // ModR/M (FPU and system instructions).
+  bool hasModRm = hasMem || hasReg || hasRm;
+  bool fixedModRm = false;
+
+  if (!hasModRm) {
+    uint32_t end = hasLabel ? h.modRmPos : size;
+    for (i = 0; i < opCount; i++)
+      if (immChanged[i] != kInvalidValue && immChanged[i] < end)
+        end = immChanged[i];
+
+    if (end < h.modRmPos || end - h.modRmPos > 1)
+      return;
+
+    if (end - h.modRmPos == 1) {
+      hasModRm = true;
+      fixedModRm = true;
+    }
+  }
+
+  uint32_t modRmSize = 0;
+  if (hasMem) {
+    modRmSize = X86Decoder_parseMem(nullptr, code + h.modRmPos, size - h.modRmPos, _arch, h, vSib, 0);
+    if (modRmSize == 0)
+      return;
+  }
+  else if (hasModRm) {
+    modRmSize = 1;
+  }
+
+  uint32_t opCode = h.opCode;
+  uint32_t immPos = h.modRmPos + modRmSize;
+
+  if (h.map == kX86DecoderMap3dNow) {
+    if (immPos >= size)
+      return;
+    opCode = code[immPos++];
+  }
+
+  if (immPos > size)
+    return;
+
+  uint32_t immSize = size - immPos;
+
+  if (hasLabel) {
+    if (immSize != 1 && immSize != 4)
+      return;
+
+    for (i = 0; i < opCount; i++)
+      if (form.opList[i].field == kX86DecoderFieldRel)
+        form.opList[i].size = static_cast<uint8_t>(immSize);
+  }
+  else {
+    // Immediates follow each other, sizes are given by their offsets.
+    uint32_t offset = 0;
+    for (;;) {
+      uint32_t current = kInvalidValue;
+      uint32_t next = immSize;
+
+      for (i = 0; i < opCount; i++) {
+        if (immChanged[i] == kInvalidValue)
+          continue;
+
+        uint32_t immOffset = immChanged[i] - immPos;
+        if (immChanged[i] < immPos || immOffset >= immSize)
+          return;
+
+        if (immOffset == offset) {
+          if (current != kInvalidValue)
+            return;
+          current = i;
+        }
+        else if (immOffset > offset && immOffset < next) {
+          next = immOffset;
+        }
+      }
+
+      if (current == kInvalidValue) {
+        if (offset != immSize)
+          return;
+        break;
+      }
+
+      X86DecoderOp& dst = form.opList[current];
+      uint32_t opSize = next - offset;
+
+      if (dst.field == kX86DecoderFieldIs4) {
+        if (opSize != 1)
+          return;
+      }
+      else {
+        if (opSize != 1 && opSize != 2 && opSize != 4 && opSize != 8)
+          return;
+
+        // Immediates are sign-extended to the operand size. 8-bit immediates
+        // are only signed if there is a longer alternative encoding.
+        bool isSigned = (opSize == 1 && (encoding == kX86InstEncodingX86Arith ||
+                                         encoding == kX86InstEncodingX86Imul  ||
+                                         encoding == kX86InstEncodingX86Push)) ||
+                        (opSize == 4 && ((h.features & kX86DecoderFeatureW) != 0 ||
+                                         encoding == kX86InstEncodingX86Push));
+        dst.size = static_cast<uint8_t>(opSize);
+        dst.type = isSigned;
+      }
+
+      dst.value = static_cast<uint8_t>(offset);
+      offset = next;
+    }
+  }
+
+  uint32_t flags = 0;
+  if (hasModRm) {
+    uint32_t modRm = code[h.modRmPos];
+    uint32_t mask;
+
+    if (fixedModRm)
+      mask = 0xFF;
+    else if (hasMem)
+      mask = hasReg ? 0x00 : hasImmReg ? 0x20 : 0x38;
+    else
+      mask = 0xC0 | (hasReg ? 0x00 : 0x38) | (hasRm ? 0x00 : 0x07);
+
+    form.modRmMask = static_cast<uint8_t>(mask);
+    form.modRmValue = static_cast<uint8_t>(modRm & mask);
+    flags |= kX86DecoderFormModRm;
+  }
+
+  if (hasMem)
+    flags |= kX86DecoderFormMem;
+
+  if (hasVvvv)
+    flags |= kX86DecoderFormVvvv;
+
+  if (hasLabel && (options & kInstOptionShortForm) != 0)
+    flags |= kX86DecoderFormShort;
+
+  if (encoding == kX86InstEncodingX86Jcc)
+    flags |= kX86DecoderFormJcc;
+
+  uint32_t extMask = 0;
+  if (hasReg)
+    extMask |= kX86DecoderExtR;
+  if (hasRm || hasOpLow || hasMem)
+    extMask |= kX86DecoderExtB;
+  if (hasMem)
+    extMask |= kX86DecoderExtX;
+
+  uint32_t features = h.features;
+  if (hasMem)
+    features &= ~kX86DecoderFeature67;
+
+  form.key = static_cast<uint16_t>((h.map << 8) | opCode);
+  form.features = static_cast<uint8_t>(features);
+  form.flags = static_cast<uint8_t>(flags);
+  form.extMask = static_cast<uint8_t>(extMask);
+  form.immSize = static_cast<uint8_t>(immSize);
+
+  addForm(form, hasOpLow);
+}
+
+void X86DecoderBuilder::probeRow(uint32_t instId, const X86ProbeRow& row) noexcept {
+  const X86InstInfo& info = X86Util::getInstInfo(instId);
+  const X86InstExtendedInfo& extendedInfo = info.getExtendedInfo();
+
+  // Instructions that require REX.W are X64 only, in X86 mode the assembler
+  // would emit the same bytes as their 32-bit variants (`cdqe` and `cwde`).
+  if (_arch == kArchX86 && extendedInfo.getEncoding() < kX86InstEncodingFpuOp &&
+      (info.getPrimaryOpCode() & kX86InstOpCode_W) != 0)
+    return;
+
+  uint32_t opCount = static_cast<uint32_t>(::strlen(row.shape));
+  bool raw = (row.flags & kX86ProbeFlagRaw) != 0 || extendedInfo.getOperandFlags(0) == 0;
+
+  X86ProbeOp candidates[4][16];
+  uint32_t counts[4];
+  uint32_t i;
+
+  bool hasImm = false;
+  bool hasLabel = false;
+
+  for (i = 0; i < opCount; i++) {
+    uint32_t letter = static_cast<uint8_t>(row.shape[i]);
+    counts[i] = getCandidates(candidates[i], letter,
+      extendedInfo.getOperandFlags(i), row.kinds, raw, extendedInfo.getFlags());
+
+    if (counts[i] == 0)
+      return;
+
+    hasImm |= letter == 'I';
+    hasLabel |= letter == 'L';
+  }
+
+  // Iterate over all combinations of candidates. Combinations that use the
+  // same vector register type are probed first - some instructions encode
+  // MM and XMM operands the same way if one of them is XMM (like `phsubsw`)
+  // and the first form that matches is the one that is decoded.
+  for (uint32_t pass = 0; pass < 2; pass++) {
+    uint32_t indexes[4] = { 0, 0, 0, 0 };
+
+    for (;;) {
+      X86ProbeOp ops[4];
+      Operand opList[4];
+
+      bool valid = true;
+      bool mixed = false;
+
+      uint32_t sameType = 0;
+      uint32_t sameSize = 0;
+      uint32_t vecType = 0;
+
+      for (i = 0; i < opCount; i++) {
+        ops[i] = candidates[i][indexes[i]];
+        makeOp(opList[i], ops[i], kX86ProbeRegBase, x86ProbeImm[0][0]);
+
+        uint32_t regType = ops[i].kind == kX86ProbeOpReg ? ops[i].regType : 0;
+        if ((row.flags & kX86ProbeFlagSame) != 0) {
+          if (regType != 0) {
+            if (sameType == 0)
+              sameType = regType;
+            else if (sameType != regType)
+              valid = false;
+          }
+
+          uint32_t size = (regType != 0 && regType <= kX86RegTypeGpq) || ops[i].kind == kX86ProbeOpMem ? ops[i].size : 0;
+          if (size != 0) {
+            if (sameSize == 0)
+              sameSize = size;
+            else if (sameSize != size)
+              valid = false;
+          }
+        }
+
+        if (regType >= kX86RegTypeMm && regType <= kX86RegTypeZmm && regType != kX86RegTypeK) {
+          if (vecType == 0)
+            vecType = regType;
+          else if (vecType != regType)
+            mixed = true;
+        }
+      }
+
+      if (valid && mixed != (pass != 0))
+        valid = false;
+
+      if (valid && !raw)
+        valid = X86Util::validateInst(_arch, nullptr, instId, 0, opList, opCount) == kErrorOk;
+
+      if (valid) {
+        uint32_t immClassCount = !hasImm ? 1 : ((row.flags & kX86ProbeFlagImm64) && _arch == kArchX64) ? 3 : 2;
+        for (uint32_t immClass = 0; immClass < immClassCount; immClass++)
+          probe(instId, ops, opCount, immClass, 0);
+
+        if (hasLabel && (row.flags & kX86ProbeFlagShort) != 0)
+          probe(instId, ops, opCount, 0, kInstOptionShortForm);
+      }
+
+      // Next combination.
+      for (i = 0; i < opCount; i++) {
+        if (++indexes[i] < counts[i])
+          break;
+        indexes[i] = 0;
+      }
+
+      if (i == opCount)
+        break;
+    }
+  }
+}
+
+Error X86DecoderBuilder::build() noexcept {
+  _error = kErrorOk;
+
+  for (uint32_t instId = 1; instId < _kX86InstIdCount; instId++) {
+    uint32_t encoding = X86Util::getInstInfo(instId).getExtendedInfo().getEncoding();
+
+    for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(x86ProbeRows); i++) {
+      if (x86ProbeRows[i].encoding == encoding)
+        probeRow(instId, x86ProbeRows[i]);
+    }
+  }
+
+  return _error;
+}
+
+// ============================================================================
+// [asmjit::X86Disassembler - Construction / Destruction]
+// ============================================================================
+
+static ASMJIT_INLINE bool X86Disassembler_isSameForm(const X86DecoderForm& a, const X86DecoderForm& b) noexcept {
+  // Forms of different instructions can have the same encoding (aliases), the
+  // first one always matches.
+  return ::memcmp(&a.key, &b.key, sizeof(X86DecoderForm) - sizeof(uint16_t)) == 0;
+}
+
+X86Disassembler::X86Disassembler(uint32_t arch) noexcept
+  : _arch(arch),
+    _formCount(0),
+    _forms(nullptr),
+    _index(nullptr) {
+
+  ASMJIT_ASSERT(arch == kArchX86 || arch == kArchX64);
+
+  X86DecoderBuilder builder(arch);
+  if (builder.build() != kErrorOk)
+    return;
+
+  const X86DecoderForm* src = builder._forms.getData();
+  uint32_t count = static_cast<uint32_t>(builder._forms.getLength());
+
+  X86DecoderForm* forms = static_cast<X86DecoderForm*>(ASMJIT_ALLOC(count * sizeof(X86DecoderForm)));
+  uint32_t* index = static_cast<uint32_t*>(ASMJIT_ALLOC((kX86DecoderKeyCount + 1) * sizeof(uint32_t)));
+
+  if (forms == nullptr || index == nullptr) {
+    ASMJIT_FREE(forms);
+    ASMJIT_FREE(index);
+    return;
+  }
+
+  // Stable counting sort by key - forms of the same key stay in the order of
+  // instruction ids.
+  uint32_t i;
+  ::memset(index, 0, (kX86DecoderKeyCount + 1) * sizeof(uint32_t));
+
+  for (i = 0; i < count; i++)
+    index[src[i].key + 1]++;
+
+  for (i = 0; i < kX86DecoderKeyCount; i++)
+    index[i + 1] += index[i];
+
+  for (i = 0; i < count; i++)
+    forms[index[src[i].key]++] = src[i];
+
+  for (i = kX86DecoderKeyCount; i > 0; i--)
+    index[i] = index[i - 1];
+  index[0] = 0;
+
+  // Remove duplicates, they would never match.
+  uint32_t n = 0;
+  for (i = 0; i < kX86DecoderKeyCount; i++) {
+    uint32_t start = index[i];
+    uint32_t end = index[i + 1];
+    uint32_t keyStart = n;
+
+    for (uint32_t j = start; j < end; j++) {
+      uint32_t k;
+      for (k = keyStart; k < n; k++)
+        if (X86Disassembler_isSameForm(forms[k], forms[j]))
+          break;
+
+      if (k == n)
+        forms[n++] = forms[j];
+    }
+
+    index[i] = keyStart;
+  }
+  index[kX86DecoderKeyCount] = n;
+
+  _formCount = n;
+  _forms = forms;
+  _index = index;
+}
+
+X86Disassembler::~X86Disassembler() noexcept {
+  ASMJIT_FREE(_forms);
+  ASMJIT_FREE(_index);
+}
+
+// ============================================================================
+// [asmjit::X86Disassembler - Decode]
+// ============================================================================
+
+static bool X86Disassembler_decodeWith(const X86Disassembler* self, X86DecodedInst& inst,
+  const uint8_t* p, size_t size, Ptr address, bool waitPrefix) noexcept {
+
+  uint32_t arch = self->_arch;
+  X86DecoderHeader h;
+
+  if (!X86Decoder_parseHeader(h, p, size, arch, waitPrefix))
+    return false;
+
+  // 3dNow opcode follows ModR/M, SIB, and displacement.
+  if (h.map == kX86DecoderMap3dNow) {
+    if (h.modRmPos >= size)
+      return false;
+
+    uint32_t modRmSize = (p[h.modRmPos] >> 6) == 3 ? 1 :
+      X86Decoder_parseMem(nullptr, p + h.modRmPos, size - h.modRmPos, arch, h, kX86MemVSibGpz, 0);
+
+    if (modRmSize == 0 || h.modRmPos + modRmSize >= size)
+      return false;
+    h.opCode = p[h.modRmPos + modRmSize];
+  }
+
+  uint32_t key = (h.map << 8) | h.opCode;
+  const X86DecoderForm* forms = self->_forms;
+
+  uint32_t start = self->_index[key];
+  uint32_t end = self->_index[key + 1];
+
+  if (h.map >= kX86DecoderMapEvex0F) {
+    for (uint32_t i = start; i < end; i++) {
+      const X86DecoderForm& form = forms[i];
+      if ((h.features & kX86DecoderFeaturePP) != form.features)
+        continue;
+
+      if (h.modRmPos >= size)
+        return false;
+
+      uint32_t modRmSize = (p[h.modRmPos] >> 6) == 3 ? 1 :
+        X86Decoder_parseMem(nullptr, p + h.modRmPos, size - h.modRmPos, arch, h, kX86MemVSibGpz, 0);
+      uint32_t instSize = h.modRmPos + modRmSize + form.immSize;
+
+      if (modRmSize == 0 || instSize > size || instSize > kX86DecoderMaxInstSize)
+        return false;
+
+      inst.size = instSize;
+      inst.flags = kX86DecodedFlagEvex;
+      return true;
+    }
+    return false;
+  }
+
+  for (uint32_t i = start; i < end; i++) {
+    if (X86Decoder_matchForm(forms[i], h, p, size, address, arch, inst))
+      return true;
+  }
+
+  // Multi-byte NOP used by code alignment (0F 1F /0).
+  if (h.map == kX86DecoderMap0F && h.opCode == 0x1F &&
+      (h.features & ~kX86DecoderFeature66) == 0 && h.ext == 0 &&
+      h.segment == kX86SegDefault && h.options == 0 && h.modRmPos < size &&
+      ((p[h.modRmPos] >> 3) & 0x07) == 0) {
+
+    uint32_t modRmSize = X86Decoder_parseMem(nullptr, p + h.modRmPos, size - h.modRmPos, arch, h, kX86MemVSibGpz, 0);
+    if (modRmSize != 0) {
+      inst.instId = kX86InstIdNop;
+      inst.size = h.modRmPos + modRmSize;
+      inst.flags = kX86DecodedFlagNop;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+Error X86Disassembler::decode(X86DecodedInst& inst, const void* data, size_t size, Ptr address) const noexcept {
+  inst.reset();
+
+  if (!isInitialized())
+    return kErrorNoHeapMemory;
+
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  if (size == 0)
+    return kErrorIllegalInst;
+
+  if (X86Disassembler_decodeWith(this, inst, p, size, address, true))
+    return kErrorOk;
+
+  // 9B followed by an FPU instruction that doesn't wait is `fwait`.
+  inst.reset();
+  if (p[0] == 0x9B && X86Disassembler_decodeWith(this, inst, p, size, address, false))
+    return kErrorOk;
+
+  inst.reset();
+  return kErrorIllegalInst;
+}
+
+// ============================================================================
+// [asmjit::X86Disassembler - Disassemble]
+// ============================================================================
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+static bool X86Disassembler_formatData(StringBuilder& sb, uint32_t arch, Ptr address,
+  const uint8_t* data, size_t size, const char* comment) noexcept {
+
+  StringBuilderTmp<256> line;
+
+  line.appendUInt(arch == kArchX86 ? (address & 0xFFFFFFFFU) : address, 16, arch == kArchX86 ? 8 : 16);
+  line.appendString(": .data ");
+  line.appendHex(data, size);
+
+  if (!LogUtil::formatLine(line, nullptr, kInvalidIndex, 0, 0, comment))
+    return false;
+
+  return sb.appendString(line.getData(), line.getLength());
+}
+
+Error X86Disassembler::disassemble(StringBuilder& sb, const void* data, size_t size,
+  Ptr baseAddress, uint32_t loggerOptions) const noexcept {
+
+  if (!isInitialized())
+    return kErrorNoHeapMemory;
+
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  size_t offset = 0;
+
+  X86DecodedInst inst;
+  StringBuilderTmp<256> line;
+
+  while (offset < size) {
+    Ptr address = baseAddress + offset;
+
+    if (decode(inst, p + offset, size - offset, address) != kErrorOk) {
+      // Group bytes that can't be decoded, up to 16 bytes per line.
+      size_t end = offset + 1;
+      while (end < size && end - offset < 16 &&
+             decode(inst, p + end, size - end, baseAddress + end) != kErrorOk)
+        end++;
+
+      if (!X86Disassembler_formatData(sb, _arch, address, p + offset, end - offset, nullptr))
+        return kErrorNoHeapMemory;
+
+      offset = end;
+      continue;
+    }
+
+    if (inst.hasFlag(kX86DecodedFlagEvex)) {
+      if (!X86Disassembler_formatData(sb, _arch, address, p + offset, inst.size, "evex"))
+        return kErrorNoHeapMemory;
+
+      offset += inst.size;
+      continue;
+    }
+
+    line.clear();
+    line.appendUInt(_arch == kArchX86 ? (address & 0xFFFFFFFFU) : address, 16, _arch == kArchX86 ? 8 : 16);
+    line.appendString(": ");
+
+    ASMJIT_PROPAGATE_ERROR(X86Util::formatInst(line, _arch,
+      inst.instId, inst.options, inst.opList, inst.opCount, loggerOptions));
+
+    bool ok;
+    if ((loggerOptions & Logger::kOptionBinaryForm) != 0)
+      ok = LogUtil::formatLine(line, p + offset, inst.size, 0, 0, nullptr);
+    else
+      ok = LogUtil::formatLine(line, nullptr, kInvalidIndex, 0, 0, nullptr);
+
+    if (!ok || !sb.appendString(line.getData(), line.getLength()))
+      return kErrorNoHeapMemory;
+
+    offset += inst.size;
+  }
+
+  return kErrorOk;
+}
+
+Error X86Disassembler::log(Logger* logger, const void* data, size_t size, Ptr baseAddress) const noexcept {
+  if (logger == nullptr)
+    return kErrorInvalidArgument;
+
+  StringBuilderTmp<1024> sb;
+  ASMJIT_PROPAGATE_ERROR(disassemble(sb, data, size, baseAddress, logger->getOptions()));
+
+  logger->logString(Logger::kStyleDefault, sb.getData(), sb.getLength());
+  return kErrorOk;
+}
+#endif // !ASMJIT_DISABLE_LOGGER
+
+// ============================================================================
+// [asmjit::X86Disassembler - Verify]
+// ============================================================================
+
+//! \internal
+//!
+//! Find the index of the instruction at `offset` in sorted `offsets`.
+static size_t X86Disassembler_findOffset(const uint32_t* offsets, size_t count, Ptr offset) noexcept {
+  size_t lo = 0;
+  size_t hi = count;
+
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (offsets[mid] < offset)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return (lo < count && offsets[lo] == offset) ? lo : kInvalidIndex;
+}
+
+Error X86Disassembler::verify(const void* data, size_t size, Ptr baseAddress, size_t* errorOffset) const noexcept {
+  if (!isInitialized())
+    return kErrorNoHeapMemory;
+
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  X86DecodedInst inst;
+
+  PodVector<uint32_t> offsets;
+  PodVector<uint32_t> labels;
+
+  size_t offset = 0;
+  size_t failOffset = 0;
+
+  // Decode all instructions first, branches can go forward.
+  while (offset < size) {
+    if (decode(inst, p + offset, size - offset, baseAddress + offset) != kErrorOk) {
+      if (errorOffset != nullptr)
+        *errorOffset = offset;
+      return kErrorIllegalInst;
+    }
+
+    if (offsets.append(static_cast<uint32_t>(offset)) != kErrorOk ||
+        labels.append(kInvalidValue) != kErrorOk)
+      return kErrorNoHeapMemory;
+
+    offset += inst.size;
+  }
+
+  StaticRuntime runtime(reinterpret_cast<void*>(static_cast<uintptr_t>(baseAddress)));
+  X86Assembler a(&runtime, _arch);
+  a.addAsmOptions(Assembler::kOptionPredictedJumps);
+
+  size_t count = offsets.getLength();
+  size_t i;
+
+  // Create labels of instructions targeted by branches.
+  for (i = 0; i < count; i++) {
+    offset = offsets[i];
+    decode(inst, p + offset, size - offset, baseAddress + offset);
+
+    if (inst.hasFlag(kX86DecodedFlagTarget) && inst.target - baseAddress < size) {
+      size_t target = X86Disassembler_findOffset(offsets.getData(), count, inst.target - baseAddress);
+      if (target != kInvalidIndex && labels[target] == kInvalidValue)
+        labels[target] = a.newLabel().getId();
+    }
+  }
+
+  // Assemble.
+  Error err = kErrorOk;
+  for (i = 0; i < count && err == kErrorOk; i++) {
+    offset = offsets[i];
+    decode(inst, p + offset, size - offset, baseAddress + offset);
+
+    if (labels[i] != kInvalidValue)
+      a.bind(Label(labels[i]));
+
+    size_t target = kInvalidIndex;
+    if (inst.hasFlag(kX86DecodedFlagTarget) && inst.target - baseAddress < size)
+      target = X86Disassembler_findOffset(offsets.getData(), count, inst.target - baseAddress);
+
+    // EVEX instructions, alignment NOPs, and branches that leave the range
+    // are copied as they are.
+    if (inst.hasFlag(kX86DecodedFlagEvex | kX86DecodedFlagNop) ||
+        (inst.hasFlag(kX86DecodedFlagTarget) && target == kInvalidIndex)) {
+      err = a.embed(p + offset, inst.size);
+      continue;
+    }
+
+    // Branches keep the form they were decoded from.
+    uint32_t options = inst.options;
+    if (target != kInvalidIndex) {
+      for (uint32_t j = 0; j < inst.opCount; j++) {
+        if (inst.opList[j].isImm())
+          inst.opList[j] = Label(labels[target]);
+      }
+
+      if ((options & kInstOptionShortForm) == 0)
+        options |= kInstOptionLongForm;
+    }
+
+    a.setInstOptions(options);
+    err = a.emit(inst.instId, inst.opList[0], inst.opList[1], inst.opList[2], inst.opList[3]);
+
+    if (err == kErrorOk && a.getOffset() != offset + inst.size)
+      err = kErrorCodeMismatch;
+  }
+
+  if (err == kErrorOk) {
+    size_t codeSize = a.getCodeSize();
+    uint8_t* code = static_cast<uint8_t*>(ASMJIT_ALLOC(codeSize + 1));
+
+    if (code == nullptr)
+      return kErrorNoHeapMemory;
+
+    codeSize = a.relocCode(code, baseAddress);
+
+    size_t n = Utils::iMin(codeSize, size);
+    failOffset = 0;
+    while (failOffset < n && code[failOffset] == p[failOffset])
+      failOffset++;
+
+    ASMJIT_FREE(code);
+
+    if (failOffset == size && codeSize == size)
+      return kErrorOk;
+  }
+  else {
+    failOffset = offsets[i - 1];
+  }
+
+  // Report the instruction that contains the first mismatch.
+  if (errorOffset != nullptr) {
+    size_t lo = 0;
+    for (i = 0; i < count && offsets[i] <= failOffset; i++)
+      lo = offsets[i];
+    *errorOffset = lo;
+  }
+
+  return kErrorCodeMismatch;
+}
+
+// ============================================================================
+// [asmjit::X86Disassembler - Test]
+// ============================================================================
+
+#if defined(ASMJIT_TEST)
+static void X86DisassemblerTest_generate(X86Assembler& a) noexcept {
+  using namespace x86;
+
+  Label loop = a.newLabel();
+  Label done = a.newLabel();
+
+  a.push(a.zbp);
+  a.mov(a.zbp, a.zsp);
+  a.xor_(eax, eax);
+  a.mov(ecx, 1000);
+
+  a.bind(loop);
+  a.add(eax, dword_ptr(a.zbx, a.zcx, 2, 16));
+  a.add(eax, 1);
+  a.sub(ecx, 0x12345);
+  a.lea(a.zdx, ptr(a.zax, a.zcx, 3, -8));
+  a.imul(eax, ecx, 10);
+  a.shl(edx, 3);
+  a.sar(edx, cl);
+  a.test(al, 1);
+  a.movzx(esi, byte_ptr(a.zsi));
+  a.xchg(ecx, edx);
+  a.cmp(eax, ecx);
+  a.jne(loop);
+  a.jz(done);
+
+  a.movaps(xmm1, xmm2);
+  a.addps(xmm1, ptr(a.zbx));
+  a.pshufd(xmm3, xmm4, 0x1B);
+  a.movd(xmm5, eax);
+  a.vaddps(ymm1, ymm2, ymm3);
+  a.vblendvps(xmm1, xmm2, xmm3, xmm4);
+  a.vpgatherdd(xmm0, ptr(a.zax, xmm1, 2), xmm2);
+  a.fld(dword_ptr(a.zsp));
+  a.fstp(qword_ptr(a.zsp, 8));
+  a.fstsw(ax);
+  a.call(done);
+
+  a.align(kAlignCode, 16);
+  a.bind(done);
+  a.pop(a.zbp);
+  a.ret();
+}
+
+UNIT(x86_disassembler) {
+  static const uint32_t archList[] = {
+#if defined(ASMJIT_BUILD_X86)
+    kArchX86,
+#endif // ASMJIT_BUILD_X86
+#if defined(ASMJIT_BUILD_X64)
+    kArchX64
+#endif // ASMJIT_BUILD_X64
+  };
+
+  for (uint32_t n = 0; n < ASMJIT_ARRAY_SIZE(archList); n++) {
+    uint32_t arch = archList[n];
+    Ptr baseAddress = static_cast<Ptr>(0x10000000);
+
+    StaticRuntime runtime(reinterpret_cast<void*>(static_cast<uintptr_t>(baseAddress)));
+    X86Assembler a(&runtime, arch);
+
+    X86DisassemblerTest_generate(a);
+    if (arch == kArchX64) {
+      a.mov(x86::r10, Imm(ASMJIT_INT64_C(0x1122334455667788)));
+      a.movsxd(x86::r11, x86::dword_ptr(x86::r12, x86::r13, 3, 0x100));
+      a.mov(x86::spl, x86::r8b);
+      a.vpaddd(x86::ymm12, x86::ymm13, x86::ymm14);
+    }
+    a.mov(x86::ah, x86::bl);
+
+    size_t size = a.getCodeSize();
+    uint8_t* code = static_cast<uint8_t*>(ASMJIT_ALLOC(size));
+    size = a.relocCode(code, baseAddress);
+
+    X86Disassembler disasm(arch);
+    INFO("Verifying %s code.", arch == kArchX86 ? "X86" : "X64");
+    EXPECT(disasm.isInitialized(),
+      "Disassembler should be initialized.");
+
+    size_t errorOffset = 0;
+    Error err = disasm.verify(code, size, baseAddress, &errorOffset);
+    EXPECT(err == kErrorOk,
+      "Verification failed with error %u at offset %u.", err, static_cast<unsigned int>(errorOffset));
+
+    X86DecodedInst inst;
+    EXPECT(disasm.decode(inst, code, size, baseAddress) == kErrorOk && inst.instId == kX86InstIdPush,
+      "The first instruction should be decoded as push.");
+
+    // `add eax, 1` with imm32 decodes, but the assembler emits the imm8 form.
+    static const uint8_t nonCanonical[] = { 0x81, 0xC0, 0x01, 0x00, 0x00, 0x00 };
+    EXPECT(disasm.decode(inst, nonCanonical, sizeof(nonCanonical)) == kErrorOk && inst.instId == kX86InstIdAdd,
+      "Non-canonical encoding should be decoded.");
+    EXPECT(disasm.verify(nonCanonical, sizeof(nonCanonical)) == kErrorCodeMismatch,
+      "Verification should fail if the assembler produces different bytes.");
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+    StringBuilder sb;
+    EXPECT(disasm.disassemble(sb, code, size, baseAddress) == kErrorOk,
+      "Disassembling should succeed.");
+    EXPECT(::strstr(sb.getData(), "10000000: push") != nullptr,
+      "Disassembly should start with push:\n%s", sb.getData());
+    EXPECT(::strstr(sb.getData(), "vblendvps xmm1, xmm2, xmm3, xmm4") != nullptr,
+      "Disassembly should contain vblendvps:\n%s", sb.getData());
+#endif // !ASMJIT_DISABLE_LOGGER
+
+    ASMJIT_FREE(code);
+  }
+}
+#endif // ASMJIT_TEST
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // ASMJIT_BUILD_X86 || ASMJIT_BUILD_X64
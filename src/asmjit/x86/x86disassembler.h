@@ -0,0 +1,226 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Guard]
+#ifndef _ASMJIT_X86_X86DISASSEMBLER_H
+#define _ASMJIT_X86_X86DISASSEMBLER_H
+
+// [Dependencies]
+#include "../base/containers.h"
+#include "../base/logger.h"
+#include "../x86/x86inst.h"
+#include "../x86/x86operand.h"
+
+// [Api-Begin]
+#include "../apibegin.h"
+
+namespace asmjit {
+
+//! \addtogroup asmjit_x86
+//! \{
+
+// ============================================================================
+// [asmjit::X86DecodedFlags]
+// ============================================================================
+
+//! X86 decoded instruction flags.
+ASMJIT_ENUM(X86DecodedFlags) {
+  //! The instruction has a relative target (jmp, jcc, call, jecxz), which was
+  //! converted to an absolute address, see \ref X86DecodedInst::target.
+  kX86DecodedFlagTarget = 0x00000001,
+  //! The instruction is EVEX encoded. Only its length is decoded, `instId` is
+  //! `kInstIdNone` and there are no operands.
+  kX86DecodedFlagEvex = 0x00000002,
+  //! The instruction is a multi-byte NOP used by code alignment. It's decoded
+  //! as `nop` without operands, which doesn't describe its length.
+  kX86DecodedFlagNop = 0x00000004
+};
+
+// ============================================================================
+// [asmjit::X86DecodedInst]
+// ============================================================================
+
+//! X86 instruction decoded by \ref X86Disassembler.
+//!
+//! Operands use the same representation as operands passed to `X86Assembler`,
+//! so a decoded instruction can be emitted again by `X86Assembler::emit()`.
+//! Relative targets are stored as immediate operands holding an absolute
+//! address.
+struct X86DecodedInst {
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  //! Reset the decoded instruction.
+  ASMJIT_INLINE void reset() noexcept {
+    instId = kInstIdNone;
+    options = 0;
+    size = 0;
+    opCount = 0;
+    flags = 0;
+    target = 0;
+
+    for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(opList); i++)
+      opList[i] = noOperand;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get whether the instruction has a flag `flag`.
+  ASMJIT_INLINE bool hasFlag(uint32_t flag) const noexcept { return (flags & flag) != 0; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Instruction id, see \ref X86InstId.
+  uint32_t instId;
+  //! Instruction options, see \ref InstOptions and \ref X86InstOptions.
+  uint32_t options;
+  //! Instruction size in bytes, including all prefixes.
+  uint32_t size;
+  //! Count of operands in `opList`.
+  uint32_t opCount;
+  //! Flags, see \ref X86DecodedFlags.
+  uint32_t flags;
+
+  //! Absolute target address if `kX86DecodedFlagTarget` is set.
+  Ptr target;
+
+  //! Operands.
+  Operand opList[4];
+};
+
+// ============================================================================
+// [asmjit::X86Disassembler]
+// ============================================================================
+
+//! \internal
+struct X86DecoderForm;
+
+//! X86/X64 disassembler.
+//!
+//! Decodes machine code produced by `X86Assembler` back to instructions. The
+//! decoder is generated from the same instruction table the assembler uses,
+//! so it understands all legacy, FPU, MMX/SSE, 3dNow, VEX and XOP encodings
+//! the assembler can emit. EVEX encoded instructions are only measured.
+//!
+//! The disassembler can be used to inspect the final code after relocation
+//! (relaxed jumps, trampolines, resolved labels), which is something the
+//! `Logger` attached to `X86Assembler` can't do:
+//!
+//! ~~~
+//! using namespace asmjit;
+//!
+//! X86Disassembler disasm(kArchX64);
+//! StringBuilder sb;
+//!
+//! disasm.disassemble(sb, code, codeSize, (Ptr)code);
+//! printf("%s", sb.getData());
+//! ~~~
+//!
+//! `verify()` decodes the code and assembles it again, which validates both
+//! the decoder and the assembler without depending on an external tool.
+class ASMJIT_VIRTAPI X86Disassembler {
+ public:
+  ASMJIT_NO_COPY(X86Disassembler)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! Create a `X86Disassembler` instance for `arch`.
+  ASMJIT_API X86Disassembler(uint32_t arch = kArchHost) noexcept;
+  //! Destroy the `X86Disassembler` instance.
+  ASMJIT_API ~X86Disassembler() noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! Get the target architecture.
+  ASMJIT_INLINE uint32_t getArch() const noexcept { return _arch; }
+
+  //! Get whether the disassembler was initialized successfully.
+  //!
+  //! It fails only if the decoder tables couldn't be allocated.
+  ASMJIT_INLINE bool isInitialized() const noexcept { return _formCount != 0; }
+
+  // --------------------------------------------------------------------------
+  // [Decode]
+  // --------------------------------------------------------------------------
+
+  //! Decode a single instruction from `data` of `size` bytes into `inst`.
+  //!
+  //! The `address` is the address of `data` at runtime, it's used to compute
+  //! targets of relative jumps and calls. Returns `kErrorOk` on success,
+  //! `kErrorIllegalInst` if the bytes don't form an instruction known to the
+  //! instruction table, or `kErrorNoHeapMemory` if not initialized.
+  ASMJIT_API Error decode(X86DecodedInst& inst, const void* data, size_t size, Ptr address = 0) const noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Disassemble]
+  // --------------------------------------------------------------------------
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  //! Disassemble `size` bytes of `data` into `sb`, one instruction per line.
+  //!
+  //! Each line starts with the address of the instruction, which is computed
+  //! from `baseAddress`, the instruction uses the same syntax as `Logger`.
+  //! `loggerOptions` is a combination of \ref Logger::Options. Bytes that
+  //! can't be decoded are printed as `.data`.
+  ASMJIT_API Error disassemble(StringBuilder& sb, const void* data, size_t size,
+    Ptr baseAddress = 0, uint32_t loggerOptions = 0) const noexcept;
+
+  //! Disassemble `size` bytes of `data` and send the output to `logger`.
+  ASMJIT_API Error log(Logger* logger, const void* data, size_t size,
+    Ptr baseAddress = 0) const noexcept;
+#endif // !ASMJIT_DISABLE_LOGGER
+
+  // --------------------------------------------------------------------------
+  // [Verify]
+  // --------------------------------------------------------------------------
+
+  //! Verify `size` bytes of `data` by decoding and assembling them again.
+  //!
+  //! The decoded instructions are emitted by `X86Assembler` to `baseAddress`
+  //! (relative targets inside the range are converted to labels) and the
+  //! relocated result is compared with `data`. EVEX instructions, alignment
+  //! NOPs, and branches that leave the range are copied as they are. The range
+  //! must contain only code, trampolines and data sections can't be verified.
+  //!
+  //! Returns `kErrorOk` if both match, `kErrorIllegalInst` if some bytes can't
+  //! be decoded, or `kErrorCodeMismatch` if the assembler produced different
+  //! bytes. In case of failure the offset of the instruction that failed is
+  //! stored to `errorOffset` (if not null).
+  ASMJIT_API Error verify(const void* data, size_t size, Ptr baseAddress = 0,
+    size_t* errorOffset = nullptr) const noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! Target architecture.
+  uint32_t _arch;
+  //! Count of decoder forms.
+  uint32_t _formCount;
+  //! Decoder forms sorted by opcode.
+  X86DecoderForm* _forms;
+  //! Index of the first form of each opcode, see \ref X86DecoderForm.
+  uint32_t* _index;
+};
+
+//! \}
+
+} // asmjit namespace
+
+// [Api-End]
+#include "../apiend.h"
+
+// [Guard]
+#endif // _ASMJIT_X86_X86DISASSEMBLER_H
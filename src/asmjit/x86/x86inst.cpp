@@ -12,7 +12,9 @@
 #if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
 
 // [Dependencies]
+#include "../base/cpuinfo.h"
 #include "../x86/x86inst.h"
+#include "../x86/x86operand.h"
 
 // [Api-Begin]
 #include "../apibegin.h"
@@ -88,10 +90,19 @@ enum X86InstOpInternal {
 //! X86/X64 Instruction AVX-512 flags (combined).
 ASMJIT_ENUM(X86InstFlagsInternal) {
   // FPU.
-  kX86InstFlagMem2_4           = kX86InstFlagMem2        | kX86InstFlagMem4,
-  kX86InstFlagMem2_4_8         = kX86InstFlagMem2_4      | kX86InstFlagMem8,
-  kX86InstFlagMem4_8           = kX86InstFlagMem4        | kX86InstFlagMem8,
-  kX86InstFlagMem4_8_10        = kX86InstFlagMem4_8      | kX86InstFlagMem10
+  kX86InstFlagMem2_4              = kX86InstFlagMem2            | kX86InstFlagMem4,
+  kX86InstFlagMem2_4_8            = kX86InstFlagMem2_4          | kX86InstFlagMem8,
+  kX86InstFlagMem4_8              = kX86InstFlagMem4            | kX86InstFlagMem8,
+  kX86InstFlagMem4_8_10           = kX86InstFlagMem4_8          | kX86InstFlagMem10,
+
+  // AVX-512.
+  kX86InstFlagAvx512F_VL          = kX86InstFlagAvx512F         | kX86InstFlagAvx512VL,
+  kX86InstFlagAvx512F_VL_K        = kX86InstFlagAvx512F_VL      | kX86InstFlagAvx512KMask,
+  kX86InstFlagAvx512F_VL_K_B      = kX86InstFlagAvx512F_VL_K    | kX86InstFlagAvx512BCast,
+  kX86InstFlagAvx512F_VL_KZ       = kX86InstFlagAvx512F_VL_K    | kX86InstFlagAvx512KZero,
+  kX86InstFlagAvx512F_VL_KZ_B     = kX86InstFlagAvx512F_VL_KZ   | kX86InstFlagAvx512BCast,
+  kX86InstFlagAvx512F_VL_KZ_B_Sae = kX86InstFlagAvx512F_VL_KZ_B | kX86InstFlagAvx512Sae,
+  kX86InstFlagAvx512F_VL_KZ_B_Rnd = kX86InstFlagAvx512F_VL_KZ_B | kX86InstFlagAvx512Rnd
 };
 
 // ============================================================================
@@ -174,106 +185,113 @@ static const char _x86InstNameData[] =
   "ja\0" "jae\0" "jb\0" "jbe\0" "jc\0" "je\0" "jecxz\0" "jg\0" "jge\0" "jl\0"
   "jle\0" "jmp\0" "jna\0" "jnae\0" "jnb\0" "jnbe\0" "jnc\0" "jne\0" "jng\0"
   "jnge\0" "jnl\0" "jnle\0" "jno\0" "jnp\0" "jns\0" "jnz\0" "jo\0" "jp\0"
-  "jpe\0" "jpo\0" "js\0" "jz\0" "lahf\0" "lea\0" "leave\0" "lfence\0" "lzcnt\0"
-  "mfence\0" "monitor\0" "mov_ptr\0" "movdq2q\0" "movnti\0" "movntq\0"
-  "movntsd\0" "movntss\0" "movq2dq\0" "movsx\0" "movsxd\0" "movzx\0" "mulx\0"
-  "mwait\0" "neg\0" "not\0" "pause\0" "pavgusb\0" "pdep\0" "pext\0" "pf2id\0"
-  "pf2iw\0" "pfacc\0" "pfadd\0" "pfcmpeq\0" "pfcmpge\0" "pfcmpgt\0" "pfmax\0"
-  "pfmin\0" "pfmul\0" "pfnacc\0" "pfpnacc\0" "pfrcp\0" "pfrcpit1\0"
-  "pfrcpit2\0" "pfrsqit1\0" "pfrsqrt\0" "pfsub\0" "pfsubr\0" "pi2fd\0"
-  "pi2fw\0" "pmulhrw\0" "pop\0" "popa\0" "popcnt\0" "popf\0" "prefetch\0"
-  "prefetch3dnow\0" "prefetchw\0" "prefetchwt1\0" "pshufw\0" "pswapd\0"
-  "push\0" "pusha\0" "pushf\0" "rcl\0" "rcr\0" "rdfsbase\0" "rdgsbase\0"
-  "rdrand\0" "rdseed\0" "rdtsc\0" "rdtscp\0" "rep lods_b\0" "rep lods_d\0"
-  "rep lods_q\0" "rep lods_w\0" "rep movs_b\0" "rep movs_d\0" "rep movs_q\0"
-  "rep movs_w\0" "rep stos_b\0" "rep stos_d\0" "rep stos_q\0" "rep stos_w\0"
-  "repe cmps_b\0" "repe cmps_d\0" "repe cmps_q\0" "repe cmps_w\0"
-  "repe scas_b\0" "repe scas_d\0" "repe scas_q\0" "repe scas_w\0"
-  "repne cmps_b\0" "repne cmps_d\0" "repne cmps_q\0" "repne cmps_w\0"
-  "repne scas_b\0" "repne scas_d\0" "repne scas_q\0" "repne scas_w\0" "ret\0"
-  "rol\0" "ror\0" "rorx\0" "sahf\0" "sal\0" "sar\0" "sarx\0" "sbb\0" "seta\0"
-  "setae\0" "setb\0" "setbe\0" "setc\0" "sete\0" "setg\0" "setge\0" "setl\0"
-  "setle\0" "setna\0" "setnae\0" "setnb\0" "setnbe\0" "setnc\0" "setne\0"
-  "setng\0" "setnge\0" "setnl\0" "setnle\0" "setno\0" "setnp\0" "setns\0"
-  "setnz\0" "seto\0" "setp\0" "setpe\0" "setpo\0" "sets\0" "setz\0" "sfence\0"
-  "sha1msg1\0" "sha1msg2\0" "sha1nexte\0" "sha1rnds4\0" "sha256msg1\0"
-  "sha256msg2\0" "sha256rnds2\0" "shl\0" "shlx\0" "shr\0" "shrd\0" "shrx\0"
-  "stc\0" "t1mskc\0" "tzcnt\0" "tzmsk\0" "ud2\0" "vaddpd\0" "vaddps\0"
-  "vaddsd\0" "vaddss\0" "vaddsubpd\0" "vaddsubps\0" "vaesdec\0" "vaesdeclast\0"
-  "vaesenc\0" "vaesenclast\0" "vaesimc\0" "vaeskeygenassist\0" "vandnpd\0"
-  "vandnps\0" "vandpd\0" "vandps\0" "vblendpd\0" "vblendps\0" "vblendvpd\0"
-  "vblendvps\0" "vbroadcastf128\0" "vbroadcasti128\0" "vbroadcastsd\0"
-  "vbroadcastss\0" "vcmppd\0" "vcmpps\0" "vcmpsd\0" "vcmpss\0" "vcomisd\0"
-  "vcomiss\0" "vcvtdq2pd\0" "vcvtdq2ps\0" "vcvtpd2dq\0" "vcvtpd2ps\0"
-  "vcvtph2ps\0" "vcvtps2dq\0" "vcvtps2pd\0" "vcvtps2ph\0" "vcvtsd2si\0"
-  "vcvtsd2ss\0" "vcvtsi2sd\0" "vcvtsi2ss\0" "vcvtss2sd\0" "vcvtss2si\0"
-  "vcvttpd2dq\0" "vcvttps2dq\0" "vcvttsd2si\0" "vcvttss2si\0" "vdivpd\0"
-  "vdivps\0" "vdivsd\0" "vdivss\0" "vdppd\0" "vdpps\0" "vextractf128\0"
-  "vextracti128\0" "vextractps\0" "vfmadd132pd\0" "vfmadd132ps\0"
-  "vfmadd132sd\0" "vfmadd132ss\0" "vfmadd213pd\0" "vfmadd213ps\0"
-  "vfmadd213sd\0" "vfmadd213ss\0" "vfmadd231pd\0" "vfmadd231ps\0"
-  "vfmadd231sd\0" "vfmadd231ss\0" "vfmaddpd\0" "vfmaddps\0" "vfmaddsd\0"
-  "vfmaddss\0" "vfmaddsub132pd\0" "vfmaddsub132ps\0" "vfmaddsub213pd\0"
-  "vfmaddsub213ps\0" "vfmaddsub231pd\0" "vfmaddsub231ps\0" "vfmaddsubpd\0"
-  "vfmaddsubps\0" "vfmsub132pd\0" "vfmsub132ps\0" "vfmsub132sd\0"
-  "vfmsub132ss\0" "vfmsub213pd\0" "vfmsub213ps\0" "vfmsub213sd\0"
-  "vfmsub213ss\0" "vfmsub231pd\0" "vfmsub231ps\0" "vfmsub231sd\0"
-  "vfmsub231ss\0" "vfmsubadd132pd\0" "vfmsubadd132ps\0" "vfmsubadd213pd\0"
-  "vfmsubadd213ps\0" "vfmsubadd231pd\0" "vfmsubadd231ps\0" "vfmsubaddpd\0"
-  "vfmsubaddps\0" "vfmsubpd\0" "vfmsubps\0" "vfmsubsd\0" "vfmsubss\0"
-  "vfnmadd132pd\0" "vfnmadd132ps\0" "vfnmadd132sd\0" "vfnmadd132ss\0"
-  "vfnmadd213pd\0" "vfnmadd213ps\0" "vfnmadd213sd\0" "vfnmadd213ss\0"
-  "vfnmadd231pd\0" "vfnmadd231ps\0" "vfnmadd231sd\0" "vfnmadd231ss\0"
-  "vfnmaddpd\0" "vfnmaddps\0" "vfnmaddsd\0" "vfnmaddss\0" "vfnmsub132pd\0"
-  "vfnmsub132ps\0" "vfnmsub132sd\0" "vfnmsub132ss\0" "vfnmsub213pd\0"
-  "vfnmsub213ps\0" "vfnmsub213sd\0" "vfnmsub213ss\0" "vfnmsub231pd\0"
-  "vfnmsub231ps\0" "vfnmsub231sd\0" "vfnmsub231ss\0" "vfnmsubpd\0"
-  "vfnmsubps\0" "vfnmsubsd\0" "vfnmsubss\0" "vfrczpd\0" "vfrczps\0" "vfrczsd\0"
-  "vfrczss\0" "vgatherdpd\0" "vgatherdps\0" "vgatherqpd\0" "vgatherqps\0"
-  "vhaddpd\0" "vhaddps\0" "vhsubpd\0" "vhsubps\0" "vinsertf128\0"
-  "vinserti128\0" "vinsertps\0" "vlddqu\0" "vldmxcsr\0" "vmaskmovdqu\0"
-  "vmaskmovpd\0" "vmaskmovps\0" "vmaxpd\0" "vmaxps\0" "vmaxsd\0" "vmaxss\0"
-  "vminpd\0" "vminps\0" "vminsd\0" "vminss\0" "vmovapd\0" "vmovaps\0" "vmovd\0"
-  "vmovddup\0" "vmovdqa\0" "vmovdqu\0" "vmovhlps\0" "vmovhpd\0" "vmovhps\0"
+  "jpe\0" "jpo\0" "js\0" "jz\0" "kandnw\0" "kandw\0" "kmovw\0" "knotw\0"
+  "kortestw\0" "korw\0" "kxnorw\0" "kxorw\0" "lahf\0" "lea\0" "leave\0"
+  "lfence\0" "lzcnt\0" "mfence\0" "monitor\0" "mov_ptr\0" "movdq2q\0"
+  "movnti\0" "movntq\0" "movntsd\0" "movntss\0" "movq2dq\0" "movsx\0"
+  "movsxd\0" "movzx\0" "mulx\0" "mwait\0" "neg\0" "not\0" "pause\0" "pavgusb\0"
+  "pdep\0" "pext\0" "pf2id\0" "pf2iw\0" "pfacc\0" "pfadd\0" "pfcmpeq\0"
+  "pfcmpge\0" "pfcmpgt\0" "pfmax\0" "pfmin\0" "pfmul\0" "pfnacc\0" "pfpnacc\0"
+  "pfrcp\0" "pfrcpit1\0" "pfrcpit2\0" "pfrsqit1\0" "pfrsqrt\0" "pfsub\0"
+  "pfsubr\0" "pi2fd\0" "pi2fw\0" "pmulhrw\0" "pop\0" "popa\0" "popcnt\0"
+  "popf\0" "prefetch\0" "prefetch3dnow\0" "prefetchw\0" "prefetchwt1\0"
+  "pshufw\0" "pswapd\0" "push\0" "pusha\0" "pushf\0" "rcl\0" "rcr\0"
+  "rdfsbase\0" "rdgsbase\0" "rdrand\0" "rdseed\0" "rdtsc\0" "rdtscp\0"
+  "rep lods_b\0" "rep lods_d\0" "rep lods_q\0" "rep lods_w\0" "rep movs_b\0"
+  "rep movs_d\0" "rep movs_q\0" "rep movs_w\0" "rep stos_b\0" "rep stos_d\0"
+  "rep stos_q\0" "rep stos_w\0" "repe cmps_b\0" "repe cmps_d\0" "repe cmps_q\0"
+  "repe cmps_w\0" "repe scas_b\0" "repe scas_d\0" "repe scas_q\0"
+  "repe scas_w\0" "repne cmps_b\0" "repne cmps_d\0" "repne cmps_q\0"
+  "repne cmps_w\0" "repne scas_b\0" "repne scas_d\0" "repne scas_q\0"
+  "repne scas_w\0" "ret\0" "rol\0" "ror\0" "rorx\0" "sahf\0" "sal\0" "sar\0"
+  "sarx\0" "sbb\0" "seta\0" "setae\0" "setb\0" "setbe\0" "setc\0" "sete\0"
+  "setg\0" "setge\0" "setl\0" "setle\0" "setna\0" "setnae\0" "setnb\0"
+  "setnbe\0" "setnc\0" "setne\0" "setng\0" "setnge\0" "setnl\0" "setnle\0"
+  "setno\0" "setnp\0" "setns\0" "setnz\0" "seto\0" "setp\0" "setpe\0" "setpo\0"
+  "sets\0" "setz\0" "sfence\0" "sha1msg1\0" "sha1msg2\0" "sha1nexte\0"
+  "sha1rnds4\0" "sha256msg1\0" "sha256msg2\0" "sha256rnds2\0" "shl\0" "shlx\0"
+  "shr\0" "shrd\0" "shrx\0" "stc\0" "t1mskc\0" "tzcnt\0" "tzmsk\0" "ud2\0"
+  "vaddpd\0" "vaddps\0" "vaddsd\0" "vaddss\0" "vaddsubpd\0" "vaddsubps\0"
+  "vaesdec\0" "vaesdeclast\0" "vaesenc\0" "vaesenclast\0" "vaesimc\0"
+  "vaeskeygenassist\0" "vandnpd\0" "vandnps\0" "vandpd\0" "vandps\0"
+  "vblendpd\0" "vblendps\0" "vblendvpd\0" "vblendvps\0" "vbroadcastf128\0"
+  "vbroadcasti128\0" "vbroadcastsd\0" "vbroadcastss\0" "vcmppd\0" "vcmpps\0"
+  "vcmpsd\0" "vcmpss\0" "vcomisd\0" "vcomiss\0" "vcvtdq2pd\0" "vcvtdq2ps\0"
+  "vcvtpd2dq\0" "vcvtpd2ps\0" "vcvtph2ps\0" "vcvtps2dq\0" "vcvtps2pd\0"
+  "vcvtps2ph\0" "vcvtsd2si\0" "vcvtsd2ss\0" "vcvtsi2sd\0" "vcvtsi2ss\0"
+  "vcvtss2sd\0" "vcvtss2si\0" "vcvttpd2dq\0" "vcvttps2dq\0" "vcvttsd2si\0"
+  "vcvttss2si\0" "vdivpd\0" "vdivps\0" "vdivsd\0" "vdivss\0" "vdppd\0"
+  "vdpps\0" "vextractf128\0" "vextracti128\0" "vextractps\0" "vfmadd132pd\0"
+  "vfmadd132ps\0" "vfmadd132sd\0" "vfmadd132ss\0" "vfmadd213pd\0"
+  "vfmadd213ps\0" "vfmadd213sd\0" "vfmadd213ss\0" "vfmadd231pd\0"
+  "vfmadd231ps\0" "vfmadd231sd\0" "vfmadd231ss\0" "vfmaddpd\0" "vfmaddps\0"
+  "vfmaddsd\0" "vfmaddss\0" "vfmaddsub132pd\0" "vfmaddsub132ps\0"
+  "vfmaddsub213pd\0" "vfmaddsub213ps\0" "vfmaddsub231pd\0" "vfmaddsub231ps\0"
+  "vfmaddsubpd\0" "vfmaddsubps\0" "vfmsub132pd\0" "vfmsub132ps\0"
+  "vfmsub132sd\0" "vfmsub132ss\0" "vfmsub213pd\0" "vfmsub213ps\0"
+  "vfmsub213sd\0" "vfmsub213ss\0" "vfmsub231pd\0" "vfmsub231ps\0"
+  "vfmsub231sd\0" "vfmsub231ss\0" "vfmsubadd132pd\0" "vfmsubadd132ps\0"
+  "vfmsubadd213pd\0" "vfmsubadd213ps\0" "vfmsubadd231pd\0" "vfmsubadd231ps\0"
+  "vfmsubaddpd\0" "vfmsubaddps\0" "vfmsubpd\0" "vfmsubps\0" "vfmsubsd\0"
+  "vfmsubss\0" "vfnmadd132pd\0" "vfnmadd132ps\0" "vfnmadd132sd\0"
+  "vfnmadd132ss\0" "vfnmadd213pd\0" "vfnmadd213ps\0" "vfnmadd213sd\0"
+  "vfnmadd213ss\0" "vfnmadd231pd\0" "vfnmadd231ps\0" "vfnmadd231sd\0"
+  "vfnmadd231ss\0" "vfnmaddpd\0" "vfnmaddps\0" "vfnmaddsd\0" "vfnmaddss\0"
+  "vfnmsub132pd\0" "vfnmsub132ps\0" "vfnmsub132sd\0" "vfnmsub132ss\0"
+  "vfnmsub213pd\0" "vfnmsub213ps\0" "vfnmsub213sd\0" "vfnmsub213ss\0"
+  "vfnmsub231pd\0" "vfnmsub231ps\0" "vfnmsub231sd\0" "vfnmsub231ss\0"
+  "vfnmsubpd\0" "vfnmsubps\0" "vfnmsubsd\0" "vfnmsubss\0" "vfrczpd\0"
+  "vfrczps\0" "vfrczsd\0" "vfrczss\0" "vgatherdpd\0" "vgatherdps\0"
+  "vgatherqpd\0" "vgatherqps\0" "vhaddpd\0" "vhaddps\0" "vhsubpd\0" "vhsubps\0"
+  "vinsertf128\0" "vinserti128\0" "vinsertps\0" "vlddqu\0" "vldmxcsr\0"
+  "vmaskmovdqu\0" "vmaskmovpd\0" "vmaskmovps\0" "vmaxpd\0" "vmaxps\0"
+  "vmaxsd\0" "vmaxss\0" "vminpd\0" "vminps\0" "vminsd\0" "vminss\0" "vmovapd\0"
+  "vmovaps\0" "vmovd\0" "vmovddup\0" "vmovdqa\0" "vmovdqa32\0" "vmovdqa64\0"
+  "vmovdqu\0" "vmovdqu32\0" "vmovdqu64\0" "vmovhlps\0" "vmovhpd\0" "vmovhps\0"
   "vmovlhps\0" "vmovlpd\0" "vmovlps\0" "vmovmskpd\0" "vmovmskps\0" "vmovntdq\0"
   "vmovntdqa\0" "vmovntpd\0" "vmovntps\0" "vmovq\0" "vmovsd\0" "vmovshdup\0"
   "vmovsldup\0" "vmovss\0" "vmovupd\0" "vmovups\0" "vmpsadbw\0" "vmulpd\0"
   "vmulps\0" "vmulsd\0" "vmulss\0" "vorpd\0" "vorps\0" "vpabsb\0" "vpabsd\0"
   "vpabsw\0" "vpackssdw\0" "vpacksswb\0" "vpackusdw\0" "vpackuswb\0" "vpaddb\0"
   "vpaddd\0" "vpaddq\0" "vpaddsb\0" "vpaddsw\0" "vpaddusb\0" "vpaddusw\0"
-  "vpaddw\0" "vpalignr\0" "vpand\0" "vpandn\0" "vpavgb\0" "vpavgw\0"
-  "vpblendd\0" "vpblendvb\0" "vpblendw\0" "vpbroadcastb\0" "vpbroadcastd\0"
-  "vpbroadcastq\0" "vpbroadcastw\0" "vpclmulqdq\0" "vpcmov\0" "vpcmpeqb\0"
+  "vpaddw\0" "vpalignr\0" "vpand\0" "vpandd\0" "vpandn\0" "vpandnd\0"
+  "vpandnq\0" "vpandq\0" "vpavgb\0" "vpavgw\0" "vpblendd\0" "vpblendvb\0"
+  "vpblendw\0" "vpbroadcastb\0" "vpbroadcastd\0" "vpbroadcastq\0"
+  "vpbroadcastw\0" "vpclmulqdq\0" "vpcmov\0" "vpcmpd\0" "vpcmpeqb\0"
   "vpcmpeqd\0" "vpcmpeqq\0" "vpcmpeqw\0" "vpcmpestri\0" "vpcmpestrm\0"
   "vpcmpgtb\0" "vpcmpgtd\0" "vpcmpgtq\0" "vpcmpgtw\0" "vpcmpistri\0"
-  "vpcmpistrm\0" "vpcomb\0" "vpcomd\0" "vpcomq\0" "vpcomub\0" "vpcomud\0"
+  "vpcmpistrm\0" "vpcmpq\0" "vpcmpud\0" "vpcmpuq\0" "vpcomb\0" "vpcomd\0"
+  "vpcompressd\0" "vpcompressq\0" "vpcomq\0" "vpcomub\0" "vpcomud\0"
   "vpcomuq\0" "vpcomuw\0" "vpcomw\0" "vperm2f128\0" "vperm2i128\0" "vpermd\0"
   "vpermil2pd\0" "vpermil2ps\0" "vpermilpd\0" "vpermilps\0" "vpermpd\0"
-  "vpermps\0" "vpermq\0" "vpextrb\0" "vpextrd\0" "vpextrq\0" "vpextrw\0"
-  "vpgatherdd\0" "vpgatherdq\0" "vpgatherqd\0" "vpgatherqq\0" "vphaddbd\0"
-  "vphaddbq\0" "vphaddbw\0" "vphaddd\0" "vphadddq\0" "vphaddsw\0" "vphaddubd\0"
-  "vphaddubq\0" "vphaddubw\0" "vphaddudq\0" "vphadduwd\0" "vphadduwq\0"
-  "vphaddw\0" "vphaddwd\0" "vphaddwq\0" "vphminposuw\0" "vphsubbw\0"
-  "vphsubd\0" "vphsubdq\0" "vphsubsw\0" "vphsubw\0" "vphsubwd\0" "vpinsrb\0"
-  "vpinsrd\0" "vpinsrq\0" "vpinsrw\0" "vpmacsdd\0" "vpmacsdqh\0" "vpmacsdql\0"
-  "vpmacssdd\0" "vpmacssdqh\0" "vpmacssdql\0" "vpmacsswd\0" "vpmacssww\0"
-  "vpmacswd\0" "vpmacsww\0" "vpmadcsswd\0" "vpmadcswd\0" "vpmaddubsw\0"
-  "vpmaddwd\0" "vpmaskmovd\0" "vpmaskmovq\0" "vpmaxsb\0" "vpmaxsd\0"
-  "vpmaxsw\0" "vpmaxub\0" "vpmaxud\0" "vpmaxuw\0" "vpminsb\0" "vpminsd\0"
-  "vpminsw\0" "vpminub\0" "vpminud\0" "vpminuw\0" "vpmovmskb\0" "vpmovsxbd\0"
-  "vpmovsxbq\0" "vpmovsxbw\0" "vpmovsxdq\0" "vpmovsxwd\0" "vpmovsxwq\0"
-  "vpmovzxbd\0" "vpmovzxbq\0" "vpmovzxbw\0" "vpmovzxdq\0" "vpmovzxwd\0"
-  "vpmovzxwq\0" "vpmuldq\0" "vpmulhrsw\0" "vpmulhuw\0" "vpmulhw\0" "vpmulld\0"
-  "vpmullw\0" "vpmuludq\0" "vpor\0" "vpperm\0" "vprotb\0" "vprotd\0" "vprotq\0"
-  "vprotw\0" "vpsadbw\0" "vpshab\0" "vpshad\0" "vpshaq\0" "vpshaw\0" "vpshlb\0"
-  "vpshld\0" "vpshlq\0" "vpshlw\0" "vpshufb\0" "vpshufd\0" "vpshufhw\0"
-  "vpshuflw\0" "vpsignb\0" "vpsignd\0" "vpsignw\0" "vpslld\0" "vpslldq\0"
-  "vpsllq\0" "vpsllvd\0" "vpsllvq\0" "vpsllw\0" "vpsrad\0" "vpsravd\0"
-  "vpsraw\0" "vpsrld\0" "vpsrldq\0" "vpsrlq\0" "vpsrlvd\0" "vpsrlvq\0"
-  "vpsrlw\0" "vpsubb\0" "vpsubd\0" "vpsubq\0" "vpsubsb\0" "vpsubsw\0"
-  "vpsubusb\0" "vpsubusw\0" "vpsubw\0" "vptest\0" "vpunpckhbw\0" "vpunpckhdq\0"
-  "vpunpckhqdq\0" "vpunpckhwd\0" "vpunpcklbw\0" "vpunpckldq\0" "vpunpcklqdq\0"
-  "vpunpcklwd\0" "vpxor\0" "vrcpps\0" "vrcpss\0" "vroundpd\0" "vroundps\0"
+  "vpermps\0" "vpermq\0" "vpexpandd\0" "vpexpandq\0" "vpextrb\0" "vpextrd\0"
+  "vpextrq\0" "vpextrw\0" "vpgatherdd\0" "vpgatherdq\0" "vpgatherqd\0"
+  "vpgatherqq\0" "vphaddbd\0" "vphaddbq\0" "vphaddbw\0" "vphaddd\0"
+  "vphadddq\0" "vphaddsw\0" "vphaddubd\0" "vphaddubq\0" "vphaddubw\0"
+  "vphaddudq\0" "vphadduwd\0" "vphadduwq\0" "vphaddw\0" "vphaddwd\0"
+  "vphaddwq\0" "vphminposuw\0" "vphsubbw\0" "vphsubd\0" "vphsubdq\0"
+  "vphsubsw\0" "vphsubw\0" "vphsubwd\0" "vpinsrb\0" "vpinsrd\0" "vpinsrq\0"
+  "vpinsrw\0" "vpmacsdd\0" "vpmacsdqh\0" "vpmacsdql\0" "vpmacssdd\0"
+  "vpmacssdqh\0" "vpmacssdql\0" "vpmacsswd\0" "vpmacssww\0" "vpmacswd\0"
+  "vpmacsww\0" "vpmadcsswd\0" "vpmadcswd\0" "vpmaddubsw\0" "vpmaddwd\0"
+  "vpmaskmovd\0" "vpmaskmovq\0" "vpmaxsb\0" "vpmaxsd\0" "vpmaxsw\0" "vpmaxub\0"
+  "vpmaxud\0" "vpmaxuw\0" "vpminsb\0" "vpminsd\0" "vpminsw\0" "vpminub\0"
+  "vpminud\0" "vpminuw\0" "vpmovmskb\0" "vpmovsxbd\0" "vpmovsxbq\0"
+  "vpmovsxbw\0" "vpmovsxdq\0" "vpmovsxwd\0" "vpmovsxwq\0" "vpmovzxbd\0"
+  "vpmovzxbq\0" "vpmovzxbw\0" "vpmovzxdq\0" "vpmovzxwd\0" "vpmovzxwq\0"
+  "vpmuldq\0" "vpmulhrsw\0" "vpmulhuw\0" "vpmulhw\0" "vpmulld\0" "vpmullw\0"
+  "vpmuludq\0" "vpor\0" "vpord\0" "vporq\0" "vpperm\0" "vprotb\0" "vprotd\0"
+  "vprotq\0" "vprotw\0" "vpsadbw\0" "vpshab\0" "vpshad\0" "vpshaq\0" "vpshaw\0"
+  "vpshlb\0" "vpshld\0" "vpshlq\0" "vpshlw\0" "vpshufb\0" "vpshufd\0"
+  "vpshufhw\0" "vpshuflw\0" "vpsignb\0" "vpsignd\0" "vpsignw\0" "vpslld\0"
+  "vpslldq\0" "vpsllq\0" "vpsllvd\0" "vpsllvq\0" "vpsllw\0" "vpsrad\0"
+  "vpsravd\0" "vpsraw\0" "vpsrld\0" "vpsrldq\0" "vpsrlq\0" "vpsrlvd\0"
+  "vpsrlvq\0" "vpsrlw\0" "vpsubb\0" "vpsubd\0" "vpsubq\0" "vpsubsb\0"
+  "vpsubsw\0" "vpsubusb\0" "vpsubusw\0" "vpsubw\0" "vpternlogd\0"
+  "vpternlogq\0" "vptest\0" "vptestmd\0" "vptestmq\0" "vptestnmd\0"
+  "vptestnmq\0" "vpunpckhbw\0" "vpunpckhdq\0" "vpunpckhqdq\0" "vpunpckhwd\0"
+  "vpunpcklbw\0" "vpunpckldq\0" "vpunpcklqdq\0" "vpunpcklwd\0" "vpxor\0"
+  "vpxord\0" "vpxorq\0" "vrcpps\0" "vrcpss\0" "vroundpd\0" "vroundps\0"
   "vroundsd\0" "vroundss\0" "vrsqrtps\0" "vrsqrtss\0" "vshufpd\0" "vshufps\0"
   "vsqrtpd\0" "vsqrtps\0" "vsqrtsd\0" "vsqrtss\0" "vstmxcsr\0" "vsubpd\0"
   "vsubps\0" "vsubsd\0" "vsubss\0" "vtestpd\0" "vtestps\0" "vucomisd\0"
@@ -283,88 +301,91 @@ static const char _x86InstNameData[] =
 // ----------------------------------------------------------------------------
 
 static const uint16_t _x86InstNameIndex[] = {
-  0, 1, 5, 640, 3418, 3430, 3652, 3662, 3157, 3169, 10, 2391, 2399, 2411, 2419,
-  2431, 2439, 1644, 4511, 2456, 2464, 2472, 2479, 15, 21, 29, 34, 40, 47, 2486,
-  2495, 2504, 2514, 52, 60, 65, 71, 78, 83, 87, 91, 97, 100, 104, 108, 112,
+  0, 1, 5, 640, 3470, 3482, 3704, 3714, 3209, 3221, 10, 2443, 2451, 2463, 2471,
+  2483, 2491, 1696, 4610, 2508, 2516, 2524, 2531, 15, 21, 29, 34, 40, 47, 2538,
+  2547, 2556, 2566, 52, 60, 65, 71, 78, 83, 87, 91, 97, 100, 104, 108, 112,
   117, 122, 126, 130, 135, 139, 143, 151, 162, 166, 172, 497, 504, 179, 512,
   185, 191, 198, 204, 211, 218, 519, 527, 226, 536, 233, 240, 248, 255, 263,
-  270, 277, 284, 291, 297, 303, 310, 317, 323, 329, 2580, 2587, 1902, 1915,
-  1928, 1941, 2594, 2601, 333, 341, 352, 6267, 6276, 362, 368, 372, 2624, 2634,
-  2644, 378, 2654, 387, 396, 2674, 2684, 405, 2704, 2714, 2724, 2734, 2744,
-  2754, 2764, 414, 2775, 424, 2786, 2797, 434, 438, 443, 447, 2394, 659, 2808,
-  2815, 2822, 2829, 2836, 2842, 627, 451, 2874, 4916, 457, 463, 1382, 468, 474,
+  270, 277, 284, 291, 297, 303, 310, 317, 323, 329, 2632, 2639, 1954, 1967,
+  1980, 1993, 2646, 2653, 333, 341, 352, 6549, 6558, 362, 368, 372, 2676, 2686,
+  2696, 378, 2706, 387, 396, 2726, 2736, 405, 2756, 2766, 2776, 2786, 2796,
+  2806, 2816, 414, 2827, 424, 2838, 2849, 434, 438, 443, 447, 2446, 659, 2860,
+  2867, 2874, 2881, 2888, 2894, 627, 451, 2926, 5112, 457, 463, 1434, 468, 474,
   479, 485, 490, 496, 503, 511, 518, 526, 535, 543, 551, 558, 563, 569, 576,
   582, 589, 594, 602, 607, 613, 619, 626, 632, 638, 644, 650, 657, 663, 670,
   675, 681, 689, 695, 700, 706, 713, 719, 726, 730, 735, 741, 748, 755, 762,
-  769, 776, 782, 1424, 787, 793, 800, 807, 812, 819, 826, 834, 841, 848, 854,
-  861, 867, 875, 882, 888, 895, 900, 908, 914, 918, 924, 931, 936, 1486, 942,
-  1492, 948, 955, 960, 966, 973, 981, 988, 996, 1002, 1007, 1012, 1020, 1030,
-  1037, 1046, 1054, 1060, 3941, 3949, 3957, 3965, 658, 676, 1068, 3997, 1072,
+  769, 776, 782, 1476, 787, 793, 800, 807, 812, 819, 826, 834, 841, 848, 854,
+  861, 867, 875, 882, 888, 895, 900, 908, 914, 918, 924, 931, 936, 1538, 942,
+  1544, 948, 955, 960, 966, 973, 981, 988, 996, 1002, 1007, 1012, 1020, 1030,
+  1037, 1046, 1054, 1060, 3993, 4001, 4009, 4017, 658, 676, 1068, 4049, 1072,
   871, 1080, 1083, 1087, 1090, 1094, 1097, 1106, 1109, 1113, 1116, 1124, 1128,
   1133, 1137, 1142, 1146, 1150, 1154, 1159, 1163, 1168, 1172, 1176, 1180, 1184,
-  1187, 1190, 1194, 1198, 1201, 1100, 1120, 1204, 4007, 4014, 1209, 1213, 1219,
-  1672, 1683, 1694, 1705, 1226, 4023, 5362, 4057, 4064, 5381, 4078, 1232, 4085,
-  4092, 5429, 4106, 1239, 4624, 1247, 4113, 4121, 505, 5355, 4135, 1255, 4144,
-  4027, 4160, 4169, 4177, 4185, 4194, 4202, 4210, 4220, 4230, 4239, 1263, 4249,
-  4258, 1270, 1277, 1285, 5366, 1293, 1716, 1727, 1738, 1749, 4273, 4280, 4290,
-  4300, 1301, 1307, 4307, 4315, 1314, 4323, 677, 4332, 4339, 4346, 4353, 1320,
-  1325, 1331, 808, 1335, 1017, 6325, 6332, 4372, 4379, 4386, 4393, 4403, 4413,
-  4423, 4433, 4440, 4447, 4454, 4462, 4470, 4479, 4488, 4495, 4504, 4510, 1339,
-  4517, 1345, 4524, 4540, 4550, 4611, 4629, 4638, 4647, 4656, 4665, 4676, 4687,
-  4696, 4705, 4714, 4723, 4734, 1353, 1358, 4899, 4907, 4915, 4923, 1363, 1369,
-  1375, 1381, 1387, 1395, 1403, 1411, 1417, 1423, 1429, 1436, 1444, 1450, 1459,
-  1468, 1477, 1485, 1491, 5002, 5019, 5088, 5114, 5135, 5152, 5161, 1498, 1504,
-  5178, 5186, 5194, 5202, 5330, 5341, 5372, 5380, 5388, 5396, 5404, 5412, 5420,
-  5428, 5436, 5444, 5452, 5460, 5468, 5478, 5488, 5498, 5508, 5518, 5528, 5538,
-  5548, 5558, 5568, 5578, 5588, 5598, 5606, 1510, 5616, 5625, 5633, 5641, 5649,
-  1518, 1522, 1527, 1534, 5658, 1539, 1548, 1562, 1572, 4324, 5762, 5770, 5778,
-  5787, 1584, 5796, 5804, 5812, 5820, 5827, 5835, 5858, 5865, 5880, 5887, 5894,
-  5902, 5925, 5932, 5939, 5946, 5953, 5961, 5969, 5978, 5987, 1591, 5994, 6001,
-  6012, 6023, 6035, 6046, 6057, 6068, 6080, 1598, 1603, 1609, 6091, 1615, 6097,
-  6104, 1619, 1623, 1632, 1641, 1648, 1655, 1661, 1668, 1679, 1690, 1701, 1712,
-  1723, 1734, 1745, 1756, 1767, 1778, 1789, 1800, 1812, 1824, 1836, 1848, 1860,
-  1872, 1884, 1896, 1909, 1922, 1935, 1948, 1961, 1974, 1987, 2000, 2004, 2008,
-  2012, 6111, 6120, 6129, 6138, 6147, 6156, 2017, 2022, 2026, 2030, 2035, 1954,
-  1967, 1980, 1993, 2039, 2044, 2050, 2055, 2061, 2066, 2071, 2076, 2082, 2087,
-  2093, 2099, 2106, 2112, 2119, 2125, 2131, 2137, 2144, 2150, 2157, 2163, 2169,
-  2175, 2181, 2186, 2191, 2197, 2203, 2208, 2213, 2220, 2229, 2238, 2248, 2258,
-  2269, 2280, 2292, 5742, 2296, 2301, 2305, 2310, 6165, 6173, 6181, 6148, 6197,
-  6157, 2315, 4580, 6213, 1760, 1771, 1782, 1793, 715, 3160, 3172, 3848, 3858,
-  2319, 5995, 2326, 2332, 6266, 6275, 2338, 6284, 6294, 6304, 6314, 2342, 2349,
-  2356, 2363, 2370, 2380, 2390, 2398, 2410, 2418, 2430, 2438, 2455, 2463, 2471,
-  2478, 2485, 2494, 2503, 2513, 2523, 2538, 2553, 2566, 2579, 2586, 2593, 2600,
-  2607, 2615, 2623, 2633, 2643, 2653, 2663, 2673, 2683, 2693, 2703, 2713, 2723,
-  2733, 2743, 2753, 2763, 2774, 2785, 2796, 2807, 2814, 2821, 2828, 2835, 2841,
-  2847, 2860, 2873, 2884, 2896, 2908, 2920, 2932, 2944, 2956, 2968, 2980, 2992,
-  3004, 3016, 3028, 3037, 3046, 3055, 3064, 3079, 3094, 3109, 3124, 3139, 3154,
-  3166, 3178, 3190, 3202, 3214, 3226, 3238, 3250, 3262, 3274, 3286, 3298, 3310,
-  3322, 3337, 3352, 3367, 3382, 3397, 3412, 3424, 3436, 3445, 3454, 3463, 3472,
-  3485, 3498, 3511, 3524, 3537, 3550, 3563, 3576, 3589, 3602, 3615, 3628, 3638,
-  3648, 3658, 3668, 3681, 3694, 3707, 3720, 3733, 3746, 3759, 3772, 3785, 3798,
-  3811, 3824, 3834, 3844, 3854, 3864, 3872, 3880, 3888, 3896, 3907, 3918, 3929,
-  3940, 3948, 3956, 3964, 3972, 3984, 3996, 4006, 4013, 4022, 4034, 4045, 4056,
-  4063, 4070, 4077, 4084, 4091, 4098, 4105, 4112, 4120, 4128, 4134, 4143, 4151,
-  4159, 4168, 4176, 4184, 4193, 4201, 4209, 4219, 4229, 4238, 4248, 4257, 4266,
-  4272, 4279, 4289, 4299, 4306, 4314, 4322, 4331, 4338, 4345, 4352, 4359, 4365,
-  4371, 4378, 4385, 4392, 4402, 4412, 4422, 4432, 4439, 4446, 4453, 4461, 4469,
-  4478, 4487, 4494, 4503, 4509, 4516, 4523, 4530, 4539, 4549, 4558, 4571, 4584,
-  4597, 4610, 4621, 4628, 4637, 4646, 4655, 4664, 4675, 4686, 4695, 4704, 4713,
-  4722, 4733, 4744, 4751, 4758, 4765, 4773, 4781, 4789, 4797, 4804, 4815, 4826,
-  4833, 4844, 4855, 4865, 4875, 4883, 4891, 4898, 4906, 4914, 4922, 4930, 4941,
-  4952, 4963, 4974, 4983, 4992, 5001, 5009, 5018, 5027, 5037, 5047, 5057, 5067,
-  5077, 5087, 5095, 5104, 5113, 5125, 5134, 5142, 5151, 5160, 5168, 5177, 5185,
-  5193, 5201, 5209, 5218, 5228, 5238, 5248, 5259, 5270, 5280, 5290, 5299, 5308,
-  5319, 5329, 5340, 5349, 5360, 5371, 5379, 5387, 5395, 5403, 5411, 5419, 5427,
-  5435, 5443, 5451, 5459, 5467, 5477, 5487, 5497, 5507, 5517, 5527, 5537, 5547,
-  5557, 5567, 5577, 5587, 5597, 5605, 5615, 5624, 5632, 5640, 5648, 5657, 5662,
-  5669, 5676, 5683, 5690, 5697, 5705, 5712, 5719, 5726, 5733, 5740, 5747, 5754,
-  5761, 5769, 5777, 5786, 5795, 5803, 5811, 5819, 5826, 5834, 5841, 5849, 5857,
-  5864, 5871, 5879, 5886, 5893, 5901, 5908, 5916, 5924, 5931, 5938, 5945, 5952,
-  5960, 5968, 5977, 5986, 5993, 6000, 6011, 6022, 6034, 6045, 6056, 6067, 6079,
-  6090, 6096, 6103, 6110, 6119, 6128, 6137, 6146, 6155, 6164, 6172, 6180, 6188,
-  6196, 6204, 6212, 6221, 6228, 6235, 6242, 6249, 6257, 6265, 6274, 6283, 6293,
-  6303, 6313, 6323, 6330, 6337, 6346, 6357, 6366, 6375, 336, 6380, 6092, 6324,
-  6331, 1013, 1021, 1031, 1038, 6387, 6396, 6407
+  1187, 1190, 1194, 1198, 1201, 1100, 1120, 1204, 1211, 1217, 1223, 1229, 1238,
+  1243, 1250, 1256, 4059, 4066, 1261, 1265, 1271, 1724, 1735, 1746, 1757, 1278,
+  4075, 5558, 4109, 4116, 5577, 4130, 1284, 4137, 4144, 5625, 4158, 1291, 4746,
+  1299, 4165, 4173, 505, 5551, 4187, 1307, 4196, 4079, 4252, 4261, 4269, 4277,
+  4286, 4294, 4302, 4312, 4322, 4331, 1315, 4341, 4350, 1322, 1329, 1337, 5562,
+  1345, 1768, 1779, 1790, 1801, 4365, 4372, 4382, 4392, 1353, 1359, 4399, 4407,
+  1366, 4415, 677, 4424, 4431, 4438, 4445, 1372, 1377, 1383, 808, 1387, 1017,
+  6607, 6614, 4464, 4471, 4478, 4485, 4495, 4505, 4515, 4525, 4532, 4539, 4546,
+  4554, 4562, 4571, 4580, 4587, 4596, 4609, 1391, 4639, 1397, 4646, 4662, 4672,
+  4733, 4758, 4767, 4776, 4785, 4794, 4805, 4816, 4825, 4834, 4843, 4852, 4863,
+  1405, 1410, 5095, 5103, 5111, 5119, 1415, 1421, 1427, 1433, 1439, 1447, 1455,
+  1463, 1469, 1475, 1481, 1488, 1496, 1502, 1511, 1520, 1529, 1537, 1543, 5198,
+  5215, 5284, 5310, 5331, 5348, 5357, 1550, 1556, 5374, 5382, 5390, 5398, 5526,
+  5537, 5568, 5576, 5584, 5592, 5600, 5608, 5616, 5624, 5632, 5640, 5648, 5656,
+  5664, 5674, 5684, 5694, 5704, 5714, 5724, 5734, 5744, 5754, 5764, 5774, 5784,
+  5794, 5802, 1562, 5812, 5821, 5829, 5837, 5845, 1570, 1574, 1579, 1586, 5854,
+  1591, 1600, 1614, 1624, 4416, 5970, 5978, 5986, 5995, 1636, 6004, 6012, 6020,
+  6028, 6035, 6043, 6066, 6073, 6088, 6095, 6102, 6110, 6133, 6140, 6147, 6154,
+  6161, 6169, 6177, 6186, 6195, 1643, 6224, 6269, 6280, 6291, 6303, 6314, 6325,
+  6336, 6348, 1650, 1655, 1661, 6359, 1667, 6379, 6386, 1671, 1675, 1684, 1693,
+  1700, 1707, 1713, 1720, 1731, 1742, 1753, 1764, 1775, 1786, 1797, 1808, 1819,
+  1830, 1841, 1852, 1864, 1876, 1888, 1900, 1912, 1924, 1936, 1948, 1961, 1974,
+  1987, 2000, 2013, 2026, 2039, 2052, 2056, 2060, 2064, 6393, 6402, 6411, 6420,
+  6429, 6438, 2069, 2074, 2078, 2082, 2087, 2006, 2019, 2032, 2045, 2091, 2096,
+  2102, 2107, 2113, 2118, 2123, 2128, 2134, 2139, 2145, 2151, 2158, 2164, 2171,
+  2177, 2183, 2189, 2196, 2202, 2209, 2215, 2221, 2227, 2233, 2238, 2243, 2249,
+  2255, 2260, 2265, 2272, 2281, 2290, 2300, 2310, 2321, 2332, 2344, 5950, 2348,
+  2353, 2357, 2362, 6447, 6455, 6463, 6430, 6479, 6439, 2367, 4702, 6495, 1812,
+  1823, 1834, 1845, 715, 3212, 3224, 3900, 3910, 2371, 6225, 2378, 2384, 6548,
+  6557, 2390, 6566, 6576, 6586, 6596, 2394, 2401, 2408, 2415, 2422, 2432, 2442,
+  2450, 2462, 2470, 2482, 2490, 2507, 2515, 2523, 2530, 2537, 2546, 2555, 2565,
+  2575, 2590, 2605, 2618, 2631, 2638, 2645, 2652, 2659, 2667, 2675, 2685, 2695,
+  2705, 2715, 2725, 2735, 2745, 2755, 2765, 2775, 2785, 2795, 2805, 2815, 2826,
+  2837, 2848, 2859, 2866, 2873, 2880, 2887, 2893, 2899, 2912, 2925, 2936, 2948,
+  2960, 2972, 2984, 2996, 3008, 3020, 3032, 3044, 3056, 3068, 3080, 3089, 3098,
+  3107, 3116, 3131, 3146, 3161, 3176, 3191, 3206, 3218, 3230, 3242, 3254, 3266,
+  3278, 3290, 3302, 3314, 3326, 3338, 3350, 3362, 3374, 3389, 3404, 3419, 3434,
+  3449, 3464, 3476, 3488, 3497, 3506, 3515, 3524, 3537, 3550, 3563, 3576, 3589,
+  3602, 3615, 3628, 3641, 3654, 3667, 3680, 3690, 3700, 3710, 3720, 3733, 3746,
+  3759, 3772, 3785, 3798, 3811, 3824, 3837, 3850, 3863, 3876, 3886, 3896, 3906,
+  3916, 3924, 3932, 3940, 3948, 3959, 3970, 3981, 3992, 4000, 4008, 4016, 4024,
+  4036, 4048, 4058, 4065, 4074, 4086, 4097, 4108, 4115, 4122, 4129, 4136, 4143,
+  4150, 4157, 4164, 4172, 4180, 4186, 4195, 4203, 4213, 4223, 4231, 4241, 4251,
+  4260, 4268, 4276, 4285, 4293, 4301, 4311, 4321, 4330, 4340, 4349, 4358, 4364,
+  4371, 4381, 4391, 4398, 4406, 4414, 4423, 4430, 4437, 4444, 4451, 4457, 4463,
+  4470, 4477, 4484, 4494, 4504, 4514, 4524, 4531, 4538, 4545, 4553, 4561, 4570,
+  4579, 4586, 4595, 4601, 4608, 4615, 4623, 4631, 4638, 4645, 4652, 4661, 4671,
+  4680, 4693, 4706, 4719, 4732, 4743, 4750, 4757, 4766, 4775, 4784, 4793, 4804,
+  4815, 4824, 4833, 4842, 4851, 4862, 4873, 4880, 4888, 4896, 4903, 4910, 4922,
+  4934, 4941, 4949, 4957, 4965, 4973, 4980, 4991, 5002, 5009, 5020, 5031, 5041,
+  5051, 5059, 5067, 5074, 5084, 5094, 5102, 5110, 5118, 5126, 5137, 5148, 5159,
+  5170, 5179, 5188, 5197, 5205, 5214, 5223, 5233, 5243, 5253, 5263, 5273, 5283,
+  5291, 5300, 5309, 5321, 5330, 5338, 5347, 5356, 5364, 5373, 5381, 5389, 5397,
+  5405, 5414, 5424, 5434, 5444, 5455, 5466, 5476, 5486, 5495, 5504, 5515, 5525,
+  5536, 5545, 5556, 5567, 5575, 5583, 5591, 5599, 5607, 5615, 5623, 5631, 5639,
+  5647, 5655, 5663, 5673, 5683, 5693, 5703, 5713, 5723, 5733, 5743, 5753, 5763,
+  5773, 5783, 5793, 5801, 5811, 5820, 5828, 5836, 5844, 5853, 5858, 5864, 5870,
+  5877, 5884, 5891, 5898, 5905, 5913, 5920, 5927, 5934, 5941, 5948, 5955, 5962,
+  5969, 5977, 5985, 5994, 6003, 6011, 6019, 6027, 6034, 6042, 6049, 6057, 6065,
+  6072, 6079, 6087, 6094, 6101, 6109, 6116, 6124, 6132, 6139, 6146, 6153, 6160,
+  6168, 6176, 6185, 6194, 6201, 6212, 6223, 6230, 6239, 6248, 6258, 6268, 6279,
+  6290, 6302, 6313, 6324, 6335, 6347, 6358, 6364, 6371, 6378, 6385, 6392, 6401,
+  6410, 6419, 6428, 6437, 6446, 6454, 6462, 6470, 6478, 6486, 6494, 6503, 6510,
+  6517, 6524, 6531, 6539, 6547, 6556, 6565, 6575, 6585, 6595, 6605, 6612, 6619,
+  6628, 6639, 6648, 6657, 336, 6662, 6360, 6606, 6613, 1013, 1021, 1031, 1038,
+  6669, 6678, 6689
 };
 
 enum X86InstAlphaIndex {
@@ -384,7 +405,7 @@ static const uint16_t _x86InstAlphaIndex[26] = {
   kX86InstIdHaddpd,
   kX86InstIdIdiv,
   kX86InstIdJa,
-  0xFFFF,
+  kX86InstIdKandnw,
   kX86InstIdLahf,
   kX86InstIdMaskmovdqu,
   kX86InstIdNeg,
@@ -462,7 +483,7 @@ const X86InstExtendedInfo _x86InstExtendedInfo[] = {
   { Enc(X86Rm_B)         , 0 , 0 , 0x00, 0x3F, 0, { U                 , U                 , U                 , U                 , U                  }, F(RW)|F(Special)                   , U                    },
   { Enc(X86Op)           , 0 , 0 , 0x00, 0x00, 0, { U                 , U                 , U                 , U                 , U                  }, F(Volatile)                        , U                    },
   { Enc(X86Enter)        , 0 , 0 , 0x00, 0x00, 0, { U                 , U                 , U                 , U                 , U                  }, F(Volatile)|F(Special)             , U                    },
-  { Enc(SimdExtract)     , 0 , 8 , 0x00, 0x00, 0, { O(GqdMem)         , O(Xmm)            , U                 , U                 , U                  }, F(WO)                              , U                    },
+  { Enc(SimdExtract)     , 0 , 8 , 0x00, 0x00, 0, { O(GqdMem)         , O(Xmm)            , O(Imm)            , U                 , U                  }, F(WO)                              , U                    },
   { Enc(SimdExtrq)       , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)|O(Imm)     , O(None)|O(Imm)    , U                 , U                  }, F(RW)                              , O_660F00(78,0,_,_,_) },
   { Enc(FpuOp)           , 0 , 0 , 0x00, 0x00, 0, { U                 , U                 , U                 , U                 , U                  }, F(Fp)                              , U                    },
   { Enc(FpuArith)        , 0 , 0 , 0x00, 0x00, 0, { O(FpMem)          , O(Fp)             , U                 , U                 , U                  }, F(Fp)|F(Mem4_8)                    , U                    },
@@ -500,7 +521,11 @@ const X86InstExtendedInfo _x86InstExtendedInfo[] = {
   { Enc(X86Jcc)          , 0 , 0 , 0x10, 0x00, 0, { O(Label)          , U                 , U                 , U                 , U                  }, F(Flow)|F(Volatile)                , U                    },
   { Enc(X86Jcc)          , 0 , 0 , 0x02, 0x00, 0, { O(Label)          , U                 , U                 , U                 , U                  }, F(Flow)|F(Volatile)                , U                    },
   { Enc(X86Jecxz)        , 0 , 0 , 0x00, 0x00, 0, { O(Gqdw)           , O(Label)          , U                 , U                 , U                  }, F(Flow)|F(Volatile)|F(Special)     , U                    },
-  { Enc(X86Jmp)          , 0 , 0 , 0x00, 0x00, 0, { O(Label)|O(Imm)   , U                 , U                 , U                 , U                  }, F(Flow)|F(Volatile)                , O_000000(E9,U,_,_,_) },
+  { Enc(X86Jmp)          , 0 , 0 , 0x00, 0x00, 0, { O(GqdMem)|O(LImm) , U                 , U                 , U                 , U                  }, F(Flow)|F(Volatile)                , O_000000(E9,U,_,_,_) },
+  { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(K)              , O(K)              , O(K)              , U                 , U                  }, F(WO)|A(F)                         , U                    },
+  { Enc(AvxKMov)         , 0 , 0 , 0x00, 0x00, 0, { O(KMem)|O(Gd)     , O(KMem)|O(Gd)     , U                 , U                 , U                  }, F(WO)|A(F)                         , O_000F00(91,U,0,0,_) },
+  { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(K)              , O(K)              , U                 , U                 , U                  }, F(WO)|A(F)                         , U                    },
+  { Enc(AvxRm)           , 0 , 0 , 0x00, 0x3F, 0, { O(K)              , O(K)              , U                 , U                 , U                  }, F(RO)|A(F)                         , U                    },
   { Enc(X86Op)           , 0 , 0 , 0x3E, 0x00, 0, { U                 , U                 , U                 , U                 , U                  }, F(RW)|F(Volatile)|F(Special)       , U                    },
   { Enc(SimdRm)          , 0 , 16, 0x00, 0x00, 0, { O(Xmm)            , O(Mem)            , U                 , U                 , U                  }, F(WO)                              , U                    },
   { Enc(X86Lea)          , 0 , 0 , 0x00, 0x00, 0, { O(Gqd)            , O(Mem)            , U                 , U                 , U                  }, F(WO)                              , U                    },
@@ -559,9 +584,8 @@ const X86InstExtendedInfo _x86InstExtendedInfo[] = {
   { Enc(Simd3dNow)       , 0 , 0 , 0x00, 0x00, 0, { O(Mm)             , O(MmMem)          , U                 , U                 , U                  }, F(RW)                              , U                    },
   { Enc(SimdRmi)         , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                  }, F(WO)|F(Special)                   , U                    },
   { Enc(AvxRvm_OptW)     , 0 , 0 , 0x00, 0x00, 0, { O(Gqd)            , O(Gqd)            , O(GqdMem)         , U                 , U                  }, F(WO)                              , U                    },
-  { Enc(SimdExtract)     , 0 , 8 , 0x00, 0x00, 0, { O(Gd)|O(Gb)|O(Mem), O(Xmm)            , U                 , U                 , U                  }, F(WO)                              , U                    },
-  { Enc(SimdExtract)     , 0 , 8 , 0x00, 0x00, 0, { O(GdMem)          , O(Xmm)            , U                 , U                 , U                  }, F(WO)                              , U                    },
-  { Enc(SimdPextrw)      , 0 , 8 , 0x00, 0x00, 0, { O(GdMem)          , O(MmXmm)          , U                 , U                 , U                  }, F(WO)                              , O_000F3A(15,U,_,_,_) },
+  { Enc(SimdExtract)     , 0 , 8 , 0x00, 0x00, 0, { O(GqdMem)|O(Gb)   , O(Xmm)            , O(Imm)            , U                 , U                  }, F(WO)                              , U                    },
+  { Enc(SimdPextrw)      , 0 , 8 , 0x00, 0x00, 0, { O(GqdMem)         , O(MmXmm)          , O(Imm)            , U                 , U                  }, F(WO)                              , O_000F3A(15,U,_,_,_) },
   { Enc(Simd3dNow)       , 0 , 8 , 0x00, 0x00, 0, { O(Mm)             , O(MmMem)          , U                 , U                 , U                  }, F(WO)                              , U                    },
   { Enc(SimdRmi)         , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(GdMem)          , O(Imm)            , U                 , U                  }, F(RW)                              , U                    },
   { Enc(SimdRmi)         , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(GqMem)          , O(Imm)            , U                 , U                  }, F(RW)                              , U                    },
@@ -609,25 +633,26 @@ const X86InstExtendedInfo _x86InstExtendedInfo[] = {
   { Enc(X86Set)          , 0 , 1 , 0x01, 0x00, 0, { O(GbMem)          , U                 , U                 , U                 , U                  }, F(WO)                              , U                    },
   { Enc(X86Set)          , 0 , 1 , 0x10, 0x00, 0, { O(GbMem)          , U                 , U                 , U                 , U                  }, F(WO)                              , U                    },
   { Enc(X86Set)          , 0 , 1 , 0x02, 0x00, 0, { O(GbMem)          , U                 , U                 , U                 , U                  }, F(WO)                              , U                    },
-  { Enc(X86ShldShrd)     , 0 , 0 , 0x00, 0x3F, 0, { O(GqdwbMem)       , O(Gb)             , U                 , U                 , U                  }, F(RW)|F(Special)                   , U                    },
-  { Enc(X86ShldShrd)     , 0 , 0 , 0x00, 0x3F, 0, { O(GqdwbMem)       , O(Gqdwb)          , U                 , U                 , U                  }, F(RW)|F(Special)                   , U                    },
+  { Enc(X86ShldShrd)     , 0 , 0 , 0x00, 0x3F, 0, { O(GqdwMem)        , O(Gqdw)           , O(Gb)|O(Imm)      , U                 , U                  }, F(RW)|F(Special)                   , U                    },
   { Enc(X86Op)           , 0 , 0 , 0x00, 0x20, 0, { U                 , U                 , U                 , U                 , U                  }, F(None)                            , U                    },
   { Enc(X86Op)           , 0 , 0 , 0x00, 0x40, 0, { U                 , U                 , U                 , U                 , U                  }, F(None)                            , U                    },
   { Enc(X86M)            , 0 , 0 , 0x00, 0x00, 0, { O(Mem)            , U                 , U                 , U                 , U                  }, F(Volatile)                        , U                    },
   { Enc(X86Op)           , 0 , 0 , 0x40, 0x00, 0, { U                 , U                 , U                 , U                 , U                  }, F(RW)|F(Volatile)|F(Special)       , U                    },
   { Enc(X86Op_66H)       , 0 , 0 , 0x40, 0x00, 0, { U                 , U                 , U                 , U                 , U                  }, F(RW)|F(Volatile)|F(Special)       , U                    },
   { Enc(X86Test)         , 0 , 0 , 0x00, 0x3F, 0, { O(GqdwbMem)       , O(Gqdwb)|O(Imm)   , U                 , U                 , U                  }, F(RO)                              , O_000000(F6,U,_,_,_) },
-  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , U                    },
   { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRmi)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRvmi_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRvmr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , O(Xy)             , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Ymm)            , O(Mem)            , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Ymm)            , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
-  { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRm_T1S)       , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(F_VL_KZ)            , U                    },
   { Enc(AvxRvmi)         , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x3F, 0, { O(Xmm)            , O(XmmMem)         , U                 , U                 , U                  }, F(RO)|F(Avx)                       , U                    },
+  { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxMri_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(Xy)             , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
@@ -650,11 +675,16 @@ const X86InstExtendedInfo _x86InstExtendedInfo[] = {
   { Enc(AvxRm)           , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , U                 , U                 , U                  }, F(RO)|F(Avx)|F(Special)            , U                    },
   { Enc(AvxRvmMvr_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(Xy)             , O(XyMem)          , U                 , U                  }, F(RW)|F(Avx)                       , O_660F38(2F,U,_,_,_) },
   { Enc(AvxRvmMvr_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(Xy)             , O(XyMem)          , U                 , U                  }, F(RW)|F(Avx)                       , O_660F38(2E,U,_,_,_) },
-  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(29,U,_,_,_) },
-  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_000F00(29,U,_,_,_) },
-  { Enc(AvxMovDQ)        , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(7E,U,_,_,_) },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|F(Avx)|A(F_VL_KZ_B_Sae)      , U                    },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(F_VL_KZ)            , O_660F00(29,U,_,_,1) },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(F_VL_KZ)            , O_000F00(29,U,_,_,0) },
+  { Enc(AvxMovDQ)        , 0 , 0 , 0x00, 0x00, 0, { O(GqdMem)|O(Xmm)  , O(GqdMem)|O(Xmm)  , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(7E,U,_,_,_) },
   { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(7F,U,_,_,_) },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|A(F_VL_KZ)                   , O_660F00(7F,U,_,_,0) },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|A(F_VL_KZ)                   , O_660F00(7F,U,_,_,1) },
   { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_F30F00(7F,U,_,_,_) },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|A(F_VL_KZ)                   , O_F30F00(7F,U,_,_,0) },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|A(F_VL_KZ)                   , O_F30F00(7F,U,_,_,1) },
   { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(Xmm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRvmMr)        , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(Xmm)            , O(Mem)            , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(17,U,_,_,_) },
   { Enc(AvxRvmMr)        , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(Xmm)            , O(Mem)            , U                 , U                  }, F(WO)|F(Avx)                       , O_000F00(17,U,_,_,_) },
@@ -662,20 +692,27 @@ const X86InstExtendedInfo _x86InstExtendedInfo[] = {
   { Enc(AvxRvmMr)        , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(Xmm)            , O(Mem)            , U                 , U                  }, F(WO)|F(Avx)                       , O_000F00(13,U,_,_,_) },
   { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Gqd)            , O(Xy)             , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxMr_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Mem)            , O(Xy)             , U                 , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxMovDQ)        , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(XmmMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(7E,U,_,W,_) },
   { Enc(AvxMovSsSd)      , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(XmmMem)         , O(Xmm)            , U                 , U                  }, F(WO)|F(Avx)                       , O_F20F00(11,U,_,_,_) },
-  { Enc(AvxMovSsSd)      , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(Xmm)            , O(Xmm)            , U                 , U                  }, F(WO)|F(Avx)                       , O_F30F00(11,U,_,_,_) },
-  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(11,U,_,_,_) },
-  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyMem)          , O(XyMem)          , U                 , U                 , U                  }, F(WO)|F(Avx)                       , O_000F00(11,U,_,_,_) },
+  { Enc(AvxMovSsSd)      , 0 , 0 , 0x00, 0x00, 0, { O(XmmMem)         , O(XmmMem)         , O(Xmm)            , U                 , U                  }, F(WO)|F(Avx)                       , O_F30F00(11,U,_,_,_) },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(F_VL_KZ)            , O_660F00(11,U,_,_,1) },
+  { Enc(AvxRmMr_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(F_VL_KZ)            , O_000F00(11,U,_,_,0) },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|F(Avx)|A(F_VL_KZ_B)          , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|A(F_VL_KZ_B)                 , U                    },
   { Enc(AvxRvmr)         , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , O(Xy)             , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(XopRvrmRvmr_OptL), 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , O(XyMem)          , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRvmi_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(K)              , O(Xyz)            , O(XyzMem)         , O(Imm)            , U                  }, F(WO)|A(F_VL_K_B)                  , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)|O(K)       , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|F(Avx)|A(F_VL_K_B)           , U                    },
   { Enc(AvxRmi)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)|F(Special)            , U                    },
   { Enc(XopRvmi)         , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxMr_T1S)       , 0 , 0 , 0x00, 0x00, 0, { O(XyzMem)         , O(Xyz)            , U                 , U                 , U                  }, F(WO)|A(F_VL_KZ)                   , U                    },
   { Enc(AvxRvmi)         , 0 , 0 , 0x00, 0x00, 0, { O(Ymm)            , O(Ymm)            , O(YmmMem)         , O(Imm)            , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRvm)          , 0 , 0 , 0x00, 0x00, 0, { O(Ymm)            , O(Ymm)            , O(YmmMem)         , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRvrmRvmr_OptL), 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(Xy)             , O(XyMem)          , O(XyMem)          , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxRvmRmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                  }, F(WO)|F(Avx)                       , O_660F3A(05,U,_,_,_) },
   { Enc(AvxRvmRmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                  }, F(WO)|F(Avx)                       , O_660F3A(04,U,_,_,_) },
   { Enc(AvxRmi)          , 0 , 0 , 0x00, 0x00, 0, { O(Ymm)            , O(YmmMem)         , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRm_T1S)       , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|A(F_VL_KZ)                   , U                    },
   { Enc(AvxMri)          , 0 , 0 , 0x00, 0x00, 0, { O(GqdwbMem)       , O(Xmm)            , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxMri)          , 0 , 0 , 0x00, 0x00, 0, { O(GqMem)          , O(Xmm)            , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
   { Enc(AvxMri)          , 0 , 0 , 0x00, 0x00, 0, { O(GqdwMem)        , O(Xmm)            , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
@@ -691,22 +728,26 @@ const X86InstExtendedInfo _x86InstExtendedInfo[] = {
   { Enc(XopRvmRmi)       , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , O(XmmMem)|O(Imm)  , U                 , U                  }, F(WO)|F(Avx)                       , O_00_M08(C3,U,_,_,_) },
   { Enc(XopRvmRmi)       , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , O(XmmMem)|O(Imm)  , U                 , U                  }, F(WO)|F(Avx)                       , O_00_M08(C1,U,_,_,_) },
   { Enc(XopRvmRmv)       , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , O(XmmMem)         , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
+  { Enc(AvxRmi_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(XyzMem)         , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)|A(F_VL_KZ_B)          , U                    },
   { Enc(AvxRmi_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
-  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(72,6,_,_,_) },
+  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(72,6,_,_,_) },
   { Enc(AvxVmi_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(Imm)            , U                 , U                  }, F(WO)|F(Avx)                       , U                    },
-  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(73,6,_,_,_) },
-  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(71,6,_,_,_) },
-  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(72,4,_,_,_) },
-  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(71,4,_,_,_) },
-  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(72,2,_,_,_) },
-  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(73,2,_,_,_) },
-  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(71,2,_,_,_) },
+  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(73,6,_,_,_) },
+  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(71,6,_,_,_) },
+  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(72,4,_,_,_) },
+  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(71,4,_,_,_) },
+  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(72,2,_,_,_) },
+  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(73,2,_,_,_) },
+  { Enc(AvxRvmVmi_OptL)  , 0 , 0 , 0x00, 0x00, 0, { O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                  }, F(WO)|F(Avx)                       , O_660F00(71,2,_,_,_) },
+  { Enc(AvxRvmi_OptL)    , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(Xyz)            , O(XyzMem)         , O(Imm)            , U                  }, F(RW)|A(F_VL_KZ_B)                 , U                    },
   { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x3F, 0, { O(Xy)             , O(XyMem)          , U                 , U                 , U                  }, F(RO)|F(Avx)                       , U                    },
+  { Enc(AvxRvm_OptL)     , 0 , 0 , 0x00, 0x00, 0, { O(K)              , O(Xyz)            , O(XyzMem)         , U                 , U                  }, F(WO)|A(F_VL_K_B)                  , U                    },
+  { Enc(AvxRm_OptL)      , 0 , 0 , 0x00, 0x00, 0, { O(Xyz)            , O(XyzMem)         , U                 , U                 , U                  }, F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , U                    },
   { Enc(AvxM)            , 0 , 0 , 0x00, 0x00, 0, { O(Mem)            , U                 , U                 , U                 , U                  }, F(Volatile)|F(Avx)                 , U                    },
   { Enc(AvxOp)           , 0 , 0 , 0x00, 0x00, 0, { U                 , U                 , U                 , U                 , U                  }, F(Volatile)|F(Avx)                 , U                    },
   { Enc(X86Rm)           , 0 , 0 , 0x00, 0x00, 0, { O(Gqd)            , U                 , U                 , U                 , U                  }, F(RO)|F(Volatile)                  , U                    },
   { Enc(X86Xadd)         , 0 , 0 , 0x00, 0x3F, 0, { O(GqdwbMem)       , O(Gqdwb)          , U                 , U                 , U                  }, F(RW)|F(Xchg)|F(Lock)              , U                    },
-  { Enc(X86Xchg)         , 0 , 0 , 0x00, 0x00, 0, { O(GqdwbMem)       , O(Gqdwb)          , U                 , U                 , U                  }, F(RW)|F(Xchg)|F(Lock)              , U                    },
+  { Enc(X86Xchg)         , 0 , 0 , 0x00, 0x00, 0, { O(GqdwbMem)       , O(GqdwbMem)       , U                 , U                 , U                  }, F(RW)|F(Xchg)|F(Lock)              , U                    },
   { Enc(SimdRm)          , 0 , 0 , 0x00, 0x00, 0, { O(Xmm)            , O(XmmMem)         , U                 , U                 , U                  }, F(RW)|F(None)                      , U                    },
   { Enc(X86M)            , 0 , 0 , 0x00, 0x00, 0, { O(Mem)            , U                 , U                 , U                 , U                  }, F(RO)|F(Volatile)|F(Special)       , U                    }
 };
@@ -994,174 +1035,182 @@ enum X86InstData_ExtendedIndex {
     kX86InstIdJz_ExtendedIndex = 87,
     kX86InstIdJecxz_ExtendedIndex = 93,
     kX86InstIdJmp_ExtendedIndex = 94,
-    kX86InstIdLahf_ExtendedIndex = 95,
-    kX86InstIdLddqu_ExtendedIndex = 96,
+    kX86InstIdKandnw_ExtendedIndex = 95,
+    kX86InstIdKandw_ExtendedIndex = 95,
+    kX86InstIdKmovw_ExtendedIndex = 96,
+    kX86InstIdKnotw_ExtendedIndex = 97,
+    kX86InstIdKortestw_ExtendedIndex = 98,
+    kX86InstIdKorw_ExtendedIndex = 95,
+    kX86InstIdKxnorw_ExtendedIndex = 95,
+    kX86InstIdKxorw_ExtendedIndex = 95,
+    kX86InstIdLahf_ExtendedIndex = 99,
+    kX86InstIdLddqu_ExtendedIndex = 100,
     kX86InstIdLdmxcsr_ExtendedIndex = 24,
-    kX86InstIdLea_ExtendedIndex = 97,
-    kX86InstIdLeave_ExtendedIndex = 98,
-    kX86InstIdLfence_ExtendedIndex = 99,
-    kX86InstIdLodsB_ExtendedIndex = 100,
-    kX86InstIdLodsD_ExtendedIndex = 101,
-    kX86InstIdLodsQ_ExtendedIndex = 102,
-    kX86InstIdLodsW_ExtendedIndex = 103,
+    kX86InstIdLea_ExtendedIndex = 101,
+    kX86InstIdLeave_ExtendedIndex = 102,
+    kX86InstIdLfence_ExtendedIndex = 103,
+    kX86InstIdLodsB_ExtendedIndex = 104,
+    kX86InstIdLodsD_ExtendedIndex = 105,
+    kX86InstIdLodsQ_ExtendedIndex = 106,
+    kX86InstIdLodsW_ExtendedIndex = 107,
     kX86InstIdLzcnt_ExtendedIndex = 14,
-    kX86InstIdMaskmovdqu_ExtendedIndex = 104,
-    kX86InstIdMaskmovq_ExtendedIndex = 105,
+    kX86InstIdMaskmovdqu_ExtendedIndex = 108,
+    kX86InstIdMaskmovq_ExtendedIndex = 109,
     kX86InstIdMaxpd_ExtendedIndex = 4,
     kX86InstIdMaxps_ExtendedIndex = 4,
     kX86InstIdMaxsd_ExtendedIndex = 4,
     kX86InstIdMaxss_ExtendedIndex = 4,
-    kX86InstIdMfence_ExtendedIndex = 106,
+    kX86InstIdMfence_ExtendedIndex = 110,
     kX86InstIdMinpd_ExtendedIndex = 4,
     kX86InstIdMinps_ExtendedIndex = 4,
     kX86InstIdMinsd_ExtendedIndex = 4,
     kX86InstIdMinss_ExtendedIndex = 4,
-    kX86InstIdMonitor_ExtendedIndex = 107,
-    kX86InstIdMov_ExtendedIndex = 108,
-    kX86InstIdMovPtr_ExtendedIndex = 109,
-    kX86InstIdMovapd_ExtendedIndex = 110,
-    kX86InstIdMovaps_ExtendedIndex = 111,
-    kX86InstIdMovbe_ExtendedIndex = 112,
-    kX86InstIdMovd_ExtendedIndex = 113,
-    kX86InstIdMovddup_ExtendedIndex = 114,
-    kX86InstIdMovdq2q_ExtendedIndex = 115,
-    kX86InstIdMovdqa_ExtendedIndex = 116,
-    kX86InstIdMovdqu_ExtendedIndex = 117,
-    kX86InstIdMovhlps_ExtendedIndex = 118,
-    kX86InstIdMovhpd_ExtendedIndex = 119,
-    kX86InstIdMovhps_ExtendedIndex = 120,
-    kX86InstIdMovlhps_ExtendedIndex = 121,
-    kX86InstIdMovlpd_ExtendedIndex = 122,
-    kX86InstIdMovlps_ExtendedIndex = 123,
-    kX86InstIdMovmskpd_ExtendedIndex = 124,
-    kX86InstIdMovmskps_ExtendedIndex = 124,
-    kX86InstIdMovntdq_ExtendedIndex = 125,
-    kX86InstIdMovntdqa_ExtendedIndex = 126,
-    kX86InstIdMovnti_ExtendedIndex = 127,
-    kX86InstIdMovntpd_ExtendedIndex = 128,
-    kX86InstIdMovntps_ExtendedIndex = 129,
-    kX86InstIdMovntq_ExtendedIndex = 130,
-    kX86InstIdMovntsd_ExtendedIndex = 131,
-    kX86InstIdMovntss_ExtendedIndex = 132,
-    kX86InstIdMovq_ExtendedIndex = 133,
-    kX86InstIdMovq2dq_ExtendedIndex = 134,
-    kX86InstIdMovsB_ExtendedIndex = 135,
-    kX86InstIdMovsD_ExtendedIndex = 135,
-    kX86InstIdMovsQ_ExtendedIndex = 135,
-    kX86InstIdMovsW_ExtendedIndex = 136,
-    kX86InstIdMovsd_ExtendedIndex = 137,
+    kX86InstIdMonitor_ExtendedIndex = 111,
+    kX86InstIdMov_ExtendedIndex = 112,
+    kX86InstIdMovPtr_ExtendedIndex = 113,
+    kX86InstIdMovapd_ExtendedIndex = 114,
+    kX86InstIdMovaps_ExtendedIndex = 115,
+    kX86InstIdMovbe_ExtendedIndex = 116,
+    kX86InstIdMovd_ExtendedIndex = 117,
+    kX86InstIdMovddup_ExtendedIndex = 118,
+    kX86InstIdMovdq2q_ExtendedIndex = 119,
+    kX86InstIdMovdqa_ExtendedIndex = 120,
+    kX86InstIdMovdqu_ExtendedIndex = 121,
+    kX86InstIdMovhlps_ExtendedIndex = 122,
+    kX86InstIdMovhpd_ExtendedIndex = 123,
+    kX86InstIdMovhps_ExtendedIndex = 124,
+    kX86InstIdMovlhps_ExtendedIndex = 125,
+    kX86InstIdMovlpd_ExtendedIndex = 126,
+    kX86InstIdMovlps_ExtendedIndex = 127,
+    kX86InstIdMovmskpd_ExtendedIndex = 128,
+    kX86InstIdMovmskps_ExtendedIndex = 128,
+    kX86InstIdMovntdq_ExtendedIndex = 129,
+    kX86InstIdMovntdqa_ExtendedIndex = 130,
+    kX86InstIdMovnti_ExtendedIndex = 131,
+    kX86InstIdMovntpd_ExtendedIndex = 132,
+    kX86InstIdMovntps_ExtendedIndex = 133,
+    kX86InstIdMovntq_ExtendedIndex = 134,
+    kX86InstIdMovntsd_ExtendedIndex = 135,
+    kX86InstIdMovntss_ExtendedIndex = 136,
+    kX86InstIdMovq_ExtendedIndex = 137,
+    kX86InstIdMovq2dq_ExtendedIndex = 138,
+    kX86InstIdMovsB_ExtendedIndex = 139,
+    kX86InstIdMovsD_ExtendedIndex = 139,
+    kX86InstIdMovsQ_ExtendedIndex = 139,
+    kX86InstIdMovsW_ExtendedIndex = 140,
+    kX86InstIdMovsd_ExtendedIndex = 141,
     kX86InstIdMovshdup_ExtendedIndex = 42,
     kX86InstIdMovsldup_ExtendedIndex = 42,
-    kX86InstIdMovss_ExtendedIndex = 138,
-    kX86InstIdMovsx_ExtendedIndex = 139,
-    kX86InstIdMovsxd_ExtendedIndex = 140,
-    kX86InstIdMovupd_ExtendedIndex = 141,
-    kX86InstIdMovups_ExtendedIndex = 142,
-    kX86InstIdMovzx_ExtendedIndex = 139,
+    kX86InstIdMovss_ExtendedIndex = 142,
+    kX86InstIdMovsx_ExtendedIndex = 143,
+    kX86InstIdMovsxd_ExtendedIndex = 144,
+    kX86InstIdMovupd_ExtendedIndex = 145,
+    kX86InstIdMovups_ExtendedIndex = 146,
+    kX86InstIdMovzx_ExtendedIndex = 143,
     kX86InstIdMpsadbw_ExtendedIndex = 11,
     kX86InstIdMul_ExtendedIndex = 80,
     kX86InstIdMulpd_ExtendedIndex = 4,
     kX86InstIdMulps_ExtendedIndex = 4,
     kX86InstIdMulsd_ExtendedIndex = 4,
     kX86InstIdMulss_ExtendedIndex = 4,
-    kX86InstIdMulx_ExtendedIndex = 143,
-    kX86InstIdMwait_ExtendedIndex = 107,
-    kX86InstIdNeg_ExtendedIndex = 144,
-    kX86InstIdNop_ExtendedIndex = 145,
-    kX86InstIdNot_ExtendedIndex = 146,
+    kX86InstIdMulx_ExtendedIndex = 147,
+    kX86InstIdMwait_ExtendedIndex = 111,
+    kX86InstIdNeg_ExtendedIndex = 148,
+    kX86InstIdNop_ExtendedIndex = 149,
+    kX86InstIdNot_ExtendedIndex = 150,
     kX86InstIdOr_ExtendedIndex = 3,
     kX86InstIdOrpd_ExtendedIndex = 4,
     kX86InstIdOrps_ExtendedIndex = 4,
-    kX86InstIdPabsb_ExtendedIndex = 147,
-    kX86InstIdPabsd_ExtendedIndex = 147,
-    kX86InstIdPabsw_ExtendedIndex = 147,
-    kX86InstIdPackssdw_ExtendedIndex = 147,
-    kX86InstIdPacksswb_ExtendedIndex = 147,
+    kX86InstIdPabsb_ExtendedIndex = 151,
+    kX86InstIdPabsd_ExtendedIndex = 151,
+    kX86InstIdPabsw_ExtendedIndex = 151,
+    kX86InstIdPackssdw_ExtendedIndex = 151,
+    kX86InstIdPacksswb_ExtendedIndex = 151,
     kX86InstIdPackusdw_ExtendedIndex = 4,
-    kX86InstIdPackuswb_ExtendedIndex = 147,
-    kX86InstIdPaddb_ExtendedIndex = 147,
-    kX86InstIdPaddd_ExtendedIndex = 147,
-    kX86InstIdPaddq_ExtendedIndex = 147,
-    kX86InstIdPaddsb_ExtendedIndex = 147,
-    kX86InstIdPaddsw_ExtendedIndex = 147,
-    kX86InstIdPaddusb_ExtendedIndex = 147,
-    kX86InstIdPaddusw_ExtendedIndex = 147,
-    kX86InstIdPaddw_ExtendedIndex = 147,
-    kX86InstIdPalignr_ExtendedIndex = 148,
-    kX86InstIdPand_ExtendedIndex = 147,
-    kX86InstIdPandn_ExtendedIndex = 147,
-    kX86InstIdPause_ExtendedIndex = 149,
-    kX86InstIdPavgb_ExtendedIndex = 147,
-    kX86InstIdPavgusb_ExtendedIndex = 150,
-    kX86InstIdPavgw_ExtendedIndex = 147,
+    kX86InstIdPackuswb_ExtendedIndex = 151,
+    kX86InstIdPaddb_ExtendedIndex = 151,
+    kX86InstIdPaddd_ExtendedIndex = 151,
+    kX86InstIdPaddq_ExtendedIndex = 151,
+    kX86InstIdPaddsb_ExtendedIndex = 151,
+    kX86InstIdPaddsw_ExtendedIndex = 151,
+    kX86InstIdPaddusb_ExtendedIndex = 151,
+    kX86InstIdPaddusw_ExtendedIndex = 151,
+    kX86InstIdPaddw_ExtendedIndex = 151,
+    kX86InstIdPalignr_ExtendedIndex = 152,
+    kX86InstIdPand_ExtendedIndex = 151,
+    kX86InstIdPandn_ExtendedIndex = 151,
+    kX86InstIdPause_ExtendedIndex = 153,
+    kX86InstIdPavgb_ExtendedIndex = 151,
+    kX86InstIdPavgusb_ExtendedIndex = 154,
+    kX86InstIdPavgw_ExtendedIndex = 151,
     kX86InstIdPblendvb_ExtendedIndex = 12,
     kX86InstIdPblendw_ExtendedIndex = 11,
     kX86InstIdPclmulqdq_ExtendedIndex = 11,
-    kX86InstIdPcmpeqb_ExtendedIndex = 147,
-    kX86InstIdPcmpeqd_ExtendedIndex = 147,
+    kX86InstIdPcmpeqb_ExtendedIndex = 151,
+    kX86InstIdPcmpeqd_ExtendedIndex = 151,
     kX86InstIdPcmpeqq_ExtendedIndex = 4,
-    kX86InstIdPcmpeqw_ExtendedIndex = 147,
-    kX86InstIdPcmpestri_ExtendedIndex = 151,
-    kX86InstIdPcmpestrm_ExtendedIndex = 151,
-    kX86InstIdPcmpgtb_ExtendedIndex = 147,
-    kX86InstIdPcmpgtd_ExtendedIndex = 147,
+    kX86InstIdPcmpeqw_ExtendedIndex = 151,
+    kX86InstIdPcmpestri_ExtendedIndex = 155,
+    kX86InstIdPcmpestrm_ExtendedIndex = 155,
+    kX86InstIdPcmpgtb_ExtendedIndex = 151,
+    kX86InstIdPcmpgtd_ExtendedIndex = 151,
     kX86InstIdPcmpgtq_ExtendedIndex = 4,
-    kX86InstIdPcmpgtw_ExtendedIndex = 147,
-    kX86InstIdPcmpistri_ExtendedIndex = 151,
-    kX86InstIdPcmpistrm_ExtendedIndex = 151,
-    kX86InstIdPdep_ExtendedIndex = 152,
-    kX86InstIdPext_ExtendedIndex = 152,
-    kX86InstIdPextrb_ExtendedIndex = 153,
-    kX86InstIdPextrd_ExtendedIndex = 154,
+    kX86InstIdPcmpgtw_ExtendedIndex = 151,
+    kX86InstIdPcmpistri_ExtendedIndex = 155,
+    kX86InstIdPcmpistrm_ExtendedIndex = 155,
+    kX86InstIdPdep_ExtendedIndex = 156,
+    kX86InstIdPext_ExtendedIndex = 156,
+    kX86InstIdPextrb_ExtendedIndex = 157,
+    kX86InstIdPextrd_ExtendedIndex = 56,
     kX86InstIdPextrq_ExtendedIndex = 56,
-    kX86InstIdPextrw_ExtendedIndex = 155,
-    kX86InstIdPf2id_ExtendedIndex = 156,
-    kX86InstIdPf2iw_ExtendedIndex = 156,
-    kX86InstIdPfacc_ExtendedIndex = 150,
-    kX86InstIdPfadd_ExtendedIndex = 150,
-    kX86InstIdPfcmpeq_ExtendedIndex = 150,
-    kX86InstIdPfcmpge_ExtendedIndex = 150,
-    kX86InstIdPfcmpgt_ExtendedIndex = 150,
-    kX86InstIdPfmax_ExtendedIndex = 150,
-    kX86InstIdPfmin_ExtendedIndex = 150,
-    kX86InstIdPfmul_ExtendedIndex = 150,
-    kX86InstIdPfnacc_ExtendedIndex = 150,
-    kX86InstIdPfpnacc_ExtendedIndex = 150,
-    kX86InstIdPfrcp_ExtendedIndex = 156,
-    kX86InstIdPfrcpit1_ExtendedIndex = 150,
-    kX86InstIdPfrcpit2_ExtendedIndex = 150,
-    kX86InstIdPfrsqit1_ExtendedIndex = 150,
-    kX86InstIdPfrsqrt_ExtendedIndex = 150,
-    kX86InstIdPfsub_ExtendedIndex = 150,
-    kX86InstIdPfsubr_ExtendedIndex = 150,
-    kX86InstIdPhaddd_ExtendedIndex = 147,
-    kX86InstIdPhaddsw_ExtendedIndex = 147,
-    kX86InstIdPhaddw_ExtendedIndex = 147,
+    kX86InstIdPextrw_ExtendedIndex = 158,
+    kX86InstIdPf2id_ExtendedIndex = 159,
+    kX86InstIdPf2iw_ExtendedIndex = 159,
+    kX86InstIdPfacc_ExtendedIndex = 154,
+    kX86InstIdPfadd_ExtendedIndex = 154,
+    kX86InstIdPfcmpeq_ExtendedIndex = 154,
+    kX86InstIdPfcmpge_ExtendedIndex = 154,
+    kX86InstIdPfcmpgt_ExtendedIndex = 154,
+    kX86InstIdPfmax_ExtendedIndex = 154,
+    kX86InstIdPfmin_ExtendedIndex = 154,
+    kX86InstIdPfmul_ExtendedIndex = 154,
+    kX86InstIdPfnacc_ExtendedIndex = 154,
+    kX86InstIdPfpnacc_ExtendedIndex = 154,
+    kX86InstIdPfrcp_ExtendedIndex = 159,
+    kX86InstIdPfrcpit1_ExtendedIndex = 154,
+    kX86InstIdPfrcpit2_ExtendedIndex = 154,
+    kX86InstIdPfrsqit1_ExtendedIndex = 154,
+    kX86InstIdPfrsqrt_ExtendedIndex = 154,
+    kX86InstIdPfsub_ExtendedIndex = 154,
+    kX86InstIdPfsubr_ExtendedIndex = 154,
+    kX86InstIdPhaddd_ExtendedIndex = 151,
+    kX86InstIdPhaddsw_ExtendedIndex = 151,
+    kX86InstIdPhaddw_ExtendedIndex = 151,
     kX86InstIdPhminposuw_ExtendedIndex = 4,
-    kX86InstIdPhsubd_ExtendedIndex = 147,
-    kX86InstIdPhsubsw_ExtendedIndex = 147,
-    kX86InstIdPhsubw_ExtendedIndex = 147,
-    kX86InstIdPi2fd_ExtendedIndex = 156,
-    kX86InstIdPi2fw_ExtendedIndex = 156,
-    kX86InstIdPinsrb_ExtendedIndex = 157,
-    kX86InstIdPinsrd_ExtendedIndex = 157,
-    kX86InstIdPinsrq_ExtendedIndex = 158,
-    kX86InstIdPinsrw_ExtendedIndex = 159,
-    kX86InstIdPmaddubsw_ExtendedIndex = 147,
-    kX86InstIdPmaddwd_ExtendedIndex = 147,
+    kX86InstIdPhsubd_ExtendedIndex = 151,
+    kX86InstIdPhsubsw_ExtendedIndex = 151,
+    kX86InstIdPhsubw_ExtendedIndex = 151,
+    kX86InstIdPi2fd_ExtendedIndex = 159,
+    kX86InstIdPi2fw_ExtendedIndex = 159,
+    kX86InstIdPinsrb_ExtendedIndex = 160,
+    kX86InstIdPinsrd_ExtendedIndex = 160,
+    kX86InstIdPinsrq_ExtendedIndex = 161,
+    kX86InstIdPinsrw_ExtendedIndex = 162,
+    kX86InstIdPmaddubsw_ExtendedIndex = 151,
+    kX86InstIdPmaddwd_ExtendedIndex = 151,
     kX86InstIdPmaxsb_ExtendedIndex = 4,
     kX86InstIdPmaxsd_ExtendedIndex = 4,
-    kX86InstIdPmaxsw_ExtendedIndex = 147,
-    kX86InstIdPmaxub_ExtendedIndex = 147,
+    kX86InstIdPmaxsw_ExtendedIndex = 151,
+    kX86InstIdPmaxub_ExtendedIndex = 151,
     kX86InstIdPmaxud_ExtendedIndex = 4,
     kX86InstIdPmaxuw_ExtendedIndex = 4,
     kX86InstIdPminsb_ExtendedIndex = 4,
     kX86InstIdPminsd_ExtendedIndex = 4,
-    kX86InstIdPminsw_ExtendedIndex = 147,
-    kX86InstIdPminub_ExtendedIndex = 147,
+    kX86InstIdPminsw_ExtendedIndex = 151,
+    kX86InstIdPminub_ExtendedIndex = 151,
     kX86InstIdPminud_ExtendedIndex = 4,
     kX86InstIdPminuw_ExtendedIndex = 4,
-    kX86InstIdPmovmskb_ExtendedIndex = 160,
+    kX86InstIdPmovmskb_ExtendedIndex = 163,
     kX86InstIdPmovsxbd_ExtendedIndex = 42,
     kX86InstIdPmovsxbq_ExtendedIndex = 42,
     kX86InstIdPmovsxbw_ExtendedIndex = 42,
@@ -1175,151 +1224,151 @@ enum X86InstData_ExtendedIndex {
     kX86InstIdPmovzxwd_ExtendedIndex = 42,
     kX86InstIdPmovzxwq_ExtendedIndex = 42,
     kX86InstIdPmuldq_ExtendedIndex = 4,
-    kX86InstIdPmulhrsw_ExtendedIndex = 147,
-    kX86InstIdPmulhrw_ExtendedIndex = 150,
-    kX86InstIdPmulhuw_ExtendedIndex = 147,
-    kX86InstIdPmulhw_ExtendedIndex = 147,
+    kX86InstIdPmulhrsw_ExtendedIndex = 151,
+    kX86InstIdPmulhrw_ExtendedIndex = 154,
+    kX86InstIdPmulhuw_ExtendedIndex = 151,
+    kX86InstIdPmulhw_ExtendedIndex = 151,
     kX86InstIdPmulld_ExtendedIndex = 4,
-    kX86InstIdPmullw_ExtendedIndex = 147,
-    kX86InstIdPmuludq_ExtendedIndex = 147,
-    kX86InstIdPop_ExtendedIndex = 161,
-    kX86InstIdPopa_ExtendedIndex = 98,
-    kX86InstIdPopcnt_ExtendedIndex = 162,
-    kX86InstIdPopf_ExtendedIndex = 163,
-    kX86InstIdPor_ExtendedIndex = 147,
-    kX86InstIdPrefetch_ExtendedIndex = 164,
+    kX86InstIdPmullw_ExtendedIndex = 151,
+    kX86InstIdPmuludq_ExtendedIndex = 151,
+    kX86InstIdPop_ExtendedIndex = 164,
+    kX86InstIdPopa_ExtendedIndex = 102,
+    kX86InstIdPopcnt_ExtendedIndex = 165,
+    kX86InstIdPopf_ExtendedIndex = 166,
+    kX86InstIdPor_ExtendedIndex = 151,
+    kX86InstIdPrefetch_ExtendedIndex = 167,
     kX86InstIdPrefetch3dNow_ExtendedIndex = 24,
-    kX86InstIdPrefetchw_ExtendedIndex = 165,
-    kX86InstIdPrefetchwt1_ExtendedIndex = 165,
-    kX86InstIdPsadbw_ExtendedIndex = 147,
-    kX86InstIdPshufb_ExtendedIndex = 147,
-    kX86InstIdPshufd_ExtendedIndex = 166,
-    kX86InstIdPshufhw_ExtendedIndex = 166,
-    kX86InstIdPshuflw_ExtendedIndex = 166,
-    kX86InstIdPshufw_ExtendedIndex = 167,
-    kX86InstIdPsignb_ExtendedIndex = 147,
-    kX86InstIdPsignd_ExtendedIndex = 147,
-    kX86InstIdPsignw_ExtendedIndex = 147,
-    kX86InstIdPslld_ExtendedIndex = 168,
-    kX86InstIdPslldq_ExtendedIndex = 169,
-    kX86InstIdPsllq_ExtendedIndex = 170,
-    kX86InstIdPsllw_ExtendedIndex = 171,
-    kX86InstIdPsrad_ExtendedIndex = 172,
-    kX86InstIdPsraw_ExtendedIndex = 173,
-    kX86InstIdPsrld_ExtendedIndex = 174,
-    kX86InstIdPsrldq_ExtendedIndex = 175,
-    kX86InstIdPsrlq_ExtendedIndex = 176,
-    kX86InstIdPsrlw_ExtendedIndex = 177,
-    kX86InstIdPsubb_ExtendedIndex = 147,
-    kX86InstIdPsubd_ExtendedIndex = 147,
-    kX86InstIdPsubq_ExtendedIndex = 147,
-    kX86InstIdPsubsb_ExtendedIndex = 147,
-    kX86InstIdPsubsw_ExtendedIndex = 147,
-    kX86InstIdPsubusb_ExtendedIndex = 147,
-    kX86InstIdPsubusw_ExtendedIndex = 147,
-    kX86InstIdPsubw_ExtendedIndex = 147,
-    kX86InstIdPswapd_ExtendedIndex = 156,
+    kX86InstIdPrefetchw_ExtendedIndex = 168,
+    kX86InstIdPrefetchwt1_ExtendedIndex = 168,
+    kX86InstIdPsadbw_ExtendedIndex = 151,
+    kX86InstIdPshufb_ExtendedIndex = 151,
+    kX86InstIdPshufd_ExtendedIndex = 169,
+    kX86InstIdPshufhw_ExtendedIndex = 169,
+    kX86InstIdPshuflw_ExtendedIndex = 169,
+    kX86InstIdPshufw_ExtendedIndex = 170,
+    kX86InstIdPsignb_ExtendedIndex = 151,
+    kX86InstIdPsignd_ExtendedIndex = 151,
+    kX86InstIdPsignw_ExtendedIndex = 151,
+    kX86InstIdPslld_ExtendedIndex = 171,
+    kX86InstIdPslldq_ExtendedIndex = 172,
+    kX86InstIdPsllq_ExtendedIndex = 173,
+    kX86InstIdPsllw_ExtendedIndex = 174,
+    kX86InstIdPsrad_ExtendedIndex = 175,
+    kX86InstIdPsraw_ExtendedIndex = 176,
+    kX86InstIdPsrld_ExtendedIndex = 177,
+    kX86InstIdPsrldq_ExtendedIndex = 178,
+    kX86InstIdPsrlq_ExtendedIndex = 179,
+    kX86InstIdPsrlw_ExtendedIndex = 180,
+    kX86InstIdPsubb_ExtendedIndex = 151,
+    kX86InstIdPsubd_ExtendedIndex = 151,
+    kX86InstIdPsubq_ExtendedIndex = 151,
+    kX86InstIdPsubsb_ExtendedIndex = 151,
+    kX86InstIdPsubsw_ExtendedIndex = 151,
+    kX86InstIdPsubusb_ExtendedIndex = 151,
+    kX86InstIdPsubusw_ExtendedIndex = 151,
+    kX86InstIdPsubw_ExtendedIndex = 151,
+    kX86InstIdPswapd_ExtendedIndex = 159,
     kX86InstIdPtest_ExtendedIndex = 39,
-    kX86InstIdPunpckhbw_ExtendedIndex = 147,
-    kX86InstIdPunpckhdq_ExtendedIndex = 147,
+    kX86InstIdPunpckhbw_ExtendedIndex = 151,
+    kX86InstIdPunpckhdq_ExtendedIndex = 151,
     kX86InstIdPunpckhqdq_ExtendedIndex = 4,
-    kX86InstIdPunpckhwd_ExtendedIndex = 147,
-    kX86InstIdPunpcklbw_ExtendedIndex = 147,
-    kX86InstIdPunpckldq_ExtendedIndex = 147,
+    kX86InstIdPunpckhwd_ExtendedIndex = 151,
+    kX86InstIdPunpcklbw_ExtendedIndex = 151,
+    kX86InstIdPunpckldq_ExtendedIndex = 151,
     kX86InstIdPunpcklqdq_ExtendedIndex = 4,
-    kX86InstIdPunpcklwd_ExtendedIndex = 147,
-    kX86InstIdPush_ExtendedIndex = 178,
-    kX86InstIdPusha_ExtendedIndex = 98,
-    kX86InstIdPushf_ExtendedIndex = 179,
-    kX86InstIdPxor_ExtendedIndex = 147,
-    kX86InstIdRcl_ExtendedIndex = 180,
+    kX86InstIdPunpcklwd_ExtendedIndex = 151,
+    kX86InstIdPush_ExtendedIndex = 181,
+    kX86InstIdPusha_ExtendedIndex = 102,
+    kX86InstIdPushf_ExtendedIndex = 182,
+    kX86InstIdPxor_ExtendedIndex = 151,
+    kX86InstIdRcl_ExtendedIndex = 183,
     kX86InstIdRcpps_ExtendedIndex = 42,
     kX86InstIdRcpss_ExtendedIndex = 47,
-    kX86InstIdRcr_ExtendedIndex = 180,
-    kX86InstIdRdfsbase_ExtendedIndex = 181,
-    kX86InstIdRdgsbase_ExtendedIndex = 181,
-    kX86InstIdRdrand_ExtendedIndex = 182,
-    kX86InstIdRdseed_ExtendedIndex = 182,
-    kX86InstIdRdtsc_ExtendedIndex = 183,
-    kX86InstIdRdtscp_ExtendedIndex = 183,
-    kX86InstIdRepLodsB_ExtendedIndex = 184,
-    kX86InstIdRepLodsD_ExtendedIndex = 184,
-    kX86InstIdRepLodsQ_ExtendedIndex = 184,
-    kX86InstIdRepLodsW_ExtendedIndex = 184,
-    kX86InstIdRepMovsB_ExtendedIndex = 185,
-    kX86InstIdRepMovsD_ExtendedIndex = 185,
-    kX86InstIdRepMovsQ_ExtendedIndex = 185,
-    kX86InstIdRepMovsW_ExtendedIndex = 185,
-    kX86InstIdRepStosB_ExtendedIndex = 184,
-    kX86InstIdRepStosD_ExtendedIndex = 184,
-    kX86InstIdRepStosQ_ExtendedIndex = 184,
-    kX86InstIdRepStosW_ExtendedIndex = 184,
-    kX86InstIdRepeCmpsB_ExtendedIndex = 186,
-    kX86InstIdRepeCmpsD_ExtendedIndex = 186,
-    kX86InstIdRepeCmpsQ_ExtendedIndex = 186,
-    kX86InstIdRepeCmpsW_ExtendedIndex = 186,
-    kX86InstIdRepeScasB_ExtendedIndex = 186,
-    kX86InstIdRepeScasD_ExtendedIndex = 186,
-    kX86InstIdRepeScasQ_ExtendedIndex = 186,
-    kX86InstIdRepeScasW_ExtendedIndex = 186,
-    kX86InstIdRepneCmpsB_ExtendedIndex = 186,
-    kX86InstIdRepneCmpsD_ExtendedIndex = 186,
-    kX86InstIdRepneCmpsQ_ExtendedIndex = 186,
-    kX86InstIdRepneCmpsW_ExtendedIndex = 186,
-    kX86InstIdRepneScasB_ExtendedIndex = 186,
-    kX86InstIdRepneScasD_ExtendedIndex = 186,
-    kX86InstIdRepneScasQ_ExtendedIndex = 186,
-    kX86InstIdRepneScasW_ExtendedIndex = 186,
-    kX86InstIdRet_ExtendedIndex = 187,
-    kX86InstIdRol_ExtendedIndex = 188,
-    kX86InstIdRor_ExtendedIndex = 188,
-    kX86InstIdRorx_ExtendedIndex = 189,
-    kX86InstIdRoundpd_ExtendedIndex = 166,
-    kX86InstIdRoundps_ExtendedIndex = 166,
-    kX86InstIdRoundsd_ExtendedIndex = 190,
-    kX86InstIdRoundss_ExtendedIndex = 191,
+    kX86InstIdRcr_ExtendedIndex = 183,
+    kX86InstIdRdfsbase_ExtendedIndex = 184,
+    kX86InstIdRdgsbase_ExtendedIndex = 184,
+    kX86InstIdRdrand_ExtendedIndex = 185,
+    kX86InstIdRdseed_ExtendedIndex = 185,
+    kX86InstIdRdtsc_ExtendedIndex = 186,
+    kX86InstIdRdtscp_ExtendedIndex = 186,
+    kX86InstIdRepLodsB_ExtendedIndex = 187,
+    kX86InstIdRepLodsD_ExtendedIndex = 187,
+    kX86InstIdRepLodsQ_ExtendedIndex = 187,
+    kX86InstIdRepLodsW_ExtendedIndex = 187,
+    kX86InstIdRepMovsB_ExtendedIndex = 188,
+    kX86InstIdRepMovsD_ExtendedIndex = 188,
+    kX86InstIdRepMovsQ_ExtendedIndex = 188,
+    kX86InstIdRepMovsW_ExtendedIndex = 188,
+    kX86InstIdRepStosB_ExtendedIndex = 187,
+    kX86InstIdRepStosD_ExtendedIndex = 187,
+    kX86InstIdRepStosQ_ExtendedIndex = 187,
+    kX86InstIdRepStosW_ExtendedIndex = 187,
+    kX86InstIdRepeCmpsB_ExtendedIndex = 189,
+    kX86InstIdRepeCmpsD_ExtendedIndex = 189,
+    kX86InstIdRepeCmpsQ_ExtendedIndex = 189,
+    kX86InstIdRepeCmpsW_ExtendedIndex = 189,
+    kX86InstIdRepeScasB_ExtendedIndex = 189,
+    kX86InstIdRepeScasD_ExtendedIndex = 189,
+    kX86InstIdRepeScasQ_ExtendedIndex = 189,
+    kX86InstIdRepeScasW_ExtendedIndex = 189,
+    kX86InstIdRepneCmpsB_ExtendedIndex = 189,
+    kX86InstIdRepneCmpsD_ExtendedIndex = 189,
+    kX86InstIdRepneCmpsQ_ExtendedIndex = 189,
+    kX86InstIdRepneCmpsW_ExtendedIndex = 189,
+    kX86InstIdRepneScasB_ExtendedIndex = 189,
+    kX86InstIdRepneScasD_ExtendedIndex = 189,
+    kX86InstIdRepneScasQ_ExtendedIndex = 189,
+    kX86InstIdRepneScasW_ExtendedIndex = 189,
+    kX86InstIdRet_ExtendedIndex = 190,
+    kX86InstIdRol_ExtendedIndex = 191,
+    kX86InstIdRor_ExtendedIndex = 191,
+    kX86InstIdRorx_ExtendedIndex = 192,
+    kX86InstIdRoundpd_ExtendedIndex = 169,
+    kX86InstIdRoundps_ExtendedIndex = 169,
+    kX86InstIdRoundsd_ExtendedIndex = 193,
+    kX86InstIdRoundss_ExtendedIndex = 194,
     kX86InstIdRsqrtps_ExtendedIndex = 42,
     kX86InstIdRsqrtss_ExtendedIndex = 47,
-    kX86InstIdSahf_ExtendedIndex = 192,
-    kX86InstIdSal_ExtendedIndex = 193,
-    kX86InstIdSar_ExtendedIndex = 193,
-    kX86InstIdSarx_ExtendedIndex = 194,
+    kX86InstIdSahf_ExtendedIndex = 195,
+    kX86InstIdSal_ExtendedIndex = 196,
+    kX86InstIdSar_ExtendedIndex = 196,
+    kX86InstIdSarx_ExtendedIndex = 197,
     kX86InstIdSbb_ExtendedIndex = 1,
     kX86InstIdScasB_ExtendedIndex = 35,
     kX86InstIdScasD_ExtendedIndex = 35,
     kX86InstIdScasQ_ExtendedIndex = 35,
     kX86InstIdScasW_ExtendedIndex = 36,
-    kX86InstIdSeta_ExtendedIndex = 195,
-    kX86InstIdSetae_ExtendedIndex = 196,
-    kX86InstIdSetb_ExtendedIndex = 196,
-    kX86InstIdSetbe_ExtendedIndex = 195,
-    kX86InstIdSetc_ExtendedIndex = 196,
-    kX86InstIdSete_ExtendedIndex = 197,
-    kX86InstIdSetg_ExtendedIndex = 198,
-    kX86InstIdSetge_ExtendedIndex = 199,
-    kX86InstIdSetl_ExtendedIndex = 199,
-    kX86InstIdSetle_ExtendedIndex = 198,
-    kX86InstIdSetna_ExtendedIndex = 195,
-    kX86InstIdSetnae_ExtendedIndex = 196,
-    kX86InstIdSetnb_ExtendedIndex = 196,
-    kX86InstIdSetnbe_ExtendedIndex = 195,
-    kX86InstIdSetnc_ExtendedIndex = 196,
-    kX86InstIdSetne_ExtendedIndex = 197,
-    kX86InstIdSetng_ExtendedIndex = 198,
-    kX86InstIdSetnge_ExtendedIndex = 199,
-    kX86InstIdSetnl_ExtendedIndex = 199,
-    kX86InstIdSetnle_ExtendedIndex = 198,
-    kX86InstIdSetno_ExtendedIndex = 200,
-    kX86InstIdSetnp_ExtendedIndex = 201,
-    kX86InstIdSetns_ExtendedIndex = 202,
-    kX86InstIdSetnz_ExtendedIndex = 197,
-    kX86InstIdSeto_ExtendedIndex = 200,
-    kX86InstIdSetp_ExtendedIndex = 201,
-    kX86InstIdSetpe_ExtendedIndex = 201,
-    kX86InstIdSetpo_ExtendedIndex = 201,
-    kX86InstIdSets_ExtendedIndex = 202,
-    kX86InstIdSetz_ExtendedIndex = 197,
-    kX86InstIdSfence_ExtendedIndex = 99,
+    kX86InstIdSeta_ExtendedIndex = 198,
+    kX86InstIdSetae_ExtendedIndex = 199,
+    kX86InstIdSetb_ExtendedIndex = 199,
+    kX86InstIdSetbe_ExtendedIndex = 198,
+    kX86InstIdSetc_ExtendedIndex = 199,
+    kX86InstIdSete_ExtendedIndex = 200,
+    kX86InstIdSetg_ExtendedIndex = 201,
+    kX86InstIdSetge_ExtendedIndex = 202,
+    kX86InstIdSetl_ExtendedIndex = 202,
+    kX86InstIdSetle_ExtendedIndex = 201,
+    kX86InstIdSetna_ExtendedIndex = 198,
+    kX86InstIdSetnae_ExtendedIndex = 199,
+    kX86InstIdSetnb_ExtendedIndex = 199,
+    kX86InstIdSetnbe_ExtendedIndex = 198,
+    kX86InstIdSetnc_ExtendedIndex = 199,
+    kX86InstIdSetne_ExtendedIndex = 200,
+    kX86InstIdSetng_ExtendedIndex = 201,
+    kX86InstIdSetnge_ExtendedIndex = 202,
+    kX86InstIdSetnl_ExtendedIndex = 202,
+    kX86InstIdSetnle_ExtendedIndex = 201,
+    kX86InstIdSetno_ExtendedIndex = 203,
+    kX86InstIdSetnp_ExtendedIndex = 204,
+    kX86InstIdSetns_ExtendedIndex = 205,
+    kX86InstIdSetnz_ExtendedIndex = 200,
+    kX86InstIdSeto_ExtendedIndex = 203,
+    kX86InstIdSetp_ExtendedIndex = 204,
+    kX86InstIdSetpe_ExtendedIndex = 204,
+    kX86InstIdSetpo_ExtendedIndex = 204,
+    kX86InstIdSets_ExtendedIndex = 205,
+    kX86InstIdSetz_ExtendedIndex = 200,
+    kX86InstIdSfence_ExtendedIndex = 103,
     kX86InstIdSha1msg1_ExtendedIndex = 4,
     kX86InstIdSha1msg2_ExtendedIndex = 4,
     kX86InstIdSha1nexte_ExtendedIndex = 4,
@@ -1327,480 +1376,506 @@ enum X86InstData_ExtendedIndex {
     kX86InstIdSha256msg1_ExtendedIndex = 4,
     kX86InstIdSha256msg2_ExtendedIndex = 4,
     kX86InstIdSha256rnds2_ExtendedIndex = 4,
-    kX86InstIdShl_ExtendedIndex = 193,
-    kX86InstIdShld_ExtendedIndex = 203,
-    kX86InstIdShlx_ExtendedIndex = 194,
-    kX86InstIdShr_ExtendedIndex = 193,
-    kX86InstIdShrd_ExtendedIndex = 204,
-    kX86InstIdShrx_ExtendedIndex = 194,
+    kX86InstIdShl_ExtendedIndex = 196,
+    kX86InstIdShld_ExtendedIndex = 206,
+    kX86InstIdShlx_ExtendedIndex = 197,
+    kX86InstIdShr_ExtendedIndex = 196,
+    kX86InstIdShrd_ExtendedIndex = 206,
+    kX86InstIdShrx_ExtendedIndex = 197,
     kX86InstIdShufpd_ExtendedIndex = 11,
     kX86InstIdShufps_ExtendedIndex = 11,
     kX86InstIdSqrtpd_ExtendedIndex = 42,
     kX86InstIdSqrtps_ExtendedIndex = 42,
     kX86InstIdSqrtsd_ExtendedIndex = 50,
     kX86InstIdSqrtss_ExtendedIndex = 47,
-    kX86InstIdStc_ExtendedIndex = 205,
-    kX86InstIdStd_ExtendedIndex = 206,
-    kX86InstIdStmxcsr_ExtendedIndex = 207,
-    kX86InstIdStosB_ExtendedIndex = 208,
-    kX86InstIdStosD_ExtendedIndex = 208,
-    kX86InstIdStosQ_ExtendedIndex = 208,
-    kX86InstIdStosW_ExtendedIndex = 209,
+    kX86InstIdStc_ExtendedIndex = 207,
+    kX86InstIdStd_ExtendedIndex = 208,
+    kX86InstIdStmxcsr_ExtendedIndex = 209,
+    kX86InstIdStosB_ExtendedIndex = 210,
+    kX86InstIdStosD_ExtendedIndex = 210,
+    kX86InstIdStosQ_ExtendedIndex = 210,
+    kX86InstIdStosW_ExtendedIndex = 211,
     kX86InstIdSub_ExtendedIndex = 3,
     kX86InstIdSubpd_ExtendedIndex = 4,
     kX86InstIdSubps_ExtendedIndex = 4,
     kX86InstIdSubsd_ExtendedIndex = 4,
     kX86InstIdSubss_ExtendedIndex = 4,
     kX86InstIdT1mskc_ExtendedIndex = 10,
-    kX86InstIdTest_ExtendedIndex = 210,
-    kX86InstIdTzcnt_ExtendedIndex = 162,
+    kX86InstIdTest_ExtendedIndex = 212,
+    kX86InstIdTzcnt_ExtendedIndex = 165,
     kX86InstIdTzmsk_ExtendedIndex = 10,
     kX86InstIdUcomisd_ExtendedIndex = 39,
     kX86InstIdUcomiss_ExtendedIndex = 39,
-    kX86InstIdUd2_ExtendedIndex = 145,
+    kX86InstIdUd2_ExtendedIndex = 149,
     kX86InstIdUnpckhpd_ExtendedIndex = 4,
     kX86InstIdUnpckhps_ExtendedIndex = 4,
     kX86InstIdUnpcklpd_ExtendedIndex = 4,
     kX86InstIdUnpcklps_ExtendedIndex = 4,
-    kX86InstIdVaddpd_ExtendedIndex = 211,
-    kX86InstIdVaddps_ExtendedIndex = 211,
-    kX86InstIdVaddsd_ExtendedIndex = 212,
-    kX86InstIdVaddss_ExtendedIndex = 212,
-    kX86InstIdVaddsubpd_ExtendedIndex = 211,
-    kX86InstIdVaddsubps_ExtendedIndex = 211,
-    kX86InstIdVaesdec_ExtendedIndex = 212,
-    kX86InstIdVaesdeclast_ExtendedIndex = 212,
-    kX86InstIdVaesenc_ExtendedIndex = 212,
-    kX86InstIdVaesenclast_ExtendedIndex = 212,
-    kX86InstIdVaesimc_ExtendedIndex = 213,
-    kX86InstIdVaeskeygenassist_ExtendedIndex = 214,
-    kX86InstIdVandnpd_ExtendedIndex = 211,
-    kX86InstIdVandnps_ExtendedIndex = 211,
-    kX86InstIdVandpd_ExtendedIndex = 211,
-    kX86InstIdVandps_ExtendedIndex = 211,
-    kX86InstIdVblendpd_ExtendedIndex = 215,
-    kX86InstIdVblendps_ExtendedIndex = 215,
-    kX86InstIdVblendvpd_ExtendedIndex = 216,
-    kX86InstIdVblendvps_ExtendedIndex = 216,
-    kX86InstIdVbroadcastf128_ExtendedIndex = 217,
-    kX86InstIdVbroadcasti128_ExtendedIndex = 217,
-    kX86InstIdVbroadcastsd_ExtendedIndex = 218,
-    kX86InstIdVbroadcastss_ExtendedIndex = 219,
-    kX86InstIdVcmppd_ExtendedIndex = 215,
-    kX86InstIdVcmpps_ExtendedIndex = 215,
-    kX86InstIdVcmpsd_ExtendedIndex = 220,
-    kX86InstIdVcmpss_ExtendedIndex = 220,
-    kX86InstIdVcomisd_ExtendedIndex = 221,
-    kX86InstIdVcomiss_ExtendedIndex = 221,
-    kX86InstIdVcvtdq2pd_ExtendedIndex = 219,
-    kX86InstIdVcvtdq2ps_ExtendedIndex = 222,
-    kX86InstIdVcvtpd2dq_ExtendedIndex = 223,
-    kX86InstIdVcvtpd2ps_ExtendedIndex = 223,
-    kX86InstIdVcvtph2ps_ExtendedIndex = 219,
-    kX86InstIdVcvtps2dq_ExtendedIndex = 222,
-    kX86InstIdVcvtps2pd_ExtendedIndex = 219,
-    kX86InstIdVcvtps2ph_ExtendedIndex = 224,
-    kX86InstIdVcvtsd2si_ExtendedIndex = 225,
-    kX86InstIdVcvtsd2ss_ExtendedIndex = 212,
-    kX86InstIdVcvtsi2sd_ExtendedIndex = 226,
-    kX86InstIdVcvtsi2ss_ExtendedIndex = 226,
-    kX86InstIdVcvtss2sd_ExtendedIndex = 212,
-    kX86InstIdVcvtss2si_ExtendedIndex = 225,
-    kX86InstIdVcvttpd2dq_ExtendedIndex = 227,
-    kX86InstIdVcvttps2dq_ExtendedIndex = 222,
-    kX86InstIdVcvttsd2si_ExtendedIndex = 225,
-    kX86InstIdVcvttss2si_ExtendedIndex = 225,
-    kX86InstIdVdivpd_ExtendedIndex = 211,
-    kX86InstIdVdivps_ExtendedIndex = 211,
-    kX86InstIdVdivsd_ExtendedIndex = 212,
-    kX86InstIdVdivss_ExtendedIndex = 212,
-    kX86InstIdVdppd_ExtendedIndex = 220,
-    kX86InstIdVdpps_ExtendedIndex = 215,
-    kX86InstIdVextractf128_ExtendedIndex = 228,
-    kX86InstIdVextracti128_ExtendedIndex = 228,
-    kX86InstIdVextractps_ExtendedIndex = 229,
-    kX86InstIdVfmadd132pd_ExtendedIndex = 230,
-    kX86InstIdVfmadd132ps_ExtendedIndex = 230,
-    kX86InstIdVfmadd132sd_ExtendedIndex = 231,
-    kX86InstIdVfmadd132ss_ExtendedIndex = 231,
-    kX86InstIdVfmadd213pd_ExtendedIndex = 230,
-    kX86InstIdVfmadd213ps_ExtendedIndex = 230,
-    kX86InstIdVfmadd213sd_ExtendedIndex = 231,
-    kX86InstIdVfmadd213ss_ExtendedIndex = 231,
-    kX86InstIdVfmadd231pd_ExtendedIndex = 230,
-    kX86InstIdVfmadd231ps_ExtendedIndex = 230,
-    kX86InstIdVfmadd231sd_ExtendedIndex = 231,
-    kX86InstIdVfmadd231ss_ExtendedIndex = 231,
-    kX86InstIdVfmaddpd_ExtendedIndex = 232,
-    kX86InstIdVfmaddps_ExtendedIndex = 232,
-    kX86InstIdVfmaddsd_ExtendedIndex = 233,
-    kX86InstIdVfmaddss_ExtendedIndex = 233,
-    kX86InstIdVfmaddsub132pd_ExtendedIndex = 230,
-    kX86InstIdVfmaddsub132ps_ExtendedIndex = 230,
-    kX86InstIdVfmaddsub213pd_ExtendedIndex = 230,
-    kX86InstIdVfmaddsub213ps_ExtendedIndex = 230,
-    kX86InstIdVfmaddsub231pd_ExtendedIndex = 230,
-    kX86InstIdVfmaddsub231ps_ExtendedIndex = 230,
-    kX86InstIdVfmaddsubpd_ExtendedIndex = 232,
-    kX86InstIdVfmaddsubps_ExtendedIndex = 232,
-    kX86InstIdVfmsub132pd_ExtendedIndex = 230,
-    kX86InstIdVfmsub132ps_ExtendedIndex = 230,
-    kX86InstIdVfmsub132sd_ExtendedIndex = 231,
-    kX86InstIdVfmsub132ss_ExtendedIndex = 231,
-    kX86InstIdVfmsub213pd_ExtendedIndex = 230,
-    kX86InstIdVfmsub213ps_ExtendedIndex = 230,
-    kX86InstIdVfmsub213sd_ExtendedIndex = 231,
-    kX86InstIdVfmsub213ss_ExtendedIndex = 231,
-    kX86InstIdVfmsub231pd_ExtendedIndex = 230,
-    kX86InstIdVfmsub231ps_ExtendedIndex = 230,
-    kX86InstIdVfmsub231sd_ExtendedIndex = 231,
-    kX86InstIdVfmsub231ss_ExtendedIndex = 231,
-    kX86InstIdVfmsubadd132pd_ExtendedIndex = 230,
-    kX86InstIdVfmsubadd132ps_ExtendedIndex = 230,
-    kX86InstIdVfmsubadd213pd_ExtendedIndex = 230,
-    kX86InstIdVfmsubadd213ps_ExtendedIndex = 230,
-    kX86InstIdVfmsubadd231pd_ExtendedIndex = 230,
-    kX86InstIdVfmsubadd231ps_ExtendedIndex = 230,
-    kX86InstIdVfmsubaddpd_ExtendedIndex = 232,
-    kX86InstIdVfmsubaddps_ExtendedIndex = 232,
-    kX86InstIdVfmsubpd_ExtendedIndex = 232,
-    kX86InstIdVfmsubps_ExtendedIndex = 232,
-    kX86InstIdVfmsubsd_ExtendedIndex = 233,
-    kX86InstIdVfmsubss_ExtendedIndex = 233,
-    kX86InstIdVfnmadd132pd_ExtendedIndex = 230,
-    kX86InstIdVfnmadd132ps_ExtendedIndex = 230,
-    kX86InstIdVfnmadd132sd_ExtendedIndex = 231,
-    kX86InstIdVfnmadd132ss_ExtendedIndex = 231,
-    kX86InstIdVfnmadd213pd_ExtendedIndex = 230,
-    kX86InstIdVfnmadd213ps_ExtendedIndex = 230,
-    kX86InstIdVfnmadd213sd_ExtendedIndex = 231,
-    kX86InstIdVfnmadd213ss_ExtendedIndex = 231,
-    kX86InstIdVfnmadd231pd_ExtendedIndex = 230,
-    kX86InstIdVfnmadd231ps_ExtendedIndex = 230,
-    kX86InstIdVfnmadd231sd_ExtendedIndex = 231,
-    kX86InstIdVfnmadd231ss_ExtendedIndex = 231,
-    kX86InstIdVfnmaddpd_ExtendedIndex = 232,
-    kX86InstIdVfnmaddps_ExtendedIndex = 232,
-    kX86InstIdVfnmaddsd_ExtendedIndex = 233,
-    kX86InstIdVfnmaddss_ExtendedIndex = 233,
-    kX86InstIdVfnmsub132pd_ExtendedIndex = 230,
-    kX86InstIdVfnmsub132ps_ExtendedIndex = 230,
-    kX86InstIdVfnmsub132sd_ExtendedIndex = 231,
-    kX86InstIdVfnmsub132ss_ExtendedIndex = 231,
-    kX86InstIdVfnmsub213pd_ExtendedIndex = 230,
-    kX86InstIdVfnmsub213ps_ExtendedIndex = 230,
-    kX86InstIdVfnmsub213sd_ExtendedIndex = 231,
-    kX86InstIdVfnmsub213ss_ExtendedIndex = 231,
-    kX86InstIdVfnmsub231pd_ExtendedIndex = 230,
-    kX86InstIdVfnmsub231ps_ExtendedIndex = 230,
-    kX86InstIdVfnmsub231sd_ExtendedIndex = 231,
-    kX86InstIdVfnmsub231ss_ExtendedIndex = 231,
-    kX86InstIdVfnmsubpd_ExtendedIndex = 232,
-    kX86InstIdVfnmsubps_ExtendedIndex = 232,
-    kX86InstIdVfnmsubsd_ExtendedIndex = 233,
-    kX86InstIdVfnmsubss_ExtendedIndex = 233,
-    kX86InstIdVfrczpd_ExtendedIndex = 234,
-    kX86InstIdVfrczps_ExtendedIndex = 234,
-    kX86InstIdVfrczsd_ExtendedIndex = 235,
-    kX86InstIdVfrczss_ExtendedIndex = 235,
-    kX86InstIdVgatherdpd_ExtendedIndex = 236,
-    kX86InstIdVgatherdps_ExtendedIndex = 236,
-    kX86InstIdVgatherqpd_ExtendedIndex = 236,
-    kX86InstIdVgatherqps_ExtendedIndex = 237,
-    kX86InstIdVhaddpd_ExtendedIndex = 211,
-    kX86InstIdVhaddps_ExtendedIndex = 211,
-    kX86InstIdVhsubpd_ExtendedIndex = 211,
-    kX86InstIdVhsubps_ExtendedIndex = 211,
-    kX86InstIdVinsertf128_ExtendedIndex = 238,
-    kX86InstIdVinserti128_ExtendedIndex = 238,
-    kX86InstIdVinsertps_ExtendedIndex = 220,
-    kX86InstIdVlddqu_ExtendedIndex = 239,
-    kX86InstIdVldmxcsr_ExtendedIndex = 240,
-    kX86InstIdVmaskmovdqu_ExtendedIndex = 241,
-    kX86InstIdVmaskmovpd_ExtendedIndex = 242,
-    kX86InstIdVmaskmovps_ExtendedIndex = 243,
-    kX86InstIdVmaxpd_ExtendedIndex = 211,
-    kX86InstIdVmaxps_ExtendedIndex = 211,
-    kX86InstIdVmaxsd_ExtendedIndex = 211,
-    kX86InstIdVmaxss_ExtendedIndex = 211,
-    kX86InstIdVminpd_ExtendedIndex = 211,
-    kX86InstIdVminps_ExtendedIndex = 211,
-    kX86InstIdVminsd_ExtendedIndex = 211,
-    kX86InstIdVminss_ExtendedIndex = 211,
-    kX86InstIdVmovapd_ExtendedIndex = 244,
-    kX86InstIdVmovaps_ExtendedIndex = 245,
-    kX86InstIdVmovd_ExtendedIndex = 246,
-    kX86InstIdVmovddup_ExtendedIndex = 222,
-    kX86InstIdVmovdqa_ExtendedIndex = 247,
-    kX86InstIdVmovdqu_ExtendedIndex = 248,
-    kX86InstIdVmovhlps_ExtendedIndex = 249,
-    kX86InstIdVmovhpd_ExtendedIndex = 250,
-    kX86InstIdVmovhps_ExtendedIndex = 251,
-    kX86InstIdVmovlhps_ExtendedIndex = 249,
-    kX86InstIdVmovlpd_ExtendedIndex = 252,
-    kX86InstIdVmovlps_ExtendedIndex = 253,
-    kX86InstIdVmovmskpd_ExtendedIndex = 254,
-    kX86InstIdVmovmskps_ExtendedIndex = 254,
-    kX86InstIdVmovntdq_ExtendedIndex = 255,
-    kX86InstIdVmovntdqa_ExtendedIndex = 239,
-    kX86InstIdVmovntpd_ExtendedIndex = 255,
-    kX86InstIdVmovntps_ExtendedIndex = 255,
-    kX86InstIdVmovq_ExtendedIndex = 246,
-    kX86InstIdVmovsd_ExtendedIndex = 256,
-    kX86InstIdVmovshdup_ExtendedIndex = 222,
-    kX86InstIdVmovsldup_ExtendedIndex = 222,
-    kX86InstIdVmovss_ExtendedIndex = 257,
-    kX86InstIdVmovupd_ExtendedIndex = 258,
-    kX86InstIdVmovups_ExtendedIndex = 259,
-    kX86InstIdVmpsadbw_ExtendedIndex = 215,
-    kX86InstIdVmulpd_ExtendedIndex = 211,
-    kX86InstIdVmulps_ExtendedIndex = 211,
-    kX86InstIdVmulsd_ExtendedIndex = 211,
-    kX86InstIdVmulss_ExtendedIndex = 211,
-    kX86InstIdVorpd_ExtendedIndex = 211,
-    kX86InstIdVorps_ExtendedIndex = 211,
-    kX86InstIdVpabsb_ExtendedIndex = 222,
-    kX86InstIdVpabsd_ExtendedIndex = 222,
-    kX86InstIdVpabsw_ExtendedIndex = 222,
-    kX86InstIdVpackssdw_ExtendedIndex = 211,
-    kX86InstIdVpacksswb_ExtendedIndex = 211,
-    kX86InstIdVpackusdw_ExtendedIndex = 211,
-    kX86InstIdVpackuswb_ExtendedIndex = 211,
-    kX86InstIdVpaddb_ExtendedIndex = 211,
-    kX86InstIdVpaddd_ExtendedIndex = 211,
-    kX86InstIdVpaddq_ExtendedIndex = 211,
-    kX86InstIdVpaddsb_ExtendedIndex = 211,
-    kX86InstIdVpaddsw_ExtendedIndex = 211,
-    kX86InstIdVpaddusb_ExtendedIndex = 211,
-    kX86InstIdVpaddusw_ExtendedIndex = 211,
-    kX86InstIdVpaddw_ExtendedIndex = 211,
-    kX86InstIdVpalignr_ExtendedIndex = 215,
-    kX86InstIdVpand_ExtendedIndex = 211,
-    kX86InstIdVpandn_ExtendedIndex = 211,
-    kX86InstIdVpavgb_ExtendedIndex = 211,
-    kX86InstIdVpavgw_ExtendedIndex = 211,
-    kX86InstIdVpblendd_ExtendedIndex = 215,
-    kX86InstIdVpblendvb_ExtendedIndex = 260,
-    kX86InstIdVpblendw_ExtendedIndex = 215,
-    kX86InstIdVpbroadcastb_ExtendedIndex = 219,
-    kX86InstIdVpbroadcastd_ExtendedIndex = 219,
-    kX86InstIdVpbroadcastq_ExtendedIndex = 219,
-    kX86InstIdVpbroadcastw_ExtendedIndex = 219,
-    kX86InstIdVpclmulqdq_ExtendedIndex = 220,
-    kX86InstIdVpcmov_ExtendedIndex = 261,
-    kX86InstIdVpcmpeqb_ExtendedIndex = 211,
-    kX86InstIdVpcmpeqd_ExtendedIndex = 211,
-    kX86InstIdVpcmpeqq_ExtendedIndex = 211,
-    kX86InstIdVpcmpeqw_ExtendedIndex = 211,
-    kX86InstIdVpcmpestri_ExtendedIndex = 262,
-    kX86InstIdVpcmpestrm_ExtendedIndex = 262,
-    kX86InstIdVpcmpgtb_ExtendedIndex = 211,
-    kX86InstIdVpcmpgtd_ExtendedIndex = 211,
-    kX86InstIdVpcmpgtq_ExtendedIndex = 211,
-    kX86InstIdVpcmpgtw_ExtendedIndex = 211,
-    kX86InstIdVpcmpistri_ExtendedIndex = 262,
-    kX86InstIdVpcmpistrm_ExtendedIndex = 262,
-    kX86InstIdVpcomb_ExtendedIndex = 263,
-    kX86InstIdVpcomd_ExtendedIndex = 263,
-    kX86InstIdVpcomq_ExtendedIndex = 263,
-    kX86InstIdVpcomub_ExtendedIndex = 263,
-    kX86InstIdVpcomud_ExtendedIndex = 263,
-    kX86InstIdVpcomuq_ExtendedIndex = 263,
-    kX86InstIdVpcomuw_ExtendedIndex = 263,
-    kX86InstIdVpcomw_ExtendedIndex = 263,
-    kX86InstIdVperm2f128_ExtendedIndex = 264,
-    kX86InstIdVperm2i128_ExtendedIndex = 264,
-    kX86InstIdVpermd_ExtendedIndex = 265,
-    kX86InstIdVpermil2pd_ExtendedIndex = 266,
-    kX86InstIdVpermil2ps_ExtendedIndex = 266,
-    kX86InstIdVpermilpd_ExtendedIndex = 267,
-    kX86InstIdVpermilps_ExtendedIndex = 268,
-    kX86InstIdVpermpd_ExtendedIndex = 269,
-    kX86InstIdVpermps_ExtendedIndex = 265,
-    kX86InstIdVpermq_ExtendedIndex = 269,
-    kX86InstIdVpextrb_ExtendedIndex = 270,
-    kX86InstIdVpextrd_ExtendedIndex = 229,
-    kX86InstIdVpextrq_ExtendedIndex = 271,
-    kX86InstIdVpextrw_ExtendedIndex = 272,
-    kX86InstIdVpgatherdd_ExtendedIndex = 236,
-    kX86InstIdVpgatherdq_ExtendedIndex = 236,
-    kX86InstIdVpgatherqd_ExtendedIndex = 237,
-    kX86InstIdVpgatherqq_ExtendedIndex = 236,
-    kX86InstIdVphaddbd_ExtendedIndex = 235,
-    kX86InstIdVphaddbq_ExtendedIndex = 235,
-    kX86InstIdVphaddbw_ExtendedIndex = 235,
-    kX86InstIdVphaddd_ExtendedIndex = 211,
-    kX86InstIdVphadddq_ExtendedIndex = 235,
-    kX86InstIdVphaddsw_ExtendedIndex = 211,
-    kX86InstIdVphaddubd_ExtendedIndex = 235,
-    kX86InstIdVphaddubq_ExtendedIndex = 235,
-    kX86InstIdVphaddubw_ExtendedIndex = 235,
-    kX86InstIdVphaddudq_ExtendedIndex = 235,
-    kX86InstIdVphadduwd_ExtendedIndex = 235,
-    kX86InstIdVphadduwq_ExtendedIndex = 235,
-    kX86InstIdVphaddw_ExtendedIndex = 211,
-    kX86InstIdVphaddwd_ExtendedIndex = 235,
-    kX86InstIdVphaddwq_ExtendedIndex = 235,
-    kX86InstIdVphminposuw_ExtendedIndex = 213,
-    kX86InstIdVphsubbw_ExtendedIndex = 235,
-    kX86InstIdVphsubd_ExtendedIndex = 211,
-    kX86InstIdVphsubdq_ExtendedIndex = 235,
-    kX86InstIdVphsubsw_ExtendedIndex = 211,
-    kX86InstIdVphsubw_ExtendedIndex = 211,
-    kX86InstIdVphsubwd_ExtendedIndex = 235,
-    kX86InstIdVpinsrb_ExtendedIndex = 273,
-    kX86InstIdVpinsrd_ExtendedIndex = 274,
-    kX86InstIdVpinsrq_ExtendedIndex = 275,
-    kX86InstIdVpinsrw_ExtendedIndex = 276,
-    kX86InstIdVpmacsdd_ExtendedIndex = 277,
-    kX86InstIdVpmacsdqh_ExtendedIndex = 277,
-    kX86InstIdVpmacsdql_ExtendedIndex = 277,
-    kX86InstIdVpmacssdd_ExtendedIndex = 277,
-    kX86InstIdVpmacssdqh_ExtendedIndex = 277,
-    kX86InstIdVpmacssdql_ExtendedIndex = 277,
-    kX86InstIdVpmacsswd_ExtendedIndex = 277,
-    kX86InstIdVpmacssww_ExtendedIndex = 277,
-    kX86InstIdVpmacswd_ExtendedIndex = 277,
-    kX86InstIdVpmacsww_ExtendedIndex = 277,
-    kX86InstIdVpmadcsswd_ExtendedIndex = 277,
-    kX86InstIdVpmadcswd_ExtendedIndex = 277,
-    kX86InstIdVpmaddubsw_ExtendedIndex = 211,
-    kX86InstIdVpmaddwd_ExtendedIndex = 211,
-    kX86InstIdVpmaskmovd_ExtendedIndex = 278,
-    kX86InstIdVpmaskmovq_ExtendedIndex = 278,
-    kX86InstIdVpmaxsb_ExtendedIndex = 211,
-    kX86InstIdVpmaxsd_ExtendedIndex = 211,
-    kX86InstIdVpmaxsw_ExtendedIndex = 211,
-    kX86InstIdVpmaxub_ExtendedIndex = 211,
-    kX86InstIdVpmaxud_ExtendedIndex = 211,
-    kX86InstIdVpmaxuw_ExtendedIndex = 211,
-    kX86InstIdVpminsb_ExtendedIndex = 211,
-    kX86InstIdVpminsd_ExtendedIndex = 211,
-    kX86InstIdVpminsw_ExtendedIndex = 211,
-    kX86InstIdVpminub_ExtendedIndex = 211,
-    kX86InstIdVpminud_ExtendedIndex = 211,
-    kX86InstIdVpminuw_ExtendedIndex = 211,
-    kX86InstIdVpmovmskb_ExtendedIndex = 254,
-    kX86InstIdVpmovsxbd_ExtendedIndex = 222,
-    kX86InstIdVpmovsxbq_ExtendedIndex = 222,
-    kX86InstIdVpmovsxbw_ExtendedIndex = 222,
-    kX86InstIdVpmovsxdq_ExtendedIndex = 222,
-    kX86InstIdVpmovsxwd_ExtendedIndex = 222,
-    kX86InstIdVpmovsxwq_ExtendedIndex = 222,
-    kX86InstIdVpmovzxbd_ExtendedIndex = 222,
-    kX86InstIdVpmovzxbq_ExtendedIndex = 222,
-    kX86InstIdVpmovzxbw_ExtendedIndex = 222,
-    kX86InstIdVpmovzxdq_ExtendedIndex = 222,
-    kX86InstIdVpmovzxwd_ExtendedIndex = 222,
-    kX86InstIdVpmovzxwq_ExtendedIndex = 222,
-    kX86InstIdVpmuldq_ExtendedIndex = 211,
-    kX86InstIdVpmulhrsw_ExtendedIndex = 211,
-    kX86InstIdVpmulhuw_ExtendedIndex = 211,
-    kX86InstIdVpmulhw_ExtendedIndex = 211,
-    kX86InstIdVpmulld_ExtendedIndex = 211,
-    kX86InstIdVpmullw_ExtendedIndex = 211,
-    kX86InstIdVpmuludq_ExtendedIndex = 211,
-    kX86InstIdVpor_ExtendedIndex = 211,
-    kX86InstIdVpperm_ExtendedIndex = 279,
-    kX86InstIdVprotb_ExtendedIndex = 280,
-    kX86InstIdVprotd_ExtendedIndex = 281,
-    kX86InstIdVprotq_ExtendedIndex = 282,
-    kX86InstIdVprotw_ExtendedIndex = 283,
-    kX86InstIdVpsadbw_ExtendedIndex = 211,
-    kX86InstIdVpshab_ExtendedIndex = 284,
-    kX86InstIdVpshad_ExtendedIndex = 284,
-    kX86InstIdVpshaq_ExtendedIndex = 284,
-    kX86InstIdVpshaw_ExtendedIndex = 284,
-    kX86InstIdVpshlb_ExtendedIndex = 284,
-    kX86InstIdVpshld_ExtendedIndex = 284,
-    kX86InstIdVpshlq_ExtendedIndex = 284,
-    kX86InstIdVpshlw_ExtendedIndex = 284,
-    kX86InstIdVpshufb_ExtendedIndex = 211,
-    kX86InstIdVpshufd_ExtendedIndex = 285,
-    kX86InstIdVpshufhw_ExtendedIndex = 285,
-    kX86InstIdVpshuflw_ExtendedIndex = 285,
-    kX86InstIdVpsignb_ExtendedIndex = 211,
-    kX86InstIdVpsignd_ExtendedIndex = 211,
-    kX86InstIdVpsignw_ExtendedIndex = 211,
-    kX86InstIdVpslld_ExtendedIndex = 286,
-    kX86InstIdVpslldq_ExtendedIndex = 287,
-    kX86InstIdVpsllq_ExtendedIndex = 288,
-    kX86InstIdVpsllvd_ExtendedIndex = 211,
-    kX86InstIdVpsllvq_ExtendedIndex = 211,
-    kX86InstIdVpsllw_ExtendedIndex = 289,
-    kX86InstIdVpsrad_ExtendedIndex = 290,
-    kX86InstIdVpsravd_ExtendedIndex = 211,
-    kX86InstIdVpsraw_ExtendedIndex = 291,
-    kX86InstIdVpsrld_ExtendedIndex = 292,
-    kX86InstIdVpsrldq_ExtendedIndex = 287,
-    kX86InstIdVpsrlq_ExtendedIndex = 293,
-    kX86InstIdVpsrlvd_ExtendedIndex = 211,
-    kX86InstIdVpsrlvq_ExtendedIndex = 211,
-    kX86InstIdVpsrlw_ExtendedIndex = 294,
-    kX86InstIdVpsubb_ExtendedIndex = 211,
-    kX86InstIdVpsubd_ExtendedIndex = 211,
-    kX86InstIdVpsubq_ExtendedIndex = 211,
-    kX86InstIdVpsubsb_ExtendedIndex = 211,
-    kX86InstIdVpsubsw_ExtendedIndex = 211,
-    kX86InstIdVpsubusb_ExtendedIndex = 211,
-    kX86InstIdVpsubusw_ExtendedIndex = 211,
-    kX86InstIdVpsubw_ExtendedIndex = 211,
-    kX86InstIdVptest_ExtendedIndex = 295,
-    kX86InstIdVpunpckhbw_ExtendedIndex = 211,
-    kX86InstIdVpunpckhdq_ExtendedIndex = 211,
-    kX86InstIdVpunpckhqdq_ExtendedIndex = 211,
-    kX86InstIdVpunpckhwd_ExtendedIndex = 211,
-    kX86InstIdVpunpcklbw_ExtendedIndex = 211,
-    kX86InstIdVpunpckldq_ExtendedIndex = 211,
-    kX86InstIdVpunpcklqdq_ExtendedIndex = 211,
-    kX86InstIdVpunpcklwd_ExtendedIndex = 211,
-    kX86InstIdVpxor_ExtendedIndex = 211,
-    kX86InstIdVrcpps_ExtendedIndex = 222,
-    kX86InstIdVrcpss_ExtendedIndex = 212,
-    kX86InstIdVroundpd_ExtendedIndex = 285,
-    kX86InstIdVroundps_ExtendedIndex = 285,
-    kX86InstIdVroundsd_ExtendedIndex = 220,
-    kX86InstIdVroundss_ExtendedIndex = 220,
-    kX86InstIdVrsqrtps_ExtendedIndex = 222,
-    kX86InstIdVrsqrtss_ExtendedIndex = 212,
-    kX86InstIdVshufpd_ExtendedIndex = 215,
-    kX86InstIdVshufps_ExtendedIndex = 215,
-    kX86InstIdVsqrtpd_ExtendedIndex = 222,
-    kX86InstIdVsqrtps_ExtendedIndex = 222,
-    kX86InstIdVsqrtsd_ExtendedIndex = 212,
-    kX86InstIdVsqrtss_ExtendedIndex = 212,
-    kX86InstIdVstmxcsr_ExtendedIndex = 296,
-    kX86InstIdVsubpd_ExtendedIndex = 211,
-    kX86InstIdVsubps_ExtendedIndex = 211,
-    kX86InstIdVsubsd_ExtendedIndex = 212,
-    kX86InstIdVsubss_ExtendedIndex = 212,
-    kX86InstIdVtestpd_ExtendedIndex = 295,
-    kX86InstIdVtestps_ExtendedIndex = 295,
-    kX86InstIdVucomisd_ExtendedIndex = 221,
-    kX86InstIdVucomiss_ExtendedIndex = 221,
-    kX86InstIdVunpckhpd_ExtendedIndex = 211,
-    kX86InstIdVunpckhps_ExtendedIndex = 211,
-    kX86InstIdVunpcklpd_ExtendedIndex = 211,
-    kX86InstIdVunpcklps_ExtendedIndex = 211,
-    kX86InstIdVxorpd_ExtendedIndex = 211,
-    kX86InstIdVxorps_ExtendedIndex = 211,
-    kX86InstIdVzeroall_ExtendedIndex = 297,
-    kX86InstIdVzeroupper_ExtendedIndex = 297,
-    kX86InstIdWrfsbase_ExtendedIndex = 298,
-    kX86InstIdWrgsbase_ExtendedIndex = 298,
-    kX86InstIdXadd_ExtendedIndex = 299,
-    kX86InstIdXchg_ExtendedIndex = 300,
-    kX86InstIdXgetbv_ExtendedIndex = 135,
+    kX86InstIdVaddpd_ExtendedIndex = 213,
+    kX86InstIdVaddps_ExtendedIndex = 213,
+    kX86InstIdVaddsd_ExtendedIndex = 214,
+    kX86InstIdVaddss_ExtendedIndex = 214,
+    kX86InstIdVaddsubpd_ExtendedIndex = 215,
+    kX86InstIdVaddsubps_ExtendedIndex = 215,
+    kX86InstIdVaesdec_ExtendedIndex = 214,
+    kX86InstIdVaesdeclast_ExtendedIndex = 214,
+    kX86InstIdVaesenc_ExtendedIndex = 214,
+    kX86InstIdVaesenclast_ExtendedIndex = 214,
+    kX86InstIdVaesimc_ExtendedIndex = 216,
+    kX86InstIdVaeskeygenassist_ExtendedIndex = 217,
+    kX86InstIdVandnpd_ExtendedIndex = 215,
+    kX86InstIdVandnps_ExtendedIndex = 215,
+    kX86InstIdVandpd_ExtendedIndex = 215,
+    kX86InstIdVandps_ExtendedIndex = 215,
+    kX86InstIdVblendpd_ExtendedIndex = 218,
+    kX86InstIdVblendps_ExtendedIndex = 218,
+    kX86InstIdVblendvpd_ExtendedIndex = 219,
+    kX86InstIdVblendvps_ExtendedIndex = 219,
+    kX86InstIdVbroadcastf128_ExtendedIndex = 220,
+    kX86InstIdVbroadcasti128_ExtendedIndex = 220,
+    kX86InstIdVbroadcastsd_ExtendedIndex = 221,
+    kX86InstIdVbroadcastss_ExtendedIndex = 222,
+    kX86InstIdVcmppd_ExtendedIndex = 218,
+    kX86InstIdVcmpps_ExtendedIndex = 218,
+    kX86InstIdVcmpsd_ExtendedIndex = 223,
+    kX86InstIdVcmpss_ExtendedIndex = 223,
+    kX86InstIdVcomisd_ExtendedIndex = 224,
+    kX86InstIdVcomiss_ExtendedIndex = 224,
+    kX86InstIdVcvtdq2pd_ExtendedIndex = 225,
+    kX86InstIdVcvtdq2ps_ExtendedIndex = 226,
+    kX86InstIdVcvtpd2dq_ExtendedIndex = 227,
+    kX86InstIdVcvtpd2ps_ExtendedIndex = 227,
+    kX86InstIdVcvtph2ps_ExtendedIndex = 225,
+    kX86InstIdVcvtps2dq_ExtendedIndex = 226,
+    kX86InstIdVcvtps2pd_ExtendedIndex = 225,
+    kX86InstIdVcvtps2ph_ExtendedIndex = 228,
+    kX86InstIdVcvtsd2si_ExtendedIndex = 229,
+    kX86InstIdVcvtsd2ss_ExtendedIndex = 214,
+    kX86InstIdVcvtsi2sd_ExtendedIndex = 230,
+    kX86InstIdVcvtsi2ss_ExtendedIndex = 230,
+    kX86InstIdVcvtss2sd_ExtendedIndex = 214,
+    kX86InstIdVcvtss2si_ExtendedIndex = 229,
+    kX86InstIdVcvttpd2dq_ExtendedIndex = 231,
+    kX86InstIdVcvttps2dq_ExtendedIndex = 226,
+    kX86InstIdVcvttsd2si_ExtendedIndex = 229,
+    kX86InstIdVcvttss2si_ExtendedIndex = 229,
+    kX86InstIdVdivpd_ExtendedIndex = 213,
+    kX86InstIdVdivps_ExtendedIndex = 213,
+    kX86InstIdVdivsd_ExtendedIndex = 214,
+    kX86InstIdVdivss_ExtendedIndex = 214,
+    kX86InstIdVdppd_ExtendedIndex = 223,
+    kX86InstIdVdpps_ExtendedIndex = 218,
+    kX86InstIdVextractf128_ExtendedIndex = 232,
+    kX86InstIdVextracti128_ExtendedIndex = 232,
+    kX86InstIdVextractps_ExtendedIndex = 233,
+    kX86InstIdVfmadd132pd_ExtendedIndex = 234,
+    kX86InstIdVfmadd132ps_ExtendedIndex = 234,
+    kX86InstIdVfmadd132sd_ExtendedIndex = 235,
+    kX86InstIdVfmadd132ss_ExtendedIndex = 235,
+    kX86InstIdVfmadd213pd_ExtendedIndex = 234,
+    kX86InstIdVfmadd213ps_ExtendedIndex = 234,
+    kX86InstIdVfmadd213sd_ExtendedIndex = 235,
+    kX86InstIdVfmadd213ss_ExtendedIndex = 235,
+    kX86InstIdVfmadd231pd_ExtendedIndex = 234,
+    kX86InstIdVfmadd231ps_ExtendedIndex = 234,
+    kX86InstIdVfmadd231sd_ExtendedIndex = 235,
+    kX86InstIdVfmadd231ss_ExtendedIndex = 235,
+    kX86InstIdVfmaddpd_ExtendedIndex = 236,
+    kX86InstIdVfmaddps_ExtendedIndex = 236,
+    kX86InstIdVfmaddsd_ExtendedIndex = 237,
+    kX86InstIdVfmaddss_ExtendedIndex = 237,
+    kX86InstIdVfmaddsub132pd_ExtendedIndex = 234,
+    kX86InstIdVfmaddsub132ps_ExtendedIndex = 234,
+    kX86InstIdVfmaddsub213pd_ExtendedIndex = 234,
+    kX86InstIdVfmaddsub213ps_ExtendedIndex = 234,
+    kX86InstIdVfmaddsub231pd_ExtendedIndex = 234,
+    kX86InstIdVfmaddsub231ps_ExtendedIndex = 234,
+    kX86InstIdVfmaddsubpd_ExtendedIndex = 236,
+    kX86InstIdVfmaddsubps_ExtendedIndex = 236,
+    kX86InstIdVfmsub132pd_ExtendedIndex = 234,
+    kX86InstIdVfmsub132ps_ExtendedIndex = 234,
+    kX86InstIdVfmsub132sd_ExtendedIndex = 235,
+    kX86InstIdVfmsub132ss_ExtendedIndex = 235,
+    kX86InstIdVfmsub213pd_ExtendedIndex = 234,
+    kX86InstIdVfmsub213ps_ExtendedIndex = 234,
+    kX86InstIdVfmsub213sd_ExtendedIndex = 235,
+    kX86InstIdVfmsub213ss_ExtendedIndex = 235,
+    kX86InstIdVfmsub231pd_ExtendedIndex = 234,
+    kX86InstIdVfmsub231ps_ExtendedIndex = 234,
+    kX86InstIdVfmsub231sd_ExtendedIndex = 235,
+    kX86InstIdVfmsub231ss_ExtendedIndex = 235,
+    kX86InstIdVfmsubadd132pd_ExtendedIndex = 234,
+    kX86InstIdVfmsubadd132ps_ExtendedIndex = 234,
+    kX86InstIdVfmsubadd213pd_ExtendedIndex = 234,
+    kX86InstIdVfmsubadd213ps_ExtendedIndex = 234,
+    kX86InstIdVfmsubadd231pd_ExtendedIndex = 234,
+    kX86InstIdVfmsubadd231ps_ExtendedIndex = 234,
+    kX86InstIdVfmsubaddpd_ExtendedIndex = 236,
+    kX86InstIdVfmsubaddps_ExtendedIndex = 236,
+    kX86InstIdVfmsubpd_ExtendedIndex = 236,
+    kX86InstIdVfmsubps_ExtendedIndex = 236,
+    kX86InstIdVfmsubsd_ExtendedIndex = 237,
+    kX86InstIdVfmsubss_ExtendedIndex = 237,
+    kX86InstIdVfnmadd132pd_ExtendedIndex = 234,
+    kX86InstIdVfnmadd132ps_ExtendedIndex = 234,
+    kX86InstIdVfnmadd132sd_ExtendedIndex = 235,
+    kX86InstIdVfnmadd132ss_ExtendedIndex = 235,
+    kX86InstIdVfnmadd213pd_ExtendedIndex = 234,
+    kX86InstIdVfnmadd213ps_ExtendedIndex = 234,
+    kX86InstIdVfnmadd213sd_ExtendedIndex = 235,
+    kX86InstIdVfnmadd213ss_ExtendedIndex = 235,
+    kX86InstIdVfnmadd231pd_ExtendedIndex = 234,
+    kX86InstIdVfnmadd231ps_ExtendedIndex = 234,
+    kX86InstIdVfnmadd231sd_ExtendedIndex = 235,
+    kX86InstIdVfnmadd231ss_ExtendedIndex = 235,
+    kX86InstIdVfnmaddpd_ExtendedIndex = 236,
+    kX86InstIdVfnmaddps_ExtendedIndex = 236,
+    kX86InstIdVfnmaddsd_ExtendedIndex = 237,
+    kX86InstIdVfnmaddss_ExtendedIndex = 237,
+    kX86InstIdVfnmsub132pd_ExtendedIndex = 234,
+    kX86InstIdVfnmsub132ps_ExtendedIndex = 234,
+    kX86InstIdVfnmsub132sd_ExtendedIndex = 235,
+    kX86InstIdVfnmsub132ss_ExtendedIndex = 235,
+    kX86InstIdVfnmsub213pd_ExtendedIndex = 234,
+    kX86InstIdVfnmsub213ps_ExtendedIndex = 234,
+    kX86InstIdVfnmsub213sd_ExtendedIndex = 235,
+    kX86InstIdVfnmsub213ss_ExtendedIndex = 235,
+    kX86InstIdVfnmsub231pd_ExtendedIndex = 234,
+    kX86InstIdVfnmsub231ps_ExtendedIndex = 234,
+    kX86InstIdVfnmsub231sd_ExtendedIndex = 235,
+    kX86InstIdVfnmsub231ss_ExtendedIndex = 235,
+    kX86InstIdVfnmsubpd_ExtendedIndex = 236,
+    kX86InstIdVfnmsubps_ExtendedIndex = 236,
+    kX86InstIdVfnmsubsd_ExtendedIndex = 237,
+    kX86InstIdVfnmsubss_ExtendedIndex = 237,
+    kX86InstIdVfrczpd_ExtendedIndex = 238,
+    kX86InstIdVfrczps_ExtendedIndex = 238,
+    kX86InstIdVfrczsd_ExtendedIndex = 239,
+    kX86InstIdVfrczss_ExtendedIndex = 239,
+    kX86InstIdVgatherdpd_ExtendedIndex = 240,
+    kX86InstIdVgatherdps_ExtendedIndex = 240,
+    kX86InstIdVgatherqpd_ExtendedIndex = 240,
+    kX86InstIdVgatherqps_ExtendedIndex = 241,
+    kX86InstIdVhaddpd_ExtendedIndex = 215,
+    kX86InstIdVhaddps_ExtendedIndex = 215,
+    kX86InstIdVhsubpd_ExtendedIndex = 215,
+    kX86InstIdVhsubps_ExtendedIndex = 215,
+    kX86InstIdVinsertf128_ExtendedIndex = 242,
+    kX86InstIdVinserti128_ExtendedIndex = 242,
+    kX86InstIdVinsertps_ExtendedIndex = 223,
+    kX86InstIdVlddqu_ExtendedIndex = 243,
+    kX86InstIdVldmxcsr_ExtendedIndex = 244,
+    kX86InstIdVmaskmovdqu_ExtendedIndex = 245,
+    kX86InstIdVmaskmovpd_ExtendedIndex = 246,
+    kX86InstIdVmaskmovps_ExtendedIndex = 247,
+    kX86InstIdVmaxpd_ExtendedIndex = 248,
+    kX86InstIdVmaxps_ExtendedIndex = 248,
+    kX86InstIdVmaxsd_ExtendedIndex = 215,
+    kX86InstIdVmaxss_ExtendedIndex = 215,
+    kX86InstIdVminpd_ExtendedIndex = 248,
+    kX86InstIdVminps_ExtendedIndex = 248,
+    kX86InstIdVminsd_ExtendedIndex = 215,
+    kX86InstIdVminss_ExtendedIndex = 215,
+    kX86InstIdVmovapd_ExtendedIndex = 249,
+    kX86InstIdVmovaps_ExtendedIndex = 250,
+    kX86InstIdVmovd_ExtendedIndex = 251,
+    kX86InstIdVmovddup_ExtendedIndex = 226,
+    kX86InstIdVmovdqa_ExtendedIndex = 252,
+    kX86InstIdVmovdqa32_ExtendedIndex = 253,
+    kX86InstIdVmovdqa64_ExtendedIndex = 254,
+    kX86InstIdVmovdqu_ExtendedIndex = 255,
+    kX86InstIdVmovdqu32_ExtendedIndex = 256,
+    kX86InstIdVmovdqu64_ExtendedIndex = 257,
+    kX86InstIdVmovhlps_ExtendedIndex = 258,
+    kX86InstIdVmovhpd_ExtendedIndex = 259,
+    kX86InstIdVmovhps_ExtendedIndex = 260,
+    kX86InstIdVmovlhps_ExtendedIndex = 258,
+    kX86InstIdVmovlpd_ExtendedIndex = 261,
+    kX86InstIdVmovlps_ExtendedIndex = 262,
+    kX86InstIdVmovmskpd_ExtendedIndex = 263,
+    kX86InstIdVmovmskps_ExtendedIndex = 263,
+    kX86InstIdVmovntdq_ExtendedIndex = 264,
+    kX86InstIdVmovntdqa_ExtendedIndex = 243,
+    kX86InstIdVmovntpd_ExtendedIndex = 264,
+    kX86InstIdVmovntps_ExtendedIndex = 264,
+    kX86InstIdVmovq_ExtendedIndex = 265,
+    kX86InstIdVmovsd_ExtendedIndex = 266,
+    kX86InstIdVmovshdup_ExtendedIndex = 226,
+    kX86InstIdVmovsldup_ExtendedIndex = 226,
+    kX86InstIdVmovss_ExtendedIndex = 267,
+    kX86InstIdVmovupd_ExtendedIndex = 268,
+    kX86InstIdVmovups_ExtendedIndex = 269,
+    kX86InstIdVmpsadbw_ExtendedIndex = 218,
+    kX86InstIdVmulpd_ExtendedIndex = 213,
+    kX86InstIdVmulps_ExtendedIndex = 213,
+    kX86InstIdVmulsd_ExtendedIndex = 215,
+    kX86InstIdVmulss_ExtendedIndex = 215,
+    kX86InstIdVorpd_ExtendedIndex = 215,
+    kX86InstIdVorps_ExtendedIndex = 215,
+    kX86InstIdVpabsb_ExtendedIndex = 226,
+    kX86InstIdVpabsd_ExtendedIndex = 226,
+    kX86InstIdVpabsw_ExtendedIndex = 226,
+    kX86InstIdVpackssdw_ExtendedIndex = 215,
+    kX86InstIdVpacksswb_ExtendedIndex = 215,
+    kX86InstIdVpackusdw_ExtendedIndex = 215,
+    kX86InstIdVpackuswb_ExtendedIndex = 215,
+    kX86InstIdVpaddb_ExtendedIndex = 215,
+    kX86InstIdVpaddd_ExtendedIndex = 270,
+    kX86InstIdVpaddq_ExtendedIndex = 270,
+    kX86InstIdVpaddsb_ExtendedIndex = 215,
+    kX86InstIdVpaddsw_ExtendedIndex = 215,
+    kX86InstIdVpaddusb_ExtendedIndex = 215,
+    kX86InstIdVpaddusw_ExtendedIndex = 215,
+    kX86InstIdVpaddw_ExtendedIndex = 215,
+    kX86InstIdVpalignr_ExtendedIndex = 218,
+    kX86InstIdVpand_ExtendedIndex = 215,
+    kX86InstIdVpandd_ExtendedIndex = 271,
+    kX86InstIdVpandn_ExtendedIndex = 215,
+    kX86InstIdVpandnd_ExtendedIndex = 271,
+    kX86InstIdVpandnq_ExtendedIndex = 271,
+    kX86InstIdVpandq_ExtendedIndex = 271,
+    kX86InstIdVpavgb_ExtendedIndex = 215,
+    kX86InstIdVpavgw_ExtendedIndex = 215,
+    kX86InstIdVpblendd_ExtendedIndex = 218,
+    kX86InstIdVpblendvb_ExtendedIndex = 272,
+    kX86InstIdVpblendw_ExtendedIndex = 218,
+    kX86InstIdVpbroadcastb_ExtendedIndex = 225,
+    kX86InstIdVpbroadcastd_ExtendedIndex = 222,
+    kX86InstIdVpbroadcastq_ExtendedIndex = 222,
+    kX86InstIdVpbroadcastw_ExtendedIndex = 225,
+    kX86InstIdVpclmulqdq_ExtendedIndex = 223,
+    kX86InstIdVpcmov_ExtendedIndex = 273,
+    kX86InstIdVpcmpd_ExtendedIndex = 274,
+    kX86InstIdVpcmpeqb_ExtendedIndex = 215,
+    kX86InstIdVpcmpeqd_ExtendedIndex = 275,
+    kX86InstIdVpcmpeqq_ExtendedIndex = 215,
+    kX86InstIdVpcmpeqw_ExtendedIndex = 215,
+    kX86InstIdVpcmpestri_ExtendedIndex = 276,
+    kX86InstIdVpcmpestrm_ExtendedIndex = 276,
+    kX86InstIdVpcmpgtb_ExtendedIndex = 215,
+    kX86InstIdVpcmpgtd_ExtendedIndex = 275,
+    kX86InstIdVpcmpgtq_ExtendedIndex = 215,
+    kX86InstIdVpcmpgtw_ExtendedIndex = 215,
+    kX86InstIdVpcmpistri_ExtendedIndex = 276,
+    kX86InstIdVpcmpistrm_ExtendedIndex = 276,
+    kX86InstIdVpcmpq_ExtendedIndex = 274,
+    kX86InstIdVpcmpud_ExtendedIndex = 274,
+    kX86InstIdVpcmpuq_ExtendedIndex = 274,
+    kX86InstIdVpcomb_ExtendedIndex = 277,
+    kX86InstIdVpcomd_ExtendedIndex = 277,
+    kX86InstIdVpcompressd_ExtendedIndex = 278,
+    kX86InstIdVpcompressq_ExtendedIndex = 278,
+    kX86InstIdVpcomq_ExtendedIndex = 277,
+    kX86InstIdVpcomub_ExtendedIndex = 277,
+    kX86InstIdVpcomud_ExtendedIndex = 277,
+    kX86InstIdVpcomuq_ExtendedIndex = 277,
+    kX86InstIdVpcomuw_ExtendedIndex = 277,
+    kX86InstIdVpcomw_ExtendedIndex = 277,
+    kX86InstIdVperm2f128_ExtendedIndex = 279,
+    kX86InstIdVperm2i128_ExtendedIndex = 279,
+    kX86InstIdVpermd_ExtendedIndex = 280,
+    kX86InstIdVpermil2pd_ExtendedIndex = 281,
+    kX86InstIdVpermil2ps_ExtendedIndex = 281,
+    kX86InstIdVpermilpd_ExtendedIndex = 282,
+    kX86InstIdVpermilps_ExtendedIndex = 283,
+    kX86InstIdVpermpd_ExtendedIndex = 284,
+    kX86InstIdVpermps_ExtendedIndex = 280,
+    kX86InstIdVpermq_ExtendedIndex = 284,
+    kX86InstIdVpexpandd_ExtendedIndex = 285,
+    kX86InstIdVpexpandq_ExtendedIndex = 285,
+    kX86InstIdVpextrb_ExtendedIndex = 286,
+    kX86InstIdVpextrd_ExtendedIndex = 233,
+    kX86InstIdVpextrq_ExtendedIndex = 287,
+    kX86InstIdVpextrw_ExtendedIndex = 288,
+    kX86InstIdVpgatherdd_ExtendedIndex = 240,
+    kX86InstIdVpgatherdq_ExtendedIndex = 240,
+    kX86InstIdVpgatherqd_ExtendedIndex = 241,
+    kX86InstIdVpgatherqq_ExtendedIndex = 240,
+    kX86InstIdVphaddbd_ExtendedIndex = 239,
+    kX86InstIdVphaddbq_ExtendedIndex = 239,
+    kX86InstIdVphaddbw_ExtendedIndex = 239,
+    kX86InstIdVphaddd_ExtendedIndex = 215,
+    kX86InstIdVphadddq_ExtendedIndex = 239,
+    kX86InstIdVphaddsw_ExtendedIndex = 215,
+    kX86InstIdVphaddubd_ExtendedIndex = 239,
+    kX86InstIdVphaddubq_ExtendedIndex = 239,
+    kX86InstIdVphaddubw_ExtendedIndex = 239,
+    kX86InstIdVphaddudq_ExtendedIndex = 239,
+    kX86InstIdVphadduwd_ExtendedIndex = 239,
+    kX86InstIdVphadduwq_ExtendedIndex = 239,
+    kX86InstIdVphaddw_ExtendedIndex = 215,
+    kX86InstIdVphaddwd_ExtendedIndex = 239,
+    kX86InstIdVphaddwq_ExtendedIndex = 239,
+    kX86InstIdVphminposuw_ExtendedIndex = 216,
+    kX86InstIdVphsubbw_ExtendedIndex = 239,
+    kX86InstIdVphsubd_ExtendedIndex = 215,
+    kX86InstIdVphsubdq_ExtendedIndex = 239,
+    kX86InstIdVphsubsw_ExtendedIndex = 215,
+    kX86InstIdVphsubw_ExtendedIndex = 215,
+    kX86InstIdVphsubwd_ExtendedIndex = 239,
+    kX86InstIdVpinsrb_ExtendedIndex = 289,
+    kX86InstIdVpinsrd_ExtendedIndex = 290,
+    kX86InstIdVpinsrq_ExtendedIndex = 291,
+    kX86InstIdVpinsrw_ExtendedIndex = 292,
+    kX86InstIdVpmacsdd_ExtendedIndex = 293,
+    kX86InstIdVpmacsdqh_ExtendedIndex = 293,
+    kX86InstIdVpmacsdql_ExtendedIndex = 293,
+    kX86InstIdVpmacssdd_ExtendedIndex = 293,
+    kX86InstIdVpmacssdqh_ExtendedIndex = 293,
+    kX86InstIdVpmacssdql_ExtendedIndex = 293,
+    kX86InstIdVpmacsswd_ExtendedIndex = 293,
+    kX86InstIdVpmacssww_ExtendedIndex = 293,
+    kX86InstIdVpmacswd_ExtendedIndex = 293,
+    kX86InstIdVpmacsww_ExtendedIndex = 293,
+    kX86InstIdVpmadcsswd_ExtendedIndex = 293,
+    kX86InstIdVpmadcswd_ExtendedIndex = 293,
+    kX86InstIdVpmaddubsw_ExtendedIndex = 215,
+    kX86InstIdVpmaddwd_ExtendedIndex = 215,
+    kX86InstIdVpmaskmovd_ExtendedIndex = 294,
+    kX86InstIdVpmaskmovq_ExtendedIndex = 294,
+    kX86InstIdVpmaxsb_ExtendedIndex = 215,
+    kX86InstIdVpmaxsd_ExtendedIndex = 215,
+    kX86InstIdVpmaxsw_ExtendedIndex = 215,
+    kX86InstIdVpmaxub_ExtendedIndex = 215,
+    kX86InstIdVpmaxud_ExtendedIndex = 215,
+    kX86InstIdVpmaxuw_ExtendedIndex = 215,
+    kX86InstIdVpminsb_ExtendedIndex = 215,
+    kX86InstIdVpminsd_ExtendedIndex = 215,
+    kX86InstIdVpminsw_ExtendedIndex = 215,
+    kX86InstIdVpminub_ExtendedIndex = 215,
+    kX86InstIdVpminud_ExtendedIndex = 215,
+    kX86InstIdVpminuw_ExtendedIndex = 215,
+    kX86InstIdVpmovmskb_ExtendedIndex = 263,
+    kX86InstIdVpmovsxbd_ExtendedIndex = 225,
+    kX86InstIdVpmovsxbq_ExtendedIndex = 225,
+    kX86InstIdVpmovsxbw_ExtendedIndex = 225,
+    kX86InstIdVpmovsxdq_ExtendedIndex = 225,
+    kX86InstIdVpmovsxwd_ExtendedIndex = 225,
+    kX86InstIdVpmovsxwq_ExtendedIndex = 225,
+    kX86InstIdVpmovzxbd_ExtendedIndex = 225,
+    kX86InstIdVpmovzxbq_ExtendedIndex = 225,
+    kX86InstIdVpmovzxbw_ExtendedIndex = 225,
+    kX86InstIdVpmovzxdq_ExtendedIndex = 225,
+    kX86InstIdVpmovzxwd_ExtendedIndex = 225,
+    kX86InstIdVpmovzxwq_ExtendedIndex = 225,
+    kX86InstIdVpmuldq_ExtendedIndex = 215,
+    kX86InstIdVpmulhrsw_ExtendedIndex = 215,
+    kX86InstIdVpmulhuw_ExtendedIndex = 215,
+    kX86InstIdVpmulhw_ExtendedIndex = 215,
+    kX86InstIdVpmulld_ExtendedIndex = 270,
+    kX86InstIdVpmullw_ExtendedIndex = 215,
+    kX86InstIdVpmuludq_ExtendedIndex = 215,
+    kX86InstIdVpor_ExtendedIndex = 215,
+    kX86InstIdVpord_ExtendedIndex = 271,
+    kX86InstIdVporq_ExtendedIndex = 271,
+    kX86InstIdVpperm_ExtendedIndex = 295,
+    kX86InstIdVprotb_ExtendedIndex = 296,
+    kX86InstIdVprotd_ExtendedIndex = 297,
+    kX86InstIdVprotq_ExtendedIndex = 298,
+    kX86InstIdVprotw_ExtendedIndex = 299,
+    kX86InstIdVpsadbw_ExtendedIndex = 215,
+    kX86InstIdVpshab_ExtendedIndex = 300,
+    kX86InstIdVpshad_ExtendedIndex = 300,
+    kX86InstIdVpshaq_ExtendedIndex = 300,
+    kX86InstIdVpshaw_ExtendedIndex = 300,
+    kX86InstIdVpshlb_ExtendedIndex = 300,
+    kX86InstIdVpshld_ExtendedIndex = 300,
+    kX86InstIdVpshlq_ExtendedIndex = 300,
+    kX86InstIdVpshlw_ExtendedIndex = 300,
+    kX86InstIdVpshufb_ExtendedIndex = 215,
+    kX86InstIdVpshufd_ExtendedIndex = 301,
+    kX86InstIdVpshufhw_ExtendedIndex = 302,
+    kX86InstIdVpshuflw_ExtendedIndex = 302,
+    kX86InstIdVpsignb_ExtendedIndex = 215,
+    kX86InstIdVpsignd_ExtendedIndex = 215,
+    kX86InstIdVpsignw_ExtendedIndex = 215,
+    kX86InstIdVpslld_ExtendedIndex = 303,
+    kX86InstIdVpslldq_ExtendedIndex = 304,
+    kX86InstIdVpsllq_ExtendedIndex = 305,
+    kX86InstIdVpsllvd_ExtendedIndex = 215,
+    kX86InstIdVpsllvq_ExtendedIndex = 215,
+    kX86InstIdVpsllw_ExtendedIndex = 306,
+    kX86InstIdVpsrad_ExtendedIndex = 307,
+    kX86InstIdVpsravd_ExtendedIndex = 215,
+    kX86InstIdVpsraw_ExtendedIndex = 308,
+    kX86InstIdVpsrld_ExtendedIndex = 309,
+    kX86InstIdVpsrldq_ExtendedIndex = 304,
+    kX86InstIdVpsrlq_ExtendedIndex = 310,
+    kX86InstIdVpsrlvd_ExtendedIndex = 215,
+    kX86InstIdVpsrlvq_ExtendedIndex = 215,
+    kX86InstIdVpsrlw_ExtendedIndex = 311,
+    kX86InstIdVpsubb_ExtendedIndex = 215,
+    kX86InstIdVpsubd_ExtendedIndex = 270,
+    kX86InstIdVpsubq_ExtendedIndex = 270,
+    kX86InstIdVpsubsb_ExtendedIndex = 215,
+    kX86InstIdVpsubsw_ExtendedIndex = 215,
+    kX86InstIdVpsubusb_ExtendedIndex = 215,
+    kX86InstIdVpsubusw_ExtendedIndex = 215,
+    kX86InstIdVpsubw_ExtendedIndex = 215,
+    kX86InstIdVpternlogd_ExtendedIndex = 312,
+    kX86InstIdVpternlogq_ExtendedIndex = 312,
+    kX86InstIdVptest_ExtendedIndex = 313,
+    kX86InstIdVptestmd_ExtendedIndex = 314,
+    kX86InstIdVptestmq_ExtendedIndex = 314,
+    kX86InstIdVptestnmd_ExtendedIndex = 314,
+    kX86InstIdVptestnmq_ExtendedIndex = 314,
+    kX86InstIdVpunpckhbw_ExtendedIndex = 215,
+    kX86InstIdVpunpckhdq_ExtendedIndex = 215,
+    kX86InstIdVpunpckhqdq_ExtendedIndex = 215,
+    kX86InstIdVpunpckhwd_ExtendedIndex = 215,
+    kX86InstIdVpunpcklbw_ExtendedIndex = 215,
+    kX86InstIdVpunpckldq_ExtendedIndex = 215,
+    kX86InstIdVpunpcklqdq_ExtendedIndex = 215,
+    kX86InstIdVpunpcklwd_ExtendedIndex = 215,
+    kX86InstIdVpxor_ExtendedIndex = 215,
+    kX86InstIdVpxord_ExtendedIndex = 271,
+    kX86InstIdVpxorq_ExtendedIndex = 271,
+    kX86InstIdVrcpps_ExtendedIndex = 226,
+    kX86InstIdVrcpss_ExtendedIndex = 214,
+    kX86InstIdVroundpd_ExtendedIndex = 302,
+    kX86InstIdVroundps_ExtendedIndex = 302,
+    kX86InstIdVroundsd_ExtendedIndex = 223,
+    kX86InstIdVroundss_ExtendedIndex = 223,
+    kX86InstIdVrsqrtps_ExtendedIndex = 226,
+    kX86InstIdVrsqrtss_ExtendedIndex = 214,
+    kX86InstIdVshufpd_ExtendedIndex = 218,
+    kX86InstIdVshufps_ExtendedIndex = 218,
+    kX86InstIdVsqrtpd_ExtendedIndex = 315,
+    kX86InstIdVsqrtps_ExtendedIndex = 315,
+    kX86InstIdVsqrtsd_ExtendedIndex = 214,
+    kX86InstIdVsqrtss_ExtendedIndex = 214,
+    kX86InstIdVstmxcsr_ExtendedIndex = 316,
+    kX86InstIdVsubpd_ExtendedIndex = 213,
+    kX86InstIdVsubps_ExtendedIndex = 213,
+    kX86InstIdVsubsd_ExtendedIndex = 214,
+    kX86InstIdVsubss_ExtendedIndex = 214,
+    kX86InstIdVtestpd_ExtendedIndex = 313,
+    kX86InstIdVtestps_ExtendedIndex = 313,
+    kX86InstIdVucomisd_ExtendedIndex = 224,
+    kX86InstIdVucomiss_ExtendedIndex = 224,
+    kX86InstIdVunpckhpd_ExtendedIndex = 215,
+    kX86InstIdVunpckhps_ExtendedIndex = 215,
+    kX86InstIdVunpcklpd_ExtendedIndex = 215,
+    kX86InstIdVunpcklps_ExtendedIndex = 215,
+    kX86InstIdVxorpd_ExtendedIndex = 215,
+    kX86InstIdVxorps_ExtendedIndex = 215,
+    kX86InstIdVzeroall_ExtendedIndex = 317,
+    kX86InstIdVzeroupper_ExtendedIndex = 317,
+    kX86InstIdWrfsbase_ExtendedIndex = 318,
+    kX86InstIdWrgsbase_ExtendedIndex = 318,
+    kX86InstIdXadd_ExtendedIndex = 319,
+    kX86InstIdXchg_ExtendedIndex = 320,
+    kX86InstIdXgetbv_ExtendedIndex = 139,
     kX86InstIdXor_ExtendedIndex = 3,
-    kX86InstIdXorpd_ExtendedIndex = 301,
-    kX86InstIdXorps_ExtendedIndex = 301,
-    kX86InstIdXrstor_ExtendedIndex = 302,
-    kX86InstIdXrstor64_ExtendedIndex = 302,
-    kX86InstIdXsave_ExtendedIndex = 302,
-    kX86InstIdXsave64_ExtendedIndex = 302,
-    kX86InstIdXsaveopt_ExtendedIndex = 302,
-    kX86InstIdXsaveopt64_ExtendedIndex = 302,
-    kX86InstIdXsetbv_ExtendedIndex = 107
+    kX86InstIdXorpd_ExtendedIndex = 321,
+    kX86InstIdXorps_ExtendedIndex = 321,
+    kX86InstIdXrstor_ExtendedIndex = 322,
+    kX86InstIdXrstor64_ExtendedIndex = 322,
+    kX86InstIdXsave_ExtendedIndex = 322,
+    kX86InstIdXsave64_ExtendedIndex = 322,
+    kX86InstIdXsaveopt_ExtendedIndex = 322,
+    kX86InstIdXsaveopt64_ExtendedIndex = 322,
+    kX86InstIdXsetbv_ExtendedIndex = 111
 };
 // ----------------------------------------------------------------------------
 // ${X86InstData:End}
@@ -1950,7 +2025,7 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Dpps            , "dpps"            , Enc(SimdRmi)         , O_660F3A(40,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                 ),
   INST(Emms            , "emms"            , Enc(X86Op)           , O_000F00(77,U,_,_,_), U                   , F(Volatile)                        , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
   INST(Enter           , "enter"           , Enc(X86Enter)        , O_000000(C8,U,_,_,_), U                   , F(Volatile)|F(Special)             , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
-  INST(Extractps       , "extractps"       , Enc(SimdExtract)     , O_660F3A(17,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 8 , O(GqdMem)         , O(Xmm)            , U                 , U                 , U                 ),
+  INST(Extractps       , "extractps"       , Enc(SimdExtract)     , O_660F3A(17,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 8 , O(GqdMem)         , O(Xmm)            , O(Imm)            , U                 , U                 ),
   INST(Extrq           , "extrq"           , Enc(SimdExtrq)       , O_660F00(79,U,_,_,_), O_660F00(78,0,_,_,_), F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)|O(Imm)     , O(None)|O(Imm)    , U                 , U                 ),
   INST(F2xm1           , "f2xm1"           , Enc(FpuOp)           , O_00_X(D9F0,U)      , U                   , F(Fp)                              , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
   INST(Fabs            , "fabs"            , Enc(FpuOp)           , O_00_X(D9E1,U)      , U                   , F(Fp)                              , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
@@ -2040,7 +2115,7 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Fucomip         , "fucomip"         , Enc(FpuR)            , O_00_X(DFE8,U)      , U                   , F(Fp)                              , EF(WWWWWW__), 0 , 0 , O(Fp)             , U                 , U                 , U                 , U                 ),
   INST(Fucomp          , "fucomp"          , Enc(FpuRDef)         , O_00_X(DDE8,U)      , U                   , F(Fp)                              , EF(________), 0 , 0 , O(Fp)             , U                 , U                 , U                 , U                 ),
   INST(Fucompp         , "fucompp"         , Enc(FpuOp)           , O_00_X(DAE9,U)      , U                   , F(Fp)                              , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
-  INST(Fwait           , "fwait"           , Enc(X86Op)           , O_000000(DB,U,_,_,_), U                   , F(Fp)|F(Volatile)                  , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
+  INST(Fwait           , "fwait"           , Enc(X86Op)           , O_000000(9B,U,_,_,_), U                   , F(Fp)|F(Volatile)                  , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
   INST(Fxam            , "fxam"            , Enc(FpuOp)           , O_00_X(D9E5,U)      , U                   , F(Fp)                              , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
   INST(Fxch            , "fxch"            , Enc(FpuR)            , O_00_X(D9C8,U)      , U                   , F(Fp)                              , EF(________), 0 , 0 , O(Fp)             , U                 , U                 , U                 , U                 ),
   INST(Fxrstor         , "fxrstor"         , Enc(X86M)            , O_000F00(AE,1,_,_,_), U                   , F(Fp)                              , EF(________), 0 , 0 , O(Mem)            , U                 , U                 , U                 , U                 ),
@@ -2091,7 +2166,15 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Js              , "js"              , Enc(X86Jcc)          , O_000000(78,U,_,_,_), U                   , F(Flow)|F(Volatile)                , EF(_R______), 0 , 0 , O(Label)          , U                 , U                 , U                 , U                 ),
   INST(Jz              , "jz"              , Enc(X86Jcc)          , O_000000(74,U,_,_,_), U                   , F(Flow)|F(Volatile)                , EF(__R_____), 0 , 0 , O(Label)          , U                 , U                 , U                 , U                 ),
   INST(Jecxz           , "jecxz"           , Enc(X86Jecxz)        , O_000000(E3,U,_,_,_), U                   , F(Flow)|F(Volatile)|F(Special)     , EF(________), 0 , 0 , O(Gqdw)           , O(Label)          , U                 , U                 , U                 ),
-  INST(Jmp             , "jmp"             , Enc(X86Jmp)          , O_000000(FF,4,_,_,_), O_000000(E9,U,_,_,_), F(Flow)|F(Volatile)                , EF(________), 0 , 0 , O(Label)|O(Imm)   , U                 , U                 , U                 , U                 ),
+  INST(Jmp             , "jmp"             , Enc(X86Jmp)          , O_000000(FF,4,_,_,_), O_000000(E9,U,_,_,_), F(Flow)|F(Volatile)                , EF(________), 0 , 0 , O(GqdMem)|O(LImm) , U                 , U                 , U                 , U                 ),
+  INST(Kandnw          , "kandnw"          , Enc(AvxRvm)          , O_000F00(42,U,L,0,_), U                   , F(WO)|A(F)                         , EF(________), 0 , 0 , O(K)              , O(K)              , O(K)              , U                 , U                 ),
+  INST(Kandw           , "kandw"           , Enc(AvxRvm)          , O_000F00(41,U,L,0,_), U                   , F(WO)|A(F)                         , EF(________), 0 , 0 , O(K)              , O(K)              , O(K)              , U                 , U                 ),
+  INST(Kmovw           , "kmovw"           , Enc(AvxKMov)         , O_000F00(90,U,0,0,_), O_000F00(91,U,0,0,_), F(WO)|A(F)                         , EF(________), 0 , 0 , O(KMem)|O(Gd)     , O(KMem)|O(Gd)     , U                 , U                 , U                 ),
+  INST(Knotw           , "knotw"           , Enc(AvxRm)           , O_000F00(44,U,0,0,_), U                   , F(WO)|A(F)                         , EF(________), 0 , 0 , O(K)              , O(K)              , U                 , U                 , U                 ),
+  INST(Kortestw        , "kortestw"        , Enc(AvxRm)           , O_000F00(98,U,0,0,_), U                   , F(RO)|A(F)                         , EF(WWWWWW__), 0 , 0 , O(K)              , O(K)              , U                 , U                 , U                 ),
+  INST(Korw            , "korw"            , Enc(AvxRvm)          , O_000F00(45,U,L,0,_), U                   , F(WO)|A(F)                         , EF(________), 0 , 0 , O(K)              , O(K)              , O(K)              , U                 , U                 ),
+  INST(Kxnorw          , "kxnorw"          , Enc(AvxRvm)          , O_000F00(46,U,L,0,_), U                   , F(WO)|A(F)                         , EF(________), 0 , 0 , O(K)              , O(K)              , O(K)              , U                 , U                 ),
+  INST(Kxorw           , "kxorw"           , Enc(AvxRvm)          , O_000F00(47,U,L,0,_), U                   , F(WO)|A(F)                         , EF(________), 0 , 0 , O(K)              , O(K)              , O(K)              , U                 , U                 ),
   INST(Lahf            , "lahf"            , Enc(X86Op)           , O_000000(9F,U,_,_,_), U                   , F(RW)|F(Volatile)|F(Special)       , EF(_RRRRR__), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
   INST(Lddqu           , "lddqu"           , Enc(SimdRm)          , O_F20F00(F0,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 16, O(Xmm)            , O(Mem)            , U                 , U                 , U                 ),
   INST(Ldmxcsr         , "ldmxcsr"         , Enc(X86M)            , O_000F00(AE,2,_,_,_), U                   , F(RO)|F(Volatile)                  , EF(________), 0 , 0 , O(Mem)            , U                 , U                 , U                 , U                 ),
@@ -2209,10 +2292,10 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Pcmpistrm       , "pcmpistrm"       , Enc(SimdRmi)         , O_660F3A(62,U,_,_,_), U                   , F(WO)|F(Special)                   , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                 ),
   INST(Pdep            , "pdep"            , Enc(AvxRvm_OptW)     , O_F20F38(F5,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 0 , O(Gqd)            , O(Gqd)            , O(GqdMem)         , U                 , U                 ),
   INST(Pext            , "pext"            , Enc(AvxRvm_OptW)     , O_F30F38(F5,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 0 , O(Gqd)            , O(Gqd)            , O(GqdMem)         , U                 , U                 ),
-  INST(Pextrb          , "pextrb"          , Enc(SimdExtract)     , O_000F3A(14,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 8 , O(Gd)|O(Gb)|O(Mem), O(Xmm)            , U                 , U                 , U                 ),
-  INST(Pextrd          , "pextrd"          , Enc(SimdExtract)     , O_000F3A(16,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 8 , O(GdMem)          , O(Xmm)            , U                 , U                 , U                 ),
-  INST(Pextrq          , "pextrq"          , Enc(SimdExtract)     , O_000F3A(16,U,_,W,_), U                   , F(WO)                              , EF(________), 0 , 8 , O(GqdMem)         , O(Xmm)            , U                 , U                 , U                 ),
-  INST(Pextrw          , "pextrw"          , Enc(SimdPextrw)      , O_000F00(C5,U,_,_,_), O_000F3A(15,U,_,_,_), F(WO)                              , EF(________), 0 , 8 , O(GdMem)          , O(MmXmm)          , U                 , U                 , U                 ),
+  INST(Pextrb          , "pextrb"          , Enc(SimdExtract)     , O_000F3A(14,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 8 , O(GqdMem)|O(Gb)   , O(Xmm)            , O(Imm)            , U                 , U                 ),
+  INST(Pextrd          , "pextrd"          , Enc(SimdExtract)     , O_000F3A(16,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 8 , O(GqdMem)         , O(Xmm)            , O(Imm)            , U                 , U                 ),
+  INST(Pextrq          , "pextrq"          , Enc(SimdExtract)     , O_000F3A(16,U,_,W,_), U                   , F(WO)                              , EF(________), 0 , 8 , O(GqdMem)         , O(Xmm)            , O(Imm)            , U                 , U                 ),
+  INST(Pextrw          , "pextrw"          , Enc(SimdPextrw)      , O_000F00(C5,U,_,_,_), O_000F3A(15,U,_,_,_), F(WO)                              , EF(________), 0 , 8 , O(GqdMem)         , O(MmXmm)          , O(Imm)            , U                 , U                 ),
   INST(Pf2id           , "pf2id"           , Enc(Simd3dNow)       , O_000F0F(1D,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 8 , O(Mm)             , O(MmMem)          , U                 , U                 , U                 ),
   INST(Pf2iw           , "pf2iw"           , Enc(Simd3dNow)       , O_000F0F(1C,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 8 , O(Mm)             , O(MmMem)          , U                 , U                 , U                 ),
   INST(Pfacc           , "pfacc"           , Enc(Simd3dNow)       , O_000F0F(AE,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Mm)             , O(MmMem)          , U                 , U                 , U                 ),
@@ -2426,10 +2509,10 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Sha256msg2      , "sha256msg2"      , Enc(SimdRm)          , O_000F38(CD,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Sha256rnds2     , "sha256rnds2"     , Enc(SimdRm)          , O_000F38(CB,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Shl             , "shl"             , Enc(X86Rot)          , O_000000(D0,4,_,_,_), U                   , F(RW)|F(Special)                   , EF(WWWUWW__), 0 , 0 , O(GqdwbMem)       , O(Gb)|O(Imm)      , U                 , U                 , U                 ),
-  INST(Shld            , "shld"            , Enc(X86ShldShrd)     , O_000F00(A4,U,_,_,_), U                   , F(RW)|F(Special)                   , EF(UWWUWW__), 0 , 0 , O(GqdwbMem)       , O(Gb)             , U                 , U                 , U                 ),
+  INST(Shld            , "shld"            , Enc(X86ShldShrd)     , O_000F00(A4,U,_,_,_), U                   , F(RW)|F(Special)                   , EF(UWWUWW__), 0 , 0 , O(GqdwMem)        , O(Gqdw)           , O(Gb)|O(Imm)      , U                 , U                 ),
   INST(Shlx            , "shlx"            , Enc(AvxRmv_OptW)     , O_660F38(F7,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 0 , O(Gqd)            , O(GqdMem)         , O(Gqd)            , U                 , U                 ),
   INST(Shr             , "shr"             , Enc(X86Rot)          , O_000000(D0,5,_,_,_), U                   , F(RW)|F(Special)                   , EF(WWWUWW__), 0 , 0 , O(GqdwbMem)       , O(Gb)|O(Imm)      , U                 , U                 , U                 ),
-  INST(Shrd            , "shrd"            , Enc(X86ShldShrd)     , O_000F00(AC,U,_,_,_), U                   , F(RW)|F(Special)                   , EF(UWWUWW__), 0 , 0 , O(GqdwbMem)       , O(Gqdwb)          , U                 , U                 , U                 ),
+  INST(Shrd            , "shrd"            , Enc(X86ShldShrd)     , O_000F00(AC,U,_,_,_), U                   , F(RW)|F(Special)                   , EF(UWWUWW__), 0 , 0 , O(GqdwMem)        , O(Gqdw)           , O(Gb)|O(Imm)      , U                 , U                 ),
   INST(Shrx            , "shrx"            , Enc(AvxRmv_OptW)     , O_F20F38(F7,U,_,_,_), U                   , F(WO)                              , EF(________), 0 , 0 , O(Gqd)            , O(GqdMem)         , O(Gqd)            , U                 , U                 ),
   INST(Shufpd          , "shufpd"          , Enc(SimdRmi)         , O_660F00(C6,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                 ),
   INST(Shufps          , "shufps"          , Enc(SimdRmi)         , O_000F00(C6,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                 ),
@@ -2460,8 +2543,8 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Unpckhps        , "unpckhps"        , Enc(SimdRm)          , O_000F00(15,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Unpcklpd        , "unpcklpd"        , Enc(SimdRm)          , O_660F00(14,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Unpcklps        , "unpcklps"        , Enc(SimdRm)          , O_000F00(14,U,_,_,_), U                   , F(RW)                              , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
-  INST(Vaddpd          , "vaddpd"          , Enc(AvxRvm_OptL)     , O_660F00(58,U,_,I,1), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vaddps          , "vaddps"          , Enc(AvxRvm_OptL)     , O_000F00(58,U,_,I,0), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vaddpd          , "vaddpd"          , Enc(AvxRvm_OptL)     , O_660F00(58,U,_,I,1), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vaddps          , "vaddps"          , Enc(AvxRvm_OptL)     , O_000F00(58,U,_,I,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vaddsd          , "vaddsd"          , Enc(AvxRvm)          , O_F20F00(58,U,0,I,1), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vaddss          , "vaddss"          , Enc(AvxRvm)          , O_F30F00(58,U,0,I,0), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vaddsubpd       , "vaddsubpd"       , Enc(AvxRvm_OptL)     , O_660F00(D0,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
@@ -2483,7 +2566,7 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vbroadcastf128  , "vbroadcastf128"  , Enc(AvxRm)           , O_660F38(1A,U,L,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(Mem)            , U                 , U                 , U                 ),
   INST(Vbroadcasti128  , "vbroadcasti128"  , Enc(AvxRm)           , O_660F38(5A,U,L,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(Mem)            , U                 , U                 , U                 ),
   INST(Vbroadcastsd    , "vbroadcastsd"    , Enc(AvxRm)           , O_660F38(19,U,L,0,1), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(XmmMem)         , U                 , U                 , U                 ),
-  INST(Vbroadcastss    , "vbroadcastss"    , Enc(AvxRm_OptL)      , O_660F38(18,U,_,0,0), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vbroadcastss    , "vbroadcastss"    , Enc(AvxRm_T1S)       , O_660F38(18,U,_,0,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ)            , EF(________), 0 , 0 , O(Xyz)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vcmppd          , "vcmppd"          , Enc(AvxRvmi_OptL)    , O_660F00(C2,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vcmpps          , "vcmpps"          , Enc(AvxRvmi_OptL)    , O_000F00(C2,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vcmpsd          , "vcmpsd"          , Enc(AvxRvmi)         , O_F20F00(C2,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
@@ -2508,8 +2591,8 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vcvttps2dq      , "vcvttps2dq"      , Enc(AvxRm_OptL)      , O_F30F00(5B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vcvttsd2si      , "vcvttsd2si"      , Enc(AvxRm)           , O_F20F00(2C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Gqd)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vcvttss2si      , "vcvttss2si"      , Enc(AvxRm)           , O_F30F00(2C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Gqd)            , O(XmmMem)         , U                 , U                 , U                 ),
-  INST(Vdivpd          , "vdivpd"          , Enc(AvxRvm_OptL)     , O_660F00(5E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vdivps          , "vdivps"          , Enc(AvxRvm_OptL)     , O_000F00(5E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vdivpd          , "vdivpd"          , Enc(AvxRvm_OptL)     , O_660F00(5E,U,_,_,1), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vdivps          , "vdivps"          , Enc(AvxRvm_OptL)     , O_000F00(5E,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vdivsd          , "vdivsd"          , Enc(AvxRvm)          , O_F20F00(5E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vdivss          , "vdivss"          , Enc(AvxRvm)          , O_F30F00(5E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vdppd           , "vdppd"           , Enc(AvxRvmi)         , O_660F3A(41,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
@@ -2617,20 +2700,24 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vmaskmovdqu     , "vmaskmovdqu"     , Enc(AvxRm)           , O_660F00(F7,U,_,_,_), U                   , F(RO)|F(Avx)|F(Special)            , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , U                 , U                 , U                 ),
   INST(Vmaskmovpd      , "vmaskmovpd"      , Enc(AvxRvmMvr_OptL)  , O_660F38(2D,U,_,_,_), O_660F38(2F,U,_,_,_), F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vmaskmovps      , "vmaskmovps"      , Enc(AvxRvmMvr_OptL)  , O_660F38(2C,U,_,_,_), O_660F38(2E,U,_,_,_), F(RW)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmaxpd          , "vmaxpd"          , Enc(AvxRvm_OptL)     , O_660F00(5F,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmaxps          , "vmaxps"          , Enc(AvxRvm_OptL)     , O_000F00(5F,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vmaxpd          , "vmaxpd"          , Enc(AvxRvm_OptL)     , O_660F00(5F,U,_,_,1), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Sae)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vmaxps          , "vmaxps"          , Enc(AvxRvm_OptL)     , O_000F00(5F,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Sae)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vmaxsd          , "vmaxsd"          , Enc(AvxRvm_OptL)     , O_F20F00(5F,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vmaxss          , "vmaxss"          , Enc(AvxRvm_OptL)     , O_F30F00(5F,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vminpd          , "vminpd"          , Enc(AvxRvm_OptL)     , O_660F00(5D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vminps          , "vminps"          , Enc(AvxRvm_OptL)     , O_000F00(5D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vminpd          , "vminpd"          , Enc(AvxRvm_OptL)     , O_660F00(5D,U,_,_,1), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Sae)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vminps          , "vminps"          , Enc(AvxRvm_OptL)     , O_000F00(5D,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Sae)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vminsd          , "vminsd"          , Enc(AvxRvm_OptL)     , O_F20F00(5D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vminss          , "vminss"          , Enc(AvxRvm_OptL)     , O_F30F00(5D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmovapd         , "vmovapd"         , Enc(AvxRmMr_OptL)    , O_660F00(28,U,_,_,_), O_660F00(29,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vmovaps         , "vmovaps"         , Enc(AvxRmMr_OptL)    , O_000F00(28,U,_,_,_), O_000F00(29,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vmovd           , "vmovd"           , Enc(AvxMovDQ)        , O_660F00(6E,U,_,_,_), O_660F00(7E,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vmovapd         , "vmovapd"         , Enc(AvxRmMr_OptL)    , O_660F00(28,U,_,_,1), O_660F00(29,U,_,_,1), F(WO)|F(Avx)|A(F_VL_KZ)            , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vmovaps         , "vmovaps"         , Enc(AvxRmMr_OptL)    , O_000F00(28,U,_,_,0), O_000F00(29,U,_,_,0), F(WO)|F(Avx)|A(F_VL_KZ)            , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vmovd           , "vmovd"           , Enc(AvxMovDQ)        , O_660F00(6E,U,_,_,_), O_660F00(7E,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(GqdMem)|O(Xmm)  , O(GqdMem)|O(Xmm)  , U                 , U                 , U                 ),
   INST(Vmovddup        , "vmovddup"        , Enc(AvxRm_OptL)      , O_F20F00(12,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vmovdqa         , "vmovdqa"         , Enc(AvxRmMr_OptL)    , O_660F00(6F,U,_,_,_), O_660F00(7F,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(XyMem)          , U                 , U                 , U                 ),
+  INST(Vmovdqa32       , "vmovdqa32"       , Enc(AvxRmMr_OptL)    , O_660F00(6F,U,_,_,0), O_660F00(7F,U,_,_,0), F(WO)|A(F_VL_KZ)                   , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vmovdqa64       , "vmovdqa64"       , Enc(AvxRmMr_OptL)    , O_660F00(6F,U,_,_,1), O_660F00(7F,U,_,_,1), F(WO)|A(F_VL_KZ)                   , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
   INST(Vmovdqu         , "vmovdqu"         , Enc(AvxRmMr_OptL)    , O_F30F00(6F,U,_,_,_), O_F30F00(7F,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(XyMem)          , U                 , U                 , U                 ),
+  INST(Vmovdqu32       , "vmovdqu32"       , Enc(AvxRmMr_OptL)    , O_F30F00(6F,U,_,_,0), O_F30F00(7F,U,_,_,0), F(WO)|A(F_VL_KZ)                   , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vmovdqu64       , "vmovdqu64"       , Enc(AvxRmMr_OptL)    , O_F30F00(6F,U,_,_,1), O_F30F00(7F,U,_,_,1), F(WO)|A(F_VL_KZ)                   , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
   INST(Vmovhlps        , "vmovhlps"        , Enc(AvxRvm)          , O_000F00(12,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(Xmm)            , U                 , U                 ),
   INST(Vmovhpd         , "vmovhpd"         , Enc(AvxRvmMr)        , O_660F00(16,U,_,_,_), O_660F00(17,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(Xmm)            , O(Mem)            , U                 , U                 ),
   INST(Vmovhps         , "vmovhps"         , Enc(AvxRvmMr)        , O_000F00(16,U,_,_,_), O_000F00(17,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(Xmm)            , O(Mem)            , U                 , U                 ),
@@ -2643,16 +2730,16 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vmovntdqa       , "vmovntdqa"       , Enc(AvxRm_OptL)      , O_660F38(2A,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Mem)            , U                 , U                 , U                 ),
   INST(Vmovntpd        , "vmovntpd"        , Enc(AvxMr_OptL)      , O_660F00(2B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Mem)            , O(Xy)             , U                 , U                 , U                 ),
   INST(Vmovntps        , "vmovntps"        , Enc(AvxMr_OptL)      , O_000F00(2B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Mem)            , O(Xy)             , U                 , U                 , U                 ),
-  INST(Vmovq           , "vmovq"           , Enc(AvxMovDQ)        , O_660F00(6E,U,_,W,_), O_660F00(7E,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vmovq           , "vmovq"           , Enc(AvxMovDQ)        , O_660F00(6E,U,_,W,_), O_660F00(7E,U,_,W,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vmovsd          , "vmovsd"          , Enc(AvxMovSsSd)      , O_F20F00(10,U,_,_,_), O_F20F00(11,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(XmmMem)         , O(Xmm)            , U                 , U                 ),
   INST(Vmovshdup       , "vmovshdup"       , Enc(AvxRm_OptL)      , O_F30F00(16,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vmovsldup       , "vmovsldup"       , Enc(AvxRm_OptL)      , O_F30F00(12,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vmovss          , "vmovss"          , Enc(AvxMovSsSd)      , O_F30F00(10,U,_,_,_), O_F30F00(11,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(Xmm)            , O(Xmm)            , U                 , U                 ),
-  INST(Vmovupd         , "vmovupd"         , Enc(AvxRmMr_OptL)    , O_660F00(10,U,_,_,_), O_660F00(11,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vmovups         , "vmovups"         , Enc(AvxRmMr_OptL)    , O_000F00(10,U,_,_,_), O_000F00(11,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XyMem)          , O(XyMem)          , U                 , U                 , U                 ),
+  INST(Vmovss          , "vmovss"          , Enc(AvxMovSsSd)      , O_F30F00(10,U,_,_,_), O_F30F00(11,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(XmmMem)         , O(XmmMem)         , O(Xmm)            , U                 , U                 ),
+  INST(Vmovupd         , "vmovupd"         , Enc(AvxRmMr_OptL)    , O_660F00(10,U,_,_,1), O_660F00(11,U,_,_,1), F(WO)|F(Avx)|A(F_VL_KZ)            , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vmovups         , "vmovups"         , Enc(AvxRmMr_OptL)    , O_000F00(10,U,_,_,0), O_000F00(11,U,_,_,0), F(WO)|F(Avx)|A(F_VL_KZ)            , EF(________), 0 , 0 , O(XyzMem)         , O(XyzMem)         , U                 , U                 , U                 ),
   INST(Vmpsadbw        , "vmpsadbw"        , Enc(AvxRvmi_OptL)    , O_660F3A(42,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
-  INST(Vmulpd          , "vmulpd"          , Enc(AvxRvm_OptL)     , O_660F00(59,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vmulps          , "vmulps"          , Enc(AvxRvm_OptL)     , O_000F00(59,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vmulpd          , "vmulpd"          , Enc(AvxRvm_OptL)     , O_660F00(59,U,_,_,1), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vmulps          , "vmulps"          , Enc(AvxRvm_OptL)     , O_000F00(59,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vmulsd          , "vmulsd"          , Enc(AvxRvm_OptL)     , O_F20F00(59,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vmulss          , "vmulss"          , Enc(AvxRvm_OptL)     , O_F30F00(59,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vorpd           , "vorpd"           , Enc(AvxRvm_OptL)     , O_660F00(56,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
@@ -2665,8 +2752,8 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpackusdw       , "vpackusdw"       , Enc(AvxRvm_OptL)     , O_660F38(2B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpackuswb       , "vpackuswb"       , Enc(AvxRvm_OptL)     , O_660F00(67,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpaddb          , "vpaddb"          , Enc(AvxRvm_OptL)     , O_660F00(FC,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpaddd          , "vpaddd"          , Enc(AvxRvm_OptL)     , O_660F00(FE,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpaddq          , "vpaddq"          , Enc(AvxRvm_OptL)     , O_660F00(D4,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpaddd          , "vpaddd"          , Enc(AvxRvm_OptL)     , O_660F00(FE,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B)          , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpaddq          , "vpaddq"          , Enc(AvxRvm_OptL)     , O_660F00(D4,U,_,_,1), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B)          , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpaddsb         , "vpaddsb"         , Enc(AvxRvm_OptL)     , O_660F00(EC,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpaddsw         , "vpaddsw"         , Enc(AvxRvm_OptL)     , O_660F00(ED,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpaddusb        , "vpaddusb"        , Enc(AvxRvm_OptL)     , O_660F00(DC,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
@@ -2674,32 +2761,42 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpaddw          , "vpaddw"          , Enc(AvxRvm_OptL)     , O_660F00(FD,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpalignr        , "vpalignr"        , Enc(AvxRvmi_OptL)    , O_660F3A(0F,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vpand           , "vpand"           , Enc(AvxRvm_OptL)     , O_660F00(DB,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpandd          , "vpandd"          , Enc(AvxRvm_OptL)     , O_660F00(DB,U,_,_,0), U                   , F(WO)|A(F_VL_KZ_B)                 , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpandn          , "vpandn"          , Enc(AvxRvm_OptL)     , O_660F00(DF,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpandnd         , "vpandnd"         , Enc(AvxRvm_OptL)     , O_660F00(DF,U,_,_,0), U                   , F(WO)|A(F_VL_KZ_B)                 , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpandnq         , "vpandnq"         , Enc(AvxRvm_OptL)     , O_660F00(DF,U,_,_,1), U                   , F(WO)|A(F_VL_KZ_B)                 , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpandq          , "vpandq"          , Enc(AvxRvm_OptL)     , O_660F00(DB,U,_,_,1), U                   , F(WO)|A(F_VL_KZ_B)                 , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpavgb          , "vpavgb"          , Enc(AvxRvm_OptL)     , O_660F00(E0,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpavgw          , "vpavgw"          , Enc(AvxRvm_OptL)     , O_660F00(E3,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpblendd        , "vpblendd"        , Enc(AvxRvmi_OptL)    , O_660F3A(02,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vpblendvb       , "vpblendvb"       , Enc(AvxRvmr)         , O_660F3A(4C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Xy)             , U                 ),
   INST(Vpblendw        , "vpblendw"        , Enc(AvxRvmi_OptL)    , O_660F3A(0E,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vpbroadcastb    , "vpbroadcastb"    , Enc(AvxRm_OptL)      , O_660F38(78,U,_,_,0), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
-  INST(Vpbroadcastd    , "vpbroadcastd"    , Enc(AvxRm_OptL)      , O_660F38(58,U,_,_,0), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
-  INST(Vpbroadcastq    , "vpbroadcastq"    , Enc(AvxRm_OptL)      , O_660F38(59,U,_,_,1), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpbroadcastd    , "vpbroadcastd"    , Enc(AvxRm_T1S)       , O_660F38(58,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ)            , EF(________), 0 , 0 , O(Xyz)            , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpbroadcastq    , "vpbroadcastq"    , Enc(AvxRm_T1S)       , O_660F38(59,U,_,_,1), U                   , F(WO)|F(Avx)|A(F_VL_KZ)            , EF(________), 0 , 0 , O(Xyz)            , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vpbroadcastw    , "vpbroadcastw"    , Enc(AvxRm_OptL)      , O_660F38(79,U,_,_,0), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vpclmulqdq      , "vpclmulqdq"      , Enc(AvxRvmi)         , O_660F3A(44,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
   INST(Vpcmov          , "vpcmov"          , Enc(XopRvrmRvmr_OptL), O_00_M08(A2,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(XyMem)          , U                 ),
+  INST(Vpcmpd          , "vpcmpd"          , Enc(AvxRvmi_OptL)    , O_660F3A(1F,U,_,_,0), U                   , F(WO)|A(F_VL_K_B)                  , EF(________), 0 , 0 , O(K)              , O(Xyz)            , O(XyzMem)         , O(Imm)            , U                 ),
   INST(Vpcmpeqb        , "vpcmpeqb"        , Enc(AvxRvm_OptL)     , O_660F00(74,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpcmpeqd        , "vpcmpeqd"        , Enc(AvxRvm_OptL)     , O_660F00(76,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpcmpeqd        , "vpcmpeqd"        , Enc(AvxRvm_OptL)     , O_660F00(76,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_K_B)           , EF(________), 0 , 0 , O(Xyz)|O(K)       , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpcmpeqq        , "vpcmpeqq"        , Enc(AvxRvm_OptL)     , O_660F38(29,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpcmpeqw        , "vpcmpeqw"        , Enc(AvxRvm_OptL)     , O_660F00(75,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpcmpestri      , "vpcmpestri"      , Enc(AvxRmi)          , O_660F3A(61,U,_,_,_), U                   , F(WO)|F(Avx)|F(Special)            , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                 ),
   INST(Vpcmpestrm      , "vpcmpestrm"      , Enc(AvxRmi)          , O_660F3A(60,U,_,_,_), U                   , F(WO)|F(Avx)|F(Special)            , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                 ),
   INST(Vpcmpgtb        , "vpcmpgtb"        , Enc(AvxRvm_OptL)     , O_660F00(64,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpcmpgtd        , "vpcmpgtd"        , Enc(AvxRvm_OptL)     , O_660F00(66,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpcmpgtd        , "vpcmpgtd"        , Enc(AvxRvm_OptL)     , O_660F00(66,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_K_B)           , EF(________), 0 , 0 , O(Xyz)|O(K)       , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpcmpgtq        , "vpcmpgtq"        , Enc(AvxRvm_OptL)     , O_660F38(37,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpcmpgtw        , "vpcmpgtw"        , Enc(AvxRvm_OptL)     , O_660F00(65,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpcmpistri      , "vpcmpistri"      , Enc(AvxRmi)          , O_660F3A(63,U,_,_,_), U                   , F(WO)|F(Avx)|F(Special)            , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                 ),
   INST(Vpcmpistrm      , "vpcmpistrm"      , Enc(AvxRmi)          , O_660F3A(62,U,_,_,_), U                   , F(WO)|F(Avx)|F(Special)            , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 , U                 ),
+  INST(Vpcmpq          , "vpcmpq"          , Enc(AvxRvmi_OptL)    , O_660F3A(1F,U,_,_,1), U                   , F(WO)|A(F_VL_K_B)                  , EF(________), 0 , 0 , O(K)              , O(Xyz)            , O(XyzMem)         , O(Imm)            , U                 ),
+  INST(Vpcmpud         , "vpcmpud"         , Enc(AvxRvmi_OptL)    , O_660F3A(1E,U,_,_,0), U                   , F(WO)|A(F_VL_K_B)                  , EF(________), 0 , 0 , O(K)              , O(Xyz)            , O(XyzMem)         , O(Imm)            , U                 ),
+  INST(Vpcmpuq         , "vpcmpuq"         , Enc(AvxRvmi_OptL)    , O_660F3A(1E,U,_,_,1), U                   , F(WO)|A(F_VL_K_B)                  , EF(________), 0 , 0 , O(K)              , O(Xyz)            , O(XyzMem)         , O(Imm)            , U                 ),
   INST(Vpcomb          , "vpcomb"          , Enc(XopRvmi)         , O_00_M08(CC,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
   INST(Vpcomd          , "vpcomd"          , Enc(XopRvmi)         , O_00_M08(CE,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
+  INST(Vpcompressd     , "vpcompressd"     , Enc(AvxMr_T1S)       , O_660F38(8B,U,_,_,0), U                   , F(WO)|A(F_VL_KZ)                   , EF(________), 0 , 0 , O(XyzMem)         , O(Xyz)            , U                 , U                 , U                 ),
+  INST(Vpcompressq     , "vpcompressq"     , Enc(AvxMr_T1S)       , O_660F38(8B,U,_,_,1), U                   , F(WO)|A(F_VL_KZ)                   , EF(________), 0 , 0 , O(XyzMem)         , O(Xyz)            , U                 , U                 , U                 ),
   INST(Vpcomq          , "vpcomq"          , Enc(XopRvmi)         , O_00_M08(CF,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
   INST(Vpcomub         , "vpcomub"         , Enc(XopRvmi)         , O_00_M08(EC,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
   INST(Vpcomud         , "vpcomud"         , Enc(XopRvmi)         , O_00_M08(EE,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(Imm)            , U                 ),
@@ -2716,6 +2813,8 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpermpd         , "vpermpd"         , Enc(AvxRmi)          , O_660F3A(01,U,L,W,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(YmmMem)         , O(Imm)            , U                 , U                 ),
   INST(Vpermps         , "vpermps"         , Enc(AvxRvm)          , O_660F38(16,U,L,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(Ymm)            , O(YmmMem)         , U                 , U                 ),
   INST(Vpermq          , "vpermq"          , Enc(AvxRmi)          , O_660F3A(00,U,L,W,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Ymm)            , O(YmmMem)         , O(Imm)            , U                 , U                 ),
+  INST(Vpexpandd       , "vpexpandd"       , Enc(AvxRm_T1S)       , O_660F38(89,U,_,_,0), U                   , F(WO)|A(F_VL_KZ)                   , EF(________), 0 , 0 , O(Xyz)            , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vpexpandq       , "vpexpandq"       , Enc(AvxRm_T1S)       , O_660F38(89,U,_,_,1), U                   , F(WO)|A(F_VL_KZ)                   , EF(________), 0 , 0 , O(Xyz)            , O(XyzMem)         , U                 , U                 , U                 ),
   INST(Vpextrb         , "vpextrb"         , Enc(AvxMri)          , O_660F3A(14,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(GqdwbMem)       , O(Xmm)            , O(Imm)            , U                 , U                 ),
   INST(Vpextrd         , "vpextrd"         , Enc(AvxMri)          , O_660F3A(16,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(GqdMem)         , O(Xmm)            , O(Imm)            , U                 , U                 ),
   INST(Vpextrq         , "vpextrq"         , Enc(AvxMri)          , O_660F3A(16,U,_,W,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(GqMem)          , O(Xmm)            , O(Imm)            , U                 , U                 ),
@@ -2779,26 +2878,28 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpminud         , "vpminud"         , Enc(AvxRvm_OptL)     , O_660F38(3B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpminuw         , "vpminuw"         , Enc(AvxRvm_OptL)     , O_660F38(3A,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpmovmskb       , "vpmovmskb"       , Enc(AvxRm_OptL)      , O_660F00(D7,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Gqd)            , O(Xy)             , U                 , U                 , U                 ),
-  INST(Vpmovsxbd       , "vpmovsxbd"       , Enc(AvxRm_OptL)      , O_660F38(21,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vpmovsxbq       , "vpmovsxbq"       , Enc(AvxRm_OptL)      , O_660F38(22,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vpmovsxbw       , "vpmovsxbw"       , Enc(AvxRm_OptL)      , O_660F38(20,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vpmovsxdq       , "vpmovsxdq"       , Enc(AvxRm_OptL)      , O_660F38(25,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vpmovsxwd       , "vpmovsxwd"       , Enc(AvxRm_OptL)      , O_660F38(23,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vpmovsxwq       , "vpmovsxwq"       , Enc(AvxRm_OptL)      , O_660F38(24,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vpmovzxbd       , "vpmovzxbd"       , Enc(AvxRm_OptL)      , O_660F38(31,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vpmovzxbq       , "vpmovzxbq"       , Enc(AvxRm_OptL)      , O_660F38(32,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vpmovzxbw       , "vpmovzxbw"       , Enc(AvxRm_OptL)      , O_660F38(30,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vpmovzxdq       , "vpmovzxdq"       , Enc(AvxRm_OptL)      , O_660F38(35,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vpmovzxwd       , "vpmovzxwd"       , Enc(AvxRm_OptL)      , O_660F38(33,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vpmovzxwq       , "vpmovzxwq"       , Enc(AvxRm_OptL)      , O_660F38(34,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
+  INST(Vpmovsxbd       , "vpmovsxbd"       , Enc(AvxRm_OptL)      , O_660F38(21,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpmovsxbq       , "vpmovsxbq"       , Enc(AvxRm_OptL)      , O_660F38(22,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpmovsxbw       , "vpmovsxbw"       , Enc(AvxRm_OptL)      , O_660F38(20,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpmovsxdq       , "vpmovsxdq"       , Enc(AvxRm_OptL)      , O_660F38(25,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpmovsxwd       , "vpmovsxwd"       , Enc(AvxRm_OptL)      , O_660F38(23,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpmovsxwq       , "vpmovsxwq"       , Enc(AvxRm_OptL)      , O_660F38(24,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpmovzxbd       , "vpmovzxbd"       , Enc(AvxRm_OptL)      , O_660F38(31,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpmovzxbq       , "vpmovzxbq"       , Enc(AvxRm_OptL)      , O_660F38(32,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpmovzxbw       , "vpmovzxbw"       , Enc(AvxRm_OptL)      , O_660F38(30,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpmovzxdq       , "vpmovzxdq"       , Enc(AvxRm_OptL)      , O_660F38(35,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpmovzxwd       , "vpmovzxwd"       , Enc(AvxRm_OptL)      , O_660F38(33,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
+  INST(Vpmovzxwq       , "vpmovzxwq"       , Enc(AvxRm_OptL)      , O_660F38(34,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XmmMem)         , U                 , U                 , U                 ),
   INST(Vpmuldq         , "vpmuldq"         , Enc(AvxRvm_OptL)     , O_660F38(28,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpmulhrsw       , "vpmulhrsw"       , Enc(AvxRvm_OptL)     , O_660F38(0B,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpmulhuw        , "vpmulhuw"        , Enc(AvxRvm_OptL)     , O_660F00(E4,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpmulhw         , "vpmulhw"         , Enc(AvxRvm_OptL)     , O_660F00(E5,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpmulld         , "vpmulld"         , Enc(AvxRvm_OptL)     , O_660F38(40,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpmulld         , "vpmulld"         , Enc(AvxRvm_OptL)     , O_660F38(40,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B)          , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpmullw         , "vpmullw"         , Enc(AvxRvm_OptL)     , O_660F00(D5,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpmuludq        , "vpmuludq"        , Enc(AvxRvm_OptL)     , O_660F00(F4,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpor            , "vpor"            , Enc(AvxRvm_OptL)     , O_660F00(EB,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpord           , "vpord"           , Enc(AvxRvm_OptL)     , O_660F00(EB,U,_,_,0), U                   , F(WO)|A(F_VL_KZ_B)                 , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vporq           , "vporq"           , Enc(AvxRvm_OptL)     , O_660F00(EB,U,_,_,1), U                   , F(WO)|A(F_VL_KZ_B)                 , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpperm          , "vpperm"          , Enc(XopRvrmRvmr)     , O_00_M08(A3,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , O(XmmMem)         , U                 ),
   INST(Vprotb          , "vprotb"          , Enc(XopRvmRmi)       , O_00_M09(90,U,_,_,_), O_00_M08(C0,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(XmmMem)|O(Imm)  , U                 , U                 ),
   INST(Vprotd          , "vprotd"          , Enc(XopRvmRmi)       , O_00_M09(92,U,_,_,_), O_00_M08(C2,U,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(XmmMem)|O(Imm)  , U                 , U                 ),
@@ -2814,36 +2915,42 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpshlq          , "vpshlq"          , Enc(XopRvmRmv)       , O_00_M09(97,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(XmmMem)         , U                 , U                 ),
   INST(Vpshlw          , "vpshlw"          , Enc(XopRvmRmv)       , O_00_M09(95,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , O(XmmMem)         , U                 , U                 ),
   INST(Vpshufb         , "vpshufb"         , Enc(AvxRvm_OptL)     , O_660F38(00,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpshufd         , "vpshufd"         , Enc(AvxRmi_OptL)     , O_660F00(70,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(Imm)            , U                 , U                 ),
+  INST(Vpshufd         , "vpshufd"         , Enc(AvxRmi_OptL)     , O_660F00(70,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B)          , EF(________), 0 , 0 , O(Xyz)            , O(XyzMem)         , O(Imm)            , U                 , U                 ),
   INST(Vpshufhw        , "vpshufhw"        , Enc(AvxRmi_OptL)     , O_F30F00(70,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(Imm)            , U                 , U                 ),
   INST(Vpshuflw        , "vpshuflw"        , Enc(AvxRmi_OptL)     , O_F20F00(70,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(Imm)            , U                 , U                 ),
   INST(Vpsignb         , "vpsignb"         , Enc(AvxRvm_OptL)     , O_660F38(08,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsignd         , "vpsignd"         , Enc(AvxRvm_OptL)     , O_660F38(0A,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsignw         , "vpsignw"         , Enc(AvxRvm_OptL)     , O_660F38(09,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpslld          , "vpslld"          , Enc(AvxRvmVmi_OptL)  , O_660F00(F2,U,_,_,_), O_660F00(72,6,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                 ),
+  INST(Vpslld          , "vpslld"          , Enc(AvxRvmVmi_OptL)  , O_660F00(F2,U,_,_,_), O_660F00(72,6,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                 ),
   INST(Vpslldq         , "vpslldq"         , Enc(AvxVmi_OptL)     , O_660F00(73,7,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(Imm)            , U                 , U                 ),
-  INST(Vpsllq          , "vpsllq"          , Enc(AvxRvmVmi_OptL)  , O_660F00(F3,U,_,_,_), O_660F00(73,6,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                 ),
+  INST(Vpsllq          , "vpsllq"          , Enc(AvxRvmVmi_OptL)  , O_660F00(F3,U,_,_,_), O_660F00(73,6,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                 ),
   INST(Vpsllvd         , "vpsllvd"         , Enc(AvxRvm_OptL)     , O_660F38(47,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsllvq         , "vpsllvq"         , Enc(AvxRvm_OptL)     , O_660F38(47,U,_,W,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpsllw          , "vpsllw"          , Enc(AvxRvmVmi_OptL)  , O_660F00(F1,U,_,_,_), O_660F00(71,6,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                 ),
-  INST(Vpsrad          , "vpsrad"          , Enc(AvxRvmVmi_OptL)  , O_660F00(E2,U,_,_,_), O_660F00(72,4,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                 ),
+  INST(Vpsllw          , "vpsllw"          , Enc(AvxRvmVmi_OptL)  , O_660F00(F1,U,_,_,_), O_660F00(71,6,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                 ),
+  INST(Vpsrad          , "vpsrad"          , Enc(AvxRvmVmi_OptL)  , O_660F00(E2,U,_,_,_), O_660F00(72,4,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                 ),
   INST(Vpsravd         , "vpsravd"         , Enc(AvxRvm_OptL)     , O_660F38(46,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpsraw          , "vpsraw"          , Enc(AvxRvmVmi_OptL)  , O_660F00(E1,U,_,_,_), O_660F00(71,4,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                 ),
-  INST(Vpsrld          , "vpsrld"          , Enc(AvxRvmVmi_OptL)  , O_660F00(D2,U,_,_,_), O_660F00(72,2,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                 ),
+  INST(Vpsraw          , "vpsraw"          , Enc(AvxRvmVmi_OptL)  , O_660F00(E1,U,_,_,_), O_660F00(71,4,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                 ),
+  INST(Vpsrld          , "vpsrld"          , Enc(AvxRvmVmi_OptL)  , O_660F00(D2,U,_,_,_), O_660F00(72,2,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                 ),
   INST(Vpsrldq         , "vpsrldq"         , Enc(AvxVmi_OptL)     , O_660F00(73,3,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(Imm)            , U                 , U                 ),
-  INST(Vpsrlq          , "vpsrlq"          , Enc(AvxRvmVmi_OptL)  , O_660F00(D3,U,_,_,_), O_660F00(73,2,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                 ),
+  INST(Vpsrlq          , "vpsrlq"          , Enc(AvxRvmVmi_OptL)  , O_660F00(D3,U,_,_,_), O_660F00(73,2,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                 ),
   INST(Vpsrlvd         , "vpsrlvd"         , Enc(AvxRvm_OptL)     , O_660F38(45,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsrlvq         , "vpsrlvq"         , Enc(AvxRvm_OptL)     , O_660F38(45,U,_,W,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpsrlw          , "vpsrlw"          , Enc(AvxRvmVmi_OptL)  , O_660F00(D1,U,_,_,_), O_660F00(71,2,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XyMem)|O(Imm)   , U                 , U                 ),
+  INST(Vpsrlw          , "vpsrlw"          , Enc(AvxRvmVmi_OptL)  , O_660F00(D1,U,_,_,_), O_660F00(71,2,_,_,_), F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(XmmMem)|O(Imm)  , U                 , U                 ),
   INST(Vpsubb          , "vpsubb"          , Enc(AvxRvm_OptL)     , O_660F00(F8,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpsubd          , "vpsubd"          , Enc(AvxRvm_OptL)     , O_660F00(FA,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vpsubq          , "vpsubq"          , Enc(AvxRvm_OptL)     , O_660F00(FB,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpsubd          , "vpsubd"          , Enc(AvxRvm_OptL)     , O_660F00(FA,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B)          , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpsubq          , "vpsubq"          , Enc(AvxRvm_OptL)     , O_660F00(FB,U,_,_,1), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B)          , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpsubsb         , "vpsubsb"         , Enc(AvxRvm_OptL)     , O_660F00(E8,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsubsw         , "vpsubsw"         , Enc(AvxRvm_OptL)     , O_660F00(E9,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsubusb        , "vpsubusb"        , Enc(AvxRvm_OptL)     , O_660F00(D8,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsubusw        , "vpsubusw"        , Enc(AvxRvm_OptL)     , O_660F00(D9,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpsubw          , "vpsubw"          , Enc(AvxRvm_OptL)     , O_660F00(F9,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpternlogd      , "vpternlogd"      , Enc(AvxRvmi_OptL)    , O_660F3A(25,U,_,_,0), U                   , F(RW)|A(F_VL_KZ_B)                 , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , O(Imm)            , U                 ),
+  INST(Vpternlogq      , "vpternlogq"      , Enc(AvxRvmi_OptL)    , O_660F3A(25,U,_,_,1), U                   , F(RW)|A(F_VL_KZ_B)                 , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , O(Imm)            , U                 ),
   INST(Vptest          , "vptest"          , Enc(AvxRm_OptL)      , O_660F38(17,U,_,_,_), U                   , F(RO)|F(Avx)                       , EF(WWWWWW__), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
+  INST(Vptestmd        , "vptestmd"        , Enc(AvxRvm_OptL)     , O_660F38(27,U,_,_,0), U                   , F(WO)|A(F_VL_K_B)                  , EF(________), 0 , 0 , O(K)              , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vptestmq        , "vptestmq"        , Enc(AvxRvm_OptL)     , O_660F38(27,U,_,_,1), U                   , F(WO)|A(F_VL_K_B)                  , EF(________), 0 , 0 , O(K)              , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vptestnmd       , "vptestnmd"       , Enc(AvxRvm_OptL)     , O_F30F38(27,U,_,_,0), U                   , F(WO)|A(F_VL_K_B)                  , EF(________), 0 , 0 , O(K)              , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vptestnmq       , "vptestnmq"       , Enc(AvxRvm_OptL)     , O_F30F38(27,U,_,_,1), U                   , F(WO)|A(F_VL_K_B)                  , EF(________), 0 , 0 , O(K)              , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vpunpckhbw      , "vpunpckhbw"      , Enc(AvxRvm_OptL)     , O_660F00(68,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpunpckhdq      , "vpunpckhdq"      , Enc(AvxRvm_OptL)     , O_660F00(6A,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpunpckhqdq     , "vpunpckhqdq"     , Enc(AvxRvm_OptL)     , O_660F00(6D,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
@@ -2853,6 +2960,8 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vpunpcklqdq     , "vpunpcklqdq"     , Enc(AvxRvm_OptL)     , O_660F00(6C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpunpcklwd      , "vpunpcklwd"      , Enc(AvxRvm_OptL)     , O_660F00(61,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
   INST(Vpxor           , "vpxor"           , Enc(AvxRvm_OptL)     , O_660F00(EF,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vpxord          , "vpxord"          , Enc(AvxRvm_OptL)     , O_660F00(EF,U,_,_,0), U                   , F(WO)|A(F_VL_KZ_B)                 , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vpxorq          , "vpxorq"          , Enc(AvxRvm_OptL)     , O_660F00(EF,U,_,_,1), U                   , F(WO)|A(F_VL_KZ_B)                 , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vrcpps          , "vrcpps"          , Enc(AvxRm_OptL)      , O_000F00(53,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
   INST(Vrcpss          , "vrcpss"          , Enc(AvxRvm)          , O_F30F00(53,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vroundpd        , "vroundpd"        , Enc(AvxRmi_OptL)     , O_660F3A(09,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , O(Imm)            , U                 , U                 ),
@@ -2863,13 +2972,13 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Vrsqrtss        , "vrsqrtss"        , Enc(AvxRvm)          , O_F30F00(52,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vshufpd         , "vshufpd"         , Enc(AvxRvmi_OptL)    , O_660F00(C6,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
   INST(Vshufps         , "vshufps"         , Enc(AvxRvmi_OptL)    , O_000F00(C6,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , O(Imm)            , U                 ),
-  INST(Vsqrtpd         , "vsqrtpd"         , Enc(AvxRm_OptL)      , O_660F00(51,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
-  INST(Vsqrtps         , "vsqrtps"         , Enc(AvxRm_OptL)      , O_000F00(51,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
+  INST(Vsqrtpd         , "vsqrtpd"         , Enc(AvxRm_OptL)      , O_660F00(51,U,_,_,1), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , EF(________), 0 , 0 , O(Xyz)            , O(XyzMem)         , U                 , U                 , U                 ),
+  INST(Vsqrtps         , "vsqrtps"         , Enc(AvxRm_OptL)      , O_000F00(51,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , EF(________), 0 , 0 , O(Xyz)            , O(XyzMem)         , U                 , U                 , U                 ),
   INST(Vsqrtsd         , "vsqrtsd"         , Enc(AvxRvm)          , O_F20F00(51,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vsqrtss         , "vsqrtss"         , Enc(AvxRvm)          , O_F30F00(51,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vstmxcsr        , "vstmxcsr"        , Enc(AvxM)            , O_000F00(AE,3,_,_,_), U                   , F(Volatile)|F(Avx)                 , EF(________), 0 , 0 , O(Mem)            , U                 , U                 , U                 , U                 ),
-  INST(Vsubpd          , "vsubpd"          , Enc(AvxRvm_OptL)     , O_660F00(5C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
-  INST(Vsubps          , "vsubps"          , Enc(AvxRvm_OptL)     , O_000F00(5C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xy)             , O(Xy)             , O(XyMem)          , U                 , U                 ),
+  INST(Vsubpd          , "vsubpd"          , Enc(AvxRvm_OptL)     , O_660F00(5C,U,_,_,1), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
+  INST(Vsubps          , "vsubps"          , Enc(AvxRvm_OptL)     , O_000F00(5C,U,_,_,0), U                   , F(WO)|F(Avx)|A(F_VL_KZ_B_Rnd)      , EF(________), 0 , 0 , O(Xyz)            , O(Xyz)            , O(XyzMem)         , U                 , U                 ),
   INST(Vsubsd          , "vsubsd"          , Enc(AvxRvm)          , O_F20F00(5C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vsubss          , "vsubss"          , Enc(AvxRvm)          , O_F30F00(5C,U,_,_,_), U                   , F(WO)|F(Avx)                       , EF(________), 0 , 0 , O(Xmm)            , O(Xmm)            , O(XmmMem)         , U                 , U                 ),
   INST(Vtestpd         , "vtestpd"         , Enc(AvxRm_OptL)      , O_660F38(0F,U,_,_,_), U                   , F(RO)|F(Avx)                       , EF(WWWWWW__), 0 , 0 , O(Xy)             , O(XyMem)          , U                 , U                 , U                 ),
@@ -2887,7 +2996,7 @@ const X86InstInfo _x86InstInfo[] = {
   INST(Wrfsbase        , "wrfsbase"        , Enc(X86Rm)           , O_F30F00(AE,2,_,_,_), U                   , F(RO)|F(Volatile)                  , EF(________), 0 , 0 , O(Gqd)            , U                 , U                 , U                 , U                 ),
   INST(Wrgsbase        , "wrgsbase"        , Enc(X86Rm)           , O_F30F00(AE,3,_,_,_), U                   , F(RO)|F(Volatile)                  , EF(________), 0 , 0 , O(Gqd)            , U                 , U                 , U                 , U                 ),
   INST(Xadd            , "xadd"            , Enc(X86Xadd)         , O_000F00(C0,U,_,_,_), U                   , F(RW)|F(Xchg)|F(Lock)              , EF(WWWWWW__), 0 , 0 , O(GqdwbMem)       , O(Gqdwb)          , U                 , U                 , U                 ),
-  INST(Xchg            , "xchg"            , Enc(X86Xchg)         , O_000000(86,U,_,_,_), U                   , F(RW)|F(Xchg)|F(Lock)              , EF(________), 0 , 0 , O(GqdwbMem)       , O(Gqdwb)          , U                 , U                 , U                 ),
+  INST(Xchg            , "xchg"            , Enc(X86Xchg)         , O_000000(86,U,_,_,_), U                   , F(RW)|F(Xchg)|F(Lock)              , EF(________), 0 , 0 , O(GqdwbMem)       , O(GqdwbMem)       , U                 , U                 , U                 ),
   INST(Xgetbv          , "xgetbv"          , Enc(X86Op)           , O_000F01(D0,U,_,_,_), U                   , F(WO)|F(Special)                   , EF(________), 0 , 0 , U                 , U                 , U                 , U                 , U                 ),
   INST(Xor             , "xor"             , Enc(X86Arith)        , O_000000(30,6,_,_,_), U                   , F(RW)|F(Lock)                      , EF(WWWUWW__), 0 , 0 , O(GqdwbMem)       , O(GqdwbMem)|O(Imm), U                 , U                 , U                 ),
   INST(Xorpd           , "xorpd"           , Enc(SimdRm)          , O_660F00(57,U,_,_,_), U                   , F(RW)|F(None)                      , EF(________), 0 , 0 , O(Xmm)            , O(XmmMem)         , U                 , U                 , U                 ),
@@ -3053,6 +3162,194 @@ const char* X86Util::getInstNameById(uint32_t id) noexcept {
 }
 #endif // ASMJIT_DISABLE_TEXT
 
+// ============================================================================
+// [asmjit::X86Util - Validation]
+// ============================================================================
+
+//! \internal
+enum {
+  kX86ValidateGpMask = kX86InstOpGb  | kX86InstOpGw  | kX86InstOpGd | kX86InstOpGq,
+  kX86ValidateVecMask = kX86InstOpXmm | kX86InstOpYmm | kX86InstOpZmm,
+
+  kX86ValidateFeatureMask = kX86InstFlagAvx      | kX86InstFlagXop      |
+                            kX86InstFlagAvx512F  | kX86InstFlagAvx512CD |
+                            kX86InstFlagAvx512PF | kX86InstFlagAvx512ER |
+                            kX86InstFlagAvx512DQ | kX86InstFlagAvx512BW,
+
+  kX86ValidateEvexOptions = kX86InstOptionEvex      | kX86InstOptionEvexZero  |
+                            kX86InstOptionEvexOneN  | kX86InstOptionEvexSae   |
+                            kX86InstOptionEvexRnSae | kX86InstOptionEvexRdSae |
+                            kX86InstOptionEvexRuSae | kX86InstOptionEvexRzSae |
+                            kX86InstOptionEvexK
+};
+
+//! \internal
+//!
+//! Operand flag of each register type indexed by `regType >> 4`, zero if the
+//! register is not described by the instruction table (RIP and segment).
+static const uint16_t _x86ValidateRegOpFlag[16] = {
+  kX86InstOpGb , kX86InstOpGw , kX86InstOpGd , kX86InstOpGq ,
+  kX86InstOpFp , kX86InstOpMm , kX86InstOpK  , kX86InstOpXmm,
+  kX86InstOpYmm, kX86InstOpZmm, 0            , 0            ,
+  0            , 0            , 0            , 0
+};
+
+//! \internal
+//!
+//! Get whether the CPU features required by an instruction having `instFlags`
+//! are provided by `cpuInfo`. `evex` is true if the instruction is encoded by
+//! EVEX prefix and `zmm` if it uses a ZMM register.
+static ASMJIT_INLINE bool X86Util_hasFeatures(const CpuInfo* cpuInfo, uint32_t instFlags, bool evex, bool zmm) noexcept {
+  static const uint32_t avx512Map[][2] = {
+    { kX86InstFlagAvx512F , CpuInfo::kX86FeatureAVX512F  },
+    { kX86InstFlagAvx512CD, CpuInfo::kX86FeatureAVX512CD },
+    { kX86InstFlagAvx512PF, CpuInfo::kX86FeatureAVX512PF },
+    { kX86InstFlagAvx512ER, CpuInfo::kX86FeatureAVX512ER },
+    { kX86InstFlagAvx512DQ, CpuInfo::kX86FeatureAVX512DQ },
+    { kX86InstFlagAvx512BW, CpuInfo::kX86FeatureAVX512BW }
+  };
+
+  if ((instFlags & kX86InstFlagXop) != 0 && !cpuInfo->hasFeature(CpuInfo::kX86FeatureXOP))
+    return false;
+
+  // Instructions that have both VEX and EVEX forms only need AVX if VEX is used.
+  if (!evex && (instFlags & kX86InstFlagAvx) != 0)
+    return cpuInfo->hasFeature(CpuInfo::kX86FeatureAVX);
+
+  for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(avx512Map); i++) {
+    if ((instFlags & avx512Map[i][0]) != 0 && !cpuInfo->hasFeature(avx512Map[i][1]))
+      return false;
+  }
+
+  // XMM and YMM forms of AVX-512 instructions require VL.
+  if (evex && !zmm && (instFlags & kX86InstFlagAvx512VL) != 0)
+    return cpuInfo->hasFeature(CpuInfo::kX86FeatureAVX512VL);
+
+  return true;
+}
+
+Error X86Util::validateInst(uint32_t arch, const CpuInfo* cpuInfo,
+  uint32_t instId, uint32_t options, const Operand* opList, uint32_t opCount) noexcept {
+
+  if (instId == kInstIdNone || instId >= _kX86InstIdCount)
+    return kErrorUnknownInst;
+
+  const X86InstExtendedInfo& extendedInfo = _x86InstInfo[instId].getExtendedInfo();
+  uint32_t instFlags = extendedInfo.getFlags();
+
+  if ((options & kX86InstOptionLock) != 0 && (instFlags & kX86InstFlagLock) == 0)
+    return kErrorIllegalInst;
+
+  // Operand flags of all operands, combined flags, and physical registers.
+  // Operands that follow the first `kTypeNone` operand are not used.
+  uint32_t opFlags[5];
+  uint32_t allFlags = 0;
+  uint32_t regs = 0;
+  bool hasVar = false;
+
+  uint32_t i;
+  uint32_t maxIndex = arch == kArchX86 ? 8 : 32;
+
+  ASMJIT_ASSERT(opCount <= ASMJIT_ARRAY_SIZE(opFlags));
+  for (i = 0; i < opCount; i++) {
+    const Operand& op = opList[i];
+    uint32_t opType = op.getOp();
+    uint32_t flags;
+
+    if (opType == Operand::kTypeReg || opType == Operand::kTypeVar) {
+      flags = _x86ValidateRegOpFlag[op.getRegType() >> 4];
+
+      if (opType == Operand::kTypeVar) {
+        hasVar = true;
+      }
+      else {
+        uint32_t index = static_cast<const Reg&>(op).getRegIndex();
+        if (index >= maxIndex)
+          return kErrorInvalidArch;
+        regs |= index;
+      }
+    }
+    else if (opType == Operand::kTypeMem) {
+      flags = kX86InstOpMem;
+
+      // Only check physical registers, variables are checked by `X86Compiler`.
+      const X86Mem& m = static_cast<const X86Mem&>(op);
+      if (arch == kArchX86 && m.isBaseIndexType()) {
+        uint32_t base = m.getBase();
+        uint32_t index = m.getIndex();
+
+        if (m.hasBase() && !OperandUtil::isVarId(base) && (base >= 8 || !m.hasGpdBase()))
+          return kErrorInvalidArch;
+
+        if (m.hasIndex() && !OperandUtil::isVarId(index) && index >= 8)
+          return kErrorInvalidArch;
+      }
+    }
+    else if (opType == Operand::kTypeImm) {
+      flags = kX86InstOpImm;
+    }
+    else if (opType == Operand::kTypeLabel) {
+      flags = kX86InstOpLabel;
+    }
+    else {
+      break;
+    }
+
+    opFlags[i] = flags;
+    allFlags |= flags;
+  }
+
+  uint32_t count = i;
+  for (; i < ASMJIT_ARRAY_SIZE(opFlags); i++)
+    opFlags[i] = kX86InstOpNone;
+
+  if (arch == kArchX86 && (allFlags & kX86InstOpGq) != 0)
+    return kErrorInvalidArch;
+
+  // Instructions with implicit operands don't describe them, nothing to check.
+  // Missing operands are not checked as the table doesn't mark all optional
+  // operands (X87 and string instructions mostly). Special instructions are
+  // not checked when used by `X86Compiler`, which passes implicit operands
+  // as variables of any size (like `shl(var, count)` or `rep_movsb(...)`).
+  uint32_t f0 = extendedInfo.getOperandFlags(0);
+  if (f0 != 0 && !(hasVar && (instFlags & kX86InstFlagSpecial) != 0)) {
+    for (i = 0; i < count; i++) {
+      uint32_t flags = opFlags[i];
+      if (flags != 0 && (flags & extendedInfo.getOperandFlags(i)) == 0)
+        return kErrorIllegalOperand;
+    }
+
+    // GP registers have to match if the instruction accepts the same sizes.
+    uint32_t f1 = extendedInfo.getOperandFlags(1);
+    if ((opFlags[0] & kX86ValidateGpMask) != 0 &&
+        (opFlags[1] & kX86ValidateGpMask) != 0 &&
+        (f0 & kX86ValidateGpMask) == (f1 & kX86ValidateGpMask) && opFlags[0] != opFlags[1])
+      return kErrorIllegalOperand;
+
+    // The same for vector registers, which can be the first three operands.
+    for (i = 1; i < 3; i++) {
+      if ((opFlags[0] & kX86ValidateVecMask) != 0 &&
+          (opFlags[i] & kX86ValidateVecMask) != 0 &&
+          (f0 & kX86ValidateVecMask) == (extendedInfo.getOperandFlags(i) & kX86ValidateVecMask) && opFlags[0] != opFlags[i])
+        return kErrorIllegalOperand;
+    }
+  }
+
+  if ((instFlags & kX86ValidateFeatureMask) != 0 && cpuInfo != nullptr &&
+      (cpuInfo->getArch() == kArchX86 || cpuInfo->getArch() == kArchX64)) {
+    // The same rules as used by `X86Assembler` to select EVEX over VEX.
+    bool zmm = (allFlags & kX86InstOpZmm) != 0;
+    bool evex = (options & kX86ValidateEvexOptions) != 0 ||
+                ((instFlags & kX86InstFlagAvx512KMask) != 0 &&
+                 ((instFlags & kX86InstFlagAvx) == 0 || (regs & 0x10) != 0 || zmm || opFlags[0] == kX86InstOpK));
+
+    if (!X86Util_hasFeatures(cpuInfo, instFlags, evex, zmm))
+      return kErrorMissingCpuFeature;
+  }
+
+  return kErrorOk;
+}
+
 // ============================================================================
 // [asmjit::X86Util - Test]
 // ============================================================================
@@ -3085,6 +3382,75 @@ UNIT(x86_inst_name) {
 }
 #endif // ASMJIT_TEST && !ASMJIT_DISABLE_TEXT
 
+#if defined(ASMJIT_TEST)
+static Error X86InstTest_validate(uint32_t arch, const CpuInfo* cpuInfo, uint32_t instId, uint32_t options,
+  const Operand& o0, const Operand& o1 = noOperand, const Operand& o2 = noOperand) noexcept {
+
+  Operand opList[3] = { o0, o1, o2 };
+  return X86Util::validateInst(arch, cpuInfo, instId, options, opList, 3);
+}
+
+UNIT(x86_inst_validate) {
+  CpuInfo noAvx;
+  noAvx.setArch(kArchX64);
+
+  CpuInfo avx;
+  avx.setArch(kArchX64);
+  avx.addFeature(CpuInfo::kX86FeatureAVX);
+
+  CpuInfo avx512;
+  avx512.setArch(kArchX64);
+  avx512.addFeature(CpuInfo::kX86FeatureAVX);
+  avx512.addFeature(CpuInfo::kX86FeatureAVX512F);
+
+  INFO("Validating operands.");
+  EXPECT(X86InstTest_validate(kArchX64, nullptr, kX86InstIdAdd, 0, x86::eax, x86::ecx) == kErrorOk,
+    "Should accept `add eax, ecx`.");
+  EXPECT(X86InstTest_validate(kArchX64, nullptr, kX86InstIdAdd, 0, x86::rax, x86::ptr(x86::r8, x86::r9, 2)) == kErrorOk,
+    "Should accept `add rax, [r8 + r9 * 4]`.");
+  EXPECT(X86InstTest_validate(kArchX64, nullptr, kX86InstIdAdd, 0, x86::eax, x86::rcx) == kErrorIllegalOperand,
+    "Should refuse `add eax, rcx`.");
+  EXPECT(X86InstTest_validate(kArchX64, nullptr, kX86InstIdAdd, 0, x86::eax, x86::xmm0) == kErrorIllegalOperand,
+    "Should refuse `add eax, xmm0`.");
+  EXPECT(X86InstTest_validate(kArchX64, nullptr, kX86InstIdMovzx, 0, x86::eax, x86::cx) == kErrorOk,
+    "Should accept `movzx eax, cx`.");
+  EXPECT(X86InstTest_validate(kArchX64, nullptr, kX86InstIdVaddps, 0, x86::ymm0, x86::xmm1, x86::ymm2) == kErrorIllegalOperand,
+    "Should refuse `vaddps ymm0, xmm1, ymm2`.");
+  EXPECT(X86InstTest_validate(kArchX64, nullptr, _kX86InstIdCount, 0, x86::eax) == kErrorUnknownInst,
+    "Should refuse unknown instruction.");
+
+  INFO("Validating LOCK prefix.");
+  EXPECT(X86InstTest_validate(kArchX64, nullptr, kX86InstIdAdd, kX86InstOptionLock, x86::dword_ptr(x86::rax), x86::ecx) == kErrorOk,
+    "Should accept `lock add [rax], ecx`.");
+  EXPECT(X86InstTest_validate(kArchX64, nullptr, kX86InstIdMov, kX86InstOptionLock, x86::dword_ptr(x86::rax), x86::ecx) == kErrorIllegalInst,
+    "Should refuse `lock mov [rax], ecx`.");
+
+  INFO("Validating architecture.");
+  EXPECT(X86InstTest_validate(kArchX86, nullptr, kX86InstIdAdd, 0, x86::rax, x86::rcx) == kErrorInvalidArch,
+    "Should refuse `add rax, rcx` in X86 mode.");
+  EXPECT(X86InstTest_validate(kArchX86, nullptr, kX86InstIdAdd, 0, x86::eax, x86::r8d) == kErrorInvalidArch,
+    "Should refuse `add eax, r8d` in X86 mode.");
+  EXPECT(X86InstTest_validate(kArchX86, nullptr, kX86InstIdAdd, 0, x86::eax, x86::ptr(x86::rax)) == kErrorInvalidArch,
+    "Should refuse `add eax, [rax]` in X86 mode.");
+  EXPECT(X86InstTest_validate(kArchX86, nullptr, kX86InstIdAdd, 0, x86::eax, x86::ptr(x86::eax)) == kErrorOk,
+    "Should accept `add eax, [eax]` in X86 mode.");
+
+  INFO("Validating CPU features.");
+  EXPECT(X86InstTest_validate(kArchX64, &noAvx, kX86InstIdVaddps, 0, x86::ymm0, x86::ymm1, x86::ymm2) == kErrorMissingCpuFeature,
+    "Should refuse `vaddps ymm0, ymm1, ymm2` without AVX.");
+  EXPECT(X86InstTest_validate(kArchX64, &avx, kX86InstIdVaddps, 0, x86::ymm0, x86::ymm1, x86::ymm2) == kErrorOk,
+    "Should accept `vaddps ymm0, ymm1, ymm2` with AVX.");
+  EXPECT(X86InstTest_validate(kArchX64, &avx, kX86InstIdVaddps, 0, x86::zmm0, x86::zmm1, x86::zmm2) == kErrorMissingCpuFeature,
+    "Should refuse `vaddps zmm0, zmm1, zmm2` without AVX512F.");
+  EXPECT(X86InstTest_validate(kArchX64, &avx512, kX86InstIdVaddps, 0, x86::zmm0, x86::zmm1, x86::zmm2) == kErrorOk,
+    "Should accept `vaddps zmm0, zmm1, zmm2` with AVX512F.");
+  EXPECT(X86InstTest_validate(kArchX64, &avx512, kX86InstIdVaddps, 0, x86::ymm16, x86::ymm1, x86::ymm2) == kErrorMissingCpuFeature,
+    "Should refuse `vaddps ymm16, ymm1, ymm2` without AVX512VL.");
+  EXPECT(X86InstTest_validate(kArchX64, nullptr, kX86InstIdVaddps, 0, x86::ymm16, x86::ymm1, x86::ymm2) == kErrorOk,
+    "Should skip CPU features if there is no CpuInfo.");
+}
+#endif // ASMJIT_TEST
+
 } // asmjit namespace
 
 // [Api-End]
@@ -24,6 +24,8 @@ namespace asmjit {
 // [Forward Declarations]
 // ============================================================================
 
+class CpuInfo;
+
 struct X86InstInfo;
 struct X86InstExtendedInfo;
 
@@ -358,6 +360,14 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdJz,                          // X86/X64 (jcc)
   kX86InstIdJecxz,                       // X86/X64 (jcxz/jecxz/jrcxz)
   kX86InstIdJmp,                         // X86/X64 (jmp)
+  kX86InstIdKandnw,                      // AVX512F
+  kX86InstIdKandw,                       // AVX512F
+  kX86InstIdKmovw,                       // AVX512F
+  kX86InstIdKnotw,                       // AVX512F
+  kX86InstIdKortestw,                    // AVX512F
+  kX86InstIdKorw,                        // AVX512F
+  kX86InstIdKxnorw,                      // AVX512F
+  kX86InstIdKxorw,                       // AVX512F
   kX86InstIdLahf,                        // X86/X64 (LAHF/SAHF)
   kX86InstIdLddqu,                       // SSE3
   kX86InstIdLdmxcsr,                     // SSE
@@ -896,7 +906,11 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdVmovd,                       // AVX
   kX86InstIdVmovddup,                    // AVX
   kX86InstIdVmovdqa,                     // AVX
+  kX86InstIdVmovdqa32,                   // AVX512F
+  kX86InstIdVmovdqa64,                   // AVX512F
   kX86InstIdVmovdqu,                     // AVX
+  kX86InstIdVmovdqu32,                   // AVX512F
+  kX86InstIdVmovdqu64,                   // AVX512F
   kX86InstIdVmovhlps,                    // AVX
   kX86InstIdVmovhpd,                     // AVX
   kX86InstIdVmovhps,                     // AVX
@@ -940,7 +954,11 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdVpaddw,                      // AVX2
   kX86InstIdVpalignr,                    // AVX2
   kX86InstIdVpand,                       // AVX2
+  kX86InstIdVpandd,                      // AVX512F
   kX86InstIdVpandn,                      // AVX2
+  kX86InstIdVpandnd,                     // AVX512F
+  kX86InstIdVpandnq,                     // AVX512F
+  kX86InstIdVpandq,                      // AVX512F
   kX86InstIdVpavgb,                      // AVX2
   kX86InstIdVpavgw,                      // AVX2
   kX86InstIdVpblendd,                    // AVX2
@@ -952,6 +970,7 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdVpbroadcastw,                // AVX2
   kX86InstIdVpclmulqdq,                  // AVX+PCLMULQDQ
   kX86InstIdVpcmov,                      // XOP
+  kX86InstIdVpcmpd,                      // AVX512F
   kX86InstIdVpcmpeqb,                    // AVX2
   kX86InstIdVpcmpeqd,                    // AVX2
   kX86InstIdVpcmpeqq,                    // AVX2
@@ -964,8 +983,13 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdVpcmpgtw,                    // AVX2
   kX86InstIdVpcmpistri,                  // AVX
   kX86InstIdVpcmpistrm,                  // AVX
+  kX86InstIdVpcmpq,                      // AVX512F
+  kX86InstIdVpcmpud,                     // AVX512F
+  kX86InstIdVpcmpuq,                     // AVX512F
   kX86InstIdVpcomb,                      // XOP
   kX86InstIdVpcomd,                      // XOP
+  kX86InstIdVpcompressd,                 // AVX512F
+  kX86InstIdVpcompressq,                 // AVX512F
   kX86InstIdVpcomq,                      // XOP
   kX86InstIdVpcomub,                     // XOP
   kX86InstIdVpcomud,                     // XOP
@@ -982,6 +1006,8 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdVpermpd,                     // AVX2
   kX86InstIdVpermps,                     // AVX2
   kX86InstIdVpermq,                      // AVX2
+  kX86InstIdVpexpandd,                   // AVX512F
+  kX86InstIdVpexpandq,                   // AVX512F
   kX86InstIdVpextrb,                     // AVX
   kX86InstIdVpextrd,                     // AVX
   kX86InstIdVpextrq,                     // AVX (X64)
@@ -1065,6 +1091,8 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdVpmullw,                     // AVX/AVX2
   kX86InstIdVpmuludq,                    // AVX/AVX2
   kX86InstIdVpor,                        // AVX/AVX2
+  kX86InstIdVpord,                       // AVX512F
+  kX86InstIdVporq,                       // AVX512F
   kX86InstIdVpperm,                      // XOP
   kX86InstIdVprotb,                      // XOP
   kX86InstIdVprotd,                      // XOP
@@ -1109,7 +1137,13 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdVpsubusb,                    // AVX/AVX2
   kX86InstIdVpsubusw,                    // AVX/AVX2
   kX86InstIdVpsubw,                      // AVX/AVX2
+  kX86InstIdVpternlogd,                  // AVX512F
+  kX86InstIdVpternlogq,                  // AVX512F
   kX86InstIdVptest,                      // AVX
+  kX86InstIdVptestmd,                    // AVX512F
+  kX86InstIdVptestmq,                    // AVX512F
+  kX86InstIdVptestnmd,                   // AVX512F
+  kX86InstIdVptestnmq,                   // AVX512F
   kX86InstIdVpunpckhbw,                  // AVX/AVX2
   kX86InstIdVpunpckhdq,                  // AVX/AVX2
   kX86InstIdVpunpckhqdq,                 // AVX/AVX2
@@ -1119,6 +1153,8 @@ ASMJIT_ENUM(X86InstId) {
   kX86InstIdVpunpcklqdq,                 // AVX/AVX2
   kX86InstIdVpunpcklwd,                  // AVX/AVX2
   kX86InstIdVpxor,                       // AVX/AVX2
+  kX86InstIdVpxord,                      // AVX512F
+  kX86InstIdVpxorq,                      // AVX512F
   kX86InstIdVrcpps,                      // AVX
   kX86InstIdVrcpss,                      // AVX
   kX86InstIdVroundpd,                    // AVX
@@ -1193,7 +1229,11 @@ ASMJIT_ENUM(X86InstOptions) {
   kX86InstOptionEvexRnSae = 0x00100000,  //!< EVEX 'round-to-nearest' (even) and `SAE`.
   kX86InstOptionEvexRdSae = 0x00200000,  //!< EVEX 'round-down' (toward -inf) and 'SAE'.
   kX86InstOptionEvexRuSae = 0x00400000,  //!< EVEX 'round-up' (toward +inf) and 'SAE'.
-  kX86InstOptionEvexRzSae = 0x00800000   //!< EVEX 'round-toward-zero' (truncate) and 'SAE'.
+  kX86InstOptionEvexRzSae = 0x00800000,  //!< EVEX 'round-toward-zero' (truncate) and 'SAE'.
+  kX86InstOptionEvexK     = 0x07000000,  //!< EVEX opmask register {k1..k7} (index stored in these bits).
+
+  //! Shift of the opmask register index stored in `kX86InstOptionEvexK`.
+  kX86InstOptionEvexKShift = 24
 };
 
 // ============================================================================
@@ -1274,10 +1314,12 @@ ASMJIT_ENUM(X86InstEncoding) {
   kX86InstEncodingAvxM,                  //!< AVX encoding - [M].
   kX86InstEncodingAvxMr,                 //!< AVX encoding - [MR].
   kX86InstEncodingAvxMr_OptL,            //!< AVX encoding - [MR] (Propagates AVX.L if YMM used).
+  kX86InstEncodingAvxMr_T1S,             //!< AVX encoding - [MR] (Propagates AVX.L if YMM used, EVEX disp8*N uses the element size).
   kX86InstEncodingAvxMri,                //!< AVX encoding - [MRI].
   kX86InstEncodingAvxMri_OptL,           //!< AVX encoding - [MRI] (Propagates AVX.L if YMM used).
   kX86InstEncodingAvxRm,                 //!< AVX encoding - [RM].
   kX86InstEncodingAvxRm_OptL,            //!< AVX encoding - [RM] (Propagates AVX.L if YMM used).
+  kX86InstEncodingAvxRm_T1S,             //!< AVX encoding - [RM] (Propagates AVX.L if YMM used, EVEX disp8*N uses the element size).
   kX86InstEncodingAvxRmi,                //!< AVX encoding - [RMI].
   kX86InstEncodingAvxRmi_OptW,           //!< AVX encoding - [RMI] (Propagates AVX.W if GPQ used).
   kX86InstEncodingAvxRmi_OptL,           //!< AVX encoding - [RMI] (Propagates AVX.L if YMM used).
@@ -1306,6 +1348,7 @@ ASMJIT_ENUM(X86InstEncoding) {
   kX86InstEncodingAvxVmi_OptL,           //!< AVX encoding - [VMI] (Propagates AVX.L if YMM used).
   kX86InstEncodingAvxRvrmRvmr,           //!< AVX encoding - [RVRM|RVMR].
   kX86InstEncodingAvxRvrmRvmr_OptL,      //!< AVX encoding - [RVRM|RVMR] (Propagates AVX.L if YMM used).
+  kX86InstEncodingAvxKMov,               //!< AVX encoding - kmovw.
   kX86InstEncodingAvxMovDQ,              //!< AVX encoding - vmovd, vmovq.
   kX86InstEncodingAvxMovSsSd,            //!< AVX encoding - vmovss, vmovsd.
   kX86InstEncodingAvxGather,             //!< AVX encoding - gather (VSIB).
@@ -1863,6 +1906,11 @@ struct X86InstExtendedInfo {
     return hasFlag(kX86InstFlagSpecialMem);
   }
 
+  //! Get whether the instruction must not be reordered by the scheduler.
+  ASMJIT_INLINE bool isVolatile() const noexcept {
+    return hasFlag(kX86InstFlagVolatile);
+  }
+
   //! Get whether the move instruction zeroes the rest of the register
   //! if the source is memory operand.
   //!
@@ -2105,6 +2153,51 @@ struct X86Util {
     return _x86InstInfo[instId];
   }
 
+  // --------------------------------------------------------------------------
+  // [Validation]
+  // --------------------------------------------------------------------------
+
+  //! Validate instruction `instId` with `options` and operands `opList` of
+  //! `opCount` against the operand flags stored in the instruction table.
+  //!
+  //! The following is checked:
+  //!
+  //!   - Operand kinds (register type, memory, immediate, label),
+  //!     see \ref X86InstInfo::getOperandFlags(). Instructions that don't
+  //!     describe their operands (`kX86InstFlagSpecial` ones mostly) and
+  //!     segment registers are not checked.
+  //!   - GP registers of the first two operands have the same size if these
+  //!     operands accept the same kinds of GP registers (`add`, not `movzx`).
+  //!     The same applies to vector registers of the first three operands.
+  //!   - Registers and address registers can be used by `arch`.
+  //!   - LOCK prefix is allowed.
+  //!   - CPU features required by AVX, XOP, and AVX-512 instructions are
+  //!     provided by `cpuInfo`. This is skipped if `cpuInfo` is `nullptr` or
+  //!     doesn't describe an X86/X64 CPU, the instruction table doesn't store
+  //!     features of legacy (MMX/SSE) instructions.
+  //!
+  //! Works with both registers (`X86Assembler`) and variables (`X86Compiler`).
+  //! Returns `kErrorOk` if the instruction is valid, otherwise one of
+  //! `kErrorUnknownInst`, `kErrorIllegalInst`, `kErrorIllegalOperand`,
+  //! `kErrorInvalidArch`, and `kErrorMissingCpuFeature`.
+  ASMJIT_API static Error validateInst(uint32_t arch, const CpuInfo* cpuInfo,
+    uint32_t instId, uint32_t options, const Operand* opList, uint32_t opCount) noexcept;
+
+  // --------------------------------------------------------------------------
+  // [Formatting]
+  // --------------------------------------------------------------------------
+
+#if !defined(ASMJIT_DISABLE_LOGGER)
+  //! Format instruction `instId` having `options` and operands `opList` of
+  //! `opCount` into `sb`.
+  //!
+  //! The output uses the same syntax as `X86Assembler` uses for logging,
+  //! `loggerOptions` is a combination of \ref Logger::Options.
+  ASMJIT_API static Error formatInst(StringBuilder& sb, uint32_t arch,
+    uint32_t instId, uint32_t options, const Operand* opList, uint32_t opCount,
+    uint32_t loggerOptions) noexcept;
+#endif // !ASMJIT_DISABLE_LOGGER
+
   // --------------------------------------------------------------------------
   // [Condition Codes]
   // --------------------------------------------------------------------------
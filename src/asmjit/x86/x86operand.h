@@ -1381,7 +1381,7 @@ public:
   //! Set memory operand segment, see `X86Seg`.
   ASMJIT_INLINE X86Mem& setSegment(uint32_t segIndex) noexcept {
     _vmem.flags = static_cast<uint8_t>(
-      (static_cast<uint32_t>(_vmem.flags) & kX86MemSegMask) + (segIndex << kX86MemSegIndex));
+      (static_cast<uint32_t>(_vmem.flags) & ~kX86MemSegMask) + (segIndex << kX86MemSegIndex));
     return *this;
   }
 
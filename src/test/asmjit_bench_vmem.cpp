@@ -0,0 +1,389 @@
+// [AsmJit]
+// Complete x86/x64 JIT and Remote Assembler for C++.
+//
+// [License]
+// Zlib - See LICENSE.md file in the package.
+
+// [Dependencies]
+#include "../asmjit/asmjit.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+# include <pthread.h>
+#endif // !_WIN32
+
+// ============================================================================
+// [Configuration]
+// ============================================================================
+
+static const uint32_t kNumRepeats = 3;
+static const uint32_t kNumFunctions = 20000;
+static const uint32_t kNumLive = 64;
+static const uint32_t kMaxThreads = 32;
+
+static const uint32_t kNumFragments[] = { 10000, 40000, 160000 };
+static const uint32_t kNumFragmentedOps = 1000000;
+static const uint32_t kNumLarge = 256;
+
+static const uint32_t kNumScattered = 8192;
+static const uint32_t kScatterDistance = 4096;
+static const uint32_t kNumScatteredCalls = 4000000;
+
+// ============================================================================
+// [Performance]
+// ============================================================================
+
+struct Performance {
+  static inline uint32_t now() {
+    return asmjit::Utils::getTickCount();
+  }
+
+  inline void reset() {
+    tick = 0;
+    best = 0xFFFFFFFF;
+  }
+
+  inline uint32_t start() {
+    return (tick = now());
+  }
+
+  inline uint32_t diff() const {
+    return now() - tick;
+  }
+
+  inline uint32_t end() {
+    tick = diff();
+    if (best > tick)
+      best = tick;
+    return tick;
+  }
+
+  uint32_t tick;
+  uint32_t best;
+};
+
+// ============================================================================
+// [Thread]
+// ============================================================================
+
+typedef void (*ThreadFunc)(void* arg);
+
+struct ThreadData {
+  ThreadFunc func;
+  void* arg;
+};
+
+#if defined(_WIN32)
+typedef HANDLE ThreadHandle;
+
+static DWORD WINAPI threadEntry(LPVOID p) {
+  ThreadData* data = static_cast<ThreadData*>(p);
+  data->func(data->arg);
+  return 0;
+}
+
+static void runThreads(ThreadFunc func, void** args, uint32_t count) {
+  ThreadHandle handles[kMaxThreads];
+  ThreadData data[kMaxThreads];
+
+  for (uint32_t i = 0; i < count; i++) {
+    data[i].func = func;
+    data[i].arg = args[i];
+    handles[i] = ::CreateThread(NULL, 0, threadEntry, &data[i], 0, NULL);
+  }
+
+  ::WaitForMultipleObjects(count, handles, TRUE, INFINITE);
+  for (uint32_t i = 0; i < count; i++)
+    ::CloseHandle(handles[i]);
+}
+#else
+typedef pthread_t ThreadHandle;
+
+static void* threadEntry(void* p) {
+  ThreadData* data = static_cast<ThreadData*>(p);
+  data->func(data->arg);
+  return NULL;
+}
+
+static void runThreads(ThreadFunc func, void** args, uint32_t count) {
+  ThreadHandle handles[kMaxThreads];
+  ThreadData data[kMaxThreads];
+
+  for (uint32_t i = 0; i < count; i++) {
+    data[i].func = func;
+    data[i].arg = args[i];
+    pthread_create(&handles[i], NULL, threadEntry, &data[i]);
+  }
+
+  for (uint32_t i = 0; i < count; i++)
+    pthread_join(handles[i], NULL);
+}
+#endif // _WIN32
+
+// ============================================================================
+// [Bench - JitRuntime::add]
+// ============================================================================
+
+// Each thread keeps `kNumLive` functions alive and replaces the oldest one by
+// a new function, which exercises both `JitRuntime::add()` and `release()`.
+struct AddWorker {
+  asmjit::JitRuntime* runtime;
+  uint32_t count;
+  uint32_t failed;
+};
+
+static void benchAddWorker(void* arg) {
+  using namespace asmjit;
+
+  AddWorker* worker = static_cast<AddWorker*>(arg);
+  JitRuntime* runtime = worker->runtime;
+
+  X86Assembler a(runtime);
+  void* live[kNumLive];
+  ::memset(live, 0, sizeof(live));
+
+  for (uint32_t i = 0; i < worker->count; i++) {
+    a.reset();
+    a.mov(x86::eax, static_cast<int32_t>(i));
+    for (uint32_t j = 0; j < (i & 15); j++)
+      a.add(x86::eax, static_cast<int32_t>(j));
+    a.ret();
+
+    uint32_t slot = i % kNumLive;
+    if (live[slot] != NULL)
+      runtime->release(live[slot]);
+
+    live[slot] = a.make();
+    if (live[slot] == NULL)
+      worker->failed++;
+  }
+
+  for (uint32_t i = 0; i < kNumLive; i++)
+    if (live[i] != NULL)
+      runtime->release(live[i]);
+}
+
+static void benchAdd(bool threadCache) {
+  using namespace asmjit;
+
+  Performance perf;
+  AddWorker workers[kMaxThreads];
+  void* args[kMaxThreads];
+
+  for (uint32_t numThreads = 1; numThreads <= kMaxThreads; numThreads *= 2) {
+    uint32_t failed = 0;
+    perf.reset();
+
+    for (uint32_t r = 0; r < kNumRepeats; r++) {
+      JitRuntime runtime;
+      runtime.getMemMgr()->setThreadCacheEnabled(threadCache);
+
+      for (uint32_t i = 0; i < numThreads; i++) {
+        workers[i].runtime = &runtime;
+        workers[i].count = kNumFunctions;
+        workers[i].failed = 0;
+        args[i] = &workers[i];
+      }
+
+      perf.start();
+      runThreads(benchAddWorker, args, numThreads);
+      perf.end();
+
+      for (uint32_t i = 0; i < numThreads; i++)
+        failed += workers[i].failed;
+    }
+
+    double total = static_cast<double>(numThreads) * kNumFunctions;
+    double time = perf.best ? static_cast<double>(perf.best) : 1.0;
+
+    printf("JitRuntime::add (%s) | Threads: %-2u | Time: %-6u [ms] | Speed: %9.1f [Kfn/s]%s\n",
+      threadCache ? "ThreadCache" : "SharedPool ",
+      numThreads,
+      perf.best,
+      total / time,
+      failed ? " | FAILED" : "");
+  }
+}
+
+// ============================================================================
+// [Bench - Fragmented VMemMgr]
+// ============================================================================
+
+// Deterministic random number generator, so all runs use the same sizes.
+static uint32_t benchRandom(uint32_t& state) {
+  state = state * 1103515245 + 12345;
+  return (state >> 16) & 0x7FFF;
+}
+
+// Fill a `VMemMgr` by `numLive` small allocations and release every other one,
+// which leaves small holes in all nodes. Then measure replacing small chunks
+// mixed with larger allocations that don't fit into any hole, which is the
+// worst case of searching for a free run in a fragmented heap.
+static void benchFragmented(uint32_t numLive) {
+  using namespace asmjit;
+
+  Performance perf;
+  perf.reset();
+
+  size_t used = 0;
+  size_t allocated = 0;
+
+  void** live = static_cast<void**>(::malloc(numLive * sizeof(void*)));
+  void* large[kNumLarge];
+
+  if (live == NULL)
+    return;
+
+  for (uint32_t r = 0; r < kNumRepeats; r++) {
+    VMemMgr memMgr;
+    uint32_t state = 1;
+    uint32_t i;
+
+    for (i = 0; i < numLive; i++)
+      live[i] = memMgr.alloc(64 + benchRandom(state) % 192);
+
+    for (i = 0; i < numLive; i += 2) {
+      memMgr.release(live[i]);
+      live[i] = NULL;
+    }
+
+    ::memset(large, 0, sizeof(large));
+
+    perf.start();
+    for (i = 0; i < kNumFragmentedOps; i++) {
+      if ((i & 3) == 0) {
+        uint32_t index = (i >> 2) % kNumLarge;
+        if (large[index] != NULL)
+          memMgr.release(large[index]);
+        large[index] = memMgr.alloc(1024 + benchRandom(state) % 3072);
+      }
+      else {
+        uint32_t index = (((benchRandom(state) << 15) | benchRandom(state)) % (numLive / 2)) * 2;
+        if (live[index] != NULL)
+          memMgr.release(live[index]);
+        live[index] = memMgr.alloc(32 + benchRandom(state) % 192);
+      }
+    }
+    perf.end();
+
+    used = memMgr.getUsedBytes();
+    allocated = memMgr.getAllocatedBytes();
+  }
+
+  ::free(live);
+
+  double time = perf.best ? static_cast<double>(perf.best) : 1.0;
+  printf("VMemMgr (Fragmented) | Live: %-6u | Time: %-6u [ms] | Speed: %9.1f [Kops/s] | Used: %6u [KB] | Allocated: %6u [KB]\n",
+    numLive,
+    perf.best,
+    static_cast<double>(kNumFragmentedOps) / time,
+    static_cast<unsigned int>(used / 1024),
+    static_cast<unsigned int>(allocated / 1024));
+}
+
+// ============================================================================
+// [Bench - Huge Pages]
+// ============================================================================
+
+#if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
+typedef int (*ScatteredFunc)(void);
+
+// Generate `kNumScattered` small functions, each on its own 4kB page, and call
+// them in a random order. With regular pages every call is likely an iTLB miss,
+// with huge pages the whole code fits into a few iTLB entries.
+static void benchHugePages(bool hugePages) {
+  using namespace asmjit;
+
+  Performance perf;
+  perf.reset();
+
+  VMemMgr memMgr;
+  if (hugePages && memMgr.setHugePagesEnabled(true) != kErrorOk) {
+    printf("VMemMgr (HugePages)  | Not supported by the host\n");
+    return;
+  }
+
+  ScatteredFunc* funcs = static_cast<ScatteredFunc*>(::malloc(kNumScattered * sizeof(ScatteredFunc)));
+  uint32_t* order = static_cast<uint32_t*>(::malloc(kNumScattered * sizeof(uint32_t)));
+
+  if (funcs == NULL || order == NULL) {
+    ::free(funcs);
+    ::free(order);
+    return;
+  }
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime);
+
+  uint32_t state = 1;
+  uint32_t i;
+  bool failed = false;
+
+  for (i = 0; i < kNumScattered; i++) {
+    a.reset();
+    a.mov(x86::eax, static_cast<int32_t>(i));
+    a.ret();
+
+    void* p = memMgr.alloc(kScatterDistance);
+    if (p == NULL || a.relocCode(p, (Ptr)(uintptr_t)p) == 0) {
+      failed = true;
+      break;
+    }
+
+    funcs[i] = asmjit_cast<ScatteredFunc>(p);
+    order[i] = i;
+  }
+
+  // Shuffle the call order.
+  for (i = kNumScattered - 1; i > 0; i--) {
+    uint32_t j = ((benchRandom(state) << 15) | benchRandom(state)) % (i + 1);
+    uint32_t t = order[i];
+    order[i] = order[j];
+    order[j] = t;
+  }
+
+  uint32_t sum = 0;
+  if (!failed) {
+    for (uint32_t r = 0; r < kNumRepeats; r++) {
+      perf.start();
+      for (i = 0; i < kNumScatteredCalls; i++)
+        sum += static_cast<uint32_t>(funcs[order[i % kNumScattered]]());
+      perf.end();
+    }
+  }
+
+  ::free(funcs);
+  ::free(order);
+
+  double time = perf.best ? static_cast<double>(perf.best) : 1.0;
+  printf("VMemMgr (%s) | Funcs: %-6u | Time: %-6u [ms] | Speed: %9.1f [Kcalls/s] | Allocated: %6u [KB]%s\n",
+    hugePages ? "HugePages " : "SmallPages",
+    kNumScattered,
+    perf.best,
+    static_cast<double>(kNumScatteredCalls) / time,
+    static_cast<unsigned int>(memMgr.getAllocatedBytes() / 1024),
+    failed || sum == 0 ? " | FAILED" : "");
+}
+#endif // ASMJIT_BUILD_X86 || ASMJIT_BUILD_X64
+
+// ============================================================================
+// [Main]
+// ============================================================================
+
+int main(int argc, char* argv[]) {
+  for (uint32_t i = 0; i < ASMJIT_ARRAY_SIZE(kNumFragments); i++)
+    benchFragmented(kNumFragments[i]);
+
+#if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
+  benchHugePages(false);
+  benchHugePages(true);
+
+  benchAdd(false);
+  benchAdd(true);
+#endif // ASMJIT_BUILD_X86 || ASMJIT_BUILD_X64
+
+  return 0;
+}
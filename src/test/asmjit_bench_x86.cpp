@@ -19,6 +19,12 @@
 
 static const uint32_t kNumRepeats = 10;
 static const uint32_t kNumIterations = 5000;
+static const uint32_t kNumLargeParts = 256;
+static const uint32_t kNumLargeVars = 4096;
+static const uint32_t kNumModuleFuncs = 64;
+static const uint32_t kNumModuleVars = 512;
+static const uint32_t kNumExprs = 1024;
+static const uint32_t kNumHotBlocks = 4096;
 
 // ============================================================================
 // [TestRuntime]
@@ -32,7 +38,11 @@ struct TestRuntime : public asmjit::Runtime {
   // --------------------------------------------------------------------------
 
   TestRuntime(uint32_t arch, uint32_t callConv) ASMJIT_NOEXCEPT {
+    // Pretend that all features are supported, `asmgen` uses all of them.
     _cpuInfo.setArch(arch);
+    for (uint32_t i = 0; i < asmjit::CpuInfo::kX86FeaturesCount; i++)
+      _cpuInfo.addFeature(i);
+
     _stackAlignment = 16;
     _baseAddress = 0;
     _cdeclConv = static_cast<uint8_t>(callConv);
@@ -113,6 +123,165 @@ static double mbps(uint32_t time, size_t outputSize) {
   return (bytesTotal * 1000) / (static_cast<double>(time) * 1024 * 1024);
 }
 
+// ============================================================================
+// [GenLarge]
+// ============================================================================
+
+#if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
+// Generate a single function that uses `numVars` variables in a loop. Each
+// variable lives for a short window of the code, which is typical for code
+// generated from expressions. The window is wider than the register file so
+// some variables have to be spilled, and conditional blocks force the state
+// of the register allocator to be merged.
+static void generateLarge(asmjit::X86Compiler& c, uint32_t numVars) {
+  using namespace asmjit;
+  using namespace asmjit::x86;
+
+  enum { kWindow = 20 };
+
+  X86GpVar dst = c.newIntPtr("dst");
+  X86GpVar src = c.newIntPtr("src");
+  X86GpVar cnt = c.newIntPtr("cnt");
+  X86GpVar window[kWindow];
+
+  Label L_Loop = c.newLabel();
+
+  c.addFunc(FuncBuilder3<Void, void*, const void*, size_t>(c.getRuntime()->getCdeclConv()));
+
+  c.setArg(0, dst);
+  c.setArg(1, src);
+  c.setArg(2, cnt);
+
+  c.bind(L_Loop);
+
+  for (uint32_t i = 0; i < numVars; i++) {
+    X86GpVar v = c.newInt32("v%u", i);
+    X86GpVar& slot = window[i % kWindow];
+
+    c.mov(v, dword_ptr(src, static_cast<int32_t>(i % 64) * 4));
+    if (i != 0)
+      c.add(v, window[(i - 1) % kWindow]);
+
+    if (i >= kWindow) {
+      c.xor_(v, slot);
+      c.mov(dword_ptr(dst, static_cast<int32_t>(i % 64) * 4), slot);
+    }
+
+    if ((i % 32) == 31) {
+      Label L_Skip = c.newLabel();
+      c.test(v, v);
+      c.jz(L_Skip);
+      c.imul(v, window[(i - 7) % kWindow]);
+      c.bind(L_Skip);
+    }
+
+    slot = v;
+  }
+
+  for (uint32_t i = 0; i < kWindow && i < numVars; i++)
+    c.add(dword_ptr(dst, static_cast<int32_t>(i) * 4), window[i]);
+
+  c.dec(cnt);
+  c.jnz(L_Loop);
+  c.endFunc();
+}
+#endif
+
+// ============================================================================
+// [GenExpr]
+// ============================================================================
+
+#if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
+// Generate a single function that evaluates `numExprs` expressions the way a
+// naive front-end does - each expression computes the address of a record
+// and loads both of its operands again. Results are stored from time to time
+// so loaded values can't be reused forever.
+static void generateExpr(asmjit::X86Compiler& c, uint32_t numExprs) {
+  using namespace asmjit;
+  using namespace asmjit::x86;
+
+  X86GpVar dst = c.newIntPtr("dst");
+  X86GpVar src = c.newIntPtr("src");
+  X86GpVar idx = c.newIntPtr("idx");
+  X86GpVar acc = c.newInt32("acc");
+
+  c.addFunc(FuncBuilder3<int, void*, const void*, size_t>(c.getRuntime()->getCdeclConv()));
+
+  c.setArg(0, dst);
+  c.setArg(1, src);
+  c.setArg(2, idx);
+  c.xor_(acc, acc);
+
+  for (uint32_t i = 0; i < numExprs; i++) {
+    X86GpVar rec = c.newIntPtr("rec%u", i);
+    X86GpVar a = c.newInt32("a%u", i);
+    X86GpVar b = c.newInt32("b%u", i);
+
+    c.lea(rec, ptr(src, idx, 2));
+    c.mov(a, dword_ptr(rec, static_cast<int32_t>(i % 4) * 4));
+    c.mov(b, dword_ptr(rec, static_cast<int32_t>((i + 1) % 4) * 4));
+    c.add(a, b);
+    c.add(acc, a);
+
+    if ((i % 8) == 7)
+      c.mov(dword_ptr(dst, static_cast<int32_t>(i / 8 % 16) * 4), acc);
+  }
+
+  c.ret(acc);
+  c.endFunc();
+}
+#endif
+
+// ============================================================================
+// [GenHot]
+// ============================================================================
+
+#if defined(ASMJIT_BUILD_X86) || defined(ASMJIT_BUILD_X64)
+// Emit `count` blocks of the most common GP and SSE instructions, either by
+// using `X86Assembler` intrinsics, which use the fast path, or through the
+// generic `emit()`.
+#define HOT_2(inst, id, o0, o1) \
+  do { \
+    if (generic) \
+      a.emit(kX86InstId##id, o0, o1); \
+    else \
+      a.inst(o0, o1); \
+  } while (0)
+
+static void generateHot(asmjit::X86Assembler& a, uint32_t count, bool generic) {
+  using namespace asmjit;
+  using namespace asmjit::x86;
+
+  const X86GpReg& zax = a.zax;
+  const X86GpReg& zcx = a.zcx;
+  const X86GpReg& zsi = a.zsi;
+  const X86GpReg& zdi = a.zdi;
+
+  for (uint32_t i = 0; i < count; i++) {
+    int32_t disp = static_cast<int32_t>(i % 64) * 16;
+
+    HOT_2(mov   , Mov   , zax, ptr(zsi, disp));
+    HOT_2(add   , Add   , zax, zcx);
+    HOT_2(lea   , Lea   , zcx, ptr(zsi, zax, 2, 8));
+    HOT_2(sub   , Sub   , eax, static_cast<int>(i));
+    HOT_2(and_  , And   , ecx, 0xFF);
+    HOT_2(shl   , Shl   , zax, 3);
+    HOT_2(imul  , Imul  , eax, ecx);
+    HOT_2(cmp   , Cmp   , zax, ptr(zdi, disp));
+    HOT_2(test  , Test  , ecx, ecx);
+    HOT_2(mov   , Mov   , ptr(zdi, disp), zax);
+    HOT_2(movaps, Movaps, xmm0, ptr(zsi, disp));
+    HOT_2(mulps , Mulps , xmm0, xmm1);
+    HOT_2(addps , Addps , xmm0, xmm2);
+    HOT_2(pxor  , Pxor  , xmm3, xmm3);
+    HOT_2(paddd , Paddd , xmm3, ptr(zsi, zcx, 2));
+    HOT_2(movaps, Movaps, ptr(zdi, disp), xmm0);
+  }
+}
+
+#undef HOT_2
+#endif
+
 // ============================================================================
 // [Main]
 // ============================================================================
@@ -181,6 +350,303 @@ static void benchX86(uint32_t arch, uint32_t callConv) {
 
   printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s]\n",
     "X86Compiler", archName, perf.best, mbps(perf.best, cmpOutputSize));
+
+  // --------------------------------------------------------------------------
+  // [Bench - Large Function]
+  // --------------------------------------------------------------------------
+
+  // A single multi-megabyte function, each repeat starts with an empty
+  // code-buffer, so the time includes growing it.
+  size_t largeOutputSize = 0;
+
+  perf.reset();
+  for (r = 0; r < kNumRepeats; r++) {
+    X86Assembler large(&runtime, arch);
+
+    perf.start();
+    for (i = 0; i < kNumLargeParts; i++)
+      asmgen::opcode(large);
+
+    void* p = large.make();
+    runtime.release(p);
+    perf.end();
+
+    largeOutputSize = large.getCodeSize();
+  }
+
+  printf("%-12s (%s) | Time: %-6u [ms] | Speed: %7.3f [MB/s] | Size: %u [KB]\n",
+    "X86Assembler", archName, perf.best, mbps(perf.best, largeOutputSize),
+    static_cast<unsigned int>(largeOutputSize / 1024));
+
+  // --------------------------------------------------------------------------
+  // [Bench - Fast Path]
+  // --------------------------------------------------------------------------
+
+  // The same instruction mix encoded by the generic `emit()` and by the fast
+  // path used by `X86Assembler` intrinsics, the code must be the same.
+  uint32_t hotTime[2];
+  size_t hotSize[2];
+
+  for (uint32_t fast = 0; fast < 2; fast++) {
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      perf.start();
+      for (i = 0; i < kNumIterations / 50; i++) {
+        a.reset();
+        generateHot(a, kNumHotBlocks, fast == 0);
+      }
+      perf.end();
+    }
+
+    hotTime[fast] = perf.best;
+    hotSize[fast] = a.getCodeSize() * (kNumIterations / 50);
+  }
+  a.reset();
+
+  printf("%-12s (%s) | Generic: %-6u [ms] | Fast: %-6u [ms] | Speed: %7.3f -> %7.3f [MB/s]%s\n",
+    "Fast Path", archName, hotTime[0], hotTime[1],
+    mbps(hotTime[0], hotSize[0]), mbps(hotTime[1], hotSize[1]),
+    hotSize[0] == hotSize[1] ? "" : " | SIZE MISMATCH");
+
+  // --------------------------------------------------------------------------
+  // [Bench - Strict Validation]
+  // --------------------------------------------------------------------------
+
+  // Time of both workloads without and with `kOptionStrictValidation`, no
+  // instruction is refused as `TestRuntime` provides all CPU features.
+  uint32_t opcodeTime[2];
+  uint32_t blendTime[2];
+
+  for (uint32_t s = 0; s < 2; s++) {
+    uint32_t options = s ? static_cast<uint32_t>(Assembler::kOptionStrictValidation) : 0;
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      perf.start();
+      for (i = 0; i < kNumIterations / 10; i++) {
+        a.reset();
+        a.addAsmOptions(options);
+        asmgen::opcode(a);
+      }
+      perf.end();
+    }
+    opcodeTime[s] = perf.best;
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      perf.start();
+      for (i = 0; i < kNumIterations / 10; i++) {
+        a.reset();
+        a.addAsmOptions(options);
+        c.attach(&a);
+        asmgen::blend(c);
+        c.finalize();
+      }
+      perf.end();
+    }
+    blendTime[s] = perf.best;
+  }
+  a.reset();
+
+  printf("%-12s (%s) | Opcode: %u -> %u [ms] | Blend: %u -> %u [ms]\n",
+    "Validation", archName, opcodeTime[0], opcodeTime[1], blendTime[0], blendTime[1]);
+
+  // --------------------------------------------------------------------------
+  // [Bench - Jump Relaxation]
+  // --------------------------------------------------------------------------
+
+  // Code size of both workloads without and with `kOptionRelaxJumps`.
+  size_t opcodeSize[2];
+  size_t blendSize[2];
+
+  for (r = 0; r < 2; r++) {
+    uint32_t options = r ? static_cast<uint32_t>(Assembler::kOptionRelaxJumps) : 0;
+
+    a.reset();
+    a.addAsmOptions(options);
+    asmgen::opcode(a);
+    a.relax();
+    opcodeSize[r] = a.getCodeSize();
+
+    a.reset();
+    a.addAsmOptions(options);
+    c.attach(&a);
+    asmgen::blend(c);
+    c.finalize();
+    a.relax();
+    blendSize[r] = a.getCodeSize();
+  }
+  a.reset();
+
+  printf("%-12s (%s) | Opcode: %u -> %u [bytes] | Blend: %u -> %u [bytes]\n",
+    "Relaxation", archName,
+    static_cast<unsigned int>(opcodeSize[0]), static_cast<unsigned int>(opcodeSize[1]),
+    static_cast<unsigned int>(blendSize[0]), static_cast<unsigned int>(blendSize[1]));
+
+  // --------------------------------------------------------------------------
+  // [Bench - Register Allocation]
+  // --------------------------------------------------------------------------
+
+  // Compile time of a large generated function and code size of both
+  // workloads with the default allocator and `kCompilerFeatureLinearScan`.
+  for (uint32_t ls = 0; ls < 2; ls++) {
+    size_t largeSize = 0;
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      perf.start();
+      c.attach(&a);
+      c.setFeature(kCompilerFeatureLinearScan, ls != 0);
+      generateLarge(c, kNumLargeVars);
+      c.finalize();
+      perf.end();
+
+      largeSize = a.getCodeSize();
+      a.reset();
+    }
+
+    c.attach(&a);
+    c.setFeature(kCompilerFeatureLinearScan, ls != 0);
+    asmgen::blend(c);
+    c.finalize();
+    size_t blendSize = a.getCodeSize();
+    a.reset();
+
+    printf("%-12s (%s) | %-10s | Time: %-6u [ms] | Large: %u [bytes] | Blend: %u [bytes]\n",
+      "RegAlloc", archName, ls ? "LinearScan" : "LookAhead", perf.best,
+      static_cast<unsigned int>(largeSize), static_cast<unsigned int>(blendSize));
+  }
+
+  // --------------------------------------------------------------------------
+  // [Bench - Peephole]
+  // --------------------------------------------------------------------------
+
+  // Code size of both workloads without and with `kCompilerFeaturePeephole`.
+  // Neither workload contains a pattern the peephole optimizer rewrites, so
+  // the sizes don't change, the rewrites are checked by unit tests.
+  size_t largeSize[2];
+
+  for (r = 0; r < 2; r++) {
+    c.attach(&a);
+    c.setFeature(kCompilerFeaturePeephole, r != 0);
+    generateLarge(c, kNumLargeVars);
+    c.finalize();
+    largeSize[r] = a.getCodeSize();
+    a.reset();
+
+    c.attach(&a);
+    c.setFeature(kCompilerFeaturePeephole, r != 0);
+    asmgen::blend(c);
+    c.finalize();
+    blendSize[r] = a.getCodeSize();
+    a.reset();
+  }
+
+  printf("%-12s (%s) | Large: %u -> %u [bytes] | Blend: %u -> %u [bytes]\n",
+    "Peephole", archName,
+    static_cast<unsigned int>(largeSize[0]), static_cast<unsigned int>(largeSize[1]),
+    static_cast<unsigned int>(blendSize[0]), static_cast<unsigned int>(blendSize[1]));
+
+  // --------------------------------------------------------------------------
+  // [Bench - Scheduler]
+  // --------------------------------------------------------------------------
+
+  // Compile time of a large generated function and code size of both
+  // workloads without and with `kCompilerFeatureEnableScheduler`. All regions
+  // of the large function need spills, so the scheduler keeps their original
+  // order and the size doesn't change, but it still costs the compile time of
+  // scheduling them.
+  uint32_t schedTime[2];
+
+  for (uint32_t s = 0; s < 2; s++) {
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      perf.start();
+      c.attach(&a);
+      c.setFeature(kCompilerFeatureEnableScheduler, s != 0);
+      generateLarge(c, kNumLargeVars);
+      c.finalize();
+      perf.end();
+
+      largeSize[s] = a.getCodeSize();
+      a.reset();
+    }
+
+    c.attach(&a);
+    c.setFeature(kCompilerFeatureEnableScheduler, s != 0);
+    asmgen::blend(c);
+    c.finalize();
+    blendSize[s] = a.getCodeSize();
+    a.reset();
+
+    schedTime[s] = perf.best;
+  }
+
+  printf("%-12s (%s) | Time: %u -> %u [ms] | Large: %u -> %u [bytes] | Blend: %u -> %u [bytes]\n",
+    "Scheduler", archName, schedTime[0], schedTime[1],
+    static_cast<unsigned int>(largeSize[0]), static_cast<unsigned int>(largeSize[1]),
+    static_cast<unsigned int>(blendSize[0]), static_cast<unsigned int>(blendSize[1]));
+
+  // --------------------------------------------------------------------------
+  // [Bench - Value Numbering]
+  // --------------------------------------------------------------------------
+
+  // Compile time of expressions that repeat their loads and code size of them
+  // and of a large generated function without and with value numbering.
+  size_t exprSize[2];
+
+  for (uint32_t v = 0; v < 2; v++) {
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      perf.start();
+      c.attach(&a);
+      c.setFeature(kCompilerFeatureValueNumbering, v != 0);
+      generateExpr(c, kNumExprs);
+      c.finalize();
+      perf.end();
+
+      exprSize[v] = a.getCodeSize();
+      a.reset();
+    }
+
+    c.attach(&a);
+    c.setFeature(kCompilerFeatureValueNumbering, v != 0);
+    generateLarge(c, kNumLargeVars);
+    c.finalize();
+    largeSize[v] = a.getCodeSize();
+    a.reset();
+
+    printf("%-12s (%s) | %-10s | Time: %-6u [ms] | Expr: %u [bytes] | Large: %u [bytes]\n",
+      "ValueNumber", archName, v ? "Enabled" : "Disabled", perf.best,
+      static_cast<unsigned int>(exprSize[v]), static_cast<unsigned int>(largeSize[v]));
+  }
+
+  // --------------------------------------------------------------------------
+  // [Bench - Parallel Finalize]
+  // --------------------------------------------------------------------------
+
+  // Compile time of a module of many generated functions finalized by 1 and
+  // 4 threads, the code size has to be the same.
+  for (uint32_t t = 1; t <= 4; t += 3) {
+    size_t moduleSize = 0;
+
+    perf.reset();
+    for (r = 0; r < kNumRepeats; r++) {
+      perf.start();
+      c.attach(&a);
+      c.setThreadCount(t);
+      for (i = 0; i < kNumModuleFuncs; i++)
+        generateLarge(c, kNumModuleVars);
+      c.finalize();
+      perf.end();
+
+      moduleSize = a.getCodeSize();
+      a.reset();
+    }
+
+    printf("%-12s (%s) | Threads: %u | Time: %-6u [ms] | Module: %u [bytes]\n",
+      "Finalize", archName, t, perf.best, static_cast<unsigned int>(moduleSize));
+  }
 }
 #endif
 
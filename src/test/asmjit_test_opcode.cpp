@@ -35,6 +35,165 @@ static const char* archIdToString(uint32_t archId) {
   }
 }
 
+// ============================================================================
+// [CheckEvex / CheckFixed]
+// ============================================================================
+
+#if defined(ASMJIT_BUILD_X64)
+// Compare bytes emitted since `offset` with `expected` (hex string).
+static bool checkOpcode(asmjit::X86Assembler& a, size_t offset, const char* expected, const char* inst) {
+  char buf[64];
+  size_t length = a.getOffset() - offset;
+
+  if (length > 30)
+    length = 30;
+
+  for (size_t i = 0; i < length; i++)
+    sprintf(buf + i * 2, "%02x", a.getBuffer()[offset + i]);
+  buf[length * 2] = '\0';
+
+  if (a.getLastError() == asmjit::kErrorOk && strcmp(buf, expected) == 0)
+    return true;
+
+  printf("  %s: Expected '%s', got '%s' [%s]\n", inst, expected, buf,
+    asmjit::DebugUtils::errorAsString(a.getLastError()));
+
+  a.resetLastError();
+  return false;
+}
+
+#define CHECK_OPCODE(EXPECTED, INST) \
+  do { \
+    size_t offset = a.getOffset(); \
+    a.INST; \
+    if (!checkOpcode(a, offset, EXPECTED, #INST)) \
+      failed++; \
+  } while (0)
+
+// Check EVEX (AVX-512) encodings byte-for-byte. The expected sequences come
+// from GNU as / llvm-mc and cover `EVEX.R'/V'/X`, opmask and zeroing, embedded
+// broadcast and rounding, and disp8*N compression (FV and T1S tuples).
+static int checkEvex() {
+  using namespace asmjit;
+  using namespace asmjit::x86;
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime, kArchX64);
+  int failed = 0;
+
+  printf("Opcodes [EVEX]\n");
+
+  // Registers.
+  CHECK_OPCODE("62f1744858c2", vaddps(zmm0, zmm1, zmm2));
+  CHECK_OPCODE("62010c4058fd", vaddps(zmm31, zmm30, zmm29));
+  CHECK_OPCODE("62117c4058c0", vaddps(zmm8, zmm16, zmm24));
+  CHECK_OPCODE("62a1740058c2", vaddps(xmm16, xmm17, xmm18));
+  CHECK_OPCODE("62b16c2858cc", vaddps(ymm1, ymm2, ymm20));
+  CHECK_OPCODE("c5e858cb"    , vaddps(xmm1, xmm2, xmm3));
+  CHECK_OPCODE("62e17c48100f", vmovups(zmm17, ptr(rdi)));
+  CHECK_OPCODE("6261fd481137", vmovupd(ptr(rdi), zmm30));
+
+  // Opmask and zeroing.
+  CHECK_OPCODE("62f16c4958cb", k(k1).vaddps(zmm1, zmm2, zmm3));
+  CHECK_OPCODE("62f16ccf58cb", k(k7).z().vaddps(zmm1, zmm2, zmm3));
+  CHECK_OPCODE("62f17c4b294f01", k(k3).vmovaps(ptr(rdi, 64), zmm1));
+  CHECK_OPCODE("62f1fec96f5e02", k(k1).z().vmovdqu64(zmm3, ptr(rsi, 128)));
+
+  // Embedded rounding and SAE.
+  CHECK_OPCODE("62f16c1858cb", rn_sae().vaddps(zmm1, zmm2, zmm3));
+  CHECK_OPCODE("62f16c3858cb", rd_sae().vaddps(zmm1, zmm2, zmm3));
+  CHECK_OPCODE("62f16c5858cb", ru_sae().vaddps(zmm1, zmm2, zmm3));
+  CHECK_OPCODE("62f1ed7858cb", rz_sae().vaddpd(zmm1, zmm2, zmm3));
+  CHECK_OPCODE("62f16c185fcb", sae().vmaxps(zmm1, zmm2, zmm3));
+
+  // Memory and disp8*N compression.
+  CHECK_OPCODE("62f16c485808", vaddps(zmm1, zmm2, ptr(rax)));
+  CHECK_OPCODE("62f16c48584801", vaddps(zmm1, zmm2, ptr(rax, 64)));
+  CHECK_OPCODE("62f16c4858487f", vaddps(zmm1, zmm2, ptr(rax, 8128)));
+  CHECK_OPCODE("62f16c48584880", vaddps(zmm1, zmm2, ptr(rax, -8192)));
+  CHECK_OPCODE("62f16c48588800200000", vaddps(zmm1, zmm2, ptr(rax, 8192)));
+  CHECK_OPCODE("62f16c48588841000000", vaddps(zmm1, zmm2, ptr(rax, 65)));
+  CHECK_OPCODE("62916c48584cac02", vaddps(zmm1, zmm2, ptr(r12, r13, 2, 128)));
+  CHECK_OPCODE("62f16c48584c2401", vaddps(zmm1, zmm2, ptr(rsp, 64)));
+  CHECK_OPCODE("62f16c48584d00", vaddps(zmm1, zmm2, ptr(rbp)));
+  CHECK_OPCODE("62e16c08584804", vaddps(xmm17, xmm2, ptr(rax, 64)));
+  CHECK_OPCODE("62f16c48580d00010000", vaddps(zmm1, zmm2, ptr(rip, 0x100)));
+
+  // Embedded broadcast.
+  CHECK_OPCODE("62f16c58584804", _1ToN().vaddps(zmm1, zmm2, ptr(rax, 16)));
+  CHECK_OPCODE("62f1ed58584802", _1ToN().vaddpd(zmm1, zmm2, ptr(rax, 16)));
+  CHECK_OPCODE("62b14cd2584cc8ff", k(k2).z()._1ToN().vaddps(zmm1, zmm22, ptr(rax, r9, 3, -4)));
+  CHECK_OPCODE("62f36d58254801ff", _1ToN().vpternlogd(zmm1, zmm2, ptr(rax, 4), 0xFF));
+
+  // Tuple T1S.
+  CHECK_OPCODE("62f27d48184803", vbroadcastss(zmm1, ptr(rax, 12)));
+  CHECK_OPCODE("62f2fd48594801", vpbroadcastq(zmm1, ptr(rax, 8)));
+  CHECK_OPCODE("62f27d498b5702", k(k1).vpcompressd(ptr(rdi, 8), zmm2));
+  CHECK_OPCODE("62f27dc9894e01", k(k1).z().vpexpandd(zmm1, ptr(rsi, 4)));
+
+  // Opmask destination.
+  CHECK_OPCODE("62f36d4a1fcb04", k(k2).vpcmpd(k1, zmm2, zmm3, 4));
+  CHECK_OPCODE("62f3ed581e480805", _1ToN().vpcmpuq(k1, zmm2, ptr(rax, 64), 5));
+  CHECK_OPCODE("62f16d0876cb", vpcmpeqd(k1, xmm2, xmm3));
+  CHECK_OPCODE("c5e976cb"    , vpcmpeqd(xmm1, xmm2, xmm3));
+  CHECK_OPCODE("62f2ee4c27cb", k(k4).vptestnmq(k1, zmm2, zmm3));
+
+  // Opmask instructions (VEX encoded).
+  CHECK_OPCODE("c5cc46fd"    , kxnorw(k7, k6, k5));
+  CHECK_OPCODE("c5f898ca"    , kortestw(k1, k2));
+  CHECK_OPCODE("c5f89108"    , kmovw(ptr(rax), k1));
+  CHECK_OPCODE("c4c17892cd"  , kmovw(k1, r13d));
+  CHECK_OPCODE("c57893e1"    , kmovw(r12d, k1));
+
+  printf("  %s\n", failed ? "Failed!" : "Passed.");
+  return failed;
+}
+
+// Check encodings that were wrong in the past, one check per fix. The expected
+// sequences come from GNU as.
+static int checkFixed() {
+  using namespace asmjit;
+  using namespace asmjit::x86;
+
+  JitRuntime runtime;
+  X86Assembler a(&runtime, kArchX64);
+  int failed = 0;
+
+  printf("Opcodes [Fixed]\n");
+
+  // Operand size of crc32 is given by the source operand.
+  CHECK_OPCODE("f20f38f0c1"  , crc32(eax, cl));
+  CHECK_OPCODE("f2480f38f006", crc32(rax, byte_ptr(rsi)));
+
+  // Register of extrq with immediates is encoded in ModR/M.rm.
+  CHECK_OPCODE("660f78c10804", extrq(xmm1, 8, 4));
+
+  // Immediate of AvxVmi instructions is the third operand.
+  CHECK_OPCODE("c5f173da03"  , vpsrldq(xmm1, xmm2, 3));
+
+  // vmovq to a Gpq register sets VEX.W.
+  CHECK_OPCODE("c4e1f97ec8"  , vmovq(rax, xmm1));
+
+  // fwait is 9B.
+  CHECK_OPCODE("9b"          , fwait());
+
+  // setSegment() replaces the previous segment.
+  X86Mem m = dword_ptr(rax);
+  m.setSegment(fs);
+  m.setSegment(gs);
+  CHECK_OPCODE("658b00"      , mov(eax, m));
+
+  printf("  %s\n", failed ? "Failed!" : "Passed.");
+  return failed;
+}
+
+#undef CHECK_OPCODE
+#endif // ASMJIT_BUILD_X64
+
+// ============================================================================
+// [Main]
+// ============================================================================
+
 int main(int argc, char* argv[]) {
   asmjit::FileLogger logger(stdout);
   logger.addOptions(asmjit::Logger::kOptionBinaryForm);
@@ -73,5 +232,11 @@ int main(int argc, char* argv[]) {
     runtime.release((void*)p);
   }
 
-  return 0;
+  int failed = 0;
+#if defined(ASMJIT_BUILD_X64)
+  failed += checkEvex();
+  failed += checkFixed();
+#endif // ASMJIT_BUILD_X64
+
+  return failed != 0;
 }
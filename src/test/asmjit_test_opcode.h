@@ -59,6 +59,16 @@ static void opcode(asmjit::X86Assembler& a, bool useRex1 = false, bool useRex2 =
   X86YmmReg ymmC = useRex2 ? ymm10 : ymm2;
   X86YmmReg ymmD = useRex2 ? ymm11 : ymm3;
 
+  // EVEX can encode registers up to index 31, use them to check `EVEX.R'`,
+  // `EVEX.V'` and `EVEX.X` (register form) bits.
+  X86ZmmReg zmmA = useRex1 ? zmm16 : zmm0;
+  X86ZmmReg zmmB = useRex2 ? zmm25 : zmm1;
+  X86ZmmReg zmmC = useRex2 ? zmm10 : zmm2;
+
+  X86KReg kA = k1;
+  X86KReg kB = k2;
+  X86KReg kC = k7;
+
   X86Mem anyptr_gpA = ptr(gzA);
   X86Mem anyptr_gpB = ptr(gzB);
   X86Mem anyptr_gpC = ptr(gzC);
@@ -3009,6 +3019,159 @@ static void opcode(asmjit::X86Assembler& a, bool useRex1 = false, bool useRex2 =
   a.vcvtps2ph(xmmA, ymmB, 0);
   a.vcvtps2ph(anyptr_gpA, ymmB, 0);
 
+  // AVX512F.
+  a.nop();
+
+  a.kandnw(kA, kB, kC);
+  a.kandw(kA, kB, kC);
+  a.kmovw(kA, kB);
+  a.kmovw(kA, anyptr_gpB);
+  a.kmovw(anyptr_gpA, kB);
+  a.kmovw(kA, gdB);
+  a.kmovw(gdA, kB);
+  a.knotw(kA, kB);
+  a.kortestw(kA, kB);
+  a.korw(kA, kB, kC);
+  a.kxnorw(kA, kB, kC);
+  a.kxorw(kA, kB, kC);
+  a.vaddpd(zmmA, zmmB, zmmC);
+  a.vaddpd(zmmA, zmmB, anyptr_gpC);
+  a.k(kA).z().vaddpd(zmmA, zmmB, zmmC);
+  a.rn_sae().vaddpd(zmmA, zmmB, zmmC);
+  a._1ToN().vaddpd(zmmA, zmmB, anyptr_gpC);
+  a.vaddps(zmmA, zmmB, zmmC);
+  a.vaddps(zmmA, zmmB, anyptr_gpC);
+  a.k(kA).vaddps(zmmA, zmmB, zmmC);
+  a.rz_sae().vaddps(zmmA, zmmB, zmmC);
+  a._1ToN().vaddps(zmmA, zmmB, anyptr_gpC);
+  a.vbroadcastss(zmmA, xmmB);
+  a.vbroadcastss(zmmA, anyptr_gpB);
+  a.vdivpd(zmmA, zmmB, zmmC);
+  a.vdivpd(zmmA, zmmB, anyptr_gpC);
+  a.vdivps(zmmA, zmmB, zmmC);
+  a.vdivps(zmmA, zmmB, anyptr_gpC);
+  a.vmaxpd(zmmA, zmmB, zmmC);
+  a.vmaxpd(zmmA, zmmB, anyptr_gpC);
+  a.sae().vmaxpd(zmmA, zmmB, zmmC);
+  a.vmaxps(zmmA, zmmB, zmmC);
+  a.vmaxps(zmmA, zmmB, anyptr_gpC);
+  a.vminpd(zmmA, zmmB, zmmC);
+  a.vminpd(zmmA, zmmB, anyptr_gpC);
+  a.vminps(zmmA, zmmB, zmmC);
+  a.vminps(zmmA, zmmB, anyptr_gpC);
+  a.sae().vminps(zmmA, zmmB, zmmC);
+  a.vmovapd(zmmA, zmmB);
+  a.vmovapd(zmmA, anyptr_gpB);
+  a.vmovapd(anyptr_gpA, zmmB);
+  a.vmovaps(zmmA, zmmB);
+  a.vmovaps(zmmA, anyptr_gpB);
+  a.vmovaps(anyptr_gpA, zmmB);
+  a.k(kA).vmovaps(anyptr_gpA, zmmB);
+  a.vmovdqa32(xmmA, xmmB);
+  a.vmovdqa32(xmmA, anyptr_gpB);
+  a.vmovdqa32(anyptr_gpA, xmmB);
+  a.vmovdqa32(ymmA, ymmB);
+  a.vmovdqa32(ymmA, anyptr_gpB);
+  a.vmovdqa32(anyptr_gpA, ymmB);
+  a.vmovdqa32(zmmA, zmmB);
+  a.vmovdqa32(zmmA, anyptr_gpB);
+  a.vmovdqa32(anyptr_gpA, zmmB);
+  a.vmovdqa64(zmmA, zmmB);
+  a.vmovdqa64(zmmA, anyptr_gpB);
+  a.vmovdqa64(anyptr_gpA, zmmB);
+  a.vmovdqu32(zmmA, zmmB);
+  a.vmovdqu32(zmmA, anyptr_gpB);
+  a.vmovdqu32(anyptr_gpA, zmmB);
+  a.vmovdqu64(zmmA, zmmB);
+  a.k(kA).z().vmovdqu64(zmmA, anyptr_gpB);
+  a.vmovdqu64(anyptr_gpA, zmmB);
+  a.vmovupd(zmmA, zmmB);
+  a.vmovupd(zmmA, anyptr_gpB);
+  a.vmovupd(anyptr_gpA, zmmB);
+  a.vmovups(zmmA, zmmB);
+  a.vmovups(zmmA, anyptr_gpB);
+  a.vmovups(anyptr_gpA, zmmB);
+  a.vmulpd(zmmA, zmmB, zmmC);
+  a.vmulpd(zmmA, zmmB, anyptr_gpC);
+  a.vmulps(zmmA, zmmB, zmmC);
+  a.vmulps(zmmA, zmmB, anyptr_gpC);
+  a.vpaddd(zmmA, zmmB, zmmC);
+  a.vpaddd(zmmA, zmmB, anyptr_gpC);
+  a._1ToN().vpaddd(zmmA, zmmB, anyptr_gpC);
+  a.vpaddq(zmmA, zmmB, zmmC);
+  a.vpaddq(zmmA, zmmB, anyptr_gpC);
+  a.vpandd(xmmA, xmmB, xmmC);
+  a.vpandd(ymmA, ymmB, ymmC);
+  a.vpandd(zmmA, zmmB, zmmC);
+  a.vpandd(zmmA, zmmB, anyptr_gpC);
+  a.vpandnd(zmmA, zmmB, zmmC);
+  a.vpandnd(zmmA, zmmB, anyptr_gpC);
+  a.vpandnq(zmmA, zmmB, zmmC);
+  a.vpandnq(zmmA, zmmB, anyptr_gpC);
+  a.vpandq(zmmA, zmmB, zmmC);
+  a.vpandq(zmmA, zmmB, anyptr_gpC);
+  a.vpbroadcastd(zmmA, xmmB);
+  a.vpbroadcastd(zmmA, anyptr_gpB);
+  a.vpbroadcastq(zmmA, xmmB);
+  a.vpbroadcastq(zmmA, anyptr_gpB);
+  a.vpcmpd(kA, zmmB, zmmC, 0);
+  a.vpcmpd(kA, zmmB, anyptr_gpC, 0);
+  a.vpcmpeqd(kA, xmmB, xmmC);
+  a.vpcmpeqd(kA, zmmB, zmmC);
+  a.vpcmpeqd(kA, zmmB, anyptr_gpC);
+  a.vpcmpgtd(kA, zmmB, zmmC);
+  a.vpcmpgtd(kA, zmmB, anyptr_gpC);
+  a.vpcmpq(kA, zmmB, zmmC, 0);
+  a.vpcmpq(kA, zmmB, anyptr_gpC, 0);
+  a.vpcmpud(kA, zmmB, zmmC, 0);
+  a.vpcmpud(kA, zmmB, anyptr_gpC, 0);
+  a.vpcmpuq(kA, zmmB, zmmC, 0);
+  a.k(kB).vpcmpuq(kA, zmmB, anyptr_gpC, 0);
+  a.vpcompressd(zmmA, zmmB);
+  a.vpcompressd(anyptr_gpA, zmmB);
+  a.vpcompressq(zmmA, zmmB);
+  a.vpcompressq(anyptr_gpA, zmmB);
+  a.vpexpandd(zmmA, zmmB);
+  a.vpexpandd(zmmA, anyptr_gpB);
+  a.vpexpandq(zmmA, zmmB);
+  a.vpexpandq(zmmA, anyptr_gpB);
+  a.vpmulld(zmmA, zmmB, zmmC);
+  a.vpmulld(zmmA, zmmB, anyptr_gpC);
+  a.vpord(zmmA, zmmB, zmmC);
+  a.vpord(zmmA, zmmB, anyptr_gpC);
+  a.vporq(zmmA, zmmB, zmmC);
+  a.vporq(zmmA, zmmB, anyptr_gpC);
+  a.vpshufd(zmmA, zmmB, 0);
+  a.vpshufd(zmmA, anyptr_gpB, 0);
+  a.vpsubd(zmmA, zmmB, zmmC);
+  a.vpsubd(zmmA, zmmB, anyptr_gpC);
+  a.vpsubq(zmmA, zmmB, zmmC);
+  a.vpsubq(zmmA, zmmB, anyptr_gpC);
+  a.vpternlogd(zmmA, zmmB, zmmC, 0);
+  a.vpternlogd(zmmA, zmmB, anyptr_gpC, 0);
+  a.vpternlogq(zmmA, zmmB, zmmC, 0);
+  a.vpternlogq(zmmA, zmmB, anyptr_gpC, 0);
+  a.vptestmd(kA, zmmB, zmmC);
+  a.vptestmd(kA, zmmB, anyptr_gpC);
+  a.vptestmq(kA, zmmB, zmmC);
+  a.vptestmq(kA, zmmB, anyptr_gpC);
+  a.vptestnmd(kA, zmmB, zmmC);
+  a.vptestnmd(kA, zmmB, anyptr_gpC);
+  a.vptestnmq(kA, zmmB, zmmC);
+  a.vptestnmq(kA, zmmB, anyptr_gpC);
+  a.vpxord(zmmA, zmmB, zmmC);
+  a.vpxord(zmmA, zmmB, anyptr_gpC);
+  a.vpxorq(zmmA, zmmB, zmmC);
+  a.vpxorq(zmmA, zmmB, anyptr_gpC);
+  a.vsqrtpd(zmmA, zmmB);
+  a.vsqrtpd(zmmA, anyptr_gpB);
+  a.vsqrtps(zmmA, zmmB);
+  a.vsqrtps(zmmA, anyptr_gpB);
+  a.vsubpd(zmmA, zmmB, zmmC);
+  a.vsubpd(zmmA, zmmB, anyptr_gpC);
+  a.vsubps(zmmA, zmmB, zmmC);
+  a.vsubps(zmmA, zmmB, anyptr_gpC);
+
   // Mark the end of the stream.
   a.nop();
 }
@@ -698,6 +698,87 @@ struct X86Test_AllocMany2 : public X86Test {
   }
 };
 
+// ============================================================================
+// [X86Test_AllocLoop]
+// ============================================================================
+
+struct X86Test_AllocLoop : public X86Test {
+  X86Test_AllocLoop() : X86Test("[Alloc] Loop") {}
+
+  enum { kNumInvariants = 8, kNumAccumulators = 12 };
+
+  static void add(PodVector<X86Test*>& tests) {
+    tests.append(new X86Test_AllocLoop());
+  }
+
+  virtual void compile(X86Compiler& c) {
+    c.addFunc(FuncBuilder2<int, int*, int>(kCallConvHost));
+
+    X86GpVar buf = c.newIntPtr("buf");
+    X86GpVar cnt = c.newInt32("cnt");
+    X86GpVar inv[kNumInvariants];
+    X86GpVar acc[kNumAccumulators];
+
+    c.setArg(0, buf);
+    c.setArg(1, cnt);
+
+    int i;
+
+    // Variables alive through the loop, but not used inside.
+    for (i = 0; i < kNumInvariants; i++) {
+      inv[i] = c.newInt32("inv[%d]", i);
+      c.mov(inv[i], x86::dword_ptr(buf, i * 4));
+    }
+
+    for (i = 0; i < kNumAccumulators; i++) {
+      acc[i] = c.newInt32("acc[%d]", i);
+      c.xor_(acc[i], acc[i]);
+    }
+
+    Label L_Loop = c.newLabel();
+    c.bind(L_Loop);
+
+    for (i = 0; i < kNumAccumulators; i++)
+      c.add(acc[i], i + 1);
+
+    c.dec(cnt);
+    c.jnz(L_Loop);
+
+    for (i = 1; i < kNumInvariants; i++)
+      c.add(inv[0], inv[i]);
+
+    for (i = 0; i < kNumAccumulators; i++)
+      c.add(inv[0], acc[i]);
+
+    c.ret(inv[0]);
+    c.endFunc();
+  }
+
+  virtual bool run(void* _func, StringBuilder& result, StringBuilder& expect) {
+    typedef int (*Func)(int*, int);
+    Func func = asmjit_cast<Func>(_func);
+
+    int buf[kNumInvariants];
+    int i;
+    int expectRet = 0;
+
+    for (i = 0; i < kNumInvariants; i++) {
+      buf[i] = (i + 1) * 1000;
+      expectRet += buf[i];
+    }
+
+    for (i = 0; i < kNumAccumulators; i++)
+      expectRet += (i + 1) * 5;
+
+    int resultRet = func(buf, 5);
+
+    result.setFormat("ret=%d", resultRet);
+    expect.setFormat("ret=%d", expectRet);
+
+    return resultRet == expectRet;
+  }
+};
+
 // ============================================================================
 // [X86Test_AllocImul1]
 // ============================================================================
@@ -3030,6 +3111,356 @@ struct X86Test_MiscMultiFunc : public X86Test {
   }
 };
 
+// ============================================================================
+// [X86Test_MiscManyFuncs]
+// ============================================================================
+
+struct X86Test_MiscManyFuncs : public X86Test {
+  X86Test_MiscManyFuncs() : X86Test("[Misc] ManyFuncs") {}
+
+  enum { kFuncCount = 40 };
+
+  static void add(PodVector<X86Test*>& tests) {
+    tests.append(new X86Test_MiscManyFuncs());
+  }
+
+  virtual void compile(X86Compiler& c) {
+    X86FuncNode* funcs[kFuncCount];
+    uint32_t i;
+
+    for (i = 0; i < kFuncCount; i++)
+      funcs[i] = c.newFunc(FuncBuilder1<int, int>(kCallConvHost));
+
+    // Each function except the last one returns the sum of `i` and the
+    // result of the next function called by a loop of `i` iterations.
+    for (i = 0; i < kFuncCount; i++) {
+      X86GpVar a = c.newInt32("a");
+      X86GpVar n = c.newInt32("n");
+      Label L_Loop = c.newLabel();
+      Label L_Exit = c.newLabel();
+
+      c.addFunc(funcs[i]);
+      c.setArg(0, a);
+
+      c.mov(n, static_cast<int>(i));
+      c.test(n, n);
+      c.jz(L_Exit);
+
+      c.bind(L_Loop);
+      c.inc(a);
+      c.dec(n);
+      c.jnz(L_Loop);
+
+      c.bind(L_Exit);
+      if (i + 1 < kFuncCount) {
+        X86CallNode* call = c.call(funcs[i + 1]->getEntryLabel(), FuncBuilder1<int, int>(kCallConvHost));
+        call->setArg(0, a);
+        call->setRet(0, a);
+      }
+
+      c.ret(a);
+      c.endFunc();
+    }
+  }
+
+  virtual bool run(void* _func, StringBuilder& result, StringBuilder& expect) {
+    typedef int (*Func)(int);
+
+    Func func = asmjit_cast<Func>(_func);
+
+    int resultRet = func(10);
+    int expectRet = 10 + (kFuncCount - 1) * kFuncCount / 2;
+
+    result.setFormat("ret=%d", resultRet);
+    expect.setFormat("ret=%d", expectRet);
+
+    return result.eq(expect);
+  }
+};
+
+// ============================================================================
+// [X86Test_MiscPeephole]
+// ============================================================================
+
+struct X86Test_MiscPeephole : public X86Test {
+  X86Test_MiscPeephole() : X86Test("[Misc] Peephole") {}
+
+  static void add(PodVector<X86Test*>& tests) {
+    tests.append(new X86Test_MiscPeephole());
+  }
+
+  virtual void compile(X86Compiler& c) {
+    c.setFeature(kCompilerFeaturePeephole, true);
+    c.addFunc(FuncBuilder2<int, int, int>(kCallConvHost));
+
+    X86GpVar a = c.newInt32("a");
+    X86GpVar b = c.newInt32("b");
+    X86GpVar r = c.newInt32("r");
+    X86GpVar t = c.newInt32("t");
+
+    Label L_Next = c.newLabel();
+    Label L_Skip = c.newLabel();
+
+    c.setArg(0, a);
+    c.setArg(1, b);
+
+    // Zeroing followed by an instruction that overwrites flags.
+    c.mov(r, 0);
+    c.add(r, a);
+
+    // Zeroing followed by a flag consumer must stay `mov`.
+    c.mov(t, 0);
+    c.cmp(a, b);
+    c.mov(t, 0);
+    c.setg(t.r8());
+    c.add(r, t);
+
+    // Jumps to the next instruction.
+    c.jmp(L_Next);
+    c.bind(L_Next);
+    c.cmp(a, b);
+    c.jz(L_Skip);
+    c.bind(L_Skip);
+
+    // Zeroing overwritten by the next instruction.
+    c.xor_(t, t);
+    c.mov(t, b);
+    c.add(r, t);
+
+    // Spill followed by a reload of the same slot.
+    c.spill(r);
+    c.add(r, b);
+
+    c.ret(r);
+    c.endFunc();
+  }
+
+  virtual bool run(void* _func, StringBuilder& result, StringBuilder& expect) {
+    typedef int (*Func)(int, int);
+    Func func = asmjit_cast<Func>(_func);
+
+    int resultRet = func(5, 3);
+    int expectRet = 5 + 1 + 3 + 3;
+
+    result.setFormat("ret=%d", resultRet);
+    expect.setFormat("ret=%d", expectRet);
+
+    return result.eq(expect);
+  }
+};
+
+// ============================================================================
+// [X86Test_MiscScheduler]
+// ============================================================================
+
+struct X86Test_MiscScheduler : public X86Test {
+  X86Test_MiscScheduler() : X86Test("[Misc] Scheduler") {}
+
+  static void add(PodVector<X86Test*>& tests) {
+    tests.append(new X86Test_MiscScheduler());
+  }
+
+  virtual void compile(X86Compiler& c) {
+    c.setFeature(kCompilerFeatureEnableScheduler, true);
+    c.addFunc(FuncBuilder3<int, int*, int, int>(kCallConvHost));
+
+    X86GpVar p = c.newIntPtr("p");
+    X86GpVar a = c.newInt32("a");
+    X86GpVar b = c.newInt32("b");
+
+    X86GpVar x = c.newInt32("x");
+    X86GpVar y = c.newInt32("y");
+    X86GpVar z = c.newInt32("z");
+    X86GpVar t = c.newInt32("t");
+
+    c.setArg(0, p);
+    c.setArg(1, a);
+    c.setArg(2, b);
+
+    // Two independent chains, each starting by a load.
+    c.mov(x, x86::dword_ptr(p, 0));
+    c.add(x, a);
+    c.mov(y, x86::dword_ptr(p, 4));
+    c.imul(y, b);
+
+    // Flags produced by `cmp` are consumed by `setg` before `add` overwrites
+    // them.
+    c.xor_(t, t);
+    c.cmp(a, b);
+    c.setg(t.r8());
+    c.add(y, t);
+
+    // A load that reads a value stored before it.
+    c.mov(x86::dword_ptr(p, 8), x);
+    c.mov(z, x86::dword_ptr(p, 8));
+    c.add(z, y);
+
+    c.ret(z);
+    c.endFunc();
+  }
+
+  virtual bool run(void* _func, StringBuilder& result, StringBuilder& expect) {
+    typedef int (*Func)(int*, int, int);
+    Func func = asmjit_cast<Func>(_func);
+
+    int buffer[3] = { 1, 2, 0 };
+    int resultRet = func(buffer, 5, 3);
+    int expectRet = (1 + 5) + (2 * 3 + 1);
+
+    result.setFormat("ret=%d, buffer[2]=%d", resultRet, buffer[2]);
+    expect.setFormat("ret=%d, buffer[2]=%d", expectRet, 1 + 5);
+
+    return result.eq(expect);
+  }
+};
+
+// ============================================================================
+// [X86Test_MiscValueNumbering]
+// ============================================================================
+
+struct X86Test_MiscValueNumbering : public X86Test {
+  X86Test_MiscValueNumbering() : X86Test("[Misc] ValueNumbering") {}
+
+  static void add(PodVector<X86Test*>& tests) {
+    tests.append(new X86Test_MiscValueNumbering());
+  }
+
+  virtual void compile(X86Compiler& c) {
+    c.setFeature(kCompilerFeatureValueNumbering, true);
+    c.addFunc(FuncBuilder2<int, int*, intptr_t>(kCallConvHost));
+
+    X86GpVar p = c.newIntPtr("p");
+    X86GpVar i = c.newIntPtr("i");
+    X86GpVar q = c.newIntPtr("q");
+    X86GpVar r = c.newInt32("r");
+
+    X86GpVar a = c.newInt32("a");
+    X86GpVar b = c.newInt32("b");
+    X86GpVar x = c.newInt32("x");
+    X86GpVar y = c.newInt32("y");
+    X86GpVar u = c.newInt32("u");
+    X86GpVar w = c.newInt32("w");
+    X86GpVar n = c.newInt32("n");
+
+    c.setArg(0, p);
+    c.setArg(1, i);
+
+    // The same load twice, `b` is replaced by `a`.
+    c.mov(a, x86::dword_ptr(p, i, 2));
+    c.mov(b, x86::dword_ptr(p, i, 2));
+    c.mov(r, a);
+    c.add(r, b);
+
+    // A store between two loads of the same memory.
+    c.mov(x, x86::dword_ptr(p));
+    c.mov(x86::dword_ptr(p), r);
+    c.mov(y, x86::dword_ptr(p));
+    c.add(r, x);
+    c.add(r, y);
+
+    // `w` is defined twice, the second load becomes a move from `u`.
+    c.mov(u, x86::dword_ptr(p, 12));
+    c.mov(w, x86::dword_ptr(p, 12));
+    c.add(w, u);
+    c.add(r, w);
+
+    // Addresses computed from the previous value of their own variable.
+    c.lea(q, x86::ptr(p, 16));
+    c.lea(q, x86::ptr(q, 4));
+    c.lea(q, x86::ptr(q, 4));
+    c.add(r, x86::dword_ptr(q));
+
+    // The index changes, the load has to be repeated.
+    c.add(i, 1);
+    c.mov(n, x86::dword_ptr(p, i, 2));
+    c.add(r, n);
+
+    c.ret(r);
+    c.endFunc();
+  }
+
+  virtual bool run(void* _func, StringBuilder& result, StringBuilder& expect) {
+    typedef int (*Func)(int*, intptr_t);
+    Func func = asmjit_cast<Func>(_func);
+
+    int buffer[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    int resultRet = func(buffer, 1);
+    int expectRet = (2 + 2) + 1 + 4 + (4 + 4) + 7 + 3;
+
+    result.setFormat("ret=%d, buffer[0]=%d", resultRet, buffer[0]);
+    expect.setFormat("ret=%d, buffer[0]=%d", expectRet, 2 + 2);
+
+    return result.eq(expect);
+  }
+};
+
+// ============================================================================
+// [X86Test_MiscTune]
+// ============================================================================
+
+struct X86Test_MiscTune : public X86Test {
+  X86Test_MiscTune() : X86Test("[Misc] Tune") {}
+
+  static void add(PodVector<X86Test*>& tests) {
+    tests.append(new X86Test_MiscTune());
+  }
+
+  virtual void compile(X86Compiler& c) {
+    c.setTuneArch(kX86TuneArchSkylake);
+    c.setTuneOptions(kX86TuneAll);
+    c.addFunc(FuncBuilder2<int, int*, int>(kCallConvHost));
+
+    X86GpVar p = c.newIntPtr("p");
+    X86GpVar q = c.newIntPtr("q");
+    X86GpVar i = c.newIntPtr("i");
+    X86GpVar n = c.newIntPtr("n");
+    X86GpVar sum = c.newInt32("sum");
+    X86GpVar t = c.newInt32("t");
+    X86GpVar b = c.newInt8("b");
+
+    Label L_Loop = c.newLabel();
+
+    c.setArg(0, p);
+    c.setArg(1, n);
+
+    // Zero idioms.
+    c.mov(sum, 0);
+    c.mov(i, 0);
+
+    // The `cmp` is moved next to `jl`, the byte load becomes `movzx`.
+    c.bind(L_Loop);
+    c.add(sum, x86::dword_ptr(p, i, 2));
+    c.inc(i);
+    c.cmp(i, n);
+    c.mov(b, x86::byte_ptr(p));
+    c.jl(L_Loop);
+
+    c.movzx(t, b);
+    c.add(sum, t);
+
+    // Complex address, split to `lea` and `add` on some CPUs.
+    c.lea(q, x86::ptr(p, i, 2, 8));
+    c.add(sum, x86::dword_ptr(q));
+
+    c.ret(sum);
+    c.endFunc();
+  }
+
+  virtual bool run(void* _func, StringBuilder& result, StringBuilder& expect) {
+    typedef int (*Func)(int*, int);
+    Func func = asmjit_cast<Func>(_func);
+
+    int buffer[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    int resultRet = func(buffer, 4);
+    int expectRet = (1 + 2 + 3 + 4) + 1 + 7;
+
+    result.setFormat("ret=%d", resultRet);
+    expect.setFormat("ret=%d", expectRet);
+
+    return result.eq(expect);
+  }
+};
+
 // ============================================================================
 // [X86Test_MiscUnfollow]
 // ============================================================================
@@ -3120,6 +3551,17 @@ struct X86TestSuite {
   int returnCode;
   int binSize;
   bool alwaysPrintLog;
+  bool dualMapping;
+  bool compact;
+  bool relax;
+  bool alignPolicy;
+  bool linearScan;
+  bool threads;
+  bool peephole;
+  bool scheduler;
+  bool valueNumbering;
+  bool tune;
+  bool strict;
 };
 
 #define ADD_TEST(_Class_) \
@@ -3128,7 +3570,18 @@ struct X86TestSuite {
 X86TestSuite::X86TestSuite() :
   returnCode(0),
   binSize(0),
-  alwaysPrintLog(false) {
+  alwaysPrintLog(false),
+  dualMapping(false),
+  compact(false),
+  relax(false),
+  alignPolicy(false),
+  linearScan(false),
+  threads(false),
+  peephole(false),
+  scheduler(false),
+  valueNumbering(false),
+  tune(false),
+  strict(false) {
 
   // Align.
   ADD_TEST(X86Test_AlignBase);
@@ -3146,6 +3599,7 @@ X86TestSuite::X86TestSuite() :
   ADD_TEST(X86Test_AllocUseMem);
   ADD_TEST(X86Test_AllocMany1);
   ADD_TEST(X86Test_AllocMany2);
+  ADD_TEST(X86Test_AllocLoop);
   ADD_TEST(X86Test_AllocImul1);
   ADD_TEST(X86Test_AllocImul2);
   ADD_TEST(X86Test_AllocIdiv1);
@@ -3190,6 +3644,11 @@ X86TestSuite::X86TestSuite() :
   ADD_TEST(X86Test_MiscConstPool);
   ADD_TEST(X86Test_MiscMultiRet);
   ADD_TEST(X86Test_MiscMultiFunc);
+  ADD_TEST(X86Test_MiscManyFuncs);
+  ADD_TEST(X86Test_MiscPeephole);
+  ADD_TEST(X86Test_MiscScheduler);
+  ADD_TEST(X86Test_MiscValueNumbering);
+  ADD_TEST(X86Test_MiscTune);
   ADD_TEST(X86Test_MiscUnfollow);
 }
 
@@ -3217,9 +3676,42 @@ int X86TestSuite::run() {
 
   for (i = 0; i < count; i++) {
     JitRuntime runtime;
+    if (dualMapping)
+      runtime.getMemMgr()->setDualMappingEnabled(true);
+
     X86Assembler a(&runtime);
     X86Compiler c(&a);
 
+    if (relax)
+      a.addAsmOptions(Assembler::kOptionRelaxJumps);
+
+    if (strict)
+      a.addAsmOptions(Assembler::kOptionStrictValidation);
+
+    if (alignPolicy) {
+      a.addAsmOptions(Assembler::kOptionOptimizedAlign);
+      c.setLoopAlign(32);
+      c.setJumpBoundary(32);
+    }
+
+    if (linearScan)
+      c.setFeature(kCompilerFeatureLinearScan, true);
+
+    if (threads)
+      c.setThreadCount(4);
+
+    if (peephole)
+      c.setFeature(kCompilerFeaturePeephole, true);
+
+    if (scheduler)
+      c.setFeature(kCompilerFeatureEnableScheduler, true);
+
+    if (valueNumbering)
+      c.setFeature(kCompilerFeatureValueNumbering, true);
+
+    if (tune)
+      c.setTuneOptions(kX86TuneAll);
+
     if (alwaysPrintLog) {
       fprintf(file, "\n");
       a.setLogger(&fileLogger);
@@ -3233,7 +3725,28 @@ int X86TestSuite::run() {
     test->compile(c);
     c.finalize();
 
-    void* func = a.make();
+    void* func = NULL;
+    JitFunc* movable = NULL;
+
+    if (compact) {
+      // Fill the first node, add the function into a new one and make space
+      // in the first node, so the function has to be moved by `compact()`.
+      VMemMgr* memMgr = runtime.getMemMgr();
+      memMgr->alloc(32768);
+      void* blocker = memMgr->alloc(32768);
+
+      if (runtime.addRelocatable(&movable, &a) == kErrorOk) {
+        void* initial = movable->getPtr<void*>();
+        memMgr->release(blocker);
+
+        if (runtime.compact() == kErrorOk && movable->getPtr<void*>() != initial)
+          func = movable->getPtr<void*>();
+      }
+    }
+    else {
+      func = a.make();
+    }
+
     if (alwaysPrintLog)
       fflush(file);
 
@@ -3259,7 +3772,10 @@ int X86TestSuite::run() {
         returnCode = 1;
       }
 
-      runtime.release(func);
+      if (movable != NULL)
+        runtime.releaseRelocatable(movable);
+      else
+        runtime.release(func);
     }
     else {
       if (!alwaysPrintLog) {
@@ -3320,5 +3836,49 @@ int main(int argc, char* argv[]) {
     testSuite.alwaysPrintLog = true;
   }
 
+  if (cmd.hasArg("--dual-mapping")) {
+    testSuite.dualMapping = true;
+  }
+
+  if (cmd.hasArg("--compact")) {
+    testSuite.compact = true;
+  }
+
+  if (cmd.hasArg("--relax")) {
+    testSuite.relax = true;
+  }
+
+  if (cmd.hasArg("--align-policy")) {
+    testSuite.alignPolicy = true;
+  }
+
+  if (cmd.hasArg("--linear-scan")) {
+    testSuite.linearScan = true;
+  }
+
+  if (cmd.hasArg("--threads")) {
+    testSuite.threads = true;
+  }
+
+  if (cmd.hasArg("--peephole")) {
+    testSuite.peephole = true;
+  }
+
+  if (cmd.hasArg("--scheduler")) {
+    testSuite.scheduler = true;
+  }
+
+  if (cmd.hasArg("--value-numbering")) {
+    testSuite.valueNumbering = true;
+  }
+
+  if (cmd.hasArg("--tune")) {
+    testSuite.tune = true;
+  }
+
+  if (cmd.hasArg("--strict")) {
+    testSuite.strict = true;
+  }
+
   return testSuite.run();
 }